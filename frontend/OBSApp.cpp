@@ -288,6 +288,7 @@ void OBSApp::InitUserConfigDefaults()
 	config_set_default_bool(userConfig, "BasicWindow", "ShowSourceIcons", true);
 	config_set_default_bool(userConfig, "BasicWindow", "ShowContextToolbars", true);
 	config_set_default_bool(userConfig, "BasicWindow", "StudioModeLabels", true);
+	config_set_default_uint(userConfig, "BasicWindow", "StudioPreviewFPS", 20);
 
 	config_set_default_bool(userConfig, "BasicWindow", "VerticalVolControl", false);
 
@@ -603,6 +604,10 @@ bool OBSApp::InitLocale()
 	if (!locale.empty())
 		QLocale::setDefault(QLocale(QString::fromStdString(locale).replace('-', '_')));
 
+	char localeCachePath[512];
+	if (GetAppConfigPath(localeCachePath, sizeof(localeCachePath), "obs-studio/cache/locale") > 0)
+		text_lookup_enable_cache(localeCachePath);
+
 	string englishPath;
 	if (!GetDataFilePath("locale/" DEFAULT_LANG ".ini", englishPath)) {
 		OBSErrorBox(NULL, "Failed to find locale/" DEFAULT_LANG ".ini");
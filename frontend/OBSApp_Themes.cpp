@@ -25,6 +25,8 @@
 #include <ui-config.h>
 #include <util/cf-parser.h>
 
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
@@ -803,6 +805,94 @@ static double getPaddingForDensityId(int id)
 	return paddingValue;
 }
 
+/* Compiled theme cache: the resolved stylesheet and palette are stored in
+ * the user themes directory, keyed on a hash of every contributing theme
+ * file plus the appearance settings that feed the variables.  A hit skips
+ * variable parsing, alias/math resolution and QSS substitution entirely;
+ * any edit to a theme file changes the hash and forces a recompile. */
+
+static constexpr quint32 themeCacheMagic = 0x4F425443; /* "OBTC" */
+static constexpr quint32 themeCacheVersion = 1;
+
+static QString GetThemeCachePath(const QString &themeId)
+{
+	string filename("obs-studio/themes/");
+	filename += themeId.toStdString();
+	filename += ".compiled";
+
+	char configPath[512];
+	if (!GetAppConfigPath(configPath, sizeof(configPath), filename.c_str()))
+		return QString();
+
+	filesystem::create_directories(filesystem::u8path(configPath).parent_path());
+
+	return QString::fromUtf8(configPath);
+}
+
+static QByteArray GetThemeCacheKey(const QList<QByteArray> &rawContents, const QStringList &themeIds,
+				   const QPalette &defaultPalette)
+{
+	QCryptographicHash hash(QCryptographicHash::Sha256);
+
+	for (const QByteArray &content : rawContents)
+		hash.addData(content);
+
+	hash.addData(themeIds.join(',').toUtf8());
+	hash.addData(QByteArrayLiteral(QT_VERSION_STR));
+
+	const int fontScale = config_get_int(App()->GetUserConfig(), "Appearance", "FontScale");
+	const int density = config_get_int(App()->GetUserConfig(), "Appearance", "Density");
+	hash.addData(QString("%1/%2").arg(fontScale).arg(density).toUtf8());
+
+	/* the cached palette derives from the platform default palette */
+	QByteArray paletteData;
+	QDataStream paletteStream(&paletteData, QIODeviceBase::WriteOnly);
+	paletteStream << defaultPalette;
+	hash.addData(paletteData);
+
+	return hash.result();
+}
+
+static bool LoadThemeCache(const QString &path, const QByteArray &key, QString &stylesheet, QPalette &palette,
+			   bool &usesFontScale, bool &usesDensity)
+{
+	QFile file(path);
+	if (path.isEmpty() || !file.open(QIODeviceBase::ReadOnly))
+		return false;
+
+	QDataStream in(&file);
+	in.setVersion(QDataStream::Qt_6_0);
+
+	quint32 magic = 0;
+	quint32 version = 0;
+	QByteArray storedKey;
+
+	in >> magic >> version;
+	if (magic != themeCacheMagic || version != themeCacheVersion)
+		return false;
+
+	in >> storedKey;
+	if (storedKey != key)
+		return false;
+
+	in >> stylesheet >> palette >> usesFontScale >> usesDensity;
+	return in.status() == QDataStream::Ok;
+}
+
+static void SaveThemeCache(const QString &path, const QByteArray &key, const QString &stylesheet,
+			   const QPalette &palette, bool usesFontScale, bool usesDensity)
+{
+	QFile file(path);
+	if (path.isEmpty() || !file.open(QIODeviceBase::WriteOnly))
+		return;
+
+	QDataStream out(&file);
+	out.setVersion(QDataStream::Qt_6_0);
+
+	out << themeCacheMagic << themeCacheVersion << key;
+	out << stylesheet << palette << usesFontScale << usesDensity;
+}
+
 OBSTheme *OBSApp::GetTheme(const QString &name)
 {
 	if (!themes.contains(name))
@@ -860,6 +950,7 @@ bool OBSApp::SetTheme(const QString &name)
 	}
 
 	QStringList filenames;
+	QList<QByteArray> rawContents;
 	for (const QString &themeId : themeIds) {
 		OBSTheme *cur = GetTheme(themeId);
 
@@ -868,33 +959,49 @@ bool OBSApp::SetTheme(const QString &name)
 
 		if (!file.open(QIODeviceBase::ReadOnly))
 			return false;
-		const QByteArray content = file.readAll();
-
-		for (OBSThemeVariable &var : ParseThemeVariables(content.constData())) {
-			vars[var.name] = std::move(var);
-		}
 
-		contents.emplaceBack(content.constData());
+		rawContents.emplaceBack(file.readAll());
 	}
 
-	/* Check if OBS appearance settings are used in the theme */
-	currentTheme->usesFontScale = false;
-	currentTheme->usesDensity = false;
-	for (const OBSThemeVariable &var_ : vars) {
-		if (var_.type != OBSThemeVariable::Alias)
-			continue;
+	const QString cachePath = GetThemeCachePath(theme->id);
+	const QByteArray cacheKey = GetThemeCacheKey(rawContents, themeIds, defaultPalette);
+
+	QString stylesheet;
+	QPalette palette;
+	bool usesFontScale = false;
+	bool usesDensity = false;
+
+	if (!LoadThemeCache(cachePath, cacheKey, stylesheet, palette, usesFontScale, usesDensity)) {
+		for (const QByteArray &content : rawContents) {
+			for (OBSThemeVariable &var : ParseThemeVariables(content.constData())) {
+				vars[var.name] = std::move(var);
+			}
 
-		if (var_.value.toString() == "obsFontScale") {
-			currentTheme->usesFontScale = true;
+			contents.emplaceBack(content.constData());
 		}
 
-		if (var_.value.toString() == "obsPadding") {
-			currentTheme->usesDensity = true;
+		/* Check if OBS appearance settings are used in the theme */
+		for (const OBSThemeVariable &var_ : vars) {
+			if (var_.type != OBSThemeVariable::Alias)
+				continue;
+
+			if (var_.value.toString() == "obsFontScale") {
+				usesFontScale = true;
+			}
+
+			if (var_.value.toString() == "obsPadding") {
+				usesDensity = true;
+			}
 		}
+
+		stylesheet = PrepareQSS(vars, contents);
+		palette = PreparePalette(vars, defaultPalette);
+
+		SaveThemeCache(cachePath, cacheKey, stylesheet, palette, usesFontScale, usesDensity);
 	}
 
-	const QString stylesheet = PrepareQSS(vars, contents);
-	const QPalette palette = PreparePalette(vars, defaultPalette);
+	currentTheme->usesFontScale = usesFontScale;
+	currentTheme->usesDensity = usesDensity;
 	setPalette(palette);
 	setStyleSheet(stylesheet);
 
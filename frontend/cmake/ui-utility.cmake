@@ -8,6 +8,8 @@ target_sources(
     utility/BaseLexer.hpp
     utility/BasicOutputHandler.cpp
     utility/BasicOutputHandler.hpp
+    utility/DeviceEnumCache.cpp
+    utility/DeviceEnumCache.hpp
     utility/display-helpers.hpp
     utility/FFmpegCodec.cpp
     utility/FFmpegCodec.hpp
@@ -63,6 +65,8 @@ target_sources(
     utility/StartMultiTrackVideoStreamingGuard.hpp
     utility/SurfaceEventFilter.hpp
     utility/system-info.hpp
+    utility/undo_chunk_store.cpp
+    utility/undo_chunk_store.hpp
     utility/undo_stack.cpp
     utility/undo_stack.hpp
     utility/VCamConfig.hpp
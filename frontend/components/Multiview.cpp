@@ -5,6 +5,11 @@
 
 #include <obs-frontend-api.h>
 
+#include <util/platform.h>
+
+/* refresh rate of cached (non-program/preview) multiview cells */
+#define MULTIVIEW_CELL_INTERVAL_NS (1000000000ULL / 15)
+
 Multiview::Multiview()
 {
 	InitSafeAreas(&actionSafeMargin, &graphicsSafeMargin, &fourByThreeSafeMargin, &leftLine, &topLine, &rightLine);
@@ -25,6 +30,8 @@ Multiview::~Multiview()
 	gs_vertexbuffer_destroy(leftLine);
 	gs_vertexbuffer_destroy(topLine);
 	gs_vertexbuffer_destroy(rightLine);
+	for (gs_texrender_t *texrender : cellRenders)
+		gs_texrender_destroy(texrender);
 	obs_leave_graphics();
 }
 
@@ -207,6 +214,62 @@ static inline uint32_t labelOffset(MultiviewLayout multiviewLayout, obs_source_t
 	return (cx / 2) - w;
 }
 
+void Multiview::RenderCellCached(size_t i, obs_source_t *src, uint32_t cellCX, uint32_t cellCY, uint64_t now)
+{
+	uint32_t sourceCX = obs_source_get_width(src);
+	uint32_t sourceCY = obs_source_get_height(src);
+	if (!sourceCX || !sourceCY) {
+		obs_source_video_render(src);
+		return;
+	}
+
+	if (cellRenders.size() <= i) {
+		cellRenders.resize(i + 1, nullptr);
+		cellRenderTimes.resize(i + 1, 0);
+	}
+
+	// Cap the offscreen render at the cell's on-screen size; the cell
+	// never shows more pixels than that anyway
+	uint32_t texCX = sourceCX;
+	uint32_t texCY = sourceCY;
+	if (cellCX && cellCY && sourceCX > cellCX) {
+		texCX = cellCX;
+		texCY = uint32_t((uint64_t)sourceCY * cellCX / sourceCX);
+		if (!texCY)
+			texCY = 1;
+	}
+
+	if (!cellRenders[i])
+		cellRenders[i] = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+	gs_texrender_t *texrender = cellRenders[i];
+	gs_texture_t *tex = gs_texrender_get_texture(texrender);
+
+	if (!tex || now - cellRenderTimes[i] >= MULTIVIEW_CELL_INTERVAL_NS) {
+		gs_texrender_reset(texrender);
+		if (gs_texrender_begin(texrender, texCX, texCY)) {
+			struct vec4 clearColor;
+			vec4_zero(&clearColor);
+			gs_clear(GS_CLEAR_COLOR, &clearColor, 0.0f, 0);
+			gs_ortho(0.0f, float(sourceCX), 0.0f, float(sourceCY), -100.0f, 100.0f);
+			obs_source_video_render(src);
+			gs_texrender_end(texrender);
+			cellRenderTimes[i] = now;
+		}
+		tex = gs_texrender_get_texture(texrender);
+	}
+
+	if (!tex) {
+		obs_source_video_render(src);
+		return;
+	}
+
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), tex);
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(tex, 0, sourceCX, sourceCY);
+}
+
 void Multiview::Render(uint32_t cx, uint32_t cy)
 {
 	OBSBasic *main = (OBSBasic *)obs_frontend_get_main_window();
@@ -410,12 +473,16 @@ void Multiview::Render(uint32_t cx, uint32_t cy)
 
 		/* ----------- */
 
-		// Render the source
+		// Render the source; non-program/preview cells come from the
+		// per-cell cache instead of a full re-render every frame
 		gs_matrix_push();
 		gs_matrix_translate3f(siX, siY, 0.0f);
 		gs_matrix_scale3f(siScaleX, siScaleY, 1.0f);
 		setRegion(siX, siY, siCX, siCY);
-		obs_source_video_render(src);
+		if (src == programSrc || src == previewSrc)
+			obs_source_video_render(src);
+		else
+			RenderCellCached(i, src, uint32_t(siCX * scale), uint32_t(siCY * scale), os_gettime_ns());
 		endRegion();
 		gs_matrix_pop();
 
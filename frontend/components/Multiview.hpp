@@ -39,6 +39,14 @@ private:
 	std::vector<OBSWeakSource> multiviewScenes;
 	std::vector<OBSSource> multiviewLabels;
 
+	/* Non-program/preview cells are rendered into per-cell textures at a
+	 * reduced rate and capped at the cell's on-screen resolution, then
+	 * drawn from cache every frame. */
+	std::vector<gs_texrender_t *> cellRenders;
+	std::vector<uint64_t> cellRenderTimes;
+
+	void RenderCellCached(size_t i, obs_source_t *src, uint32_t cellCX, uint32_t cellCY, uint64_t now);
+
 	// Multiview position helpers
 	float thickness = 6;
 	float offset, thicknessx2 = thickness * 2, pvwprgCX, pvwprgCY, sourceX, sourceY, labelX, labelY, scenesCX,
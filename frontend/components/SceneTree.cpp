@@ -37,6 +37,21 @@ bool SceneTree::GetGridMode()
 	return gridMode;
 }
 
+void SceneTree::BeginBulkUpdate()
+{
+	if (bulkUpdateDepth++ == 0)
+		setUpdatesEnabled(false);
+}
+
+void SceneTree::EndBulkUpdate()
+{
+	if (--bulkUpdateDepth == 0) {
+		QResizeEvent event(size(), size());
+		resizeEvent(&event);
+		setUpdatesEnabled(true);
+	}
+}
+
 void SceneTree::SetGridItemWidth(int width)
 {
 	maxWidth = width;
@@ -228,8 +243,10 @@ void SceneTree::dragLeaveEvent(QDragLeaveEvent *event)
 
 void SceneTree::rowsInserted(const QModelIndex &parent, int start, int end)
 {
-	QResizeEvent event(size(), size());
-	SceneTree::resizeEvent(&event);
+	if (bulkUpdateDepth == 0) {
+		QResizeEvent event(size(), size());
+		SceneTree::resizeEvent(&event);
+	}
 
 	QListWidget::rowsInserted(parent, start, end);
 }
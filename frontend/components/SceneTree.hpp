@@ -13,11 +13,18 @@ class SceneTree : public QListWidget {
 	bool gridMode = false;
 	int maxWidth = 150;
 	int itemHeight = 24;
+	int bulkUpdateDepth = 0;
 
 public:
 	void SetGridMode(bool grid);
 	bool GetGridMode();
 
+	/* suppresses the per-insert full-list relayout while many items are
+	 * added or reordered (e.g. a scene collection switch); one relayout
+	 * happens when the outermost EndBulkUpdate() is reached */
+	void BeginBulkUpdate();
+	void EndBulkUpdate();
+
 	void SetGridItemWidth(int width);
 	void SetGridItemHeight(int height);
 	int GetGridItemWidth();
@@ -17,6 +17,7 @@
 
 #include "OBSRemux.hpp"
 
+#include <OBSApp.hpp>
 #include <utility/RemuxEntryPathItemDelegate.hpp>
 #include <utility/RemuxQueueModel.hpp>
 #include <utility/RemuxWorker.hpp>
@@ -34,7 +35,6 @@
 OBSRemux::OBSRemux(const char *path, QWidget *parent, bool autoRemux_)
 	: QDialog(parent),
 	  queueModel(new RemuxQueueModel),
-	  worker(new RemuxWorker()),
 	  ui(new Ui::OBSRemux),
 	  recPath(path),
 	  autoRemux(autoRemux_)
@@ -85,13 +85,29 @@ OBSRemux::OBSRemux(const char *path, QWidget *parent, bool autoRemux_)
 		&OBSRemux::clearAll);
 	connect(ui->buttonBox->button(QDialogButtonBox::Close), &QPushButton::clicked, this, &OBSRemux::close);
 
-	worker->moveToThread(&remuxer);
-	remuxer.start();
+	/* remuxing is mostly I/O bound, so a few concurrent jobs go a long
+	 * way; the count can be overridden for batch-heavy setups */
+	int threadCount = (int)config_get_uint(App()->GetUserConfig(), "General", "RemuxThreads");
+	if (threadCount <= 0)
+		threadCount = qMin(4, QThread::idealThreadCount());
+	if (autoRemux)
+		threadCount = 1;
 
-	connect(worker.data(), &RemuxWorker::updateProgress, this, &OBSRemux::updateProgress);
-	connect(&remuxer, &QThread::finished, worker.data(), &QObject::deleteLater);
-	connect(worker.data(), &RemuxWorker::remuxFinished, this, &OBSRemux::remuxFinished);
-	connect(this, &OBSRemux::remux, worker.data(), &RemuxWorker::remux);
+	for (int i = 0; i < threadCount; i++) {
+		RemuxWorker *worker = new RemuxWorker();
+		QThread *thread = new QThread(this);
+
+		worker->moveToThread(thread);
+		thread->start();
+
+		connect(worker, &RemuxWorker::updateProgress, this, &OBSRemux::updateProgress);
+		connect(thread, &QThread::finished, worker, &QObject::deleteLater);
+		connect(worker, &RemuxWorker::remuxFinished, this, &OBSRemux::remuxFinished);
+
+		remuxThreads.push_back(thread);
+		workers.push_back(worker);
+		idleWorkers.push_back(worker);
+	}
 
 	connect(queueModel.data(), &RemuxQueueModel::rowsInserted, this, &OBSRemux::rowCountChanged);
 	connect(queueModel.data(), &RemuxQueueModel::rowsRemoved, this, &OBSRemux::rowCountChanged);
@@ -103,14 +119,9 @@ OBSRemux::OBSRemux(const char *path, QWidget *parent, bool autoRemux_)
 
 bool OBSRemux::stopRemux()
 {
-	if (!worker->isWorking)
+	if (activeJobs == 0)
 		return true;
 
-	// By locking the worker thread's mutex, we ensure that its
-	// update poll will be blocked as long as we're in here with
-	// the popup open.
-	QMutexLocker lock(&worker->updateMutex);
-
 	bool exit = false;
 
 	if (QMessageBox::critical(nullptr, QTStr("Remux.ExitUnfinishedTitle"), QTStr("Remux.ExitUnfinished"),
@@ -119,10 +130,13 @@ bool OBSRemux::stopRemux()
 	}
 
 	if (exit) {
-		// Inform the worker it should no longer be
-		// working. It will interrupt accordingly in
+		// Inform the workers they should no longer be
+		// working. Each will interrupt accordingly in
 		// its next update callback.
-		worker->isWorking = false;
+		for (RemuxWorker *worker : workers) {
+			QMutexLocker lock(&worker->updateMutex);
+			worker->isWorking = false;
+		}
 	}
 
 	return exit;
@@ -131,8 +145,11 @@ bool OBSRemux::stopRemux()
 OBSRemux::~OBSRemux()
 {
 	stopRemux();
-	remuxer.quit();
-	remuxer.wait();
+
+	for (QThread *thread : remuxThreads) {
+		thread->quit();
+		thread->wait();
+	}
 }
 
 void OBSRemux::rowCountChanged(const QModelIndex &, int, int)
@@ -190,13 +207,13 @@ void OBSRemux::dropEvent(QDropEvent *ev)
 
 void OBSRemux::dragEnterEvent(QDragEnterEvent *ev)
 {
-	if (ev->mimeData()->hasUrls() && !worker->isWorking)
+	if (ev->mimeData()->hasUrls() && activeJobs == 0)
 		ev->accept();
 }
 
 void OBSRemux::beginRemux()
 {
-	if (worker->isWorking) {
+	if (activeJobs > 0) {
 		stopRemux();
 		return;
 	}
@@ -221,6 +238,10 @@ void OBSRemux::beginRemux()
 	// Set all jobs to "pending" first.
 	queueModel->beginProcessing();
 
+	completedJobs = 0;
+	totalJobs = queueModel->pendingEntryCount();
+	activeProgress.clear();
+
 	ui->progressBar->setVisible(true);
 	ui->buttonBox->button(QDialogButtonBox::Ok)->setText(QTStr("Remux.Stop"));
 	setAcceptDrops(false);
@@ -230,21 +251,31 @@ void OBSRemux::beginRemux()
 
 void OBSRemux::AutoRemux(QString inFile, QString outFile)
 {
-	if (inFile != "" && outFile != "" && autoRemux) {
+	if (inFile != "" && outFile != "" && autoRemux && !workers.empty()) {
 		ui->progressBar->setVisible(true);
-		emit remux(inFile, outFile);
+		activeJobs++;
+		QMetaObject::invokeMethod(workers[0], "remux", Qt::QueuedConnection, Q_ARG(int, -1),
+					  Q_ARG(QString, inFile), Q_ARG(QString, outFile));
 		autoRemuxFile = outFile;
 	}
 }
 
 void OBSRemux::remuxNextEntry()
 {
-	worker->lastProgress = 0.f;
-
 	QString inputPath, outputPath;
-	if (queueModel->beginNextEntry(inputPath, outputPath)) {
-		emit remux(inputPath, outputPath);
-	} else {
+	int row;
+
+	/* hand pending entries to every idle worker so up to N files are
+	 * remuxed concurrently */
+	while (!idleWorkers.isEmpty() && queueModel->beginNextEntry(inputPath, outputPath, row)) {
+		RemuxWorker *worker = idleWorkers.takeFirst();
+
+		activeJobs++;
+		QMetaObject::invokeMethod(worker, "remux", Qt::QueuedConnection, Q_ARG(int, row),
+					  Q_ARG(QString, inputPath), Q_ARG(QString, outputPath));
+	}
+
+	if (activeJobs == 0) {
 		queueModel->autoRemux = autoRemux;
 		queueModel->endProcessing();
 
@@ -278,16 +309,39 @@ void OBSRemux::reject()
 	QDialog::reject();
 }
 
-void OBSRemux::updateProgress(float percent)
+void OBSRemux::updateProgress(float percent, int row)
 {
-	ui->progressBar->setValue(percent * 10);
+	/* auto-remux tracks its single file directly */
+	if (row < 0) {
+		ui->progressBar->setValue((int)(percent * 10));
+		return;
+	}
+
+	activeProgress[row] = percent;
+
+	if (totalJobs > 0) {
+		float total = completedJobs * 100.f;
+
+		for (float p : activeProgress)
+			total += p;
+
+		ui->progressBar->setValue((int)(total / totalJobs * 10.f));
+	}
 }
 
-void OBSRemux::remuxFinished(bool success)
+void OBSRemux::remuxFinished(bool success, int row)
 {
+	RemuxWorker *worker = qobject_cast<RemuxWorker *>(sender());
+
 	ui->buttonBox->button(QDialogButtonBox::Ok)->setEnabled(true);
 
-	queueModel->finishEntry(success);
+	queueModel->finishEntry(row, success);
+
+	activeProgress.remove(row);
+	completedJobs++;
+	activeJobs--;
+	if (worker)
+		idleWorkers.push_back(worker);
 
 	if (autoRemux && autoRemuxFile != "") {
 		QTimer::singleShot(3000, this, &OBSRemux::close);
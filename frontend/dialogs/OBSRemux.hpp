@@ -19,9 +19,12 @@
 
 #include "ui_OBSRemux.h"
 
+#include <QHash>
 #include <QPointer>
 #include <QThread>
 
+#include <vector>
+
 class RemuxQueueModel;
 class RemuxWorker;
 
@@ -29,8 +32,17 @@ class OBSRemux : public QDialog {
 	Q_OBJECT
 
 	QPointer<RemuxQueueModel> queueModel;
-	QThread remuxer;
-	QPointer<RemuxWorker> worker;
+
+	/* worker pool: each worker lives on its own thread and processes
+	 * one queue entry at a time */
+	std::vector<QThread *> remuxThreads;
+	std::vector<QPointer<RemuxWorker>> workers;
+	QList<RemuxWorker *> idleWorkers;
+
+	QHash<int, float> activeProgress;
+	int activeJobs = 0;
+	int completedJobs = 0;
+	int totalJobs = 0;
 
 	std::unique_ptr<Ui::OBSRemux> ui;
 
@@ -60,13 +72,10 @@ private slots:
 	void rowCountChanged(const QModelIndex &parent, int first, int last);
 
 public slots:
-	void updateProgress(float percent);
-	void remuxFinished(bool success);
+	void updateProgress(float percent, int row);
+	void remuxFinished(bool success, int row);
 	void beginRemux();
 	bool stopRemux();
 	void clearFinished();
 	void clearAll();
-
-signals:
-	void remux(const QString &source, const QString &target);
 };
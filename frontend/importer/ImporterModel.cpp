@@ -20,6 +20,9 @@
 #include <OBSApp.hpp>
 #include <importers/importers.hpp>
 
+#include <QPointer>
+#include <QThreadPool>
+
 #include "moc_ImporterModel.cpp"
 
 int ImporterModel::rowCount(const QModelIndex &) const
@@ -94,23 +97,57 @@ void ImporterModel::checkInputPath(int row)
 		entry.empty = true;
 		entry.selected = false;
 		entry.name = "";
-	} else {
-		entry.empty = false;
+		emit dataChanged(index(row, 0), index(row, ImporterColumn::Count));
+		return;
+	}
 
-		std::string program = DetectProgram(entry.path.toStdString());
-		entry.program = QTStr(program.c_str());
+	entry.empty = false;
 
-		if (program.empty()) {
-			entry.selected = false;
-		} else {
-			std::string name = GetSCName(entry.path.toStdString(), program);
-			entry.name = name.c_str();
-		}
-	}
+	/* Probing reads and parses the collection file, which is too slow
+	 * for the UI thread when many files are added at once.  Each path
+	 * is probed on the thread pool and the result is matched back to
+	 * its row afterwards, since rows may move in the meantime. */
+	QPointer<ImporterModel> guard(this);
+	QString path = entry.path;
+
+	QThreadPool::globalInstance()->start([guard, path]() {
+		std::string program = DetectProgram(path.toStdString());
+
+		QString name;
+		if (!program.empty())
+			name = GetSCName(path.toStdString(), program).c_str();
+
+		QMetaObject::invokeMethod(
+			App(),
+			[guard, path, program, name]() {
+				if (guard)
+					guard->inputPathChecked(path, program.c_str(), name);
+			},
+			Qt::QueuedConnection);
+	});
 
 	emit dataChanged(index(row, 0), index(row, ImporterColumn::Count));
 }
 
+void ImporterModel::inputPathChecked(const QString &path, const QString &program, const QString &name)
+{
+	for (int row = 0; row < options.length(); row++) {
+		ImporterEntry &entry = options[row];
+
+		if (entry.path != path)
+			continue;
+
+		entry.program = QTStr(program.toUtf8().constData());
+
+		if (program.isEmpty())
+			entry.selected = false;
+		else
+			entry.name = name;
+
+		emit dataChanged(index(row, 0), index(row, ImporterColumn::Count));
+	}
+}
+
 bool ImporterModel::setData(const QModelIndex &index, const QVariant &value, int role)
 {
 	if (role == ImporterEntryRole::NewPath) {
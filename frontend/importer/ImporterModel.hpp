@@ -58,4 +58,5 @@ private:
 	QList<ImporterEntry> options;
 
 	void checkInputPath(int row);
+	void inputPathChecked(const QString &path, const QString &program, const QString &name);
 };
@@ -31,6 +31,10 @@
 #include <QMimeData>
 #include <QPushButton>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "moc_OBSImporter.cpp"
 OBSImporter::OBSImporter(QWidget *parent) : QDialog(parent), optionsModel(new ImporterModel), ui(new Ui::OBSImporter)
 {
@@ -172,23 +176,57 @@ void OBSImporter::importCollections()
 	const std::filesystem::path sceneCollectionLocation =
 		App()->userScenesLocation / std::filesystem::u8path(OBSSceneCollectionPath);
 
+	struct ImportJob {
+		std::string path;
+		std::string name;
+		json11::Json res;
+	};
+
+	std::vector<ImportJob> jobs;
+
 	for (int i = 0; i < optionsModel->rowCount() - 1; i++) {
 		int selected = optionsModel->index(i, ImporterColumn::Selected).data(Qt::CheckStateRole).value<int>();
 
 		if (selected == Qt::Unchecked)
 			continue;
 
-		std::string pathStr = optionsModel->index(i, ImporterColumn::Path)
-					      .data(Qt::DisplayRole)
-					      .value<QString>()
-					      .toStdString();
-		std::string nameStr = optionsModel->index(i, ImporterColumn::Name)
-					      .data(Qt::DisplayRole)
-					      .value<QString>()
-					      .toStdString();
+		ImportJob job;
+		job.path = optionsModel->index(i, ImporterColumn::Path)
+				   .data(Qt::DisplayRole)
+				   .value<QString>()
+				   .toStdString();
+		job.name = optionsModel->index(i, ImporterColumn::Name)
+				   .data(Qt::DisplayRole)
+				   .value<QString>()
+				   .toStdString();
+		jobs.push_back(std::move(job));
+	}
 
-		json11::Json res;
-		ImportSC(pathStr, nameStr, res);
+	/* Translating collections is independent per file, so it runs in
+	 * parallel; only the naming and file writes below depend on shared
+	 * state and stay sequential. */
+	size_t threadCount = std::thread::hardware_concurrency();
+	if (threadCount == 0)
+		threadCount = 1;
+	if (threadCount > jobs.size())
+		threadCount = jobs.size();
+
+	std::atomic<size_t> nextJob(0);
+	std::vector<std::thread> workers;
+
+	for (size_t i = 0; i < threadCount; i++) {
+		workers.emplace_back([&]() {
+			size_t job;
+			while ((job = nextJob.fetch_add(1)) < jobs.size())
+				ImportSC(jobs[job].path, jobs[job].name, jobs[job].res);
+		});
+	}
+
+	for (std::thread &worker : workers)
+		worker.join();
+
+	for (ImportJob &job : jobs) {
+		json11::Json &res = job.res;
 
 		if (res != json11::Json()) {
 			json11::Json::object out = res.object_items();
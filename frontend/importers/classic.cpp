@@ -510,19 +510,9 @@ int ClassicImporter::ImportScenes(const string &path, string &name, Json &res)
 	return IMPORTER_SUCCESS;
 }
 
-bool ClassicImporter::Check(const string &path)
+bool ClassicImporter::CheckContents(const string &contents)
 {
-	BPtr<char> file_data = os_quick_read_utf8_file(path.c_str());
-
-	if (!file_data)
-		return false;
-
-	bool check = false;
-
-	if (strncmp(file_data, "scenes : {\r\n", 12) == 0)
-		check = true;
-
-	return check;
+	return contents.compare(0, 12, "scenes : {\r\n") == 0;
 }
 
 OBSImporterFiles ClassicImporter::FindFiles()
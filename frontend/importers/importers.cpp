@@ -17,12 +17,37 @@
 
 #include "importers.hpp"
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <sys/stat.h>
 
 using namespace std;
 using namespace json11;
 
 vector<unique_ptr<Importer>> importers;
 
+/* Detection results are cached per path so that re-probing a file (e.g.
+ * detection followed by the actual import) does not read and parse it
+ * again.  Entries are invalidated when the file's mtime changes.  Probing
+ * may run on multiple threads; the importer list itself is built once by
+ * ImportersInit before any probing starts. */
+struct DetectCacheEntry {
+	time_t modified;
+	string prog;
+};
+
+static mutex detectCacheMutex;
+static unordered_map<string, DetectCacheEntry> detectCache;
+
+static time_t GetFileModifiedTime(const string &path)
+{
+	struct stat st;
+	if (os_stat(path.c_str(), &st) != 0)
+		return 0;
+	return st.st_mtime;
+}
+
 void ImportersInit()
 {
 	importers.clear();
@@ -30,6 +55,9 @@ void ImportersInit()
 	importers.push_back(make_unique<ClassicImporter>());
 	importers.push_back(make_unique<SLImporter>());
 	importers.push_back(make_unique<XSplitImporter>());
+
+	lock_guard<mutex> lock(detectCacheMutex);
+	detectCache.clear();
 }
 
 int ImportSCFromProg(const string &path, string &name, const string &program, Json &res)
@@ -68,13 +96,35 @@ string DetectProgram(const string &path)
 		return "Null";
 	}
 
-	for (size_t i = 0; i < importers.size(); i++) {
-		if (importers[i]->Check(path)) {
-			return importers[i]->Prog();
+	time_t modified = GetFileModifiedTime(path);
+
+	{
+		lock_guard<mutex> lock(detectCacheMutex);
+		auto it = detectCache.find(path);
+		if (it != detectCache.end() && it->second.modified == modified)
+			return it->second.prog;
+	}
+
+	string prog = "Null";
+
+	/* Read the file once and let every importer check the contents,
+	 * rather than having each importer read it again. */
+	BPtr<char> file_data = os_quick_read_utf8_file(path.c_str());
+	if (file_data) {
+		string contents = file_data.Get();
+
+		for (size_t i = 0; i < importers.size(); i++) {
+			if (importers[i]->CheckContents(contents)) {
+				prog = importers[i]->Prog();
+				break;
+			}
 		}
 	}
 
-	return "Null";
+	lock_guard<mutex> lock(detectCacheMutex);
+	detectCache[path] = {modified, prog};
+
+	return prog;
 }
 
 string GetSCName(const string &path, const string &prog)
@@ -42,7 +42,14 @@ public:
 	virtual ~Importer() {}
 	virtual std::string Prog() { return "Null"; };
 	virtual int ImportScenes(const std::string &path, std::string &name, json11::Json &res) = 0;
-	virtual bool Check(const std::string &path) = 0;
+	/* Detection against already-read file contents, so that probing a
+	 * candidate file reads it from disk only once for all importers. */
+	virtual bool CheckContents(const std::string &contents) = 0;
+	virtual bool Check(const std::string &path)
+	{
+		BPtr<char> file_data = os_quick_read_utf8_file(path.c_str());
+		return file_data && CheckContents(file_data.Get());
+	}
 	virtual std::string Name(const std::string &path) = 0;
 	virtual OBSImporterFiles FindFiles()
 	{
@@ -55,7 +62,7 @@ class ClassicImporter : public Importer {
 public:
 	std::string Prog() { return "OBSClassic"; };
 	int ImportScenes(const std::string &path, std::string &name, json11::Json &res);
-	bool Check(const std::string &path);
+	bool CheckContents(const std::string &contents);
 	std::string Name(const std::string &path);
 	OBSImporterFiles FindFiles();
 };
@@ -64,7 +71,7 @@ class StudioImporter : public Importer {
 public:
 	std::string Prog() { return "OBSStudio"; };
 	int ImportScenes(const std::string &path, std::string &name, json11::Json &res);
-	bool Check(const std::string &path);
+	bool CheckContents(const std::string &contents);
 	std::string Name(const std::string &path);
 };
 
@@ -72,7 +79,7 @@ class SLImporter : public Importer {
 public:
 	std::string Prog() { return "Streamlabs"; };
 	int ImportScenes(const std::string &path, std::string &name, json11::Json &res);
-	bool Check(const std::string &path);
+	bool CheckContents(const std::string &contents);
 	std::string Name(const std::string &path);
 	OBSImporterFiles FindFiles();
 };
@@ -81,7 +88,7 @@ class XSplitImporter : public Importer {
 public:
 	std::string Prog() { return "XSplitBroadcaster"; };
 	int ImportScenes(const std::string &path, std::string &name, json11::Json &res);
-	bool Check(const std::string &path);
+	bool CheckContents(const std::string &contents);
 	std::string Name(const std::string &) { return "XSplit Import"; };
 	OBSImporterFiles FindFiles();
 };
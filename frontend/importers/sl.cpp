@@ -460,22 +460,23 @@ int SLImporter::ImportScenes(const string &path, string &name, Json &res)
 	return result;
 }
 
-bool SLImporter::Check(const string &path)
+bool SLImporter::CheckContents(const string &contents)
 {
 	bool check = false;
 
-	BPtr<char> file_data = os_quick_read_utf8_file(path.c_str());
+	/* Every Streamlabs node carries "nodeType"; when it is absent the
+	 * full JSON parse can be skipped entirely. */
+	if (contents.find("\"nodeType\"") == string::npos)
+		return false;
 
-	if (file_data) {
-		string err;
-		Json root = Json::parse(file_data, err);
+	string err;
+	Json root = Json::parse(contents, err);
 
-		if (!root.is_null()) {
-			string node_type = root["nodeType"].string_value();
+	if (!root.is_null()) {
+		string node_type = root["nodeType"].string_value();
 
-			if (node_type == "RootNode")
-				check = true;
-		}
+		if (node_type == "RootNode")
+			check = true;
 	}
 
 	return check;
@@ -204,11 +204,14 @@ void TranslatePaths(Json &res, const string &rootDir)
 	}
 }
 
-bool StudioImporter::Check(const string &path)
+bool StudioImporter::CheckContents(const string &contents)
 {
-	BPtr<char> file_data = os_quick_read_utf8_file(path.c_str());
+	/* Cheap pre-filter before committing to a full JSON parse. */
+	if (contents.find("\"current_scene\"") == string::npos)
+		return false;
+
 	string err;
-	Json collection = Json::parse(file_data, err);
+	Json collection = Json::parse(contents, err);
 
 	if (err != "")
 		return false;
@@ -455,16 +455,11 @@ int XSplitImporter::ImportScenes(const string &path, string &name, json11::Json
 	return IMPORTER_SUCCESS;
 }
 
-bool XSplitImporter::Check(const string &path)
+bool XSplitImporter::CheckContents(const string &contents)
 {
 	bool check = false;
 
-	BPtr<char> file_data = os_quick_read_utf8_file(path.c_str());
-
-	if (!file_data)
-		return false;
-
-	string pos = file_data.Get();
+	string pos = contents;
 
 	string line = ReadLine(pos);
 	while (!line.empty()) {
@@ -425,6 +425,12 @@ static void create_log_file(fstream &logFile)
 	if (logFile.is_open()) {
 		delete_oldest_file(false, "obs-studio/logs");
 		base_set_log_handler(do_log, &logFile);
+#ifndef _DEBUG
+		/* do_log drops debug messages unless --verbose is given, so have
+		 * libobs filter them before they are even formatted */
+		if (!log_verbose)
+			base_set_log_level(LOG_INFO);
+#endif
 	} else {
 		blog(LOG_ERROR, "Failed to open log file");
 	}
@@ -908,6 +908,10 @@ OBSBasicSettings::~OBSBasicSettings()
 	delete ui->filenameFormatting->completer();
 	main->EnableOutputs(true);
 
+	/* re-enumerate in the background so devices plugged in since the
+	 * last enumeration show up the next time the dialog opens */
+	main->deviceEnumCache.Refresh();
+
 	App()->UpdateHotkeyFocusSetting();
 
 	EnableThreadedMessageBoxes(false);
@@ -2221,10 +2225,8 @@ static inline void LoadListValue(QComboBox *widget, const char *text, const char
 	widget->addItem(QT_UTF8(text), QT_UTF8(val));
 }
 
-void OBSBasicSettings::LoadListValues(QComboBox *widget, obs_property_t *prop, int index)
+void OBSBasicSettings::LoadListValues(QComboBox *widget, const std::vector<DeviceEnumItem> &items, int index)
 {
-	size_t count = obs_property_list_item_count(prop);
-
 	OBSSourceAutoRelease source = obs_get_output_source(index);
 	const char *deviceId = nullptr;
 	OBSDataAutoRelease settings = nullptr;
@@ -2237,11 +2239,8 @@ void OBSBasicSettings::LoadListValues(QComboBox *widget, obs_property_t *prop, i
 
 	widget->addItem(QTStr("Basic.Settings.Audio.Disabled"), "disabled");
 
-	for (size_t i = 0; i < count; i++) {
-		const char *name = obs_property_list_item_name(prop, i);
-		const char *val = obs_property_list_item_string(prop, i);
-		LoadListValue(widget, name, val);
-	}
+	for (const DeviceEnumItem &item : items)
+		LoadListValue(widget, item.name.c_str(), item.id.c_str());
 
 	if (deviceId) {
 		QVariant var(QT_UTF8(deviceId));
@@ -2261,27 +2260,16 @@ void OBSBasicSettings::LoadListValues(QComboBox *widget, obs_property_t *prop, i
 
 void OBSBasicSettings::LoadAudioDevices()
 {
-	const char *input_id = App()->InputAudioSource();
-	const char *output_id = App()->OutputAudioSource();
-
-	obs_properties_t *input_props = obs_get_source_properties(input_id);
-	obs_properties_t *output_props = obs_get_source_properties(output_id);
+	std::vector<DeviceEnumItem> inputs = main->deviceEnumCache.AudioInputDevices();
+	std::vector<DeviceEnumItem> outputs = main->deviceEnumCache.AudioOutputDevices();
 
-	if (input_props) {
-		obs_property_t *inputs = obs_properties_get(input_props, "device_id");
-		LoadListValues(ui->auxAudioDevice1, inputs, 3);
-		LoadListValues(ui->auxAudioDevice2, inputs, 4);
-		LoadListValues(ui->auxAudioDevice3, inputs, 5);
-		LoadListValues(ui->auxAudioDevice4, inputs, 6);
-		obs_properties_destroy(input_props);
-	}
+	LoadListValues(ui->auxAudioDevice1, inputs, 3);
+	LoadListValues(ui->auxAudioDevice2, inputs, 4);
+	LoadListValues(ui->auxAudioDevice3, inputs, 5);
+	LoadListValues(ui->auxAudioDevice4, inputs, 6);
 
-	if (output_props) {
-		obs_property_t *outputs = obs_properties_get(output_props, "device_id");
-		LoadListValues(ui->desktopAudioDevice1, outputs, 1);
-		LoadListValues(ui->desktopAudioDevice2, outputs, 2);
-		obs_properties_destroy(output_props);
-	}
+	LoadListValues(ui->desktopAudioDevice1, outputs, 1);
+	LoadListValues(ui->desktopAudioDevice2, outputs, 2);
 
 	if (obs_video_active()) {
 		ui->sampleRate->setEnabled(false);
@@ -4765,17 +4753,12 @@ void OBSBasicSettings::FillAudioMonitoringDevices()
 {
 	QComboBox *cb = ui->monitoringDevice;
 
-	auto enum_devices = [](void *param, const char *name, const char *id) {
-		QComboBox *cb = (QComboBox *)param;
-		cb->addItem(name, id);
-		return true;
-	};
-
 	cb->addItem(QTStr("Basic.Settings.Advanced.Audio.MonitoringDevice"
 			  ".Default"),
 		    "default");
 
-	obs_enum_audio_monitoring_devices(enum_devices, cb);
+	for (const DeviceEnumItem &item : main->deviceEnumCache.AudioMonitoringDevices())
+		cb->addItem(item.name.c_str(), item.id.c_str());
 }
 
 void OBSBasicSettings::SimpleRecordingQualityChanged()
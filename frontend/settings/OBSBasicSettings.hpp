@@ -20,6 +20,7 @@
 
 #include "ui_OBSBasicSettings.h"
 
+#include <utility/DeviceEnumCache.hpp>
 #include <utility/FFmpegShared.hpp>
 
 #include <QPointer>
@@ -259,7 +260,7 @@ private:
 	void SetAdvOutputFFmpegEnablement(FFmpegCodecType encoderType, bool enabled, bool enableEncode = false);
 
 	/* audio */
-	void LoadListValues(QComboBox *widget, obs_property_t *prop, int index);
+	void LoadListValues(QComboBox *widget, const std::vector<DeviceEnumItem> &items, int index);
 	void LoadAudioDevices();
 	void LoadAudioSources();
 
@@ -0,0 +1,112 @@
+#include "DeviceEnumCache.hpp"
+
+#include <OBSApp.hpp>
+
+#include <util/profiler.hpp>
+
+static void EnumAudioDevices(const char *sourceId, std::vector<DeviceEnumItem> &out)
+{
+	if (!sourceId)
+		return;
+
+	obs_properties_t *props = obs_get_source_properties(sourceId);
+	if (!props)
+		return;
+
+	obs_property_t *prop = obs_properties_get(props, "device_id");
+	size_t count = obs_property_list_item_count(prop);
+
+	for (size_t i = 0; i < count; i++) {
+		const char *name = obs_property_list_item_name(prop, i);
+		const char *id = obs_property_list_item_string(prop, i);
+		out.push_back({name, id});
+	}
+
+	obs_properties_destroy(props);
+}
+
+DeviceEnumCache::~DeviceEnumCache()
+{
+	if (worker.joinable())
+		worker.join();
+}
+
+void DeviceEnumCache::EnumerateAll()
+{
+	ProfileScope("DeviceEnumCache::EnumerateAll");
+
+	std::vector<DeviceEnumItem> inputs;
+	std::vector<DeviceEnumItem> outputs;
+	std::vector<DeviceEnumItem> monitors;
+
+	EnumAudioDevices(App()->InputAudioSource(), inputs);
+	EnumAudioDevices(App()->OutputAudioSource(), outputs);
+
+	auto enum_devices = [](void *param, const char *name, const char *id) {
+		auto *list = (std::vector<DeviceEnumItem> *)param;
+		list->push_back({name, id});
+		return true;
+	};
+
+	obs_enum_audio_monitoring_devices(enum_devices, &monitors);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	audioInputs = std::move(inputs);
+	audioOutputs = std::move(outputs);
+	monitoringDevices = std::move(monitors);
+	populated = true;
+}
+
+void DeviceEnumCache::Prefetch()
+{
+	Refresh();
+}
+
+void DeviceEnumCache::Refresh()
+{
+	/* only the UI thread manages the worker, so joining here cannot
+	 * deadlock against EnumerateAll taking the results mutex */
+	if (worker.joinable())
+		worker.join();
+
+	worker = std::thread([this] { EnumerateAll(); });
+}
+
+void DeviceEnumCache::EnsurePopulated()
+{
+	if (worker.joinable())
+		worker.join();
+
+	bool done;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		done = populated;
+	}
+
+	if (!done)
+		EnumerateAll();
+}
+
+std::vector<DeviceEnumItem> DeviceEnumCache::AudioInputDevices()
+{
+	EnsurePopulated();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	return audioInputs;
+}
+
+std::vector<DeviceEnumItem> DeviceEnumCache::AudioOutputDevices()
+{
+	EnsurePopulated();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	return audioOutputs;
+}
+
+std::vector<DeviceEnumItem> DeviceEnumCache::AudioMonitoringDevices()
+{
+	EnsurePopulated();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	return monitoringDevices;
+}
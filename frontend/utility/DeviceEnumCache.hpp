@@ -0,0 +1,51 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Caches audio device enumeration for the settings UI.
+ *
+ * Querying the audio capture sources' device lists goes through the platform
+ * backends and can take seconds on machines with a lot of capture hardware,
+ * which used to stall the settings dialog on open.  The cache is warmed on a
+ * worker thread during startup; the dialog reads the cached lists instantly
+ * and kicks off a background refresh when it closes so that devices plugged
+ * in since the last enumeration show up the next time it is opened. */
+
+struct DeviceEnumItem {
+	std::string name;
+	std::string id;
+};
+
+class DeviceEnumCache {
+public:
+	~DeviceEnumCache();
+
+	/* Start enumerating on a worker thread.  Call from the UI thread. */
+	void Prefetch();
+
+	/* Re-enumerate in the background; cached lists stay available and are
+	 * swapped once the new enumeration finishes.  Call from the UI
+	 * thread. */
+	void Refresh();
+
+	/* Return cached lists, enumerating synchronously if the cache was
+	 * never populated.  Call from the UI thread. */
+	std::vector<DeviceEnumItem> AudioInputDevices();
+	std::vector<DeviceEnumItem> AudioOutputDevices();
+	std::vector<DeviceEnumItem> AudioMonitoringDevices();
+
+private:
+	void EnumerateAll();
+	void EnsurePopulated();
+
+	std::mutex mutex;
+	std::thread worker;
+	bool populated = false;
+
+	std::vector<DeviceEnumItem> audioInputs;
+	std::vector<DeviceEnumItem> audioOutputs;
+	std::vector<DeviceEnumItem> monitoringDevices;
+};
@@ -338,19 +338,20 @@ void RemuxQueueModel::endProcessing()
 	emit dataChanged(index(0, RemuxEntryColumn::State), index(queue.length(), RemuxEntryColumn::State));
 }
 
-bool RemuxQueueModel::beginNextEntry(QString &inputPath, QString &outputPath)
+bool RemuxQueueModel::beginNextEntry(QString &inputPath, QString &outputPath, int &row)
 {
 	bool anyStarted = false;
 
-	for (int row = 0; row < queue.length(); row++) {
-		RemuxQueueEntry &entry = queue[row];
+	for (int i = 0; i < queue.length(); i++) {
+		RemuxQueueEntry &entry = queue[i];
 		if (entry.state == RemuxEntryState::Pending) {
 			entry.state = RemuxEntryState::InProgress;
 
 			inputPath = entry.sourcePath;
 			outputPath = entry.targetPath;
+			row = i;
 
-			QModelIndex index = this->index(row, RemuxEntryColumn::State);
+			QModelIndex index = this->index(i, RemuxEntryColumn::State);
 			emit dataChanged(index, index);
 
 			anyStarted = true;
@@ -361,20 +362,31 @@ bool RemuxQueueModel::beginNextEntry(QString &inputPath, QString &outputPath)
 	return anyStarted;
 }
 
-void RemuxQueueModel::finishEntry(bool success)
+void RemuxQueueModel::finishEntry(int row, bool success)
 {
-	for (int row = 0; row < queue.length(); row++) {
-		RemuxQueueEntry &entry = queue[row];
-		if (entry.state == RemuxEntryState::InProgress) {
-			if (success)
-				entry.state = RemuxEntryState::Complete;
-			else
-				entry.state = RemuxEntryState::Error;
-
-			QModelIndex index = this->index(row, RemuxEntryColumn::State);
-			emit dataChanged(index, index);
+	if (row < 0 || row >= queue.length())
+		return;
 
-			break;
-		}
-	}
+	RemuxQueueEntry &entry = queue[row];
+	if (entry.state != RemuxEntryState::InProgress)
+		return;
+
+	if (success)
+		entry.state = RemuxEntryState::Complete;
+	else
+		entry.state = RemuxEntryState::Error;
+
+	QModelIndex index = this->index(row, RemuxEntryColumn::State);
+	emit dataChanged(index, index);
+}
+
+int RemuxQueueModel::pendingEntryCount() const
+{
+	int count = 0;
+
+	for (const RemuxQueueEntry &entry : queue)
+		if (entry.state == RemuxEntryState::Pending)
+			count++;
+
+	return count;
 }
@@ -53,8 +53,9 @@ public:
 	bool checkForErrors() const;
 	void beginProcessing();
 	void endProcessing();
-	bool beginNextEntry(QString &inputPath, QString &outputPath);
-	void finishEntry(bool success);
+	bool beginNextEntry(QString &inputPath, QString &outputPath, int &row);
+	void finishEntry(int row, bool success);
+	int pendingEntryCount() const;
 	bool canClearFinished() const;
 	void clearFinished();
 	void clearAll();
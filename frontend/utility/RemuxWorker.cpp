@@ -25,13 +25,15 @@ void RemuxWorker::UpdateProgress(float percent)
 	if (abs(lastProgress - percent) < 0.1f)
 		return;
 
-	emit updateProgress(percent);
+	emit updateProgress(percent, jobRow);
 	lastProgress = percent;
 }
 
-void RemuxWorker::remux(const QString &source, const QString &target)
+void RemuxWorker::remux(int row, const QString &source, const QString &target)
 {
 	isWorking = true;
+	jobRow = row;
+	lastProgress = 0.f;
 
 	auto callback = [](void *data, float percent) {
 		RemuxWorker *rw = static_cast<RemuxWorker *>(data);
@@ -57,6 +59,7 @@ void RemuxWorker::remux(const QString &source, const QString &target)
 	}
 
 	isWorking = false;
+	jobRow = -1;
 
-	emit remuxFinished(!stopped && success);
+	emit remuxFinished(!stopped && success, row);
 }
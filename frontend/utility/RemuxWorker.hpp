@@ -27,18 +27,21 @@ class RemuxWorker : public QObject {
 
 	bool isWorking;
 
+	/* queue row of the entry being remuxed, -1 outside of jobs */
+	int jobRow;
+
 	float lastProgress;
 	void UpdateProgress(float percent);
 
-	explicit RemuxWorker() : isWorking(false) {}
+	explicit RemuxWorker() : isWorking(false), jobRow(-1) {}
 	virtual ~RemuxWorker() {};
 
 private slots:
-	void remux(const QString &source, const QString &target);
+	void remux(int row, const QString &source, const QString &target);
 
 signals:
-	void updateProgress(float percent);
-	void remuxFinished(bool success);
+	void updateProgress(float percent, int row);
+	void remuxFinished(bool success, int row);
 
 	friend class OBSRemux;
 };
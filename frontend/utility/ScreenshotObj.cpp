@@ -32,6 +32,20 @@
 
 static void ScreenshotTick(void *param, float);
 
+/* called on the graphics thread once the staging copy is complete */
+static void ScreenshotReadback(void *param, uint8_t *data, uint32_t linesize, uint32_t, uint32_t,
+			       enum gs_color_format)
+{
+	ScreenshotObj *obj = static_cast<ScreenshotObj *>(param);
+
+	if (data) {
+		obj->Copy(data, linesize);
+		QMetaObject::invokeMethod(obj, "Save");
+	} else {
+		QMetaObject::invokeMethod(obj, "deleteLater");
+	}
+}
+
 ScreenshotObj::ScreenshotObj(obs_source_t *source) : weakSource(OBSGetWeakRef(source))
 {
 	obs_add_tick_callback(ScreenshotTick, this);
@@ -40,7 +54,7 @@ ScreenshotObj::ScreenshotObj(obs_source_t *source) : weakSource(OBSGetWeakRef(so
 ScreenshotObj::~ScreenshotObj()
 {
 	obs_enter_graphics();
-	gs_stagesurface_destroy(stagesurf);
+	obs_cancel_texture_readback(this);
 	gs_texrender_destroy(texrender);
 	obs_leave_graphics();
 
@@ -95,7 +109,6 @@ void ScreenshotObj::Screenshot()
 	const enum gs_color_format format = gs_get_format_from_space(space);
 
 	texrender = gs_texrender_create(format, GS_ZS_NONE);
-	stagesurf = gs_stagesurface_create(cx, cy, format);
 
 	if (gs_texrender_begin_with_color_space(texrender, cx, cy, space)) {
 		vec4 zero;
@@ -118,36 +131,26 @@ void ScreenshotObj::Screenshot()
 		gs_blend_state_pop();
 		gs_texrender_end(texrender);
 	}
-}
 
-void ScreenshotObj::Download()
-{
-	gs_stage_texture(stagesurf, gs_texrender_get_texture(texrender));
+	obs_request_texture_readback(gs_texrender_get_texture(texrender), 0, 0, ScreenshotReadback, this);
 }
 
-void ScreenshotObj::Copy()
+void ScreenshotObj::Copy(const uint8_t *videoData, uint32_t videoLinesize)
 {
-	uint8_t *videoData = nullptr;
-	uint32_t videoLinesize = 0;
-
-	if (gs_stagesurface_map(stagesurf, &videoData, &videoLinesize)) {
-		if (gs_stagesurface_get_color_format(stagesurf) == GS_RGBA16F) {
-			const uint32_t linesize = cx * 8;
-			half_bytes.reserve(cx * cy * 8);
-
-			for (uint32_t y = 0; y < cy; y++) {
-				const uint8_t *const line = videoData + (y * videoLinesize);
-				half_bytes.insert(half_bytes.end(), line, line + linesize);
-			}
-		} else {
-			image = QImage(cx, cy, QImage::Format::Format_RGBX8888);
+	if (gs_texrender_get_format(texrender) == GS_RGBA16F) {
+		const uint32_t linesize = cx * 8;
+		half_bytes.reserve(cx * cy * 8);
 
-			int linesize = image.bytesPerLine();
-			for (int y = 0; y < (int)cy; y++)
-				memcpy(image.scanLine(y), videoData + (y * videoLinesize), linesize);
+		for (uint32_t y = 0; y < cy; y++) {
+			const uint8_t *const line = videoData + (y * videoLinesize);
+			half_bytes.insert(half_bytes.end(), line, line + linesize);
 		}
+	} else {
+		image = QImage(cx, cy, QImage::Format::Format_RGBX8888);
 
-		gs_stagesurface_unmap(stagesurf);
+		int linesize = image.bytesPerLine();
+		for (int y = 0; y < (int)cy; y++)
+			memcpy(image.scanLine(y), videoData + (y * videoLinesize), linesize);
 	}
 }
 
@@ -279,36 +282,15 @@ void ScreenshotObj::MuxAndFinish()
 	deleteLater();
 }
 
-#define STAGE_SCREENSHOT 0
-#define STAGE_DOWNLOAD 1
-#define STAGE_COPY_AND_SAVE 2
-#define STAGE_FINISH 3
-
 static void ScreenshotTick(void *param, float)
 {
 	ScreenshotObj *data = static_cast<ScreenshotObj *>(param);
 
-	if (data->stage == STAGE_FINISH) {
-		return;
-	}
-
+	/* render and stage once; the readback service calls back when the
+	 * copy is complete */
 	obs_enter_graphics();
-
-	switch (data->stage) {
-	case STAGE_SCREENSHOT:
-		data->Screenshot();
-		break;
-	case STAGE_DOWNLOAD:
-		data->Download();
-		break;
-	case STAGE_COPY_AND_SAVE:
-		data->Copy();
-		QMetaObject::invokeMethod(data, "Save");
-		obs_remove_tick_callback(ScreenshotTick, data);
-		break;
-	}
-
+	data->Screenshot();
 	obs_leave_graphics();
 
-	data->stage++;
+	obs_remove_tick_callback(ScreenshotTick, data);
 }
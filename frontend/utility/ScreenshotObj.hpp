@@ -31,12 +31,10 @@ public:
 	ScreenshotObj(obs_source_t *source);
 	~ScreenshotObj() override;
 	void Screenshot();
-	void Download();
-	void Copy();
+	void Copy(const uint8_t *data, uint32_t linesize);
 	void MuxAndFinish();
 
 	gs_texrender_t *texrender = nullptr;
-	gs_stagesurf_t *stagesurf = nullptr;
 	OBSWeakSource weakSource;
 	std::string path;
 	QImage image;
@@ -45,8 +43,6 @@ public:
 	uint32_t cy;
 	std::thread th;
 
-	int stage = 0;
-
 public slots:
 	void Save();
 };
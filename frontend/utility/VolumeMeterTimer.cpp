@@ -20,7 +20,7 @@ void VolumeMeterTimer::timerEvent(QTimerEvent *)
 		if (meter->needLayoutChange()) {
 			// Tell paintEvent to update layout and paint everything
 			meter->update();
-		} else {
+		} else if (meter->needsRepaint()) {
 			// Tell paintEvent to paint only the bars
 			meter->update(meter->getBarRect());
 		}
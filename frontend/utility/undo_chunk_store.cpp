@@ -0,0 +1,132 @@
+#include "undo_chunk_store.hpp"
+
+#include <cstring>
+
+/* Content-defined chunking: a gear rolling hash over the last bytes of the
+ * stream, with a cut whenever the low bits are all zero.  Average chunk size
+ * is 4 KiB; minimum and maximum bounds keep degenerate inputs (long runs,
+ * no boundaries) from producing pathological chunk counts. */
+
+#define CHUNK_BOUNDARY_MASK 0xFFF /* 1 in 4096 bytes on average */
+#define CHUNK_MIN_SIZE 512
+#define CHUNK_MAX_SIZE 65536
+
+/* expired index entries are swept every N store() calls */
+#define COMPACT_INTERVAL 64
+
+static uint64_t gear_table[256];
+static bool gear_table_initialized = false;
+
+static void init_gear_table()
+{
+	/* splitmix64, fixed seed: the table only has to be well-mixed */
+	uint64_t x = 0x9E3779B97F4A7C15ULL;
+
+	for (int i = 0; i < 256; i++) {
+		x += 0x9E3779B97F4A7C15ULL;
+		uint64_t z = x;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		gear_table[i] = z ^ (z >> 31);
+	}
+
+	gear_table_initialized = true;
+}
+
+static uint64_t hash_chunk(const char *data, size_t len)
+{
+	/* FNV-1a */
+	uint64_t hash = 0xCBF29CE484222325ULL;
+
+	for (size_t i = 0; i < len; i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= 0x100000001B3ULL;
+	}
+
+	return hash;
+}
+
+std::string undo_chunked_data::str() const
+{
+	std::string out;
+	out.reserve(total);
+
+	for (auto &chunk : chunks)
+		out.append(*chunk);
+
+	return out;
+}
+
+std::shared_ptr<const std::string> undo_chunk_store::intern(const char *data, size_t len)
+{
+	uint64_t hash = hash_chunk(data, len);
+
+	auto range = index.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it) {
+		std::shared_ptr<const std::string> existing = it->second.lock();
+		if (existing && existing->size() == len && memcmp(existing->data(), data, len) == 0)
+			return existing;
+	}
+
+	auto chunk = std::make_shared<const std::string>(data, len);
+	index.emplace(hash, chunk);
+	return chunk;
+}
+
+void undo_chunk_store::compact()
+{
+	for (auto it = index.begin(); it != index.end();) {
+		if (it->second.expired())
+			it = index.erase(it);
+		else
+			++it;
+	}
+}
+
+undo_chunked_data undo_chunk_store::store(const std::string &data)
+{
+	undo_chunked_data out;
+
+	if (!gear_table_initialized)
+		init_gear_table();
+
+	if (++ops % COMPACT_INTERVAL == 0)
+		compact();
+
+	const char *cursor = data.data();
+	size_t remaining = data.size();
+
+	while (remaining) {
+		uint64_t hash = 0;
+		size_t len = 0;
+		size_t max = remaining < CHUNK_MAX_SIZE ? remaining : CHUNK_MAX_SIZE;
+
+		while (len < max) {
+			hash = (hash << 1) + gear_table[(unsigned char)cursor[len]];
+			len++;
+
+			if (len >= CHUNK_MIN_SIZE && (hash & CHUNK_BOUNDARY_MASK) == 0)
+				break;
+		}
+
+		out.chunks.push_back(intern(cursor, len));
+		out.total += len;
+		cursor += len;
+		remaining -= len;
+	}
+
+	return out;
+}
+
+size_t undo_chunk_store::unique_bytes() const
+{
+	size_t bytes = 0;
+
+	for (auto &entry : index) {
+		std::shared_ptr<const std::string> chunk = entry.second.lock();
+		if (chunk)
+			bytes += chunk->size();
+	}
+
+	return bytes;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Content-addressed storage for undo/redo snapshots.
+ *
+ * Undo records carry full serialized scene state; consecutive records differ
+ * only by the edit between them.  Snapshots are split into content-defined
+ * chunks (a rolling hash picks the cut points, so an insertion only reshapes
+ * the chunks around it) and identical chunks are stored once and shared by
+ * reference, making stack memory roughly proportional to what actually
+ * changed instead of snapshot-size times stack-depth. */
+
+class undo_chunked_data {
+	std::vector<std::shared_ptr<const std::string>> chunks;
+	size_t total = 0;
+
+	friend class undo_chunk_store;
+
+public:
+	/* Reassembles the original snapshot */
+	std::string str() const;
+
+	size_t size() const { return total; }
+};
+
+class undo_chunk_store {
+	std::unordered_multimap<uint64_t, std::weak_ptr<const std::string>> index;
+	size_t ops = 0;
+
+	std::shared_ptr<const std::string> intern(const char *data, size_t len);
+	void compact();
+
+public:
+	undo_chunked_data store(const std::string &data);
+
+	/* Bytes held by chunks still referenced by at least one record */
+	size_t unique_bytes() const;
+};
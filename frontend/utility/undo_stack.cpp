@@ -48,11 +48,11 @@ void undo_stack::add_action(const QString &name, const undo_redo_cb &undo, const
 
 	if (last_is_repeatable && repeatable && name == undo_items[0].name) {
 		undo_items[0].redo = redo;
-		undo_items[0].redo_data = redo_data;
+		undo_items[0].redo_data = chunk_store.store(redo_data);
 		return;
 	}
 
-	undo_redo_t n = {name, undo_data, redo_data, undo, redo};
+	undo_redo_t n = {name, chunk_store.store(undo_data), chunk_store.store(redo_data), undo, redo};
 
 	last_is_repeatable = repeatable;
 	undo_items.push_front(n);
@@ -73,7 +73,7 @@ void undo_stack::undo()
 	last_is_repeatable = false;
 
 	undo_redo_t temp = undo_items.front();
-	temp.undo(temp.undo_data);
+	temp.undo(temp.undo_data.str());
 	redo_items.push_front(temp);
 	undo_items.pop_front();
 
@@ -96,7 +96,7 @@ void undo_stack::redo()
 	last_is_repeatable = false;
 
 	undo_redo_t temp = redo_items.front();
-	temp.redo(temp.redo_data);
+	temp.redo(temp.redo_data.str());
 	undo_items.push_front(temp);
 	redo_items.pop_front();
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ui_OBSBasic.h"
+#include "undo_chunk_store.hpp"
 
 #include <QObject>
 #include <QString>
@@ -18,13 +19,16 @@ class undo_stack : public QObject {
 
 	struct undo_redo_t {
 		QString name;
-		std::string undo_data;
-		std::string redo_data;
+		/* snapshots are chunked with structural sharing; see
+		 * undo_chunk_store.hpp */
+		undo_chunked_data undo_data;
+		undo_chunked_data redo_data;
 		undo_redo_cb undo;
 		undo_redo_cb redo;
 	};
 
 	ui_ptr ui;
+	undo_chunk_store chunk_store;
 	std::deque<undo_redo_t> undo_items;
 	std::deque<undo_redo_t> redo_items;
 	int disable_refs = 0;
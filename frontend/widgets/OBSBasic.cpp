@@ -989,6 +989,11 @@ void OBSBasic::OBSInit()
 
 	LogEncoders();
 
+	/* audio device lists can take a while to enumerate on some systems;
+	 * warm the cache off the UI thread so the settings dialog opens
+	 * instantly */
+	deviceEnumCache.Prefetch();
+
 	blog(LOG_INFO, STARTUP_SEPARATOR);
 
 	if (!InitService())
@@ -1328,6 +1333,8 @@ OBSBasic::~OBSBasic()
 	if (patronJsonThread && patronJsonThread->isRunning())
 		patronJsonThread->wait();
 
+	FinishPendingCollectionWrite();
+
 	delete screenshotData;
 	delete previewProjector;
 	delete studioProgramProjector;
@@ -1385,6 +1392,7 @@ OBSBasic::~OBSBasic()
 	gs_vertexbuffer_destroy(leftLine);
 	gs_vertexbuffer_destroy(topLine);
 	gs_vertexbuffer_destroy(rightLine);
+	gs_texrender_destroy(studioPreviewTexrender);
 	obs_leave_graphics();
 
 	/* When shutting down, sometimes source references can get in to the
@@ -23,6 +23,7 @@
 #include <OBSApp.hpp>
 #include <oauth/Auth.hpp>
 #include <utility/BasicOutputHandler.hpp>
+#include <utility/DeviceEnumCache.hpp>
 #include <utility/OBSCanvas.hpp>
 #include <utility/VCamConfig.hpp>
 #include <utility/platform.hpp>
@@ -43,6 +44,9 @@ Q_DECLARE_METATYPE(OBSSource);
 #include <QSystemTrayIcon>
 
 #include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 extern volatile bool recording_paused;
 
@@ -309,6 +313,8 @@ public:
 	 * warning for `ui` while initializing `undo_s`. */
 	undo_stack undo_s;
 
+	DeviceEnumCache deviceEnumCache;
+
 	explicit OBSBasic(QWidget *parent = 0);
 	virtual ~OBSBasic();
 
@@ -1047,6 +1053,7 @@ private:
 	long disableSaving = 1;
 	bool projectChanged = false;
 	bool clearingFailed = false;
+	std::thread collectionWriteThread;
 
 	QPointer<OBSMissingFiles> missDialog;
 
@@ -1061,6 +1068,7 @@ private:
 	void ClearSceneData();
 	void LogScenes();
 	void SaveProjectNow();
+	void FinishPendingCollectionWrite();
 	void ShowMissingFilesDialog(obs_missing_files_t *files);
 
 	void SetupNewSceneCollection(const std::string &collectionName);
@@ -1255,10 +1263,22 @@ private:
 	static void SceneRefreshed(void *data, calldata_t *params);
 	static void SceneItemAdded(void *data, calldata_t *params);
 
+	/* Scene signals are coalesced so that bulk operations (scene
+	 * collection load, script-driven edits) post one queued UI event
+	 * instead of one per libobs signal. */
+	std::mutex pendingSceneSignalsMutex;
+	std::vector<OBSSceneItem> pendingAddedItems;
+	std::vector<OBSScene> pendingReorderScenes;
+	std::vector<OBSScene> pendingRefreshScenes;
+	bool sceneSignalDrainQueued = false;
+
+	void QueueSceneSignalDrain();
+
 public slots:
 	void on_actionResetTransform_triggered();
 
 private slots:
+	void DrainSceneSignals();
 	void AddSceneItem(OBSSceneItem item);
 	void AddScene(OBSSource source);
 	void RemoveScene(OBSSource source);
@@ -1412,6 +1432,13 @@ private:
 	int programCX = 0, programCY = 0;
 	float programScale = 0.0f;
 
+	/* studio mode preview runs at a reduced rate; the scene is rendered
+	 * into this texture and reused until the next refresh is due */
+	gs_texrender_t *studioPreviewTexrender = nullptr;
+	uint64_t studioPreviewLastRender = 0;
+	obs_source_t *studioPreviewLastScene = nullptr;
+
+	void DrawStudioModePreview(obs_source_t *source, uint32_t cx, uint32_t cy);
 	void CreateProgramDisplay();
 	void CreateProgramOptions();
 	void SetPreviewProgramMode(bool enabled);
@@ -1598,6 +1598,16 @@ void OBSBasicPreview::mouseMoveEvent(QMouseEvent *event)
 		mouseMoved = true;
 		mousePos = pos;
 	} else {
+		/* The hover hit test walks every scene item; high-rate mice
+		 * deliver far more move events than the display can show, so
+		 * clamp the walk to roughly the display rate and keep the
+		 * previous hover result in between. */
+		uint64_t interval = obs_get_frame_interval_ns();
+		uint64_t ts = os_gettime_ns();
+		if (interval && ts - lastHoverTestTime < interval)
+			return;
+		lastHoverTestTime = ts;
+
 		vec2 pos = GetMouseEventPos(event);
 		OBSSceneItem item = GetItemAtPos(pos, true);
 
@@ -79,6 +79,7 @@ private:
 	float groupRot = 0.0f;
 	bool updatingXScrollBar = false;
 	bool updatingYScrollBar = false;
+	uint64_t lastHoverTestTime = 0;
 
 	std::vector<obs_sceneitem_t *> hoveredPreviewItems;
 	std::vector<obs_sceneitem_t *> selectedItems;
@@ -4,6 +4,9 @@
 
 #include <qt-wrappers.hpp>
 
+#include <util/profiler.h>
+
+#include <QDir>
 #include <QGridLayout>
 #include <QLabel>
 #include <QPushButton>
@@ -80,6 +83,7 @@ OBSBasicStats::OBSBasicStats(QWidget *parent, bool closable)
 	hddSpace = new QLabel(this);
 	recordTimeLeft = new QLabel(this);
 	memUsage = new QLabel(this);
+	gpuTexMemory = new QLabel(this);
 
 	QString str = MakeTimeLeftText(99999, 59);
 	int textWidth = recordTimeLeft->fontMetrics().boundingRect(str).width();
@@ -89,11 +93,13 @@ OBSBasicStats::OBSBasicStats(QWidget *parent, bool closable)
 	newStat("HDDSpaceAvailable", hddSpace, 0);
 	newStat("DiskFullIn", recordTimeLeft, 0);
 	newStat("MemoryUsage", memUsage, 0);
+	newStat("GPUTextureMemory", gpuTexMemory, 0);
 
 	fps = new QLabel(this);
 	renderTime = new QLabel(this);
 	skippedFrames = new QLabel(this);
 	missedFrames = new QLabel(this);
+	savedCompositions = new QLabel(this);
 
 	str = MakeMissedFramesText(999999, 999999, 99.99);
 	textWidth = missedFrames->fontMetrics().boundingRect(str).width();
@@ -105,14 +111,18 @@ OBSBasicStats::OBSBasicStats(QWidget *parent, bool closable)
 	newStat("AverageTimeToRender", renderTime, 2);
 	newStat("MissedFrames", missedFrames, 2);
 	newStat("SkippedFrames", skippedFrames, 2);
+	newStat("SavedCompositions", savedCompositions, 2);
 
 	/* --------------------------------------------- */
 	QPushButton *closeButton = nullptr;
 	if (closable)
 		closeButton = new QPushButton(QTStr("Close"));
 	QPushButton *resetButton = new QPushButton(QTStr("Reset"));
+	traceButton = new QPushButton(
+		QTStr(profiler_trace_enabled() ? "Basic.Stats.Trace.Save" : "Basic.Stats.Trace.Start"));
 	QHBoxLayout *buttonLayout = new QHBoxLayout;
 	buttonLayout->addStretch();
+	buttonLayout->addWidget(traceButton);
 	buttonLayout->addWidget(resetButton);
 	if (closable)
 		buttonLayout->addWidget(closeButton);
@@ -161,6 +171,7 @@ OBSBasicStats::OBSBasicStats(QWidget *parent, bool closable)
 	if (closable)
 		connect(closeButton, &QPushButton::clicked, [this]() { close(); });
 	connect(resetButton, &QPushButton::clicked, [this]() { Reset(); });
+	connect(traceButton, &QPushButton::clicked, [this]() { ToggleTrace(); });
 
 	delete shortcutFilter;
 	shortcutFilter = CreateShortcutFilter();
@@ -253,6 +264,7 @@ static uint32_t first_encoded = 0xFFFFFFFF;
 static uint32_t first_skipped = 0xFFFFFFFF;
 static uint32_t first_rendered = 0xFFFFFFFF;
 static uint32_t first_lagged = 0xFFFFFFFF;
+static uint32_t first_saved = 0xFFFFFFFF;
 
 void OBSBasicStats::InitializeValues()
 {
@@ -261,6 +273,7 @@ void OBSBasicStats::InitializeValues()
 	first_skipped = video_output_get_skipped_frames(video);
 	first_rendered = obs_get_total_frames();
 	first_lagged = obs_get_lagged_frames();
+	first_saved = obs_get_composition_skipped_frames();
 }
 
 void OBSBasicStats::Update()
@@ -339,6 +352,24 @@ void OBSBasicStats::Update()
 
 	/* ------------------ */
 
+	struct gs_texture_memory_stats texStats;
+	gs_get_texture_memory_stats(&texStats);
+
+	num = (long double)texStats.live_bytes / (1024.0l * 1024.0l);
+	str = QString::number(num, 'f', 1) + QStringLiteral(" MB");
+	if (texStats.budget_bytes) {
+		num = (long double)texStats.budget_bytes / (1024.0l * 1024.0l);
+		str += QStringLiteral(" / ") + QString::number(num, 'f', 0) + QStringLiteral(" MB");
+	}
+	if (texStats.demotions) {
+		str += QStringLiteral(" (") +
+		       QTStr("Basic.Stats.GPUTextureMemory.Evicted").arg(QString::number(texStats.demotions)) +
+		       QStringLiteral(")");
+	}
+	gpuTexMemory->setText(str);
+
+	/* ------------------ */
+
 	num = (long double)obs_get_average_frame_time_ns() / 1000000.0l;
 
 	str = QString::number(num, 'f', 1) + QStringLiteral(" ms");
@@ -406,6 +437,21 @@ void OBSBasicStats::Update()
 	else
 		setClasses(missedFrames, "");
 
+	/* ------------------ */
+
+	uint32_t total_saved = obs_get_composition_skipped_frames();
+
+	if (total_saved < first_saved)
+		first_saved = total_saved;
+	total_saved -= first_saved;
+
+	num = total_rendered ? (long double)total_saved / (long double)total_rendered : 0.0l;
+	num *= 100.0l;
+
+	str = QString("%1 / %2 (%3%)")
+		      .arg(QString::number(total_saved), QString::number(total_rendered), QString::number(num, 'f', 1));
+	savedCompositions->setText(str);
+
 	/* ------------------------------------------- */
 	/* recording/streaming stats                   */
 
@@ -467,6 +513,7 @@ void OBSBasicStats::Reset()
 	first_skipped = 0xFFFFFFFF;
 	first_rendered = 0xFFFFFFFF;
 	first_lagged = 0xFFFFFFFF;
+	first_saved = 0xFFFFFFFF;
 
 	OBSOutputAutoRelease strOutput = obs_frontend_get_streaming_output();
 	OBSOutputAutoRelease recOutput = obs_frontend_get_recording_output();
@@ -476,6 +523,26 @@ void OBSBasicStats::Reset()
 	Update();
 }
 
+void OBSBasicStats::ToggleTrace()
+{
+	if (!profiler_trace_enabled()) {
+		profiler_trace_start(0);
+		traceButton->setText(QTStr("Basic.Stats.Trace.Save"));
+		return;
+	}
+
+	profiler_trace_stop();
+	traceButton->setText(QTStr("Basic.Stats.Trace.Start"));
+
+	QString path = SaveFile(this, QTStr("Basic.Stats.Trace.Save"), QDir::homePath() + "/obs-trace.json",
+				"JSON Files (*.json)");
+	if (path.isEmpty())
+		return;
+
+	if (!profiler_trace_save(path.toUtf8().constData()))
+		blog(LOG_WARNING, "Failed to save profiler trace to '%s'", path.toUtf8().constData());
+}
+
 void OBSBasicStats::OutputLabels::Update(obs_output_t *output, bool rec)
 {
 	uint64_t totalBytes = output ? obs_output_get_total_bytes(output) : 0;
@@ -10,6 +10,7 @@
 
 class QLabel;
 class QGridLayout;
+class QPushButton;
 
 class OBSBasicStats : public QFrame {
 	Q_OBJECT
@@ -19,10 +20,12 @@ class OBSBasicStats : public QFrame {
 	QLabel *hddSpace = nullptr;
 	QLabel *recordTimeLeft = nullptr;
 	QLabel *memUsage = nullptr;
+	QLabel *gpuTexMemory = nullptr;
 
 	QLabel *renderTime = nullptr;
 	QLabel *skippedFrames = nullptr;
 	QLabel *missedFrames = nullptr;
+	QLabel *savedCompositions = nullptr;
 
 	QGridLayout *outputLayout = nullptr;
 
@@ -54,8 +57,11 @@ class OBSBasicStats : public QFrame {
 
 	QList<OutputLabels> outputLabels;
 
+	QPushButton *traceButton = nullptr;
+
 	void AddOutputLabels(QString name);
 	void Update();
+	void ToggleTrace();
 
 	virtual void closeEvent(QCloseEvent *event) override;
 
@@ -164,7 +164,7 @@ void OBSBasic::RenderMain(void *data, uint32_t, uint32_t)
 		OBSScene scene = window->GetCurrentScene();
 		obs_source_t *source = obs_scene_get_source(scene);
 		if (source)
-			obs_source_video_render(source);
+			window->DrawStudioModePreview(source, ovi.base_width, ovi.base_height);
 	} else {
 		obs_render_main_texture_src_color_only();
 	}
@@ -953,11 +953,30 @@ void OBSBasic::Save(SceneCollection &collection)
 	}
 
 	const std::string collectionFileName = collection.getFilePathString();
-	bool success = obs_data_save_json_pretty_safe(saveData, collectionFileName.c_str(), "tmp", "bak");
 
-	if (!success) {
-		blog(LOG_ERROR, "Could not save scene data to %s", collectionFileName.c_str());
+	/* Serialization happens here so unchanged subtrees come out of the
+	 * obs-data json cache; only the disk write (with its fsync and
+	 * atomic rename) moves to a background thread. */
+	const char *json = obs_data_get_json_pretty(saveData);
+	if (!json || !*json) {
+		blog(LOG_ERROR, "Could not serialize scene data for %s", collectionFileName.c_str());
+		return;
 	}
+
+	/* keep a single write in flight so tmp/bak renames stay ordered */
+	FinishPendingCollectionWrite();
+
+	collectionWriteThread = std::thread([jsonStr = std::string(json), collectionFileName]() {
+		if (!os_quick_write_utf8_file_safe(collectionFileName.c_str(), jsonStr.c_str(), jsonStr.size(), false,
+						   "tmp", "bak"))
+			blog(LOG_ERROR, "Could not save scene data to %s", collectionFileName.c_str());
+	});
+}
+
+void OBSBasic::FinishPendingCollectionWrite()
+{
+	if (collectionWriteThread.joinable())
+		collectionWriteThread.join();
 }
 
 void OBSBasic::DeferSaveBegin()
@@ -1293,6 +1312,10 @@ void OBSBasic::LoadData(obs_data_t *data, SceneCollection &collection)
 	updateRemigrationMenuItem(collection.getCoordinateMode(), ui->actionRemigrateSceneCollection);
 
 	obs_missing_files_t *files = obs_missing_files_create();
+
+	/* every scene created during the load inserts a list row; batch them
+	 * so the scene list lays out once instead of once per scene */
+	ui->scenes->BeginBulkUpdate();
 	obs_load_sources(sources, AddMissingFiles, files);
 
 	if (resetVideo)
@@ -1301,6 +1324,7 @@ void OBSBasic::LoadData(obs_data_t *data, SceneCollection &collection)
 		LoadTransitions(transitions, AddMissingFiles, files);
 	if (sceneOrder)
 		LoadSceneListOrder(sceneOrder);
+	ui->scenes->EndBulkUpdate();
 
 	curTransition = FindTransition(transitionName);
 	if (!curTransition)
@@ -1459,6 +1483,10 @@ void OBSBasic::SaveProjectNow()
 
 	projectChanged = true;
 	SaveProjectDeferred();
+
+	/* explicit saves (shutdown, collection/profile switches) must be
+	 * durable before the caller proceeds */
+	FinishPendingCollectionWrite();
 }
 
 void OBSBasic::SaveProject()
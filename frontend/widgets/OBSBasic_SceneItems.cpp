@@ -1269,7 +1269,9 @@ void OBSBasic::on_actionFitToScreen_triggered()
 {
 	obs_bounds_type boundsType = OBS_BOUNDS_SCALE_INNER;
 	OBSDataAutoRelease wrapper = obs_scene_save_transform_states(GetCurrentScene(), false);
+	obs_scene_defer_update_begin(GetCurrentScene());
 	obs_scene_enum_items(GetCurrentScene(), CenterAlignSelectedItems, &boundsType);
+	obs_scene_defer_update_end(GetCurrentScene());
 	OBSDataAutoRelease rwrapper = obs_scene_save_transform_states(GetCurrentScene(), false);
 
 	std::string undo_data(obs_data_get_json(wrapper));
@@ -1283,7 +1285,9 @@ void OBSBasic::on_actionStretchToScreen_triggered()
 {
 	obs_bounds_type boundsType = OBS_BOUNDS_STRETCH;
 	OBSDataAutoRelease wrapper = obs_scene_save_transform_states(GetCurrentScene(), false);
+	obs_scene_defer_update_begin(GetCurrentScene());
 	obs_scene_enum_items(GetCurrentScene(), CenterAlignSelectedItems, &boundsType);
+	obs_scene_defer_update_end(GetCurrentScene());
 	OBSDataAutoRelease rwrapper = obs_scene_save_transform_states(GetCurrentScene(), false);
 
 	std::string undo_data(obs_data_get_json(wrapper));
@@ -1358,6 +1362,7 @@ void OBSBasic::CenterSelectedSceneItems(const CenterType &centerType)
 	vec3_sub(&offset, &screenCenter, &center);
 
 	// Shift items by offset
+	obs_scene_defer_update_begin(GetCurrentScene());
 	for (auto &item : items) {
 		vec3 tl, br;
 
@@ -1374,6 +1379,7 @@ void OBSBasic::CenterSelectedSceneItems(const CenterType &centerType)
 
 		SetItemTL(item, tl);
 	}
+	obs_scene_defer_update_end(GetCurrentScene());
 }
 
 void OBSBasic::on_actionCenterToScreen_triggered()
@@ -24,6 +24,7 @@
 
 #include <qt-wrappers.hpp>
 
+#include <QHash>
 #include <QLineEdit>
 #include <QWidgetAction>
 
@@ -57,31 +58,38 @@ obs_data_array_t *OBSBasic::SaveSceneListOrder()
 	return sceneOrder;
 }
 
-static void ReorderItemByName(QListWidget *lw, const char *name, int newIndex)
+void OBSBasic::LoadSceneListOrder(obs_data_array_t *array)
 {
-	for (int i = 0; i < lw->count(); i++) {
-		QListWidgetItem *item = lw->item(i);
+	size_t num = obs_data_array_count(array);
 
-		if (strcmp(name, QT_TO_UTF8(item->text())) == 0) {
-			if (newIndex != i) {
-				item = lw->takeItem(i);
-				lw->insertItem(newIndex, item);
-			}
-			break;
-		}
+	/* look items up by name once instead of scanning the whole list per
+	 * entry; with hundreds of scenes the quadratic scan (and the
+	 * relayout every takeItem/insertItem used to trigger) dominated
+	 * collection switch time */
+	QHash<QString, QListWidgetItem *> items;
+	for (int i = 0; i < ui->scenes->count(); i++) {
+		QListWidgetItem *item = ui->scenes->item(i);
+		items.insert(item->text(), item);
 	}
-}
 
-void OBSBasic::LoadSceneListOrder(obs_data_array_t *array)
-{
-	size_t num = obs_data_array_count(array);
+	ui->scenes->BeginBulkUpdate();
 
+	int idx = 0;
 	for (size_t i = 0; i < num; i++) {
 		OBSDataAutoRelease data = obs_data_array_item(array, i);
-		const char *name = obs_data_get_string(data, "name");
+		QListWidgetItem *item = items.take(QT_UTF8(obs_data_get_string(data, "name")));
+		if (!item)
+			continue;
 
-		ReorderItemByName(ui->scenes, name, (int)i);
+		int row = ui->scenes->row(item);
+		if (row != idx) {
+			ui->scenes->takeItem(row);
+			ui->scenes->insertItem(idx, item);
+		}
+		idx++;
 	}
+
+	ui->scenes->EndBulkUpdate();
 }
 
 OBSScene OBSBasic::GetCurrentScene()
@@ -448,13 +456,62 @@ void OBSBasic::RemoveSelectedScene()
 	OnEvent(OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED);
 }
 
+/* Scene signals can arrive from any thread and in bulk (scene collection
+ * load fires item_add once per item, reorders once per move).  Instead of
+ * posting one queued UI event per signal, accumulate them and post a single
+ * drain; reorder/refresh are deduplicated per scene since the handlers
+ * rebuild from current scene state anyway. */
+static void AddPendingScene(std::vector<OBSScene> &scenes, obs_scene_t *scene)
+{
+	for (OBSScene &pending : scenes) {
+		if (pending == scene)
+			return;
+	}
+
+	scenes.emplace_back(scene);
+}
+
+/* Must be called with pendingSceneSignalsMutex held. */
+void OBSBasic::QueueSceneSignalDrain()
+{
+	if (sceneSignalDrainQueued)
+		return;
+
+	sceneSignalDrainQueued = true;
+	QMetaObject::invokeMethod(this, "DrainSceneSignals", Qt::QueuedConnection);
+}
+
+void OBSBasic::DrainSceneSignals()
+{
+	std::vector<OBSSceneItem> addedItems;
+	std::vector<OBSScene> reorderScenes;
+	std::vector<OBSScene> refreshScenes;
+
+	{
+		std::lock_guard<std::mutex> lock(pendingSceneSignalsMutex);
+		addedItems.swap(pendingAddedItems);
+		reorderScenes.swap(pendingReorderScenes);
+		refreshScenes.swap(pendingRefreshScenes);
+		sceneSignalDrainQueued = false;
+	}
+
+	for (OBSSceneItem &item : addedItems)
+		AddSceneItem(item);
+	for (OBSScene &scene : refreshScenes)
+		RefreshSources(scene);
+	for (OBSScene &scene : reorderScenes)
+		ReorderSources(scene);
+}
+
 void OBSBasic::SceneReordered(void *data, calldata_t *params)
 {
 	OBSBasic *window = static_cast<OBSBasic *>(data);
 
 	obs_scene_t *scene = (obs_scene_t *)calldata_ptr(params, "scene");
 
-	QMetaObject::invokeMethod(window, "ReorderSources", Q_ARG(OBSScene, OBSScene(scene)));
+	std::lock_guard<std::mutex> lock(window->pendingSceneSignalsMutex);
+	AddPendingScene(window->pendingReorderScenes, scene);
+	window->QueueSceneSignalDrain();
 }
 
 void OBSBasic::SceneRefreshed(void *data, calldata_t *params)
@@ -463,7 +520,9 @@ void OBSBasic::SceneRefreshed(void *data, calldata_t *params)
 
 	obs_scene_t *scene = (obs_scene_t *)calldata_ptr(params, "scene");
 
-	QMetaObject::invokeMethod(window, "RefreshSources", Q_ARG(OBSScene, OBSScene(scene)));
+	std::lock_guard<std::mutex> lock(window->pendingSceneSignalsMutex);
+	AddPendingScene(window->pendingRefreshScenes, scene);
+	window->QueueSceneSignalDrain();
 }
 
 void OBSBasic::SceneItemAdded(void *data, calldata_t *params)
@@ -472,7 +531,9 @@ void OBSBasic::SceneItemAdded(void *data, calldata_t *params)
 
 	obs_sceneitem_t *item = (obs_sceneitem_t *)calldata_ptr(params, "item");
 
-	QMetaObject::invokeMethod(window, "AddSceneItem", Q_ARG(OBSSceneItem, OBSSceneItem(item)));
+	std::lock_guard<std::mutex> lock(window->pendingSceneSignalsMutex);
+	window->pendingAddedItems.emplace_back(item);
+	window->QueueSceneSignalDrain();
 }
 
 void OBSBasic::on_scenes_currentItemChanged(QListWidgetItem *current, QListWidgetItem *)
@@ -26,6 +26,8 @@
 #include <qt-wrappers.hpp>
 #include <slider-ignorewheel.hpp>
 
+#include <util/platform.h>
+
 #include <QToolTip>
 
 void OBSBasic::CreateProgramDisplay()
@@ -284,6 +286,69 @@ void OBSBasic::SetPreviewProgramMode(bool enabled)
 	UpdateTitleBar();
 }
 
+void OBSBasic::DrawStudioModePreview(obs_source_t *source, uint32_t cx, uint32_t cy)
+{
+	uint32_t fps = (uint32_t)config_get_uint(App()->GetUserConfig(), "BasicWindow", "StudioPreviewFPS");
+
+	/* HDR preview spaces keep the direct path so nothing is lost to the
+	 * RGBA cache texture */
+	if (!fps || gs_get_color_space() != GS_CS_SRGB) {
+		obs_source_video_render(source);
+		return;
+	}
+
+	if (!studioPreviewTexrender)
+		studioPreviewTexrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+	uint64_t interval = 1000000000ULL / fps;
+	uint64_t now = os_gettime_ns();
+
+	/* the pointer is only compared, never dereferenced; a scene switch
+	 * must not wait out the refresh interval */
+	bool refresh = source != studioPreviewLastScene || now - studioPreviewLastRender >= interval;
+
+	if (refresh) {
+		gs_texrender_reset(studioPreviewTexrender);
+		if (!gs_texrender_begin(studioPreviewTexrender, cx, cy)) {
+			obs_source_video_render(source);
+			return;
+		}
+
+		struct vec4 clear_color;
+		vec4_set(&clear_color, 0.0f, 0.0f, 0.0f, 0.0f);
+		gs_clear(GS_CLEAR_COLOR, &clear_color, 1.0f, 0);
+		gs_ortho(0.0f, float(cx), 0.0f, float(cy), -100.0f, 100.0f);
+
+		obs_source_video_render(source);
+
+		gs_texrender_end(studioPreviewTexrender);
+		studioPreviewLastRender = now;
+		studioPreviewLastScene = source;
+	}
+
+	gs_texture_t *tex = gs_texrender_get_texture(studioPreviewTexrender);
+	if (!tex) {
+		obs_source_video_render(source);
+		return;
+	}
+
+	const bool previous = gs_framebuffer_srgb_enabled();
+	gs_enable_framebuffer_srgb(true);
+
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_eparam_t *param = gs_effect_get_param_by_name(effect, "image");
+	gs_effect_set_texture_srgb(param, tex);
+
+	gs_blend_state_push();
+	gs_blend_function_separate(GS_BLEND_ONE, GS_BLEND_ZERO, GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(tex, 0, 0, 0);
+
+	gs_blend_state_pop();
+	gs_enable_framebuffer_srgb(previous);
+}
+
 void OBSBasic::RenderProgram(void *data, uint32_t, uint32_t)
 {
 	GS_DEBUG_MARKER_BEGIN(GS_DEBUG_COLOR_DEFAULT, "RenderProgram");
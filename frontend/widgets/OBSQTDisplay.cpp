@@ -128,6 +128,14 @@ void OBSQTDisplay::UpdateDisplayBackgroundColor()
 	obs_display_set_background_color(display, backgroundColor);
 }
 
+void OBSQTDisplay::UpdateExposure()
+{
+	/* a minimized or fully occluded window stops being exposed; the
+	 * display skips rendering and swapping until the next expose */
+	if (display)
+		obs_display_set_hidden(display, !windowHandle()->isExposed());
+}
+
 void OBSQTDisplay::CreateDisplay()
 {
 	if (display)
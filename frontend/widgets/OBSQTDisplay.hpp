@@ -36,6 +36,7 @@ public:
 	QColor GetDisplayBackgroundColor() const;
 	void SetDisplayBackgroundColor(const QColor &color);
 	void UpdateDisplayBackgroundColor();
+	void UpdateExposure();
 	void CreateDisplay();
 	void DestroyDisplay()
 	{
@@ -447,6 +447,7 @@ void VolumeMeter::setLevels(const float magnitude[MAX_AUDIO_CHANNELS], const flo
 	QMutexLocker locker(&dataMutex);
 
 	currentLastUpdateTime = ts;
+	idlePainted = false;
 	for (int channelNr = 0; channelNr < MAX_AUDIO_CHANNELS; channelNr++) {
 		currentMagnitude[channelNr] = magnitude[channelNr];
 		currentPeak[channelNr] = peak[channelNr];
@@ -932,6 +933,16 @@ void VolumeMeter::paintEvent(QPaintEvent *event)
 	}
 
 	lastRedrawTime = ts;
+	idlePainted = idle;
+}
+
+/* Whether the shared update timer needs to schedule a repaint.  Once an idle
+ * meter has painted its empty state there is nothing left to animate until
+ * new levels arrive, so inactive meters cost no UI-thread time regardless of
+ * how many the mixer holds. */
+bool VolumeMeter::needsRepaint() const
+{
+	return !idlePainted;
 }
 
 QRect VolumeMeter::getBarRect() const
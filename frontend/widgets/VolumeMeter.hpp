@@ -5,6 +5,8 @@
 #include <QMutex>
 #include <QWidget>
 
+#include <atomic>
+
 #define FADER_PRECISION 4096.0
 
 class VolumeMeterTimer;
@@ -147,6 +149,10 @@ private:
 	bool vertical;
 	bool muted = false;
 
+	/* true once the idle (empty) state has been painted; cleared when new
+	 * levels arrive so the shared timer can skip inactive meters */
+	std::atomic<bool> idlePainted = false;
+
 public:
 	explicit VolumeMeter(QWidget *parent = nullptr, obs_volmeter_t *obs_volmeter = nullptr, bool vertical = false);
 	~VolumeMeter();
@@ -155,6 +161,7 @@ public:
 		       const float inputPeak[MAX_AUDIO_CHANNELS]);
 	QRect getBarRect() const;
 	bool needLayoutChange();
+	bool needsRepaint() const;
 
 	QColor getBackgroundNominalColor() const;
 	void setBackgroundNominalColor(QColor c);
@@ -10,6 +10,9 @@
 
 #include <QFormLayout>
 
+#include <algorithm>
+#include <memory>
+
 #include "moc_AutoConfigTestPage.cpp"
 
 #define TEST_STR(x) "Basic.AutoConfig.TestPage." x
@@ -18,6 +21,7 @@
 #define TEST_BW TEST_STR("TestingBandwidth")
 #define TEST_BW_NO_OUTPUT TEST_STR("TestingBandwidth.NoOutput")
 #define TEST_BW_CONNECTING TEST_STR("TestingBandwidth.Connecting")
+#define TEST_BW_PROBING TEST_STR("TestingBandwidth.Probing")
 #define TEST_BW_CONNECT_FAIL TEST_STR("TestingBandwidth.ConnectFailed")
 #define TEST_BW_SERVER TEST_STR("TestingBandwidth.Server")
 #define TEST_RES_VAL TEST_STR("TestingRes.Resolution")
@@ -308,6 +312,121 @@ void AutoConfigTestPage::TestBandwidthThread()
 	signal_handler_connect(sh, "start", pre_on_started, &on_started);
 	signal_handler_connect(sh, "stop", pre_on_stopped, &on_stopped);
 
+	/* -----------------------------------*/
+	/* probe connectivity in parallel     */
+
+	/* With several candidate servers, connect to all of them at once to
+	 * find which are reachable and how far away they are, then run the
+	 * throughput measurement only on the closest one (measuring
+	 * throughput concurrently would have the probes contend for the
+	 * same uplink).  Unreachable servers sort last and are only tried
+	 * if the closer ones fail. */
+	bool probed = false;
+
+	if (servers.size() > 1) {
+		struct ConnectProbe {
+			AutoConfigTestPage *page;
+			ServerInfo *server;
+			OBSServiceAutoRelease service;
+			OBSOutputAutoRelease output;
+			bool done = false;
+			bool connected = false;
+		};
+
+		auto probe_started = [](void *data, calldata_t *) {
+			ConnectProbe *probe = static_cast<ConnectProbe *>(data);
+			unique_lock<mutex> lock(probe->page->m);
+			probe->connected = true;
+			probe->done = true;
+			probe->page->cv.notify_one();
+		};
+
+		auto probe_stopped = [](void *data, calldata_t *) {
+			ConnectProbe *probe = static_cast<ConnectProbe *>(data);
+			unique_lock<mutex> lock(probe->page->m);
+			probe->done = true;
+			probe->page->cv.notify_one();
+		};
+
+		std::vector<std::unique_ptr<ConnectProbe>> probes;
+
+		for (auto &server : servers) {
+			auto probe = std::make_unique<ConnectProbe>();
+			probe->page = this;
+			probe->server = &server;
+
+			probe->service = obs_service_create(serverType, "probe_service", nullptr, nullptr);
+			OBSDataAutoRelease probe_settings = obs_data_create();
+			obs_data_apply(probe_settings, service_settings);
+			obs_data_set_string(probe_settings, "server", server.address.c_str());
+			obs_service_update(probe->service, probe_settings);
+
+			probe->output = obs_output_create(output_type, "probe_stream", nullptr, nullptr);
+			if (!probe->output)
+				continue;
+
+			obs_output_update(probe->output, output_settings);
+			obs_output_set_video_encoder(probe->output, vencoder);
+			obs_output_set_audio_encoder(probe->output, aencoder, 0);
+			obs_output_set_reconnect_settings(probe->output, 0, 0);
+			obs_output_set_service(probe->output, probe->service);
+
+			signal_handler *psh = obs_output_get_signal_handler(probe->output);
+			signal_handler_connect(psh, "start", probe_started, probe.get());
+			signal_handler_connect(psh, "stop", probe_stopped, probe.get());
+
+			probes.push_back(std::move(probe));
+		}
+
+		QMetaObject::invokeMethod(this, "UpdateMessage", Q_ARG(QString, QTStr(TEST_BW_PROBING)));
+
+		for (auto &probe : probes) {
+			if (!obs_output_start(probe->output))
+				probe->done = true;
+		}
+
+		{
+			unique_lock<mutex> ul(m);
+			auto deadline = chrono::steady_clock::now() + chrono::seconds(15);
+
+			for (;;) {
+				if (cancel)
+					break;
+
+				bool all_done = true;
+				for (auto &probe : probes)
+					all_done = all_done && probe->done;
+				if (all_done)
+					break;
+
+				if (cv.wait_until(ul, deadline) == cv_status::timeout)
+					break;
+			}
+		}
+
+		for (auto &probe : probes) {
+			if (probe->connected)
+				probe->server->ms = obs_output_get_connect_time_ms(probe->output);
+
+			signal_handler *psh = obs_output_get_signal_handler(probe->output);
+			signal_handler_disconnect(psh, "start", probe_started, probe.get());
+			signal_handler_disconnect(psh, "stop", probe_stopped, probe.get());
+
+			obs_output_force_stop(probe->output);
+		}
+
+		if (cancel)
+			return;
+
+		std::stable_sort(servers.begin(), servers.end(), [](const ServerInfo &a, const ServerInfo &b) {
+			if ((a.ms < 0) != (b.ms < 0))
+				return b.ms < 0;
+			return a.ms < b.ms;
+		});
+
+		probed = true;
+	}
+
 	/* -----------------------------------*/
 	/* test servers                       */
 
@@ -390,6 +509,12 @@ void AutoConfigTestPage::TestBandwidthThread()
 
 		server.ms = obs_output_get_connect_time_ms(output);
 		success = true;
+
+		/* connectivity of every server was probed up front, so one
+		 * throughput measurement on the closest reachable server is
+		 * enough */
+		if (probed)
+			break;
 	}
 
 	if (!success) {
@@ -573,6 +698,12 @@ bool AutoConfigTestPage::TestSoftwareEncoding()
 	int i = 0;
 	int count = 1;
 
+	/* time-box the benchmark: each resolution costs ~5 seconds, so once
+	 * a usable result exists stop descending through smaller ones after
+	 * the budget runs out */
+	const uint64_t test_start = os_gettime_ns();
+	const uint64_t test_budget_ns = 60000000000ULL;
+
 	auto testRes = [&](int cy, int fps_num, int fps_den, bool force) {
 		int per = ++i * 100 / count;
 		QMetaObject::invokeMethod(this, "Progress", Q_ARG(int, per));
@@ -584,6 +715,9 @@ bool AutoConfigTestPage::TestSoftwareEncoding()
 		if (results.size() >= 3)
 			return true;
 
+		if (!results.empty() && os_gettime_ns() - test_start > test_budget_ns)
+			return true;
+
 		if (!fps_num || !fps_den) {
 			fps_num = wiz->specificFPSNum;
 			fps_den = wiz->specificFPSDen;
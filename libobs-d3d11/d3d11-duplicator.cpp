@@ -16,6 +16,7 @@
 ******************************************************************************/
 
 #include "d3d11-subsystem.hpp"
+#include <util/platform.h>
 #include <unordered_map>
 
 static inline bool get_monitor(gs_device_t *device, int monitor_idx, IDXGIOutput **dxgiOutput)
@@ -222,7 +223,79 @@ EXPORT void gs_duplicator_destroy(gs_duplicator_t *duplicator)
 	}
 }
 
-static inline void copy_texture(gs_duplicator_t *d, ID3D11Texture2D *tex)
+/* log the copied-pixel rate at debug level every five seconds */
+#define DUPLICATOR_STATS_INTERVAL_NS 5000000000ULL
+
+static inline void count_copied_pixels(gs_duplicator_t *d, uint64_t pixels)
+{
+	const uint64_t now = os_gettime_ns();
+
+	d->copied_pixels += pixels;
+
+	if (!d->stats_start_ns) {
+		d->stats_start_ns = now;
+	} else if (now - d->stats_start_ns >= DUPLICATOR_STATS_INTERVAL_NS) {
+		const double seconds = (double)(now - d->stats_start_ns) / 1000000000.0;
+		blog(LOG_DEBUG, "duplicator %d: %.0f copied pixels/s", d->idx,
+		     (double)d->copied_pixels / seconds);
+		d->copied_pixels = 0;
+		d->stats_start_ns = now;
+	}
+}
+
+static inline void copy_rect(gs_duplicator_t *d, ID3D11Texture2D *tex, const RECT &rect)
+{
+	D3D11_BOX box;
+
+	if (rect.right <= rect.left || rect.bottom <= rect.top)
+		return;
+
+	box.left = rect.left;
+	box.top = rect.top;
+	box.front = 0;
+	box.right = rect.right;
+	box.bottom = rect.bottom;
+	box.back = 1;
+
+	d->device->context->CopySubresourceRegion(d->texture->texture, 0, rect.left, rect.top, 0, tex, 0, &box);
+	count_copied_pixels(d, (uint64_t)(rect.right - rect.left) * (uint64_t)(rect.bottom - rect.top));
+}
+
+/* copies only the regions DXGI reports as changed; the acquired frame is
+ * the complete desktop image, so move rect destinations can be copied
+ * from it like dirty rects instead of shuffling our own texture around */
+static bool copy_changed_regions(gs_duplicator_t *d, ID3D11Texture2D *tex, const DXGI_OUTDUPL_FRAME_INFO &info)
+{
+	UINT move_size = 0;
+	UINT dirty_size = 0;
+	HRESULT hr;
+
+	if (!info.TotalMetadataBufferSize)
+		return true;
+
+	if (d->metadata.size() < info.TotalMetadataBufferSize)
+		d->metadata.resize(info.TotalMetadataBufferSize);
+
+	DXGI_OUTDUPL_MOVE_RECT *moves = (DXGI_OUTDUPL_MOVE_RECT *)d->metadata.data();
+	hr = d->duplicator->GetFrameMoveRects((UINT)d->metadata.size(), moves, &move_size);
+	if (FAILED(hr))
+		return false;
+
+	RECT *dirty = (RECT *)(d->metadata.data() + move_size);
+	hr = d->duplicator->GetFrameDirtyRects((UINT)(d->metadata.size() - move_size), dirty, &dirty_size);
+	if (FAILED(hr))
+		return false;
+
+	for (UINT i = 0; i < move_size / sizeof(DXGI_OUTDUPL_MOVE_RECT); i++)
+		copy_rect(d, tex, moves[i].DestinationRect);
+
+	for (UINT i = 0; i < dirty_size / sizeof(RECT); i++)
+		copy_rect(d, tex, dirty[i]);
+
+	return true;
+}
+
+static inline void copy_texture(gs_duplicator_t *d, ID3D11Texture2D *tex, const DXGI_OUTDUPL_FRAME_INFO &info)
 {
 	D3D11_TEXTURE2D_DESC desc;
 	tex->GetDesc(&desc);
@@ -237,10 +310,18 @@ static inline void copy_texture(gs_duplicator_t *d, ID3D11Texture2D *tex)
 		d->color_space =
 			d->hdr ? GS_CS_709_SCRGB
 			       : ((desc.Format == DXGI_FORMAT_R16G16B16A16_FLOAT) ? GS_CS_SRGB_16F : GS_CS_SRGB);
+		d->full_copy_done = false;
 	}
 
-	if (d->texture)
-		d->device->context->CopyResource(d->texture->texture, tex);
+	if (!d->texture)
+		return;
+
+	if (d->full_copy_done && copy_changed_regions(d, tex, info))
+		return;
+
+	d->device->context->CopyResource(d->texture->texture, tex);
+	count_copied_pixels(d, (uint64_t)desc.Width * (uint64_t)desc.Height);
+	d->full_copy_done = true;
 }
 
 EXPORT bool gs_duplicator_update_frame(gs_duplicator_t *d)
@@ -282,7 +363,7 @@ EXPORT bool gs_duplicator_update_frame(gs_duplicator_t *d)
 		return true;
 	}
 
-	copy_texture(d, tex);
+	copy_texture(d, tex, info);
 	d->duplicator->ReleaseFrame();
 	d->updated = true;
 	return true;
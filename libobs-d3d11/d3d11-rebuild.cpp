@@ -219,6 +219,8 @@ void gs_vertex_shader::Rebuild(ID3D11Device *dev)
 			throw HRError("Failed to create constant buffer", hr);
 	}
 
+	constantsValid = false;
+
 	for (gs_shader_param &param : params) {
 		param.nextSampler = nullptr;
 		param.curValue.clear();
@@ -240,6 +242,8 @@ void gs_pixel_shader::Rebuild(ID3D11Device *dev)
 			throw HRError("Failed to create constant buffer", hr);
 	}
 
+	constantsValid = false;
+
 	for (gs_shader_param &param : params) {
 		param.nextSampler = nullptr;
 		param.curValue.clear();
@@ -252,6 +256,17 @@ void gs_swap_chain::Rebuild(ID3D11Device *dev)
 	HRESULT hr = device->factory->CreateSwapChain(dev, &swapDesc, &swap);
 	if (FAILED(hr))
 		throw HRError("Failed to create swap chain", hr);
+
+	/* Release() closed the waitable handle; reacquire it so the rebuilt
+	 * swap chain keeps its latency cap and non-blocking presents */
+	if (swapDesc.Flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) {
+		ComPtr<IDXGISwapChain2> swap2 = ComQIPtr<IDXGISwapChain2>(swap);
+		hr = swap2->SetMaximumFrameLatency(2);
+		if (FAILED(hr))
+			blog(LOG_DEBUG, "%s: SetMaximumFrameLatency failed", __FUNCTION__);
+		hWaitable = swap2->GetFrameLatencyWaitableObject();
+	}
+
 	Init();
 }
 
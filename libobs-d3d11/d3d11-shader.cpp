@@ -303,28 +303,9 @@ void gs_shader::Compile(const char *shaderString, const char *file, const char *
 #endif
 }
 
-inline void gs_shader::UpdateParam(vector<uint8_t> &constData, gs_shader_param &param, bool &upload)
+inline void gs_shader::LoadTextureParam(gs_shader_param &param)
 {
-	if (param.type != GS_SHADER_PARAM_TEXTURE) {
-		if (!param.curValue.size())
-			throw "Not all shader parameters were set";
-
-		/* padding in case the constant needs to start at a new
-		 * register */
-		if (param.pos > constData.size()) {
-			uint8_t zero = 0;
-
-			constData.insert(constData.end(), param.pos - constData.size(), zero);
-		}
-
-		constData.insert(constData.end(), param.curValue.begin(), param.curValue.end());
-
-		if (param.changed) {
-			upload = true;
-			param.changed = false;
-		}
-
-	} else if (param.curValue.size() == sizeof(struct gs_shader_texture)) {
+	if (param.curValue.size() == sizeof(struct gs_shader_texture)) {
 		struct gs_shader_texture shader_tex;
 		memcpy(&shader_tex, param.curValue.data(), sizeof(shader_tex));
 		if (shader_tex.srgb)
@@ -340,30 +321,65 @@ inline void gs_shader::UpdateParam(vector<uint8_t> &constData, gs_shader_param &
 	}
 }
 
+inline void gs_shader::PackParam(vector<uint8_t> &constData, gs_shader_param &param)
+{
+	/* padding in case the constant needs to start at a new register */
+	if (param.pos > constData.size()) {
+		uint8_t zero = 0;
+
+		constData.insert(constData.end(), param.pos - constData.size(), zero);
+	}
+
+	constData.insert(constData.end(), param.curValue.begin(), param.curValue.end());
+	param.changed = false;
+}
+
 void gs_shader::UploadParams()
 {
-	vector<uint8_t> constData;
-	bool upload = false;
+	bool upload = !constantsValid;
+
+	/* textures always need (re)binding, but the constant buffer only
+	 * has to be repacked and mapped when a parameter actually changed
+	 * since the last upload to this shader */
+	for (size_t i = 0; i < params.size(); i++) {
+		gs_shader_param &param = params[i];
+
+		if (param.type == GS_SHADER_PARAM_TEXTURE) {
+			LoadTextureParam(param);
+		} else {
+			if (!param.curValue.size())
+				throw "Not all shader parameters were set";
+
+			if (param.changed)
+				upload = true;
+		}
+	}
 
+	if (!upload)
+		return;
+
+	vector<uint8_t> constData;
 	constData.reserve(constantSize);
 
-	for (size_t i = 0; i < params.size(); i++)
-		UpdateParam(constData, params[i], upload);
+	for (size_t i = 0; i < params.size(); i++) {
+		if (params[i].type != GS_SHADER_PARAM_TEXTURE)
+			PackParam(constData, params[i]);
+	}
 
 	if (constData.size() != constantSize)
 		throw "Invalid constant data size given to shader";
 
-	if (upload) {
-		D3D11_MAPPED_SUBRESOURCE map;
-		HRESULT hr;
+	D3D11_MAPPED_SUBRESOURCE map;
+	HRESULT hr;
 
-		hr = device->context->Map(constants, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
-		if (FAILED(hr))
-			throw HRError("Could not lock constant buffer", hr);
+	hr = device->context->Map(constants, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+	if (FAILED(hr))
+		throw HRError("Could not lock constant buffer", hr);
 
-		memcpy(map.pData, constData.data(), constData.size());
-		device->context->Unmap(constants, 0);
-	}
+	memcpy(map.pData, constData.data(), constData.size());
+	device->context->Unmap(constants, 0);
+
+	constantsValid = true;
 }
 
 void gs_shader_destroy(gs_shader_t *shader)
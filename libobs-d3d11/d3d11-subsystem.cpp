@@ -246,6 +246,16 @@ gs_swap_chain::gs_swap_chain(gs_device *device, const gs_init_data *data)
 
 	if (flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) {
 		ComPtr<IDXGISwapChain2> swap2 = ComQIPtr<IDXGISwapChain2>(swap);
+
+		/* waitable swap chains default to a maximum latency of three
+		 * queued frames, which shows up as visible preview lag; two
+		 * keeps one frame in flight while the next one renders.  The
+		 * waitable handle still makes presents non-blocking via
+		 * device_is_present_ready */
+		hr = swap2->SetMaximumFrameLatency(2);
+		if (FAILED(hr))
+			blog(LOG_DEBUG, "%s: SetMaximumFrameLatency failed", __FUNCTION__);
+
 		hWaitable = swap2->GetFrameLatencyWaitableObject();
 		if (hWaitable == NULL) {
 			throw HRError("Failed to GetFrameLatencyWaitableObject", hr);
@@ -2641,12 +2651,43 @@ bool gs_texture_map(gs_texture_t *tex, uint8_t **ptr, uint32_t *linesize)
 		return false;
 
 	gs_texture_2d *tex2d = static_cast<gs_texture_2d *>(tex);
-
 	D3D11_MAPPED_SUBRESOURCE map;
-	hr = tex2d->device->context->Map(tex2d->texture, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+
+	/* two-plane textures keep the old dynamic mapping; everything else
+	 * goes through the staging ring so the map never waits on GPU reads
+	 * of the texture itself */
+	if (tex2d->twoPlane || tex2d->chroma) {
+		hr = tex2d->device->context->Map(tex2d->texture, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+		if (FAILED(hr))
+			return false;
+
+		*ptr = (uint8_t *)map.pData;
+		*linesize = map.RowPitch;
+		return true;
+	}
+
+	if (!tex2d->isDynamic || !tex2d->InitStagingRing())
+		return false;
+
+	hr = E_FAIL;
+	for (size_t i = 0; i < gs_texture_2d::NUM_STAGING; i++) {
+		hr = tex2d->device->context->Map(tex2d->staging[tex2d->curStaging], 0, D3D11_MAP_WRITE,
+						 D3D11_MAP_FLAG_DO_NOT_WAIT, &map);
+		if (SUCCEEDED(hr))
+			break;
+		if (hr != DXGI_ERROR_WAS_STILL_DRAWING)
+			return false;
+
+		tex2d->curStaging = (tex2d->curStaging + 1) % gs_texture_2d::NUM_STAGING;
+	}
+
+	/* every slot still in flight: wait for the oldest one */
+	if (FAILED(hr))
+		hr = tex2d->device->context->Map(tex2d->staging[tex2d->curStaging], 0, D3D11_MAP_WRITE, 0, &map);
 	if (FAILED(hr))
 		return false;
 
+	tex2d->stagingMapped = true;
 	*ptr = (uint8_t *)map.pData;
 	*linesize = map.RowPitch;
 	return true;
@@ -2658,6 +2699,17 @@ void gs_texture_unmap(gs_texture_t *tex)
 		return;
 
 	gs_texture_2d *tex2d = static_cast<gs_texture_2d *>(tex);
+
+	if (tex2d->stagingMapped) {
+		ID3D11Texture2D *stage = tex2d->staging[tex2d->curStaging];
+
+		tex2d->device->context->Unmap(stage, 0);
+		tex2d->device->context->CopySubresourceRegion(tex2d->texture, 0, 0, 0, 0, stage, 0, nullptr);
+		tex2d->stagingMapped = false;
+		tex2d->curStaging = (tex2d->curStaging + 1) % gs_texture_2d::NUM_STAGING;
+		return;
+	}
+
 	tex2d->device->context->Unmap(tex2d->texture, 0);
 }
 
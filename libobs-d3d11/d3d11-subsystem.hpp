@@ -93,11 +93,11 @@ static inline DXGI_FORMAT ConvertGSTextureFormatResource(gs_color_format format)
 	case GS_R32F:
 		return DXGI_FORMAT_R32_FLOAT;
 	case GS_DXT1:
-		return DXGI_FORMAT_BC1_UNORM;
+		return DXGI_FORMAT_BC1_TYPELESS;
 	case GS_DXT3:
-		return DXGI_FORMAT_BC2_UNORM;
+		return DXGI_FORMAT_BC2_TYPELESS;
 	case GS_DXT5:
-		return DXGI_FORMAT_BC3_UNORM;
+		return DXGI_FORMAT_BC3_TYPELESS;
 	case GS_R8G8:
 		return DXGI_FORMAT_R8G8_UNORM;
 	case GS_RGBA_UNORM:
@@ -122,6 +122,12 @@ static inline DXGI_FORMAT ConvertGSTextureFormatView(gs_color_format format)
 		return DXGI_FORMAT_B8G8R8X8_UNORM;
 	case GS_BGRA:
 		return DXGI_FORMAT_B8G8R8A8_UNORM;
+	case GS_DXT1:
+		return DXGI_FORMAT_BC1_UNORM;
+	case GS_DXT3:
+		return DXGI_FORMAT_BC2_UNORM;
+	case GS_DXT5:
+		return DXGI_FORMAT_BC3_UNORM;
 	default:
 		return ConvertGSTextureFormatResource(format);
 	}
@@ -136,6 +142,12 @@ static inline DXGI_FORMAT ConvertGSTextureFormatViewLinear(gs_color_format forma
 		return DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
 	case GS_BGRA:
 		return DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+	case GS_DXT1:
+		return DXGI_FORMAT_BC1_UNORM_SRGB;
+	case GS_DXT3:
+		return DXGI_FORMAT_BC2_UNORM_SRGB;
+	case GS_DXT5:
+		return DXGI_FORMAT_BC3_UNORM_SRGB;
 	default:
 		return ConvertGSTextureFormatResource(format);
 	}
@@ -174,10 +186,13 @@ static inline gs_color_format ConvertDXGITextureFormat(DXGI_FORMAT format)
 		return GS_R16F;
 	case DXGI_FORMAT_R32_FLOAT:
 		return GS_R32F;
+	case DXGI_FORMAT_BC1_TYPELESS:
 	case DXGI_FORMAT_BC1_UNORM:
 		return GS_DXT1;
+	case DXGI_FORMAT_BC2_TYPELESS:
 	case DXGI_FORMAT_BC2_UNORM:
 		return GS_DXT3;
+	case DXGI_FORMAT_BC3_TYPELESS:
 	case DXGI_FORMAT_BC3_UNORM:
 		return GS_DXT5;
 	case DXGI_FORMAT_R8G8B8A8_UNORM:
@@ -516,12 +531,21 @@ struct gs_texture_2d : gs_texture {
 	bool chroma = false;
 	bool acquired = false;
 
+	/* staging ring for dynamic uploads: mapping a staging slot never
+	 * stalls on GPU reads of the texture itself, and the upload lands
+	 * via a queued CopySubresourceRegion */
+	static const size_t NUM_STAGING = 3;
+	ComPtr<ID3D11Texture2D> staging[NUM_STAGING];
+	size_t curStaging = 0;
+	bool stagingMapped = false;
+
 	vector<vector<uint8_t>> data;
 	vector<D3D11_SUBRESOURCE_DATA> srd;
 	D3D11_TEXTURE2D_DESC td = {};
 
 	void InitSRD(vector<D3D11_SUBRESOURCE_DATA> &srd);
 	void InitTexture(const uint8_t *const *data);
+	bool InitStagingRing();
 	void InitResourceView();
 	void InitRenderTargets();
 	void BackupTexture(const uint8_t *const *data);
@@ -539,6 +563,10 @@ struct gs_texture_2d : gs_texture {
 			rt.Release();
 		for (ComPtr<ID3D11RenderTargetView> &rt : renderTargetLinear)
 			rt.Release();
+		for (ComPtr<ID3D11Texture2D> &stage : staging)
+			stage.Release();
+		curStaging = 0;
+		stagingMapped = false;
 		gdiSurface.Release();
 		shaderRes.Release();
 		shaderResLinear.Release();
@@ -684,11 +712,13 @@ struct gs_shader : gs_obj {
 	vector<gs_shader_param> params;
 	ComPtr<ID3D11Buffer> constants;
 	size_t constantSize;
+	bool constantsValid = false;
 
 	D3D11_BUFFER_DESC bd = {};
 	vector<uint8_t> data;
 
-	inline void UpdateParam(vector<uint8_t> &constData, gs_shader_param &param, bool &upload);
+	inline void LoadTextureParam(gs_shader_param &param);
+	inline void PackParam(vector<uint8_t> &constData, gs_shader_param &param);
 	void UploadParams();
 
 	void BuildConstantBuffer();
@@ -765,6 +795,12 @@ struct gs_duplicator : gs_obj {
 	long refs;
 	bool updated;
 
+	/* dirty/move rect metadata buffer plus copied-pixel statistics */
+	vector<uint8_t> metadata;
+	bool full_copy_done = false;
+	uint64_t copied_pixels = 0;
+	uint64_t stats_start_ns = 0;
+
 	void Start();
 
 	inline void Release() { duplicator.Release(); }
@@ -29,6 +29,27 @@ void gs_texture_2d::InitSRD(vector<D3D11_SUBRESOURCE_DATA> &srd)
 	if (!actual_levels)
 		actual_levels = gs_get_total_levels(width, height, 1);
 
+	if (gs_is_compressed_format(format)) {
+		/* block-compressed pitch is bytes per row of 4x4 blocks, not
+		 * bytes per pixel row */
+		const uint32_t blockSize = (format == GS_DXT1) ? 8 : 16;
+
+		for (size_t i = 0; i < textures; i++) {
+			for (uint32_t j = 0; j < actual_levels; j++) {
+				const uint32_t levelWidth = std::max(width >> j, 1u);
+				const uint32_t levelHeight = std::max(height >> j, 1u);
+				const uint32_t pitch = (levelWidth + 3) / 4 * blockSize;
+
+				D3D11_SUBRESOURCE_DATA newSRD;
+				newSRD.pSysMem = data[curTex++].data();
+				newSRD.SysMemPitch = pitch;
+				newSRD.SysMemSlicePitch = pitch * ((levelHeight + 3) / 4);
+				srd.push_back(newSRD);
+			}
+		}
+		return;
+	}
+
 	rowSizeBytes /= 8;
 
 	for (size_t i = 0; i < textures; i++) {
@@ -106,8 +127,12 @@ void gs_texture_2d::InitTexture(const uint8_t *const *data)
 	td.Format = twoPlane ? ((format == GS_R16) ? DXGI_FORMAT_P010 : DXGI_FORMAT_NV12) : dxgiFormatResource;
 	td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 	td.SampleDesc.Count = 1;
-	td.CPUAccessFlags = isDynamic ? D3D11_CPU_ACCESS_WRITE : 0;
-	td.Usage = isDynamic ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT;
+
+	/* plain dynamic textures are updated through the staging ring and
+	 * stay default-usage; two-plane textures keep the old mapped path */
+	const bool mapDirect = isDynamic && twoPlane;
+	td.CPUAccessFlags = mapDirect ? D3D11_CPU_ACCESS_WRITE : 0;
+	td.Usage = mapDirect ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT;
 
 	if (type == GS_TEXTURE_CUBE)
 		td.MiscFlags |= D3D11_RESOURCE_MISC_TEXTURECUBE;
@@ -168,6 +193,39 @@ void gs_texture_2d::InitTexture(const uint8_t *const *data)
 	}
 }
 
+/* created lazily on the first map so textures that are never mapped do
+ * not pay for the ring */
+bool gs_texture_2d::InitStagingRing()
+{
+	D3D11_TEXTURE2D_DESC sd = {};
+	HRESULT hr;
+
+	if (staging[0])
+		return true;
+
+	sd.Width = td.Width;
+	sd.Height = td.Height;
+	sd.MipLevels = 1;
+	sd.ArraySize = 1;
+	sd.Format = td.Format;
+	sd.SampleDesc.Count = 1;
+	sd.Usage = D3D11_USAGE_STAGING;
+	sd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	for (size_t i = 0; i < NUM_STAGING; i++) {
+		hr = device->device->CreateTexture2D(&sd, nullptr, staging[i].Assign());
+		if (FAILED(hr)) {
+			blog(LOG_ERROR, "InitStagingRing: Failed to create staging texture: %08lX", hr);
+			for (size_t j = 0; j <= i; j++)
+				staging[j].Release();
+			return false;
+		}
+	}
+
+	curStaging = 0;
+	return true;
+}
+
 void gs_texture_2d::InitResourceView()
 {
 	HRESULT hr;
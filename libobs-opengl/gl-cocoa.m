@@ -308,34 +308,59 @@ void gl_getclientsize(const struct gs_swap_chain *swap, uint32_t *width, uint32_
         *height = swap->info.cy;
 }
 
-gs_texture_t *device_texture_create_from_iosurface(gs_device_t *device, void *iosurf)
-{
-    IOSurfaceRef ref = (IOSurfaceRef) iosurf;
-    struct gs_texture_2d *tex = bzalloc(sizeof(struct gs_texture_2d));
+/* Table of IOSurface pixel formats that can be bound directly as GL
+ * textures; surfaces in any other format cannot be made resident
+ * without a conversion pass and are rejected. */
+struct iosurface_format_entry {
+    OSType pf;
+    enum gs_color_format format;
+    GLenum gl_format;
+    GLenum gl_type;
+};
+
+static const struct iosurface_format_entry iosurface_formats[] = {
+    /* kCVPixelFormatType_32BGRA */
+    {('B' << 24) | ('G' << 16) | ('R' << 8) | 'A', GS_BGRA, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV},
+    /* kCVPixelFormatType_ARGB2101010LEPacked */
+    {('l' << 24) | ('1' << 16) | ('0' << 8) | 'r', GS_R10G10B10A2, GL_BGRA, GL_UNSIGNED_INT_2_10_10_10_REV},
+    /* kCVPixelFormatType_64RGBAHalf (EDR content) */
+    {('R' << 24) | ('G' << 16) | ('h' << 8) | 'A', GS_RGBA16F, GL_RGBA, GL_HALF_FLOAT},
+};
 
+static const struct iosurface_format_entry *find_iosurface_format(IOSurfaceRef ref)
+{
     OSType pf = IOSurfaceGetPixelFormat(ref);
 
-    FourCharCode l10r_code = 0;
-    l10r_code = ('l' << 24) | ('1' << 16) | ('0' << 8) | 'r';
+    if (pf == 0) {
+        blog(LOG_ERROR, "Invalid IOSurface buffer");
+        return NULL;
+    }
 
-    FourCharCode bgra_code = 0;
-    bgra_code = ('B' << 24) | ('G' << 16) | ('R' << 8) | 'A';
+    for (size_t i = 0; i < sizeof(iosurface_formats) / sizeof(iosurface_formats[0]); i++) {
+        if (iosurface_formats[i].pf == pf)
+            return &iosurface_formats[i];
+    }
 
-    const bool l10r = pf == l10r_code;
-    if (pf == 0)
-        blog(LOG_ERROR, "Invalid IOSurface Buffer");
-    else if ((pf != bgra_code) && !l10r)
-        blog(LOG_ERROR, "Unexpected pixel format: %d (%c%c%c%c)", pf, pf >> 24, pf >> 16, pf >> 8, pf);
+    blog(LOG_ERROR, "Unsupported IOSurface pixel format: %d (%c%c%c%c)", pf, pf >> 24, pf >> 16, pf >> 8, pf);
+    return NULL;
+}
 
-    const enum gs_color_format color_format = l10r ? GS_R10G10B10A2 : GS_BGRA;
+gs_texture_t *device_texture_create_from_iosurface(gs_device_t *device, void *iosurf)
+{
+    IOSurfaceRef ref = (IOSurfaceRef) iosurf;
+    struct gs_texture_2d *tex = bzalloc(sizeof(struct gs_texture_2d));
+
+    const struct iosurface_format_entry *entry = find_iosurface_format(ref);
+    if (!entry)
+        goto fail;
 
     tex->base.device = device;
     tex->base.type = GS_TEXTURE_2D;
-    tex->base.format = color_format;
+    tex->base.format = entry->format;
     tex->base.levels = 1;
-    tex->base.gl_format = l10r ? GL_BGRA : convert_gs_format(color_format);
-    tex->base.gl_internal_format = convert_gs_internal_format(color_format);
-    tex->base.gl_type = l10r ? GL_UNSIGNED_INT_2_10_10_10_REV : GL_UNSIGNED_INT_8_8_8_8_REV;
+    tex->base.gl_format = entry->gl_format;
+    tex->base.gl_internal_format = convert_gs_internal_format(entry->format);
+    tex->base.gl_type = entry->gl_type;
     tex->base.gl_target = GL_TEXTURE_RECTANGLE_ARB;
     tex->base.is_dynamic = false;
     tex->base.is_render_target = false;
@@ -399,20 +424,16 @@ bool gs_texture_rebind_iosurface(gs_texture_t *texture, void *iosurf)
     if (!iosurf)
         return false;
 
-    FourCharCode l10r_code = 0;
-    l10r_code = ('l' << 24) | ('1' << 16) | ('0' << 8) | 'r';
-
-    FourCharCode bgra_code = 0;
-    bgra_code = ('B' << 24) | ('G' << 16) | ('R' << 8) | 'A';
-
     struct gs_texture_2d *tex = (struct gs_texture_2d *) texture;
     IOSurfaceRef ref = (IOSurfaceRef) iosurf;
 
-    OSType pf = IOSurfaceGetPixelFormat(ref);
-    if (pf == 0) {
-        blog(LOG_ERROR, "Invalid IOSurface buffer");
-    } else if ((pf != bgra_code) && (pf != l10r_code)) {
-        blog(LOG_ERROR, "Unexpected pixel format: %d (%c%c%c%c)", pf, pf >> 24, pf >> 16, pf >> 8, pf);
+    const struct iosurface_format_entry *entry = find_iosurface_format(ref);
+    if (!entry)
+        return false;
+
+    if (entry->format != tex->base.format) {
+        blog(LOG_ERROR, "gs_texture_rebind_iosurface: pixel format changed, recreate the texture");
+        return false;
     }
 
     tex->width = (uint32_t) IOSurfaceGetWidth(ref);
@@ -62,6 +62,10 @@ void gs_indexbuffer_destroy(gs_indexbuffer_t *ib)
 		if (ib->buffer)
 			gl_delete_buffers(1, &ib->buffer);
 
+		/* invalidate VAO element bindings cached against this
+		 * buffer */
+		ib->device->vao_generation++;
+
 		bfree(ib->data);
 		bfree(ib);
 	}
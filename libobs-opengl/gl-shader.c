@@ -16,6 +16,9 @@
 ******************************************************************************/
 
 #include <assert.h>
+#include <inttypes.h>
+#include <util/dstr.h>
+#include <util/platform.h>
 
 #include <graphics/vec2.h>
 #include <graphics/vec3.h>
@@ -37,6 +40,20 @@ static inline void shader_attrib_free(struct shader_attrib *attrib)
 	bfree(attrib->name);
 }
 
+#define FNV1A_OFFSET 14695981039346656037ULL
+
+static uint64_t fnv1a_hash(uint64_t hash, const void *data, size_t len)
+{
+	const uint8_t *bytes = data;
+
+	for (size_t i = 0; i < len; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
 static void gl_get_shader_info(GLuint shader, const char *file, char **error_string)
 {
 	char *errors;
@@ -189,6 +206,8 @@ static bool gl_shader_init(struct gs_shader *shader, struct gl_shader_parser *gl
 	if (!gl_success("glShaderSource"))
 		return false;
 
+	shader->hash = fnv1a_hash(FNV1A_OFFSET, glsp->gl_string.array, glsp->gl_string.len);
+
 	glCompileShader(shader->obj);
 	if (!gl_success("glCompileShader"))
 		return false;
@@ -434,6 +453,14 @@ static void program_set_param_data(struct gs_program *program, struct program_pa
 {
 	void *array = pp->param->cur_value.array;
 
+	if (pp->param->type != GS_SHADER_PARAM_TEXTURE && pp->param->cur_value.num) {
+		if (pp->last_value.num == pp->param->cur_value.num &&
+		    memcmp(pp->last_value.array, array, pp->last_value.num) == 0)
+			return;
+
+		da_copy(pp->last_value, pp->param->cur_value);
+	}
+
 	if (pp->param->type == GS_SHADER_PARAM_BOOL || pp->param->type == GS_SHADER_PARAM_INT) {
 		if (validate_param(pp, sizeof(int))) {
 			glUniform1iv(pp->obj, 1, (int *)array);
@@ -573,6 +600,7 @@ static bool assign_program_param(struct gs_program *program, struct gs_shader_pa
 	}
 
 	info.param = param;
+	da_init(info.last_value);
 	da_push_back(program->params, &info);
 	return true;
 }
@@ -598,9 +626,135 @@ static inline bool assign_program_params(struct gs_program *program)
 	return true;
 }
 
+/* the cache key covers both translated shaders and the device strings, since
+ * program binaries are driver-specific */
+static bool get_program_cache_path(struct gs_program *program, struct dstr *path)
+{
+	const char *vendor, *renderer, *version;
+	char *data_path;
+	uint64_t hash;
+	GLint num_formats = 0;
+
+	if (!glGetProgramBinary || !glProgramBinary)
+		return false;
+
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+	if (!gl_success("glGetIntegerv") || num_formats <= 0)
+		return false;
+
+	vendor = (const char *)glGetString(GL_VENDOR);
+	renderer = (const char *)glGetString(GL_RENDERER);
+	version = (const char *)glGetString(GL_VERSION);
+	if (!vendor || !renderer || !version)
+		return false;
+
+	hash = fnv1a_hash(FNV1A_OFFSET, &program->vertex_shader->hash, sizeof(uint64_t));
+	hash = fnv1a_hash(hash, &program->pixel_shader->hash, sizeof(uint64_t));
+	hash = fnv1a_hash(hash, vendor, strlen(vendor));
+	hash = fnv1a_hash(hash, renderer, strlen(renderer));
+	hash = fnv1a_hash(hash, version, strlen(version));
+
+	data_path = os_get_program_data_path_ptr("obs-studio/shader-cache");
+	if (!data_path)
+		return false;
+
+	os_mkdirs(data_path);
+	dstr_printf(path, "%s/%016" PRIx64 ".glbin", data_path, hash);
+	bfree(data_path);
+	return true;
+}
+
+/* file layout: uint32_t binary format, program binary, uint64_t checksum */
+static bool load_program_binary(struct gs_program *program, const char *path)
+{
+	uint8_t *data = NULL;
+	uint64_t checksum;
+	uint32_t format;
+	size_t binary_len;
+	long size;
+	int linked = false;
+	bool success = false;
+
+	FILE *file = os_fopen(path, "rb");
+	if (!file)
+		return false;
+
+	if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) <= (long)(sizeof(format) + sizeof(checksum)) ||
+	    fseek(file, 0, SEEK_SET) != 0)
+		goto fail;
+
+	data = bmalloc((size_t)size);
+	if (fread(data, 1, (size_t)size, file) != (size_t)size)
+		goto fail;
+
+	binary_len = (size_t)size - sizeof(format) - sizeof(checksum);
+	memcpy(&format, data, sizeof(format));
+	memcpy(&checksum, data + size - sizeof(checksum), sizeof(checksum));
+
+	if (fnv1a_hash(FNV1A_OFFSET, data + sizeof(format), binary_len) != checksum)
+		goto fail;
+
+	glProgramBinary(program->obj, (GLenum)format, data + sizeof(format), (GLsizei)binary_len);
+	if (!gl_success("glProgramBinary"))
+		goto fail;
+
+	glGetProgramiv(program->obj, GL_LINK_STATUS, &linked);
+	success = gl_success("glGetProgramiv") && linked != GL_FALSE;
+
+fail:
+	fclose(file);
+	bfree(data);
+
+	/* stale or corrupt binaries (e.g. after a driver update) are removed
+	 * and rewritten after the fallback compile */
+	if (!success)
+		os_unlink(path);
+
+	return success;
+}
+
+static void save_program_binary(struct gs_program *program, const char *path)
+{
+	GLint length = 0;
+	GLsizei written = 0;
+	GLenum format = 0;
+	uint32_t format32;
+	uint64_t checksum;
+	uint8_t *data;
+
+	glGetProgramiv(program->obj, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (!gl_success("glGetProgramiv") || length <= 0)
+		return;
+
+	data = bmalloc((size_t)length);
+	glGetProgramBinary(program->obj, length, &written, &format, data);
+	if (!gl_success("glGetProgramBinary") || written <= 0) {
+		bfree(data);
+		return;
+	}
+
+	checksum = fnv1a_hash(FNV1A_OFFSET, data, (size_t)written);
+	format32 = (uint32_t)format;
+
+	FILE *file = os_fopen(path, "wb");
+	if (file) {
+		bool success = fwrite(&format32, sizeof(format32), 1, file) == 1 &&
+			       fwrite(data, 1, (size_t)written, file) == (size_t)written &&
+			       fwrite(&checksum, sizeof(checksum), 1, file) == 1;
+		fclose(file);
+		if (!success)
+			os_unlink(path);
+	}
+
+	bfree(data);
+}
+
 struct gs_program *gs_program_create(struct gs_device *device)
 {
 	struct gs_program *program = bzalloc(sizeof(*program));
+	struct dstr cache_path = {0};
+	bool use_cache = false;
+	bool cached = false;
 	int linked = false;
 
 	program->device = device;
@@ -611,25 +765,36 @@ struct gs_program *gs_program_create(struct gs_device *device)
 	if (!gl_success("glCreateProgram"))
 		goto error_detach_neither;
 
-	glAttachShader(program->obj, program->vertex_shader->obj);
-	if (!gl_success("glAttachShader (vertex)"))
-		goto error_detach_neither;
+	use_cache = get_program_cache_path(program, &cache_path);
+	if (use_cache)
+		cached = load_program_binary(program, cache_path.array);
 
-	glAttachShader(program->obj, program->pixel_shader->obj);
-	if (!gl_success("glAttachShader (pixel)"))
-		goto error_detach_vertex;
+	if (!cached) {
+		glAttachShader(program->obj, program->vertex_shader->obj);
+		if (!gl_success("glAttachShader (vertex)"))
+			goto error_detach_neither;
 
-	glLinkProgram(program->obj);
-	if (!gl_success("glLinkProgram"))
-		goto error;
+		glAttachShader(program->obj, program->pixel_shader->obj);
+		if (!gl_success("glAttachShader (pixel)"))
+			goto error_detach_vertex;
 
-	glGetProgramiv(program->obj, GL_LINK_STATUS, &linked);
-	if (!gl_success("glGetProgramiv"))
-		goto error;
+		if (use_cache) {
+			glProgramParameteri(program->obj, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+			gl_success("glProgramParameteri");
+		}
 
-	if (linked == GL_FALSE) {
-		print_link_errors(program->obj);
-		goto error;
+		glLinkProgram(program->obj);
+		if (!gl_success("glLinkProgram"))
+			goto error;
+
+		glGetProgramiv(program->obj, GL_LINK_STATUS, &linked);
+		if (!gl_success("glGetProgramiv"))
+			goto error;
+
+		if (linked == GL_FALSE) {
+			print_link_errors(program->obj);
+			goto error;
+		}
 	}
 
 	if (!assign_program_attribs(program))
@@ -637,11 +802,18 @@ struct gs_program *gs_program_create(struct gs_device *device)
 	if (!assign_program_params(program))
 		goto error;
 
-	glDetachShader(program->obj, program->vertex_shader->obj);
-	gl_success("glDetachShader (vertex)");
+	if (!cached) {
+		glDetachShader(program->obj, program->vertex_shader->obj);
+		gl_success("glDetachShader (vertex)");
+
+		glDetachShader(program->obj, program->pixel_shader->obj);
+		gl_success("glDetachShader (pixel)");
+
+		if (use_cache)
+			save_program_binary(program, cache_path.array);
+	}
 
-	glDetachShader(program->obj, program->pixel_shader->obj);
-	gl_success("glDetachShader (pixel)");
+	dstr_free(&cache_path);
 
 	program->next = device->first_program;
 	program->prev_next = &device->first_program;
@@ -652,14 +824,19 @@ struct gs_program *gs_program_create(struct gs_device *device)
 	return program;
 
 error:
-	glDetachShader(program->obj, program->pixel_shader->obj);
-	gl_success("glDetachShader (pixel)");
+	if (!cached) {
+		glDetachShader(program->obj, program->pixel_shader->obj);
+		gl_success("glDetachShader (pixel)");
+	}
 
 error_detach_vertex:
-	glDetachShader(program->obj, program->vertex_shader->obj);
-	gl_success("glDetachShader (vertex)");
+	if (!cached) {
+		glDetachShader(program->obj, program->vertex_shader->obj);
+		gl_success("glDetachShader (vertex)");
+	}
 
 error_detach_neither:
+	dstr_free(&cache_path);
 	gs_program_destroy(program);
 	return NULL;
 }
@@ -675,6 +852,12 @@ void gs_program_destroy(struct gs_program *program)
 		gl_success("glUseProgram (zero)");
 	}
 
+	/* invalidate VAO configurations cached against this program */
+	program->device->vao_generation++;
+
+	for (size_t i = 0; i < program->params.num; i++)
+		da_free(program->params.array[i].last_value);
+
 	da_free(program->attribs);
 	da_free(program->params);
 
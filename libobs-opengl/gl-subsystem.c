@@ -293,6 +293,13 @@ int device_create(gs_device_t **p_device, uint32_t adapter)
 	gl_enable(GL_CULL_FACE);
 	gl_gen_vertex_arrays(1, &device->empty_vao);
 
+	/* shadow state starts at the GL defaults (blending and the tests
+	 * are disabled already via bzalloc) */
+	device->cur_blend_src_c = GL_ONE;
+	device->cur_blend_dest_c = GL_ZERO;
+	device->cur_blend_src_a = GL_ONE;
+	device->cur_blend_dest_a = GL_ZERO;
+
 	struct gs_sampler_info raw_load_info;
 	raw_load_info.filter = GS_FILTER_POINT;
 	raw_load_info.address_u = GS_ADDRESS_BORDER;
@@ -1228,32 +1235,41 @@ enum gs_cull_mode device_get_cull_mode(const gs_device_t *device)
 
 void device_enable_blending(gs_device_t *device, bool enable)
 {
+	if (device->cur_blend_enabled == enable)
+		return;
+
+	device->cur_blend_enabled = enable;
+
 	if (enable)
 		gl_enable(GL_BLEND);
 	else
 		gl_disable(GL_BLEND);
-
-	UNUSED_PARAMETER(device);
 }
 
 void device_enable_depth_test(gs_device_t *device, bool enable)
 {
+	if (device->cur_depth_test_enabled == enable)
+		return;
+
+	device->cur_depth_test_enabled = enable;
+
 	if (enable)
 		gl_enable(GL_DEPTH_TEST);
 	else
 		gl_disable(GL_DEPTH_TEST);
-
-	UNUSED_PARAMETER(device);
 }
 
 void device_enable_stencil_test(gs_device_t *device, bool enable)
 {
+	if (device->cur_stencil_test_enabled == enable)
+		return;
+
+	device->cur_stencil_test_enabled = enable;
+
 	if (enable)
 		gl_enable(GL_STENCIL_TEST);
 	else
 		gl_disable(GL_STENCIL_TEST);
-
-	UNUSED_PARAMETER(device);
 }
 
 void device_enable_stencil_write(gs_device_t *device, bool enable)
@@ -1278,11 +1294,18 @@ void device_blend_function(gs_device_t *device, enum gs_blend_type src, enum gs_
 	GLenum gl_src = convert_gs_blend_type(src);
 	GLenum gl_dst = convert_gs_blend_type(dest);
 
+	if (device->cur_blend_src_c == gl_src && device->cur_blend_dest_c == gl_dst &&
+	    device->cur_blend_src_a == gl_src && device->cur_blend_dest_a == gl_dst)
+		return;
+
+	device->cur_blend_src_c = gl_src;
+	device->cur_blend_dest_c = gl_dst;
+	device->cur_blend_src_a = gl_src;
+	device->cur_blend_dest_a = gl_dst;
+
 	glBlendFunc(gl_src, gl_dst);
 	if (!gl_success("glBlendFunc"))
 		blog(LOG_ERROR, "device_blend_function (GL) failed");
-
-	UNUSED_PARAMETER(device);
 }
 
 void device_blend_function_separate(gs_device_t *device, enum gs_blend_type src_c, enum gs_blend_type dest_c,
@@ -1293,11 +1316,18 @@ void device_blend_function_separate(gs_device_t *device, enum gs_blend_type src_
 	GLenum gl_src_a = convert_gs_blend_type(src_a);
 	GLenum gl_dst_a = convert_gs_blend_type(dest_a);
 
+	if (device->cur_blend_src_c == gl_src_c && device->cur_blend_dest_c == gl_dst_c &&
+	    device->cur_blend_src_a == gl_src_a && device->cur_blend_dest_a == gl_dst_a)
+		return;
+
+	device->cur_blend_src_c = gl_src_c;
+	device->cur_blend_dest_c = gl_dst_c;
+	device->cur_blend_src_a = gl_src_a;
+	device->cur_blend_dest_a = gl_dst_a;
+
 	glBlendFuncSeparate(gl_src_c, gl_dst_c, gl_src_a, gl_dst_a);
 	if (!gl_success("glBlendFuncSeparate"))
 		blog(LOG_ERROR, "device_blend_function_separate (GL) failed");
-
-	UNUSED_PARAMETER(device);
 }
 
 void device_blend_op(gs_device_t *device, enum gs_blend_op_type op)
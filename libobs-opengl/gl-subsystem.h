@@ -120,11 +120,11 @@ static inline GLenum convert_gs_internal_format(enum gs_color_format format)
 	case GS_R32F:
 		return GL_R32F;
 	case GS_DXT1:
-		return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
 	case GS_DXT3:
-		return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+		return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
 	case GS_DXT5:
-		return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
 	case GS_RGBA_UNORM:
 		return GL_RGBA;
 	case GS_BGRX_UNORM:
@@ -472,6 +472,9 @@ struct gs_shader {
 	enum gs_shader_type type;
 	GLuint obj;
 
+	/* hash of the translated GLSL, used for the program binary cache */
+	uint64_t hash;
+
 	struct gs_shader_param *viewproj;
 	struct gs_shader_param *world;
 
@@ -483,6 +486,11 @@ struct gs_shader {
 struct program_param {
 	GLint obj;
 	struct gs_shader_param *param;
+
+	/* value last uploaded to this program; uniforms persist in the
+	 * program object, so unchanged parameters can skip the glUniform
+	 * call entirely on subsequent draws */
+	DARRAY(uint8_t) last_value;
 };
 
 struct gs_program {
@@ -502,6 +510,8 @@ extern struct gs_program *gs_program_create(struct gs_device *device);
 extern void gs_program_destroy(struct gs_program *program);
 extern void program_update_params(struct gs_program *shader);
 
+#define GS_NUM_VB_REGIONS 3
+
 struct gs_vertex_buffer {
 	GLuint vao;
 	GLuint vertex_buffer;
@@ -511,6 +521,29 @@ struct gs_vertex_buffer {
 	DARRAY(GLuint) uv_buffers;
 	DARRAY(size_t) uv_sizes;
 
+	/* persistent-mapped ring (dynamic buffers, GL_ARB_buffer_storage):
+	 * each GL buffer holds GS_NUM_VB_REGIONS copies of the vertex data
+	 * and flushes rotate through them behind fences instead of
+	 * remapping/orphaning the storage on every update */
+	bool persistent;
+	size_t cur_region;
+	GLsync region_fences[GS_NUM_VB_REGIONS];
+
+	/* the (program, index buffer, ring region) combination the VAO was
+	 * last configured for; while it matches, binding the VAO is enough
+	 * and the attrib pointers need not be respecified.  The pointers are
+	 * only compared, never dereferenced - vao_program_generation guards
+	 * against reuse of a freed address */
+	struct gs_program *vao_program;
+	struct gs_index_buffer *vao_ib;
+	long vao_program_generation;
+	size_t vao_region;
+	uint8_t *vertex_map;
+	uint8_t *normal_map;
+	uint8_t *tangent_map;
+	uint8_t *color_map;
+	DARRAY(uint8_t *) uv_maps;
+
 	gs_device_t *device;
 	size_t num;
 	bool dynamic;
@@ -649,6 +682,21 @@ struct gs_device {
 	enum gs_cull_mode cur_cull_mode;
 	struct gs_rect cur_viewport;
 
+	/* shadowed GL state so redundant driver calls can be skipped; all
+	 * GL state changes go through the device functions, so the shadow
+	 * cannot go stale */
+	bool cur_blend_enabled;
+	bool cur_depth_test_enabled;
+	bool cur_stencil_test_enabled;
+	GLenum cur_blend_src_c;
+	GLenum cur_blend_dest_c;
+	GLenum cur_blend_src_a;
+	GLenum cur_blend_dest_a;
+
+	/* bumped whenever a program or index buffer is destroyed so that
+	 * vertex buffers know their cached VAO setup may reference it */
+	long vao_generation;
+
 	struct matrix4 cur_proj;
 	struct matrix4 cur_view;
 	struct matrix4 cur_viewproj;
@@ -18,45 +18,85 @@
 #include <graphics/vec3.h>
 #include "gl-subsystem.h"
 
-static bool create_buffers(struct gs_vertex_buffer *vb)
+static bool create_persistent_buffer(GLuint *buffer, uint8_t **map, size_t size, const void *data)
+{
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	bool success;
+
+	if (!gl_gen_buffers(1, buffer))
+		return false;
+	if (!gl_bind_buffer(GL_ARRAY_BUFFER, *buffer))
+		return false;
+
+	glBufferStorage(GL_ARRAY_BUFFER, size * GS_NUM_VB_REGIONS, NULL, flags);
+	success = gl_success("glBufferStorage");
+
+	if (success) {
+		*map = glMapBufferRange(GL_ARRAY_BUFFER, 0, size * GS_NUM_VB_REGIONS, flags);
+		success = gl_success("glMapBufferRange") && *map != NULL;
+	}
+
+	if (success && data)
+		memcpy(*map, data, size);
+
+	gl_bind_buffer(GL_ARRAY_BUFFER, 0);
+	return success;
+}
+
+static inline bool create_vb_buffer(struct gs_vertex_buffer *vb, GLuint *buffer, uint8_t **map, size_t size,
+				    const void *data)
 {
 	GLenum usage = vb->dynamic ? GL_STREAM_DRAW : GL_STATIC_DRAW;
+
+	if (vb->persistent)
+		return create_persistent_buffer(buffer, map, size, data);
+
+	return gl_create_buffer(GL_ARRAY_BUFFER, buffer, size, data, usage);
+}
+
+static bool create_buffers(struct gs_vertex_buffer *vb)
+{
 	size_t i;
 
-	if (!gl_create_buffer(GL_ARRAY_BUFFER, &vb->vertex_buffer, vb->data->num * sizeof(struct vec3),
-			      vb->data->points, usage))
+	vb->persistent = vb->dynamic && GLAD_GL_ARB_buffer_storage;
+
+	if (!create_vb_buffer(vb, &vb->vertex_buffer, &vb->vertex_map, vb->data->num * sizeof(struct vec3),
+			      vb->data->points))
 		return false;
 
 	if (vb->data->normals) {
-		if (!gl_create_buffer(GL_ARRAY_BUFFER, &vb->normal_buffer, vb->data->num * sizeof(struct vec3),
-				      vb->data->normals, usage))
+		if (!create_vb_buffer(vb, &vb->normal_buffer, &vb->normal_map, vb->data->num * sizeof(struct vec3),
+				      vb->data->normals))
 			return false;
 	}
 
 	if (vb->data->tangents) {
-		if (!gl_create_buffer(GL_ARRAY_BUFFER, &vb->tangent_buffer, vb->data->num * sizeof(struct vec3),
-				      vb->data->tangents, usage))
+		if (!create_vb_buffer(vb, &vb->tangent_buffer, &vb->tangent_map, vb->data->num * sizeof(struct vec3),
+				      vb->data->tangents))
 			return false;
 	}
 
 	if (vb->data->colors) {
-		if (!gl_create_buffer(GL_ARRAY_BUFFER, &vb->color_buffer, vb->data->num * sizeof(uint32_t),
-				      vb->data->colors, usage))
+		if (!create_vb_buffer(vb, &vb->color_buffer, &vb->color_map, vb->data->num * sizeof(uint32_t),
+				      vb->data->colors))
 			return false;
 	}
 
 	da_reserve(vb->uv_buffers, vb->data->num_tex);
+	da_reserve(vb->uv_maps, vb->data->num_tex);
 	da_reserve(vb->uv_sizes, vb->data->num_tex);
 
 	for (i = 0; i < vb->data->num_tex; i++) {
 		GLuint tex_buffer;
+		uint8_t *tex_map = NULL;
 		struct gs_tvertarray *tv = vb->data->tvarray + i;
 		size_t size = vb->data->num * sizeof(float) * tv->width;
 
-		if (!gl_create_buffer(GL_ARRAY_BUFFER, &tex_buffer, size, tv->array, usage))
+		if (!create_vb_buffer(vb, &tex_buffer, &tex_map, size, tv->array))
 			return false;
 
 		da_push_back(vb->uv_buffers, &tex_buffer);
+		da_push_back(vb->uv_maps, &tex_map);
 		da_push_back(vb->uv_sizes, &tv->width);
 	}
 
@@ -88,24 +128,42 @@ gs_vertbuffer_t *device_vertexbuffer_create(gs_device_t *device, struct gs_vb_da
 	return vb;
 }
 
+static inline void destroy_vb_buffer(struct gs_vertex_buffer *vb, GLuint buffer)
+{
+	if (!buffer)
+		return;
+
+	if (vb->persistent && gl_bind_buffer(GL_ARRAY_BUFFER, buffer)) {
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		gl_success("glUnmapBuffer");
+		gl_bind_buffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	gl_delete_buffers(1, &buffer);
+}
+
 void gs_vertexbuffer_destroy(gs_vertbuffer_t *vb)
 {
 	if (vb) {
-		if (vb->vertex_buffer)
-			gl_delete_buffers(1, &vb->vertex_buffer);
-		if (vb->normal_buffer)
-			gl_delete_buffers(1, &vb->normal_buffer);
-		if (vb->tangent_buffer)
-			gl_delete_buffers(1, &vb->tangent_buffer);
-		if (vb->color_buffer)
-			gl_delete_buffers(1, &vb->color_buffer);
-		if (vb->uv_buffers.num)
-			gl_delete_buffers((GLsizei)vb->uv_buffers.num, vb->uv_buffers.array);
+		destroy_vb_buffer(vb, vb->vertex_buffer);
+		destroy_vb_buffer(vb, vb->normal_buffer);
+		destroy_vb_buffer(vb, vb->tangent_buffer);
+		destroy_vb_buffer(vb, vb->color_buffer);
+		for (size_t i = 0; i < vb->uv_buffers.num; i++)
+			destroy_vb_buffer(vb, vb->uv_buffers.array[i]);
+
+		for (size_t i = 0; i < GS_NUM_VB_REGIONS; i++) {
+			if (vb->region_fences[i]) {
+				glDeleteSync(vb->region_fences[i]);
+				gl_success("glDeleteSync");
+			}
+		}
 
 		if (vb->vao)
 			gl_delete_vertex_arrays(1, &vb->vao);
 
 		da_free(vb->uv_sizes);
+		da_free(vb->uv_maps);
 		da_free(vb->uv_buffers);
 		gs_vbdata_destroy(vb->data);
 
@@ -113,6 +171,55 @@ void gs_vertexbuffer_destroy(gs_vertbuffer_t *vb)
 	}
 }
 
+static void gs_vertexbuffer_flush_persistent(gs_vertbuffer_t *vb, const struct gs_vb_data *data)
+{
+	size_t num_tex = data->num_tex < vb->data->num_tex ? data->num_tex : vb->data->num_tex;
+	GLsync fence;
+	size_t i;
+
+	/* every draw since the last flush read the current region, so fence
+	 * it and rotate; the new region was fenced GS_NUM_VB_REGIONS flushes
+	 * ago, so any draw still reading it has almost certainly retired and
+	 * the wait below is normally free */
+	vb->region_fences[vb->cur_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	gl_success("glFenceSync");
+
+	vb->cur_region = (vb->cur_region + 1) % GS_NUM_VB_REGIONS;
+
+	fence = vb->region_fences[vb->cur_region];
+	if (fence) {
+		glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		gl_success("glClientWaitSync");
+		glDeleteSync(fence);
+		gl_success("glDeleteSync");
+		vb->region_fences[vb->cur_region] = NULL;
+	}
+
+	if (data->points)
+		memcpy(vb->vertex_map + vb->cur_region * vb->num * sizeof(struct vec3), data->points,
+		       data->num * sizeof(struct vec3));
+
+	if (vb->normal_map && data->normals)
+		memcpy(vb->normal_map + vb->cur_region * vb->num * sizeof(struct vec3), data->normals,
+		       data->num * sizeof(struct vec3));
+
+	if (vb->tangent_map && data->tangents)
+		memcpy(vb->tangent_map + vb->cur_region * vb->num * sizeof(struct vec3), data->tangents,
+		       data->num * sizeof(struct vec3));
+
+	if (vb->color_map && data->colors)
+		memcpy(vb->color_map + vb->cur_region * vb->num * sizeof(uint32_t), data->colors,
+		       data->num * sizeof(uint32_t));
+
+	for (i = 0; i < num_tex; i++) {
+		struct gs_tvertarray *tv = data->tvarray + i;
+		size_t stride = vb->num * vb->uv_sizes.array[i] * sizeof(float);
+
+		memcpy(vb->uv_maps.array[i] + vb->cur_region * stride, tv->array,
+		       data->num * tv->width * sizeof(float));
+	}
+}
+
 static inline void gs_vertexbuffer_flush_internal(gs_vertbuffer_t *vb, const struct gs_vb_data *data)
 {
 	size_t i;
@@ -123,6 +230,11 @@ static inline void gs_vertexbuffer_flush_internal(gs_vertbuffer_t *vb, const str
 		goto failed;
 	}
 
+	if (vb->persistent) {
+		gs_vertexbuffer_flush_persistent(vb, data);
+		return;
+	}
+
 	if (data->points) {
 		if (!update_buffer(GL_ARRAY_BUFFER, vb->vertex_buffer, data->points, data->num * sizeof(struct vec3)))
 			goto failed;
@@ -175,25 +287,35 @@ struct gs_vb_data *gs_vertexbuffer_get_data(const gs_vertbuffer_t *vb)
 }
 
 static inline GLuint get_vb_buffer(struct gs_vertex_buffer *vb, enum attrib_type type, size_t index, GLint *width,
-				   GLenum *gl_type)
+				   GLenum *gl_type, size_t *offset)
 {
+	/* persistent buffers hold one copy of the data per ring region, so
+	 * the attrib pointer has to aim at the region currently in flight */
+	const size_t region = vb->persistent ? vb->cur_region : 0;
+
 	*gl_type = GL_FLOAT;
 	*width = 4;
+	*offset = 0;
 
 	if (type == ATTRIB_POSITION) {
+		*offset = region * vb->num * sizeof(struct vec3);
 		return vb->vertex_buffer;
 	} else if (type == ATTRIB_NORMAL) {
+		*offset = region * vb->num * sizeof(struct vec3);
 		return vb->normal_buffer;
 	} else if (type == ATTRIB_TANGENT) {
+		*offset = region * vb->num * sizeof(struct vec3);
 		return vb->tangent_buffer;
 	} else if (type == ATTRIB_COLOR) {
 		*gl_type = GL_UNSIGNED_BYTE;
+		*offset = region * vb->num * sizeof(uint32_t);
 		return vb->color_buffer;
 	} else if (type == ATTRIB_TEXCOORD) {
 		if (vb->uv_buffers.num <= index)
 			return 0;
 
 		*width = (GLint)vb->uv_sizes.array[index];
+		*offset = region * vb->num * vb->uv_sizes.array[index] * sizeof(float);
 		return vb->uv_buffers.array[index];
 	}
 
@@ -205,9 +327,10 @@ static bool load_vb_buffer(struct shader_attrib *attrib, struct gs_vertex_buffer
 	GLenum type;
 	GLint width;
 	GLuint buffer;
+	size_t offset;
 	bool success = true;
 
-	buffer = get_vb_buffer(vb, attrib->type, attrib->index, &width, &type);
+	buffer = get_vb_buffer(vb, attrib->type, attrib->index, &width, &type, &offset);
 	if (!buffer) {
 		blog(LOG_ERROR, "Vertex buffer does not have the required "
 				"inputs for vertex shader");
@@ -217,7 +340,7 @@ static bool load_vb_buffer(struct shader_attrib *attrib, struct gs_vertex_buffer
 	if (!gl_bind_buffer(GL_ARRAY_BUFFER, buffer))
 		return false;
 
-	glVertexAttribPointer(id, width, type, GL_TRUE, 0, 0);
+	glVertexAttribPointer(id, width, type, GL_TRUE, 0, (const GLvoid *)offset);
 	if (!gl_success("glVertexAttribPointer"))
 		success = false;
 
@@ -234,11 +357,20 @@ static bool load_vb_buffer(struct shader_attrib *attrib, struct gs_vertex_buffer
 bool load_vb_buffers(struct gs_program *program, struct gs_vertex_buffer *vb, struct gs_index_buffer *ib)
 {
 	struct gs_shader *shader = program->vertex_shader;
+	const size_t region = vb->persistent ? vb->cur_region : 0;
 	size_t i;
 
 	if (!gl_bind_vertex_array(vb->vao))
 		return false;
 
+	/* attrib pointers and the element binding live in the VAO; if it was
+	 * last configured for this exact combination, binding it is enough */
+	if (program == vb->vao_program && ib == vb->vao_ib && region == vb->vao_region &&
+	    vb->vao_program_generation == vb->device->vao_generation)
+		return true;
+
+	vb->vao_program = NULL;
+
 	for (i = 0; i < shader->attribs.num; i++) {
 		struct shader_attrib *attrib = shader->attribs.array + i;
 		if (!load_vb_buffer(attrib, vb, program->attribs.array[i]))
@@ -248,6 +380,10 @@ bool load_vb_buffers(struct gs_program *program, struct gs_vertex_buffer *vb, st
 	if (ib && !gl_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, ib->buffer))
 		return false;
 
+	vb->vao_program = program;
+	vb->vao_ib = ib;
+	vb->vao_region = region;
+	vb->vao_program_generation = vb->device->vao_generation;
 	return true;
 }
 
@@ -18,6 +18,16 @@ struct audio_monitor {
 	uint_fast32_t packets;
 	uint_fast64_t frames;
 
+	/* Adaptive buffering: the pulse buffer grows to ride out backlog
+	 * spikes and shrinks back toward the base latency once the peak
+	 * backlog of the last window stays low.  Underruns raise the base
+	 * latency instead. */
+	size_t peak_backlog;
+	uint64_t backlog_window_start;
+	uint32_t base_tlength;
+	uint32_t tlength_cap;
+	volatile long underruns;
+
 	struct deque new_data;
 	audio_resampler_t *resampler;
 
@@ -178,6 +188,65 @@ void process_volume(const struct audio_monitor *monitor, float vol, uint8_t *con
 	}
 }
 
+static void on_underflow(pa_stream *p, void *userdata)
+{
+	PULSE_DATA(userdata);
+
+	os_atomic_inc_long(&data->underruns);
+
+	UNUSED_PARAMETER(p);
+}
+
+#define BACKLOG_WINDOW_NS 5000000000ULL
+
+/* Re-evaluates the buffer size once per window: underruns double the base
+ * latency target, and a buffer that was grown past the observed peak backlog
+ * is shrunk back down so a single scheduling hiccup does not leave the
+ * monitor with permanently higher latency. */
+static void adapt_buffer_attr(struct audio_monitor *data)
+{
+	uint64_t now = os_gettime_ns();
+	uint32_t target;
+	long underruns;
+
+	if (data->new_data.size > data->peak_backlog)
+		data->peak_backlog = data->new_data.size;
+
+	if (!data->backlog_window_start) {
+		data->backlog_window_start = now;
+		return;
+	}
+	if (now - data->backlog_window_start < BACKLOG_WINDOW_NS)
+		return;
+
+	underruns = os_atomic_set_long(&data->underruns, 0);
+	if (underruns > 0) {
+		uint32_t grown = data->base_tlength * 2;
+		if (grown > data->tlength_cap)
+			grown = data->tlength_cap;
+		if (grown != data->base_tlength) {
+			blog(LOG_INFO, "%ld underruns, raising monitor buffer to %" PRIu32 " bytes", underruns, grown);
+			data->base_tlength = grown;
+		}
+	}
+
+	target = (uint32_t)data->peak_backlog;
+	if (target < data->base_tlength)
+		target = data->base_tlength;
+
+	if (data->attr.tlength > target + target / 2) {
+		data->attr.fragsize = (uint32_t)-1;
+		data->attr.maxlength = (uint32_t)-1;
+		data->attr.prebuf = (uint32_t)-1;
+		data->attr.minreq = (uint32_t)-1;
+		data->attr.tlength = target;
+		pa_stream_set_buffer_attr(data->stream, &data->attr, NULL, NULL);
+	}
+
+	data->peak_backlog = 0;
+	data->backlog_window_start = now;
+}
+
 static void do_stream_write(void *param)
 {
 	PULSE_DATA(param);
@@ -192,10 +261,12 @@ static void do_stream_write(void *param)
 		data->attr.maxlength = (uint32_t)-1;
 		data->attr.prebuf = (uint32_t)-1;
 		data->attr.minreq = (uint32_t)-1;
-		data->attr.tlength = data->new_data.size;
+		data->attr.tlength = (uint32_t)data->new_data.size;
 		pa_stream_set_buffer_attr(data->stream, &data->attr, NULL, NULL);
 	}
 
+	adapt_buffer_attr(data);
+
 	// Buffer up enough data before we start playing.
 	if (pa_stream_is_corked(data->stream)) {
 		if (data->new_data.size >= data->attr.tlength) {
@@ -333,6 +404,7 @@ static void pulseaudio_stop_playback(struct audio_monitor *monitor)
 		/* Remove the callbacks, to ensure we no longer try to do anything
 		 * with this stream object */
 		pulseaudio_write_callback(monitor->stream, NULL, NULL);
+		pulseaudio_set_underflow_callback(monitor->stream, NULL, NULL);
 
 		/* Unreference the stream and drop it. PA will free it when it can. */
 		pulseaudio_lock();
@@ -437,6 +509,9 @@ static bool audio_monitor_init(struct audio_monitor *monitor, obs_source_t *sour
 	monitor->attr.prebuf = (uint32_t)-1;
 	monitor->attr.tlength = pa_usec_to_bytes(25000, &spec);
 
+	monitor->base_tlength = monitor->attr.tlength;
+	monitor->tlength_cap = monitor->attr.tlength * 8;
+
 	pa_stream_flags_t flags = PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_AUTO_TIMING_UPDATE | PA_STREAM_START_CORKED;
 
 	int_fast32_t ret = pulseaudio_connect_playback(monitor->stream, monitor->device, &monitor->attr, flags);
@@ -446,6 +521,8 @@ static bool audio_monitor_init(struct audio_monitor *monitor, obs_source_t *sour
 		return false;
 	}
 
+	pulseaudio_set_underflow_callback(monitor->stream, on_underflow, monitor);
+
 	blog(LOG_INFO, "Started Monitoring in '%s'", monitor->device);
 	return true;
 }
@@ -111,6 +111,28 @@ static struct signal_info *getsignal(signal_handler_t *handler, const char *name
 	return signal;
 }
 
+/* The signal list is append-only; signals are never removed until the
+ * handler itself is destroyed.  As long as appends publish the new node
+ * atomically (see signal_handler_add), the emit path can walk the list
+ * without taking the handler mutex. */
+static struct signal_info *getsignal_lockfree(signal_handler_t *handler, const char *name)
+{
+	struct signal_info *signal;
+
+	if (!handler)
+		return NULL;
+
+	signal = os_atomic_load_ptr((void *const volatile *)&handler->first);
+	while (signal != NULL) {
+		if (strcmp(signal->func.name, name) == 0)
+			break;
+
+		signal = os_atomic_load_ptr((void *const volatile *)&signal->next);
+	}
+
+	return signal;
+}
+
 /* ------------------------------------------------------------------------- */
 
 signal_handler_t *signal_handler_create(void)
@@ -177,10 +199,12 @@ bool signal_handler_add(signal_handler_t *handler, const char *signal_decl)
 		success = false;
 	} else {
 		sig = signal_info_create(&func);
+		/* publish atomically so getsignal_lockfree never sees a
+		 * partially initialized node */
 		if (!last)
-			handler->first = sig;
+			os_atomic_set_ptr((void *volatile *)&handler->first, sig);
 		else
-			last->next = sig;
+			os_atomic_set_ptr((void *volatile *)&last->next, sig);
 	}
 
 	pthread_mutex_unlock(&handler->mutex);
@@ -289,12 +313,19 @@ void signal_handler_remove_current(void)
 
 void signal_handler_signal(signal_handler_t *handler, const char *signal, calldata_t *params)
 {
-	struct signal_info *sig = getsignal_locked(handler, signal);
+	struct signal_info *sig = getsignal_lockfree(handler, signal);
 	long remove_refs = 0;
 
 	if (!sig)
 		return;
 
+	/* High-frequency signals usually have no listeners at all; skip
+	 * both callback mutexes in that case.  The unlocked reads can miss
+	 * a callback added concurrently with this emission, but the locked
+	 * path never ordered connects against in-flight emissions either. */
+	if (!sig->callbacks.num && !handler->global_callbacks.num)
+		return;
+
 	pthread_mutex_lock(&sig->mutex);
 	sig->signalling = true;
 
@@ -1732,6 +1732,7 @@ static void ep_compile_annotations(ep_param_array_t *ep_annotations, gs_effect_p
 		struct ep_param *param_in = ep_annotations->array + i;
 
 		param->name = bstrdup(param_in->name);
+		param->name_hash = effect_name_hash(param->name);
 		param->section = EFFECT_ANNOTATION;
 		param->effect = ep->effect;
 		da_move(param->default_val, param_in->default_val);
@@ -1760,6 +1761,7 @@ static void ep_compile_param(struct effect_parser *ep, size_t idx)
 	param_in->param = param;
 
 	param->name = bstrdup(param_in->name);
+	param->name_hash = effect_name_hash(param->name);
 	param->section = EFFECT_PARAM;
 	param->effect = ep->effect;
 	da_move(param->default_val, param_in->default_val);
@@ -1911,6 +1913,7 @@ static inline bool ep_compile_technique(struct effect_parser *ep, size_t idx)
 	tech_in = ep->techniques.array + idx;
 
 	tech->name = bstrdup(tech_in->name);
+	tech->name_hash = effect_name_hash(tech->name);
 	tech->section = EFFECT_TECHNIQUE;
 	tech->effect = ep->effect;
 
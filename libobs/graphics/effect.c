@@ -40,9 +40,11 @@ gs_technique_t *gs_effect_get_technique(const gs_effect_t *effect, const char *n
 	if (!effect)
 		return NULL;
 
+	uint32_t hash = effect_name_hash(name);
+
 	for (size_t i = 0; i < effect->techniques.num; i++) {
 		struct gs_effect_technique *tech = effect->techniques.array + i;
-		if (strcmp(tech->name, name) == 0)
+		if (tech->name_hash == hash && strcmp(tech->name, name) == 0)
 			return tech;
 	}
 
@@ -278,11 +280,12 @@ gs_eparam_t *gs_effect_get_param_by_name(const gs_effect_t *effect, const char *
 		return NULL;
 
 	struct gs_effect_param *params = effect->params.array;
+	uint32_t hash = effect_name_hash(name);
 
 	for (size_t i = 0; i < effect->params.num; i++) {
 		struct gs_effect_param *param = params + i;
 
-		if (strcmp(param->name, name) == 0)
+		if (param->name_hash == hash && strcmp(param->name, name) == 0)
 			return param;
 	}
 
@@ -311,10 +314,11 @@ gs_eparam_t *gs_param_get_annotation_by_name(const gs_eparam_t *param, const cha
 	if (!param)
 		return NULL;
 	struct gs_effect_param *params = param->annotations.array;
+	uint32_t hash = effect_name_hash(name);
 
 	for (size_t i = 0; i < param->annotations.num; i++) {
 		struct gs_effect_param *g_param = params + i;
-		if (strcmp(g_param->name, name) == 0)
+		if (g_param->name_hash == hash && strcmp(g_param->name, name) == 0)
 			return g_param;
 	}
 	return NULL;
@@ -475,6 +479,8 @@ void gs_effect_set_texture(gs_eparam_t *param, gs_texture_t *val)
 	struct gs_shader_texture shader_tex;
 	shader_tex.tex = val;
 	shader_tex.srgb = false;
+	if (val)
+		gs_texture_mark_used(val);
 	effect_setval_inline(param, &shader_tex, sizeof(shader_tex));
 }
 
@@ -483,6 +489,8 @@ void gs_effect_set_texture_srgb(gs_eparam_t *param, gs_texture_t *val)
 	struct gs_shader_texture shader_tex;
 	shader_tex.tex = val;
 	shader_tex.srgb = true;
+	if (val)
+		gs_texture_mark_used(val);
 	effect_setval_inline(param, &shader_tex, sizeof(shader_tex));
 }
 
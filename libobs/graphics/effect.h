@@ -20,6 +20,8 @@
 #include "effect-parser.h"
 #include "graphics.h"
 
+#include "../util/crc32.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -42,10 +44,19 @@ typedef DARRAY(struct pass_shaderparam) pass_shaderparam_array_t;
 
 enum effect_section { EFFECT_PARAM, EFFECT_TECHNIQUE, EFFECT_SAMPLER, EFFECT_PASS, EFFECT_ANNOTATION };
 
+/* Parameter and technique names are hashed once at effect compile time so
+ * that per-frame by-name lookups reduce to integer comparisons, with strcmp
+ * only confirming an actual hash match. */
+static inline uint32_t effect_name_hash(const char *name)
+{
+	return calc_crc32(0, name, strlen(name));
+}
+
 /* ------------------------------------------------------------------------- */
 
 struct gs_effect_param {
 	char *name;
+	uint32_t name_hash;
 	enum effect_section section;
 
 	enum gs_shader_param_type type;
@@ -120,6 +131,7 @@ static inline void effect_pass_free(struct gs_effect_pass *pass)
 
 struct gs_effect_technique {
 	char *name;
+	uint32_t name_hash;
 	enum effect_section section;
 	struct gs_effect *effect;
 
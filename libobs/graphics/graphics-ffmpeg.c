@@ -406,23 +406,42 @@ static void *ffmpeg_image_reformat_frame(struct ffmpeg_image *info, AVFrame *fra
 				src += src_linesize - src_min_line;
 			}
 		} else if (alpha_mode == GS_IMAGE_ALPHA_PREMULTIPLY_SRGB) {
+			/* expand whole rows so the sRGB transfer runs through
+			 * the batch kernels instead of per-texel powf() */
+			float *row = bmalloc(row_elements * 4 * sizeof(float));
 			for (int y = 0; y < info->cy; y++) {
+				const uint8_t *sp = src;
+				float *rf = row;
 				for (size_t x = 0; x < row_elements; ++x) {
-					memcpy(value, src, sizeof(value));
-					f[0] = (float)obs_bswap16(value[0]) / 65535.0f;
-					f[1] = (float)obs_bswap16(value[1]) / 65535.0f;
-					f[2] = (float)obs_bswap16(value[2]) / 65535.0f;
-					f[3] = (float)obs_bswap16(value[3]) / 65535.0f;
-					gs_float3_srgb_nonlinear_to_linear(f);
-					gs_premultiply_float4(f);
-					gs_float3_srgb_linear_to_nonlinear(f);
-					gs_float4_to_u8x4(dst, f);
+					memcpy(value, sp, sizeof(value));
+					rf[0] = (float)obs_bswap16(value[0]) / 65535.0f;
+					rf[1] = (float)obs_bswap16(value[1]) / 65535.0f;
+					rf[2] = (float)obs_bswap16(value[2]) / 65535.0f;
+					rf[3] = (float)obs_bswap16(value[3]) / 65535.0f;
+					rf += 4;
+					sp += sizeof(value);
+				}
+
+				gs_float4_srgb_nonlinear_to_linear_batch(row, row_elements);
+
+				rf = row;
+				for (size_t x = 0; x < row_elements; ++x) {
+					gs_premultiply_float4(rf);
+					rf += 4;
+				}
+
+				gs_float4_srgb_linear_to_nonlinear_batch(row, row_elements);
+
+				rf = row;
+				for (size_t x = 0; x < row_elements; ++x) {
+					gs_float4_to_u8x4(dst, rf);
 					dst += sizeof(*dst) * 4;
-					src += sizeof(value);
+					rf += 4;
 				}
 
-				src += src_linesize - src_min_line;
+				src += src_linesize;
 			}
+			bfree(row);
 		} else if (alpha_mode == GS_IMAGE_ALPHA_PREMULTIPLY) {
 			for (int y = 0; y < info->cy; y++) {
 				for (size_t x = 0; x < row_elements; ++x) {
@@ -590,34 +609,45 @@ static float pq_to_linear(float u)
 	return powf(fabsf(max(common - 0.8359375f, 0.f) / (18.8515625f - 18.6875f * common)), 1.f / 0.1593017578f);
 }
 
+#define PQ_CONVERT_BATCH 256
+
 static void convert_pq_to_cccs(const BYTE *intermediate, const UINT intermediate_size, BYTE *bytes)
 {
 	const BYTE *src_cursor = intermediate;
 	const BYTE *src_cursor_end = src_cursor + intermediate_size;
 	BYTE *dst_cursor = bytes;
 	uint32_t rgb10;
-	struct half rgba16[4];
-	rgba16[3].u = 0x3c00;
+	float batch[PQ_CONVERT_BATCH * 4];
 	while (src_cursor < src_cursor_end) {
-		memcpy(&rgb10, src_cursor, sizeof(rgb10));
-		const float blue = (float)(rgb10 & 0x3ff) / 1023.f;
-		const float green = (float)((rgb10 >> 10) & 0x3ff) / 1023.f;
-		const float red = (float)((rgb10 >> 20) & 0x3ff) / 1023.f;
-		const float red2020 = pq_to_linear(red);
-		const float green2020 = pq_to_linear(green);
-		const float blue2020 = pq_to_linear(blue);
-		const float red709 = 1.6604910021084345f * red2020 - 0.58764113878854951f * green2020 -
-				     0.072849863319884883f * blue2020;
-		const float green709 = -0.12455047452159074f * red2020 + 1.1328998971259603f * green2020 -
-				       0.0083494226043694768f * blue2020;
-		const float blue709 = -0.018150763354905303f * red2020 - 0.10057889800800739f * green2020 +
-				      1.1187296613629127f * blue2020;
-		rgba16[0] = half_from_float(red709 * 125.f);
-		rgba16[1] = half_from_float(green709 * 125.f);
-		rgba16[2] = half_from_float(blue709 * 125.f);
-		memcpy(dst_cursor, &rgba16, sizeof(rgba16));
-		src_cursor += 4;
-		dst_cursor += 8;
+		size_t texels = (size_t)(src_cursor_end - src_cursor) / 4;
+		if (texels > PQ_CONVERT_BATCH)
+			texels = PQ_CONVERT_BATCH;
+
+		float *f = batch;
+		for (size_t i = 0; i < texels; ++i) {
+			memcpy(&rgb10, src_cursor, sizeof(rgb10));
+			const float blue = (float)(rgb10 & 0x3ff) / 1023.f;
+			const float green = (float)((rgb10 >> 10) & 0x3ff) / 1023.f;
+			const float red = (float)((rgb10 >> 20) & 0x3ff) / 1023.f;
+			const float red2020 = pq_to_linear(red);
+			const float green2020 = pq_to_linear(green);
+			const float blue2020 = pq_to_linear(blue);
+			const float red709 = 1.6604910021084345f * red2020 - 0.58764113878854951f * green2020 -
+					     0.072849863319884883f * blue2020;
+			const float green709 = -0.12455047452159074f * red2020 + 1.1328998971259603f * green2020 -
+					       0.0083494226043694768f * blue2020;
+			const float blue709 = -0.018150763354905303f * red2020 - 0.10057889800800739f * green2020 +
+					      1.1187296613629127f * blue2020;
+			f[0] = red709 * 125.f;
+			f[1] = green709 * 125.f;
+			f[2] = blue709 * 125.f;
+			f[3] = 1.f;
+			f += 4;
+			src_cursor += 4;
+		}
+
+		gs_half_from_float_plane((struct half *)dst_cursor, batch, texels * 4);
+		dst_cursor += texels * 8;
 	}
 }
 
@@ -314,6 +314,10 @@ struct graphics_subsystem {
 	gs_vertbuffer_t *flipped_sprite_buffer;
 	gs_vertbuffer_t *subregion_buffer;
 
+	gs_vertbuffer_t *sprite_batch_buffer;
+	size_t sprite_batch_capacity; /* in quads */
+	size_t sprite_batch_num;
+
 	bool using_immediate;
 	struct gs_vb_data *vbd;
 	gs_vertbuffer_t *immediate_vertbuffer;
@@ -333,3 +337,6 @@ struct graphics_subsystem {
 
 	bool linear_srgb;
 };
+
+/* updates a texture's last-use frame in the residency registry */
+extern void gs_texture_mark_used(gs_texture_t *tex);
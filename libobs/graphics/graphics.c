@@ -20,6 +20,7 @@
 #include "../util/base.h"
 #include "../util/bmem.h"
 #include "../util/platform.h"
+#include "../util/uthash.h"
 #include "graphics-internal.h"
 #include "vec2.h"
 #include "vec3.h"
@@ -251,6 +252,8 @@ void gs_destroy(graphics_t *graphics)
 			effect = next;
 		}
 
+		if (graphics->sprite_batch_buffer)
+			graphics->exports.gs_vertexbuffer_destroy(graphics->sprite_batch_buffer);
 		graphics->exports.gs_vertexbuffer_destroy(graphics->subregion_buffer);
 		graphics->exports.gs_vertexbuffer_destroy(graphics->flipped_sprite_buffer);
 		graphics->exports.gs_vertexbuffer_destroy(graphics->sprite_buffer);
@@ -1118,6 +1121,136 @@ void gs_draw_sprite_subregion(gs_texture_t *tex, uint32_t flip, uint32_t sub_x,
 	gs_draw(GS_TRISTRIP, 0, 0);
 }
 
+#define SPRITE_BATCH_INITIAL_QUADS 64
+
+static bool sprite_batch_ensure_capacity(graphics_t *graphics, size_t num_quads)
+{
+	size_t capacity = graphics->sprite_batch_capacity;
+	struct gs_vb_data *vbd;
+
+	if (graphics->sprite_batch_buffer && num_quads <= capacity)
+		return true;
+
+	if (!capacity)
+		capacity = SPRITE_BATCH_INITIAL_QUADS;
+	while (capacity < num_quads)
+		capacity *= 2;
+
+	vbd = gs_vbdata_create();
+	vbd->num = capacity * 6;
+	vbd->points = bmalloc(sizeof(struct vec3) * vbd->num);
+	vbd->num_tex = 1;
+	vbd->tvarray = bzalloc(sizeof(struct gs_tvertarray));
+	vbd->tvarray[0].width = 2;
+	vbd->tvarray[0].array = bmalloc(sizeof(struct vec2) * vbd->num);
+
+	if (graphics->sprite_batch_buffer) {
+		struct gs_vb_data *old = gs_vertexbuffer_get_data(graphics->sprite_batch_buffer);
+		size_t num_verts = graphics->sprite_batch_num * 6;
+
+		memcpy(vbd->points, old->points, sizeof(struct vec3) * num_verts);
+		memcpy(vbd->tvarray[0].array, old->tvarray[0].array, sizeof(struct vec2) * num_verts);
+
+		gs_vertexbuffer_destroy(graphics->sprite_batch_buffer);
+	}
+
+	graphics->sprite_batch_buffer = gs_vertexbuffer_create(vbd, GS_DYNAMIC);
+	graphics->sprite_batch_capacity = graphics->sprite_batch_buffer ? capacity : 0;
+	return graphics->sprite_batch_buffer != NULL;
+}
+
+void gs_sprite_batch_begin(void)
+{
+	graphics_t *graphics = thread_graphics;
+
+	if (!gs_valid("gs_sprite_batch_begin"))
+		return;
+
+	graphics->sprite_batch_num = 0;
+}
+
+void gs_sprite_batch_quad(const struct matrix4 *transform, float width, float height, uint32_t flip)
+{
+	graphics_t *graphics = thread_graphics;
+	struct vec3 corners[4];
+	struct gs_vb_data *data;
+	struct vec3 *points;
+	struct vec2 *uvs;
+	float start_u, end_u;
+	float start_v, end_v;
+	size_t base;
+
+	if (!gs_valid_p("gs_sprite_batch_quad", transform))
+		return;
+
+	if (width == 0.0f || height == 0.0f) {
+		blog(LOG_ERROR, "A sprite cannot be batched without "
+				"a width/height");
+		return;
+	}
+
+	if (!sprite_batch_ensure_capacity(graphics, graphics->sprite_batch_num + 1))
+		return;
+
+	for (size_t i = 0; i < 4; i++) {
+		struct vec3 pos;
+		vec3_set(&pos, (i & 1) ? width : 0.0f, (i & 2) ? height : 0.0f, 0.0f);
+		vec3_transform(&corners[i], &pos, transform);
+	}
+
+	start_u = (flip & GS_FLIP_U) != 0 ? 1.0f : 0.0f;
+	end_u = 1.0f - start_u;
+	start_v = (flip & GS_FLIP_V) != 0 ? 1.0f : 0.0f;
+	end_v = 1.0f - start_v;
+
+	data = gs_vertexbuffer_get_data(graphics->sprite_batch_buffer);
+	base = graphics->sprite_batch_num * 6;
+	points = data->points + base;
+	uvs = (struct vec2 *)data->tvarray[0].array + base;
+
+	points[0] = corners[0];
+	points[1] = corners[1];
+	points[2] = corners[2];
+	points[3] = corners[2];
+	points[4] = corners[1];
+	points[5] = corners[3];
+
+	vec2_set(&uvs[0], start_u, start_v);
+	vec2_set(&uvs[1], end_u, start_v);
+	vec2_set(&uvs[2], start_u, end_v);
+	vec2_set(&uvs[3], start_u, end_v);
+	vec2_set(&uvs[4], end_u, start_v);
+	vec2_set(&uvs[5], end_u, end_v);
+
+	graphics->sprite_batch_num++;
+}
+
+size_t gs_sprite_batch_num(void)
+{
+	graphics_t *graphics = thread_graphics;
+
+	if (!gs_valid("gs_sprite_batch_num"))
+		return 0;
+
+	return graphics->sprite_batch_num;
+}
+
+void gs_sprite_batch_draw(void)
+{
+	graphics_t *graphics = thread_graphics;
+
+	if (!gs_valid("gs_sprite_batch_draw"))
+		return;
+	if (!graphics->sprite_batch_num)
+		return;
+
+	gs_vertexbuffer_flush(graphics->sprite_batch_buffer);
+	gs_load_vertexbuffer(graphics->sprite_batch_buffer);
+	gs_load_indexbuffer(NULL);
+
+	gs_draw(GS_TRIS, 0, (uint32_t)(graphics->sprite_batch_num * 6));
+}
+
 void gs_draw_cube_backdrop(gs_texture_t *cubetex, const struct quat *rot, float left, float right, float top,
 			   float bottom, float znear)
 {
@@ -1376,6 +1509,178 @@ uint32_t gs_get_height(void)
 	return graphics->exports.device_get_height(graphics->device);
 }
 
+/* ------------------------------------------------------------------------- */
+/* texture residency tracking
+ *
+ * every texture created through the gs_texture_create* wrappers is
+ * recorded with an estimated size and the frame it was last bound, so
+ * the renderer can keep total texture memory under a budget.  owners of
+ * re-creatable textures opt in to demotion with
+ * gs_texture_set_demotable(); gs_process_texture_budget() then releases
+ * the least recently used idle textures when the budget is exceeded.
+ *
+ * the registry has its own mutex because stats are read off the
+ * graphics thread. */
+
+struct texture_residency_entry {
+	gs_texture_t *tex;
+	uint64_t size;
+	uint64_t last_used_frame;
+	void (*demote)(void *param);
+	void *demote_param;
+	UT_hash_handle hh;
+};
+
+static pthread_mutex_t residency_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct texture_residency_entry *residency_entries = NULL;
+static uint64_t residency_frame = 0;
+static uint64_t residency_live_bytes = 0;
+static uint64_t residency_live_textures = 0;
+static uint64_t residency_budget = 0;
+static uint64_t residency_demotions = 0;
+static uint64_t residency_demoted_bytes = 0;
+
+static void track_texture_create(gs_texture_t *tex, uint32_t width, uint32_t height, enum gs_color_format format,
+				 uint32_t levels)
+{
+	struct texture_residency_entry *entry;
+	uint64_t size;
+
+	if (!tex)
+		return;
+
+	size = (uint64_t)width * height * gs_get_format_bpp(format) / 8;
+	if (levels != 1)
+		size += size / 3; /* full mip chain upper bound */
+
+	entry = bzalloc(sizeof(*entry));
+	entry->tex = tex;
+	entry->size = size;
+
+	pthread_mutex_lock(&residency_mutex);
+	entry->last_used_frame = residency_frame;
+	HASH_ADD_PTR(residency_entries, tex, entry);
+	residency_live_bytes += size;
+	residency_live_textures++;
+	pthread_mutex_unlock(&residency_mutex);
+}
+
+static void track_texture_destroy(gs_texture_t *tex)
+{
+	struct texture_residency_entry *entry;
+
+	pthread_mutex_lock(&residency_mutex);
+	HASH_FIND_PTR(residency_entries, &tex, entry);
+	if (entry) {
+		HASH_DELETE(hh, residency_entries, entry);
+		residency_live_bytes -= entry->size;
+		residency_live_textures--;
+	}
+	pthread_mutex_unlock(&residency_mutex);
+
+	bfree(entry);
+}
+
+static inline void track_texture_use(gs_texture_t *tex)
+{
+	struct texture_residency_entry *entry;
+
+	if (!tex)
+		return;
+
+	pthread_mutex_lock(&residency_mutex);
+	HASH_FIND_PTR(residency_entries, &tex, entry);
+	if (entry)
+		entry->last_used_frame = residency_frame;
+	pthread_mutex_unlock(&residency_mutex);
+}
+
+void gs_set_texture_budget(uint64_t bytes)
+{
+	pthread_mutex_lock(&residency_mutex);
+	residency_budget = bytes;
+	pthread_mutex_unlock(&residency_mutex);
+}
+
+void gs_get_texture_memory_stats(struct gs_texture_memory_stats *stats)
+{
+	pthread_mutex_lock(&residency_mutex);
+	stats->live_bytes = residency_live_bytes;
+	stats->live_textures = residency_live_textures;
+	stats->budget_bytes = residency_budget;
+	stats->demotions = residency_demotions;
+	stats->demoted_bytes = residency_demoted_bytes;
+	pthread_mutex_unlock(&residency_mutex);
+}
+
+void gs_texture_set_demotable(gs_texture_t *tex, void (*demote)(void *param), void *param)
+{
+	struct texture_residency_entry *entry;
+
+	if (!tex)
+		return;
+
+	pthread_mutex_lock(&residency_mutex);
+	HASH_FIND_PTR(residency_entries, &tex, entry);
+	if (entry) {
+		entry->demote = demote;
+		entry->demote_param = param;
+	}
+	pthread_mutex_unlock(&residency_mutex);
+}
+
+void gs_process_texture_budget(void)
+{
+	if (!gs_valid("gs_process_texture_budget"))
+		return;
+
+	pthread_mutex_lock(&residency_mutex);
+	residency_frame++;
+
+	while (residency_budget && residency_live_bytes > residency_budget) {
+		struct texture_residency_entry *entry, *tmp;
+		struct texture_residency_entry *best = NULL;
+		void (*demote)(void *param);
+		void *param;
+
+		HASH_ITER (hh, residency_entries, entry, tmp) {
+			if (!entry->demote)
+				continue;
+			/* never demote textures bound this frame or last */
+			if (entry->last_used_frame + 1 >= residency_frame)
+				continue;
+			if (!best || entry->last_used_frame < best->last_used_frame)
+				best = entry;
+		}
+
+		if (!best)
+			break;
+
+		demote = best->demote;
+		param = best->demote_param;
+
+		/* the owner may keep the texture; don't pick it again */
+		best->demote = NULL;
+		residency_demotions++;
+		residency_demoted_bytes += best->size;
+
+		/* the callback typically destroys the texture, which
+		 * re-enters the registry */
+		pthread_mutex_unlock(&residency_mutex);
+		demote(param);
+		pthread_mutex_lock(&residency_mutex);
+	}
+
+	pthread_mutex_unlock(&residency_mutex);
+}
+
+void gs_texture_mark_used(gs_texture_t *tex)
+{
+	track_texture_use(tex);
+}
+
+/* ------------------------------------------------------------------------- */
+
 static inline bool is_pow2(uint32_t size)
 {
 	return size >= 2 && (size & (size - 1)) == 0;
@@ -1408,8 +1713,10 @@ gs_texture_t *gs_texture_create(uint32_t width, uint32_t height, enum gs_color_f
 		levels = 1;
 	}
 
-	return graphics->exports.device_texture_create(graphics->device, width, height, color_format, levels, data,
-						       flags);
+	gs_texture_t *tex = graphics->exports.device_texture_create(graphics->device, width, height, color_format,
+								    levels, data, flags);
+	track_texture_create(tex, width, height, color_format, levels);
+	return tex;
 }
 
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__DragonFly__)
@@ -1420,8 +1727,10 @@ gs_texture_t *gs_texture_create_from_dmabuf(unsigned int width, unsigned int hei
 {
 	graphics_t *graphics = thread_graphics;
 
-	return graphics->exports.device_texture_create_from_dmabuf(
+	gs_texture_t *tex = graphics->exports.device_texture_create_from_dmabuf(
 		graphics->device, width, height, drm_format, color_format, n_planes, fds, strides, offsets, modifiers);
+	track_texture_create(tex, width, height, color_format, 1);
+	return tex;
 }
 
 bool gs_query_dmabuf_capabilities(enum gs_dmabuf_flags *dmabuf_flags, uint32_t **drm_formats, size_t *n_formats)
@@ -1445,8 +1754,10 @@ gs_texture_t *gs_texture_create_from_pixmap(uint32_t width, uint32_t height, enu
 {
 	graphics_t *graphics = thread_graphics;
 
-	return graphics->exports.device_texture_create_from_pixmap(graphics->device, width, height, color_format,
-								   target, pixmap);
+	gs_texture_t *tex = graphics->exports.device_texture_create_from_pixmap(graphics->device, width, height,
+										color_format, target, pixmap);
+	track_texture_create(tex, width, height, color_format, 1);
+	return tex;
 }
 
 bool gs_query_sync_capabilities(void)
@@ -1712,6 +2023,7 @@ void gs_load_texture(gs_texture_t *tex, int unit)
 	if (!gs_valid("gs_load_texture"))
 		return;
 
+	track_texture_use(tex);
 	graphics->exports.device_load_texture(graphics->device, tex, unit);
 }
 
@@ -1812,6 +2124,7 @@ void gs_set_render_target(gs_texture_t *tex, gs_zstencil_t *zstencil)
 	if (!gs_valid("gs_set_render_target"))
 		return;
 
+	track_texture_use(tex);
 	graphics->exports.device_set_render_target(graphics->device, tex, zstencil);
 }
 
@@ -1822,6 +2135,7 @@ void gs_set_render_target_with_color_space(gs_texture_t *tex, gs_zstencil_t *zst
 	if (!gs_valid("gs_set_render_target_with_color_space"))
 		return;
 
+	track_texture_use(tex);
 	graphics->exports.device_set_render_target_with_color_space(graphics->device, tex, zstencil, space);
 }
 
@@ -1884,6 +2198,8 @@ void gs_copy_texture(gs_texture_t *dst, gs_texture_t *src)
 	if (!gs_valid_p2("gs_copy_texture", dst, src))
 		return;
 
+	track_texture_use(dst);
+	track_texture_use(src);
 	graphics->exports.device_copy_texture(graphics->device, dst, src);
 }
 
@@ -1895,6 +2211,8 @@ void gs_copy_texture_region(gs_texture_t *dst, uint32_t dst_x, uint32_t dst_y, g
 	if (!gs_valid_p("gs_copy_texture_region", dst))
 		return;
 
+	track_texture_use(dst);
+	track_texture_use(src);
 	graphics->exports.device_copy_texture_region(graphics->device, dst, dst_x, dst_y, src, src_x, src_y, src_w,
 						     src_h);
 }
@@ -1906,6 +2224,7 @@ void gs_stage_texture(gs_stagesurf_t *dst, gs_texture_t *src)
 	if (!gs_valid("gs_stage_texture"))
 		return;
 
+	track_texture_use(src);
 	graphics->exports.device_stage_texture(graphics->device, dst, src);
 }
 
@@ -2382,6 +2701,7 @@ void gs_shader_set_texture(gs_sparam_t *param, gs_texture_t *val)
 	if (!gs_valid_p("gs_shader_set_texture", param))
 		return;
 
+	track_texture_use(val);
 	graphics->exports.gs_shader_set_texture(param, val);
 }
 
@@ -2424,6 +2744,7 @@ void gs_texture_destroy(gs_texture_t *tex)
 	if (!tex)
 		return;
 
+	track_texture_destroy(tex);
 	graphics->exports.gs_texture_destroy(tex);
 }
 
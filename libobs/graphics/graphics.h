@@ -586,6 +586,22 @@ EXPORT void gs_draw_quadf(gs_texture_t *tex, uint32_t flip, float width, float h
 EXPORT void gs_draw_sprite_subregion(gs_texture_t *tex, uint32_t flip, uint32_t x, uint32_t y, uint32_t cx,
 				     uint32_t cy);
 
+/**
+ * Batched sprite drawing
+ *
+ *   Queue any number of quads with gs_sprite_batch_quad(), then issue all of
+ * them as a single draw call with gs_sprite_batch_draw().  Each quad's
+ * transform is applied on the CPU when it is queued, and composes with the
+ * current matrix at draw time; because one draw is issued, all queued quads
+ * must share the same texture and effect state.  gs_sprite_batch_begin()
+ * discards any previously queued quads, so gs_sprite_batch_draw() may be
+ * called repeatedly (e.g. once per effect pass).
+ */
+EXPORT void gs_sprite_batch_begin(void);
+EXPORT void gs_sprite_batch_quad(const struct matrix4 *transform, float width, float height, uint32_t flip);
+EXPORT size_t gs_sprite_batch_num(void);
+EXPORT void gs_sprite_batch_draw(void);
+
 EXPORT void gs_draw_cube_backdrop(gs_texture_t *cubetex, const struct quat *rot, float left, float right, float top,
 				  float bottom, float znear);
 
@@ -741,6 +757,35 @@ EXPORT bool gs_texture_is_rect(const gs_texture_t *tex);
  */
 EXPORT void *gs_texture_get_obj(gs_texture_t *tex);
 
+/* texture residency / memory budget */
+
+struct gs_texture_memory_stats {
+	uint64_t live_bytes;     /**< estimated bytes of live textures */
+	uint64_t live_textures;  /**< number of live tracked textures */
+	uint64_t budget_bytes;   /**< current budget (0 = unlimited) */
+	uint64_t demotions;      /**< textures demoted since startup */
+	uint64_t demoted_bytes;  /**< estimated bytes freed by demotion */
+};
+
+/** Sets the texture memory budget in bytes (0 = unlimited) */
+EXPORT void gs_set_texture_budget(uint64_t bytes);
+
+/** Gets texture memory usage, budget, and eviction statistics.  May be
+ * called from any thread. */
+EXPORT void gs_get_texture_memory_stats(struct gs_texture_memory_stats *stats);
+
+/**
+ * Marks a texture as demotable.  When texture memory exceeds the
+ * budget, the least recently used demotable textures have their demote
+ * callback invoked on the graphics thread; the owner is expected to
+ * destroy the texture and re-create it (typically from data it already
+ * holds in system memory) the next time it is needed.  Pass NULL to
+ * clear. */
+EXPORT void gs_texture_set_demotable(gs_texture_t *tex, void (*demote)(void *param), void *param);
+
+/** Runs one budget pass; called once per frame by the video renderer */
+EXPORT void gs_process_texture_budget(void);
+
 EXPORT void gs_cubetexture_destroy(gs_texture_t *cubetex);
 EXPORT uint32_t gs_cubetexture_get_size(const gs_texture_t *cubetex);
 EXPORT enum gs_color_format gs_cubetexture_get_color_format(const gs_texture_t *cubetex);
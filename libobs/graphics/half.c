@@ -0,0 +1,140 @@
+/******************************************************************************
+    Copyright (C) 2023 by Lain Bailey <lain@obsproject.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "half.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define HALF_HAVE_F16C
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define HALF_F16C_TARGET
+#elif defined(__F16C__)
+#define HALF_F16C_TARGET
+#else
+#define HALF_F16C_TARGET __attribute__((target("avx,f16c")))
+#endif
+#elif defined(__aarch64__)
+#define HALF_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef HALF_HAVE_F16C
+static bool half_f16c_supported(void)
+{
+	static int cached = -1;
+
+	if (cached < 0) {
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		cached = (info[2] & (1 << 29)) != 0;
+#else
+		cached = __builtin_cpu_supports("f16c") ? 1 : 0;
+#endif
+	}
+
+	return cached == 1;
+}
+
+static HALF_F16C_TARGET void half_from_float_plane_f16c(struct half *dst, const float *src, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m256 v = _mm256_loadu_ps(src + i);
+		__m128i h = _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm_storeu_si128((__m128i *)&dst[i], h);
+	}
+
+	for (; i < count; ++i)
+		dst[i] = half_from_float(src[i]);
+}
+
+static HALF_F16C_TARGET void float_from_half_plane_f16c(float *dst, const struct half *src, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i h = _mm_loadu_si128((const __m128i *)&src[i]);
+		_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+	}
+
+	for (; i < count; ++i)
+		dst[i] = half_to_float(src[i]);
+}
+#endif
+
+#ifdef HALF_HAVE_NEON
+static void half_from_float_plane_neon(struct half *dst, const float *src, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		float16x4_t h = vcvt_f16_f32(vld1q_f32(src + i));
+		vst1_u16((uint16_t *)&dst[i], vreinterpret_u16_f16(h));
+	}
+
+	for (; i < count; ++i)
+		dst[i] = half_from_float(src[i]);
+}
+
+static void float_from_half_plane_neon(float *dst, const struct half *src, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		float16x4_t h = vreinterpret_f16_u16(vld1_u16((const uint16_t *)&src[i]));
+		vst1q_f32(dst + i, vcvt_f32_f16(h));
+	}
+
+	for (; i < count; ++i)
+		dst[i] = half_to_float(src[i]);
+}
+#endif
+
+void gs_half_from_float_plane(struct half *dst, const float *src, size_t count)
+{
+#if defined(HALF_HAVE_F16C)
+	if (half_f16c_supported()) {
+		half_from_float_plane_f16c(dst, src, count);
+		return;
+	}
+#elif defined(HALF_HAVE_NEON)
+	half_from_float_plane_neon(dst, src, count);
+	return;
+#endif
+
+	for (size_t i = 0; i < count; ++i)
+		dst[i] = half_from_float(src[i]);
+}
+
+void gs_float_from_half_plane(float *dst, const struct half *src, size_t count)
+{
+#if defined(HALF_HAVE_F16C)
+	if (half_f16c_supported()) {
+		float_from_half_plane_f16c(dst, src, count);
+		return;
+	}
+#elif defined(HALF_HAVE_NEON)
+	float_from_half_plane_neon(dst, src, count);
+	return;
+#endif
+
+	for (size_t i = 0; i < count; ++i)
+		dst[i] = half_to_float(src[i]);
+}
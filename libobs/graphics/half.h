@@ -42,6 +42,8 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "math-defs.h"
 
+#include <string.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -95,6 +97,47 @@ static inline struct half half_from_bits(uint16_t u)
 	return h;
 }
 
+/* adapted from DirectXMath XMConvertHalfToFloat */
+static inline float half_to_float(struct half h)
+{
+	uint32_t Mantissa = (uint32_t)(h.u & 0x03FF);
+	uint32_t Exponent = (h.u & 0x7C00);
+
+	if (Exponent == 0x7C00) { // INF/NAN
+		Exponent = 0x8f;
+	} else if (Exponent != 0) { // The value is normalized
+		Exponent = (uint32_t)((h.u >> 10) & 0x1F);
+	} else if (Mantissa != 0) { // The value is denormalized
+		// Normalize the value in the resulting float
+		Exponent = 1;
+
+		do {
+			Exponent--;
+			Mantissa <<= 1;
+		} while ((Mantissa & 0x0400) == 0);
+
+		Mantissa &= 0x03FF;
+	} else { // The value is zero
+		Exponent = (uint32_t)-112;
+	}
+
+	uint32_t Result = ((uint32_t)(h.u & 0x8000) << 16) | // Sign
+			  ((Exponent + 112) << 23) |         // Exponent
+			  (Mantissa << 13);                  // Mantissa
+
+	float f;
+	memcpy(&f, &Result, sizeof(f));
+	return f;
+}
+
+/**
+ * Batch half<->float plane converters.  These dispatch to F16C on capable
+ * x86 hosts and native NEON conversions on arm64, falling back to the
+ * scalar helpers above elsewhere.
+ */
+EXPORT void gs_half_from_float_plane(struct half *dst, const float *src, size_t count);
+EXPORT void gs_float_from_half_plane(float *dst, const struct half *src, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,13 +16,169 @@
 ******************************************************************************/
 
 #include "image-file.h"
+#include "texture-compress.h"
 #include "../util/base.h"
 #include "../util/platform.h"
 #include "../util/dstr.h"
+#include "../util/threading.h"
 #include "vec4.h"
 
+#include <sys/stat.h>
+
 #define blog(level, format, ...) blog(level, "%s: " format, __FUNCTION__, __VA_ARGS__)
 
+/* Byte budget shared by all animated images for pre-uploaded frame
+ * textures; animations that do not fit within the remaining budget fall
+ * back to uploading frames on demand through a single dynamic texture,
+ * so many animated overlays cannot exhaust VRAM. */
+#define FRAME_PREUPLOAD_BUDGET (256 * 1024 * 1024)
+
+static pthread_mutex_t preupload_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t preupload_bytes = 0;
+
+static bool claim_preupload_budget(uint64_t size)
+{
+	bool claimed = false;
+
+	pthread_mutex_lock(&preupload_mutex);
+	if (preupload_bytes + size <= FRAME_PREUPLOAD_BUDGET) {
+		preupload_bytes += size;
+		claimed = true;
+	}
+	pthread_mutex_unlock(&preupload_mutex);
+
+	return claimed;
+}
+
+static void release_preupload_budget(uint64_t size)
+{
+	pthread_mutex_lock(&preupload_mutex);
+	preupload_bytes -= size;
+	pthread_mutex_unlock(&preupload_mutex);
+}
+
+/* Optional BC transcoding for static images: quarters VRAM and composite
+ * bandwidth for opaque art (DXT1), halves it for art with alpha (DXT5).
+ * The transcode result is cached next to the source image and keyed on
+ * the source's modification time. */
+static bool image_bc_enabled = false;
+
+void gs_image_file_enable_bc_compression(bool enable)
+{
+	image_bc_enabled = enable;
+}
+
+#define BC_CACHE_SUFFIX ".obsbc"
+#define BC_CACHE_MAGIC 0x31636274 /* "tbc1" */
+#define BC_CACHE_VERSION 1
+
+struct bc_cache_header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t format;
+	uint32_t cx;
+	uint32_t cy;
+	uint32_t alpha_mode;
+	uint64_t mtime;
+	uint32_t size;
+};
+
+static bool load_bc_cache(const char *cache_path, uint64_t mtime, enum gs_image_alpha_mode alpha_mode,
+			  gs_image_file_t *image)
+{
+	struct bc_cache_header hdr;
+	uint8_t *data = NULL;
+	bool success = false;
+	FILE *f;
+
+	f = os_fopen(cache_path, "rb");
+	if (!f)
+		return false;
+
+	if (fread(&hdr, sizeof(hdr), 1, f) != 1)
+		goto done;
+	if (hdr.magic != BC_CACHE_MAGIC || hdr.version != BC_CACHE_VERSION || hdr.mtime != mtime ||
+	    hdr.cx != image->cx || hdr.cy != image->cy || hdr.alpha_mode != (uint32_t)alpha_mode)
+		goto done;
+	if (hdr.format != GS_DXT1 && hdr.format != GS_DXT5)
+		goto done;
+	if (hdr.size != image->cx * image->cy * gs_get_format_bpp((enum gs_color_format)hdr.format) / 8)
+		goto done;
+
+	data = bmalloc(hdr.size);
+	if (fread(data, 1, hdr.size, f) != hdr.size)
+		goto done;
+
+	bfree(image->texture_data);
+	image->texture_data = data;
+	image->format = (enum gs_color_format)hdr.format;
+	data = NULL;
+	success = true;
+
+done:
+	bfree(data);
+	fclose(f);
+	return success;
+}
+
+static void save_bc_cache(const char *cache_path, uint64_t mtime, enum gs_image_alpha_mode alpha_mode,
+			  const gs_image_file_t *image, uint32_t size)
+{
+	struct bc_cache_header hdr = {
+		.magic = BC_CACHE_MAGIC,
+		.version = BC_CACHE_VERSION,
+		.format = (uint32_t)image->format,
+		.cx = image->cx,
+		.cy = image->cy,
+		.alpha_mode = (uint32_t)alpha_mode,
+		.mtime = mtime,
+		.size = size,
+	};
+	FILE *f;
+
+	f = os_fopen(cache_path, "wb");
+	if (!f) {
+		blog(LOG_WARNING, "Failed to write '%s'", cache_path);
+		return;
+	}
+
+	if (fwrite(&hdr, sizeof(hdr), 1, f) != 1 || fwrite(image->texture_data, 1, size, f) != size)
+		blog(LOG_WARNING, "Failed to write '%s'", cache_path);
+
+	fclose(f);
+}
+
+static void compress_static_image(gs_image_file_t *image, const char *file, enum gs_image_alpha_mode alpha_mode)
+{
+	struct dstr cache_path = {0};
+	enum gs_color_format format;
+	uint8_t *data;
+	uint32_t size;
+	struct stat st;
+
+	if (os_stat(file, &st) != 0)
+		return;
+
+	const uint64_t mtime = (uint64_t)st.st_mtime;
+
+	dstr_printf(&cache_path, "%s" BC_CACHE_SUFFIX, file);
+
+	if (load_bc_cache(cache_path.array, mtime, alpha_mode, image)) {
+		dstr_free(&cache_path);
+		return;
+	}
+
+	if (gs_compress_bc_image(image->texture_data, image->cx, image->cy, image->format, &format, &data, &size)) {
+		bfree(image->texture_data);
+		image->texture_data = data;
+		image->format = format;
+
+		save_bc_cache(cache_path.array, mtime, alpha_mode, image, size);
+	}
+
+	dstr_free(&cache_path);
+}
+
 static void *bi_def_bitmap_create(int width, int height)
 {
 	return bmalloc((size_t)4 * width * height);
@@ -202,6 +358,9 @@ static void gs_image_file_init_internal(gs_image_file_t *image, const char *file
 	image->texture_data =
 		gs_create_texture_file_data3(file, alpha_mode, &image->format, &image->cx, &image->cy, space);
 
+	if (image->texture_data && image_bc_enabled)
+		compress_static_image(image, file, alpha_mode);
+
 	if (mem_usage) {
 		*mem_usage += image->cx * image->cy * gs_get_format_bpp(image->format) / 8;
 	}
@@ -226,6 +385,17 @@ void gs_image_file_free(gs_image_file_t *image)
 
 	if (image->loaded) {
 		if (image->is_animated_gif) {
+			if (image->frame_textures) {
+				for (unsigned int i = 0; i < image->gif.frame_count; i++)
+					gs_texture_destroy(image->frame_textures[i]);
+				bfree(image->frame_textures);
+				release_preupload_budget(get_full_decoded_gif_size(image));
+
+				/* `texture` aliases one of the frame
+				 * textures destroyed above */
+				image->texture = NULL;
+			}
+
 			gif_finalise(&image->gif);
 			bfree(image->animation_frame_cache);
 			bfree(image->animation_frame_data);
@@ -259,20 +429,58 @@ void gs_image_file4_init(gs_image_file4_t *if4, const char *file, enum gs_image_
 	if4->image3.alpha_mode = alpha_mode;
 }
 
+/* budget demotion: drop the GPU copy of an idle static image; the
+ * retained decoded data re-uploads on the next render */
+static void image_file_demote(void *param)
+{
+	gs_image_file_t *image = param;
+
+	gs_texture_destroy(image->texture);
+	image->texture = NULL;
+}
+
 void gs_image_file_init_texture(gs_image_file_t *image)
 {
 	if (!image->loaded)
 		return;
 
 	if (image->is_animated_gif) {
-		image->texture = gs_texture_create(image->cx, image->cy, image->format, 1,
-						   (const uint8_t **)&image->gif.frame_image, GS_DYNAMIC);
+		if (claim_preupload_budget(get_full_decoded_gif_size(image))) {
+			image->frame_textures = bzalloc(sizeof(gs_texture_t *) * image->gif.frame_count);
+			image->frame_textures[0] = gs_texture_create(image->cx, image->cy, image->format, 1,
+								     (const uint8_t **)&image->gif.frame_image, 0);
+			image->texture = image->frame_textures[0];
+			image->frames_preuploaded = true;
+		} else {
+			image->texture = gs_texture_create(image->cx, image->cy, image->format, 1,
+							   (const uint8_t **)&image->gif.frame_image, GS_DYNAMIC);
+		}
 
 	} else {
-		image->texture = gs_texture_create(image->cx, image->cy, image->format, 1,
-						   (const uint8_t **)&image->texture_data, 0);
-		bfree(image->texture_data);
-		image->texture_data = NULL;
+		/* Let the GPU build a mipmap chain for large static images
+		 * so they stay sharp when scaled down on the canvas; the
+		 * graphics core only supports mipmaps on power-of-two
+		 * textures, so fall back to a single level otherwise. */
+		const bool mipmaps = !gs_is_compressed_format(image->format) &&
+				     (image->cx >= 1024 || image->cy >= 1024) && (image->cx & (image->cx - 1)) == 0 &&
+				     (image->cy & (image->cy - 1)) == 0;
+
+		image->texture = gs_texture_create(image->cx, image->cy, image->format, mipmaps ? 0 : 1,
+						   (const uint8_t **)&image->texture_data,
+						   mipmaps ? GS_BUILD_MIPMAPS : 0);
+
+		/* when a texture budget is active, keep the decoded copy in
+		 * system memory so the texture can be demoted while idle
+		 * and re-uploaded on its next use */
+		struct gs_texture_memory_stats tstats;
+		gs_get_texture_memory_stats(&tstats);
+
+		if (tstats.budget_bytes && image->texture) {
+			gs_texture_set_demotable(image->texture, image_file_demote, image);
+		} else {
+			bfree(image->texture_data);
+			image->texture_data = NULL;
+		}
 	}
 }
 
@@ -395,6 +603,18 @@ static void gs_image_file_update_texture_internal(gs_image_file_t *image, enum g
 	if (!image->animation_frame_cache[image->cur_frame])
 		decode_new_frame(image, image->cur_frame, alpha_mode);
 
+	if (image->frames_preuploaded) {
+		gs_texture_t **frame_tex = &image->frame_textures[image->cur_frame];
+
+		if (!*frame_tex && image->animation_frame_cache[image->cur_frame])
+			*frame_tex = gs_texture_create(image->cx, image->cy, image->format, 1,
+						       (const uint8_t **)&image->animation_frame_cache[image->cur_frame],
+						       0);
+		if (*frame_tex)
+			image->texture = *frame_tex;
+		return;
+	}
+
 	gs_texture_set_image(image->texture, image->animation_frame_cache[image->cur_frame], image->gif.width * 4,
 			     false);
 }
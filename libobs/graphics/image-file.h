@@ -44,6 +44,12 @@ struct gs_image_file {
 
 	uint8_t *texture_data;
 	gif_bitmap_callback_vt bitmap_callbacks;
+
+	/* Pre-uploaded animation frame textures; each frame is uploaded on
+	 * its first display and later loops only swap which texture gets
+	 * drawn.  When active, `texture` aliases an entry of this array. */
+	gs_texture_t **frame_textures;
+	bool frames_preuploaded;
 };
 
 struct gs_image_file2 {
@@ -66,6 +72,11 @@ typedef struct gs_image_file2 gs_image_file2_t;
 typedef struct gs_image_file3 gs_image_file3_t;
 typedef struct gs_image_file4 gs_image_file4_t;
 
+/* Enables BC (DXT1/DXT5) transcoding of static images at load time; the
+ * result is cached next to the source image.  Process-wide, and only
+ * affects images loaded after the call. */
+EXPORT void gs_image_file_enable_bc_compression(bool enable);
+
 EXPORT void gs_image_file_init(gs_image_file_t *image, const char *file);
 EXPORT void gs_image_file_free(gs_image_file_t *image);
 
@@ -59,52 +59,35 @@ void matrix4_from_axisang(struct matrix4 *dst, const struct axisang *aa)
 
 void matrix4_mul(struct matrix4 *dst, const struct matrix4 *m1, const struct matrix4 *m2)
 {
-	struct matrix4 transposed;
 	struct matrix4 out;
 
-	matrix4_transpose(&transposed, m2);
-
-	out.x.x = vec4_dot(&m1->x, &transposed.x);
-	out.x.y = vec4_dot(&m1->x, &transposed.y);
-	out.x.z = vec4_dot(&m1->x, &transposed.z);
-	out.x.w = vec4_dot(&m1->x, &transposed.t);
-	out.y.x = vec4_dot(&m1->y, &transposed.x);
-	out.y.y = vec4_dot(&m1->y, &transposed.y);
-	out.y.z = vec4_dot(&m1->y, &transposed.z);
-	out.y.w = vec4_dot(&m1->y, &transposed.t);
-	out.z.x = vec4_dot(&m1->z, &transposed.x);
-	out.z.y = vec4_dot(&m1->z, &transposed.y);
-	out.z.z = vec4_dot(&m1->z, &transposed.z);
-	out.z.w = vec4_dot(&m1->z, &transposed.t);
-	out.t.x = vec4_dot(&m1->t, &transposed.x);
-	out.t.y = vec4_dot(&m1->t, &transposed.y);
-	out.t.z = vec4_dot(&m1->t, &transposed.z);
-	out.t.w = vec4_dot(&m1->t, &transposed.t);
+	matrix4_vec4_mul(&out.x, &m1->x, m2);
+	matrix4_vec4_mul(&out.y, &m1->y, m2);
+	matrix4_vec4_mul(&out.z, &m1->z, m2);
+	matrix4_vec4_mul(&out.t, &m1->t, m2);
 
 	matrix4_copy(dst, &out);
 }
 
+void matrix4_mul_batch(struct matrix4 *dst, const struct matrix4 *m1, const struct matrix4 *m2, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		matrix4_vec4_mul(&dst[i].x, &m1[i].x, &m2[i]);
+		matrix4_vec4_mul(&dst[i].y, &m1[i].y, &m2[i]);
+		matrix4_vec4_mul(&dst[i].z, &m1[i].z, &m2[i]);
+		matrix4_vec4_mul(&dst[i].t, &m1[i].t, &m2[i]);
+	}
+}
+
 void matrix4_mul_4x3_only(struct matrix4 *dst, const struct matrix4 *m1, const struct matrix4 *m2)
 {
-	struct matrix4 transposed;
 	struct vec4 x;
 	struct vec4 y;
 	struct vec4 z;
 
-	matrix4_transpose(&transposed, m2);
-
-	x.x = vec4_dot(&m1->x, &transposed.x);
-	x.y = vec4_dot(&m1->x, &transposed.y);
-	x.z = vec4_dot(&m1->x, &transposed.z);
-	x.w = vec4_dot(&m1->x, &transposed.t);
-	y.x = vec4_dot(&m1->y, &transposed.x);
-	y.y = vec4_dot(&m1->y, &transposed.y);
-	y.z = vec4_dot(&m1->y, &transposed.z);
-	y.w = vec4_dot(&m1->y, &transposed.t);
-	z.x = vec4_dot(&m1->z, &transposed.x);
-	z.y = vec4_dot(&m1->z, &transposed.y);
-	z.z = vec4_dot(&m1->z, &transposed.z);
-	z.w = vec4_dot(&m1->z, &transposed.t);
+	matrix4_vec4_mul(&x, &m1->x, m2);
+	matrix4_vec4_mul(&y, &m1->y, m2);
+	matrix4_vec4_mul(&z, &m1->z, m2);
 
 	vec4_copy(&dst->x, &x);
 	vec4_copy(&dst->y, &y);
@@ -209,16 +192,11 @@ void matrix4_scale(struct matrix4 *dst, const struct matrix4 *m, const struct ve
 
 void matrix4_translate3v_i(struct matrix4 *dst, const struct vec3 *v, const struct matrix4 *m)
 {
-	struct matrix4 transposed;
 	struct vec4 v4;
 	struct vec4 t;
 
 	vec4_from_vec3(&v4, v);
-	matrix4_transpose(&transposed, m);
-	t.x = vec4_dot(&v4, &transposed.x);
-	t.y = vec4_dot(&v4, &transposed.y);
-	t.z = vec4_dot(&v4, &transposed.z);
-	t.w = vec4_dot(&v4, &transposed.t);
+	matrix4_vec4_mul(&t, &v4, m);
 	vec4_copy(&dst->x, &m->x);
 	vec4_copy(&dst->y, &m->y);
 	vec4_copy(&dst->z, &m->z);
@@ -227,14 +205,9 @@ void matrix4_translate3v_i(struct matrix4 *dst, const struct vec3 *v, const stru
 
 void matrix4_translate4v_i(struct matrix4 *dst, const struct vec4 *v, const struct matrix4 *m)
 {
-	struct matrix4 transposed;
 	struct vec4 t;
 
-	matrix4_transpose(&transposed, m);
-	t.x = vec4_dot(v, &transposed.x);
-	t.y = vec4_dot(v, &transposed.y);
-	t.z = vec4_dot(v, &transposed.z);
-	t.w = vec4_dot(v, &transposed.t);
+	matrix4_vec4_mul(&t, v, m);
 	vec4_copy(&dst->x, &m->x);
 	vec4_copy(&dst->y, &m->y);
 	vec4_copy(&dst->z, &m->z);
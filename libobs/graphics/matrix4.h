@@ -53,12 +53,35 @@ static inline void matrix4_identity(struct matrix4 *dst)
 	dst->t.w = 1.0f;
 }
 
+/*
+ * dst = v * m (row vector times matrix), computed as a linear combination
+ * of the rows of m.  Unlike the dot-product formulation this needs no
+ * transpose or horizontal adds, so it vectorizes on SSE and (through the
+ * simde mapping in util/sse-intrin.h) NEON alike.
+ */
+static inline void matrix4_vec4_mul(struct vec4 *dst, const struct vec4 *v, const struct matrix4 *m)
+{
+	__m128 out = _mm_mul_ps(_mm_shuffle_ps(v->m, v->m, _MM_SHUFFLE(0, 0, 0, 0)), m->x.m);
+	out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(v->m, v->m, _MM_SHUFFLE(1, 1, 1, 1)), m->y.m));
+	out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(v->m, v->m, _MM_SHUFFLE(2, 2, 2, 2)), m->z.m));
+	out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(v->m, v->m, _MM_SHUFFLE(3, 3, 3, 3)), m->t.m));
+	dst->m = out;
+}
+
 EXPORT void matrix4_from_matrix3(struct matrix4 *dst, const struct matrix3 *m);
 EXPORT void matrix4_from_quat(struct matrix4 *dst, const struct quat *q);
 EXPORT void matrix4_from_axisang(struct matrix4 *dst, const struct axisang *aa);
 
 EXPORT void matrix4_mul(struct matrix4 *dst, const struct matrix4 *m1, const struct matrix4 *m2);
 
+/*
+ * Multiplies count matrix pairs: dst[i] = m1[i] * m2[i].  Keeps the
+ * whole working set in registers across iterations, which is faster than
+ * calling matrix4_mul in a loop when recomputing many transforms at once
+ * (e.g. scene item transforms).  dst must not overlap m1 or m2.
+ */
+EXPORT void matrix4_mul_batch(struct matrix4 *dst, const struct matrix4 *m1, const struct matrix4 *m2, size_t count);
+
 EXPORT float matrix4_determinant(const struct matrix4 *m);
 
 EXPORT void matrix4_translate3v(struct matrix4 *dst, const struct matrix4 *m, const struct vec3 *v);
@@ -0,0 +1,374 @@
+/******************************************************************************
+    Copyright (C) 2023 by Lain Bailey <lain@obsproject.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "srgb.h"
+
+/* immintrin must precede sse-intrin.h: with simde's native aliases in
+ * effect, including it afterwards mangles the declarations */
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define SRGB_HAVE_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SRGB_AVX2_TARGET
+#elif defined(__AVX2__)
+#define SRGB_AVX2_TARGET
+#else
+#define SRGB_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+#include "../util/sse-intrin.h"
+
+/* The pow() in the sRGB transfer functions is evaluated as
+ * exp(y * log(x)) using cephes-style polynomial approximations (the same
+ * ones used by the well-known sse_mathfun kernels).  The result stays
+ * within ~2 ulps of powf(), which is far below the quantization error of
+ * the 8/10/16-bit texel data these conversions feed. */
+
+#define SRGB_LOG_SQRTHF 0.707106781186547524f
+#define SRGB_LOG_P0 7.0376836292e-2f
+#define SRGB_LOG_P1 -1.1514610310e-1f
+#define SRGB_LOG_P2 1.1676998740e-1f
+#define SRGB_LOG_P3 -1.2420140846e-1f
+#define SRGB_LOG_P4 1.4249322787e-1f
+#define SRGB_LOG_P5 -1.6668057665e-1f
+#define SRGB_LOG_P6 2.0000714765e-1f
+#define SRGB_LOG_P7 -2.4999993993e-1f
+#define SRGB_LOG_P8 3.3333331174e-1f
+#define SRGB_LOG_Q1 -2.12194440e-4f
+#define SRGB_LOG_Q2 0.693359375f
+
+#define SRGB_EXP_HI 88.3762626647949f
+#define SRGB_EXP_LO -88.3762626647949f
+#define SRGB_LOG2EF 1.44269504088896341f
+#define SRGB_EXP_C1 0.693359375f
+#define SRGB_EXP_C2 -2.12194440e-4f
+#define SRGB_EXP_P0 1.9875691500e-4f
+#define SRGB_EXP_P1 1.3981999507e-3f
+#define SRGB_EXP_P2 8.3334519073e-3f
+#define SRGB_EXP_P3 4.1665795894e-2f
+#define SRGB_EXP_P4 1.6666665459e-1f
+#define SRGB_EXP_P5 5.0000001201e-1f
+
+static inline __m128 srgb_log_ps(__m128 x)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	__m128i xi = _mm_castps_si128(x);
+	__m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(xi, 23), _mm_set1_epi32(126)));
+
+	/* keep the mantissa, set the exponent so x lands in [0.5, 1) */
+	x = _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF)));
+	x = _mm_or_ps(x, _mm_set1_ps(0.5f));
+
+	/* shift to [sqrt(1/2), sqrt(2)) */
+	__m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(SRGB_LOG_SQRTHF));
+	e = _mm_sub_ps(e, _mm_and_ps(mask, one));
+	x = _mm_add_ps(x, _mm_and_ps(mask, x));
+	x = _mm_sub_ps(x, one);
+
+	__m128 z = _mm_mul_ps(x, x);
+
+	__m128 y = _mm_set1_ps(SRGB_LOG_P0);
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_LOG_P1));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_LOG_P2));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_LOG_P3));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_LOG_P4));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_LOG_P5));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_LOG_P6));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_LOG_P7));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_LOG_P8));
+	y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+	y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(SRGB_LOG_Q1)));
+	y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+
+	x = _mm_add_ps(x, y);
+	x = _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(SRGB_LOG_Q2)));
+	return x;
+}
+
+static inline __m128 srgb_exp_ps(__m128 x)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	x = _mm_min_ps(x, _mm_set1_ps(SRGB_EXP_HI));
+	x = _mm_max_ps(x, _mm_set1_ps(SRGB_EXP_LO));
+
+	__m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(SRGB_LOG2EF)), _mm_set1_ps(0.5f));
+
+	/* floor(fx) without SSE4.1 */
+	__m128 tmp = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+	__m128 mask = _mm_and_ps(_mm_cmpgt_ps(tmp, fx), one);
+	fx = _mm_sub_ps(tmp, mask);
+
+	x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(SRGB_EXP_C1)));
+	x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(SRGB_EXP_C2)));
+
+	__m128 z = _mm_mul_ps(x, x);
+
+	__m128 y = _mm_set1_ps(SRGB_EXP_P0);
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_EXP_P1));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_EXP_P2));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_EXP_P3));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_EXP_P4));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(SRGB_EXP_P5));
+	y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), one);
+
+	__m128i emm0 = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7f)), 23);
+	return _mm_mul_ps(y, _mm_castsi128_ps(emm0));
+}
+
+static inline __m128 srgb_pow_ps(__m128 x, __m128 y)
+{
+	/* x must be positive; callers clamp before the log */
+	return srgb_exp_ps(_mm_mul_ps(y, srgb_log_ps(x)));
+}
+
+static inline __m128 srgb_nonlinear_to_linear_ps(__m128 u)
+{
+	__m128 lin = _mm_div_ps(u, _mm_set1_ps(12.92f));
+	__m128 base = _mm_div_ps(_mm_add_ps(u, _mm_set1_ps(0.055f)), _mm_set1_ps(1.055f));
+	base = _mm_max_ps(base, _mm_set1_ps(1e-10f));
+	__m128 p = srgb_pow_ps(base, _mm_set1_ps(2.4f));
+	__m128 mask = _mm_cmple_ps(u, _mm_set1_ps(0.04045f));
+	return _mm_or_ps(_mm_and_ps(mask, lin), _mm_andnot_ps(mask, p));
+}
+
+static inline __m128 srgb_linear_to_nonlinear_ps(__m128 u)
+{
+	__m128 lin = _mm_mul_ps(u, _mm_set1_ps(12.92f));
+	__m128 base = _mm_max_ps(u, _mm_set1_ps(1e-10f));
+	__m128 p = srgb_pow_ps(base, _mm_set1_ps(1.0f / 2.4f));
+	p = _mm_sub_ps(_mm_mul_ps(p, _mm_set1_ps(1.055f)), _mm_set1_ps(0.055f));
+	__m128 mask = _mm_cmple_ps(u, _mm_set1_ps(0.0031308f));
+	return _mm_or_ps(_mm_and_ps(mask, lin), _mm_andnot_ps(mask, p));
+}
+
+static void srgb_nonlinear_to_linear_flat(float *f, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(f + i, srgb_nonlinear_to_linear_ps(_mm_loadu_ps(f + i)));
+
+	for (; i < count; ++i)
+		f[i] = gs_srgb_nonlinear_to_linear(f[i]);
+}
+
+/* keeps the alpha lane of each texel untouched */
+#define SRGB_ALPHA_MASK_SSE _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0))
+
+static void srgb_nonlinear_to_linear_texels(float *f, size_t count)
+{
+	const __m128 rgb_mask = SRGB_ALPHA_MASK_SSE;
+
+	for (size_t i = 0; i < count; ++i) {
+		__m128 u = _mm_loadu_ps(f + i * 4);
+		__m128 v = srgb_nonlinear_to_linear_ps(u);
+		v = _mm_or_ps(_mm_and_ps(rgb_mask, v), _mm_andnot_ps(rgb_mask, u));
+		_mm_storeu_ps(f + i * 4, v);
+	}
+}
+
+static void srgb_linear_to_nonlinear_texels(float *f, size_t count)
+{
+	const __m128 rgb_mask = SRGB_ALPHA_MASK_SSE;
+
+	for (size_t i = 0; i < count; ++i) {
+		__m128 u = _mm_loadu_ps(f + i * 4);
+		__m128 v = srgb_linear_to_nonlinear_ps(u);
+		v = _mm_or_ps(_mm_and_ps(rgb_mask, v), _mm_andnot_ps(rgb_mask, u));
+		_mm_storeu_ps(f + i * 4, v);
+	}
+}
+
+#ifdef SRGB_HAVE_AVX2
+static bool srgb_avx2_supported(void)
+{
+	static int cached = -1;
+
+	if (cached < 0) {
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuidex(info, 7, 0);
+		cached = (info[1] & (1 << 5)) != 0;
+#else
+		cached = __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+	}
+
+	return cached == 1;
+}
+
+static SRGB_AVX2_TARGET __m256 srgb_log_ps256(__m256 x)
+{
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	__m256i xi = _mm256_castps_si256(x);
+	__m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(xi, 23), _mm256_set1_epi32(126)));
+
+	x = _mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF)));
+	x = _mm256_or_ps(x, _mm256_set1_ps(0.5f));
+
+	__m256 mask = _mm256_cmp_ps(x, _mm256_set1_ps(SRGB_LOG_SQRTHF), _CMP_LT_OQ);
+	e = _mm256_sub_ps(e, _mm256_and_ps(mask, one));
+	x = _mm256_add_ps(x, _mm256_and_ps(mask, x));
+	x = _mm256_sub_ps(x, one);
+
+	__m256 z = _mm256_mul_ps(x, x);
+
+	__m256 y = _mm256_set1_ps(SRGB_LOG_P0);
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_LOG_P1));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_LOG_P2));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_LOG_P3));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_LOG_P4));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_LOG_P5));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_LOG_P6));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_LOG_P7));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_LOG_P8));
+	y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+
+	y = _mm256_add_ps(y, _mm256_mul_ps(e, _mm256_set1_ps(SRGB_LOG_Q1)));
+	y = _mm256_sub_ps(y, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+
+	x = _mm256_add_ps(x, y);
+	x = _mm256_add_ps(x, _mm256_mul_ps(e, _mm256_set1_ps(SRGB_LOG_Q2)));
+	return x;
+}
+
+static SRGB_AVX2_TARGET __m256 srgb_exp_ps256(__m256 x)
+{
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	x = _mm256_min_ps(x, _mm256_set1_ps(SRGB_EXP_HI));
+	x = _mm256_max_ps(x, _mm256_set1_ps(SRGB_EXP_LO));
+
+	__m256 fx = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(SRGB_LOG2EF)), _mm256_set1_ps(0.5f)));
+
+	x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(SRGB_EXP_C1)));
+	x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(SRGB_EXP_C2)));
+
+	__m256 z = _mm256_mul_ps(x, x);
+
+	__m256 y = _mm256_set1_ps(SRGB_EXP_P0);
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_EXP_P1));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_EXP_P2));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_EXP_P3));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_EXP_P4));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(SRGB_EXP_P5));
+	y = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(y, z), x), one);
+
+	__m256i emm0 = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(0x7f)), 23);
+	return _mm256_mul_ps(y, _mm256_castsi256_ps(emm0));
+}
+
+static SRGB_AVX2_TARGET __m256 srgb_nonlinear_to_linear_ps256(__m256 u)
+{
+	__m256 lin = _mm256_div_ps(u, _mm256_set1_ps(12.92f));
+	__m256 base = _mm256_div_ps(_mm256_add_ps(u, _mm256_set1_ps(0.055f)), _mm256_set1_ps(1.055f));
+	base = _mm256_max_ps(base, _mm256_set1_ps(1e-10f));
+	__m256 p = srgb_exp_ps256(_mm256_mul_ps(_mm256_set1_ps(2.4f), srgb_log_ps256(base)));
+	__m256 mask = _mm256_cmp_ps(u, _mm256_set1_ps(0.04045f), _CMP_LE_OQ);
+	return _mm256_blendv_ps(p, lin, mask);
+}
+
+static SRGB_AVX2_TARGET __m256 srgb_linear_to_nonlinear_ps256(__m256 u)
+{
+	__m256 lin = _mm256_mul_ps(u, _mm256_set1_ps(12.92f));
+	__m256 base = _mm256_max_ps(u, _mm256_set1_ps(1e-10f));
+	__m256 p = srgb_exp_ps256(_mm256_mul_ps(_mm256_set1_ps(1.0f / 2.4f), srgb_log_ps256(base)));
+	p = _mm256_sub_ps(_mm256_mul_ps(p, _mm256_set1_ps(1.055f)), _mm256_set1_ps(0.055f));
+	__m256 mask = _mm256_cmp_ps(u, _mm256_set1_ps(0.0031308f), _CMP_LE_OQ);
+	return _mm256_blendv_ps(p, lin, mask);
+}
+
+static SRGB_AVX2_TARGET void srgb_nonlinear_to_linear_flat_avx2(float *f, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+		_mm256_storeu_ps(f + i, srgb_nonlinear_to_linear_ps256(_mm256_loadu_ps(f + i)));
+
+	for (; i < count; ++i)
+		f[i] = gs_srgb_nonlinear_to_linear(f[i]);
+}
+
+static SRGB_AVX2_TARGET void srgb_nonlinear_to_linear_texels_avx2(float *f, size_t count)
+{
+	const __m256 rgb_mask = _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0));
+	size_t i = 0;
+
+	for (; i + 2 <= count; i += 2) {
+		__m256 u = _mm256_loadu_ps(f + i * 4);
+		__m256 v = srgb_nonlinear_to_linear_ps256(u);
+		_mm256_storeu_ps(f + i * 4, _mm256_blendv_ps(u, v, rgb_mask));
+	}
+
+	if (i < count)
+		srgb_nonlinear_to_linear_texels(f + i * 4, count - i);
+}
+
+static SRGB_AVX2_TARGET void srgb_linear_to_nonlinear_texels_avx2(float *f, size_t count)
+{
+	const __m256 rgb_mask = _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0));
+	size_t i = 0;
+
+	for (; i + 2 <= count; i += 2) {
+		__m256 u = _mm256_loadu_ps(f + i * 4);
+		__m256 v = srgb_linear_to_nonlinear_ps256(u);
+		_mm256_storeu_ps(f + i * 4, _mm256_blendv_ps(u, v, rgb_mask));
+	}
+
+	if (i < count)
+		srgb_linear_to_nonlinear_texels(f + i * 4, count - i);
+}
+#endif
+
+void gs_float3_srgb_nonlinear_to_linear_batch(float *f, size_t count)
+{
+#ifdef SRGB_HAVE_AVX2
+	if (srgb_avx2_supported()) {
+		srgb_nonlinear_to_linear_flat_avx2(f, count * 3);
+		return;
+	}
+#endif
+	srgb_nonlinear_to_linear_flat(f, count * 3);
+}
+
+void gs_float4_srgb_nonlinear_to_linear_batch(float *f, size_t count)
+{
+#ifdef SRGB_HAVE_AVX2
+	if (srgb_avx2_supported()) {
+		srgb_nonlinear_to_linear_texels_avx2(f, count);
+		return;
+	}
+#endif
+	srgb_nonlinear_to_linear_texels(f, count);
+}
+
+void gs_float4_srgb_linear_to_nonlinear_batch(float *f, size_t count)
+{
+#ifdef SRGB_HAVE_AVX2
+	if (srgb_avx2_supported()) {
+		srgb_linear_to_nonlinear_texels_avx2(f, count);
+		return;
+	}
+#endif
+	srgb_linear_to_nonlinear_texels(f, count);
+}
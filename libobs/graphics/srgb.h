@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "../util/c99defs.h"
+
 #include <math.h>
 #include <string.h>
 
@@ -88,6 +90,18 @@ static inline void gs_float3_srgb_linear_to_nonlinear(float *f)
 	f[2] = gs_srgb_linear_to_nonlinear(f[2]);
 }
 
+/**
+ * Batch sRGB transfer conversions.  These dispatch to AVX2 on capable x86
+ * hosts and otherwise use 128-bit kernels (NEON on arm via simde), staying
+ * within ~2 ulps of the scalar helpers above.
+ *
+ * The float3 variant converts a packed array of `count` RGB triplets; the
+ * float4 variants convert `count` RGBA texels, leaving alpha untouched.
+ */
+EXPORT void gs_float3_srgb_nonlinear_to_linear_batch(float *f, size_t count);
+EXPORT void gs_float4_srgb_nonlinear_to_linear_batch(float *f, size_t count);
+EXPORT void gs_float4_srgb_linear_to_nonlinear_batch(float *f, size_t count);
+
 static inline void gs_premultiply_xyza(uint8_t *data)
 {
 	uint8_t u[4];
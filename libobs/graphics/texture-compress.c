@@ -0,0 +1,242 @@
+/******************************************************************************
+    Copyright (C) 2023 by Lain Bailey <lain@obsproject.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "../util/bmem.h"
+#include "texture-compress.h"
+
+/* Fast range-fit BC1/BC3 encoder: color endpoints come from the RGB
+ * bounding box of each 4x4 block (inset to reduce quantization spread),
+ * texels snap to the nearest of the four interpolated palette entries.
+ * Quality is well below an exhaustive encoder but the output is meant
+ * for static overlays where the source PNG remains the ground truth. */
+
+struct block_pixels {
+	uint8_t rgba[16][4];
+};
+
+static inline uint16_t pack_565(const uint8_t *rgb)
+{
+	return (uint16_t)((rgb[0] >> 3) << 11 | (rgb[1] >> 2) << 5 | (rgb[2] >> 3));
+}
+
+static inline void unpack_565(uint16_t c, uint8_t *rgb)
+{
+	rgb[0] = (uint8_t)(((c >> 11) & 0x1F) * 255 / 31);
+	rgb[1] = (uint8_t)(((c >> 5) & 0x3F) * 255 / 63);
+	rgb[2] = (uint8_t)((c & 0x1F) * 255 / 31);
+}
+
+static void get_block(const uint8_t *data, uint32_t cx, uint32_t bx, uint32_t by, bool bgr, bool opaque,
+		      struct block_pixels *block)
+{
+	for (uint32_t y = 0; y < 4; y++) {
+		const uint8_t *row = data + ((size_t)(by * 4 + y) * cx + bx * 4) * 4;
+
+		for (uint32_t x = 0; x < 4; x++) {
+			uint8_t *px = block->rgba[y * 4 + x];
+
+			px[0] = bgr ? row[2] : row[0];
+			px[1] = row[1];
+			px[2] = bgr ? row[0] : row[2];
+			px[3] = opaque ? 255 : row[3];
+			row += 4;
+		}
+	}
+}
+
+static void encode_color_block(const struct block_pixels *block, uint8_t *out)
+{
+	uint8_t min_rgb[3] = {255, 255, 255};
+	uint8_t max_rgb[3] = {0, 0, 0};
+	uint8_t palette[4][3];
+	uint32_t indices = 0;
+
+	for (size_t i = 0; i < 16; i++) {
+		for (size_t c = 0; c < 3; c++) {
+			const uint8_t v = block->rgba[i][c];
+			if (v < min_rgb[c])
+				min_rgb[c] = v;
+			if (v > max_rgb[c])
+				max_rgb[c] = v;
+		}
+	}
+
+	/* inset the bounding box by 1/16th of its extent */
+	for (size_t c = 0; c < 3; c++) {
+		const uint8_t inset = (uint8_t)((max_rgb[c] - min_rgb[c]) >> 4);
+		min_rgb[c] = (uint8_t)(min_rgb[c] + inset);
+		max_rgb[c] = (uint8_t)(max_rgb[c] - inset);
+	}
+
+	uint16_t c0 = pack_565(max_rgb);
+	uint16_t c1 = pack_565(min_rgb);
+
+	/* keep c0 > c1 so the block decodes in four-color mode */
+	if (c0 < c1) {
+		const uint16_t tmp = c0;
+		c0 = c1;
+		c1 = tmp;
+	} else if (c0 == c1 && c1 > 0) {
+		c1--;
+	}
+
+	unpack_565(c0, palette[0]);
+	unpack_565(c1, palette[1]);
+	for (size_t c = 0; c < 3; c++) {
+		palette[2][c] = (uint8_t)((2 * palette[0][c] + palette[1][c]) / 3);
+		palette[3][c] = (uint8_t)((palette[0][c] + 2 * palette[1][c]) / 3);
+	}
+
+	for (size_t i = 0; i < 16; i++) {
+		uint32_t best_idx = 0;
+		int best_err = INT32_MAX;
+
+		for (uint32_t j = 0; j < 4; j++) {
+			int err = 0;
+			for (size_t c = 0; c < 3; c++) {
+				const int d = (int)block->rgba[i][c] - (int)palette[j][c];
+				err += d * d;
+			}
+			if (err < best_err) {
+				best_err = err;
+				best_idx = j;
+			}
+		}
+
+		indices |= best_idx << (i * 2);
+	}
+
+	out[0] = (uint8_t)(c0 & 0xFF);
+	out[1] = (uint8_t)(c0 >> 8);
+	out[2] = (uint8_t)(c1 & 0xFF);
+	out[3] = (uint8_t)(c1 >> 8);
+	out[4] = (uint8_t)(indices & 0xFF);
+	out[5] = (uint8_t)((indices >> 8) & 0xFF);
+	out[6] = (uint8_t)((indices >> 16) & 0xFF);
+	out[7] = (uint8_t)((indices >> 24) & 0xFF);
+}
+
+static void encode_alpha_block(const struct block_pixels *block, uint8_t *out)
+{
+	uint8_t a0 = 0;
+	uint8_t a1 = 255;
+	uint8_t palette[8];
+	uint64_t indices = 0;
+
+	for (size_t i = 0; i < 16; i++) {
+		const uint8_t a = block->rgba[i][3];
+		if (a > a0)
+			a0 = a;
+		if (a < a1)
+			a1 = a;
+	}
+
+	if (a0 == a1 && a0 < 255)
+		a0++;
+
+	/* a0 > a1 selects the eight-step interpolated palette */
+	palette[0] = a0;
+	palette[1] = a1;
+	for (size_t i = 1; i < 7; i++)
+		palette[1 + i] = (uint8_t)(((7 - i) * a0 + i * a1) / 7);
+
+	for (size_t i = 0; i < 16; i++) {
+		uint64_t best_idx = 0;
+		int best_err = INT32_MAX;
+
+		for (uint64_t j = 0; j < 8; j++) {
+			const int d = (int)block->rgba[i][3] - (int)palette[j];
+			const int err = d * d;
+			if (err < best_err) {
+				best_err = err;
+				best_idx = j;
+			}
+		}
+
+		indices |= best_idx << (i * 3);
+	}
+
+	out[0] = a0;
+	out[1] = a1;
+	for (size_t i = 0; i < 6; i++)
+		out[2 + i] = (uint8_t)((indices >> (i * 8)) & 0xFF);
+}
+
+bool gs_compress_bc_image(const uint8_t *data, uint32_t cx, uint32_t cy, enum gs_color_format src_format,
+			  enum gs_color_format *format_out, uint8_t **data_out, uint32_t *size_out)
+{
+	bool bgr;
+	bool opaque;
+
+	if (!data || !cx || !cy || (cx & 3) != 0 || (cy & 3) != 0)
+		return false;
+
+	switch (src_format) {
+	case GS_RGBA:
+		bgr = false;
+		opaque = false;
+		break;
+	case GS_BGRA:
+		bgr = true;
+		opaque = false;
+		break;
+	case GS_BGRX:
+		bgr = true;
+		opaque = true;
+		break;
+	default:
+		return false;
+	}
+
+	if (!opaque) {
+		opaque = true;
+		for (size_t i = 0; i < (size_t)cx * cy; i++) {
+			if (data[i * 4 + 3] != 255) {
+				opaque = false;
+				break;
+			}
+		}
+	}
+
+	const enum gs_color_format format = opaque ? GS_DXT1 : GS_DXT5;
+	const size_t block_size = opaque ? 8 : 16;
+	const uint32_t blocks_x = cx / 4;
+	const uint32_t blocks_y = cy / 4;
+	uint8_t *out = bmalloc((size_t)blocks_x * blocks_y * block_size);
+	uint8_t *block_out = out;
+
+	for (uint32_t by = 0; by < blocks_y; by++) {
+		for (uint32_t bx = 0; bx < blocks_x; bx++) {
+			struct block_pixels block;
+
+			get_block(data, cx, bx, by, bgr, opaque, &block);
+
+			if (!opaque) {
+				encode_alpha_block(&block, block_out);
+				block_out += 8;
+			}
+
+			encode_color_block(&block, block_out);
+			block_out += 8;
+		}
+	}
+
+	*format_out = format;
+	*data_out = out;
+	*size_out = (uint32_t)((size_t)blocks_x * blocks_y * block_size);
+	return true;
+}
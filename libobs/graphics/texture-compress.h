@@ -0,0 +1,41 @@
+/******************************************************************************
+    Copyright (C) 2023 by Lain Bailey <lain@obsproject.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#pragma once
+
+#include "graphics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Transcodes an 8-bit image to a block-compressed format.
+ *
+ * Picks GS_DXT1 when every pixel is opaque (4 bits per pixel), GS_DXT5
+ * otherwise (8 bits per pixel).  Both dimensions must be multiples of 4
+ * and src_format must be GS_RGBA, GS_BGRA or GS_BGRX; returns false and
+ * outputs nothing when the image cannot be compressed.
+ *
+ * The returned buffer is allocated with bmalloc and owned by the caller.
+ */
+EXPORT bool gs_compress_bc_image(const uint8_t *data, uint32_t cx, uint32_t cy, enum gs_color_format src_format,
+				 enum gs_color_format *format_out, uint8_t **data_out, uint32_t *size_out);
+
+#ifdef __cplusplus
+}
+#endif
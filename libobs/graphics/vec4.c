@@ -28,14 +28,8 @@ void vec4_from_vec3(struct vec4 *dst, const struct vec3 *v)
 void vec4_transform(struct vec4 *dst, const struct vec4 *v, const struct matrix4 *m)
 {
 	struct vec4 temp;
-	struct matrix4 transpose;
 
-	matrix4_transpose(&transpose, m);
-
-	temp.x = vec4_dot(&transpose.x, v);
-	temp.y = vec4_dot(&transpose.y, v);
-	temp.z = vec4_dot(&transpose.z, v);
-	temp.w = vec4_dot(&transpose.t, v);
+	matrix4_vec4_mul(&temp, v, m);
 
 	vec4_copy(dst, &temp);
 }
@@ -56,8 +56,28 @@ static inline void audio_input_free(struct audio_input *input)
 	audio_resampler_destroy(input->resampler);
 }
 
+/* Immutable snapshot of a mix's inputs.  The audio thread loads the
+ * current snapshot once per mix pass and never takes a lock; connect and
+ * disconnect build a new snapshot and atomically swap it in, then wait
+ * for the mix pass that might still reference the old one to finish
+ * before freeing it. */
+struct audio_input_array {
+	size_t num;
+	struct audio_input array[];
+};
+
+/* Snapshots retired from within an input callback (i.e. on the audio
+ * thread itself, where waiting for the pass to finish would deadlock)
+ * are parked here until the pass that was using them has completed. */
+struct retired_input_array {
+	struct audio_input_array *snapshot;
+	audio_resampler_t *resampler;
+	long pass;
+};
+
 struct audio_mix {
-	DARRAY(struct audio_input) inputs;
+	struct audio_input_array *inputs;
+	volatile long input_count;
 	float buffer[MAX_AUDIO_CHANNELS][AUDIO_OUTPUT_FRAMES];
 	float buffer_unclamped[MAX_AUDIO_CHANNELS][AUDIO_OUTPUT_FRAMES];
 };
@@ -75,10 +95,75 @@ struct audio_output {
 
 	audio_input_callback_t input_cb;
 	void *input_param;
+
+	/* serializes connect/disconnect against each other only; the mix
+	 * loop itself runs lock-free against the input snapshots */
 	pthread_mutex_t input_mutex;
+
+	/* odd while the audio thread is inside a mix pass */
+	volatile long mix_pass;
+	DARRAY(struct retired_input_array) retired;
+
 	struct audio_mix mixes[MAX_AUDIO_MIXES];
 };
 
+static inline bool on_audio_thread(const struct audio_output *audio)
+{
+	return audio->initialized && pthread_equal(pthread_self(), audio->thread);
+}
+
+static void wait_for_mix_pass(struct audio_output *audio)
+{
+	long pass = os_atomic_load_long(&audio->mix_pass);
+
+	while ((pass & 1) && os_atomic_load_long(&audio->mix_pass) == pass)
+		os_sleep_ms(1);
+}
+
+/* Called with input_mutex released: waiting out a mix pass while holding
+ * the mutex would deadlock against an input callback trying to
+ * connect/disconnect during that same pass. */
+static void retire_input_array(struct audio_output *audio, struct audio_input_array *snapshot,
+			       audio_resampler_t *resampler)
+{
+	if (!snapshot && !resampler)
+		return;
+
+	if (on_audio_thread(audio)) {
+		struct retired_input_array retired = {
+			.snapshot = snapshot,
+			.resampler = resampler,
+			.pass = os_atomic_load_long(&audio->mix_pass),
+		};
+
+		pthread_mutex_lock(&audio->input_mutex);
+		da_push_back(audio->retired, &retired);
+		pthread_mutex_unlock(&audio->input_mutex);
+		return;
+	}
+
+	wait_for_mix_pass(audio);
+	audio_resampler_destroy(resampler);
+	bfree(snapshot);
+}
+
+/* Called with input_mutex held. */
+static void free_retired_input_arrays(struct audio_output *audio)
+{
+	long pass = os_atomic_load_long(&audio->mix_pass);
+	size_t i = audio->retired.num;
+
+	while (i > 0) {
+		struct retired_input_array *retired = audio->retired.array + --i;
+
+		if (retired->pass != pass) {
+			audio_resampler_destroy(retired->resampler);
+			bfree(retired->snapshot);
+			da_erase(audio->retired, i);
+		}
+	}
+}
+
 /* ------------------------------------------------------------------------- */
 
 static bool resample_audio_output(struct audio_input *input, struct audio_data *data)
@@ -107,12 +192,19 @@ static bool resample_audio_output(struct audio_input *input, struct audio_data *
 static inline void do_audio_output(struct audio_output *audio, size_t mix_idx, uint64_t timestamp, uint32_t frames)
 {
 	struct audio_mix *mix = &audio->mixes[mix_idx];
+	struct audio_input_array *inputs = os_atomic_load_ptr((void *const volatile *)&mix->inputs);
 	struct audio_data data;
 
-	pthread_mutex_lock(&audio->input_mutex);
+	if (!inputs)
+		return;
 
-	for (size_t i = mix->inputs.num; i > 0; i--) {
-		struct audio_input *input = mix->inputs.array + (i - 1);
+	for (size_t i = inputs->num; i > 0; i--) {
+		struct audio_input *input = inputs->array + (i - 1);
+
+		/* cleared when the input disconnects itself from within
+		 * its own callback during this pass */
+		if (!input->callback)
+			continue;
 
 		float(*buf)[AUDIO_OUTPUT_FRAMES] = input->conversion.allow_clipping ? mix->buffer_unclamped
 										    : mix->buffer;
@@ -125,8 +217,6 @@ static inline void do_audio_output(struct audio_output *audio, size_t mix_idx, u
 		if (resample_audio_output(input, &data))
 			input->callback(input->param, mix_idx, &data);
 	}
-
-	pthread_mutex_unlock(&audio->input_mutex);
 }
 
 static inline void clamp_audio_output(struct audio_output *audio, size_t bytes)
@@ -137,7 +227,7 @@ static inline void clamp_audio_output(struct audio_output *audio, size_t bytes)
 		struct audio_mix *mix = &audio->mixes[mix_idx];
 
 		/* do not process mixing if a specific mix is inactive */
-		if (!mix->inputs.num)
+		if (!os_atomic_load_long(&mix->input_count))
 			continue;
 
 		for (size_t plane = 0; plane < audio->planes; plane++) {
@@ -172,12 +262,10 @@ static void input_and_output(struct audio_output *audio, uint64_t audio_time, ui
 #endif
 
 	/* get mixers */
-	pthread_mutex_lock(&audio->input_mutex);
 	for (size_t i = 0; i < MAX_AUDIO_MIXES; i++) {
-		if (audio->mixes[i].inputs.num)
+		if (os_atomic_load_long(&audio->mixes[i].input_count))
 			active_mixes |= (1 << i);
 	}
-	pthread_mutex_unlock(&audio->input_mutex);
 
 	/* clear mix buffers */
 	for (size_t mix_idx = 0; mix_idx < MAX_AUDIO_MIXES; mix_idx++) {
@@ -228,7 +316,9 @@ static void *audio_thread(void *param)
 
 		profile_start(audio_thread_name);
 
+		os_atomic_inc_long(&audio->mix_pass);
 		input_and_output(audio, audio_time, prev_time);
+		os_atomic_inc_long(&audio->mix_pass);
 		prev_time = audio_time;
 
 		profile_end(audio_thread_name);
@@ -246,12 +336,11 @@ static void *audio_thread(void *param)
 
 /* ------------------------------------------------------------------------- */
 
-static size_t audio_get_input_idx(const audio_t *audio, size_t mix_idx, audio_output_callback_t callback, void *param)
+static size_t audio_get_input_idx(const struct audio_input_array *inputs, audio_output_callback_t callback,
+				  void *param)
 {
-	const struct audio_mix *mix = &audio->mixes[mix_idx];
-
-	for (size_t i = 0; i < mix->inputs.num; i++) {
-		struct audio_input *input = mix->inputs.array + i;
+	for (size_t i = 0; inputs && i < inputs->num; i++) {
+		const struct audio_input *input = inputs->array + i;
 
 		if (input->callback == callback && input->param == param)
 			return i;
@@ -289,6 +378,7 @@ static inline bool audio_input_init(struct audio_input *input, struct audio_outp
 bool audio_output_connect(audio_t *audio, size_t mi, const struct audio_convert_info *conversion,
 			  audio_output_callback_t callback, void *param)
 {
+	struct audio_input_array *retired_snapshot = NULL;
 	bool success = false;
 
 	if (!audio || mi >= MAX_AUDIO_MIXES)
@@ -296,8 +386,12 @@ bool audio_output_connect(audio_t *audio, size_t mi, const struct audio_convert_
 
 	pthread_mutex_lock(&audio->input_mutex);
 
-	if (audio_get_input_idx(audio, mi, callback, param) == DARRAY_INVALID) {
-		struct audio_mix *mix = &audio->mixes[mi];
+	free_retired_input_arrays(audio);
+
+	struct audio_mix *mix = &audio->mixes[mi];
+	struct audio_input_array *cur = mix->inputs;
+
+	if (audio_get_input_idx(cur, callback, param) == DARRAY_INVALID) {
 		struct audio_input input = {
 			.callback = callback,
 			.param = param,
@@ -319,30 +413,75 @@ bool audio_output_connect(audio_t *audio, size_t mi, const struct audio_convert_
 			input.conversion.samples_per_sec = audio->info.samples_per_sec;
 
 		success = audio_input_init(&input, audio);
-		if (success)
-			da_push_back(mix->inputs, &input);
+		if (success) {
+			size_t num = cur ? cur->num : 0;
+			struct audio_input_array *snapshot =
+				bzalloc(sizeof(struct audio_input_array) + (num + 1) * sizeof(struct audio_input));
+
+			if (num)
+				memcpy(snapshot->array, cur->array, num * sizeof(struct audio_input));
+			snapshot->array[num] = input;
+			snapshot->num = num + 1;
+
+			os_atomic_store_ptr((void *volatile *)&mix->inputs, snapshot);
+			os_atomic_inc_long(&mix->input_count);
+
+			retired_snapshot = cur;
+		}
 	}
 
 	pthread_mutex_unlock(&audio->input_mutex);
 
+	retire_input_array(audio, retired_snapshot, NULL);
+
 	return success;
 }
 
 void audio_output_disconnect(audio_t *audio, size_t mix_idx, audio_output_callback_t callback, void *param)
 {
+	struct audio_input_array *retired_snapshot = NULL;
+	audio_resampler_t *retired_resampler = NULL;
+
 	if (!audio || mix_idx >= MAX_AUDIO_MIXES)
 		return;
 
 	pthread_mutex_lock(&audio->input_mutex);
 
-	size_t idx = audio_get_input_idx(audio, mix_idx, callback, param);
+	free_retired_input_arrays(audio);
+
+	struct audio_mix *mix = &audio->mixes[mix_idx];
+	struct audio_input_array *cur = mix->inputs;
+
+	size_t idx = audio_get_input_idx(cur, callback, param);
 	if (idx != DARRAY_INVALID) {
-		struct audio_mix *mix = &audio->mixes[mix_idx];
-		audio_input_free(mix->inputs.array + idx);
-		da_erase(mix->inputs, idx);
+		struct audio_input_array *snapshot = NULL;
+
+		if (cur->num > 1) {
+			snapshot = bzalloc(sizeof(struct audio_input_array) +
+					   (cur->num - 1) * sizeof(struct audio_input));
+
+			memcpy(snapshot->array, cur->array, idx * sizeof(struct audio_input));
+			memcpy(snapshot->array + idx, cur->array + idx + 1,
+			       (cur->num - idx - 1) * sizeof(struct audio_input));
+			snapshot->num = cur->num - 1;
+		}
+
+		os_atomic_store_ptr((void *volatile *)&mix->inputs, snapshot);
+		os_atomic_dec_long(&mix->input_count);
+
+		/* if disconnecting from within an input callback, make
+		 * sure the rest of the current mix pass (which still uses
+		 * the old snapshot) no longer delivers to this input */
+		if (on_audio_thread(audio))
+			cur->array[idx].callback = NULL;
+
+		retired_resampler = cur->array[idx].resampler;
+		retired_snapshot = cur;
 	}
 
 	pthread_mutex_unlock(&audio->input_mutex);
+
+	retire_input_array(audio, retired_snapshot, retired_resampler);
 }
 
 static inline bool valid_audio_params(const struct audio_output_info *info)
@@ -404,13 +543,24 @@ void audio_output_close(audio_t *audio)
 	}
 
 	for (size_t mix_idx = 0; mix_idx < MAX_AUDIO_MIXES; mix_idx++) {
-		struct audio_mix *mix = &audio->mixes[mix_idx];
+		struct audio_input_array *inputs = audio->mixes[mix_idx].inputs;
+
+		if (inputs) {
+			for (size_t i = 0; i < inputs->num; i++)
+				audio_input_free(inputs->array + i);
+
+			bfree(inputs);
+		}
+	}
 
-		for (size_t i = 0; i < mix->inputs.num; i++)
-			audio_input_free(mix->inputs.array + i);
+	for (size_t i = 0; i < audio->retired.num; i++) {
+		struct retired_input_array *retired = audio->retired.array + i;
 
-		da_free(mix->inputs);
+		audio_resampler_destroy(retired->resampler);
+		bfree(retired->snapshot);
 	}
+
+	da_free(audio->retired);
 	bfree(audio);
 }
 
@@ -425,9 +575,7 @@ bool audio_output_active(const audio_t *audio)
 		return false;
 
 	for (size_t mix_idx = 0; mix_idx < MAX_AUDIO_MIXES; mix_idx++) {
-		const struct audio_mix *mix = &audio->mixes[mix_idx];
-
-		if (mix->inputs.num != 0)
+		if (os_atomic_load_long(&audio->mixes[mix_idx].input_count))
 			return true;
 	}
 
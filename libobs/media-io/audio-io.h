@@ -96,6 +96,9 @@ struct audio_output_info {
 
 	audio_input_callback_t input_callback;
 	void *input_param;
+
+	/** Worker threads for per-source audio rendering (0 = serial) */
+	uint32_t mix_threads;
 };
 
 struct audio_convert_info {
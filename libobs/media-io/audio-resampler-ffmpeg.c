@@ -41,6 +41,12 @@ struct audio_resampler {
 	AVChannelLayout input_ch_layout;
 	AVChannelLayout output_ch_layout;
 #endif
+
+	/* direct conversion path: same rate and speaker layout, only the
+	 * sample format differs (the common case for sources feeding the
+	 * float-planar mixer), so swresample is skipped entirely */
+	bool direct;
+	enum audio_format direct_format;
 };
 
 static inline enum AVSampleFormat convert_audio_format(enum audio_format format)
@@ -111,6 +117,13 @@ audio_resampler_t *audio_resampler_create(const struct resample_info *dst, const
 	rs->output_format = convert_audio_format(dst->format);
 	rs->output_planes = is_audio_planar(dst->format) ? rs->output_ch : 1;
 
+	if (src->samples_per_sec == dst->samples_per_sec && src->speakers == dst->speakers &&
+	    dst->format == AUDIO_FORMAT_FLOAT_PLANAR && src->format != AUDIO_FORMAT_UNKNOWN) {
+		rs->direct = true;
+		rs->direct_format = src->format;
+		return rs;
+	}
+
 #if (LIBSWRESAMPLE_VERSION_INT < AV_VERSION_INT(4, 5, 100))
 	rs->input_layout = convert_speaker_layout(src->speakers);
 	rs->output_layout = convert_speaker_layout(dst->speakers);
@@ -178,12 +191,92 @@ void audio_resampler_destroy(audio_resampler_t *rs)
 	}
 }
 
+static bool resample_direct(struct audio_resampler *rs, uint8_t *output[], uint32_t *out_frames, uint64_t *ts_offset,
+			    const uint8_t *const input[], uint32_t in_frames)
+{
+	uint32_t channels = rs->output_ch;
+
+	if ((int)in_frames > rs->output_size) {
+		if (rs->output_buffer[0])
+			av_freep(&rs->output_buffer[0]);
+
+		av_samples_alloc(rs->output_buffer, NULL, channels, in_frames, rs->output_format, 0);
+
+		rs->output_size = in_frames;
+	}
+
+	for (uint32_t ch = 0; ch < channels; ch++) {
+		float *out = (float *)rs->output_buffer[ch];
+
+		switch (rs->direct_format) {
+		case AUDIO_FORMAT_FLOAT_PLANAR:
+			memcpy(out, input[ch], in_frames * sizeof(float));
+			break;
+
+		case AUDIO_FORMAT_FLOAT: {
+			const float *in = (const float *)input[0] + ch;
+			for (uint32_t i = 0; i < in_frames; i++)
+				out[i] = in[i * channels];
+			break;
+		}
+		case AUDIO_FORMAT_16BIT_PLANAR: {
+			const int16_t *in = (const int16_t *)input[ch];
+			for (uint32_t i = 0; i < in_frames; i++)
+				out[i] = (float)in[i] * (1.0f / 32768.0f);
+			break;
+		}
+		case AUDIO_FORMAT_16BIT: {
+			const int16_t *in = (const int16_t *)input[0] + ch;
+			for (uint32_t i = 0; i < in_frames; i++)
+				out[i] = (float)in[i * channels] * (1.0f / 32768.0f);
+			break;
+		}
+		case AUDIO_FORMAT_32BIT_PLANAR: {
+			const int32_t *in = (const int32_t *)input[ch];
+			for (uint32_t i = 0; i < in_frames; i++)
+				out[i] = (float)in[i] * (1.0f / 2147483648.0f);
+			break;
+		}
+		case AUDIO_FORMAT_32BIT: {
+			const int32_t *in = (const int32_t *)input[0] + ch;
+			for (uint32_t i = 0; i < in_frames; i++)
+				out[i] = (float)in[i * channels] * (1.0f / 2147483648.0f);
+			break;
+		}
+		case AUDIO_FORMAT_U8BIT_PLANAR: {
+			const uint8_t *in = input[ch];
+			for (uint32_t i = 0; i < in_frames; i++)
+				out[i] = ((float)in[i] - 128.0f) * (1.0f / 128.0f);
+			break;
+		}
+		case AUDIO_FORMAT_U8BIT: {
+			const uint8_t *in = input[0] + ch;
+			for (uint32_t i = 0; i < in_frames; i++)
+				out[i] = ((float)in[i * channels] - 128.0f) * (1.0f / 128.0f);
+			break;
+		}
+		case AUDIO_FORMAT_UNKNOWN:
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < rs->output_planes; i++)
+		output[i] = rs->output_buffer[i];
+
+	*out_frames = in_frames;
+	*ts_offset = 0;
+	return true;
+}
+
 bool audio_resampler_resample(audio_resampler_t *rs, uint8_t *output[], uint32_t *out_frames, uint64_t *ts_offset,
 			      const uint8_t *const input[], uint32_t in_frames)
 {
 	if (!rs)
 		return false;
 
+	if (rs->direct)
+		return resample_direct(rs, output, out_frames, ts_offset, input, in_frames);
+
 	struct SwrContext *context = rs->context;
 	int ret;
 
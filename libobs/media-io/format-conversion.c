@@ -17,6 +17,21 @@
 
 #include "format-conversion.h"
 
+/* immintrin must precede sse-intrin.h: with simde's native aliases in
+ * effect, including it afterwards mangles the declarations */
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define FC_HAVE_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define FC_AVX2_TARGET
+#elif defined(__AVX2__)
+#define FC_AVX2_TARGET
+#else
+#define FC_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
 #include "../util/sse-intrin.h"
 
 /* ...surprisingly, if I don't use a macro to force inlining, it causes the
@@ -173,8 +188,163 @@ void convert_uyvx_to_i444(const uint8_t *input, uint32_t in_linesize, uint32_t s
 	}
 }
 
-void decompress_420(const uint8_t *const input[], const uint32_t in_linesize[], uint32_t start_y, uint32_t end_y,
-		    uint8_t *output, uint32_t out_linesize)
+#ifdef FC_HAVE_AVX2
+static bool fc_avx2_supported(void)
+{
+	static int cached = -1;
+
+	if (cached < 0) {
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuidex(info, 7, 0);
+		cached = (info[1] & (1 << 5)) != 0;
+#else
+		cached = __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+	}
+
+	return cached == 1;
+}
+
+/* The 4:2:0 decompression loops expand every chroma sample to a 2x2 block of
+ * packed 444 pixels; with AVX2 this is eight output pixels per row per
+ * iteration (four chroma samples duplicated pairwise via a cross-lane
+ * permute). */
+
+static FC_AVX2_TARGET void decompress_420_avx2(const uint8_t *const input[], const uint32_t in_linesize[],
+					       uint32_t start_y, uint32_t end_y, uint8_t *output,
+					       uint32_t out_linesize)
+{
+	uint32_t start_y_d2 = start_y / 2;
+	uint32_t width_d2 = in_linesize[0] / 2;
+	uint32_t height_d2 = end_y / 2;
+	const __m256i dup_idx = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+	uint32_t y;
+
+	for (y = start_y_d2; y < height_d2; y++) {
+		const uint8_t *chroma0 = input[1] + y * in_linesize[1];
+		const uint8_t *chroma1 = input[2] + y * in_linesize[2];
+		const uint8_t *lum0 = input[0] + y * 2 * in_linesize[0];
+		const uint8_t *lum1 = lum0 + in_linesize[0];
+		uint32_t *output0 = (uint32_t *)(output + y * 2 * out_linesize);
+		uint32_t *output1 = (uint32_t *)((uint8_t *)output0 + out_linesize);
+		uint32_t x = 0;
+
+		for (; x + 4 <= width_d2; x += 4) {
+			__m256i u = _mm256_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int *)(chroma0 + x)));
+			__m256i v = _mm256_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int *)(chroma1 + x)));
+			__m256i ch = _mm256_or_si256(_mm256_slli_epi32(u, 8), v);
+			__m256i l0, l1;
+
+			ch = _mm256_permutevar8x32_epi32(ch, dup_idx);
+
+			l0 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(lum0 + x * 2)));
+			l1 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(lum1 + x * 2)));
+
+			_mm256_storeu_si256((__m256i *)(output0 + x * 2),
+					    _mm256_or_si256(_mm256_slli_epi32(l0, 16), ch));
+			_mm256_storeu_si256((__m256i *)(output1 + x * 2),
+					    _mm256_or_si256(_mm256_slli_epi32(l1, 16), ch));
+		}
+
+		for (; x < width_d2; x++) {
+			uint32_t out = (chroma0[x] << 8) | chroma1[x];
+
+			output0[x * 2] = (lum0[x * 2] << 16) | out;
+			output0[x * 2 + 1] = (lum0[x * 2 + 1] << 16) | out;
+			output1[x * 2] = (lum1[x * 2] << 16) | out;
+			output1[x * 2 + 1] = (lum1[x * 2 + 1] << 16) | out;
+		}
+	}
+}
+
+static FC_AVX2_TARGET void decompress_nv12_avx2(const uint8_t *const input[], const uint32_t in_linesize[],
+						uint32_t start_y, uint32_t end_y, uint8_t *output,
+						uint32_t out_linesize)
+{
+	uint32_t start_y_d2 = start_y / 2;
+	uint32_t width_d2 = min_uint32(in_linesize[0], out_linesize) / 2;
+	uint32_t height_d2 = end_y / 2;
+	const __m256i dup_idx = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+	uint32_t y;
+
+	for (y = start_y_d2; y < height_d2; y++) {
+		const uint16_t *chroma = (const uint16_t *)(input[1] + y * in_linesize[1]);
+		const uint8_t *lum0 = input[0] + y * 2 * in_linesize[0];
+		const uint8_t *lum1 = lum0 + in_linesize[0];
+		uint32_t *output0 = (uint32_t *)(output + y * 2 * out_linesize);
+		uint32_t *output1 = (uint32_t *)((uint8_t *)output0 + out_linesize);
+		uint32_t x = 0;
+
+		for (; x + 4 <= width_d2; x += 4) {
+			__m256i ch = _mm256_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)(chroma + x)));
+			__m256i l0, l1;
+
+			ch = _mm256_slli_epi32(_mm256_permutevar8x32_epi32(ch, dup_idx), 8);
+
+			l0 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(lum0 + x * 2)));
+			l1 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(lum1 + x * 2)));
+
+			_mm256_storeu_si256((__m256i *)(output0 + x * 2), _mm256_or_si256(l0, ch));
+			_mm256_storeu_si256((__m256i *)(output1 + x * 2), _mm256_or_si256(l1, ch));
+		}
+
+		for (; x < width_d2; x++) {
+			uint32_t out = chroma[x] << 8;
+
+			output0[x * 2] = lum0[x * 2] | out;
+			output0[x * 2 + 1] = lum0[x * 2 + 1] | out;
+			output1[x * 2] = lum1[x * 2] | out;
+			output1[x * 2 + 1] = lum1[x * 2 + 1] | out;
+		}
+	}
+}
+
+static FC_AVX2_TARGET void decompress_422_avx2(const uint8_t *input, uint32_t in_linesize, uint32_t start_y,
+					       uint32_t end_y, uint8_t *output, uint32_t out_linesize,
+					       bool leading_lum)
+{
+	uint32_t width_d2 = min_uint32(in_linesize, out_linesize) / 2;
+	const __m256i dup_idx = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+	const __m256i keep_mask = _mm256_set1_epi32(leading_lum ? 0xFFFFFF00 : 0xFFFF00FF);
+	const __m256i fill_mask = _mm256_set1_epi32(leading_lum ? 0x000000FF : 0x0000FF00);
+	uint32_t y;
+
+	for (y = start_y; y < end_y; y++) {
+		const uint32_t *input32 = (const uint32_t *)(input + y * in_linesize);
+		uint32_t *output32 = (uint32_t *)(output + y * out_linesize);
+		uint32_t x = 0;
+
+		for (; x + 4 <= width_d2; x += 4) {
+			__m256i d = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(input32 + x)));
+			__m256i t;
+
+			d = _mm256_permutevar8x32_epi32(d, dup_idx);
+			t = _mm256_or_si256(_mm256_and_si256(d, keep_mask),
+					    _mm256_and_si256(_mm256_srli_epi32(d, 16), fill_mask));
+
+			_mm256_storeu_si256((__m256i *)(output32 + x * 2), _mm256_blend_epi32(d, t, 0xAA));
+		}
+
+		for (; x < width_d2; x++) {
+			uint32_t dw = input32[x];
+
+			output32[x * 2] = dw;
+			if (leading_lum) {
+				dw &= 0xFFFFFF00;
+				dw |= (uint8_t)(dw >> 16);
+			} else {
+				dw &= 0xFFFF00FF;
+				dw |= (dw >> 16) & 0xFF00;
+			}
+			output32[x * 2 + 1] = dw;
+		}
+	}
+}
+#endif /* FC_HAVE_AVX2 */
+
+static void decompress_420_scalar(const uint8_t *const input[], const uint32_t in_linesize[], uint32_t start_y,
+				  uint32_t end_y, uint8_t *output, uint32_t out_linesize)
 {
 	uint32_t start_y_d2 = start_y / 2;
 	uint32_t width_d2 = in_linesize[0] / 2;
@@ -206,8 +376,20 @@ void decompress_420(const uint8_t *const input[], const uint32_t in_linesize[],
 	}
 }
 
-void decompress_nv12(const uint8_t *const input[], const uint32_t in_linesize[], uint32_t start_y, uint32_t end_y,
-		     uint8_t *output, uint32_t out_linesize)
+void decompress_420(const uint8_t *const input[], const uint32_t in_linesize[], uint32_t start_y, uint32_t end_y,
+		    uint8_t *output, uint32_t out_linesize)
+{
+#ifdef FC_HAVE_AVX2
+	if (fc_avx2_supported()) {
+		decompress_420_avx2(input, in_linesize, start_y, end_y, output, out_linesize);
+		return;
+	}
+#endif
+	decompress_420_scalar(input, in_linesize, start_y, end_y, output, out_linesize);
+}
+
+static void decompress_nv12_scalar(const uint8_t *const input[], const uint32_t in_linesize[], uint32_t start_y,
+				   uint32_t end_y, uint8_t *output, uint32_t out_linesize)
 {
 	uint32_t start_y_d2 = start_y / 2;
 	uint32_t width_d2 = min_uint32(in_linesize[0], out_linesize) / 2;
@@ -238,8 +420,20 @@ void decompress_nv12(const uint8_t *const input[], const uint32_t in_linesize[],
 	}
 }
 
-void decompress_422(const uint8_t *input, uint32_t in_linesize, uint32_t start_y, uint32_t end_y, uint8_t *output,
-		    uint32_t out_linesize, bool leading_lum)
+void decompress_nv12(const uint8_t *const input[], const uint32_t in_linesize[], uint32_t start_y, uint32_t end_y,
+		     uint8_t *output, uint32_t out_linesize)
+{
+#ifdef FC_HAVE_AVX2
+	if (fc_avx2_supported()) {
+		decompress_nv12_avx2(input, in_linesize, start_y, end_y, output, out_linesize);
+		return;
+	}
+#endif
+	decompress_nv12_scalar(input, in_linesize, start_y, end_y, output, out_linesize);
+}
+
+static void decompress_422_scalar(const uint8_t *input, uint32_t in_linesize, uint32_t start_y, uint32_t end_y,
+				  uint8_t *output, uint32_t out_linesize, bool leading_lum)
 {
 	uint32_t width_d2 = min_uint32(in_linesize, out_linesize) / 2;
 	uint32_t y;
@@ -286,3 +480,15 @@ void decompress_422(const uint8_t *input, uint32_t in_linesize, uint32_t start_y
 		}
 	}
 }
+
+void decompress_422(const uint8_t *input, uint32_t in_linesize, uint32_t start_y, uint32_t end_y, uint8_t *output,
+		    uint32_t out_linesize, bool leading_lum)
+{
+#ifdef FC_HAVE_AVX2
+	if (fc_avx2_supported()) {
+		decompress_422_avx2(input, in_linesize, start_y, end_y, output, out_linesize, leading_lum);
+		return;
+	}
+#endif
+	decompress_422_scalar(input, in_linesize, start_y, end_y, output, out_linesize, leading_lum);
+}
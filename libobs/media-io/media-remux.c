@@ -23,11 +23,13 @@
 
 #include <libavformat/avformat.h>
 #include <libavcodec/version.h>
+#include <inttypes.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
 struct media_remux_job {
 	int64_t in_size;
+	int64_t reserved_moov_size;
 	AVFormatContext *ifmt_ctx, *ofmt_ctx;
 };
 
@@ -133,6 +135,56 @@ static inline bool init_output(media_remux_job_t job, const char *out_filename)
 	return true;
 }
 
+static inline int64_t estimate_stream_packets(const AVStream *st)
+{
+	double rate, seconds;
+
+	if (st->nb_frames > 0)
+		return st->nb_frames;
+
+	if (st->duration <= 0)
+		return 0;
+
+	seconds = st->duration * av_q2d(st->time_base);
+
+	if (st->codecpar->codec_type == AVMEDIA_TYPE_AUDIO && st->codecpar->sample_rate > 0) {
+		/* a typical lossy audio packet covers ~1024 samples */
+		rate = st->codecpar->sample_rate / 1024.0;
+	} else {
+		rate = av_q2d(st->avg_frame_rate);
+		if (rate <= 0.0)
+			rate = 60.0;
+	}
+
+	return (int64_t)(seconds * rate);
+}
+
+/* mp4/mov outputs: reserve space for the moov atom at the start of the
+ * file so the trailer writes the index in place, instead of leaving it at
+ * the end where players have to seek for it (or requiring a second
+ * full-file faststart rewrite pass) */
+static inline void init_faststart(media_remux_job_t job)
+{
+	const char *name = job->ofmt_ctx->oformat->name;
+	int64_t packets = 0;
+
+	if (strcmp(name, "mp4") != 0 && strcmp(name, "mov") != 0)
+		return;
+
+	for (unsigned i = 0; i < job->ifmt_ctx->nb_streams; i++)
+		packets += estimate_stream_packets(job->ifmt_ctx->streams[i]);
+
+	/* without any packet count estimate the reservation could come up
+	 * short and fail the remux, so fall back to moov-at-end */
+	if (!packets)
+		return;
+
+	/* sample tables cost roughly 40 bytes per packet; reserve double
+	 * that, since an undersized reservation fails the trailer write
+	 * while an oversized one only costs a free atom in the output */
+	job->reserved_moov_size = packets * 40 * 2 + 4096;
+}
+
 bool media_remux_job_create(media_remux_job_t *job, const char *in_filename, const char *out_filename)
 {
 	if (!job)
@@ -157,6 +209,8 @@ bool media_remux_job_create(media_remux_job_t *job, const char *in_filename, con
 	if (!init_output(*job, out_filename))
 		goto fail;
 
+	init_faststart(*job);
+
 	return true;
 
 fail:
@@ -220,13 +274,18 @@ static inline int process_packets(media_remux_job_t job, media_remux_progress_ca
 
 bool media_remux_job_process(media_remux_job_t job, media_remux_progress_callback callback, void *data)
 {
+	AVDictionary *opts = NULL;
 	int ret;
 	bool success = false;
 
 	if (!job)
 		return success;
 
-	ret = avformat_write_header(job->ofmt_ctx, NULL);
+	if (job->reserved_moov_size > 0)
+		av_dict_set_int(&opts, "moov_size", job->reserved_moov_size, 0);
+
+	ret = avformat_write_header(job->ofmt_ctx, &opts);
+	av_dict_free(&opts);
 	if (ret < 0) {
 		blog(LOG_ERROR, "media_remux: Error opening output file: %s", av_err2str(ret));
 		return success;
@@ -241,6 +300,11 @@ bool media_remux_job_process(media_remux_job_t job, media_remux_progress_callbac
 	ret = av_write_trailer(job->ofmt_ctx);
 	if (ret < 0) {
 		blog(LOG_ERROR, "media_remux: av_write_trailer: %s", av_err2str(ret));
+		if (job->reserved_moov_size > 0)
+			blog(LOG_ERROR, "media_remux: reserved moov space "
+					"(%" PRId64 " bytes) may have been "
+					"insufficient",
+			     job->reserved_moov_size);
 		success = false;
 	}
 
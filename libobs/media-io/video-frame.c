@@ -15,6 +15,7 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 ******************************************************************************/
 #include <assert.h>
+#include "../util/threading.h"
 #include "video-frame.h"
 
 #define HALF(size) ((size + 1) / 2)
@@ -187,21 +188,16 @@ void video_frame_get_plane_heights(uint32_t heights[MAX_AV_PLANES], enum video_f
 	}
 }
 
-void video_frame_init(struct video_frame *frame, enum video_format format, uint32_t width, uint32_t height)
+static size_t get_total_size(enum video_format format, uint32_t width, uint32_t height,
+			     uint32_t linesizes[MAX_AV_PLANES], size_t offsets[MAX_AV_PLANES])
 {
-	size_t size = 0;
-	uint32_t linesizes[MAX_AV_PLANES];
 	uint32_t heights[MAX_AV_PLANES];
-	size_t offsets[MAX_AV_PLANES];
+	size_t size = 0;
 	int alignment = base_get_alignment();
 
-	if (!frame)
-		return;
-
-	memset(frame, 0, sizeof(struct video_frame));
-	memset(linesizes, 0, sizeof(linesizes));
+	memset(linesizes, 0, sizeof(uint32_t) * MAX_AV_PLANES);
 	memset(heights, 0, sizeof(heights));
-	memset(offsets, 0, sizeof(offsets));
+	memset(offsets, 0, sizeof(size_t) * MAX_AV_PLANES);
 
 	/* determine linesizes for each plane */
 	video_frame_get_linesizes(linesizes, format, width);
@@ -219,13 +215,121 @@ void video_frame_init(struct video_frame *frame, enum video_format format, uint3
 		offsets[i] = size;
 	}
 
-	/* allocate memory */
-	frame->data[0] = bmalloc(size);
+	return size;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Process-wide cache of recently released frame buffers.  Buffers are plain
+ * bmalloc allocations, so frames freed directly with video_frame_free()
+ * (which calls bfree) merely bypass the cache; only matching geometries are
+ * reused, so a stale buffer can never be handed out undersized. */
+
+#define FRAME_POOL_MAX_BUFFERS 8
+
+struct pooled_buffer {
+	size_t size;
+	uint8_t *data;
+};
+
+static pthread_mutex_t frame_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct pooled_buffer frame_pool[FRAME_POOL_MAX_BUFFERS];
+static size_t frame_pool_count = 0;
+static volatile long frame_pool_hits = 0;
+static volatile long frame_pool_misses = 0;
+
+static uint8_t *frame_pool_acquire(size_t size)
+{
+	uint8_t *data = NULL;
+
+	pthread_mutex_lock(&frame_pool_mutex);
+	for (size_t i = 0; i < frame_pool_count; i++) {
+		if (frame_pool[i].size == size) {
+			data = frame_pool[i].data;
+			frame_pool[i] = frame_pool[--frame_pool_count];
+			break;
+		}
+	}
+	pthread_mutex_unlock(&frame_pool_mutex);
+
+	if (data) {
+		os_atomic_inc_long(&frame_pool_hits);
+		return data;
+	}
+
+	os_atomic_inc_long(&frame_pool_misses);
+	return bmalloc(size);
+}
+
+void video_frame_release(struct video_frame *frame, enum video_format format, uint32_t width, uint32_t height)
+{
+	uint32_t linesizes[MAX_AV_PLANES];
+	size_t offsets[MAX_AV_PLANES];
+	uint8_t *data;
+	size_t size;
+
+	if (!frame)
+		return;
+
+	data = frame->data[0];
+	memset(frame, 0, sizeof(struct video_frame));
+	if (!data)
+		return;
+
+	size = get_total_size(format, width, height, linesizes, offsets);
+
+	pthread_mutex_lock(&frame_pool_mutex);
+	if (size && frame_pool_count < FRAME_POOL_MAX_BUFFERS) {
+		frame_pool[frame_pool_count].size = size;
+		frame_pool[frame_pool_count].data = data;
+		frame_pool_count++;
+		data = NULL;
+	}
+	pthread_mutex_unlock(&frame_pool_mutex);
+
+	if (data)
+		bfree(data);
+}
+
+void video_frame_pool_get_stats(uint64_t *hits, uint64_t *misses)
+{
+	if (hits)
+		*hits = (uint64_t)os_atomic_load_long(&frame_pool_hits);
+	if (misses)
+		*misses = (uint64_t)os_atomic_load_long(&frame_pool_misses);
+}
+
+void video_frame_pool_clear(void)
+{
+	pthread_mutex_lock(&frame_pool_mutex);
+	for (size_t i = 0; i < frame_pool_count; i++)
+		bfree(frame_pool[i].data);
+	frame_pool_count = 0;
+	pthread_mutex_unlock(&frame_pool_mutex);
+}
+
+/* ------------------------------------------------------------------------- */
+
+void video_frame_init(struct video_frame *frame, enum video_format format, uint32_t width, uint32_t height)
+{
+	size_t size;
+	uint32_t linesizes[MAX_AV_PLANES];
+	size_t offsets[MAX_AV_PLANES];
+
+	if (!frame)
+		return;
+
+	memset(frame, 0, sizeof(struct video_frame));
+
+	size = get_total_size(format, width, height, linesizes, offsets);
+
+	/* allocate memory, reusing a pooled buffer when one matches */
+	frame->data[0] = size ? frame_pool_acquire(size) : bmalloc(size);
 	frame->linesize[0] = linesizes[0];
 
-	/* apply plane data pointers according to offsets */
+	/* apply plane data pointers according to offsets (offsets[i] is only
+	 * set for planes that exist) */
 	for (uint32_t i = 1; i < MAX_AV_PLANES; i++) {
-		if (!linesizes[i] || !heights[i])
+		if (!linesizes[i] || !offsets[i])
 			continue;
 		frame->data[i] = frame->data[0] + offsets[i - 1];
 		frame->linesize[i] = linesizes[i];
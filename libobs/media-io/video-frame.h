@@ -31,6 +31,15 @@ struct video_frame {
 
 EXPORT void video_frame_init(struct video_frame *frame, enum video_format format, uint32_t width, uint32_t height);
 
+/* Returns the frame's buffer to a process-wide pool so a later
+ * video_frame_init() of the same geometry can reuse it without allocating.
+ * Only valid for buffers that video_frame_init() allocated with the same
+ * format/width/height. */
+EXPORT void video_frame_release(struct video_frame *frame, enum video_format format, uint32_t width, uint32_t height);
+
+EXPORT void video_frame_pool_get_stats(uint64_t *hits, uint64_t *misses);
+EXPORT void video_frame_pool_clear(void);
+
 static inline void video_frame_free(struct video_frame *frame)
 {
 	if (frame) {
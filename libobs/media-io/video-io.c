@@ -36,8 +36,8 @@ extern profiler_name_store_t *obs_get_profiler_name_store(void);
 
 struct cached_frame_info {
 	struct video_data frame;
-	int skipped;
-	int count;
+	volatile long skipped;
+	volatile long count;
 };
 
 struct video_input {
@@ -46,6 +46,13 @@ struct video_input {
 	struct video_frame frame[MAX_CONVERT_BUFFERS];
 	int cur_frame;
 
+	// scaler cascade: when another input already produced a scaled frame
+	// this tick that matches or covers this input's target, reuse it (or
+	// rescale from it) instead of scaling the full canvas again
+	video_scaler_t *cascade_scaler;
+	struct video_scale_info cascade_from;
+	bool tick_scaled;
+
 	// allow outputting at fractions of main composition FPS,
 	// e.g. 60 FPS with frame_rate_divisor = 1 turns into 30 FPS
 	//
@@ -65,24 +72,30 @@ static inline void video_input_free(struct video_input *input)
 	for (size_t i = 0; i < MAX_CONVERT_BUFFERS; i++)
 		video_frame_free(&input->frame[i]);
 	video_scaler_destroy(input->scaler);
+	video_scaler_destroy(input->cascade_scaler);
 }
 
 struct video_output {
 	struct video_output_info info;
 
 	pthread_t thread;
-	pthread_mutex_t data_mutex;
 	bool stop;
 
 	os_sem_t *update_semaphore;
 	uint64_t frame_time;
 	volatile long skipped_frames;
 	volatile long total_frames;
+	volatile long dropped_frames;
 
 	pthread_mutex_t input_mutex;
 	DARRAY(struct video_input) inputs;
 
-	size_t available_frames;
+	/* single-producer/single-consumer frame ring: the graphics thread
+	 * owns last_added and writes slots in ring order, the video thread
+	 * owns first_added and consumes them in the same order, and
+	 * pending_frames counts published but unconsumed frames, so the
+	 * per-frame handoff needs no mutex */
+	volatile long pending_frames;
 	size_t first_added;
 	size_t last_added;
 	struct cached_frame_info cache[MAX_CACHE_SIZE];
@@ -95,31 +108,99 @@ struct video_output {
 
 /* ------------------------------------------------------------------------- */
 
-static inline bool scale_video_output(struct video_input *input, struct video_data *data)
+static inline bool scale_info_match(const struct video_scale_info *a, const struct video_scale_info *b)
+{
+	return a->format == b->format && a->width == b->width && a->height == b->height &&
+	       a->colorspace == b->colorspace && a->range == b->range;
+}
+
+static inline bool scale_info_covers(const struct video_scale_info *src, const struct video_scale_info *dst)
+{
+	return src->format == dst->format && src->colorspace == dst->colorspace && src->range == dst->range &&
+	       src->width >= dst->width && src->height >= dst->height;
+}
+
+static struct video_input *find_cascade_source(struct video_output *video, size_t idx)
+{
+	struct video_input *input = video->inputs.array + idx;
+	struct video_input *best = NULL;
+
+	for (size_t i = 0; i < idx; i++) {
+		struct video_input *other = video->inputs.array + i;
+
+		if (!other->tick_scaled || !scale_info_covers(&other->conversion, &input->conversion))
+			continue;
+
+		if (!best || (other->conversion.width * other->conversion.height <
+			      best->conversion.width * best->conversion.height))
+			best = other;
+	}
+
+	return best;
+}
+
+static inline bool scale_video_output(struct video_output *video, size_t idx, struct video_data *data)
 {
+	struct video_input *input = video->inputs.array + idx;
+	video_scaler_t *scaler = input->scaler;
+	struct video_frame *frame;
 	bool success = true;
 
-	if (input->scaler) {
-		struct video_frame *frame;
+	if (!scaler)
+		return true;
 
-		if (++input->cur_frame == MAX_CONVERT_BUFFERS)
-			input->cur_frame = 0;
+	struct video_input *src = find_cascade_source(video, idx);
+	if (src) {
+		struct video_frame *src_frame = &src->frame[src->cur_frame];
+
+		if (scale_info_match(&src->conversion, &input->conversion)) {
+			/* identical target: share the frame that was already
+			 * scaled this tick */
+			for (size_t i = 0; i < MAX_AV_PLANES; i++) {
+				data->data[i] = src_frame->data[i];
+				data->linesize[i] = src_frame->linesize[i];
+			}
+			return true;
+		}
 
-		frame = &input->frame[input->cur_frame];
+		if (!input->cascade_scaler || !scale_info_match(&input->cascade_from, &src->conversion)) {
+			video_scaler_destroy(input->cascade_scaler);
+			input->cascade_scaler = NULL;
 
-		success = video_scaler_scale(input->scaler, frame->data, frame->linesize,
-					     (const uint8_t *const *)data->data, data->linesize);
+			if (video_scaler_create2(&input->cascade_scaler, &input->conversion, &src->conversion,
+						 VIDEO_SCALE_FAST_BILINEAR, 0) == VIDEO_SCALER_SUCCESS)
+				input->cascade_from = src->conversion;
+		}
 
-		if (success) {
+		/* rescale from the smallest covering result instead of the
+		 * full canvas */
+		if (input->cascade_scaler) {
+			scaler = input->cascade_scaler;
 			for (size_t i = 0; i < MAX_AV_PLANES; i++) {
-				data->data[i] = frame->data[i];
-				data->linesize[i] = frame->linesize[i];
+				data->data[i] = src_frame->data[i];
+				data->linesize[i] = src_frame->linesize[i];
 			}
-		} else {
-			blog(LOG_WARNING, "video-io: Could not scale frame!");
 		}
 	}
 
+	if (++input->cur_frame == MAX_CONVERT_BUFFERS)
+		input->cur_frame = 0;
+
+	frame = &input->frame[input->cur_frame];
+
+	success = video_scaler_scale(scaler, frame->data, frame->linesize, (const uint8_t *const *)data->data,
+				     data->linesize);
+
+	if (success) {
+		for (size_t i = 0; i < MAX_AV_PLANES; i++) {
+			data->data[i] = frame->data[i];
+			data->linesize[i] = frame->linesize[i];
+		}
+		input->tick_scaled = true;
+	} else {
+		blog(LOG_WARNING, "video-io: Could not scale frame!");
+	}
+
 	return success;
 }
 
@@ -131,16 +212,15 @@ static inline bool video_output_cur_frame(struct video_output *video)
 
 	/* -------------------------------- */
 
-	pthread_mutex_lock(&video->data_mutex);
-
 	frame_info = &video->cache[video->first_added];
 
-	pthread_mutex_unlock(&video->data_mutex);
-
 	/* -------------------------------- */
 
 	pthread_mutex_lock(&video->input_mutex);
 
+	for (size_t i = 0; i < video->inputs.num; i++)
+		video->inputs.array[i].tick_scaled = false;
+
 	for (size_t i = 0; i < video->inputs.num; i++) {
 		struct video_input *input = video->inputs.array + i;
 		struct video_data frame = frame_info->frame;
@@ -155,7 +235,7 @@ static inline bool video_output_cur_frame(struct video_output *video)
 		if (skip)
 			continue;
 
-		if (scale_video_output(input, &frame))
+		if (scale_video_output(video, i, &frame))
 			input->callback(input->param, &frame);
 	}
 
@@ -163,25 +243,20 @@ static inline bool video_output_cur_frame(struct video_output *video)
 
 	/* -------------------------------- */
 
-	pthread_mutex_lock(&video->data_mutex);
-
 	frame_info->frame.timestamp += video->frame_time;
-	complete = --frame_info->count == 0;
-	skipped = frame_info->skipped > 0;
+	complete = os_atomic_dec_long(&frame_info->count) == 0;
+	skipped = os_atomic_load_long(&frame_info->skipped) > 0;
 
 	if (complete) {
 		if (++video->first_added == video->info.cache_size)
 			video->first_added = 0;
 
-		if (++video->available_frames == video->info.cache_size)
-			video->last_added = video->first_added;
+		os_atomic_dec_long(&video->pending_frames);
 	} else if (skipped) {
-		--frame_info->skipped;
+		os_atomic_dec_long(&frame_info->skipped);
 		os_atomic_inc_long(&video->skipped_frames);
 	}
 
-	pthread_mutex_unlock(&video->data_mutex);
-
 	/* -------------------------------- */
 
 	return complete;
@@ -233,7 +308,9 @@ static inline void init_cache(struct video_output *video)
 		video_frame_init(frame, video->info.format, video->info.width, video->info.height);
 	}
 
-	video->available_frames = video->info.cache_size;
+	/* the producer advances before writing, so the first frame lands in
+	 * slot zero where the consumer starts */
+	video->last_added = video->info.cache_size - 1;
 }
 
 int video_output_open(video_t **video, struct video_output_info *info)
@@ -250,26 +327,22 @@ int video_output_open(video_t **video, struct video_output_info *info)
 	memcpy(&out->info, info, sizeof(struct video_output_info));
 	out->frame_time = util_mul_div64(1000000000ULL, info->fps_den, info->fps_num);
 
-	if (pthread_mutex_init_recursive(&out->data_mutex) != 0)
-		goto fail0;
 	if (pthread_mutex_init_recursive(&out->input_mutex) != 0)
-		goto fail1;
+		goto fail0;
 	if (os_sem_init(&out->update_semaphore, 0) != 0)
-		goto fail2;
+		goto fail1;
 	if (pthread_create(&out->thread, NULL, video_thread, out) != 0)
-		goto fail3;
+		goto fail2;
 
 	init_cache(out);
 
 	*video = out;
 	return VIDEO_OUTPUT_SUCCESS;
 
-fail3:
-	os_sem_destroy(out->update_semaphore);
 fail2:
-	pthread_mutex_destroy(&out->input_mutex);
+	os_sem_destroy(out->update_semaphore);
 fail1:
-	pthread_mutex_destroy(&out->data_mutex);
+	pthread_mutex_destroy(&out->input_mutex);
 fail0:
 	bfree(out);
 	return VIDEO_OUTPUT_FAIL;
@@ -293,7 +366,6 @@ void video_output_close(video_t *video)
 
 	pthread_mutex_unlock(&video->input_mutex);
 	os_sem_destroy(video->update_semaphore);
-	pthread_mutex_destroy(&video->data_mutex);
 	pthread_mutex_destroy(&video->input_mutex);
 
 	bfree(video);
@@ -349,7 +421,7 @@ static inline bool video_input_init(struct video_input *input, struct video_outp
 						.range = video->info.range,
 						.colorspace = video->info.colorspace};
 
-		int ret = video_scaler_create(&input->scaler, &input->conversion, &from, VIDEO_SCALE_FAST_BILINEAR);
+		int ret = video_scaler_create2(&input->scaler, &input->conversion, &from, VIDEO_SCALE_FAST_BILINEAR, 0);
 		if (ret != VIDEO_SCALER_SUCCESS) {
 			if (ret == VIDEO_SCALER_BAD_CONVERSION)
 				blog(LOG_ERROR, "video_input_init: Bad "
@@ -373,6 +445,7 @@ static inline void reset_frames(video_t *video)
 {
 	os_atomic_set_long(&video->skipped_frames, 0);
 	os_atomic_set_long(&video->total_frames, 0);
+	os_atomic_set_long(&video->dropped_frames, 0);
 }
 
 static const video_t *get_const_root(const video_t *video)
@@ -451,6 +524,7 @@ bool video_output_connect2(video_t *video, const struct video_scale_info *conver
 static void log_skipped(video_t *video)
 {
 	long skipped = os_atomic_load_long(&video->skipped_frames);
+	long dropped = os_atomic_load_long(&video->dropped_frames);
 	double percentage_skipped = (double)skipped / (double)os_atomic_load_long(&video->total_frames) * 100.0;
 
 	if (skipped)
@@ -460,6 +534,13 @@ static void log_skipped(video_t *video)
 		     "to encoding lag: "
 		     "%ld/%ld (%0.1f%%)",
 		     video->skipped_frames, video->total_frames, percentage_skipped);
+	if (dropped)
+		blog(LOG_INFO,
+		     "Video stopped, number of "
+		     "queued encoder frames "
+		     "replaced by newer ones: "
+		     "%ld",
+		     dropped);
 }
 
 void video_output_disconnect(video_t *video, void (*callback)(void *param, struct video_data *frame), void *param)
@@ -516,31 +597,27 @@ bool video_output_lock_frame(video_t *video, struct video_frame *frame, int coun
 
 	video = get_root(video);
 
-	pthread_mutex_lock(&video->data_mutex);
-
-	if (video->available_frames == 0) {
-		video->cache[video->last_added].count += count;
-		video->cache[video->last_added].skipped += count;
+	if (os_atomic_load_long(&video->pending_frames) >= (long)video->info.cache_size) {
+		/* ring full: fold this frame into the newest queued slot */
+		cfi = &video->cache[video->last_added];
+		os_atomic_add_long(&cfi->count, count);
+		os_atomic_add_long(&cfi->skipped, count);
 		locked = false;
 
 	} else {
-		if (video->available_frames != video->info.cache_size) {
-			if (++video->last_added == video->info.cache_size)
-				video->last_added = 0;
-		}
+		if (++video->last_added == video->info.cache_size)
+			video->last_added = 0;
 
 		cfi = &video->cache[video->last_added];
 		cfi->frame.timestamp = timestamp;
-		cfi->count = count;
-		cfi->skipped = 0;
+		os_atomic_set_long(&cfi->count, count);
+		os_atomic_set_long(&cfi->skipped, 0);
 
 		memcpy(frame, &cfi->frame, sizeof(*frame));
 
 		locked = true;
 	}
 
-	pthread_mutex_unlock(&video->data_mutex);
-
 	return locked;
 }
 
@@ -551,12 +628,11 @@ void video_output_unlock_frame(video_t *video)
 
 	video = get_root(video);
 
-	pthread_mutex_lock(&video->data_mutex);
-
-	video->available_frames--;
+	/* publish the frame written since video_output_lock_frame; the
+	 * sequentially-consistent increment orders the slot contents before
+	 * the consumer can observe the new count */
+	os_atomic_inc_long(&video->pending_frames);
 	os_sem_post(video->update_semaphore);
-
-	pthread_mutex_unlock(&video->data_mutex);
 }
 
 uint64_t video_output_get_frame_time(const video_t *video)
@@ -623,6 +699,11 @@ uint32_t video_output_get_total_frames(const video_t *video)
 	return (uint32_t)os_atomic_load_long(&get_const_root(video)->total_frames);
 }
 
+uint32_t video_output_get_texture_dropped_frames(const video_t *video)
+{
+	return (uint32_t)os_atomic_load_long(&get_const_root(video)->dropped_frames);
+}
+
 /* Note: These four functions below are a very slight bit of a hack.  If the
  * texture encoder thread is active while the raw encoder thread is active, the
  * total frame count will just be doubled while they're both active.  Which is
@@ -657,6 +738,11 @@ void video_output_inc_texture_skipped_frames(video_t *video)
 	os_atomic_inc_long(&get_root(video)->skipped_frames);
 }
 
+void video_output_inc_texture_dropped_frames(video_t *video)
+{
+	os_atomic_inc_long(&get_root(video)->dropped_frames);
+}
+
 video_t *video_output_create_with_frame_rate_divisor(video_t *video, uint32_t divisor)
 {
 	// `divisor == 1` would result in the same frame rate,
@@ -324,11 +324,13 @@ EXPORT double video_output_get_frame_rate(const video_t *video);
 
 EXPORT uint32_t video_output_get_skipped_frames(const video_t *video);
 EXPORT uint32_t video_output_get_total_frames(const video_t *video);
+EXPORT uint32_t video_output_get_texture_dropped_frames(const video_t *video);
 
 extern void video_output_inc_texture_encoders(video_t *video);
 extern void video_output_dec_texture_encoders(video_t *video);
 extern void video_output_inc_texture_frames(video_t *video);
 extern void video_output_inc_texture_skipped_frames(video_t *video);
+extern void video_output_inc_texture_dropped_frames(video_t *video);
 
 extern video_t *video_output_create_with_frame_rate_divisor(video_t *video, uint32_t divisor);
 extern void video_output_free_frame_rate_divisor(video_t *video);
@@ -140,8 +140,8 @@ static inline int get_ffmpeg_range_type(enum video_range_type type)
 
 #define FIXED_1_0 (1 << 16)
 
-int video_scaler_create(video_scaler_t **scaler_out, const struct video_scale_info *dst,
-			const struct video_scale_info *src, enum video_scale_type type)
+int video_scaler_create2(video_scaler_t **scaler_out, const struct video_scale_info *dst,
+			 const struct video_scale_info *src, enum video_scale_type type, uint32_t threads)
 {
 	enum AVPixelFormat format_src = get_ffmpeg_video_format(src->format);
 	enum AVPixelFormat format_dst = get_ffmpeg_video_format(dst->format);
@@ -197,6 +197,16 @@ int video_scaler_create(video_scaler_t **scaler_out, const struct video_scale_in
 	av_opt_set_int(scaler->swscale, "dst_format", format_dst, 0);
 	av_opt_set_int(scaler->swscale, "src_range", range_src, 0);
 	av_opt_set_int(scaler->swscale, "dst_range", range_dst, 0);
+#if LIBSWSCALE_VERSION_INT >= AV_VERSION_INT(6, 1, 100)
+	/* slice-threaded scaling (0 = one thread per logical core); requires
+	 * scaling the whole frame in a single sws_scale call, which
+	 * video_scaler_scale does */
+	av_opt_set_int(scaler->swscale, "threads", threads, 0);
+#else
+	if (threads != 1)
+		blog(LOG_DEBUG, "video_scaler_create: threaded scaling "
+				"unavailable with this libswscale");
+#endif
 	if (sws_init_context(scaler->swscale, NULL, NULL) < 0) {
 		blog(LOG_ERROR, "video_scaler_create: sws_init_context failed");
 		goto fail;
@@ -217,6 +227,12 @@ fail:
 	return VIDEO_SCALER_FAILED;
 }
 
+int video_scaler_create(video_scaler_t **scaler_out, const struct video_scale_info *dst,
+			const struct video_scale_info *src, enum video_scale_type type)
+{
+	return video_scaler_create2(scaler_out, dst, src, type, 1);
+}
+
 void video_scaler_destroy(video_scaler_t *scaler)
 {
 	if (scaler) {
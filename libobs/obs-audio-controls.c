@@ -72,10 +72,15 @@ struct obs_volmeter {
 
 	enum obs_peak_meter_type peak_meter_type;
 	unsigned int update_ms;
+	uint64_t last_update_ns;
 	float prev_samples[MAX_AUDIO_CHANNELS][4];
 
 	float magnitude[MAX_AUDIO_CHANNELS];
 	float peak[MAX_AUDIO_CHANNELS];
+
+	/* envelopes held between decimated updates */
+	float held_magnitude[MAX_AUDIO_CHANNELS];
+	float held_peak[MAX_AUDIO_CHANNELS];
 };
 
 static float cubic_def_to_db(const float def)
@@ -471,7 +476,24 @@ static void volmeter_process_magnitude(obs_volmeter_t *volmeter, const struct au
 		}
 
 		float sum = 0.0;
-		for (size_t i = 0; i < nr_samples; i++) {
+		size_t i = 0;
+
+		if (((uintptr_t)samples & 0xf) == 0) {
+			__m128 sum_ps = _mm_setzero_ps();
+
+			for (; i + 4 <= nr_samples; i += 4) {
+				__m128 s = _mm_load_ps(&samples[i]);
+				sum_ps = _mm_add_ps(sum_ps, _mm_mul_ps(s, s));
+			}
+
+			__m128 hi = _mm_movehl_ps(sum_ps, sum_ps);
+			sum_ps = _mm_add_ps(sum_ps, hi);
+			hi = _mm_shuffle_ps(sum_ps, sum_ps, _MM_SHUFFLE(1, 1, 1, 1));
+			sum_ps = _mm_add_ss(sum_ps, hi);
+			sum = _mm_cvtss_f32(sum_ps);
+		}
+
+		for (; i < nr_samples; i++) {
 			float sample = samples[i];
 			sum += sample * sample;
 		}
@@ -501,6 +523,30 @@ static void volmeter_source_data_received(void *vptr, obs_source_t *source, cons
 
 	volmeter_process_audio_data(volmeter, data);
 
+	/* Decimated mode: hold the envelope over multiple audio blocks and
+	 * only fan out to the callbacks once per update interval. */
+	if (volmeter->update_ms) {
+		uint64_t now = os_gettime_ns();
+
+		for (int channel_nr = 0; channel_nr < MAX_AUDIO_CHANNELS; channel_nr++) {
+			if (volmeter->magnitude[channel_nr] > volmeter->held_magnitude[channel_nr])
+				volmeter->held_magnitude[channel_nr] = volmeter->magnitude[channel_nr];
+			if (volmeter->peak[channel_nr] > volmeter->held_peak[channel_nr])
+				volmeter->held_peak[channel_nr] = volmeter->peak[channel_nr];
+		}
+
+		if (now - volmeter->last_update_ns < (uint64_t)volmeter->update_ms * 1000000) {
+			pthread_mutex_unlock(&volmeter->mutex);
+			return;
+		}
+
+		volmeter->last_update_ns = now;
+		memcpy(volmeter->magnitude, volmeter->held_magnitude, sizeof(volmeter->magnitude));
+		memcpy(volmeter->peak, volmeter->held_peak, sizeof(volmeter->peak));
+		memset(volmeter->held_magnitude, 0, sizeof(volmeter->held_magnitude));
+		memset(volmeter->held_peak, 0, sizeof(volmeter->held_peak));
+	}
+
 	// Adjust magnitude/peak based on the volume level set by the user.
 	// And convert to dB.
 	mul = muted && !obs_source_muted(source) ? 0.0f : db_to_mul(volmeter->cur_db);
@@ -817,6 +863,25 @@ void obs_volmeter_set_peak_meter_type(obs_volmeter_t *volmeter, enum obs_peak_me
 	pthread_mutex_unlock(&volmeter->mutex);
 }
 
+void obs_volmeter_set_update_interval(obs_volmeter_t *volmeter, const unsigned int ms)
+{
+	pthread_mutex_lock(&volmeter->mutex);
+	volmeter->update_ms = ms;
+	volmeter->last_update_ns = 0;
+	memset(volmeter->held_magnitude, 0, sizeof(volmeter->held_magnitude));
+	memset(volmeter->held_peak, 0, sizeof(volmeter->held_peak));
+	pthread_mutex_unlock(&volmeter->mutex);
+}
+
+unsigned int obs_volmeter_get_update_interval(obs_volmeter_t *volmeter)
+{
+	pthread_mutex_lock(&volmeter->mutex);
+	unsigned int interval_ms = volmeter->update_ms;
+	pthread_mutex_unlock(&volmeter->mutex);
+
+	return interval_ms;
+}
+
 int obs_volmeter_get_nr_channels(obs_volmeter_t *volmeter)
 {
 	int source_nr_audio_channels;
@@ -225,6 +225,25 @@ EXPORT void obs_volmeter_detach_source(obs_volmeter_t *volmeter);
  */
 EXPORT void obs_volmeter_set_peak_meter_type(obs_volmeter_t *volmeter, enum obs_peak_meter_type peak_meter_type);
 
+/**
+ * @brief Set the update interval for the volume meter
+ * @param volmeter pointer to the volume meter object
+ * @param ms update interval in milliseconds
+ *
+ * When non-zero, the volume meter holds the peak/magnitude envelope over
+ * the audio blocks within the interval and only invokes the callbacks once
+ * per interval instead of once per audio block.  Zero (the default)
+ * invokes the callbacks for every audio block.
+ */
+EXPORT void obs_volmeter_set_update_interval(obs_volmeter_t *volmeter, const unsigned int ms);
+
+/**
+ * @brief Get the update interval of the volume meter
+ * @param volmeter pointer to the volume meter object
+ * @return update interval in milliseconds
+ */
+EXPORT unsigned int obs_volmeter_get_update_interval(obs_volmeter_t *volmeter);
+
 /**
  * @brief Get the number of channels which are configured for this source.
  * @param volmeter pointer to the volume meter object
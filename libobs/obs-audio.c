@@ -131,7 +131,7 @@ static bool ignore_audio(obs_source_t *source, size_t channels, size_t sample_ra
 
 	source->audio_pending = true;
 	source->audio_ts = 0;
-	/* tell the timestamp adjustment code in source_output_audio_data to
+	/* tell the timestamp adjustment code in source_process_audio_data to
 	 * reset everything, and hopefully fix the timestamps */
 	source->timing_set = false;
 	return false;
@@ -448,6 +448,84 @@ static inline void release_audio_sources(struct obs_core_audio *audio)
 		obs_source_release(audio->render_order.array[i]);
 }
 
+static const char *audio_tick_stage_names[AUDIO_TICK_STAGES] = {
+	"tree", "render", "sync", "mix", "discard", "tasks",
+};
+
+static inline void watchdog_mark(struct obs_core_audio *audio, enum audio_tick_stage stage, uint64_t *stage_start)
+{
+	uint64_t now = os_gettime_ns();
+	audio->tick_stage_ns[stage] = now - *stage_start;
+	*stage_start = now;
+}
+
+static void watchdog_track_source(struct obs_core_audio *audio, obs_source_t *source, uint64_t dur)
+{
+	/* unlocked read only filters the common case; re-checked below */
+	if (dur <= audio->tick_culprit_ns)
+		return;
+
+	pthread_mutex_lock(&audio->tick_culprit_mutex);
+	if (dur > audio->tick_culprit_ns) {
+		audio->tick_culprit_ns = dur;
+		snprintf(audio->tick_culprit_name, sizeof(audio->tick_culprit_name), "%s",
+			 obs_source_get_name(source));
+	}
+	pthread_mutex_unlock(&audio->tick_culprit_mutex);
+}
+
+static inline void render_audio_source_timed(struct obs_core_audio *audio, obs_source_t *source, uint32_t mixers,
+					     size_t channels, size_t sample_rate, size_t audio_size)
+{
+	uint64_t start = os_gettime_ns();
+	obs_source_audio_render(source, mixers, channels, sample_rate, audio_size);
+	watchdog_track_source(audio, source, os_gettime_ns() - start);
+}
+
+static void audio_tick_watchdog_check(struct obs_core_audio *audio, size_t sample_rate)
+{
+	uint64_t budget = util_mul_div64(AUDIO_OUTPUT_FRAMES, 1000000000ULL, sample_rate);
+	enum audio_tick_stage worst = AUDIO_TICK_TREE;
+	uint64_t total = 0;
+	uint64_t now;
+
+	for (size_t i = 0; i < AUDIO_TICK_STAGES; i++) {
+		total += audio->tick_stage_ns[i];
+		if (audio->tick_stage_ns[i] > audio->tick_stage_worst_ns[i])
+			audio->tick_stage_worst_ns[i] = audio->tick_stage_ns[i];
+		if (audio->tick_stage_ns[i] > audio->tick_stage_ns[worst])
+			worst = (enum audio_tick_stage)i;
+	}
+
+	if (total <= budget)
+		return;
+
+	audio->tick_overruns++;
+
+	struct calldata data;
+	uint8_t stack[512];
+
+	calldata_init_fixed(&data, stack, sizeof(stack));
+	calldata_set_string(&data, "stage", audio_tick_stage_names[worst]);
+	calldata_set_float(&data, "total_ms", (double)total / 1000000.0);
+	calldata_set_float(&data, "budget_ms", (double)budget / 1000000.0);
+	calldata_set_string(&data, "culprit", audio->tick_culprit_name);
+	calldata_set_float(&data, "culprit_ms", (double)audio->tick_culprit_ns / 1000000.0);
+	signal_handler_signal(obs->signals, "audio_tick_overrun", &data);
+
+	now = os_gettime_ns();
+	if (now - audio->tick_last_warn_ns >= 1000000000ULL) {
+		audio->tick_last_warn_ns = now;
+		blog(LOG_WARNING,
+		     "Audio tick overrun #%" PRIu64 ": %.02f ms of "
+		     "%.02f ms budget, worst stage: %s (%.02f ms), "
+		     "worst source: '%s' (%.02f ms)",
+		     audio->tick_overruns, (double)total / 1000000.0, (double)budget / 1000000.0,
+		     audio_tick_stage_names[worst], (double)audio->tick_stage_ns[worst] / 1000000.0,
+		     audio->tick_culprit_name, (double)audio->tick_culprit_ns / 1000000.0);
+	}
+}
+
 static inline void execute_audio_tasks(void)
 {
 	struct obs_core_audio *audio = &obs->audio;
@@ -465,6 +543,82 @@ static inline void execute_audio_tasks(void)
 	}
 }
 
+/* renders sources without an audio_render callback (leaves of the audio
+ * tree); composite sources consume their children's buffers and are
+ * rendered serially afterwards */
+static void render_leaf_audio_sources(struct obs_core_audio *audio)
+{
+	long i;
+
+	while ((i = os_atomic_inc_long(&audio->mix_next_idx) - 1) < (long)audio->render_order.num) {
+		obs_source_t *source = audio->render_order.array[i];
+
+		if (!source->info.audio_render)
+			render_audio_source_timed(audio, source, audio->mix_pass_mixers, audio->mix_pass_channels,
+						  audio->mix_pass_sample_rate, audio->mix_pass_audio_size);
+	}
+}
+
+static void *audio_mix_worker(void *param)
+{
+	struct obs_core_audio *audio = param;
+
+	os_set_thread_name("libobs: audio mix worker");
+
+	for (;;) {
+		os_sem_wait(audio->mix_start_sem);
+		if (!os_atomic_load_bool(&audio->mix_workers_active))
+			break;
+
+		render_leaf_audio_sources(audio);
+		os_sem_post(audio->mix_done_sem);
+	}
+
+	return NULL;
+}
+
+bool obs_init_audio_mix_threads(uint32_t count)
+{
+	struct obs_core_audio *audio = &obs->audio;
+
+	if (os_sem_init(&audio->mix_start_sem, 0) != 0)
+		return false;
+	if (os_sem_init(&audio->mix_done_sem, 0) != 0)
+		return false;
+
+	os_atomic_set_bool(&audio->mix_workers_active, true);
+
+	for (uint32_t i = 0; i < count; i++) {
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, audio_mix_worker, audio) != 0)
+			return false;
+		da_push_back(audio->mix_workers, &thread);
+	}
+
+	blog(LOG_INFO, "Parallel audio rendering enabled with %u worker thread(s)", count);
+	return true;
+}
+
+void obs_free_audio_mix_threads(void)
+{
+	struct obs_core_audio *audio = &obs->audio;
+
+	if (!audio->mix_workers.num)
+		return;
+
+	os_atomic_set_bool(&audio->mix_workers_active, false);
+	for (size_t i = 0; i < audio->mix_workers.num; i++)
+		os_sem_post(audio->mix_start_sem);
+	for (size_t i = 0; i < audio->mix_workers.num; i++)
+		pthread_join(audio->mix_workers.array[i], NULL);
+
+	da_free(audio->mix_workers);
+	os_sem_destroy(audio->mix_start_sem);
+	os_sem_destroy(audio->mix_done_sem);
+	audio->mix_start_sem = NULL;
+	audio->mix_done_sem = NULL;
+}
+
 bool audio_callback(void *param, uint64_t start_ts_in, uint64_t end_ts_in, uint64_t *out_ts, uint32_t mixers,
 		    struct audio_output_data *mixes)
 {
@@ -476,6 +630,10 @@ bool audio_callback(void *param, uint64_t start_ts_in, uint64_t end_ts_in, uint6
 	struct ts_info ts = {start_ts_in, end_ts_in};
 	size_t audio_size;
 	uint64_t min_ts;
+	uint64_t stage_start = os_gettime_ns();
+
+	audio->tick_culprit_ns = 0;
+	audio->tick_culprit_name[0] = 0;
 
 	da_resize(audio->render_order, 0);
 	da_resize(audio->root_nodes, 0);
@@ -490,6 +648,19 @@ bool audio_callback(void *param, uint64_t start_ts_in, uint64_t end_ts_in, uint6
 	blog(LOG_DEBUG, "ts %llu-%llu", ts.start, ts.end);
 #endif
 
+	/* ------------------------------------------------ */
+	/* drain audio handed off by capture threads */
+
+	pthread_mutex_lock(&data->audio_sources_mutex);
+
+	source = data->first_audio_source;
+	while (source) {
+		obs_source_drain_pending_audio(source);
+		source = (struct obs_source *)source->next_audio_source;
+	}
+
+	pthread_mutex_unlock(&data->audio_sources_mutex);
+
 	/* ------------------------------------------------ */
 	/* build audio render order */
 
@@ -529,11 +700,32 @@ bool audio_callback(void *param, uint64_t start_ts_in, uint64_t end_ts_in, uint6
 
 	pthread_mutex_unlock(&data->audio_sources_mutex);
 
+	watchdog_mark(audio, AUDIO_TICK_TREE, &stage_start);
+
 	/* ------------------------------------------------ */
 	/* render audio data */
+	const bool parallel = audio->mix_workers.num > 0 && audio->render_order.num > 1;
+
+	if (parallel) {
+		audio->mix_pass_mixers = mixers;
+		audio->mix_pass_channels = channels;
+		audio->mix_pass_sample_rate = sample_rate;
+		audio->mix_pass_audio_size = audio_size;
+		os_atomic_set_long(&audio->mix_next_idx, 0);
+
+		for (size_t i = 0; i < audio->mix_workers.num; i++)
+			os_sem_post(audio->mix_start_sem);
+
+		render_leaf_audio_sources(audio);
+
+		for (size_t i = 0; i < audio->mix_workers.num; i++)
+			os_sem_wait(audio->mix_done_sem);
+	}
+
 	for (size_t i = 0; i < audio->render_order.num; i++) {
 		obs_source_t *source = audio->render_order.array[i];
-		obs_source_audio_render(source, mixers, channels, sample_rate, audio_size);
+		if (!parallel || source->info.audio_render)
+			render_audio_source_timed(audio, source, mixers, channels, sample_rate, audio_size);
 
 		/* if a source has gone backward in time and we can no
 		 * longer buffer, drop some or all of its audio */
@@ -557,11 +749,14 @@ bool audio_callback(void *param, uint64_t start_ts_in, uint64_t end_ts_in, uint6
 
 				/* if we (potentially) recovered, re-render */
 				if (rerender)
-					obs_source_audio_render(source, mixers, channels, sample_rate, audio_size);
+					render_audio_source_timed(audio, source, mixers, channels, sample_rate,
+								  audio_size);
 			}
 		}
 	}
 
+	watchdog_mark(audio, AUDIO_TICK_RENDER, &stage_start);
+
 	/* ------------------------------------------------ */
 	/* get minimum audio timestamp */
 	pthread_mutex_lock(&data->audio_sources_mutex);
@@ -578,6 +773,8 @@ bool audio_callback(void *param, uint64_t start_ts_in, uint64_t end_ts_in, uint6
 		add_audio_buffering(audio, sample_rate, &ts, min_ts, buffering_name);
 	}
 
+	watchdog_mark(audio, AUDIO_TICK_SYNC, &stage_start);
+
 	/* ------------------------------------------------ */
 	/* mix audio */
 	if (!audio->buffering_wait_ticks) {
@@ -596,6 +793,8 @@ bool audio_callback(void *param, uint64_t start_ts_in, uint64_t end_ts_in, uint6
 		}
 	}
 
+	watchdog_mark(audio, AUDIO_TICK_MIX, &stage_start);
+
 	/* ------------------------------------------------ */
 	/* discard audio */
 	pthread_mutex_lock(&data->audio_sources_mutex);
@@ -615,17 +814,24 @@ bool audio_callback(void *param, uint64_t start_ts_in, uint64_t end_ts_in, uint6
 	/* release audio sources */
 	release_audio_sources(audio);
 
+	watchdog_mark(audio, AUDIO_TICK_DISCARD, &stage_start);
+
 	deque_pop_front(&audio->buffered_timestamps, NULL, sizeof(ts));
 
 	*out_ts = ts.start;
 
 	if (audio->buffering_wait_ticks) {
 		audio->buffering_wait_ticks--;
+		audio->tick_stage_ns[AUDIO_TICK_TASKS] = 0;
+		audio_tick_watchdog_check(audio, sample_rate);
 		return false;
 	}
 
 	execute_audio_tasks();
 
+	watchdog_mark(audio, AUDIO_TICK_TASKS, &stage_start);
+	audio_tick_watchdog_check(audio, sample_rate);
+
 	UNUSED_PARAMETER(param);
 	return true;
 }
@@ -19,6 +19,7 @@
 #include "obs.h"
 #include "obs-internal.h"
 
+#include <float.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/sysctl.h>
@@ -426,6 +427,7 @@ struct obs_hotkeys_platform {
     TISInputSourceRef tis;
     CFDataRef layout_data;
     UCKeyboardLayout *layout;
+    CFTimeInterval last_input_seconds;
 };
 
 // MARK: macOS Hotkey Implementation
@@ -591,6 +593,7 @@ bool obs_hotkeys_platform_init(struct obs_core_hotkeys *hotkeys)
                                     CFNotificationSuspensionBehaviorDeliverImmediately);
 
     obs_hotkeys_platform_t *platform = bzalloc(sizeof(obs_hotkeys_platform_t));
+    platform->last_input_seconds = DBL_MAX;
 
     const bool has_event_access = CGPreflightListenEventAccess();
     if (has_event_access) {
@@ -708,6 +711,22 @@ bool obs_hotkeys_platform_is_pressed(obs_hotkeys_platform_t *platform, obs_key_t
     return platform->is_key_down[key];
 }
 
+bool obs_hotkeys_platform_input_since_last(obs_hotkeys_platform_t *platform)
+{
+    if (!platform) {
+        return true;
+    }
+
+    /* grows monotonically while idle and resets to ~0 on any HID event,
+     * so a decrease means input arrived since the previous call */
+    CFTimeInterval seconds =
+        CGEventSourceSecondsSinceLastEventType(kCGEventSourceStateHIDSystemState, kCGAnyInputEventType);
+    bool input = seconds < platform->last_input_seconds;
+
+    platform->last_input_seconds = seconds;
+    return input;
+}
+
 static void unichar_to_utf8(const UniChar *character, char *buffer)
 {
     CFStringRef string = CFStringCreateWithCharactersNoCopy(NULL, character, 2, kCFAllocatorNull);
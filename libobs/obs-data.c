@@ -33,6 +33,7 @@ struct obs_data_item {
 	volatile long ref;
 	const char *name;
 	struct obs_data *parent;
+	struct obs_data_arena *arena;
 	UT_hash_handle hh;
 	enum obs_data_type type;
 	size_t name_len;
@@ -48,10 +49,18 @@ struct obs_data {
 	volatile long ref;
 	char *json;
 	struct obs_data_item *items;
+	struct obs_data_arena *arena;
+
+	/* incremented on every mutation; lets serialization skip subtrees
+	 * that have not changed since they were last serialized */
+	uint64_t version;
+	char *json_cache;
+	uint64_t json_cache_sig;
 };
 
 struct obs_data_array {
 	volatile long ref;
+	uint64_t version;
 	DARRAY(obs_data_t *) objects;
 };
 
@@ -63,6 +72,133 @@ struct obs_data_number {
 	};
 };
 
+/* ------------------------------------------------------------------------- */
+/* Arena allocation: a document loaded from JSON consists of thousands of
+ * tiny, similarly-lived allocations (one per item plus one per sub-object),
+ * so arena-backed documents carve them out of large shared blocks instead.
+ * The arena is refcounted by its live allocations: objects and items can
+ * still be detached from the document and outlive the root, and the blocks
+ * are returned in bulk once the last of them is released.  Small frees go
+ * onto per-size-class free lists so that settings mutated after load reuse
+ * their own document's memory. */
+
+struct obs_data_arena_block {
+	struct obs_data_arena_block *next;
+	size_t size;
+	size_t used;
+};
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_BUCKET_STEP 64
+#define ARENA_NUM_BUCKETS 8
+#define ARENA_MAX_BUCKET_SIZE (ARENA_BUCKET_STEP * ARENA_NUM_BUCKETS)
+
+struct obs_data_arena {
+	volatile long refs;
+	pthread_mutex_t mutex;
+	struct obs_data_arena_block *blocks;
+	void *free_lists[ARENA_NUM_BUCKETS];
+};
+
+/* the header is padded to one bucket step so that carved allocations keep
+ * base_get_alignment() (allocation sizes are all bucket-step multiples) */
+static inline uint8_t *arena_block_data(struct obs_data_arena_block *block)
+{
+	return (uint8_t *)block + ARENA_BUCKET_STEP;
+}
+
+static struct obs_data_arena *obs_data_arena_create(void)
+{
+	struct obs_data_arena *arena = bzalloc(sizeof(struct obs_data_arena));
+	pthread_mutex_init_value(&arena->mutex);
+	return arena;
+}
+
+static void obs_data_arena_destroy(struct obs_data_arena *arena)
+{
+	struct obs_data_arena_block *block = arena->blocks;
+
+	while (block) {
+		struct obs_data_arena_block *next = block->next;
+		bfree(block);
+		block = next;
+	}
+
+	pthread_mutex_destroy(&arena->mutex);
+	bfree(arena);
+}
+
+static inline void obs_data_arena_release(struct obs_data_arena *arena)
+{
+	if (os_atomic_dec_long(&arena->refs) == 0)
+		obs_data_arena_destroy(arena);
+}
+
+/* sizes at or below ARENA_MAX_BUCKET_SIZE are rounded up to a size class
+ * so that freed allocations can be reused; anything larger is bump-only
+ * and reclaimed when the arena dies */
+static inline size_t arena_bucket(size_t size)
+{
+	return (size - 1) / ARENA_BUCKET_STEP;
+}
+
+static void *obs_data_arena_alloc(struct obs_data_arena *arena, size_t size)
+{
+	struct obs_data_arena_block *block;
+	void *ptr = NULL;
+
+	if (size <= ARENA_MAX_BUCKET_SIZE)
+		size = (arena_bucket(size) + 1) * ARENA_BUCKET_STEP;
+	else
+		size = (size + ARENA_BUCKET_STEP - 1) & ~(size_t)(ARENA_BUCKET_STEP - 1);
+
+	pthread_mutex_lock(&arena->mutex);
+
+	if (size <= ARENA_MAX_BUCKET_SIZE) {
+		void **list = &arena->free_lists[arena_bucket(size)];
+		if (*list) {
+			ptr = *list;
+			*list = *(void **)ptr;
+		}
+	}
+
+	if (!ptr) {
+		block = arena->blocks;
+		if (!block || block->size - block->used < size) {
+			size_t block_size = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+
+			block = bmalloc(ARENA_BUCKET_STEP + block_size);
+			block->size = block_size;
+			block->used = 0;
+			block->next = arena->blocks;
+			arena->blocks = block;
+		}
+
+		ptr = arena_block_data(block) + block->used;
+		block->used += size;
+	}
+
+	pthread_mutex_unlock(&arena->mutex);
+
+	os_atomic_inc_long(&arena->refs);
+	memset(ptr, 0, size);
+	return ptr;
+}
+
+static void obs_data_arena_free(struct obs_data_arena *arena, void *ptr, size_t size)
+{
+	if (size <= ARENA_MAX_BUCKET_SIZE) {
+		void **list = &arena->free_lists[arena_bucket(size)];
+
+		pthread_mutex_lock(&arena->mutex);
+		*(void **)ptr = *list;
+		*list = ptr;
+		pthread_mutex_unlock(&arena->mutex);
+	}
+
+	obs_data_arena_release(arena);
+}
+
 /* ------------------------------------------------------------------------- */
 /* Item structure, designed to be one allocation only */
 
@@ -261,8 +397,9 @@ static inline void item_autoselect_data_addref(struct obs_data_item *item)
 	}
 }
 
-static struct obs_data_item *obs_data_item_create(const char *name, const void *data, size_t size,
-						  enum obs_data_type type, bool default_data, bool autoselect_data)
+static struct obs_data_item *obs_data_item_create(struct obs_data_arena *arena, const char *name, const void *data,
+						  size_t size, enum obs_data_type type, bool default_data,
+						  bool autoselect_data)
 {
 	struct obs_data_item *item;
 	size_t name_size, total_size;
@@ -273,8 +410,9 @@ static struct obs_data_item *obs_data_item_create(const char *name, const void *
 	name_size = get_name_align_size(name);
 	total_size = name_size + sizeof(struct obs_data_item) + size;
 
-	item = bzalloc(total_size);
+	item = arena ? obs_data_arena_alloc(arena, total_size) : bzalloc(total_size);
 
+	item->arena = arena;
 	item->capacity = total_size;
 	item->type = type;
 	item->name_len = name_size;
@@ -305,6 +443,7 @@ static struct obs_data_item *obs_data_item_create(const char *name, const void *
 static inline void obs_data_item_detach(struct obs_data_item *item)
 {
 	if (item->parent) {
+		item->parent->version++;
 		HASH_DEL(item->parent->items, item);
 		item->parent = NULL;
 	}
@@ -329,7 +468,13 @@ static struct obs_data_item *obs_data_item_ensure_capacity(struct obs_data_item
 	struct obs_data *parent = item->parent;
 	obs_data_item_detach(item);
 
-	new_item = brealloc(item, new_size);
+	if (item->arena) {
+		new_item = obs_data_arena_alloc(item->arena, new_size);
+		memcpy(new_item, item, item->capacity);
+		obs_data_arena_free(item->arena, item, item->capacity);
+	} else {
+		new_item = brealloc(item, new_size);
+	}
 	new_item->capacity = new_size;
 	new_item->name = get_item_name(new_item);
 
@@ -347,7 +492,10 @@ static inline void obs_data_item_destroy(struct obs_data_item *item)
 	item_default_data_release(item);
 	item_autoselect_data_release(item);
 	obs_data_item_detach(item);
-	bfree(item);
+	if (item->arena)
+		obs_data_arena_free(item->arena, item, item->capacity);
+	else
+		bfree(item);
 }
 
 static inline void move_data(obs_data_item_t *old_item, void *old_data, obs_data_item_t *item, void *data, size_t len)
@@ -452,9 +600,16 @@ static inline void obs_data_add_json_object_data(obs_data_t *data, json_t *jobj)
 	}
 }
 
+static obs_data_t *obs_data_create_in_arena(struct obs_data_arena *arena);
+
+static inline obs_data_t *obs_data_create_sub(obs_data_t *parent)
+{
+	return parent->arena ? obs_data_create_in_arena(parent->arena) : obs_data_create();
+}
+
 static inline void obs_data_add_json_object(obs_data_t *data, const char *key, json_t *jobj)
 {
-	obs_data_t *sub_obj = obs_data_create();
+	obs_data_t *sub_obj = obs_data_create_sub(data);
 
 	obs_data_add_json_object_data(sub_obj, jobj);
 	obs_data_set_obj(data, key, sub_obj);
@@ -473,7 +628,7 @@ static void obs_data_add_json_array(obs_data_t *data, const char *key, json_t *j
 		if (!json_is_object(jitem))
 			continue;
 
-		item = obs_data_create();
+		item = obs_data_create_sub(data);
 		obs_data_add_json_object_data(item, jitem);
 		obs_data_array_push_back(array, item);
 		obs_data_release(item);
@@ -583,6 +738,185 @@ static json_t *obs_data_to_json(obs_data_t *data, bool with_defaults)
 	return json;
 }
 
+/* ------------------------------------------------------------------------- */
+/*
+ * Incremental serialization: every obs_data/obs_data_array bumps a version
+ * counter when mutated, and each object caches its last compact
+ * (non-default) JSON text together with a signature of its subtree's
+ * version counters.  Serializing a large settings tree then only walks the
+ * version counters of unchanged subtrees and re-encodes the parts that
+ * actually changed, instead of rebuilding a full jansson tree on every
+ * save.  Pretty/with-defaults output is cold and keeps the jansson path.
+ */
+
+static inline uint64_t signature_mix(uint64_t sig, uint64_t val)
+{
+	return (sig ^ val) * 1099511628211ULL;
+}
+
+static uint64_t obs_data_subtree_signature(obs_data_t *data);
+
+static uint64_t obs_data_array_subtree_signature(obs_data_array_t *array)
+{
+	uint64_t sig = signature_mix(14695981039346656037ULL, array->version);
+
+	for (size_t i = 0; i < array->objects.num; i++)
+		sig = signature_mix(sig, obs_data_subtree_signature(array->objects.array[i]));
+
+	return sig;
+}
+
+static uint64_t obs_data_subtree_signature(obs_data_t *data)
+{
+	uint64_t sig = signature_mix(14695981039346656037ULL, data->version);
+
+	obs_data_item_t *item = NULL;
+	obs_data_item_t *temp = NULL;
+
+	HASH_ITER (hh, data->items, item, temp) {
+		if (!item->data_size)
+			continue;
+
+		if (item->type == OBS_DATA_OBJECT) {
+			obs_data_t **obj = get_item_data(item);
+
+			if (obj && *obj)
+				sig = signature_mix(sig, obs_data_subtree_signature(*obj));
+
+		} else if (item->type == OBS_DATA_ARRAY) {
+			obs_data_array_t **array = get_item_data(item);
+
+			if (array && *array)
+				sig = signature_mix(sig, obs_data_array_subtree_signature(*array));
+		}
+	}
+
+	return sig;
+}
+
+static void obs_data_serialize_compact(struct dstr *out, obs_data_t *data);
+
+static void serialize_json_string(struct dstr *out, const char *str)
+{
+	static const char hex[] = "0123456789abcdef";
+
+	dstr_cat_ch(out, '"');
+
+	for (const char *c = str; *c; c++) {
+		unsigned char ch = (unsigned char)*c;
+
+		if (ch == '"') {
+			dstr_cat(out, "\\\"");
+		} else if (ch == '\\') {
+			dstr_cat(out, "\\\\");
+		} else if (ch == '\b') {
+			dstr_cat(out, "\\b");
+		} else if (ch == '\f') {
+			dstr_cat(out, "\\f");
+		} else if (ch == '\n') {
+			dstr_cat(out, "\\n");
+		} else if (ch == '\r') {
+			dstr_cat(out, "\\r");
+		} else if (ch == '\t') {
+			dstr_cat(out, "\\t");
+		} else if (ch < 0x20) {
+			char esc[7] = {'\\', 'u', '0', '0', hex[ch >> 4], hex[ch & 0xF], 0};
+			dstr_cat(out, esc);
+		} else {
+			dstr_cat_ch(out, *c);
+		}
+	}
+
+	dstr_cat_ch(out, '"');
+}
+
+static void serialize_json_number(struct dstr *out, obs_data_item_t *item)
+{
+	if (obs_data_item_numtype(item) == OBS_DATA_NUM_INT) {
+		dstr_catf(out, "%lld", obs_data_item_get_int(item));
+	} else {
+		struct dstr num = {0};
+
+		dstr_printf(&num, "%.17g", obs_data_item_get_double(item));
+
+		/* keep reals distinguishable from integers on round-trip */
+		if (!strpbrk(num.array, ".eE"))
+			dstr_cat(&num, ".0");
+
+		dstr_cat_dstr(out, &num);
+		dstr_free(&num);
+	}
+}
+
+static void serialize_array_compact(struct dstr *out, obs_data_array_t *array)
+{
+	dstr_cat_ch(out, '[');
+
+	for (size_t i = 0; i < array->objects.num; i++) {
+		if (i)
+			dstr_cat_ch(out, ',');
+		obs_data_serialize_compact(out, array->objects.array[i]);
+	}
+
+	dstr_cat_ch(out, ']');
+}
+
+static void obs_data_serialize_compact(struct dstr *out, obs_data_t *data)
+{
+	uint64_t sig = obs_data_subtree_signature(data);
+	bool first = true;
+	size_t start;
+
+	if (data->json_cache && data->json_cache_sig == sig) {
+		dstr_cat(out, data->json_cache);
+		return;
+	}
+
+	obs_data_item_t *item = NULL;
+	obs_data_item_t *temp = NULL;
+
+	start = out->len;
+	dstr_cat_ch(out, '{');
+
+	HASH_ITER (hh, data->items, item, temp) {
+		enum obs_data_type type = obs_data_item_gettype(item);
+
+		if (!obs_data_item_has_user_value(item))
+			continue;
+		if (type == OBS_DATA_NULL)
+			continue;
+
+		if (!first)
+			dstr_cat_ch(out, ',');
+		first = false;
+
+		serialize_json_string(out, get_item_name(item));
+		dstr_cat_ch(out, ':');
+
+		if (type == OBS_DATA_STRING) {
+			serialize_json_string(out, obs_data_item_get_string(item));
+		} else if (type == OBS_DATA_NUMBER) {
+			serialize_json_number(out, item);
+		} else if (type == OBS_DATA_BOOLEAN) {
+			dstr_cat(out, obs_data_item_get_bool(item) ? "true" : "false");
+		} else if (type == OBS_DATA_OBJECT) {
+			obs_data_t *obj = obs_data_item_get_obj(item);
+			obs_data_serialize_compact(out, obj);
+			obs_data_release(obj);
+		} else if (type == OBS_DATA_ARRAY) {
+			obs_data_array_t *array = obs_data_item_get_array(item);
+			serialize_array_compact(out, array);
+			obs_data_array_release(array);
+		}
+	}
+
+	dstr_cat_ch(out, '}');
+
+	bfree(data->json_cache);
+	data->json_cache = bstrdup(out->array + start);
+	data->json_cache_sig = sig;
+}
+
 /* ------------------------------------------------------------------------- */
 
 obs_data_t *obs_data_create()
@@ -593,9 +927,23 @@ obs_data_t *obs_data_create()
 	return data;
 }
 
+static obs_data_t *obs_data_create_in_arena(struct obs_data_arena *arena)
+{
+	struct obs_data *data = obs_data_arena_alloc(arena, sizeof(struct obs_data));
+	data->arena = arena;
+	data->ref = 1;
+
+	return data;
+}
+
+obs_data_t *obs_data_create_arena(void)
+{
+	return obs_data_create_in_arena(obs_data_arena_create());
+}
+
 obs_data_t *obs_data_create_from_json(const char *json_string)
 {
-	obs_data_t *data = obs_data_create();
+	obs_data_t *data = obs_data_create_arena();
 
 	json_error_t error;
 	json_t *root = json_loads(json_string, JSON_REJECT_DUPLICATES, &error);
@@ -672,9 +1020,12 @@ static inline void obs_data_destroy(struct obs_data *data)
 		obs_data_item_release(&item);
 	}
 
-	/* NOTE: don't use bfree for json text, allocated by json */
-	free(data->json);
-	bfree(data);
+	bfree(data->json);
+	bfree(data->json_cache);
+	if (data->arena)
+		obs_data_arena_free(data->arena, data, sizeof(struct obs_data));
+	else
+		bfree(data);
 }
 
 void obs_data_release(obs_data_t *data)
@@ -691,20 +1042,50 @@ static const char *obs_data_get_json_internal(obs_data_t *data, bool pretty, boo
 	if (!data)
 		return NULL;
 
-	size_t flags = JSON_PRESERVE_ORDER;
+	bfree(data->json);
+	data->json = NULL;
 
-	if (pretty)
-		flags |= JSON_INDENT(4);
-	else
-		flags |= JSON_COMPACT;
+	if (!with_defaults) {
+		struct dstr str = {0};
+		obs_data_serialize_compact(&str, data);
 
-	/* NOTE: don't use libobs bfree for json text */
-	free(data->json);
-	data->json = NULL;
+		if (!pretty) {
+			data->json = str.array;
+			return data->json;
+		}
+
+		/* pretty output still benefits from the incremental
+		 * cache: re-indent the memoized compact text instead of
+		 * rebuilding a jansson tree from the whole data tree */
+		json_error_t error;
+		json_t *root = json_loads(str.array, 0, &error);
+		dstr_free(&str);
+
+		if (root) {
+			char *json = json_dumps(root, JSON_PRESERVE_ORDER | JSON_INDENT(4));
+			json_decref(root);
+
+			data->json = bstrdup(json);
+			free(json);
+			return data->json;
+		}
+	}
 
-	json_t *root = obs_data_to_json(data, with_defaults);
-	data->json = json_dumps(root, flags);
-	json_decref(root);
+	{
+		size_t flags = JSON_PRESERVE_ORDER;
+
+		if (pretty)
+			flags |= JSON_INDENT(4);
+		else
+			flags |= JSON_COMPACT;
+
+		json_t *root = obs_data_to_json(data, with_defaults);
+		char *json = json_dumps(root, flags);
+		json_decref(root);
+
+		data->json = bstrdup(json);
+		free(json);
+	}
 
 	return data->json;
 }
@@ -868,7 +1249,7 @@ static void set_item_data(struct obs_data *data, struct obs_data_item **item, co
 	obs_data_item_t *new_item = NULL;
 
 	if ((!item || !*item) && data) {
-		new_item = obs_data_item_create(name, ptr, size, type, default_data, autoselect_data);
+		new_item = obs_data_item_create(data->arena, name, ptr, size, type, default_data, autoselect_data);
 		new_item->parent = data;
 		HASH_ADD_STR(data->items, name, new_item);
 
@@ -879,6 +1260,11 @@ static void set_item_data(struct obs_data *data, struct obs_data_item **item, co
 	} else {
 		obs_data_item_setdata(item, ptr, size, type);
 	}
+
+	if (data)
+		data->version++;
+	else if (item && *item && (*item)->parent)
+		(*item)->parent->version++;
 }
 
 static inline void set_item(struct obs_data *data, obs_data_item_t **item, const char *name, const void *ptr,
@@ -936,7 +1322,7 @@ static void copy_obj(struct obs_data *data, const char *name, struct obs_data *o
 		     void (*callback)(obs_data_t *, const char *, obs_data_t *))
 {
 	if (obj) {
-		obs_data_t *new_obj = obs_data_create();
+		obs_data_t *new_obj = obs_data_create_sub(data);
 		obs_data_apply(new_obj, obj);
 		callback(data, name, new_obj);
 		obs_data_release(new_obj);
@@ -951,7 +1337,7 @@ static void copy_array(struct obs_data *data, const char *name, struct obs_data_
 		da_reserve(new_array->objects, array->objects.num);
 
 		for (size_t i = 0; i < array->objects.num; i++) {
-			obs_data_t *new_obj = obs_data_create();
+			obs_data_t *new_obj = obs_data_create_sub(data);
 			obs_data_t *obj = array->objects.array[i];
 
 			obs_data_apply(new_obj, obj);
@@ -1000,6 +1386,43 @@ void obs_data_apply(obs_data_t *target, obs_data_t *apply_data)
 	}
 }
 
+static inline void copy_item_default(struct obs_data *data, struct obs_data_item *item)
+{
+	const char *name = get_item_name(item);
+	void *ptr = get_item_default_data(item);
+
+	if (!item->default_size)
+		return;
+
+	if (item->type == OBS_DATA_OBJECT) {
+		obs_data_t **obj = ptr;
+
+		if (*obj)
+			copy_obj(data, name, *obj, obs_data_set_default_obj);
+
+	} else if (item->type == OBS_DATA_ARRAY) {
+		obs_data_array_t **array = ptr;
+
+		if (*array)
+			copy_array(data, name, *array, obs_data_set_default_array);
+
+	} else {
+		set_item_def(data, NULL, name, ptr, item->default_size, item->type);
+	}
+}
+
+void obs_data_apply_defaults(obs_data_t *target, obs_data_t *defaults_data)
+{
+	if (!target || !defaults_data || target == defaults_data)
+		return;
+
+	struct obs_data_item *item, *temp;
+
+	HASH_ITER (hh, defaults_data->items, item, temp) {
+		copy_item_default(target, item);
+	}
+}
+
 void obs_data_erase(obs_data_t *data, const char *name)
 {
 	struct obs_data_item *item = get_item(data, name);
@@ -1047,6 +1470,8 @@ void obs_data_clear(obs_data_t *target)
 	HASH_ITER (hh, target->items, item, temp) {
 		clear_item(item);
 	}
+
+	target->version++;
 }
 
 typedef void (*set_item_t)(obs_data_t *, obs_data_item_t **, const char *, const void *, size_t, enum obs_data_type);
@@ -1340,6 +1765,7 @@ size_t obs_data_array_push_back(obs_data_array_t *array, obs_data_t *obj)
 		return 0;
 
 	os_atomic_inc_long(&obj->ref);
+	array->version++;
 	return da_push_back(array->objects, &obj);
 }
 
@@ -1349,6 +1775,7 @@ void obs_data_array_insert(obs_data_array_t *array, size_t idx, obs_data_t *obj)
 		return;
 
 	os_atomic_inc_long(&obj->ref);
+	array->version++;
 	da_insert(array->objects, idx, &obj);
 }
 
@@ -1361,6 +1788,7 @@ void obs_data_array_push_back_array(obs_data_array_t *array, obs_data_array_t *a
 		obs_data_t *obj = array2->objects.array[i];
 		obs_data_addref(obj);
 	}
+	array->version++;
 	da_push_back_da(array->objects, array2->objects);
 }
 
@@ -1368,6 +1796,7 @@ void obs_data_array_erase(obs_data_array_t *array, size_t idx)
 {
 	if (array) {
 		obs_data_release(array->objects.array[idx]);
+		array->version++;
 		da_erase(array->objects, idx);
 	}
 }
@@ -1437,6 +1866,9 @@ void obs_data_item_unset_user_value(obs_data_item_t *item)
 	if (!item || !item->data_size)
 		return;
 
+	if (item->parent)
+		item->parent->version++;
+
 	void *old_non_user_data = get_default_data_ptr(item);
 
 	item_data_release(item);
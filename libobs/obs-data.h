@@ -58,6 +58,13 @@ enum obs_data_number_type { OBS_DATA_NUM_INVALID, OBS_DATA_NUM_INT, OBS_DATA_NUM
 /* Main usage functions */
 
 EXPORT obs_data_t *obs_data_create();
+
+/* Creates a data object backed by a private arena: the object, its items,
+ * and any sub-objects created while loading into it share bulk-allocated
+ * blocks, which are returned together once the last object or item carved
+ * from them is released.  Used by the JSON load paths. */
+EXPORT obs_data_t *obs_data_create_arena(void);
+
 EXPORT obs_data_t *obs_data_create_from_json(const char *json_string);
 EXPORT obs_data_t *obs_data_create_from_json_file(const char *json_file);
 EXPORT obs_data_t *obs_data_create_from_json_file_safe(const char *json_file, const char *backup_ext);
@@ -76,6 +83,9 @@ EXPORT bool obs_data_save_json_pretty_safe(obs_data_t *data, const char *file, c
 
 EXPORT void obs_data_apply(obs_data_t *target, obs_data_t *apply_data);
 
+/** Merges the default values of defaults_data in to target as defaults */
+EXPORT void obs_data_apply_defaults(obs_data_t *target, obs_data_t *defaults_data);
+
 EXPORT void obs_data_erase(obs_data_t *data, const char *name);
 EXPORT void obs_data_clear(obs_data_t *data);
 
@@ -231,6 +231,8 @@ void render_display(struct obs_display *display)
 
 	if (!display || !display->enabled)
 		return;
+	if (os_atomic_load_bool(&display->hidden))
+		return;
 
 	/* -------------------------------------------- */
 
@@ -264,10 +266,21 @@ void render_display(struct obs_display *display)
 
 		GS_DEBUG_MARKER_END();
 
-		gs_present();
+		display->present_pending = true;
 	}
 }
 
+void present_display(struct obs_display *display)
+{
+	if (!display || !display->present_pending)
+		return;
+
+	display->present_pending = false;
+
+	gs_load_swapchain(display->swap);
+	gs_present();
+}
+
 void obs_display_set_enabled(obs_display_t *display, bool enable)
 {
 	if (display)
@@ -279,6 +292,17 @@ bool obs_display_enabled(obs_display_t *display)
 	return display ? display->enabled : false;
 }
 
+void obs_display_set_hidden(obs_display_t *display, bool hidden)
+{
+	if (display)
+		os_atomic_set_bool(&display->hidden, hidden);
+}
+
+bool obs_display_hidden(obs_display_t *display)
+{
+	return display ? os_atomic_load_bool(&display->hidden) : false;
+}
+
 void obs_display_set_background_color(obs_display_t *display, uint32_t color)
 {
 	if (display)
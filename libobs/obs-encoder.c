@@ -28,6 +28,9 @@ static void encoder_set_video(obs_encoder_t *encoder, video_t *video);
 
 struct obs_encoder_info *find_encoder(const char *id)
 {
+	bool retried = false;
+
+retry:
 	for (size_t i = 0; i < obs->encoder_types.num; i++) {
 		struct obs_encoder_info *info = obs->encoder_types.array + i;
 
@@ -35,6 +38,11 @@ struct obs_encoder_info *find_encoder(const char *id)
 			return info;
 	}
 
+	if (!retried && obs_demand_load_module_type(OBS_OBJ_TYPE_ENCODER, id)) {
+		retried = true;
+		goto retry;
+	}
+
 	return NULL;
 }
 
@@ -400,6 +408,8 @@ void obs_encoder_destroy(obs_encoder_t *encoder)
 
 		if (encoder->context.data)
 			encoder->info.destroy(encoder->context.data);
+		if (encoder->motion_hints)
+			os_atomic_dec_long(&obs->video.motion_hint_encoders);
 		da_free(encoder->callbacks);
 		da_free(encoder->roi);
 		da_free(encoder->encoder_packet_times);
@@ -526,6 +536,25 @@ void obs_encoder_update(obs_encoder_t *encoder, obs_data_t *settings)
 	}
 }
 
+bool obs_encoder_reconfigure(obs_encoder_t *encoder, obs_data_t *settings)
+{
+	if (!obs_encoder_valid(encoder, "obs_encoder_reconfigure"))
+		return false;
+
+	/* inactive or uninitialized encoders can take any change */
+	if (!encoder->context.data || !encoder_active(encoder)) {
+		obs_encoder_update(encoder, settings);
+		return true;
+	}
+
+	if ((encoder->info.caps & OBS_ENCODER_CAP_RECONFIGURE) == 0 || !encoder->info.update)
+		return false;
+
+	obs_data_apply(encoder->context.settings, settings);
+	encoder->reconfigure_requested = true;
+	return true;
+}
+
 bool obs_encoder_get_extra_data(const obs_encoder_t *encoder, uint8_t **extra_data, size_t *size)
 {
 	if (!obs_encoder_valid(encoder, "obs_encoder_get_extra_data"))
@@ -1250,9 +1279,15 @@ static void send_first_video_packet(struct obs_encoder *encoder, struct encoder_
 	first_packet.data = data.array;
 	first_packet.size = data.num;
 
-	cb->new_packet(cb->param, &first_packet, packet_time);
+	/* consumers expect refcounted packet data (see
+	 * send_off_encoder_packet), so wrap the composed packet */
+	struct encoder_packet ref_packet;
+	obs_encoder_packet_create_instance(&ref_packet, &first_packet);
+
+	cb->new_packet(cb->param, &ref_packet, packet_time);
 	cb->sent_first_packet = true;
 
+	obs_encoder_packet_release(&ref_packet);
 	da_free(data);
 }
 
@@ -1336,16 +1371,24 @@ void send_off_encoder_packet(obs_encoder_t *encoder, bool success, bool received
 				     pkt->pts);
 		}
 
+		/* One refcounted copy of the encoder's transient buffer is
+		 * shared by every consumer; outputs take references instead
+		 * of copying the payload once per output. */
+		struct encoder_packet shared_pkt;
+		obs_encoder_packet_create_instance(&shared_pkt, pkt);
+
 		pthread_mutex_lock(&encoder->callbacks_mutex);
 
 		for (size_t i = encoder->callbacks.num; i > 0; i--) {
 			struct encoder_callback *cb;
 			cb = encoder->callbacks.array + (i - 1);
-			send_packet(encoder, cb, pkt, found_ept ? &ept_local : NULL);
+			send_packet(encoder, cb, &shared_pkt, found_ept ? &ept_local : NULL);
 		}
 
 		pthread_mutex_unlock(&encoder->callbacks_mutex);
 
+		obs_encoder_packet_release(&shared_pkt);
+
 		// Count number of video frames successfully encoded
 		if (pkt->type == OBS_ENCODER_VIDEO)
 			encoder->encoded_frames++;
@@ -1620,6 +1663,40 @@ static bool send_audio_data(struct obs_encoder *encoder)
 	return true;
 }
 
+/* Fast path: the audio tick delivered whole encoder frames and nothing
+ * is buffered, so submit them straight out of the mix buffer instead of
+ * round-tripping each one through audio_input_buffer.  With AAC's 1024
+ * sample frames matching AUDIO_OUTPUT_FRAMES this is the steady state,
+ * making audio framing copy-free for every track. */
+static void send_audio_data_direct(struct obs_encoder *encoder, struct audio_data *data)
+{
+	struct encoder_frame enc_frame;
+	size_t chunks = data->frames / encoder->framesize;
+	size_t sent = 0;
+
+	memset(&enc_frame, 0, sizeof(struct encoder_frame));
+
+	enc_frame.frames = (uint32_t)encoder->framesize;
+
+	while (sent < chunks) {
+		for (size_t i = 0; i < encoder->planes; i++) {
+			enc_frame.data[i] = data->data[i] + sent * encoder->framesize_bytes;
+			enc_frame.linesize[i] = (uint32_t)encoder->framesize_bytes;
+		}
+
+		enc_frame.pts = encoder->cur_pts;
+		sent++;
+
+		if (!do_encode(encoder, &enc_frame, NULL))
+			break;
+
+		encoder->cur_pts += encoder->framesize;
+	}
+
+	/* buffer any remaining tail for the normal path to pick up */
+	push_back_audio(encoder, data, data->frames * encoder->blocksize, sent * encoder->framesize_bytes);
+}
+
 static void pause_audio(struct pause_data *pause, struct audio_data *data, size_t sample_rate)
 {
 	uint64_t cutoff_frames = pause->ts_start - data->timestamp;
@@ -1702,6 +1779,13 @@ static void receive_audio(void *param, size_t mix_idx, struct audio_data *in)
 	if (audio_pause_check(&encoder->pause, &audio, encoder->samplerate))
 		goto end;
 
+	/* already started and no partial frame pending: frame-aligned
+	 * direct submission, no buffering needed */
+	if (encoder->start_ts && !encoder->audio_input_buffer[0].size && audio.frames >= encoder->framesize) {
+		send_audio_data_direct(encoder, &audio);
+		goto end;
+	}
+
 	if (!buffer_audio(encoder, &audio))
 		goto end;
 
@@ -2024,6 +2108,40 @@ uint32_t obs_encoder_get_roi_increment(const obs_encoder_t *encoder)
 	return encoder->roi_increment;
 }
 
+void obs_encoder_set_motion_hints_enabled(obs_encoder_t *encoder, bool enabled)
+{
+	if (!obs_encoder_valid(encoder, "obs_encoder_set_motion_hints_enabled"))
+		return;
+
+	if (encoder->info.type != OBS_ENCODER_VIDEO) {
+		blog(LOG_WARNING,
+		     "obs_encoder_set_motion_hints_enabled: "
+		     "encoder '%s' is not a video encoder",
+		     obs_encoder_get_name(encoder));
+		return;
+	}
+
+	if (encoder->motion_hints == enabled)
+		return;
+
+	encoder->motion_hints = enabled;
+
+	if (enabled) {
+		os_atomic_inc_long(&obs->video.motion_hint_encoders);
+	} else {
+		os_atomic_dec_long(&obs->video.motion_hint_encoders);
+		obs_encoder_clear_roi(encoder);
+	}
+}
+
+bool obs_encoder_get_motion_hints_enabled(const obs_encoder_t *encoder)
+{
+	if (!obs_encoder_valid(encoder, "obs_encoder_get_motion_hints_enabled"))
+		return false;
+
+	return encoder->motion_hints;
+}
+
 bool obs_encoder_set_group(obs_encoder_t *encoder, obs_encoder_group_t *group)
 {
 	if (!obs_encoder_valid(encoder, "obs_encoder_set_group"))
@@ -2072,6 +2190,47 @@ bool obs_encoder_set_group(obs_encoder_t *encoder, obs_encoder_group_t *group)
 	return true;
 }
 
+size_t obs_encoder_get_group_index(const obs_encoder_t *encoder)
+{
+	size_t idx = 0;
+
+	if (!obs_encoder_valid(encoder, "obs_encoder_get_group_index"))
+		return 0;
+
+	struct obs_encoder_group *group = encoder->encoder_group;
+	if (!group)
+		return 0;
+
+	pthread_mutex_lock(&group->mutex);
+	for (size_t i = 0; i < group->encoders.num; i++) {
+		if (group->encoders.array[i] == encoder) {
+			idx = i;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&group->mutex);
+
+	return idx;
+}
+
+size_t obs_encoder_get_group_size(const obs_encoder_t *encoder)
+{
+	size_t num;
+
+	if (!obs_encoder_valid(encoder, "obs_encoder_get_group_size"))
+		return 0;
+
+	struct obs_encoder_group *group = encoder->encoder_group;
+	if (!group)
+		return 0;
+
+	pthread_mutex_lock(&group->mutex);
+	num = group->encoders.num;
+	pthread_mutex_unlock(&group->mutex);
+
+	return num;
+}
+
 obs_encoder_group_t *obs_encoder_group_create()
 {
 	struct obs_encoder_group *group = bzalloc(sizeof(struct obs_encoder_group));
@@ -38,6 +38,7 @@ typedef struct obs_encoder obs_encoder_t;
 #define OBS_ENCODER_CAP_INTERNAL (1 << 3)
 #define OBS_ENCODER_CAP_ROI (1 << 4)
 #define OBS_ENCODER_CAP_SCALING (1 << 5)
+#define OBS_ENCODER_CAP_RECONFIGURE (1 << 6)
 
 /** Specifies the encoder type */
 enum obs_encoder_type {
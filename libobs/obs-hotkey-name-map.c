@@ -16,57 +16,12 @@
 ******************************************************************************/
 
 #include <string.h>
-#include <assert.h>
 
-#include <util/bmem.h>
 #include <util/c99defs.h>
+#include <util/threading.h>
 
 #include "obs-internal.h"
 
-struct obs_hotkey_name_map;
-
-typedef struct obs_hotkey_name_map_item obs_hotkey_name_map_item_t;
-
-struct obs_hotkey_name_map_item {
-	char *key;
-	int val;
-	UT_hash_handle hh;
-};
-
-static void obs_hotkey_name_map_insert(obs_hotkey_name_map_item_t **hmap, const char *key, int v)
-{
-	if (!hmap || !key)
-		return;
-
-	obs_hotkey_name_map_item_t *t;
-	HASH_FIND_STR(*hmap, key, t);
-	if (t)
-		return;
-
-	t = bzalloc(sizeof(obs_hotkey_name_map_item_t));
-	t->key = bstrdup(key);
-	t->val = v;
-
-	HASH_ADD_STR(*hmap, key, t);
-}
-
-static bool obs_hotkey_name_map_lookup(obs_hotkey_name_map_item_t *hmap, const char *key, int *v)
-{
-	if (!hmap || !key)
-		return false;
-
-	obs_hotkey_name_map_item_t *elem;
-
-	HASH_FIND_STR(hmap, key, elem);
-
-	if (elem) {
-		*v = elem->val;
-		return true;
-	}
-
-	return false;
-}
-
 static const char *obs_key_names[] = {
 #define OBS_HOTKEY(x) #x,
 #include "obs-hotkeys.h"
@@ -86,6 +41,35 @@ const char *obs_key_to_name(obs_key_t key)
 	return obs_key_names[key];
 }
 
+/* Open-addressed table of indices into obs_key_names: the names already
+ * live in static storage, so building the map is a single hashing pass
+ * with no allocations, and lookups cost one hash plus (usually) a
+ * single comparison. */
+#define NAME_MAP_SIZE (OBS_KEY_LAST_VALUE * 4)
+
+static uint16_t name_map[NAME_MAP_SIZE];
+static pthread_once_t name_map_once = PTHREAD_ONCE_INIT;
+
+static uint32_t hash_name(const char *name)
+{
+	uint32_t h = 2166136261u;
+	while (*name)
+		h = (h ^ (uint8_t)*name++) * 16777619u;
+	return h;
+}
+
+static void init_name_map(void)
+{
+	for (uint32_t i = 0; i < OBS_KEY_LAST_VALUE; i++) {
+		uint32_t slot = hash_name(obs_key_names[i]) % NAME_MAP_SIZE;
+		while (name_map[slot])
+			slot = (slot + 1) % NAME_MAP_SIZE;
+
+		/* offset by one so that zero marks an empty slot */
+		name_map[slot] = (uint16_t)(i + 1);
+	}
+}
+
 static obs_key_t obs_key_from_name_fallback(const char *name)
 {
 #define OBS_HOTKEY(x)              \
@@ -96,39 +80,21 @@ static obs_key_t obs_key_from_name_fallback(const char *name)
 	return OBS_KEY_NONE;
 }
 
-static void init_name_map(void)
-{
-#define OBS_HOTKEY(x) obs_hotkey_name_map_insert(&obs->hotkeys.name_map, #x, x);
-#include "obs-hotkeys.h"
-#undef OBS_HOTKEY
-}
-
 obs_key_t obs_key_from_name(const char *name)
 {
-	if (!obs)
-		return obs_key_from_name_fallback(name);
+	if (!name)
+		return OBS_KEY_NONE;
 
-	if (pthread_once(&obs->hotkeys.name_map_init_token, init_name_map))
+	if (pthread_once(&name_map_once, init_name_map))
 		return obs_key_from_name_fallback(name);
 
-	int v = 0;
-	if (obs_hotkey_name_map_lookup(obs->hotkeys.name_map, name, &v))
-		return v;
+	uint32_t slot = hash_name(name) % NAME_MAP_SIZE;
+	uint16_t idx;
+	while ((idx = name_map[slot]) != 0) {
+		if (strcmp(obs_key_names[idx - 1], name) == 0)
+			return (obs_key_t)(idx - 1);
+		slot = (slot + 1) % NAME_MAP_SIZE;
+	}
 
 	return OBS_KEY_NONE;
 }
-
-void obs_hotkey_name_map_free(void)
-{
-	if (!obs || !obs->hotkeys.name_map)
-		return;
-
-	obs_hotkey_name_map_item_t *root = obs->hotkeys.name_map;
-	obs_hotkey_name_map_item_t *n, *tmp;
-
-	HASH_ITER (hh, root, n, tmp) {
-		HASH_DEL(root, n);
-		bfree(n->key);
-		bfree(n);
-	}
-}
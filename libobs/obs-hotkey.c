@@ -136,13 +136,12 @@ void obs_hotkey_pair_set_descriptions(obs_hotkey_pair_id id, const char *desc0,
 
 static void hotkey_signal(const char *signal, obs_hotkey_t *hotkey)
 {
+	uint8_t stack[128];
 	calldata_t data;
-	calldata_init(&data);
+	calldata_init_fixed(&data, stack, sizeof(stack));
 	calldata_set_ptr(&data, "key", hotkey);
 
 	signal_handler_signal(obs->hotkeys.signals, signal, &data);
-
-	calldata_free(&data);
 }
 
 static inline void load_bindings(obs_hotkey_t *hotkey, obs_data_array_t *data);
@@ -1004,6 +1003,28 @@ static inline bool is_pressed(obs_key_t key)
 	return obs_hotkeys_platform_is_pressed(obs->hotkeys.platform_context, key);
 }
 
+/* per-poll key state cache: the hotkey thread visits every binding each
+ * pass, and multiple bindings often share a key; querying the platform
+ * (e.g. GetAsyncKeyState) once per distinct key per pass instead of once
+ * per binding keeps the 25 ms poll cheap with large binding counts */
+
+enum { KEY_STATE_UNKNOWN, KEY_STATE_UP, KEY_STATE_DOWN };
+
+struct obs_hotkey_key_cache {
+	uint8_t state[OBS_KEY_LAST_VALUE];
+};
+
+static inline bool is_pressed_cached(struct obs_hotkey_key_cache *cache, obs_key_t key)
+{
+	if (!cache || key < 0 || key >= OBS_KEY_LAST_VALUE)
+		return is_pressed(key);
+
+	if (cache->state[key] == KEY_STATE_UNKNOWN)
+		cache->state[key] = is_pressed(key) ? KEY_STATE_DOWN : KEY_STATE_UP;
+
+	return cache->state[key] == KEY_STATE_DOWN;
+}
+
 static inline void press_released_binding(obs_hotkey_binding_t *binding)
 {
 	binding->pressed = true;
@@ -1033,7 +1054,7 @@ static inline void release_pressed_binding(obs_hotkey_binding_t *binding)
 }
 
 static inline void handle_binding(obs_hotkey_binding_t *binding, uint32_t modifiers, bool no_press,
-				  bool strict_modifiers, bool *pressed)
+				  bool strict_modifiers, struct obs_hotkey_key_cache *key_cache, bool *pressed)
 {
 	bool modifiers_match_ = modifiers_match(binding, modifiers, strict_modifiers);
 	bool modifiers_only = binding->key.key == OBS_KEY_NONE;
@@ -1050,7 +1071,7 @@ static inline void handle_binding(obs_hotkey_binding_t *binding, uint32_t modifi
 	if ((!binding->modifiers_match && !modifiers_only) || !modifiers_match_)
 		goto reset;
 
-	if ((pressed && !*pressed) || (!pressed && !is_pressed(binding->key.key)))
+	if ((pressed && !*pressed) || (!pressed && !is_pressed_cached(key_cache, binding->key.key)))
 		goto reset;
 
 	if (binding->pressed || no_press)
@@ -1078,6 +1099,12 @@ static inline bool inject_hotkey(void *data, size_t idx, obs_hotkey_binding_t *b
 	UNUSED_PARAMETER(idx);
 	struct obs_hotkey_internal_inject *event = data;
 
+	/* injected events carry a single key; bindings for other keys
+	 * cannot be affected (OBS_KEY_NONE bindings react to modifiers
+	 * alone and are always considered) */
+	if (binding->key.key != event->hotkey.key && binding->key.key != OBS_KEY_NONE)
+		return true;
+
 	if (modifiers_match(binding, event->hotkey.modifiers, event->strict_modifiers)) {
 		bool pressed = binding->key.key == event->hotkey.key && event->pressed;
 		if (binding->key.key == OBS_KEY_NONE)
@@ -1120,6 +1147,7 @@ struct obs_query_hotkeys_helper {
 	uint32_t modifiers;
 	bool no_press;
 	bool strict_modifiers;
+	struct obs_hotkey_key_cache *key_cache;
 };
 
 static inline bool query_hotkey(void *data, size_t idx, obs_hotkey_binding_t *binding)
@@ -1127,31 +1155,62 @@ static inline bool query_hotkey(void *data, size_t idx, obs_hotkey_binding_t *bi
 	UNUSED_PARAMETER(idx);
 
 	struct obs_query_hotkeys_helper *param = (struct obs_query_hotkeys_helper *)data;
-	handle_binding(binding, param->modifiers, param->no_press, param->strict_modifiers, NULL);
+	handle_binding(binding, param->modifiers, param->no_press, param->strict_modifiers, param->key_cache, NULL);
 
 	return true;
 }
 
 static inline void query_hotkeys()
 {
+	struct obs_hotkey_key_cache key_cache = {0};
+
 	uint32_t modifiers = 0;
-	if (is_pressed(OBS_KEY_SHIFT))
+	if (is_pressed_cached(&key_cache, OBS_KEY_SHIFT))
 		modifiers |= INTERACT_SHIFT_KEY;
-	if (is_pressed(OBS_KEY_CONTROL))
+	if (is_pressed_cached(&key_cache, OBS_KEY_CONTROL))
 		modifiers |= INTERACT_CONTROL_KEY;
-	if (is_pressed(OBS_KEY_ALT))
+	if (is_pressed_cached(&key_cache, OBS_KEY_ALT))
 		modifiers |= INTERACT_ALT_KEY;
-	if (is_pressed(OBS_KEY_META))
+	if (is_pressed_cached(&key_cache, OBS_KEY_META))
 		modifiers |= INTERACT_COMMAND_KEY;
 
 	struct obs_query_hotkeys_helper param = {
 		modifiers,
 		obs->hotkeys.thread_disable_press,
 		obs->hotkeys.strict_modifiers,
+		&key_cache,
 	};
 	enum_bindings(query_hotkey, &param);
 }
 
+static inline bool binding_pressed(void *data, size_t idx, obs_hotkey_binding_t *binding)
+{
+	UNUSED_PARAMETER(idx);
+
+	bool *pressed = data;
+	if (binding->pressed) {
+		*pressed = true;
+		return false;
+	}
+
+	return true;
+}
+
+/* true when the platform saw no input since the previous wakeup and no
+ * binding is held down, i.e. a fresh query could not change anything */
+static inline bool query_hotkeys_skippable(void)
+{
+	bool pressed = false;
+
+	if (!obs->hotkeys.platform_context)
+		return false;
+	if (obs_hotkeys_platform_input_since_last(obs->hotkeys.platform_context))
+		return false;
+
+	enum_bindings(binding_pressed, &pressed);
+	return !pressed;
+}
+
 #define NBSP "\xC2\xA0"
 
 void *obs_hotkey_thread(void *arg)
@@ -1169,7 +1228,8 @@ void *obs_hotkey_thread(void *arg)
 			continue;
 
 		profile_start(hotkey_thread_name);
-		query_hotkeys();
+		if (!query_hotkeys_skippable())
+			query_hotkeys();
 		profile_end(hotkey_thread_name);
 
 		unlock();
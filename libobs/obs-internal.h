@@ -38,6 +38,7 @@
 #include "media-io/audio-io.h"
 
 #include "obs.h"
+#include "util/source-profiler.h"
 
 #include <obsversion.h>
 #include <caption/caption.h>
@@ -46,10 +47,16 @@
 #define HASH_FIND_UUID(head, uuid, out) HASH_FIND(hh_uuid, head, uuid, UUID_STR_LENGTH, out)
 #define HASH_ADD_UUID(head, uuid_field, add) HASH_ADD(hh_uuid, head, uuid_field[0], UUID_STR_LENGTH, add)
 
-#define NUM_TEXTURES 2
+/* triple-buffered staging: a surface is mapped two frames after it was
+ * staged, so the driver has time to finish the copy and the map does not
+ * stall the graphics thread */
+#define NUM_TEXTURES 3
 #define NUM_CHANNELS 3
+#define MAX_ASYNC_FRAMES 30
 #define MICROSECOND_DEN 1000000
 #define NUM_ENCODE_TEXTURES 10
+#define MIN_ENCODE_TEXTURES 3
+#define MAX_ENCODE_TEXTURES 32
 #define NUM_ENCODE_TEXTURE_FRAMES_TO_WAIT 1
 
 static inline int64_t packet_dts_usec(struct encoder_packet *packet)
@@ -124,12 +131,30 @@ struct obs_module {
 	const char *(*name)(void);
 	const char *(*description)(void);
 	const char *(*author)(void);
+	const struct obs_module_manifest *(*manifest)(void);
 
 	struct obs_module *next;
 };
 
 extern void free_module(struct obs_module *mod);
 
+/* a type id declared by a not-yet-loaded module's manifest; when the id
+ * comes from the persisted scan cache the module has not even been opened
+ * yet, in which case module is NULL and bin_path/data_path identify it */
+struct lazy_module_type {
+	enum obs_obj_type type;
+	char *id;
+	struct obs_module *module;
+	char *bin_path;
+	char *data_path;
+};
+
+extern void free_lazy_module_types(void);
+
+/* loads the lazy module declaring the given type id, if any; returns
+ * true if a module was loaded and the type lookup should be retried */
+extern bool obs_demand_load_module_type(enum obs_obj_type type, const char *id);
+
 struct obs_module_path {
 	char *bin;
 	char *data;
@@ -192,6 +217,9 @@ struct obs_core_hotkeys;
 bool obs_hotkeys_platform_init(struct obs_core_hotkeys *hotkeys);
 void obs_hotkeys_platform_free(struct obs_core_hotkeys *hotkeys);
 bool obs_hotkeys_platform_is_pressed(obs_hotkeys_platform_t *context, obs_key_t key);
+/* reports whether any user input occurred since the previous call;
+ * platforms without a cheap way to tell always return true */
+bool obs_hotkeys_platform_input_since_last(obs_hotkeys_platform_t *context);
 
 const char *obs_get_hotkey_translation(obs_key_t key, const char *def);
 
@@ -209,9 +237,6 @@ struct obs_hotkey_binding {
 	obs_hotkey_t *hotkey;
 };
 
-struct obs_hotkey_name_map_item;
-void obs_hotkey_name_map_free(void);
-
 /* ------------------------------------------------------------------------- */
 /* views */
 
@@ -236,6 +261,9 @@ extern void obs_view_free(struct obs_view *view);
 struct obs_display {
 	bool update_color_space;
 	bool enabled;
+	/* set by the frontend when the window is fully occluded or
+	 * minimized; rendering and presenting are skipped entirely */
+	volatile bool hidden;
 	uint32_t cx, cy;
 	uint32_t next_cx, next_cy;
 	uint32_t background_color;
@@ -245,6 +273,10 @@ struct obs_display {
 	DARRAY(struct draw_callback) draw_callbacks;
 	bool use_clear_workaround;
 
+	/* draw work was recorded this frame and the swap still needs a
+	 * present; only touched on the graphics thread */
+	bool present_pending;
+
 	struct obs_display *next;
 	struct obs_display **prev_next;
 };
@@ -287,8 +319,14 @@ struct obs_core_video_mix {
 #endif
 	gs_texture_t *render_texture;
 	gs_texture_t *output_texture;
+	/* horizontal-pass result of the separable output rescale, sized
+	 * output width x source height (see render_output_texture) */
+	gs_texture_t *scale_intermediate_texture;
 	enum gs_color_space render_space;
 	bool texture_rendered;
+	/* output_texture holds this frame's downscaled image and may feed
+	 * smaller mixes of the same view (see render_output_texture) */
+	bool output_scaled;
 	bool textures_copied[NUM_TEXTURES];
 	bool texture_converted;
 	bool using_nv12_tex;
@@ -327,11 +365,23 @@ struct obs_core_video_mix {
 	long encoder_refs;
 
 	bool mix_audio;
+
+	/* canvas damage tracking: whether the last composited frame came
+	 * solely from static/async sources, and the global change count it
+	 * was rendered at; when both still hold, compositing is skipped and
+	 * the previous render texture is reused */
+	bool last_render_stable;
+	long last_change_count;
 };
 
 extern struct obs_core_video_mix *obs_create_video_mix(struct obs_video_info *ovi);
 extern void obs_free_video_mix(struct obs_core_video_mix *video);
 
+struct obs_deferred_effect {
+	gs_effect_t **effect;
+	char *file;
+};
+
 struct obs_core_video {
 	graphics_t *graphics;
 	gs_effect_t *default_effect;
@@ -344,9 +394,15 @@ struct obs_core_video {
 	gs_effect_t *lanczos_effect;
 	gs_effect_t *area_effect;
 	gs_effect_t *bilinear_lowres_effect;
+	gs_effect_t *separable_scale_effect;
 	gs_effect_t *premultiplied_alpha_effect;
 	gs_samplerstate_t *point_sampler;
 
+	/* effects queued at graphics init and compiled on the graphics
+	 * thread (or on first use) instead of blocking obs_reset_video */
+	pthread_mutex_t deferred_effects_mutex;
+	DARRAY(struct obs_deferred_effect) deferred_effects;
+
 	uint64_t video_time;
 	uint64_t video_frame_interval_ns;
 	uint64_t video_half_frame_interval_ns;
@@ -355,6 +411,23 @@ struct obs_core_video {
 	pthread_t video_thread;
 	uint32_t total_frames;
 	uint32_t lagged_frames;
+	/* histogram of how far past its target each frame sleep woke up:
+	 * <25us, <100us, <500us, <2ms, >=2ms (see video_sleep) */
+	uint64_t pacing_jitter_buckets[5];
+	uint64_t pacing_jitter_max_ns;
+
+	/* dynamic resolution state: graphics thread only, except
+	 * dynres_enabled and dynres_scale_percent which other threads
+	 * access atomically */
+	volatile bool dynres_enabled;
+	volatile long dynres_scale_percent;
+	int dynres_level;
+	uint32_t dynres_lagged_prev;
+	uint32_t dynres_streak;
+	uint64_t dynres_calm_start_ns;
+	/* published atomically by the graphics thread so stats readers never
+	 * contend on mixes_mutex */
+	volatile long skipped_compositions;
 	bool thread_initialized;
 
 	gs_texture_t *transparent_texture;
@@ -379,18 +452,81 @@ struct obs_core_video {
 
 	pthread_mutex_t mixes_mutex;
 	DARRAY(struct obs_core_video_mix *) mixes;
+
+	/* canvas damage tracking; see obs_canvas_mark_dirty() */
+	volatile long canvas_change_count;
+	volatile bool render_unstable;
+
+	/* encoder motion hints: bounding rects of scene items that changed
+	 * this frame, accumulated in canvas coordinates while the main mix
+	 * composites and published to opted-in encoders as ROI */
+	DARRAY(struct obs_encoder_roi) motion_rects;
+	volatile long motion_hint_encoders;
+	bool collecting_motion_hints;
+	uint64_t motion_frame_count;
+
+	/* number of sources with an active frame budget; keeps the budget
+	 * timing path in source-profiler.c free when nothing is budgeted */
+	volatile long budget_source_count;
+
+	bool parallel_tick;
+	DARRAY(pthread_t) tick_threads;
+	os_sem_t *tick_start_sem;
+	os_sem_t *tick_done_sem;
+	volatile long tick_next_idx;
+	volatile bool tick_threads_active;
+	float tick_seconds;
+
+	/* generic job run by the tick workers; set before posting
+	 * tick_start_sem and always joined before the next dispatch, so a
+	 * single job slot suffices */
+	void (*worker_job)(void *param);
+	void *worker_job_param;
 };
 
+extern bool obs_init_tick_threads(uint32_t count);
+extern void obs_free_tick_threads(void);
+
+extern void obs_compile_deferred_effects(void);
+
+extern bool obs_init_audio_mix_threads(uint32_t count);
+extern void obs_free_audio_mix_threads(void);
+
 extern void add_ready_encoder_group(obs_encoder_t *encoder);
 
+extern void obs_missing_files_free_cache(void);
+
 struct audio_monitor;
 
+/* audio tick watchdog stages, in execution order within audio_callback */
+enum audio_tick_stage {
+	AUDIO_TICK_TREE,    /* building the audio render order */
+	AUDIO_TICK_RENDER,  /* per-source capture/resample/filter rendering */
+	AUDIO_TICK_SYNC,    /* minimum timestamp calculation and buffering */
+	AUDIO_TICK_MIX,     /* final mix reduction */
+	AUDIO_TICK_DISCARD, /* discarding consumed input audio */
+	AUDIO_TICK_TASKS,   /* queued audio thread tasks */
+	AUDIO_TICK_STAGES,
+};
+
 struct obs_core_audio {
 	audio_t *audio;
 
 	DARRAY(struct obs_source *) render_order;
 	DARRAY(struct obs_source *) root_nodes;
 
+	/* worker pool for per-source audio rendering; the mix_audio
+	 * reduction always stays on the audio thread */
+	DARRAY(pthread_t) mix_workers;
+	os_sem_t *mix_start_sem;
+	os_sem_t *mix_done_sem;
+	volatile long mix_next_idx;
+	volatile bool mix_workers_active;
+	uint32_t mix_pass_mixers;
+	size_t mix_pass_channels;
+	size_t mix_pass_sample_rate;
+	size_t mix_pass_audio_size;
+
 	uint64_t buffered_ts;
 	struct deque buffered_timestamps;
 	uint64_t buffering_wait_ticks;
@@ -405,6 +541,17 @@ struct obs_core_audio {
 
 	pthread_mutex_t task_mutex;
 	struct deque tasks;
+
+	/* tick watchdog: per-stage times for the current tick plus the
+	 * rolling worst case; the culprit (costliest source render this
+	 * tick) may be updated from mix workers, hence the mutex */
+	uint64_t tick_stage_ns[AUDIO_TICK_STAGES];
+	uint64_t tick_stage_worst_ns[AUDIO_TICK_STAGES];
+	pthread_mutex_t tick_culprit_mutex;
+	char tick_culprit_name[256];
+	uint64_t tick_culprit_ns;
+	uint64_t tick_overruns;
+	uint64_t tick_last_warn_ns;
 };
 
 /* user sources, output channels, and displays */
@@ -446,6 +593,7 @@ struct obs_core_data {
 
 	DARRAY(char *) protocols;
 	DARRAY(obs_source_t *) sources_to_tick;
+	DARRAY(obs_source_t *) sources_to_tick_parallel;
 };
 
 /* user hotkeys */
@@ -469,9 +617,6 @@ struct obs_core_hotkeys {
 
 	obs_hotkeys_platform_t *platform_context;
 
-	pthread_once_t name_map_init_token;
-	struct obs_hotkey_name_map_item *name_map;
-
 	signal_handler_t *signals;
 
 	char *translations[OBS_KEY_LAST_VALUE];
@@ -485,12 +630,25 @@ struct obs_core_hotkeys {
 
 typedef DARRAY(struct obs_source_info) obs_source_info_array_t;
 
+/* O(1) source type lookup by id; the index is stored rather than a pointer
+ * because source_types reallocates as modules register.  Also holds the
+ * lazily built per-type default settings (see obs-source.c). */
+struct source_type_item {
+	const char *id; /* key: points at the registered info's id string */
+	size_t idx;     /* index into obs_core.source_types */
+	obs_data_t *cached_defaults;
+	UT_hash_handle hh;
+};
+
 struct obs_core {
 	struct obs_module *first_module;
 	DARRAY(struct obs_module_path) module_paths;
 	DARRAY(char *) safe_modules;
+	DARRAY(struct lazy_module_type) lazy_module_types;
+	bool modules_post_loaded;
 
 	obs_source_info_array_t source_types;
+	struct source_type_item *source_type_lookup;
 	obs_source_info_array_t input_types;
 	obs_source_info_array_t filter_types;
 	obs_source_info_array_t transition_types;
@@ -520,6 +678,26 @@ struct obs_core {
 
 extern struct obs_core *obs;
 
+/* marks composited video as changed; called whenever something that can
+ * alter canvas contents happens (async frame delivery, settings updates,
+ * scene edits, transforms, channel changes) */
+static inline void obs_canvas_mark_dirty(void)
+{
+	os_atomic_inc_long(&obs->video.canvas_change_count);
+}
+
+/* marks the frame currently being composited as non-reusable; called
+ * while rendering sources whose output can change without notice */
+static inline void obs_canvas_mark_unstable(void)
+{
+	os_atomic_set_bool(&obs->video.render_unstable, true);
+}
+
+/* records the canvas-space bounding box of a changed scene item as an
+ * encoder motion hint; only has an effect while the main mix composites
+ * and at least one encoder opted into motion hints */
+extern void obs_motion_hints_add_box(const struct matrix4 *box_transform);
+
 struct obs_graphics_context {
 	uint64_t last_time;
 	uint64_t interval;
@@ -720,6 +898,19 @@ struct audio_cb_info {
 	void *param;
 };
 
+/* number of slots in the per-source capture-to-audio-thread audio ring;
+ * sized for several hundred milliseconds of small device chunks so the
+ * ring only overflows if the audio thread is badly stalled */
+#define PENDING_AUDIO_CHUNKS 64
+
+struct source_audio_chunk {
+	float *data[MAX_AUDIO_CHANNELS];
+	size_t capacity;
+	uint32_t frames;
+	uint64_t timestamp;
+	uint64_t os_time;
+};
+
 struct caption_cb_info {
 	obs_source_caption_t callback;
 	void *param;
@@ -794,6 +985,15 @@ struct obs_source {
 	uint64_t last_sys_timestamp;
 	bool async_rendered;
 
+	/* adaptive jitter buffer: estimator updated by the producer thread
+	 * feeding the source, stats published for readers on other threads */
+	uint64_t jitter_prev_sys_ns;
+	uint64_t jitter_prev_ts;
+	volatile uint64_t jitter_avg_ns;
+	volatile uint64_t jitter_peak_ns;
+	volatile long playout_rate_permille;
+	volatile long buffered_ms_stat;
+
 	/* audio */
 	bool audio_failed;
 	bool audio_pending;
@@ -806,6 +1006,16 @@ struct obs_source {
 	uint64_t audio_ts;
 	struct deque audio_input_buf[MAX_AUDIO_CHANNELS];
 	size_t last_audio_input_buf_size;
+
+	/* lock-free handoff of captured audio to the audio thread: the
+	 * capture thread fills the slot at pending_audio_write and bumps it,
+	 * the audio thread drains up to pending_audio_write at the start of
+	 * each tick (see obs_source_drain_pending_audio()).  capture threads
+	 * no longer touch audio_input_buf or audio_buf_mutex at all */
+	struct source_audio_chunk pending_audio[PENDING_AUDIO_CHUNKS];
+	volatile long pending_audio_write;
+	volatile long pending_audio_read;
+	volatile long pending_audio_dropped;
 	DARRAY(struct audio_action) audio_actions;
 	float *audio_output_buf[MAX_AUDIO_MIXES][MAX_AUDIO_CHANNELS];
 	float *audio_mix_buf[MAX_AUDIO_CHANNELS];
@@ -849,6 +1059,14 @@ struct obs_source {
 	DARRAY(struct async_frame) async_cache;
 	DARRAY(struct obs_source_frame *) async_frames;
 	pthread_mutex_t async_mutex;
+
+	/* bounded ring used to hand incoming async frames to the graphics
+	 * thread; producers are serialized by async_mutex, the graphics
+	 * thread drains into async_frames without taking the lock */
+	struct obs_source_frame *async_ring[MAX_ASYNC_FRAMES];
+	volatile long async_ring_write;
+	volatile long async_ring_read;
+	volatile bool async_clear;
 	uint32_t async_width;
 	uint32_t async_height;
 	uint32_t async_cache_width;
@@ -857,6 +1075,10 @@ struct obs_source {
 	uint32_t async_convert_height[MAX_AV_PLANES];
 	uint64_t async_last_rendered_ts;
 
+	/* bumped on every async frame delivery or clear; lets render
+	 * caches detect new frames before the source has rendered them */
+	volatile long async_delivered;
+
 	pthread_mutex_t caption_cb_mutex;
 	DARRAY(struct caption_cb_info) caption_cb_list;
 
@@ -864,6 +1086,15 @@ struct obs_source {
 	uint64_t deinterlace_offset;
 	uint64_t deinterlace_frame_ts;
 	gs_effect_t *deinterlace_effect;
+
+	/* param handles cached when the deinterlace effect is selected so
+	 * deinterlace_render avoids per-frame name lookups */
+	gs_eparam_t *deinterlace_image_param;
+	gs_eparam_t *deinterlace_prev_param;
+	gs_eparam_t *deinterlace_multiplier_param;
+	gs_eparam_t *deinterlace_field_param;
+	gs_eparam_t *deinterlace_frame2_param;
+	gs_eparam_t *deinterlace_dimensions_param;
 	struct obs_source_frame *prev_async_frame;
 	gs_texture_t *async_prev_textures[MAX_AV_PLANES];
 	gs_texrender_t *async_prev_texrender;
@@ -872,6 +1103,22 @@ struct obs_source {
 	bool deinterlace_top_first;
 	bool deinterlace_rendered;
 
+	/* render-interval throttling: sources with a non-zero interval are
+	 * ticked at the reduced rate (seconds accumulate between ticks) and
+	 * scene items cache their last render for off-frames; the change
+	 * counter forces a re-render on updates */
+	uint64_t render_interval_ns;
+	uint64_t last_interval_tick_ns;
+	float interval_tick_seconds;
+	volatile long interval_change_count;
+
+	/* per-frame time budget; accumulated/evaluated on the video pipeline
+	 * threads only (see source-profiler.c), so no locking is needed */
+	uint64_t frame_budget_ns;
+	uint64_t budget_frame_ns;
+	uint32_t budget_overrun_frames;
+	uint32_t budget_overrun_limit;
+
 	/* filters */
 	struct obs_source *filter_parent;
 	struct obs_source *filter_target;
@@ -922,9 +1169,31 @@ struct obs_source {
 	enum obs_transition_scale_type transition_scale_type;
 	struct matrix4 transition_matrices[2];
 
+	/* cached child renders: when a child subtree was static for the
+	 * whole of the previous frame, its texrender is kept across frames
+	 * instead of being re-rendered (see obs_transition_tick) */
+	bool transition_tex_valid[2];
+	bool transition_tex_unstable[2];
+	long transition_tex_change_count[2];
+	enum gs_color_space transition_tex_space[2];
+	uint32_t transition_tex_cx[2];
+	uint32_t transition_tex_cy[2];
+	struct matrix4 transition_tex_matrix[2];
+
 	/* color space */
 	gs_texrender_t *color_space_texrender;
 
+	/* cross-canvas shared render cache: a scene rendered by multiple
+	 * canvases in the same frame is composited once into this texrender
+	 * and drawn from it afterward */
+	gs_texrender_t *shared_cache;
+	uint64_t shared_frame_time;
+	uint32_t shared_render_count;
+	uint32_t shared_prev_render_count;
+	enum gs_color_space shared_cache_space;
+	bool shared_cache_valid;
+	bool shared_cache_unstable;
+
 	/* audio monitoring */
 	struct audio_monitor *monitor;
 	enum obs_monitoring_type monitoring_type;
@@ -1063,6 +1332,7 @@ extern uint64_t obs_source_get_last_async_ts(const obs_source_t *source);
 
 extern void obs_source_audio_render(obs_source_t *source, uint32_t mixers, size_t channels, size_t sample_rate,
 				    size_t size);
+extern void obs_source_drain_pending_audio(obs_source_t *source);
 
 extern void add_alignment(struct vec2 *v, uint32_t align, int cx, int cy);
 
@@ -1073,6 +1343,7 @@ extern bool update_async_textures(struct obs_source *source, const struct obs_so
 				  gs_texture_t *tex[MAX_AV_PLANES], gs_texrender_t *texrender);
 extern bool set_async_texture_size(struct obs_source *source, const struct obs_source_frame *frame);
 extern void remove_async_frame(obs_source_t *source, struct obs_source_frame *frame);
+extern void release_async_queue_frame(obs_source_t *source, struct obs_source_frame *frame);
 
 extern void set_deinterlace_texture_size(obs_source_t *source);
 extern void deinterlace_process_last_frame(obs_source_t *source, uint64_t sys_time);
@@ -1105,9 +1376,20 @@ struct obs_weak_output {
 
 #define CAPTION_LINE_CHARS (32)
 #define CAPTION_LINE_BYTES (4 * CAPTION_LINE_CHARS)
+/* SEI payloads rendered once when caption text is submitted, shared
+ * across caption tracks by refcount */
+struct caption_sei {
+	volatile long refs;
+	uint8_t *avc_sei; /* rendered AVC SEI NAL (no start code) */
+	size_t avc_size;
+	uint8_t *t35; /* raw ITU-T T.35 payload for AV1 metadata OBUs */
+	size_t t35_size;
+};
+
 struct caption_text {
 	char text[CAPTION_LINE_BYTES + 1];
 	double display_duration;
+	struct caption_sei *sei;
 	struct caption_text *next;
 };
 
@@ -1118,6 +1400,10 @@ struct caption_track_data {
 	double caption_timestamp;
 	double last_caption_timestamp;
 	struct deque caption_data;
+
+	/* checked without the mutex so caption-less outputs skip the
+	 * caption stage entirely */
+	volatile bool captions_pending;
 };
 
 struct pause_data {
@@ -1145,6 +1431,24 @@ struct keyframe_group_data {
 	enum keyframe_group_track_status seen_on_track[MAX_OUTPUT_VIDEO_ENCODERS];
 };
 
+#define INTERLEAVE_QUEUE_SIZE 64 /* per track, must be a power of two */
+#define NUM_INTERLEAVE_QUEUES (MAX_OUTPUT_VIDEO_ENCODERS + MAX_OUTPUT_AUDIO_ENCODERS)
+
+struct interleave_item {
+	struct encoder_packet packet;
+	struct encoder_packet_time packet_time;
+	bool has_packet_time;
+};
+
+/* Single-producer/single-consumer ring: the producer is the encoder thread
+ * that owns the track, the consumer is whichever thread currently holds the
+ * output's merge flag (see interleave_packets in obs-output.c). */
+struct interleave_queue {
+	struct interleave_item items[INTERLEAVE_QUEUE_SIZE];
+	volatile long write_pos;
+	volatile long read_pos;
+};
+
 struct obs_output {
 	struct obs_context_data context;
 	struct obs_output_info info;
@@ -1165,6 +1469,8 @@ struct obs_output {
 	os_event_t *stopping_event;
 	pthread_mutex_t interleaved_mutex;
 	DARRAY(struct encoder_packet) interleaved_packets;
+	struct interleave_queue *interleave_queues; /* NUM_INTERLEAVE_QUEUES */
+	volatile long interleave_merging;
 	int stop_code;
 
 	int reconnect_retry_sec;
@@ -1221,6 +1527,20 @@ struct obs_output {
 
 	struct reconnect_callback reconnect_callback;
 
+	/* shared AIMD congestion control; outputs feed samples through
+	 * obs_output_submit_congestion_sample() (see obs-output.c) */
+	pthread_mutex_t cc_mutex;
+	bool cc_enabled;
+	bool cc_active;
+	long cc_orig_bitrate;
+	long cc_cur_bitrate;
+	long cc_min_bitrate;
+	long cc_inc_bitrate;
+	uint64_t cc_base_rtt_usec;
+	uint64_t cc_last_decrease_ns;
+	uint64_t cc_clean_since_ns;
+	float cc_congestion;
+
 	bool valid;
 
 	uint64_t active_delay_ns;
@@ -1342,6 +1662,9 @@ struct obs_encoder {
 	DARRAY(struct obs_encoder_roi) roi;
 	uint32_t roi_increment;
 
+	/* compositor motion hints drive the ROI list automatically */
+	bool motion_hints;
+
 	int64_t cur_pts;
 
 	struct deque audio_input_buffer[MAX_AV_PLANES];
@@ -1439,6 +1762,10 @@ extern void source_profiler_frame_collect(void);
 extern void source_profiler_render_begin(void);
 extern void source_profiler_render_end(void);
 
+/* Obtain/submit a GPU timer for a pipeline stage (graphics context only) */
+extern gs_timer_t *source_profiler_pipeline_begin(void);
+extern void source_profiler_pipeline_end(enum profiler_pipeline_stage stage, gs_timer_t *timer);
+
 /* Reset settings, buffers, and GPU timers when video settings change */
 extern void source_profiler_reset_video(struct obs_video_info *ovi);
 
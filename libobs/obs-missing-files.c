@@ -17,6 +17,8 @@
 
 #include "util/threading.h"
 #include "util/dstr.h"
+#include "util/platform.h"
+#include "util/crc32.h"
 #include "obs-missing-files.h"
 #include "obs.h"
 
@@ -32,8 +34,151 @@ struct obs_missing_file {
 
 struct obs_missing_files {
 	DARRAY(struct obs_missing_file *) files;
+	DARRAY(struct obs_missing_file *) pending;
 };
 
+/* ------------------------------------------------------------------------- */
+/*
+ * Parallel existence checks
+ *
+ *   Sources queue their referenced paths instead of calling os_file_exists()
+ * inline; the queued checks run on a bounded pool of worker threads the first
+ * time the list is queried, so a collection load pays for its slowest stat()
+ * rather than the sum of all of them (networked media libraries can take
+ * several milliseconds per call).  Paths found missing are remembered for
+ * the rest of the session so switching collections back and forth does not
+ * re-stat files already known to be gone.
+ */
+
+#define MISSING_FILE_CHECK_THREADS 8
+
+struct missing_file_check {
+	struct obs_missing_files *files;
+	volatile long next_idx;
+	bool *exists;
+};
+
+struct missing_path_entry {
+	uint32_t hash;
+	char *path;
+};
+
+static pthread_mutex_t negative_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static DARRAY(struct missing_path_entry) negative_cache = {0};
+
+static bool negative_cache_find(uint32_t hash, const char *path)
+{
+	for (size_t i = 0; i < negative_cache.num; i++) {
+		struct missing_path_entry *entry = negative_cache.array + i;
+
+		if (entry->hash == hash && strcmp(entry->path, path) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+static bool missing_file_check_exists(const char *path)
+{
+	uint32_t hash = calc_crc32(0, path, strlen(path));
+	bool cached;
+	bool exists;
+
+	pthread_mutex_lock(&negative_cache_mutex);
+	cached = negative_cache_find(hash, path);
+	pthread_mutex_unlock(&negative_cache_mutex);
+
+	if (cached)
+		return false;
+
+	exists = os_file_exists(path);
+
+	if (!exists) {
+		pthread_mutex_lock(&negative_cache_mutex);
+		if (!negative_cache_find(hash, path)) {
+			struct missing_path_entry entry;
+			entry.hash = hash;
+			entry.path = bstrdup(path);
+			da_push_back(negative_cache, &entry);
+		}
+		pthread_mutex_unlock(&negative_cache_mutex);
+	}
+
+	return exists;
+}
+
+void obs_missing_files_free_cache(void)
+{
+	pthread_mutex_lock(&negative_cache_mutex);
+	for (size_t i = 0; i < negative_cache.num; i++)
+		bfree(negative_cache.array[i].path);
+	da_free(negative_cache);
+	pthread_mutex_unlock(&negative_cache_mutex);
+}
+
+static void *missing_file_check_thread(void *data)
+{
+	struct missing_file_check *check = data;
+	struct obs_missing_files *files = check->files;
+
+	os_set_thread_name("missing file check");
+
+	for (;;) {
+		long idx = os_atomic_inc_long(&check->next_idx) - 1;
+		if ((size_t)idx >= files->pending.num)
+			break;
+
+		check->exists[idx] = missing_file_check_exists(files->pending.array[idx]->file_path);
+	}
+
+	return NULL;
+}
+
+static void resolve_pending_files(struct obs_missing_files *files)
+{
+	pthread_t threads[MISSING_FILE_CHECK_THREADS];
+	struct missing_file_check check;
+	size_t num_threads;
+	size_t started = 0;
+
+	if (!files->pending.num)
+		return;
+
+	check.files = files;
+	check.next_idx = 0;
+	check.exists = bzalloc(files->pending.num * sizeof(bool));
+
+	num_threads = files->pending.num < MISSING_FILE_CHECK_THREADS ? files->pending.num
+								      : MISSING_FILE_CHECK_THREADS;
+
+	for (size_t i = 0; i < num_threads; i++) {
+		if (pthread_create(&threads[i], NULL, missing_file_check_thread, &check) == 0)
+			started++;
+		else
+			break;
+	}
+
+	if (!started)
+		missing_file_check_thread(&check);
+
+	for (size_t i = 0; i < started; i++)
+		pthread_join(threads[i], NULL);
+
+	for (size_t i = 0; i < files->pending.num; i++) {
+		struct obs_missing_file *file = files->pending.array[i];
+
+		if (check.exists[i])
+			obs_missing_file_release(file);
+		else
+			da_push_back(files->files, &file);
+	}
+
+	da_free(files->pending);
+	bfree(check.exists);
+}
+
+/* ------------------------------------------------------------------------- */
+
 obs_missing_files_t *obs_missing_files_create()
 {
 	struct obs_missing_files *files = bzalloc(sizeof(struct obs_missing_files));
@@ -46,8 +191,12 @@ void obs_missing_files_destroy(obs_missing_files_t *files)
 	for (size_t i = 0; i < files->files.num; i++) {
 		obs_missing_file_release(files->files.array[i]);
 	}
+	for (size_t i = 0; i < files->pending.num; i++) {
+		obs_missing_file_release(files->pending.array[i]);
+	}
 
 	da_free(files->files);
+	da_free(files->pending);
 	bfree(files);
 }
 
@@ -56,13 +205,20 @@ void obs_missing_files_add_file(obs_missing_files_t *files, obs_missing_file_t *
 	da_insert(files->files, files->files.num, &file);
 }
 
+void obs_missing_files_add_file_checked(obs_missing_files_t *files, obs_missing_file_t *file)
+{
+	da_push_back(files->pending, &file);
+}
+
 size_t obs_missing_files_count(obs_missing_files_t *files)
 {
+	resolve_pending_files(files);
 	return files->files.num;
 }
 
 obs_missing_file_t *obs_missing_files_get_file(obs_missing_files_t *files, int idx)
 {
+	resolve_pending_files(files);
 	return files->files.array[idx];
 }
 
@@ -73,6 +229,11 @@ void obs_missing_files_append(obs_missing_files_t *dst, obs_missing_files_t *src
 		obs_missing_files_add_file(dst, file);
 		os_atomic_inc_long(&file->ref);
 	}
+	for (size_t i = 0; i < src->pending.num; i++) {
+		obs_missing_file_t *file = src->pending.array[i];
+		obs_missing_files_add_file_checked(dst, file);
+		os_atomic_inc_long(&file->ref);
+	}
 }
 
 obs_missing_file_t *obs_missing_file_create(const char *path, obs_missing_file_cb callback, int src_type, void *src,
@@ -37,6 +37,17 @@ EXPORT obs_missing_file_t *obs_missing_file_create(const char *path, obs_missing
 						   void *src, void *data);
 
 EXPORT void obs_missing_files_add_file(obs_missing_files_t *files, obs_missing_file_t *file);
+
+/**
+ * Adds a file only if it turns out to be missing on disk.
+ *
+ *   The existence check is deferred and runs on a bounded pool of worker
+ * threads the first time the list is counted or indexed; paths found missing
+ * are cached for the rest of the session.  Sources should prefer this over
+ * checking os_file_exists() themselves so that slow (e.g. networked) paths
+ * are checked in parallel during collection load.
+ */
+EXPORT void obs_missing_files_add_file_checked(obs_missing_files_t *files, obs_missing_file_t *file);
 EXPORT size_t obs_missing_files_count(obs_missing_files_t *files);
 EXPORT obs_missing_file_t *obs_missing_files_get_file(obs_missing_files_t *files, int idx);
 EXPORT void obs_missing_files_destroy(obs_missing_files_t *files);
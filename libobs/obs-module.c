@@ -15,6 +15,8 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 ******************************************************************************/
 
+#include <sys/stat.h>
+
 #include "util/platform.h"
 #include "util/dstr.h"
 
@@ -56,6 +58,7 @@ static int load_module_exports(struct obs_module *mod, const char *path)
 	mod->description = os_dlsym(mod->module, "obs_module_description");
 	mod->author = os_dlsym(mod->module, "obs_module_author");
 	mod->get_string = os_dlsym(mod->module, "obs_module_get_string");
+	mod->manifest = os_dlsym(mod->module, "obs_module_manifest");
 	return MODULE_SUCCESS;
 }
 
@@ -296,6 +299,351 @@ static bool is_safe_module(const char *name)
 	return false;
 }
 
+static pthread_mutex_t lazy_modules_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void add_lazy_module_types(obs_module_t *module, enum obs_obj_type type, const char *const *ids)
+{
+	while (ids && *ids) {
+		struct lazy_module_type t = {
+			.type = type,
+			.id = bstrdup(*ids),
+			.module = module,
+		};
+
+		da_push_back(obs->lazy_module_types, &t);
+		ids++;
+	}
+}
+
+static inline void free_lazy_module_type(struct lazy_module_type *t)
+{
+	bfree(t->id);
+	bfree(t->bin_path);
+	bfree(t->data_path);
+}
+
+void free_lazy_module_types(void)
+{
+	for (size_t i = 0; i < obs->lazy_module_types.num; i++)
+		free_lazy_module_type(obs->lazy_module_types.array + i);
+	da_free(obs->lazy_module_types);
+}
+
+static void remove_lazy_module_types(obs_module_t *module)
+{
+	for (size_t i = obs->lazy_module_types.num; i > 0; i--) {
+		if (obs->lazy_module_types.array[i - 1].module == module) {
+			free_lazy_module_type(obs->lazy_module_types.array + (i - 1));
+			da_erase(obs->lazy_module_types, i - 1);
+		}
+	}
+}
+
+/* removes pending (cache-only) entries for the given binary */
+static void remove_pending_module_types(const char *bin_path)
+{
+	for (size_t i = obs->lazy_module_types.num; i > 0; i--) {
+		struct lazy_module_type *t = obs->lazy_module_types.array + (i - 1);
+		if (!t->module && strcmp(t->bin_path, bin_path) == 0) {
+			free_lazy_module_type(t);
+			da_erase(obs->lazy_module_types, i - 1);
+		}
+	}
+}
+
+/* records the manifest's type ids so the module can be loaded on first
+ * use; returns false if the manifest declares nothing, in which case
+ * the module is loaded normally */
+static bool defer_lazy_module(obs_module_t *module)
+{
+	const struct obs_module_manifest *manifest = module->manifest();
+	size_t before = obs->lazy_module_types.num;
+
+	if (!manifest)
+		return false;
+
+	add_lazy_module_types(module, OBS_OBJ_TYPE_SOURCE, manifest->source_ids);
+	add_lazy_module_types(module, OBS_OBJ_TYPE_ENCODER, manifest->encoder_ids);
+	add_lazy_module_types(module, OBS_OBJ_TYPE_OUTPUT, manifest->output_ids);
+
+	if (obs->lazy_module_types.num == before)
+		return false;
+
+	blog(LOG_DEBUG, "Deferring load of module '%s' (%zu declared types)", module->file,
+	     obs->lazy_module_types.num - before);
+	return true;
+}
+
+static bool lazy_type_matches(const struct lazy_module_type *t, enum obs_obj_type type, const char *id)
+{
+	size_t len;
+
+	if (t->type != type)
+		return false;
+
+	len = strlen(t->id);
+	if (strncmp(t->id, id, len) != 0)
+		return false;
+
+	/* registered source ids may carry a version suffix ("id_v2") */
+	return id[len] == 0 || (id[len] == '_' && id[len + 1] == 'v');
+}
+
+bool obs_demand_load_module_type(enum obs_obj_type type, const char *id)
+{
+	struct lazy_module_type *found = NULL;
+	bool loaded = false;
+
+	/* cheap unlocked check: the list is only populated during module
+	 * discovery at startup and only shrinks afterward */
+	if (!obs->lazy_module_types.num)
+		return false;
+
+	pthread_mutex_lock(&lazy_modules_mutex);
+
+	for (size_t i = 0; i < obs->lazy_module_types.num; i++) {
+		struct lazy_module_type *t = obs->lazy_module_types.array + i;
+		if (lazy_type_matches(t, type, id)) {
+			found = t;
+			break;
+		}
+	}
+
+	if (found && found->module) {
+		obs_module_t *module = found->module;
+
+		/* drop all of the module's declarations first so that
+		 * registration during load cannot re-enter this path */
+		remove_lazy_module_types(module);
+
+		blog(LOG_INFO, "Loading deferred module '%s' for type '%s'", module->file, id);
+
+		loaded = obs_init_module(module);
+		if (!loaded)
+			free_module(module);
+		else if (obs->modules_post_loaded && module->post_load)
+			module->post_load();
+	} else if (found) {
+		/* known only from the scan cache; open it now */
+		char *bin_path = bstrdup(found->bin_path);
+		char *data_path = bstrdup(found->data_path);
+		obs_module_t *module = NULL;
+
+		remove_pending_module_types(bin_path);
+
+		blog(LOG_INFO, "Loading deferred module '%s' for type '%s'", bin_path, id);
+
+		if (obs_open_module(&module, bin_path, data_path) == MODULE_SUCCESS) {
+			loaded = obs_init_module(module);
+			if (!loaded)
+				free_module(module);
+			else if (obs->modules_post_loaded && module->post_load)
+				module->post_load();
+		} else {
+			blog(LOG_WARNING, "Failed to open cached deferred module '%s'", bin_path);
+		}
+
+		bfree(bin_path);
+		bfree(data_path);
+	}
+
+	pthread_mutex_unlock(&lazy_modules_mutex);
+	return loaded;
+}
+
+/* ------------------------------------------------------------------------- */
+/* persisted module scan cache
+ *
+ * Scanning the module directories means globbing each one and opening
+ * every binary just to find out what it exports; on network installs
+ * this dominates cold start.  The scan results are persisted to a json
+ * file in the module config path and validated by each directory's
+ * mtime: installs add and replace plugin files through the directory,
+ * so an untouched mtime means the cached file list, plugin verdicts and
+ * manifests can be replayed without globbing or opening anything.
+ * Modules whose cached manifest declares types are deferred without
+ * being opened at all; obs_demand_load_module_type opens them on first
+ * use.  The cache is only engaged by obs_load_all_modules and its
+ * helpers run on the same thread, so plain statics suffice. */
+
+#define SCAN_CACHE_FILE "module-scan-cache.json"
+
+static obs_data_t *scan_cache = NULL;               /* cache from the previous run */
+static obs_data_t *scan_cache_new = NULL;           /* cache being rebuilt */
+static obs_data_array_t *scan_cache_dir = NULL;     /* fresh directory being filled */
+static obs_data_t *scan_cache_module = NULL;        /* entry for the module in flight */
+static bool scan_cache_module_cached = false;       /* entry replayed from the cache */
+static bool scan_cache_active = false;
+
+static char *get_scan_cache_path(void)
+{
+	struct dstr path = {0};
+
+	if (!obs->module_config_path)
+		return NULL;
+
+	dstr_copy(&path, obs->module_config_path);
+	if (!dstr_is_empty(&path) && dstr_end(&path) != '/')
+		dstr_cat_ch(&path, '/');
+	dstr_cat(&path, SCAN_CACHE_FILE);
+	return path.array;
+}
+
+static void module_scan_cache_begin(void)
+{
+	char *path = get_scan_cache_path();
+	if (!path)
+		return;
+
+	scan_cache = obs_data_create_from_json_file(path);
+	if (scan_cache && obs_data_get_int(scan_cache, "api_ver") != LIBOBS_API_VER) {
+		obs_data_release(scan_cache);
+		scan_cache = NULL;
+	}
+
+	scan_cache_new = obs_data_create();
+	obs_data_set_int(scan_cache_new, "api_ver", LIBOBS_API_VER);
+	scan_cache_active = true;
+	bfree(path);
+}
+
+static void module_scan_cache_end(void)
+{
+	char *path;
+
+	if (!scan_cache_active)
+		return;
+
+	scan_cache_active = false;
+
+	path = get_scan_cache_path();
+	if (path) {
+		if (!obs_data_save_json_safe(scan_cache_new, path, "tmp", NULL))
+			blog(LOG_DEBUG, "Failed to save module scan cache '%s'", path);
+		bfree(path);
+	}
+
+	obs_data_release(scan_cache);
+	obs_data_release(scan_cache_new);
+	scan_cache = NULL;
+	scan_cache_new = NULL;
+}
+
+static obs_data_t *scan_cache_find_dir(obs_data_t *cache, const char *bin)
+{
+	obs_data_array_t *dirs;
+	obs_data_t *found = NULL;
+	size_t count;
+
+	if (!cache)
+		return NULL;
+
+	dirs = obs_data_get_array(cache, "dirs");
+	if (!dirs)
+		return NULL;
+
+	count = obs_data_array_count(dirs);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *dir = obs_data_array_item(dirs, i);
+		if (strcmp(obs_data_get_string(dir, "bin"), bin) == 0) {
+			found = dir;
+			break;
+		}
+		obs_data_release(dir);
+	}
+
+	obs_data_array_release(dirs);
+	return found;
+}
+
+static void scan_cache_add_dir(obs_data_t *dir)
+{
+	obs_data_array_t *dirs = obs_data_get_array(scan_cache_new, "dirs");
+	if (!dirs) {
+		dirs = obs_data_array_create();
+		obs_data_set_array(scan_cache_new, "dirs", dirs);
+	}
+
+	obs_data_array_push_back(dirs, dir);
+	obs_data_array_release(dirs);
+}
+
+static void scan_cache_set_ids(obs_data_t *mod, const char *key, const char *const *ids)
+{
+	obs_data_array_t *arr = obs_data_array_create();
+
+	while (ids && *ids) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "id", *ids);
+		obs_data_array_push_back(arr, item);
+		obs_data_release(item);
+		ids++;
+	}
+
+	obs_data_set_array(mod, key, arr);
+	obs_data_array_release(arr);
+}
+
+/* records the manifest of a freshly probed module so the next launch can
+ * defer it without opening the binary */
+static void record_manifest_in_cache(obs_module_t *module)
+{
+	const struct obs_module_manifest *manifest;
+
+	if (!scan_cache_module)
+		return;
+
+	manifest = module->manifest();
+	if (!manifest)
+		return;
+
+	scan_cache_set_ids(scan_cache_module, "sources", manifest->source_ids);
+	scan_cache_set_ids(scan_cache_module, "encoders", manifest->encoder_ids);
+	scan_cache_set_ids(scan_cache_module, "outputs", manifest->output_ids);
+}
+
+static void add_pending_module_types(const struct obs_module_info2 *info, enum obs_obj_type type, obs_data_t *mod,
+				     const char *key)
+{
+	obs_data_array_t *arr = obs_data_get_array(mod, key);
+	size_t count = arr ? obs_data_array_count(arr) : 0;
+
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(arr, i);
+		struct lazy_module_type t = {
+			.type = type,
+			.id = bstrdup(obs_data_get_string(item, "id")),
+			.bin_path = bstrdup(info->bin_path),
+			.data_path = bstrdup(info->data_path),
+		};
+
+		da_push_back(obs->lazy_module_types, &t);
+		obs_data_release(item);
+	}
+
+	obs_data_array_release(arr);
+}
+
+/* registers the cached manifest's type ids without opening the binary;
+ * returns false if the cache has no manifest for this module */
+static bool defer_cached_module(const struct obs_module_info2 *info, obs_data_t *mod)
+{
+	size_t before = obs->lazy_module_types.num;
+
+	add_pending_module_types(info, OBS_OBJ_TYPE_SOURCE, mod, "sources");
+	add_pending_module_types(info, OBS_OBJ_TYPE_ENCODER, mod, "encoders");
+	add_pending_module_types(info, OBS_OBJ_TYPE_OUTPUT, mod, "outputs");
+
+	if (obs->lazy_module_types.num == before)
+		return false;
+
+	blog(LOG_DEBUG, "Deferring load of module '%s' from scan cache (%zu declared types)", info->bin_path,
+	     obs->lazy_module_types.num - before);
+	return true;
+}
+
+/* ------------------------------------------------------------------------- */
+
 static void load_all_callback(void *param, const struct obs_module_info2 *info)
 {
 	struct fail_info *fail_info = param;
@@ -304,7 +652,16 @@ static void load_all_callback(void *param, const struct obs_module_info2 *info)
 	bool is_obs_plugin;
 	bool can_load_obs_plugin;
 
-	get_plugin_info(info->bin_path, &is_obs_plugin, &can_load_obs_plugin);
+	if (scan_cache_module_cached) {
+		is_obs_plugin = obs_data_get_bool(scan_cache_module, "plugin");
+		can_load_obs_plugin = obs_data_get_bool(scan_cache_module, "can_load");
+	} else {
+		get_plugin_info(info->bin_path, &is_obs_plugin, &can_load_obs_plugin);
+		if (scan_cache_module) {
+			obs_data_set_bool(scan_cache_module, "plugin", is_obs_plugin);
+			obs_data_set_bool(scan_cache_module, "can_load", can_load_obs_plugin);
+		}
+	}
 
 	if (!is_obs_plugin) {
 		blog(LOG_WARNING, "Skipping module '%s', not an OBS plugin", info->bin_path);
@@ -324,6 +681,10 @@ static void load_all_callback(void *param, const struct obs_module_info2 *info)
 		goto load_failure;
 	}
 
+	/* cached manifest: defer the module without opening its binary */
+	if (scan_cache_module_cached && defer_cached_module(info, scan_cache_module))
+		return;
+
 	int code = obs_open_module(&module, info->bin_path, info->data_path);
 	switch (code) {
 	case MODULE_MISSING_EXPORTS:
@@ -342,6 +703,12 @@ static void load_all_callback(void *param, const struct obs_module_info2 *info)
 		return;
 	}
 
+	if (module->manifest && defer_lazy_module(module)) {
+		record_manifest_in_cache(module);
+		UNUSED_PARAMETER(param);
+		return;
+	}
+
 	if (!obs_init_module(module))
 		free_module(module);
 
@@ -364,7 +731,9 @@ static const char *reset_win32_symbol_paths_name = "reset_win32_symbol_paths";
 void obs_load_all_modules(void)
 {
 	profile_start(obs_load_all_modules_name);
+	module_scan_cache_begin();
 	obs_find_modules2(load_all_callback, NULL);
+	module_scan_cache_end();
 #ifdef _WIN32
 	profile_start(reset_win32_symbol_paths_name);
 	reset_win32_symbol_paths();
@@ -381,7 +750,9 @@ void obs_load_all_modules2(struct obs_module_failure_info *mfi)
 	memset(mfi, 0, sizeof(*mfi));
 
 	profile_start(obs_load_all_modules2_name);
+	module_scan_cache_begin();
 	obs_find_modules2(load_all_callback, &fail_info);
+	module_scan_cache_end();
 #ifdef _WIN32
 	profile_start(reset_win32_symbol_paths_name);
 	reset_win32_symbol_paths();
@@ -405,8 +776,11 @@ void obs_module_failure_info_free(struct obs_module_failure_info *mfi)
 void obs_post_load_modules(void)
 {
 	for (obs_module_t *mod = obs->first_module; !!mod; mod = mod->next)
-		if (mod->post_load)
+		if (mod->loaded && mod->post_load)
 			mod->post_load();
+
+	/* lazy modules loaded after this point run post_load themselves */
+	obs->modules_post_loaded = true;
 }
 
 static inline void make_data_dir(struct dstr *parsed_data_dir, const char *data_dir, const char *name)
@@ -505,7 +879,21 @@ static void process_found_module(struct obs_module_path *omp, const char *path,
 		info.bin_path = parsed_bin_path.array;
 		info.data_path = parsed_data_dir;
 		info.name = name.array;
+
+		if (scan_cache_dir) {
+			scan_cache_module = obs_data_create();
+			obs_data_set_string(scan_cache_module, "name", info.name);
+			obs_data_set_string(scan_cache_module, "bin_path", info.bin_path);
+			obs_data_set_string(scan_cache_module, "data_path", info.data_path);
+		}
+
 		callback(param, &info);
+
+		if (scan_cache_dir) {
+			obs_data_array_push_back(scan_cache_dir, scan_cache_module);
+			obs_data_release(scan_cache_module);
+			scan_cache_module = NULL;
+		}
 	}
 
 	bfree(parsed_data_dir);
@@ -513,9 +901,59 @@ static void process_found_module(struct obs_module_path *omp, const char *path,
 	dstr_free(&parsed_bin_path);
 }
 
+/* replays the cached scan of a directory whose mtime is unchanged;
+ * returns false if there is no valid cache entry for it */
+static bool serve_modules_from_cache(struct obs_module_path *omp, const char *dir_path,
+				     obs_find_module_callback2_t callback, void *param)
+{
+	obs_data_array_t *modules;
+	obs_data_t *dir;
+	struct stat st;
+	size_t count;
+
+	dir = scan_cache_find_dir(scan_cache, omp->bin);
+	if (!dir)
+		return false;
+
+	if (os_stat(dir_path, &st) != 0 || (long long)st.st_mtime != obs_data_get_int(dir, "mtime")) {
+		obs_data_release(dir);
+		return false;
+	}
+
+	/* carry the whole entry over; freshly probed manifests may still be
+	 * added to it if a cached module lacked one */
+	scan_cache_add_dir(dir);
+
+	modules = obs_data_get_array(dir, "modules");
+	count = modules ? obs_data_array_count(modules) : 0;
+
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *mod = obs_data_array_item(modules, i);
+		struct obs_module_info2 info = {
+			.name = obs_data_get_string(mod, "name"),
+			.bin_path = obs_data_get_string(mod, "bin_path"),
+			.data_path = obs_data_get_string(mod, "data_path"),
+		};
+
+		scan_cache_module = mod;
+		scan_cache_module_cached = true;
+		callback(param, &info);
+		scan_cache_module = NULL;
+		scan_cache_module_cached = false;
+
+		obs_data_release(mod);
+	}
+
+	obs_data_array_release(modules);
+	obs_data_release(dir);
+	return true;
+}
+
 static void find_modules_in_path(struct obs_module_path *omp, obs_find_module_callback2_t callback, void *param)
 {
 	struct dstr search_path = {0};
+	struct dstr dir_path = {0};
+	obs_data_t *dir_entry = NULL;
 	char *module_start;
 	bool search_directories = false;
 	os_glob_t *gi;
@@ -531,6 +969,24 @@ static void find_modules_in_path(struct obs_module_path *omp, obs_find_module_ca
 	if (!dstr_is_empty(&search_path) && dstr_end(&search_path) != '/')
 		dstr_cat_ch(&search_path, '/');
 
+	dstr_copy_dstr(&dir_path, &search_path);
+
+	if (scan_cache_active && serve_modules_from_cache(omp, dir_path.array, callback, param)) {
+		dstr_free(&dir_path);
+		dstr_free(&search_path);
+		return;
+	}
+
+	if (scan_cache_active) {
+		struct stat st;
+		if (os_stat(dir_path.array, &st) == 0) {
+			dir_entry = obs_data_create();
+			obs_data_set_string(dir_entry, "bin", omp->bin);
+			obs_data_set_int(dir_entry, "mtime", (long long)st.st_mtime);
+			scan_cache_dir = obs_data_array_create();
+		}
+	}
+
 	dstr_cat_ch(&search_path, '*');
 	if (!search_directories)
 		dstr_cat(&search_path, get_module_extension());
@@ -544,6 +1000,15 @@ static void find_modules_in_path(struct obs_module_path *omp, obs_find_module_ca
 		os_globfree(gi);
 	}
 
+	if (dir_entry) {
+		obs_data_set_array(dir_entry, "modules", scan_cache_dir);
+		scan_cache_add_dir(dir_entry);
+		obs_data_array_release(scan_cache_dir);
+		scan_cache_dir = NULL;
+		obs_data_release(dir_entry);
+	}
+
+	dstr_free(&dir_path);
 	dstr_free(&search_path);
 }
 
@@ -582,6 +1047,8 @@ void free_module(struct obs_module *mod)
 	if (!mod)
 		return;
 
+	remove_lazy_module_types(mod);
+
 	if (mod->module) {
 		if (mod->free_locale)
 			mod->free_locale();
@@ -808,6 +1275,11 @@ void obs_register_source_s(const struct obs_source_info *info, size_t size)
 	if (array)
 		da_push_back(*array, &data);
 	da_push_back(obs->source_types, &data);
+
+	struct source_type_item *lookup = bzalloc(sizeof(struct source_type_item));
+	lookup->id = obs->source_types.array[obs->source_types.num - 1].id;
+	lookup->idx = obs->source_types.num - 1;
+	HASH_ADD_KEYPTR(hh, obs->source_type_lookup, lookup->id, strlen(lookup->id), lookup);
 	return;
 
 error:
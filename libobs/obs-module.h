@@ -106,6 +106,32 @@ MODULE_EXPORT void obs_module_unload(void);
 /** Optional: Called when all modules have finished loading */
 MODULE_EXPORT void obs_module_post_load(void);
 
+/** Lists of type IDs a module registers, for lazy module loading.  Each
+ * list is a NULL-terminated array of unversioned IDs, or NULL if the
+ * module registers no types of that kind. */
+struct obs_module_manifest {
+	const char *const *source_ids;
+	const char *const *encoder_ids;
+	const char *const *output_ids;
+};
+
+/**
+ * Optional: Declares the types this module registers without loading it.
+ *
+ * When a module exports this function, obs_module_load() is deferred
+ * until one of the declared types is first looked up or instantiated,
+ * rather than being called at startup.  The manifest must list every
+ * type ID the module registers; types not listed will not trigger the
+ * deferred load and will be missing until something else does.  Modules
+ * that need obs_module_post_load() ordering or register other kinds of
+ * types (services, hotkeys at load time, etc.) should not declare a
+ * manifest.
+ *
+ * @return  The module's manifest; must remain valid for the lifetime of
+ *          the module
+ */
+MODULE_EXPORT const struct obs_module_manifest *obs_module_manifest(void);
+
 /** Called to set the current locale data for the module.  */
 MODULE_EXPORT void obs_module_set_locale(const char *locale);
 
@@ -16,6 +16,11 @@
 ******************************************************************************/
 
 #include "obs-nal.h"
+#include "util/sse-intrin.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 /* NOTE: I noticed that FFmpeg does some unusual special handling of certain
  * scenarios that I was unaware of, so instead of just searching for {0, 0, 1}
@@ -57,10 +62,55 @@ static const uint8_t *ff_avc_find_startcode_internal(const uint8_t *p, const uin
 	return end + 3;
 }
 
+static inline int first_zero_offset(int mask)
+{
+#ifdef _MSC_VER
+	unsigned long offset;
+	_BitScanForward(&offset, (unsigned long)mask);
+	return (int)offset;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
 const uint8_t *obs_nal_find_startcode(const uint8_t *p, const uint8_t *end)
 {
-	const uint8_t *out = ff_avc_find_startcode_internal(p, end);
-	if (p < out && out < end && !out[-1])
+	const uint8_t *const start = p;
+	const uint8_t *out;
+
+	/* a start code contains two consecutive zero bytes, so whole
+	 * 16-byte blocks without a single zero can be skipped outright;
+	 * emulation prevention keeps zeros rare inside entropy-coded
+	 * payload, which makes the skip the common case at high bitrates */
+	while (end - p >= 16 + 3) {
+		const __m128i chunk = _mm_loadu_si128((const __m128i *)p);
+		int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_setzero_si128()));
+
+		if (!mask) {
+			p += 16;
+			continue;
+		}
+
+		/* test the three-byte pattern at each zero in the block;
+		 * this may read up to two bytes past the block, which the
+		 * loop bound guarantees is still inside the buffer */
+		while (mask) {
+			const uint8_t *c = p + first_zero_offset(mask);
+
+			if (c[0] == 0 && c[1] == 0 && c[2] == 1) {
+				if (start < c && !c[-1])
+					c--;
+				return c;
+			}
+
+			mask &= mask - 1;
+		}
+
+		p += 16;
+	}
+
+	out = ff_avc_find_startcode_internal(p, end);
+	if (start < out && out < end && !out[-1])
 		out--;
 	return out;
 }
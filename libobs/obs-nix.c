@@ -446,6 +446,13 @@ bool obs_hotkeys_platform_is_pressed(obs_hotkeys_platform_t *context, obs_key_t
 	return hotkeys_vtable->is_pressed(context, key);
 }
 
+bool obs_hotkeys_platform_input_since_last(obs_hotkeys_platform_t *context)
+{
+	if (hotkeys_vtable->input_since_last)
+		return hotkeys_vtable->input_since_last(context);
+	return true;
+}
+
 void obs_key_to_str(obs_key_t key, struct dstr *dstr)
 {
 	return hotkeys_vtable->key_to_str(key, dstr);
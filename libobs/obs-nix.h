@@ -30,6 +30,11 @@ struct obs_nix_hotkeys_vtable {
 
 	bool (*is_pressed)(obs_hotkeys_platform_t *context, obs_key_t key);
 
+	/* optional; reports whether any input occurred since the previous
+	 * call.  NULL means the platform cannot tell and callers must
+	 * assume input occurred. */
+	bool (*input_since_last)(obs_hotkeys_platform_t *context);
+
 	void (*key_to_str)(obs_key_t key, struct dstr *dstr);
 
 	obs_key_t (*key_from_virtual_key)(int sym);
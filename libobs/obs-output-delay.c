@@ -53,7 +53,7 @@ static inline void push_packet(struct obs_output *output, struct encoder_packet
 	dd.packet_time_valid = packet_time != NULL;
 	if (packet_time != NULL)
 		dd.packet_time = *packet_time;
-	obs_encoder_packet_create_instance(&dd.packet, packet);
+	obs_encoder_packet_ref(&dd.packet, packet);
 
 	pthread_mutex_lock(&output->delay_mutex);
 	deque_push_back(&output->delay_data, &dd, sizeof(dd));
@@ -154,6 +154,16 @@ bool obs_output_delay_start(obs_output_t *output)
 	}
 
 	pthread_mutex_lock(&output->delay_mutex);
+
+	/* reserve the whole delay window up front; a queue holding many
+	 * seconds of packets would otherwise repeatedly grow by copy
+	 * mid-stream, stalling the packet thread */
+	if (output->delay_sec) {
+		double fps = output->video ? video_output_get_frame_rate(output->video) : 0.0;
+		size_t per_sec = (size_t)(fps > 0.0 ? fps : 60.0) + 64; /* video + audio + headroom */
+		deque_reserve(&output->delay_data, (size_t)(output->delay_sec + 1) * per_sec * sizeof(struct delay_data));
+	}
+
 	deque_push_back(&output->delay_data, &dd, sizeof(dd));
 	pthread_mutex_unlock(&output->delay_mutex);
 
@@ -121,11 +121,19 @@ static inline bool log_flag_service(const struct obs_output *output, const char
 
 const struct obs_output_info *find_output(const char *id)
 {
+	bool retried = false;
 	size_t i;
+
+retry:
 	for (i = 0; i < obs->output_types.num; i++)
 		if (strcmp(obs->output_types.array[i].id, id) == 0)
 			return obs->output_types.array + i;
 
+	if (!retried && obs_demand_load_module_type(OBS_OBJ_TYPE_OUTPUT, id)) {
+		retried = true;
+		goto retry;
+	}
+
 	return NULL;
 }
 
@@ -146,6 +154,7 @@ static const char *output_signals[] = {
 	"void deactivate(ptr output)",
 	"void reconnect(ptr output)",
 	"void reconnect_success(ptr output)",
+	"void congestion(ptr output, int bitrate, float congestion)",
 	NULL,
 };
 
@@ -166,10 +175,12 @@ obs_output_t *obs_output_create(const char *id, const char *name, obs_data_t *se
 	int ret;
 
 	output = bzalloc(sizeof(struct obs_output));
+	output->interleave_queues = bzalloc(sizeof(struct interleave_queue) * NUM_INTERLEAVE_QUEUES);
 	pthread_mutex_init_value(&output->interleaved_mutex);
 	pthread_mutex_init_value(&output->delay_mutex);
 	pthread_mutex_init_value(&output->pause.mutex);
 	pthread_mutex_init_value(&output->pkt_callbacks_mutex);
+	pthread_mutex_init_value(&output->cc_mutex);
 
 	if (pthread_mutex_init(&output->interleaved_mutex, NULL) != 0)
 		goto fail;
@@ -179,6 +190,8 @@ obs_output_t *obs_output_create(const char *id, const char *name, obs_data_t *se
 		goto fail;
 	if (pthread_mutex_init(&output->pkt_callbacks_mutex, NULL) != 0)
 		goto fail;
+	if (pthread_mutex_init(&output->cc_mutex, NULL) != 0)
+		goto fail;
 	if (os_event_init(&output->stopping_event, OS_EVENT_TYPE_MANUAL) != 0)
 		goto fail;
 	if (!init_output_handlers(output, name, settings, hotkey_data))
@@ -231,6 +244,20 @@ static inline void free_packets(struct obs_output *output)
 	for (size_t i = 0; i < output->interleaved_packets.num; i++)
 		obs_encoder_packet_release(output->interleaved_packets.array + i);
 	da_free(output->interleaved_packets);
+
+	if (output->interleave_queues) {
+		for (size_t i = 0; i < NUM_INTERLEAVE_QUEUES; i++) {
+			struct interleave_queue *q = &output->interleave_queues[i];
+			long read = os_atomic_load_long(&q->read_pos);
+
+			while (read != os_atomic_load_long(&q->write_pos)) {
+				obs_encoder_packet_release(&q->items[read & (INTERLEAVE_QUEUE_SIZE - 1)].packet);
+				read++;
+			}
+
+			os_atomic_set_long(&q->read_pos, read);
+		}
+	}
 }
 
 static inline void clear_raw_audio_buffers(obs_output_t *output)
@@ -242,6 +269,22 @@ static inline void clear_raw_audio_buffers(obs_output_t *output)
 	}
 }
 
+static void caption_sei_release(struct caption_sei *sei)
+{
+	if (!sei || os_atomic_dec_long(&sei->refs) != 0)
+		return;
+
+	bfree(sei->avc_sei);
+	bfree(sei->t35);
+	bfree(sei);
+}
+
+static void caption_text_free(struct caption_text *text)
+{
+	caption_sei_release(text->sei);
+	bfree(text);
+}
+
 static void destroy_caption_track(struct caption_track_data **ctrack_ptr)
 {
 	if (!ctrack_ptr || !*ctrack_ptr) {
@@ -301,11 +344,14 @@ void obs_output_destroy(obs_output_t *output)
 
 		clear_raw_audio_buffers(output);
 
+		bfree(output->interleave_queues);
+
 		os_event_destroy(output->stopping_event);
 		pthread_mutex_destroy(&output->pause.mutex);
 		pthread_mutex_destroy(&output->interleaved_mutex);
 		pthread_mutex_destroy(&output->delay_mutex);
 		pthread_mutex_destroy(&output->pkt_callbacks_mutex);
+		pthread_mutex_destroy(&output->cc_mutex);
 		os_event_destroy(output->reconnect_stop_event);
 		obs_context_data_free(&output->context);
 		deque_free(&output->delay_data);
@@ -353,6 +399,7 @@ bool obs_output_actual_start(obs_output_t *output)
 		ctrack->caption_timestamp = 0;
 		deque_free(&ctrack->caption_data);
 		deque_init(&ctrack->caption_data);
+		os_atomic_store_bool(&ctrack->captions_pending, !!ctrack->caption_head);
 		pthread_mutex_unlock(&ctrack->caption_mutex);
 	}
 
@@ -485,7 +532,7 @@ void obs_output_actual_stop(obs_output_t *output, bool force, uint64_t ts)
 		}
 		while (ctrack->caption_head) {
 			ctrack->caption_tail = ctrack->caption_head->next;
-			bfree(ctrack->caption_head);
+			caption_text_free(ctrack->caption_head);
 			ctrack->caption_head = ctrack->caption_tail;
 		}
 	}
@@ -1462,21 +1509,15 @@ static size_t extract_buffer_from_sei(sei_t *sei, uint8_t **data_out)
 }
 
 static const uint8_t nal_start[4] = {0, 0, 0, 1};
-static bool add_caption(struct obs_output *output, struct encoder_packet *out)
+static bool insert_caption_sei(struct encoder_packet *out, const uint8_t *sei_data, size_t sei_size,
+			       const uint8_t *t35, size_t t35_size)
 {
 	struct encoder_packet backup = *out;
-	sei_t sei;
-	uint8_t *data = NULL;
-	size_t size;
 	long ref = 1;
 	bool avc = false;
 	bool hevc = false;
 	bool av1 = false;
 
-	/* Instead of exiting early for unsupported codecs, we will continue
-	 * processing to allow the freeing of caption data even if the captions
-	 * will not be included in the bitstream due to being unimplemented in
-	 * the given codec. */
 	if (strcmp(out->encoder->info.codec, "h264") == 0) {
 		avc = true;
 	} else if (strcmp(out->encoder->info.codec, "av1") == 0) {
@@ -1487,17 +1528,9 @@ static bool add_caption(struct obs_output *output, struct encoder_packet *out)
 #endif
 	}
 
-	DARRAY(uint8_t) out_data;
-
-	if (out->priority > 1)
+	if (!avc && !hevc && !av1)
 		return false;
 
-	struct caption_track_data *ctrack = output->caption_tracks[out->track_idx];
-	if (!ctrack) {
-		blog(LOG_DEBUG, "Caption track for index: %lu has not been initialized", out->track_idx);
-		return false;
-	}
-
 #ifdef ENABLE_HEVC
 	uint8_t hevc_nal_header[2];
 	if (hevc) {
@@ -1522,126 +1555,143 @@ static bool add_caption(struct obs_output *output, struct encoder_packet *out)
 		hevc_nal_header[1] = out->data[nal_header_index_start + 1];
 	}
 #endif
-	sei_init(&sei, 0.0);
 
+	DARRAY(uint8_t) out_data;
 	da_init(out_data);
 	da_push_back_array(out_data, (uint8_t *)&ref, sizeof(ref));
 	da_push_back_array(out_data, out->data, out->size);
 
-	if (ctrack->caption_data.size > 0) {
+	/* In each of these specs there is an identical structure that
+	 * carries caption information. It is named slightly differently
+	 * in each one. The metadata_itut_t35 in AV1 or the
+	 * user_data_registered_itu_t_t35 in HEVC/AVC. We have an AVC
+	 * SEI wrapped version of that here. We will strip it out and
+	 * repackage it slightly to fit the different codec carrying
+	 * mechanisms. A slightly modified SEI for HEVC and a metadata
+	 * OBU for AV1. */
+	if (avc) {
+		/* TODO: SEI should come after AUD/SPS/PPS,
+		 * but before any VCL */
+		da_push_back_array(out_data, nal_start, 4);
+		da_push_back_array(out_data, sei_data, sei_size);
+#ifdef ENABLE_HEVC
+	} else if (hevc) {
+		/* Only first NAL (VPS/PPS/SPS) should use the 4 byte
+		 * start code. SEIs use 3 byte version */
+		da_push_back_array(out_data, nal_start + 1, 3);
+		/* nal_unit_header( ) {
+		 * forbidden_zero_bit       f(1)
+		 * nal_unit_type            u(6)
+		 * nuh_layer_id             u(6)
+		 * nuh_temporal_id_plus1    u(3)
+		 * }
+		 */
+		const uint8_t prefix_sei_nal_type = 39;
+		/* The first bit is always 0, so we just need to
+		 * save the last bit off the original header and
+		 * add the SEI NAL type. */
+		uint8_t first_byte = (prefix_sei_nal_type << 1) | (0x01 & hevc_nal_header[0]);
+		hevc_nal_header[0] = first_byte;
+		/* The HEVC NAL unit header is 2 byte instead of
+		 * one, otherwise everything else is the
+		 * same. */
+		da_push_back_array(out_data, hevc_nal_header, 2);
+		da_push_back_array(out_data, &sei_data[1], sei_size - 1);
+#endif
+	} else if (av1) {
+		uint8_t *obu_buffer = NULL;
+		size_t obu_buffer_size = 0;
+		metadata_obu((uint8_t *)t35, t35_size, &obu_buffer, &obu_buffer_size, METADATA_TYPE_ITUT_T35);
+		if (obu_buffer) {
+			da_push_back_array(out_data, obu_buffer, obu_buffer_size);
+			bfree(obu_buffer);
+		}
+	}
 
-		cea708_t cea708;
-		cea708_init(&cea708, 0); // set up a new popon frame
-		void *caption_buf = bzalloc(3 * sizeof(uint8_t));
+	obs_encoder_packet_release(out);
 
-		while (ctrack->caption_data.size > 0) {
-			deque_pop_front(&ctrack->caption_data, caption_buf, 3 * sizeof(uint8_t));
+	*out = backup;
+	out->data = (uint8_t *)out_data.array + sizeof(ref);
+	out->size = out_data.num - sizeof(ref);
+	return true;
+}
 
-			if ((((uint8_t *)caption_buf)[0] & 0x3) != 0) {
-				// only send cea 608
-				continue;
-			}
+/* Renders the SEI payloads for a caption text once at submission time,
+ * so the output thread never encodes captions itself. */
+static struct caption_sei *caption_sei_create(const char *text)
+{
+	caption_frame_t cf;
+	sei_t sei;
 
-			uint16_t captionData = ((uint8_t *)caption_buf)[1];
-			captionData = captionData << 8;
-			captionData += ((uint8_t *)caption_buf)[2];
+	caption_frame_init(&cf);
+	caption_frame_from_text(&cf, text);
 
-			// padding
-			if (captionData == 0x8080) {
-				continue;
-			}
+	sei_init(&sei, 0.0);
+	sei_from_caption_frame(&sei, &cf);
 
-			if (captionData == 0) {
-				continue;
-			}
+	struct caption_sei *cs = bzalloc(sizeof(*cs));
+	cs->refs = 1;
+	cs->avc_sei = bmalloc(sei_render_size(&sei));
+	cs->avc_size = sei_render(&sei, cs->avc_sei);
+	cs->t35_size = extract_buffer_from_sei(&sei, &cs->t35);
 
-			if (!eia608_parity_varify(captionData)) {
-				continue;
-			}
+	sei_free(&sei);
+	return cs;
+}
 
-			cea708_add_cc_data(&cea708, 1, ((uint8_t *)caption_buf)[0] & 0x3, captionData);
-		}
+static bool add_caption_cc_data(struct encoder_packet *out, struct deque *cc_data)
+{
+	sei_t sei;
+	cea708_t cea708;
+	uint8_t caption_buf[3];
 
-		bfree(caption_buf);
+	cea708_init(&cea708, 0); // set up a new popon frame
 
-		sei_message_t *msg = sei_message_new(sei_type_user_data_registered_itu_t_t35, 0, CEA608_MAX_SIZE);
-		msg->size = cea708_render(&cea708, sei_message_data(msg), sei_message_size(msg));
-		sei_message_append(&sei, msg);
-	} else if (ctrack->caption_head) {
-		caption_frame_t cf;
-		caption_frame_init(&cf);
-		caption_frame_from_text(&cf, &ctrack->caption_head->text[0]);
+	while (cc_data->size > 0) {
+		deque_pop_front(cc_data, caption_buf, sizeof(caption_buf));
 
-		sei_from_caption_frame(&sei, &cf);
+		if ((caption_buf[0] & 0x3) != 0) {
+			// only send cea 608
+			continue;
+		}
 
-		struct caption_text *next = ctrack->caption_head->next;
-		bfree(ctrack->caption_head);
-		ctrack->caption_head = next;
-	}
+		uint16_t captionData = caption_buf[1];
+		captionData = captionData << 8;
+		captionData += caption_buf[2];
 
-	if (avc || hevc || av1) {
-		if (avc || hevc) {
-			data = bmalloc(sei_render_size(&sei));
-			size = sei_render(&sei, data);
+		// padding
+		if (captionData == 0x8080) {
+			continue;
 		}
-		/* In each of these specs there is an identical structure that
-		 * carries caption information. It is named slightly differently
-		 * in each one. The metadata_itut_t35 in AV1 or the
-		 * user_data_registered_itu_t_t35 in HEVC/AVC. We have an AVC
-		 * SEI wrapped version of that here. We will strip it out and
-		 * repackage it slightly to fit the different codec carrying
-		 * mechanisms. A slightly modified SEI for HEVC and a metadata
-		 * OBU for AV1. */
-		if (avc) {
-			/* TODO: SEI should come after AUD/SPS/PPS,
-			 * but before any VCL */
-			da_push_back_array(out_data, nal_start, 4);
-			da_push_back_array(out_data, data, size);
-#ifdef ENABLE_HEVC
-		} else if (hevc) {
-			/* Only first NAL (VPS/PPS/SPS) should use the 4 byte
-			 * start code. SEIs use 3 byte version */
-			da_push_back_array(out_data, nal_start + 1, 3);
-			/* nal_unit_header( ) {
-			 * forbidden_zero_bit       f(1)
-			 * nal_unit_type            u(6)
-			 * nuh_layer_id             u(6)
-			 * nuh_temporal_id_plus1    u(3)
-			 * }
-			 */
-			const uint8_t prefix_sei_nal_type = 39;
-			/* The first bit is always 0, so we just need to
-			 * save the last bit off the original header and
-			 * add the SEI NAL type. */
-			uint8_t first_byte = (prefix_sei_nal_type << 1) | (0x01 & hevc_nal_header[0]);
-			hevc_nal_header[0] = first_byte;
-			/* The HEVC NAL unit header is 2 byte instead of
-			 * one, otherwise everything else is the
-			 * same. */
-			da_push_back_array(out_data, hevc_nal_header, 2);
-			da_push_back_array(out_data, &data[1], size - 1);
-#endif
-		} else if (av1) {
-			uint8_t *obu_buffer = NULL;
-			size_t obu_buffer_size = 0;
-			size = extract_buffer_from_sei(&sei, &data);
-			metadata_obu(data, size, &obu_buffer, &obu_buffer_size, METADATA_TYPE_ITUT_T35);
-			if (obu_buffer) {
-				da_push_back_array(out_data, obu_buffer, obu_buffer_size);
-				bfree(obu_buffer);
-			}
+
+		if (captionData == 0) {
+			continue;
 		}
-		if (data) {
-			bfree(data);
+
+		if (!eia608_parity_varify(captionData)) {
+			continue;
 		}
-		obs_encoder_packet_release(out);
 
-		*out = backup;
-		out->data = (uint8_t *)out_data.array + sizeof(ref);
-		out->size = out_data.num - sizeof(ref);
+		cea708_add_cc_data(&cea708, 1, caption_buf[0] & 0x3, captionData);
 	}
+
+	sei_init(&sei, 0.0);
+
+	sei_message_t *msg = sei_message_new(sei_type_user_data_registered_itu_t_t35, 0, CEA608_MAX_SIZE);
+	msg->size = cea708_render(&cea708, sei_message_data(msg), sei_message_size(msg));
+	sei_message_append(&sei, msg);
+
+	uint8_t *avc_data = bmalloc(sei_render_size(&sei));
+	size_t avc_size = sei_render(&sei, avc_data);
+	uint8_t *t35 = NULL;
+	size_t t35_size = extract_buffer_from_sei(&sei, &t35);
+
+	const bool inserted = insert_caption_sei(out, avc_data, avc_size, t35, t35_size);
+
+	bfree(t35);
+	bfree(avc_data);
 	sei_free(&sei);
-	return avc || hevc || av1;
+	return inserted;
 }
 
 static inline void send_interleaved(struct obs_output *output)
@@ -1661,29 +1711,49 @@ static inline void send_interleaved(struct obs_output *output)
 	if (out.type == OBS_ENCODER_VIDEO) {
 		output->total_frames++;
 
-		pthread_mutex_lock(&output->caption_tracks[out.track_idx]->caption_mutex);
-
-		double frame_timestamp = (out.pts * out.timebase_num) / (double)out.timebase_den;
-
 		struct caption_track_data *ctrack = output->caption_tracks[out.track_idx];
 
-		if (ctrack->caption_head && ctrack->caption_timestamp <= frame_timestamp) {
-			blog(LOG_DEBUG, "Sending caption: %f \"%s\"", frame_timestamp, &ctrack->caption_head->text[0]);
+		/* the pending flag is checked without the mutex so that
+		 * caption-less outputs never lock on the packet path */
+		if (ctrack && out.priority <= 1 && os_atomic_load_bool(&ctrack->captions_pending)) {
+			double frame_timestamp = (out.pts * out.timebase_num) / (double)out.timebase_den;
+			struct caption_text *text = NULL;
+			struct deque cc_data = {0};
 
-			double display_duration = ctrack->caption_head->display_duration;
+			pthread_mutex_lock(&ctrack->caption_mutex);
 
-			if (add_caption(output, &out)) {
-				ctrack->caption_timestamp = frame_timestamp + display_duration;
+			if (ctrack->caption_data.size > 0) {
+				if (ctrack->last_caption_timestamp < frame_timestamp) {
+					ctrack->last_caption_timestamp = frame_timestamp;
+					cc_data = ctrack->caption_data;
+					deque_init(&ctrack->caption_data);
+				}
+			} else if (ctrack->caption_head && ctrack->caption_timestamp <= frame_timestamp) {
+				text = ctrack->caption_head;
+				ctrack->caption_head = text->next;
+				if (!ctrack->caption_head)
+					ctrack->caption_tail = NULL;
 			}
-		}
 
-		if (ctrack->caption_data.size > 0) {
-			if (ctrack->last_caption_timestamp < frame_timestamp) {
-				ctrack->last_caption_timestamp = frame_timestamp;
-				add_caption(output, &out);
+			if (!ctrack->caption_data.size && !ctrack->caption_head)
+				os_atomic_store_bool(&ctrack->captions_pending, false);
+
+			pthread_mutex_unlock(&ctrack->caption_mutex);
+
+			/* SEI insertion happens without the mutex held */
+			if (text) {
+				blog(LOG_DEBUG, "Sending caption: %f \"%s\"", frame_timestamp, &text->text[0]);
+
+				if (insert_caption_sei(&out, text->sei->avc_sei, text->sei->avc_size, text->sei->t35,
+						       text->sei->t35_size))
+					ctrack->caption_timestamp = frame_timestamp + text->display_duration;
+
+				caption_text_free(text);
+			} else if (cc_data.size > 0) {
+				add_caption_cc_data(&out, &cc_data);
+				deque_free(&cc_data);
 			}
 		}
-		pthread_mutex_unlock(&ctrack->caption_mutex);
 
 		/* Iterate the array of encoder packet times to
 		 * find a matching PTS entry, and drain the array.
@@ -2153,28 +2223,19 @@ static void apply_ept_offsets(struct obs_output *output)
 	}
 }
 
-static void interleave_packets(void *data, struct encoder_packet *packet, struct encoder_packet_time *packet_time)
+/* runs the actual interleave logic for one dequeued packet; called with the
+ * interleaved mutex held, and always consumes the item's packet reference */
+static void process_interleaved_packet(struct obs_output *output, struct interleave_item *item)
 {
-	struct obs_output *output = data;
-	struct encoder_packet out;
+	struct encoder_packet out = item->packet;
 	bool was_started;
 	bool received_video;
 	struct encoder_packet_time *output_packet_time = NULL;
 
-	if (!active(output))
-		return;
-
-	packet->track_idx = get_encoder_index(output, packet);
-
-	pthread_mutex_lock(&output->interleaved_mutex);
-
 	/* if first video frame is not a keyframe, discard until received */
-	if (packet->type == OBS_ENCODER_VIDEO && !output->received_video[packet->track_idx] && !packet->keyframe) {
-		discard_unused_audio_packets(output, packet->dts_usec);
-		pthread_mutex_unlock(&output->interleaved_mutex);
-
-		if (output->active_delay_ns)
-			obs_encoder_packet_release(packet);
+	if (out.type == OBS_ENCODER_VIDEO && !output->received_video[out.track_idx] && !out.keyframe) {
+		discard_unused_audio_packets(output, out.dts_usec);
+		obs_encoder_packet_release(&out);
 		return;
 	}
 
@@ -2184,24 +2245,19 @@ static void interleave_packets(void *data, struct encoder_packet *packet, struct
 			received_video = received_video && output->received_video[i];
 	}
 
-	check_encoder_group_keyframe_alignment(output, packet);
+	check_encoder_group_keyframe_alignment(output, &out);
 
 	was_started = output->received_audio && received_video;
 
-	if (output->active_delay_ns)
-		out = *packet;
-	else
-		obs_encoder_packet_create_instance(&out, packet);
-
-	if (packet_time) {
-		output_packet_time = da_push_back_new(output->encoder_packet_times[packet->track_idx]);
-		*output_packet_time = *packet_time;
+	if (item->has_packet_time) {
+		output_packet_time = da_push_back_new(output->encoder_packet_times[out.track_idx]);
+		*output_packet_time = item->packet_time;
 	}
 
 	if (was_started)
 		apply_interleaved_packet_offset(output, &out, output_packet_time);
 	else
-		check_received(output, packet);
+		check_received(output, &out);
 
 	insert_interleaved_packet(output, &out);
 
@@ -2228,10 +2284,115 @@ static void interleave_packets(void *data, struct encoder_packet *packet, struct
 			send_interleaved(output);
 		}
 	}
+}
+
+static inline size_t interleave_queue_idx(const struct encoder_packet *packet)
+{
+	return packet->type == OBS_ENCODER_VIDEO ? packet->track_idx : MAX_OUTPUT_VIDEO_ENCODERS + packet->track_idx;
+}
+
+static inline bool interleave_queues_empty(struct obs_output *output)
+{
+	for (size_t i = 0; i < NUM_INTERLEAVE_QUEUES; i++) {
+		struct interleave_queue *q = &output->interleave_queues[i];
+
+		if (os_atomic_load_long(&q->read_pos) != os_atomic_load_long(&q->write_pos))
+			return false;
+	}
+
+	return true;
+}
+
+/* k-way merge of the per-track queues: always consumes the queued packet
+ * with the lowest DTS first */
+static void drain_interleave_queues(struct obs_output *output)
+{
+	pthread_mutex_lock(&output->interleaved_mutex);
+
+	for (;;) {
+		struct interleave_queue *best = NULL;
+		struct interleave_item *best_item = NULL;
+
+		for (size_t i = 0; i < NUM_INTERLEAVE_QUEUES; i++) {
+			struct interleave_queue *q = &output->interleave_queues[i];
+			long read = os_atomic_load_long(&q->read_pos);
+			struct interleave_item *item;
+
+			if (read == os_atomic_load_long(&q->write_pos))
+				continue;
+
+			item = &q->items[read & (INTERLEAVE_QUEUE_SIZE - 1)];
+			if (!best_item || item->packet.dts_usec < best_item->packet.dts_usec) {
+				best = q;
+				best_item = item;
+			}
+		}
+
+		if (!best)
+			break;
+
+		process_interleaved_packet(output, best_item);
+		os_atomic_inc_long(&best->read_pos);
+	}
 
 	pthread_mutex_unlock(&output->interleaved_mutex);
 }
 
+/* Encoder threads only push into their own track's SPSC ring here and then
+ * race for the merge flag, so they no longer contend on a shared mutex with
+ * every other encoder's submission path.  Whichever thread wins the flag
+ * drains all queues; losers are covered by the winner's re-check after it
+ * releases the flag. */
+static void interleave_packets(void *data, struct encoder_packet *packet, struct encoder_packet_time *packet_time)
+{
+	struct obs_output *output = data;
+	struct interleave_queue *q;
+	struct interleave_item *item;
+	long write;
+
+	if (!active(output))
+		return;
+
+	packet->track_idx = get_encoder_index(output, packet);
+
+	q = &output->interleave_queues[interleave_queue_idx(packet)];
+
+	for (;;) {
+		write = os_atomic_load_long(&q->write_pos);
+		if (write - os_atomic_load_long(&q->read_pos) < INTERLEAVE_QUEUE_SIZE)
+			break;
+
+		/* ring full: the merge stage is behind, so help it along */
+		if (os_atomic_compare_swap_long(&output->interleave_merging, 0, 1)) {
+			drain_interleave_queues(output);
+			os_atomic_set_long(&output->interleave_merging, 0);
+		} else {
+			os_sleep_ms(1);
+		}
+	}
+
+	item = &q->items[write & (INTERLEAVE_QUEUE_SIZE - 1)];
+
+	if (output->active_delay_ns)
+		item->packet = *packet; /* takes over the delay queue's reference */
+	else
+		obs_encoder_packet_ref(&item->packet, packet);
+
+	item->has_packet_time = !!packet_time;
+	if (packet_time)
+		item->packet_time = *packet_time;
+
+	os_atomic_store_long(&q->write_pos, write + 1);
+
+	while (os_atomic_compare_swap_long(&output->interleave_merging, 0, 1)) {
+		drain_interleave_queues(output);
+		os_atomic_set_long(&output->interleave_merging, 0);
+
+		if (interleave_queues_empty(output))
+			break;
+	}
+}
+
 static void default_encoded_callback(void *param, struct encoder_packet *packet,
 				     struct encoder_packet_time *packet_time)
 {
@@ -2503,32 +2664,79 @@ bool obs_output_can_begin_data_capture(const obs_output_t *output, uint32_t flag
 	return can_begin_data_capture(output);
 }
 
-static inline bool initialize_audio_encoders(obs_output_t *output)
+struct encoder_init_task {
+	obs_encoder_t *encoder;
+	pthread_t thread;
+	bool threaded;
+	bool success;
+};
+
+static void *encoder_init_thread(void *param)
 {
-	for (size_t i = 0; i < MAX_OUTPUT_AUDIO_ENCODERS; i++) {
-		obs_encoder_t *audio = output->audio_encoders[i];
+	struct encoder_init_task *task = param;
 
-		if (audio && !obs_encoder_initialize(audio)) {
-			obs_output_set_last_error(output, obs_encoder_get_last_error(audio));
-			return false;
+	os_set_thread_name("output: encoder init");
+	task->success = obs_encoder_initialize(task->encoder);
+	return NULL;
+}
+
+/* Initializes all of the output's encoders in parallel.  Encoder session
+ * creation (particularly hardware encoders) can take hundreds of
+ * milliseconds each, which adds up with multiple video tracks; each
+ * encoder is already guarded by its own init_mutex. */
+static bool initialize_encoders(obs_output_t *output)
+{
+	struct encoder_init_task tasks[MAX_OUTPUT_VIDEO_ENCODERS + MAX_OUTPUT_AUDIO_ENCODERS];
+	size_t num = 0;
+	bool success = true;
+
+	if (flag_video(output)) {
+		for (size_t i = 0; i < MAX_OUTPUT_VIDEO_ENCODERS; i++) {
+			obs_encoder_t *video = output->video_encoders[i];
+			if (video)
+				tasks[num++].encoder = video;
 		}
 	}
 
-	return true;
-}
+	if (flag_audio(output)) {
+		for (size_t i = 0; i < MAX_OUTPUT_AUDIO_ENCODERS; i++) {
+			obs_encoder_t *audio = output->audio_encoders[i];
+			if (audio)
+				tasks[num++].encoder = audio;
+		}
+	}
 
-static inline bool initialize_video_encoders(obs_output_t *output)
-{
-	for (size_t i = 0; i < MAX_OUTPUT_VIDEO_ENCODERS; i++) {
-		obs_encoder_t *video = output->video_encoders[i];
+	if (!num)
+		return true;
 
-		if (video && !obs_encoder_initialize(video)) {
-			obs_output_set_last_error(output, obs_encoder_get_last_error(video));
+	if (num == 1) {
+		obs_encoder_t *encoder = tasks[0].encoder;
+		if (!obs_encoder_initialize(encoder)) {
+			obs_output_set_last_error(output, obs_encoder_get_last_error(encoder));
 			return false;
 		}
+		return true;
+	}
+
+	for (size_t i = 0; i < num; i++) {
+		struct encoder_init_task *task = &tasks[i];
+		task->threaded = pthread_create(&task->thread, NULL, encoder_init_thread, task) == 0;
+		if (!task->threaded)
+			task->success = obs_encoder_initialize(task->encoder);
+	}
+
+	for (size_t i = 0; i < num; i++) {
+		struct encoder_init_task *task = &tasks[i];
+		if (task->threaded)
+			pthread_join(task->thread, NULL);
+
+		if (!task->success && success) {
+			obs_output_set_last_error(output, obs_encoder_get_last_error(task->encoder));
+			success = false;
+		}
 	}
 
-	return true;
+	return success;
 }
 
 static inline void pair_encoders(obs_output_t *output)
@@ -2572,12 +2780,7 @@ bool obs_output_initialize_encoders(obs_output_t *output, uint32_t flags)
 	if (active(output))
 		return delay_active(output);
 
-	if (flag_video(output) && !initialize_video_encoders(output))
-		return false;
-	if (flag_audio(output) && !initialize_audio_encoders(output))
-		return false;
-
-	return true;
+	return initialize_encoders(output);
 }
 
 static bool begin_delayed_capture(obs_output_t *output)
@@ -3001,17 +3204,22 @@ void obs_output_caption(obs_output_t *output, const struct obs_source_cea_708 *c
 		for (size_t i = 0; i < captions->packets; i++) {
 			deque_push_back(&ctrack->caption_data, captions->data + (i * 3), 3 * sizeof(uint8_t));
 		}
+		os_atomic_store_bool(&ctrack->captions_pending, true);
 		pthread_mutex_unlock(&ctrack->caption_mutex);
 	}
 }
 
-static struct caption_text *caption_text_new(const char *text, size_t bytes, struct caption_text *tail,
-					     struct caption_text **head, double display_duration)
+static struct caption_text *caption_text_new(const char *text, size_t bytes, struct caption_sei *sei,
+					     struct caption_text *tail, struct caption_text **head,
+					     double display_duration)
 {
 	struct caption_text *next = bzalloc(sizeof(struct caption_text));
 	snprintf(&next->text[0], CAPTION_LINE_BYTES + 1, "%.*s", (int)bytes, text);
 	next->display_duration = display_duration;
 
+	os_atomic_inc_long(&sei->refs);
+	next->sei = sei;
+
 	if (!*head) {
 		*head = next;
 	} else {
@@ -3039,6 +3247,12 @@ void obs_output_output_caption_text2(obs_output_t *output, const char *text, dou
 	int size = (int)strlen(text);
 	blog(LOG_DEBUG, "Caption text: %s", text);
 
+	/* render the SEI once on the submitting thread; every track shares
+	 * the pre-encoded payloads */
+	char truncated[CAPTION_LINE_BYTES + 1];
+	snprintf(truncated, sizeof(truncated), "%.*s", size, text);
+	struct caption_sei *sei = caption_sei_create(truncated);
+
 	for (size_t i = 0; i < MAX_OUTPUT_VIDEO_ENCODERS; i++) {
 		struct caption_track_data *ctrack = output->caption_tracks[i];
 		if (!ctrack) {
@@ -3046,11 +3260,177 @@ void obs_output_output_caption_text2(obs_output_t *output, const char *text, dou
 		}
 		pthread_mutex_lock(&ctrack->caption_mutex);
 
-		ctrack->caption_tail =
-			caption_text_new(text, size, ctrack->caption_tail, &ctrack->caption_head, display_duration);
+		ctrack->caption_tail = caption_text_new(text, size, sei, ctrack->caption_tail, &ctrack->caption_head,
+							display_duration);
+		os_atomic_store_bool(&ctrack->captions_pending, true);
 
 		pthread_mutex_unlock(&ctrack->caption_mutex);
 	}
+
+	caption_sei_release(sei);
+}
+
+/* AIMD congestion control tunables */
+#define CC_QUEUE_CONGESTED_USEC 500000 /* queue depth considered congested */
+#define CC_RTT_SLACK_USEC 50000        /* RTT above 2x base + slack is congested */
+#define CC_DECREASE_INTERVAL_NS 2000000000ULL
+#define CC_INCREASE_DELAY_NS 4000000000ULL
+
+static bool cc_apply_bitrate(obs_output_t *output, long bitrate)
+{
+	obs_encoder_t *vencoder = obs_output_get_video_encoder(output);
+	obs_data_t *settings;
+
+	if (!vencoder)
+		return false;
+
+	settings = obs_encoder_get_settings(vencoder);
+	obs_data_set_int(settings, "bitrate", bitrate);
+	obs_encoder_update(vencoder, settings);
+	obs_data_release(settings);
+	return true;
+}
+
+/* seeds the controller from the video encoder the first time a sample comes
+ * in after being enabled; returns false if the encoder cannot be driven */
+static bool cc_init(obs_output_t *output, uint64_t now)
+{
+	obs_encoder_t *vencoder = obs_output_get_video_encoder(output);
+	obs_data_t *settings;
+	long bitrate;
+
+	if (!vencoder || (obs_encoder_get_caps(vencoder) & OBS_ENCODER_CAP_DYN_BITRATE) == 0)
+		return false;
+
+	settings = obs_encoder_get_settings(vencoder);
+	bitrate = (long)obs_data_get_int(settings, "bitrate");
+	obs_data_release(settings);
+
+	if (!bitrate)
+		return false;
+
+	output->cc_orig_bitrate = bitrate;
+	output->cc_cur_bitrate = bitrate;
+	output->cc_min_bitrate = bitrate / 4;
+	if (output->cc_min_bitrate < 50)
+		output->cc_min_bitrate = 50;
+	output->cc_inc_bitrate = bitrate / 10;
+	if (output->cc_inc_bitrate < 50)
+		output->cc_inc_bitrate = 50;
+	output->cc_base_rtt_usec = 0;
+	output->cc_last_decrease_ns = 0;
+	output->cc_clean_since_ns = now;
+	output->cc_congestion = 0.0f;
+	output->cc_active = true;
+	return true;
+}
+
+void obs_output_enable_congestion_control(obs_output_t *output, bool enable)
+{
+	if (!obs_output_valid(output, "obs_output_enable_congestion_control"))
+		return;
+
+	pthread_mutex_lock(&output->cc_mutex);
+	output->cc_enabled = enable;
+	output->cc_active = false;
+	pthread_mutex_unlock(&output->cc_mutex);
+}
+
+bool obs_output_congestion_control_enabled(const obs_output_t *output)
+{
+	if (!obs_output_valid(output, "obs_output_congestion_control_enabled"))
+		return false;
+
+	return output->cc_enabled;
+}
+
+long obs_output_get_congestion_control_bitrate(const obs_output_t *output)
+{
+	if (!obs_output_valid(output, "obs_output_get_congestion_control_bitrate"))
+		return 0;
+
+	return output->cc_active ? output->cc_cur_bitrate : 0;
+}
+
+void obs_output_submit_congestion_sample(obs_output_t *output, uint64_t queued_usec, uint64_t rtt_usec)
+{
+	long new_bitrate = 0;
+	float congestion;
+	bool congested;
+	uint64_t now;
+
+	if (!obs_output_valid(output, "obs_output_submit_congestion_sample"))
+		return;
+
+	pthread_mutex_lock(&output->cc_mutex);
+
+	if (!output->cc_enabled) {
+		pthread_mutex_unlock(&output->cc_mutex);
+		return;
+	}
+
+	now = os_gettime_ns();
+
+	if (!output->cc_active && !cc_init(output, now)) {
+		output->cc_enabled = false;
+		pthread_mutex_unlock(&output->cc_mutex);
+		blog(LOG_WARNING,
+		     "obs_output_submit_congestion_sample: "
+		     "video encoder does not support dynamic bitrate, "
+		     "congestion control disabled");
+		return;
+	}
+
+	/* track the uncongested path RTT as the minimum sample seen */
+	if (rtt_usec && (!output->cc_base_rtt_usec || rtt_usec < output->cc_base_rtt_usec))
+		output->cc_base_rtt_usec = rtt_usec;
+
+	congested = queued_usec >= CC_QUEUE_CONGESTED_USEC;
+	if (rtt_usec && output->cc_base_rtt_usec && rtt_usec >= output->cc_base_rtt_usec * 2 + CC_RTT_SLACK_USEC)
+		congested = true;
+
+	congestion = (float)queued_usec / (float)CC_QUEUE_CONGESTED_USEC;
+	if (congestion > 1.0f)
+		congestion = 1.0f;
+	output->cc_congestion = congestion;
+
+	if (congested) {
+		output->cc_clean_since_ns = now;
+
+		/* multiplicative decrease, rate limited */
+		if (output->cc_cur_bitrate > output->cc_min_bitrate &&
+		    now - output->cc_last_decrease_ns >= CC_DECREASE_INTERVAL_NS) {
+			output->cc_cur_bitrate = output->cc_cur_bitrate * 3 / 4;
+			if (output->cc_cur_bitrate < output->cc_min_bitrate)
+				output->cc_cur_bitrate = output->cc_min_bitrate;
+			output->cc_last_decrease_ns = now;
+			new_bitrate = output->cc_cur_bitrate;
+		}
+	} else if (output->cc_cur_bitrate < output->cc_orig_bitrate &&
+		   now - output->cc_clean_since_ns >= CC_INCREASE_DELAY_NS) {
+		/* additive increase after a sustained clean period */
+		output->cc_cur_bitrate += output->cc_inc_bitrate;
+		if (output->cc_cur_bitrate > output->cc_orig_bitrate)
+			output->cc_cur_bitrate = output->cc_orig_bitrate;
+		output->cc_clean_since_ns = now;
+		new_bitrate = output->cc_cur_bitrate;
+	}
+
+	pthread_mutex_unlock(&output->cc_mutex);
+
+	if (new_bitrate && cc_apply_bitrate(output, new_bitrate)) {
+		struct calldata params;
+		uint8_t stack[128];
+
+		blog(LOG_INFO, "output '%s': congestion control set bitrate to %ld", output->context.name,
+		     new_bitrate);
+
+		calldata_init_fixed(&params, stack, sizeof(stack));
+		calldata_set_ptr(&params, "output", output);
+		calldata_set_int(&params, "bitrate", new_bitrate);
+		calldata_set_float(&params, "congestion", congestion);
+		signal_handler_signal(output->context.signals, "congestion", &params);
+	}
 }
 
 float obs_output_get_congestion(obs_output_t *output)
@@ -149,6 +149,8 @@ static const char *group_getname(void *unused)
 	return "Group";
 }
 
+static void scene_source_created(void *param, calldata_t *cd);
+
 static void *scene_create(obs_data_t *settings, struct obs_source *source)
 {
 	struct obs_scene *scene = bzalloc(sizeof(struct obs_scene));
@@ -176,6 +178,8 @@ static void *scene_create(obs_data_t *settings, struct obs_source *source)
 
 	scene->absolute_coordinates = obs_data_get_bool(obs->data.private_data, "AbsoluteCoordinates");
 
+	signal_handler_connect(obs_get_signal_handler(), "source_create", scene_source_created, scene);
+
 	UNUSED_PARAMETER(settings);
 	return scene;
 
@@ -229,15 +233,26 @@ static void remove_all_items(struct obs_scene *scene)
 	da_free(items);
 }
 
+static void release_pending_items(struct obs_scene *scene)
+{
+	for (size_t i = 0; i < scene->pending_items.num; i++)
+		obs_data_release(scene->pending_items.array[i]);
+	da_free(scene->pending_items);
+}
+
 static void scene_destroy(void *data)
 {
 	struct obs_scene *scene = data;
 
+	signal_handler_disconnect(obs_get_signal_handler(), "source_create", scene_source_created, scene);
+
 	remove_all_items(scene);
+	release_pending_items(scene);
 
 	pthread_mutex_destroy(&scene->video_mutex);
 	pthread_mutex_destroy(&scene->audio_mutex);
 	da_free(scene->mix_sources);
+	da_free(scene->render_items);
 	bfree(scene);
 }
 
@@ -292,8 +307,16 @@ static void scene_enum_all_sources(void *data, obs_source_enum_proc_t enum_callb
 	scene_enum_sources(data, enum_callback, param, false);
 }
 
+static inline void scene_render_items_invalidate(struct obs_scene *scene)
+{
+	os_atomic_set_bool(&scene->render_items_dirty, true);
+	obs_canvas_mark_dirty();
+}
+
 static inline void detach_sceneitem(struct obs_scene_item *item)
 {
+	scene_render_items_invalidate(item->parent);
+
 	if (item->prev)
 		item->prev->next = item->next;
 	else
@@ -310,6 +333,8 @@ static inline void attach_sceneitem(struct obs_scene *parent, struct obs_scene_i
 	item->prev = prev;
 	item->parent = parent;
 
+	scene_render_items_invalidate(parent);
+
 	if (prev) {
 		item->next = prev->next;
 		if (prev->next)
@@ -614,6 +639,8 @@ static void update_item_transform(struct obs_scene_item *item, bool update_tex)
 
 	if (os_atomic_load_long(&item->defer_update) > 0)
 		return;
+	if (item->parent && os_atomic_load_long(&item->parent->defer_update) > 0)
+		return;
 
 	/* Reset bounds crop */
 	memset(&item->bounds_crop, 0, sizeof(item->bounds_crop));
@@ -700,6 +727,8 @@ static void update_item_transform(struct obs_scene_item *item, bool update_tex)
 	calldata_set_ptr(&params, "item", item);
 	signal_parent(item->parent, "item_transform", &params);
 
+	obs_canvas_mark_dirty();
+
 	if (!update_tex)
 		return;
 
@@ -736,9 +765,120 @@ static inline bool item_is_scene(const struct obs_scene_item *item)
 
 static inline bool item_texture_enabled(const struct obs_scene_item *item)
 {
+	/* groups composite through a texrender so their composition can be
+	 * cached across frames while no child changes; see
+	 * item_group_cache_valid() */
 	return crop_enabled(&item->crop) || crop_enabled(&item->bounds_crop) || scale_filter_enabled(item) ||
 	       (item->blend_method == OBS_BLEND_METHOD_SRGB_OFF) || !default_blending_enabled(item) ||
-	       (item_is_scene(item) && !item->is_group);
+	       item_is_scene(item) || (item->source && item->source->render_interval_ns != 0);
+}
+
+/* whether the cached item texture is still valid for a throttled source,
+ * i.e. the render interval has not elapsed, the source was not updated,
+ * its size is unchanged and no show/hide transition is animating */
+static bool item_interval_cache_valid(const struct obs_scene_item *item)
+{
+	const struct obs_source *source = item->source;
+
+	if (!source || !source->render_interval_ns || !item->item_render)
+		return false;
+	if (obs->video.video_time - item->last_texrender_ns >= source->render_interval_ns)
+		return false;
+	if (os_atomic_load_long(&source->interval_change_count) != item->last_source_change_count)
+		return false;
+	if (obs_source_get_width(item->source) != item->last_width ||
+	    obs_source_get_height(item->source) != item->last_height)
+		return false;
+	if (transition_active(item->show_transition) || transition_active(item->hide_transition))
+		return false;
+
+	return true;
+}
+
+/* whether a group child changed since the last frame, updating its
+ * change-detection caches as a side effect.  a child is never cacheable
+ * when it, or any of its filters, may animate without signalling:
+ * synchronous render without the static-video guarantee, or nested
+ * composition */
+static bool group_child_changed(struct obs_scene_item *child)
+{
+	struct obs_source *source = child->source;
+	const uint32_t flags = source->info.output_flags;
+	const long async_sig = os_atomic_load_long(&source->async_delivered);
+	bool cacheable = true;
+	bool changed = false;
+
+	long sig = os_atomic_load_long(&source->interval_change_count);
+
+	pthread_mutex_lock(&source->filter_mutex);
+	for (size_t i = 0; i < source->filters.num; i++) {
+		struct obs_source *filter = source->filters.array[i];
+
+		if ((filter->info.output_flags & OBS_SOURCE_STATIC_VIDEO) == 0)
+			cacheable = false;
+
+		sig += os_atomic_load_long(&filter->interval_change_count);
+		if (filter->enabled)
+			sig += (long)i + 1;
+	}
+	sig += (long)source->filters.num * 31;
+	pthread_mutex_unlock(&source->filter_mutex);
+
+	if ((flags & (OBS_SOURCE_ASYNC | OBS_SOURCE_COMPOSITE)) == 0 && (flags & OBS_SOURCE_STATIC_VIDEO) == 0)
+		cacheable = false;
+	if (flags & OBS_SOURCE_COMPOSITE)
+		cacheable = false;
+
+	/* the pending flag catches transform edits whose matrices are only
+	 * recomputed during the upcoming render; the matrix compare catches
+	 * recomputes that happen without the flag */
+	if (!cacheable || sig != child->motion_change_count || async_sig != (long)child->motion_async_ts ||
+	    child->user_visible != child->motion_visible || os_atomic_load_bool(&child->update_transform) ||
+	    transition_active(child->show_transition) || transition_active(child->hide_transition) ||
+	    memcmp(&child->motion_transform, &child->box_transform, sizeof(child->box_transform)) != 0)
+		changed = true;
+
+	child->motion_change_count = sig;
+	child->motion_async_ts = (uint64_t)async_sig;
+	child->motion_visible = child->user_visible;
+	child->motion_transform = child->box_transform;
+
+	return changed;
+}
+
+/* group render cache: whether a group's composition from the previous
+ * frame is still valid.  the group only redraws when a child changed
+ * content, moved, toggled visibility or animates a transition, or when
+ * group membership or size changed.  child caches update as a side
+ * effect, so this runs exactly once per frame, from the owning scene's
+ * tick.  all children are always visited so their caches stay current */
+static bool item_group_cache_valid(struct obs_scene_item *item)
+{
+	if (!item->is_group || !item->item_render)
+		return false;
+
+	struct obs_scene *group_scene = item->source->context.data;
+	if (!group_scene)
+		return false;
+
+	bool changed = os_atomic_load_bool(&group_scene->render_items_dirty);
+
+	if (obs_source_get_width(item->source) != item->last_width ||
+	    obs_source_get_height(item->source) != item->last_height)
+		changed = true;
+	if (transition_active(item->show_transition) || transition_active(item->hide_transition))
+		changed = true;
+
+	video_lock(group_scene);
+	struct obs_scene_item *child = group_scene->first_item;
+	while (child) {
+		if (group_child_changed(child))
+			changed = true;
+		child = child->next;
+	}
+	video_unlock(group_scene);
+
+	return !changed;
 }
 
 static void render_item_texture(struct obs_scene_item *item, enum gs_color_space current_space,
@@ -881,6 +1021,76 @@ static void render_item_texture(struct obs_scene_item *item, enum gs_color_space
 	GS_DEBUG_MARKER_END();
 }
 
+/* consecutive items that draw their item texture through the plain "Draw"
+ * path of the default effect are merged into a single batched draw call */
+struct scene_item_batch {
+	gs_texture_t *tex;
+	enum obs_blending_type blend_type;
+	bool linear_srgb;
+	size_t num;
+};
+
+static void scene_item_batch_flush(struct scene_item_batch *batch)
+{
+	gs_effect_t *effect = obs->video.default_effect;
+
+	if (!batch->num)
+		return;
+
+	GS_DEBUG_MARKER_BEGIN(GS_DEBUG_COLOR_ITEM_TEXTURE, "scene_item_batch");
+
+	gs_eparam_t *const image = gs_effect_get_param_by_name(effect, "image");
+	gs_eparam_t *const multiplier_param = gs_effect_get_param_by_name(effect, "multiplier");
+
+	const bool previous = gs_framebuffer_srgb_enabled();
+	gs_enable_framebuffer_srgb(batch->linear_srgb);
+
+	if (batch->linear_srgb)
+		gs_effect_set_texture_srgb(image, batch->tex);
+	else
+		gs_effect_set_texture(image, batch->tex);
+
+	if (multiplier_param)
+		gs_effect_set_float(multiplier_param, 1.0f);
+
+	gs_blend_state_push();
+	gs_blend_function_separate(obs_blend_mode_params[batch->blend_type].src_color,
+				   obs_blend_mode_params[batch->blend_type].dst_color,
+				   obs_blend_mode_params[batch->blend_type].src_alpha,
+				   obs_blend_mode_params[batch->blend_type].dst_alpha);
+	gs_blend_op(obs_blend_mode_params[batch->blend_type].op);
+
+	while (gs_effect_loop(effect, "Draw"))
+		gs_sprite_batch_draw();
+
+	gs_blend_state_pop();
+	gs_enable_framebuffer_srgb(previous);
+
+	GS_DEBUG_MARKER_END();
+
+	batch->num = 0;
+	batch->tex = NULL;
+}
+
+/* an item can only be batched if drawing it would use the default effect's
+ * plain "Draw" technique with a multiplier of 1.0 and default samplers */
+static bool item_batch_eligible(const struct obs_scene_item *item, enum gs_color_space current_space,
+				enum gs_color_space source_space)
+{
+	if (source_space != current_space)
+		return false;
+
+	if (item->scale_filter != OBS_SCALE_DISABLE) {
+		if (item->scale_filter == OBS_SCALE_POINT)
+			return false;
+		if (!close_float(item->output_scale.x, 1.0f, EPSILON) ||
+		    !close_float(item->output_scale.y, 1.0f, EPSILON))
+			return false;
+	}
+
+	return true;
+}
+
 static bool are_texcoords_centered(struct matrix4 *m)
 {
 	static const struct matrix4 identity = {
@@ -895,7 +1105,7 @@ static bool are_texcoords_centered(struct matrix4 *m)
 	return memcmp(m, &copy, sizeof(*m)) == 0;
 }
 
-static inline void render_item(struct obs_scene_item *item)
+static inline void render_item(struct obs_scene_item *item, struct scene_item_batch *batch)
 {
 	GS_DEBUG_MARKER_BEGIN_FORMAT(GS_DEBUG_COLOR_ITEM, "Item: %s", obs_source_get_name(item->source));
 
@@ -926,6 +1136,10 @@ static inline void render_item(struct obs_scene_item *item)
 		uint32_t cx = calc_cx(item, width);
 		uint32_t cy = calc_cy(item, height);
 
+		/* loaded before rendering so that a change arriving mid-render
+		 * forces a fresh render next frame */
+		const long change_count = os_atomic_load_long(&source->interval_change_count);
+
 		if (cx && cy && gs_texrender_begin_with_color_space(item->item_render, cx, cy, source_space)) {
 			float cx_scale = (float)width / (float)cx;
 			float cy_scale = (float)height / (float)cy;
@@ -956,9 +1170,38 @@ static inline void render_item(struct obs_scene_item *item)
 			}
 
 			gs_texrender_end(item->item_render);
+
+			item->last_texrender_ns = obs->video.video_time;
+			item->last_source_change_count = change_count;
+		}
+	}
+
+	if (item->item_render && item_batch_eligible(item, current_space, source_space)) {
+		gs_texture_t *tex = gs_texrender_get_texture(item->item_render);
+		if (tex) {
+			const bool item_srgb = item->blend_method != OBS_BLEND_METHOD_SRGB_OFF;
+
+			if (batch->num && (batch->tex != tex || batch->blend_type != item->blend_type ||
+					   batch->linear_srgb != item_srgb))
+				scene_item_batch_flush(batch);
+
+			if (!batch->num) {
+				gs_sprite_batch_begin();
+				batch->tex = tex;
+				batch->blend_type = item->blend_type;
+				batch->linear_srgb = item_srgb;
+			}
+
+			gs_sprite_batch_quad(&item->draw_transform, (float)gs_texture_get_width(tex),
+					     (float)gs_texture_get_height(tex), 0);
+			batch->num++;
 		}
+		goto cleanup;
 	}
 
+	/* unbatched items must flush pending quads first to keep z-order */
+	scene_item_batch_flush(batch);
+
 	const bool linear_srgb = !item->item_render || (item->blend_method != OBS_BLEND_METHOD_SRGB_OFF);
 	const bool previous = gs_set_linear_srgb(linear_srgb);
 	gs_matrix_push();
@@ -996,8 +1239,24 @@ static void scene_video_tick(void *data, float seconds)
 	video_lock(scene);
 	item = scene->first_item;
 	while (item) {
-		if (item->item_render)
+		/* a texrender that is not reset keeps its contents and is
+		 * skipped by render_item, which reuses the cached texture
+		 * for throttled sources on off-frames and for groups
+		 * whose children are all unchanged */
+		if (item->item_render && !item_interval_cache_valid(item) && !item_group_cache_valid(item)) {
 			gs_texrender_reset(item->item_render);
+
+			/* an expired interval means the upcoming render can
+			 * change the canvas */
+			if (item->source && item->source->render_interval_ns)
+				obs_canvas_mark_dirty();
+
+			/* a group about to re-render changes its region;
+			 * surface that to the encoder motion hints, which
+			 * otherwise cannot see inside composite sources */
+			if (item->is_group)
+				os_atomic_inc_long(&item->source->interval_change_count);
+		}
 		item = item->next;
 	}
 	video_unlock(scene);
@@ -1005,8 +1264,36 @@ static void scene_video_tick(void *data, float seconds)
 	UNUSED_PARAMETER(seconds);
 }
 
+/* list of items pruned during transform updates; the render path backs it
+ * with the graphics thread's frame arena, other callers with the heap */
+struct prune_list {
+	struct obs_scene_item **items;
+	size_t num;
+	size_t cap;
+	bool use_arena;
+};
+
+static void prune_list_push(struct prune_list *list, struct obs_scene_item *item)
+{
+	if (list->num == list->cap) {
+		size_t new_cap = list->cap ? list->cap * 2 : 8;
+
+		if (list->use_arena) {
+			struct obs_scene_item **new_items = barena_alloc(new_cap * sizeof(*new_items));
+			memcpy(new_items, list->items, list->num * sizeof(*new_items));
+			list->items = new_items;
+		} else {
+			list->items = brealloc(list->items, new_cap * sizeof(*list->items));
+		}
+
+		list->cap = new_cap;
+	}
+
+	list->items[list->num++] = item;
+}
+
 /* assumes video lock */
-static void update_transforms_and_prune_sources(obs_scene_t *scene, obs_scene_item_ptr_array_t *remove_items,
+static void update_transforms_and_prune_sources(obs_scene_t *scene, struct prune_list *remove_items,
 						obs_sceneitem_t *group_sceneitem, bool scene_size_changed)
 {
 	struct obs_scene_item *item = scene->first_item;
@@ -1018,7 +1305,7 @@ static void update_transforms_and_prune_sources(obs_scene_t *scene, obs_scene_it
 			item = item->next;
 
 			obs_sceneitem_remove_internal(del_item);
-			da_push_back(*remove_items, &del_item);
+			prune_list_push(remove_items, del_item);
 			rebuild_group = true;
 			continue;
 		}
@@ -1057,14 +1344,54 @@ static inline bool scene_size_changed(obs_scene_t *scene)
 	return true;
 }
 
+/* records a motion hint for the encoders when an item visibly changed
+ * since the last composited frame: its transform moved, its source
+ * signalled new content, or it just became visible.  nested scene items
+ * contribute hints from their own render in their own coordinates,
+ * which match the canvas for canvas-sized scenes.  items inside groups
+ * render in group-local coordinates and are skipped by the caller;
+ * their motion only hints when the group item itself changes. */
+static void item_motion_hint(struct obs_scene_item *item)
+{
+	struct obs_source *source = item->source;
+
+	if (!obs->video.collecting_motion_hints)
+		return;
+
+	const long change_count = os_atomic_load_long(&source->interval_change_count);
+	const uint64_t async_ts = source->async_last_rendered_ts;
+	const uint64_t frame = obs->video.motion_frame_count;
+	const uint32_t flags = source->info.output_flags;
+
+	bool changed = change_count != item->motion_change_count || async_ts != item->motion_async_ts ||
+		       item->motion_frame != frame - 1;
+
+	/* synchronous sources without the static-video guarantee may
+	 * animate without any signal; assume they did */
+	if (!changed && (flags & (OBS_SOURCE_ASYNC | OBS_SOURCE_COMPOSITE)) == 0 &&
+	    (flags & OBS_SOURCE_STATIC_VIDEO) == 0)
+		changed = true;
+
+	if (memcmp(&item->motion_transform, &item->box_transform, sizeof(item->box_transform)) != 0) {
+		/* moved or resized: both the old and new regions change */
+		obs_motion_hints_add_box(&item->motion_transform);
+		obs_motion_hints_add_box(&item->box_transform);
+		item->motion_transform = item->box_transform;
+	} else if (changed) {
+		obs_motion_hints_add_box(&item->box_transform);
+	}
+
+	item->motion_change_count = change_count;
+	item->motion_async_ts = async_ts;
+	item->motion_frame = frame;
+}
+
 static void scene_video_render(void *data, gs_effect_t *effect)
 {
-	obs_scene_item_ptr_array_t remove_items;
+	struct prune_list remove_items = {.use_arena = true};
 	struct obs_scene *scene = data;
 	struct obs_scene_item *item;
 
-	da_init(remove_items);
-
 	video_lock(scene);
 
 	if (!scene->is_group) {
@@ -1075,21 +1402,38 @@ static void scene_video_render(void *data, gs_effect_t *effect)
 	gs_blend_state_push();
 	gs_reset_blend_state();
 
-	item = scene->first_item;
-	while (item) {
-		if (item->user_visible || transition_active(item->hide_transition))
-			render_item(item);
+	if (os_atomic_set_bool(&scene->render_items_dirty, false)) {
+		da_clear(scene->render_items);
 
-		item = item->next;
+		item = scene->first_item;
+		while (item) {
+			if (item->user_visible || item->hide_transition)
+				da_push_back(scene->render_items, &item);
+
+			item = item->next;
+		}
+	}
+
+	struct scene_item_batch batch = {0};
+
+	for (size_t i = 0; i < scene->render_items.num; i++) {
+		item = scene->render_items.array[i];
+		if (item->user_visible || transition_active(item->hide_transition)) {
+			if (!scene->is_group)
+				item_motion_hint(item);
+			render_item(item, &batch);
+		}
 	}
 
+	scene_item_batch_flush(&batch);
+
 	gs_blend_state_pop();
 
 	video_unlock(scene);
 
+	/* arena-backed storage is released by the frame arena reset */
 	for (size_t i = 0; i < remove_items.num; i++)
-		obs_sceneitem_release(remove_items.array[i]);
-	da_free(remove_items);
+		obs_sceneitem_release(remove_items.items[i]);
 
 	UNUSED_PARAMETER(effect);
 }
@@ -1111,6 +1455,9 @@ static void set_visibility(struct obs_scene_item *item, bool vis)
 	item->visible = vis;
 	item->user_visible = vis;
 
+	if (item->parent)
+		scene_render_items_invalidate(item->parent);
+
 	pthread_mutex_unlock(&item->actions_mutex);
 }
 
@@ -1142,10 +1489,18 @@ static void scene_load_item(struct obs_scene *scene, obs_data_t *item_data)
 		source = obs_get_source_by_name(name);
 
 	if (!source) {
+		/* keep the record so it is not lost on the next save, and so
+		 * the item can be created if the source shows up later */
 		blog(LOG_WARNING,
 		     "[scene_load_item] Source %s not "
-		     "found!",
+		     "found, deferring item",
 		     name);
+
+		obs_data_addref(item_data);
+
+		video_lock(scene);
+		da_push_back(scene->pending_items, &item_data);
+		video_unlock(scene);
 		return;
 	}
 
@@ -1279,6 +1634,10 @@ static void scene_load(void *data, obs_data_t *settings)
 
 	remove_all_items(scene);
 
+	video_lock(scene);
+	release_pending_items(scene);
+	video_unlock(scene);
+
 	if (obs_data_get_bool(settings, "custom_size")) {
 		scene->cx = (uint32_t)obs_data_get_int(settings, "cx");
 		scene->cy = (uint32_t)obs_data_get_int(settings, "cy");
@@ -1304,6 +1663,47 @@ static void scene_load(void *data, obs_data_t *settings)
 	obs_data_array_release(items);
 }
 
+/* resolves deferred items once a source with a matching uuid or name is
+ * created, which allows sources to be loaded lazily after their scenes */
+static void scene_source_created(void *param, calldata_t *cd)
+{
+	struct obs_scene *scene = param;
+	obs_source_t *source = calldata_ptr(cd, "source");
+	const char *uuid = obs_source_get_uuid(source);
+	const char *name = obs_source_get_name(source);
+	DARRAY(obs_data_t *) resolved;
+
+	if (!scene->pending_items.num)
+		return;
+
+	da_init(resolved);
+
+	video_lock(scene);
+
+	for (size_t i = scene->pending_items.num; i > 0; i--) {
+		obs_data_t *item_data = scene->pending_items.array[i - 1];
+		const char *item_uuid = obs_data_get_string(item_data, "source_uuid");
+		const char *item_name = obs_data_get_string(item_data, "name");
+
+		bool match = (uuid && item_uuid && *item_uuid && strcmp(item_uuid, uuid) == 0) ||
+			     (name && item_name && strcmp(item_name, name) == 0);
+
+		if (match) {
+			da_push_back(resolved, &item_data);
+			da_erase(scene->pending_items, i - 1);
+		}
+	}
+
+	video_unlock(scene);
+
+	for (size_t i = 0; i < resolved.num; i++) {
+		scene_load_item(scene, resolved.array[i]);
+		obs_data_release(resolved.array[i]);
+	}
+
+	da_free(resolved);
+}
+
 static void scene_save(void *data, obs_data_t *settings);
 
 static void scene_save_item(obs_data_array_t *array, struct obs_scene_item *item, struct obs_scene_item *backup_group)
@@ -1447,6 +1847,11 @@ static void scene_save(void *data, obs_data_t *settings)
 		item = item->next;
 	}
 
+	/* keep unresolved item records so they are not lost by a save that
+	 * happens before their sources exist */
+	for (size_t i = 0; i < scene->pending_items.num; i++)
+		obs_data_array_push_back(array, scene->pending_items.array[i]);
+
 	obs_data_set_int(settings, "id_counter", scene->id_counter);
 	obs_data_set_bool(settings, "custom_size", scene->custom_size);
 	if (scene->custom_size) {
@@ -2216,30 +2621,38 @@ obs_sceneitem_t *obs_scene_find_sceneitem_by_id(obs_scene_t *scene, int64_t id)
 
 void obs_scene_enum_items(obs_scene_t *scene, bool (*callback)(obs_scene_t *, obs_sceneitem_t *, void *), void *param)
 {
+	DARRAY(struct obs_scene_item *) items;
 	struct obs_scene_item *item;
 
 	if (!scene || !callback)
 		return;
 
+	/* Enumerate against a referenced snapshot of the item list so the
+	 * scene mutexes are only held while copying pointers; slow callbacks
+	 * (UI, scripts, remote control) no longer stall the render thread
+	 * for the duration of the walk. */
+	da_init(items);
+
 	full_lock(scene);
 
 	item = scene->first_item;
 	while (item) {
-		struct obs_scene_item *next = item->next;
-
 		obs_sceneitem_addref(item);
+		da_push_back(items, &item);
+		item = item->next;
+	}
 
-		if (!callback(scene, item, param)) {
-			obs_sceneitem_release(item);
-			break;
-		}
-
-		obs_sceneitem_release(item);
+	full_unlock(scene);
 
-		item = next;
+	for (size_t i = 0; i < items.num; i++) {
+		if (!callback(scene, items.array[i], param))
+			break;
 	}
 
-	full_unlock(scene);
+	for (size_t i = 0; i < items.num; i++)
+		obs_sceneitem_release(items.array[i]);
+
+	da_free(items);
 }
 
 static obs_sceneitem_t *sceneitem_get_ref(obs_sceneitem_t *si)
@@ -3391,6 +3804,33 @@ void obs_sceneitem_defer_update_end(obs_sceneitem_t *item)
 		do_update_transform(item);
 }
 
+void obs_scene_defer_update_begin(obs_scene_t *scene)
+{
+	if (!obs_ptr_valid(scene, "obs_scene_defer_update_begin"))
+		return;
+
+	os_atomic_inc_long(&scene->defer_update);
+}
+
+void obs_scene_defer_update_end(obs_scene_t *scene)
+{
+	struct obs_scene_item *item;
+
+	if (!obs_ptr_valid(scene, "obs_scene_defer_update_end"))
+		return;
+
+	if (os_atomic_dec_long(&scene->defer_update) != 0)
+		return;
+
+	full_lock(scene);
+	item = scene->first_item;
+	while (item) {
+		do_update_transform(item);
+		item = item->next;
+	}
+	full_unlock(scene);
+}
+
 void obs_sceneitem_defer_group_resize_begin(obs_sceneitem_t *item)
 {
 	if (!obs_ptr_valid(item, "obs_sceneitem_defer_group_resize_begin"))
@@ -4244,15 +4684,14 @@ obs_data_t *obs_sceneitem_transition_save(struct obs_scene_item *item, bool show
 
 void obs_scene_prune_sources(obs_scene_t *scene)
 {
-	obs_scene_item_ptr_array_t remove_items;
-	da_init(remove_items);
+	struct prune_list remove_items = {0};
 
 	video_lock(scene);
 	update_transforms_and_prune_sources(scene, &remove_items, NULL, false);
 	video_unlock(scene);
 
 	for (size_t i = 0; i < remove_items.num; i++)
-		obs_sceneitem_release(remove_items.array[i]);
+		obs_sceneitem_release(remove_items.items[i]);
 
-	da_free(remove_items);
+	bfree(remove_items.items);
 }
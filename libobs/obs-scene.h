@@ -51,6 +51,21 @@ struct obs_scene_item {
 	gs_texrender_t *item_render;
 	struct obs_sceneitem_crop crop;
 
+	/* render-interval throttling: when the last cached render happened
+	 * and the source change count it was rendered at */
+	uint64_t last_texrender_ns;
+	long last_source_change_count;
+
+	/* per-item change detection, used for encoder motion hints on
+	 * scene items (see item_motion_hint()) and for the group render
+	 * cache on group children (see group_child_changed()); the two
+	 * consumers never overlap */
+	struct matrix4 motion_transform;
+	long motion_change_count;
+	uint64_t motion_async_ts;
+	uint64_t motion_frame;
+	bool motion_visible;
+
 	bool absolute_coordinates;
 	struct vec2 pos;
 	struct vec2 scale;
@@ -119,9 +134,23 @@ struct obs_scene {
 
 	int64_t id_counter;
 
+	/* while positive, item transform recalculation is deferred; the
+	 * whole scene is recomputed once when the count drops to zero */
+	volatile long defer_update;
+
 	pthread_mutex_t video_mutex;
 	pthread_mutex_t audio_mutex;
 	struct obs_scene_item *first_item;
 
 	DARRAY(struct scene_source_mix) mix_sources;
+
+	/* cached flat list of renderable items, rebuilt only when item
+	 * membership, order or visibility changes */
+	DARRAY(struct obs_scene_item *) render_items;
+	volatile bool render_items_dirty;
+
+	/* saved item records whose source did not exist at load time; kept
+	 * so they survive a save, and resolved automatically when a source
+	 * with a matching uuid/name is created */
+	DARRAY(obs_data_t *) pending_items;
 };
@@ -30,7 +30,7 @@ static bool ready_deinterlace_frames(obs_source_t *source, uint64_t sys_time)
 	if (source->async_unbuffered) {
 		while (source->async_frames.num > 2) {
 			da_erase(source->async_frames, 0);
-			remove_async_frame(source, next_frame);
+			release_async_queue_frame(source, next_frame);
 			next_frame = source->async_frames.array[0];
 		}
 
@@ -75,7 +75,7 @@ static bool ready_deinterlace_frames(obs_source_t *source, uint64_t sys_time)
 
 		if (prev_frame) {
 			da_erase(source->async_frames, 0);
-			remove_async_frame(source, prev_frame);
+			release_async_queue_frame(source, prev_frame);
 		}
 
 		if (source->async_frames.num <= 2) {
@@ -200,11 +200,11 @@ static inline void deinterlace_get_closest_frames(obs_source_t *s, uint64_t sys_
 void deinterlace_process_last_frame(obs_source_t *s, uint64_t sys_time)
 {
 	if (s->prev_async_frame) {
-		remove_async_frame(s, s->prev_async_frame);
+		release_async_queue_frame(s, s->prev_async_frame);
 		s->prev_async_frame = NULL;
 	}
 	if (s->cur_async_frame) {
-		remove_async_frame(s, s->cur_async_frame);
+		release_async_queue_frame(s, s->cur_async_frame);
 		s->cur_async_frame = NULL;
 	}
 
@@ -250,7 +250,9 @@ void deinterlace_update_async_video(obs_source_t *source)
 			update_async_textures(source, frame, source->async_prev_textures, source->async_prev_texrender);
 		}
 
-		obs_source_release_frame(source, frame);
+		/* drop the temporary reference, then the queue reference */
+		os_atomic_dec_long(&frame->refs);
+		release_async_queue_frame(source, frame);
 
 	} else if (updated) { /* swap cur/prev if no previous texture */
 		for (size_t c = 0; c < MAX_AV_PLANES; c++) {
@@ -312,16 +314,28 @@ static bool deinterlace_linear_required(enum obs_deinterlace_mode mode)
 	return false;
 }
 
+static void cache_deinterlace_params(obs_source_t *source)
+{
+	gs_effect_t *effect = source->deinterlace_effect;
+
+	source->deinterlace_image_param = gs_effect_get_param_by_name(effect, "image");
+	source->deinterlace_prev_param = gs_effect_get_param_by_name(effect, "previous_image");
+	source->deinterlace_multiplier_param = gs_effect_get_param_by_name(effect, "multiplier");
+	source->deinterlace_field_param = gs_effect_get_param_by_name(effect, "field_order");
+	source->deinterlace_frame2_param = gs_effect_get_param_by_name(effect, "frame2");
+	source->deinterlace_dimensions_param = gs_effect_get_param_by_name(effect, "dimensions");
+}
+
 void deinterlace_render(obs_source_t *s)
 {
 	gs_effect_t *effect = s->deinterlace_effect;
 
-	gs_eparam_t *image = gs_effect_get_param_by_name(effect, "image");
-	gs_eparam_t *prev = gs_effect_get_param_by_name(effect, "previous_image");
-	gs_eparam_t *multiplier_param = gs_effect_get_param_by_name(effect, "multiplier");
-	gs_eparam_t *field = gs_effect_get_param_by_name(effect, "field_order");
-	gs_eparam_t *frame2 = gs_effect_get_param_by_name(effect, "frame2");
-	gs_eparam_t *dimensions = gs_effect_get_param_by_name(effect, "dimensions");
+	gs_eparam_t *image = s->deinterlace_image_param;
+	gs_eparam_t *prev = s->deinterlace_prev_param;
+	gs_eparam_t *multiplier_param = s->deinterlace_multiplier_param;
+	gs_eparam_t *field = s->deinterlace_field_param;
+	gs_eparam_t *frame2 = s->deinterlace_frame2_param;
+	gs_eparam_t *dimensions = s->deinterlace_dimensions_param;
 	struct vec2 size = {(float)s->async_width, (float)s->async_height};
 
 	gs_texture_t *cur_tex = s->async_texrender ? gs_texrender_get_texture(s->async_texrender)
@@ -412,10 +426,11 @@ static void enable_deinterlacing(obs_source_t *source, enum obs_deinterlace_mode
 
 	source->deinterlace_mode = mode;
 	source->deinterlace_effect = get_effect(mode);
+	cache_deinterlace_params(source);
 
 	pthread_mutex_lock(&source->async_mutex);
 	if (source->prev_async_frame) {
-		remove_async_frame(source, source->prev_async_frame);
+		release_async_queue_frame(source, source->prev_async_frame);
 		source->prev_async_frame = NULL;
 	}
 	pthread_mutex_unlock(&source->async_mutex);
@@ -453,6 +468,7 @@ void obs_source_set_deinterlace_mode(obs_source_t *source, enum obs_deinterlace_
 		obs_enter_graphics();
 		source->deinterlace_mode = mode;
 		source->deinterlace_effect = get_effect(mode);
+		cache_deinterlace_params(source);
 		obs_leave_graphics();
 	}
 }
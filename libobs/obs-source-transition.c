@@ -36,6 +36,12 @@ static inline bool transition_valid(const obs_source_t *transition, const char *
 	return true;
 }
 
+static inline void invalidate_transition_textures(obs_source_t *transition)
+{
+	transition->transition_tex_valid[0] = false;
+	transition->transition_tex_valid[1] = false;
+}
+
 bool obs_transition_init(obs_source_t *transition)
 {
 	pthread_mutex_init_value(&transition->transition_mutex);
@@ -81,6 +87,7 @@ void obs_transition_clear(obs_source_t *transition)
 	}
 	transition->transitioning_video = false;
 	transition->transitioning_audio = false;
+	invalidate_transition_textures(transition);
 	unlock_transition(transition);
 
 	for (size_t i = 0; i < 2; i++) {
@@ -194,6 +201,19 @@ static void recalculate_transition_size(obs_source_t *transition)
 	transition->transition_actual_cy = cy;
 }
 
+static bool transition_tex_still_valid(obs_source_t *transition, size_t idx)
+{
+	if (!transition->transition_tex_valid[idx] || transition->transition_tex_unstable[idx])
+		return false;
+	if (transition->transition_tex_change_count[idx] != os_atomic_load_long(&obs->video.canvas_change_count))
+		return false;
+	if (transition->transition_tex_cx[idx] != get_cx(transition) ||
+	    transition->transition_tex_cy[idx] != get_cy(transition))
+		return false;
+	return memcmp(&transition->transition_tex_matrix[idx], &transition->transition_matrices[idx],
+		      sizeof(struct matrix4)) == 0;
+}
+
 void obs_transition_tick(obs_source_t *transition, float t)
 {
 	recalculate_transition_size(transition);
@@ -211,8 +231,16 @@ void obs_transition_tick(obs_source_t *transition, float t)
 	}
 
 	if (trylock_textures(transition) == 0) {
-		gs_texrender_reset(transition->transition_texrender[0]);
-		gs_texrender_reset(transition->transition_texrender[1]);
+		for (size_t i = 0; i < 2; i++) {
+			/* a still-valid child render is kept across frames;
+			 * leaving the texrender un-reset makes render_child
+			 * reuse it instead of re-rendering the subtree */
+			if (transition_tex_still_valid(transition, i))
+				continue;
+
+			gs_texrender_reset(transition->transition_texrender[i]);
+			transition->transition_tex_valid[i] = false;
+		}
 		unlock_textures(transition);
 	}
 }
@@ -251,6 +279,7 @@ static void set_source(obs_source_t *transition, enum obs_transition_target targ
 		add_success = callback(transition, idx, new_child);
 
 	transition->transition_sources[idx] = add_success ? new_child : NULL;
+	invalidate_transition_textures(transition);
 
 	unlock_transition(transition);
 
@@ -411,6 +440,7 @@ void obs_transition_set(obs_source_t *transition, obs_source_t *source)
 	transition->transitioning_audio = false;
 	transition->transition_manual_val = 0.0f;
 	transition->transition_manual_target = 0.0f;
+	invalidate_transition_textures(transition);
 	unlock_transition(transition);
 
 	for (size_t i = 0; i < 2; i++) {
@@ -421,6 +451,8 @@ void obs_transition_set(obs_source_t *transition, obs_source_t *source)
 
 	if (source)
 		obs_source_add_active_child(transition, source);
+
+	obs_canvas_mark_dirty();
 }
 
 static float calc_time(obs_source_t *transition, uint64_t ts)
@@ -599,12 +631,29 @@ static inline void render_child(obs_source_t *transition, obs_source_t *child, s
 	if (!child)
 		return;
 
+	/* if the render cached last frame is still valid, tick left the
+	 * texrender un-reset and the old texture is reused as-is */
+	if (transition->transition_tex_valid[idx]) {
+		if (transition->transition_tex_space[idx] == space)
+			return;
+
+		gs_texrender_reset(transition->transition_texrender[idx]);
+		transition->transition_tex_valid[idx] = false;
+	}
+
 	enum gs_color_format format = gs_get_format_from_space(space);
 	if (gs_texrender_get_format(transition->transition_texrender[idx]) != format) {
 		gs_texrender_destroy(transition->transition_texrender[idx]);
 		transition->transition_texrender[idx] = gs_texrender_create(format, GS_ZS_NONE);
 	}
 
+	/* scope the unstable flag to the child render so a static subtree
+	 * can be detected even though the transition itself already marked
+	 * the frame unstable */
+	const long change_count = os_atomic_load_long(&obs->video.canvas_change_count);
+	const bool prev_unstable = os_atomic_load_bool(&obs->video.render_unstable);
+	os_atomic_set_bool(&obs->video.render_unstable, false);
+
 	if (gs_texrender_begin_with_color_space(transition->transition_texrender[idx], cx, cy, space)) {
 		vec4_zero(&blank);
 		gs_clear(GS_CLEAR_COLOR, &blank, 0.0f, 0);
@@ -616,7 +665,18 @@ static inline void render_child(obs_source_t *transition, obs_source_t *child, s
 		gs_matrix_pop();
 
 		gs_texrender_end(transition->transition_texrender[idx]);
+
+		transition->transition_tex_valid[idx] = true;
+		transition->transition_tex_unstable[idx] = os_atomic_load_bool(&obs->video.render_unstable);
+		transition->transition_tex_change_count[idx] = change_count;
+		transition->transition_tex_space[idx] = space;
+		transition->transition_tex_cx[idx] = cx;
+		transition->transition_tex_cy[idx] = cy;
+		matrix4_copy(&transition->transition_tex_matrix[idx], &transition->transition_matrices[idx]);
 	}
+
+	if (prev_unstable)
+		os_atomic_set_bool(&obs->video.render_unstable, true);
 }
 
 static void obs_transition_stop(obs_source_t *transition)
@@ -631,6 +691,7 @@ static void obs_transition_stop(obs_source_t *transition)
 	transition->transition_source_active[1] = false;
 	transition->transition_sources[0] = transition->transition_sources[1];
 	transition->transition_sources[1] = NULL;
+	invalidate_transition_textures(transition);
 }
 
 static inline void handle_stop(obs_source_t *transition)
@@ -682,8 +743,11 @@ void obs_transition_video_render2(obs_source_t *transition, obs_transition_video
 
 	unlock_transition(transition);
 
-	if (state.transitioning_video)
+	/* an in-progress transition animates every frame */
+	if (state.transitioning_video) {
+		obs_canvas_mark_unstable();
 		locked = trylock_textures(transition) == 0;
+	}
 
 	if (state.transitioning_video && locked && callback) {
 		gs_texture_t *tex[2];
@@ -844,6 +908,19 @@ static inline void mix_child(obs_source_t *transition, float *out, float *in, si
 {
 	void *context_data = transition->context.data;
 
+	/* both fade curves are pure functions of t; when t doesn't change
+	 * across the chunk (manual mode, or entirely before/after the
+	 * transition window) one evaluation covers every sample */
+	const float t_first = get_sample_time(transition, sample_rate, 0, ts);
+	const float t_last = count ? get_sample_time(transition, sample_rate, count - 1, ts) : t_first;
+
+	if (t_first == t_last) {
+		const float vol = mix(context_data, t_first);
+		for (size_t i = 0; i < count; i++)
+			out[i] += in[i] * vol;
+		return;
+	}
+
 	for (size_t i = 0; i < count; i++) {
 		float t = get_sample_time(transition, sample_rate, i, ts);
 		out[i] += in[i] * mix(context_data, t);
@@ -1041,6 +1118,9 @@ void obs_transition_swap_end(obs_source_t *tr_dest, obs_source_t *tr_source)
 		tr_source->transition_texrender[i] = dest;
 	}
 
+	invalidate_transition_textures(tr_dest);
+	invalidate_transition_textures(tr_source);
+
 	unlock_textures(tr_dest);
 	unlock_textures(tr_source);
 }
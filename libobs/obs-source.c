@@ -24,6 +24,7 @@
 #include "util/threading.h"
 #include "util/platform.h"
 #include "util/util_uint64.h"
+#include "util/sse-intrin.h"
 #include "callback/calldata.h"
 #include "graphics/matrix3.h"
 #include "graphics/vec3.h"
@@ -52,10 +53,17 @@ static inline bool destroying(const struct obs_source *source)
 
 struct obs_source_info *get_source_info(const char *id)
 {
-	for (size_t i = 0; i < obs->source_types.num; i++) {
-		struct obs_source_info *info = &obs->source_types.array[i];
-		if (strcmp(info->id, id) == 0)
-			return info;
+	struct source_type_item *item;
+	bool retried = false;
+
+retry:
+	HASH_FIND_STR(obs->source_type_lookup, id, item);
+	if (item)
+		return &obs->source_types.array[item->idx];
+
+	if (!retried && obs_demand_load_module_type(OBS_OBJ_TYPE_SOURCE, id)) {
+		retried = true;
+		goto retry;
 	}
 
 	return NULL;
@@ -63,12 +71,20 @@ struct obs_source_info *get_source_info(const char *id)
 
 struct obs_source_info *get_source_info2(const char *unversioned_id, uint32_t ver)
 {
+	bool retried = false;
+
+retry:
 	for (size_t i = 0; i < obs->source_types.num; i++) {
 		struct obs_source_info *info = &obs->source_types.array[i];
 		if (strcmp(info->unversioned_id, unversioned_id) == 0 && info->version == ver)
 			return info;
 	}
 
+	if (!retried && obs_demand_load_module_type(OBS_OBJ_TYPE_SOURCE, unversioned_id)) {
+		retried = true;
+		goto retry;
+	}
+
 	return NULL;
 }
 
@@ -112,6 +128,7 @@ static const char *source_signals[] = {
 	"void media_previous(ptr source)",
 	"void media_started(ptr source)",
 	"void media_ended(ptr source)",
+	"void frame_budget_exceeded(ptr source, int frame_time_ns, int budget_ns)",
 	NULL,
 };
 
@@ -328,6 +345,44 @@ static void obs_source_init_audio_hotkeys(struct obs_source *source)
 							      obs_source_hotkey_push_to_talk, source);
 }
 
+static pthread_mutex_t type_defaults_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Builds a type's default settings once and copies the cached result onto
+ * each new source, instead of re-running the plugin's get_defaults
+ * callbacks (which may rebuild nested objects or query system state) for
+ * every creation. */
+static void apply_cached_type_defaults(const struct obs_source_info *info, obs_data_t *settings)
+{
+	struct source_type_item *item;
+
+	if (!info->get_defaults && !info->get_defaults2)
+		return;
+
+	HASH_FIND_STR(obs->source_type_lookup, info->id, item);
+	if (!item) {
+		if (info->get_defaults)
+			info->get_defaults(settings);
+		if (info->get_defaults2)
+			info->get_defaults2(info->type_data, settings);
+		return;
+	}
+
+	pthread_mutex_lock(&type_defaults_mutex);
+
+	if (!item->cached_defaults) {
+		obs_data_t *defaults = obs_data_create();
+		if (info->get_defaults)
+			info->get_defaults(defaults);
+		if (info->get_defaults2)
+			info->get_defaults2(info->type_data, defaults);
+		item->cached_defaults = defaults;
+	}
+
+	obs_data_apply_defaults(settings, item->cached_defaults);
+
+	pthread_mutex_unlock(&type_defaults_mutex);
+}
+
 static obs_source_t *obs_source_create_internal(const char *id, const char *name, const char *uuid,
 						obs_data_t *settings, obs_data_t *hotkey_data, bool private,
 						uint32_t last_obs_ver, obs_canvas_t *canvas)
@@ -356,18 +411,13 @@ static obs_source_t *obs_source_create_internal(const char *id, const char *name
 	source->push_to_mute_key = OBS_INVALID_HOTKEY_ID;
 	source->push_to_talk_key = OBS_INVALID_HOTKEY_ID;
 	source->last_obs_ver = last_obs_ver;
+	source->render_interval_ns = source->info.render_interval_ns;
 
 	if (!obs_source_init_context(source, settings, name, uuid, hotkey_data, private))
 		goto fail;
 
-	if (info) {
-		if (info->get_defaults) {
-			info->get_defaults(source->context.settings);
-		}
-		if (info->get_defaults2) {
-			info->get_defaults2(info->type_data, source->context.settings);
-		}
-	}
+	if (info)
+		apply_cached_type_defaults(info, source->context.settings);
 
 	if (!obs_source_init(source))
 		goto fail;
@@ -589,10 +639,26 @@ void obs_source_frame_init(struct obs_source_frame *frame, enum video_format for
 	}
 }
 
+/* destroys a frame that was allocated via obs_source_frame_create(),
+ * returning its buffer to the shared frame buffer pool so the next
+ * allocation of the same geometry does not hit the allocator */
+static void obs_source_frame_recycle(struct obs_source_frame *frame)
+{
+	struct video_frame vframe;
+
+	if (!frame)
+		return;
+
+	memset(&vframe, 0, sizeof(vframe));
+	vframe.data[0] = frame->data[0];
+	video_frame_release(&vframe, frame->format, frame->width, frame->height);
+	bfree(frame);
+}
+
 static inline void obs_source_frame_decref(struct obs_source_frame *frame)
 {
 	if (os_atomic_dec_long(&frame->refs) == 0)
-		obs_source_frame_destroy(frame);
+		obs_source_frame_recycle(frame);
 }
 
 static bool obs_source_filter_remove_refless(obs_source_t *source, obs_source_t *filter);
@@ -650,6 +716,9 @@ void obs_source_destroy(struct obs_source *source)
 
 	source_profiler_remove_source(source);
 
+	if (source->frame_budget_ns)
+		os_atomic_dec_long(&obs->video.budget_source_count);
+
 	/* defer source destroy */
 	os_task_queue_queue_task(obs->destruction_task_thread, (os_task_t)obs_source_destroy_defer, source);
 }
@@ -693,17 +762,23 @@ static void obs_source_destroy_defer(struct obs_source *source)
 		gs_texrender_destroy(source->filter_texrender);
 	if (source->color_space_texrender)
 		gs_texrender_destroy(source->color_space_texrender);
+	if (source->shared_cache)
+		gs_texrender_destroy(source->shared_cache);
 	gs_leave_context();
 
 	for (i = 0; i < MAX_AV_PLANES; i++)
 		bfree(source->audio_data.data[i]);
 	for (i = 0; i < MAX_AUDIO_CHANNELS; i++)
 		deque_free(&source->audio_input_buf[i]);
+	for (i = 0; i < PENDING_AUDIO_CHUNKS; i++) {
+		for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++)
+			bfree(source->pending_audio[i].data[ch]);
+	}
 	audio_resampler_destroy(source->resampler);
 	bfree(source->audio_output_buf[0][0]);
 	bfree(source->audio_mix_buf[0]);
 
-	obs_source_frame_destroy(source->async_preload_frame);
+	obs_source_frame_recycle(source->async_preload_frame);
 
 	if (source->info.type == OBS_SOURCE_TYPE_TRANSITION)
 		obs_transition_free(source);
@@ -970,6 +1045,9 @@ void obs_source_update(obs_source_t *source, obs_data_t *settings)
 		source->info.update(source->context.data, source->context.settings);
 		obs_source_dosignal(source, "source_update", "update");
 	}
+
+	os_atomic_inc_long(&source->interval_change_count);
+	obs_canvas_mark_dirty();
 }
 
 void obs_source_reset_settings(obs_source_t *source, obs_data_t *settings)
@@ -1217,17 +1295,58 @@ void process_media_actions(obs_source_t *source)
 	}
 }
 
+/* graphics thread only: moves frames handed off through the ring into
+ * async_frames, which is owned exclusively by this thread */
+static void drain_async_ring(obs_source_t *source)
+{
+	struct obs_source_frame *frame;
+	long read = os_atomic_load_long(&source->async_ring_read);
+
+	if (os_atomic_set_bool(&source->async_clear, false)) {
+		pthread_mutex_lock(&source->async_mutex);
+
+		while (read < os_atomic_load_long(&source->async_ring_write)) {
+			frame = source->async_ring[read % MAX_ASYNC_FRAMES];
+			release_async_queue_frame(source, frame);
+			read++;
+		}
+		os_atomic_set_long(&source->async_ring_read, read);
+
+		for (size_t i = 0; i < source->async_frames.num; i++)
+			release_async_queue_frame(source, source->async_frames.array[i]);
+		da_resize(source->async_frames, 0);
+
+		release_async_queue_frame(source, source->cur_async_frame);
+		release_async_queue_frame(source, source->prev_async_frame);
+		source->cur_async_frame = NULL;
+		source->prev_async_frame = NULL;
+		source->last_frame_ts = 0;
+
+		pthread_mutex_unlock(&source->async_mutex);
+		return;
+	}
+
+	while (read < os_atomic_load_long(&source->async_ring_write)) {
+		frame = source->async_ring[read % MAX_ASYNC_FRAMES];
+		da_push_back(source->async_frames, &frame);
+		read++;
+	}
+	os_atomic_set_long(&source->async_ring_read, read);
+}
+
 static void async_tick(obs_source_t *source)
 {
 	uint64_t sys_time = obs->video.video_time;
 
+	drain_async_ring(source);
+
 	pthread_mutex_lock(&source->async_mutex);
 
 	if (deinterlacing_enabled(source)) {
 		deinterlace_process_last_frame(source, sys_time);
 	} else {
 		if (source->cur_async_frame) {
-			remove_async_frame(source, source->cur_async_frame);
+			release_async_queue_frame(source, source->cur_async_frame);
 			source->cur_async_frame = NULL;
 		}
 
@@ -1315,8 +1434,22 @@ void obs_source_video_tick(obs_source_t *source, float seconds)
 		source->active = now_active;
 	}
 
-	if (source->context.data && source->info.video_tick)
-		source->info.video_tick(source->context.data, seconds);
+	if (source->context.data && source->info.video_tick) {
+		if (source->render_interval_ns) {
+			/* tick throttled sources at their render interval,
+			 * handing them the accumulated elapsed time */
+			const uint64_t now = obs->video.video_time;
+
+			source->interval_tick_seconds += seconds;
+			if (now - source->last_interval_tick_ns >= source->render_interval_ns) {
+				source->info.video_tick(source->context.data, source->interval_tick_seconds);
+				source->interval_tick_seconds = 0.0f;
+				source->last_interval_tick_ns = now;
+			}
+		} else {
+			source->info.video_tick(source->context.data, seconds);
+		}
+	}
 
 	source->async_rendered = false;
 	source->deinterlace_rendered = false;
@@ -1343,6 +1476,48 @@ static inline size_t conv_time_to_frames(const size_t sample_rate, const uint64_
  * possible */
 #define TS_SMOOTHING_THRESHOLD 70000000ULL
 
+/* RFC3550-style interarrival jitter: the difference between how far apart
+ * two packets arrived and how far apart their timestamps say they should
+ * be, smoothed with a 1/16 gain.  A slowly decaying peak approximates the
+ * p99 that buffering decisions target. */
+static void update_arrival_jitter(obs_source_t *source, uint64_t ts, uint64_t sys_ns)
+{
+	if (source->jitter_prev_sys_ns && ts > source->jitter_prev_ts) {
+		const int64_t d =
+			(int64_t)(sys_ns - source->jitter_prev_sys_ns) - (int64_t)(ts - source->jitter_prev_ts);
+		const uint64_t mag = (uint64_t)(d < 0 ? -d : d);
+
+		/* stream restarts and timestamp jumps are not jitter */
+		if (mag < MAX_TS_VAR) {
+			int64_t avg = (int64_t)source->jitter_avg_ns;
+			avg += ((int64_t)mag - avg) / 16;
+			source->jitter_avg_ns = (uint64_t)avg;
+
+			uint64_t peak = source->jitter_peak_ns;
+			peak -= peak >> 8;
+			if (mag > peak)
+				peak = mag;
+			source->jitter_peak_ns = peak;
+		}
+	}
+
+	source->jitter_prev_sys_ns = sys_ns;
+	source->jitter_prev_ts = ts;
+}
+
+/* The fixed 70ms smoothing threshold makes bursty remote feeds oscillate
+ * between smoothing and resetting; widen it with the measured arrival
+ * jitter.  Capped well below MAX_TS_VAR so genuine jumps still reset. */
+static inline uint64_t ts_smoothing_threshold(const obs_source_t *source)
+{
+	uint64_t adaptive = source->jitter_peak_ns * 2;
+
+	if (adaptive > MAX_TS_VAR / 4)
+		adaptive = MAX_TS_VAR / 4;
+
+	return adaptive > TS_SMOOTHING_THRESHOLD ? adaptive : TS_SMOOTHING_THRESHOLD;
+}
+
 static inline void reset_audio_timing(obs_source_t *source, uint64_t timestamp, uint64_t os_time)
 {
 	source->timing_set = true;
@@ -1368,10 +1543,9 @@ static void handle_ts_jump(obs_source_t *source, uint64_t expected, uint64_t ts,
 	     "expected value %" PRIu64 ", input value %" PRIu64,
 	     source->context.name, diff, expected, ts);
 
-	pthread_mutex_lock(&source->audio_buf_mutex);
+	/* the caller holds audio_buf_mutex */
 	reset_audio_timing(source, ts, os_time);
 	reset_audio_data(source, os_time);
-	pthread_mutex_unlock(&source->audio_buf_mutex);
 }
 
 static void source_signal_audio_data(obs_source_t *source, const struct audio_data *in, bool muted)
@@ -1461,16 +1635,23 @@ static inline bool source_muted(obs_source_t *source, uint64_t os_time)
 	       (source->push_to_talk_enabled && !push_to_talk_active);
 }
 
-static void source_output_audio_data(obs_source_t *source, const struct audio_data *data)
+/* timestamp smoothing and insertion into audio_input_buf; runs on the
+ * audio thread for tracked audio sources (via the pending audio ring)
+ * and expects audio_buf_mutex to be held.  os_time is the arrival time
+ * captured when the chunk was handed off */
+static void source_process_audio_data(obs_source_t *source, const struct audio_data *data, uint64_t os_time)
 {
 	size_t sample_rate = audio_output_get_sample_rate(obs->audio.audio);
 	struct audio_data in = *data;
 	uint64_t diff;
-	uint64_t os_time = os_gettime_ns();
 	int64_t sync_offset;
 	bool using_direct_ts = false;
 	bool push_back = false;
 
+	/* async video sources feed the jitter estimator from video arrivals */
+	if ((source->info.output_flags & OBS_SOURCE_ASYNC_VIDEO) != OBS_SOURCE_ASYNC_VIDEO)
+		update_arrival_jitter(source, in.timestamp, os_time);
+
 	/* detects 'directly' set timestamps as long as they're within
 	 * a certain threshold */
 	if (uint64_diff(in.timestamp, os_time) < MAX_TS_VAR) {
@@ -1488,7 +1669,7 @@ static void source_output_audio_data(obs_source_t *source, const struct audio_da
 		/* smooth audio if within threshold */
 		if (diff > MAX_TS_VAR && !using_direct_ts)
 			handle_ts_jump(source, source->next_audio_ts_min, in.timestamp, diff, os_time);
-		else if (diff < TS_SMOOTHING_THRESHOLD) {
+		else if (diff < ts_smoothing_threshold(source)) {
 			if (source->async_unbuffered && source->async_decoupled)
 				source->timing_adjust = os_time - in.timestamp;
 			in.timestamp = source->next_audio_ts_min;
@@ -1504,15 +1685,13 @@ static void source_output_audio_data(obs_source_t *source, const struct audio_da
 
 	in.timestamp += source->timing_adjust;
 
-	pthread_mutex_lock(&source->audio_buf_mutex);
-
 	if (source->next_audio_sys_ts_min == in.timestamp) {
 		push_back = true;
 
 	} else if (source->next_audio_sys_ts_min) {
 		diff = uint64_diff(source->next_audio_sys_ts_min, in.timestamp);
 
-		if (diff < TS_SMOOTHING_THRESHOLD) {
+		if (diff < ts_smoothing_threshold(source)) {
 			push_back = true;
 
 		} else if (diff > MAX_TS_VAR) {
@@ -1545,10 +1724,82 @@ static void source_output_audio_data(obs_source_t *source, const struct audio_da
 		else
 			source_output_audio_place(source, &in);
 	}
+}
 
-	pthread_mutex_unlock(&source->audio_buf_mutex);
+/* hands a chunk of captured audio to the audio thread without taking
+ * audio_buf_mutex; the slot buffers are reused, so the steady state does
+ * no allocation either.  producers are serialized by audio_mutex */
+static void source_queue_audio_data(obs_source_t *source, const struct audio_data *data)
+{
+	long write = os_atomic_load_long(&source->pending_audio_write);
+	long read = os_atomic_load_long(&source->pending_audio_read);
+	size_t channels = audio_output_get_channels(obs->audio.audio);
+	size_t size = data->frames * sizeof(float);
+	struct source_audio_chunk *chunk;
+
+	/* ring full: the audio thread is badly stalled, and dropping is
+	 * better than blocking a device capture thread */
+	if (write - read >= PENDING_AUDIO_CHUNKS) {
+		os_atomic_inc_long(&source->pending_audio_dropped);
+		return;
+	}
+
+	chunk = &source->pending_audio[write % PENDING_AUDIO_CHUNKS];
 
-	source_signal_audio_data(source, data, source_muted(source, os_time));
+	if (chunk->capacity < size) {
+		for (size_t i = 0; i < MAX_AUDIO_CHANNELS; i++) {
+			bfree(chunk->data[i]);
+			chunk->data[i] = NULL;
+		}
+		for (size_t i = 0; i < channels; i++)
+			chunk->data[i] = bmalloc(size);
+		chunk->capacity = size;
+	}
+
+	for (size_t i = 0; i < channels; i++) {
+		if (chunk->data[i] && data->data[i])
+			memcpy(chunk->data[i], data->data[i], size);
+	}
+
+	chunk->frames = data->frames;
+	chunk->timestamp = data->timestamp;
+	chunk->os_time = os_gettime_ns();
+
+	os_atomic_set_long(&source->pending_audio_write, write + 1);
+}
+
+void obs_source_drain_pending_audio(obs_source_t *source)
+{
+	long read = os_atomic_load_long(&source->pending_audio_read);
+	long write = os_atomic_load_long(&source->pending_audio_write);
+	long dropped = os_atomic_exchange_long(&source->pending_audio_dropped, 0);
+
+	if (dropped) {
+		blog(LOG_WARNING, "Audio thread stalled; dropped %ld pending audio chunks for source '%s'", dropped,
+		     source->context.name);
+	}
+
+	if (read == write)
+		return;
+
+	pthread_mutex_lock(&source->audio_buf_mutex);
+
+	while (read != write) {
+		struct source_audio_chunk *chunk = &source->pending_audio[read % PENDING_AUDIO_CHUNKS];
+		struct audio_data data = {0};
+
+		for (size_t i = 0; i < MAX_AUDIO_CHANNELS; i++)
+			data.data[i] = (uint8_t *)chunk->data[i];
+		data.frames = chunk->frames;
+		data.timestamp = chunk->timestamp;
+
+		source_process_audio_data(source, &data, chunk->os_time);
+
+		read++;
+		os_atomic_set_long(&source->pending_audio_read, read);
+	}
+
+	pthread_mutex_unlock(&source->audio_buf_mutex);
 }
 
 enum convert_type {
@@ -2795,6 +3046,139 @@ static const char *get_type_format(enum obs_source_type type)
 }
 #endif
 
+static inline void render_video_direct(obs_source_t *source)
+{
+	if (source->filters.num && !source->rendering_filter)
+		obs_source_render_filters(source);
+
+	else if (source->info.video_render)
+		obs_source_main_render(source);
+
+	else if (source->filter_target)
+		obs_source_video_render(source->filter_target);
+
+	else if (deinterlacing_enabled(source))
+		deinterlace_render(source);
+
+	else
+		obs_source_render_async_video(source);
+}
+
+static void shared_cache_draw(obs_source_t *source)
+{
+	gs_effect_t *effect = obs->video.default_effect;
+	gs_technique_t *tech = gs_effect_get_technique(effect, "Draw");
+	gs_texture_t *tex = gs_texrender_get_texture(source->shared_cache);
+
+	const bool previous = gs_framebuffer_srgb_enabled();
+	gs_enable_framebuffer_srgb(true);
+
+	gs_effect_set_texture_srgb(gs_effect_get_param_by_name(effect, "image"), tex);
+
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+
+	const size_t passes = gs_technique_begin(tech);
+	for (size_t i = 0; i < passes; i++) {
+		gs_technique_begin_pass(tech, i);
+		gs_draw_sprite(tex, 0, 0, 0);
+		gs_technique_end_pass(tech);
+	}
+	gs_technique_end(tech);
+
+	gs_blend_state_pop();
+	gs_enable_framebuffer_srgb(previous);
+
+	/* the cached composite may contain unstable sources; keep the
+	 * canvas-reuse heuristics honest for every consumer */
+	if (source->shared_cache_unstable)
+		obs_canvas_mark_unstable();
+}
+
+static bool shared_cache_fill(obs_source_t *source, enum gs_color_space space, uint32_t cx, uint32_t cy)
+{
+	const enum gs_color_format format = gs_get_format_from_space(space);
+
+	if (source->shared_cache && gs_texrender_get_format(source->shared_cache) != format) {
+		gs_texrender_destroy(source->shared_cache);
+		source->shared_cache = NULL;
+	}
+
+	if (!source->shared_cache)
+		source->shared_cache = gs_texrender_create(format, GS_ZS_NONE);
+
+	gs_texrender_reset(source->shared_cache);
+	if (!gs_texrender_begin_with_color_space(source->shared_cache, cx, cy, space))
+		return false;
+
+	gs_enable_blending(false);
+
+	struct vec4 clear_color;
+	vec4_zero(&clear_color);
+	gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+	gs_ortho(0.0f, (float)cx, 0.0f, (float)cy, -100.0f, 100.0f);
+
+	render_video_direct(source);
+
+	gs_enable_blending(true);
+	gs_texrender_end(source->shared_cache);
+
+	source->shared_cache_space = space;
+	source->shared_cache_unstable = os_atomic_load_bool(&obs->video.render_unstable);
+	source->shared_cache_valid = true;
+	return true;
+}
+
+/* A scene referenced by multiple canvases is composited once per frame into
+ * a shared texrender and drawn from that texture for every subsequent
+ * consumer.  Scenes render at their base size regardless of the consumer
+ * (scaling lives in item transforms), so the composite is identical for each
+ * view; only the output color space can differ, in which case the mismatched
+ * consumer falls back to a direct render. */
+static bool shared_scene_render(obs_source_t *source)
+{
+	if (source->info.type != OBS_SOURCE_TYPE_SCENE || source->filter_parent || source->rendering_filter)
+		return false;
+
+	const uint64_t frame_time = obs->video.video_time;
+	if (!frame_time)
+		return false;
+
+	if (source->shared_frame_time != frame_time) {
+		source->shared_frame_time = frame_time;
+		source->shared_prev_render_count = source->shared_render_count;
+		source->shared_render_count = 0;
+		source->shared_cache_valid = false;
+	}
+
+	source->shared_render_count++;
+
+	const enum gs_color_space space = gs_get_color_space();
+
+	if (source->shared_cache_valid) {
+		if (source->shared_cache_space != space)
+			return false;
+		shared_cache_draw(source);
+		return true;
+	}
+
+	/* only pay for the indirection when the scene actually has (or had
+	 * last frame) more than one consumer */
+	if (source->shared_render_count < 2 && source->shared_prev_render_count < 2)
+		return false;
+
+	const uint32_t cx = get_base_width(source);
+	const uint32_t cy = get_base_height(source);
+	if (!cx || !cy)
+		return false;
+
+	if (!shared_cache_fill(source, space, cx, cy))
+		return false;
+
+	shared_cache_draw(source);
+	return true;
+}
+
 static inline void render_video(obs_source_t *source)
 {
 	if (source->info.type != OBS_SOURCE_TYPE_FILTER && (source->info.output_flags & OBS_SOURCE_VIDEO) == 0) {
@@ -2816,23 +3200,19 @@ static inline void render_video(obs_source_t *source)
 		return;
 	}
 
+	/* a synchronously rendered source can change its output without
+	 * notice, so it taints the frame for canvas reuse unless it declares
+	 * static output; composite sources (scenes/transitions) are judged
+	 * by what they render, async sources by frame delivery */
+	if (source->info.video_render &&
+	    (source->info.output_flags & (OBS_SOURCE_STATIC_VIDEO | OBS_SOURCE_COMPOSITE)) == 0)
+		obs_canvas_mark_unstable();
+
 	GS_DEBUG_MARKER_BEGIN_FORMAT(GS_DEBUG_COLOR_SOURCE, get_type_format(source->info.type),
 				     obs_source_get_name(source));
 
-	if (source->filters.num && !source->rendering_filter)
-		obs_source_render_filters(source);
-
-	else if (source->info.video_render)
-		obs_source_main_render(source);
-
-	else if (source->filter_target)
-		obs_source_video_render(source->filter_target);
-
-	else if (deinterlacing_enabled(source))
-		deinterlace_render(source);
-
-	else
-		obs_source_render_async_video(source);
+	if (!shared_scene_render(source))
+		render_video_direct(source);
 
 	GS_DEBUG_MARKER_END();
 }
@@ -3370,9 +3750,6 @@ static inline void free_async_cache(struct obs_source *source)
 		obs_source_frame_decref(source->async_cache.array[i].frame);
 
 	da_resize(source->async_cache, 0);
-	da_resize(source->async_frames, 0);
-	source->cur_async_frame = NULL;
-	source->prev_async_frame = NULL;
 }
 
 #define MAX_UNUSED_FRAME_DURATION 5
@@ -3385,14 +3762,13 @@ static void clean_cache(obs_source_t *source)
 		struct async_frame *af = &source->async_cache.array[i - 1];
 		if (!af->used) {
 			if (++af->unused_count == MAX_UNUSED_FRAME_DURATION) {
-				obs_source_frame_destroy(af->frame);
+				obs_source_frame_recycle(af->frame);
 				da_erase(source->async_cache, i - 1);
 			}
 		}
 	}
 }
 
-#define MAX_ASYNC_FRAMES 30
 //if return value is not null then do (os_atomic_dec_long(&output->refs) == 0) && obs_source_frame_destroy(output)
 static inline struct obs_source_frame *cache_video(struct obs_source *source, const struct obs_source_frame *frame)
 {
@@ -3400,9 +3776,11 @@ static inline struct obs_source_frame *cache_video(struct obs_source *source, co
 
 	pthread_mutex_lock(&source->async_mutex);
 
-	if (source->async_frames.num >= MAX_ASYNC_FRAMES) {
-		free_async_cache(source);
-		source->last_frame_ts = 0;
+	if (os_atomic_load_long(&source->async_ring_write) - os_atomic_load_long(&source->async_ring_read) >=
+	    MAX_ASYNC_FRAMES) {
+		/* graphics thread has stalled; defer the actual reset to it
+		 * so the queued frames are released safely */
+		os_atomic_set_bool(&source->async_clear, true);
 		pthread_mutex_unlock(&source->async_mutex);
 		return NULL;
 	}
@@ -3460,13 +3838,19 @@ static void obs_source_output_video_internal(obs_source_t *source, const struct
 	if (!frame) {
 		pthread_mutex_lock(&source->async_mutex);
 		source->async_active = false;
-		source->last_frame_ts = 0;
 		free_async_cache(source);
+		os_atomic_set_bool(&source->async_clear, true);
 		pthread_mutex_unlock(&source->async_mutex);
+		os_atomic_inc_long(&source->async_delivered);
+		obs_canvas_mark_dirty();
 		return;
 	}
 
 	source_profiler_async_frame_received(source);
+	os_atomic_inc_long(&source->async_delivered);
+	obs_canvas_mark_dirty();
+
+	update_arrival_jitter(source, frame->timestamp, os_gettime_ns());
 
 	struct obs_source_frame *output = cache_video(source, frame);
 
@@ -3474,11 +3858,20 @@ static void obs_source_output_video_internal(obs_source_t *source, const struct
 	pthread_mutex_lock(&source->async_mutex);
 	if (output) {
 		if (os_atomic_dec_long(&output->refs) == 0) {
-			obs_source_frame_destroy(output);
+			obs_source_frame_recycle(output);
 			output = NULL;
 		} else {
-			da_push_back(source->async_frames, &output);
-			source->async_active = true;
+			long write = os_atomic_load_long(&source->async_ring_write);
+			long read = os_atomic_load_long(&source->async_ring_read);
+
+			if (write - read < MAX_ASYNC_FRAMES) {
+				source->async_ring[write % MAX_ASYNC_FRAMES] = output;
+				os_atomic_set_long(&source->async_ring_write, write + 1);
+				source->async_active = true;
+			} else {
+				os_atomic_set_bool(&source->async_clear, true);
+				release_async_queue_frame(source, output);
+			}
 		}
 	}
 	pthread_mutex_unlock(&source->async_mutex);
@@ -3499,6 +3892,87 @@ void obs_source_output_video(obs_source_t *source, const struct obs_source_frame
 	obs_source_output_video_internal(source, &new_frame);
 }
 
+void obs_source_video_changed(obs_source_t *source)
+{
+	if (!obs_source_valid(source, "obs_source_video_changed"))
+		return;
+
+	os_atomic_inc_long(&source->interval_change_count);
+	obs_canvas_mark_dirty();
+}
+
+void obs_source_set_render_interval(obs_source_t *source, uint64_t interval_ns)
+{
+	if (!obs_source_valid(source, "obs_source_set_render_interval"))
+		return;
+
+	source->render_interval_ns = interval_ns;
+	os_atomic_inc_long(&source->interval_change_count);
+	obs_canvas_mark_dirty();
+}
+
+uint64_t obs_source_get_render_interval(const obs_source_t *source)
+{
+	return obs_source_valid(source, "obs_source_get_render_interval") ? source->render_interval_ns : 0;
+}
+
+void obs_source_set_frame_budget(obs_source_t *source, uint64_t budget_ns, uint32_t overrun_frames)
+{
+	if (!obs_source_valid(source, "obs_source_set_frame_budget"))
+		return;
+
+	if (!!budget_ns != !!source->frame_budget_ns) {
+		if (budget_ns)
+			os_atomic_inc_long(&obs->video.budget_source_count);
+		else
+			os_atomic_dec_long(&obs->video.budget_source_count);
+	}
+
+	source->frame_budget_ns = budget_ns;
+	source->budget_overrun_limit = overrun_frames ? overrun_frames : 1;
+	source->budget_overrun_frames = 0;
+}
+
+uint64_t obs_source_get_frame_budget(const obs_source_t *source)
+{
+	return obs_source_valid(source, "obs_source_get_frame_budget") ? source->frame_budget_ns : 0;
+}
+
+void obs_source_output_video_take(obs_source_t *source, struct obs_source_frame *frame)
+{
+	if (!obs_source_valid(source, "obs_source_output_video_take"))
+		return;
+	if (destroying(source))
+		return;
+	if (!frame) {
+		obs_source_output_video_internal(source, NULL);
+		return;
+	}
+
+	frame->full_range = format_is_yuv(frame->format) ? frame->full_range : true;
+
+	source_profiler_async_frame_received(source);
+
+	pthread_mutex_lock(&source->async_mutex);
+
+	/* the queue reference; the caller keeps its own */
+	os_atomic_inc_long(&frame->refs);
+
+	long write = os_atomic_load_long(&source->async_ring_write);
+	long read = os_atomic_load_long(&source->async_ring_read);
+
+	if (write - read < MAX_ASYNC_FRAMES) {
+		source->async_ring[write % MAX_ASYNC_FRAMES] = frame;
+		os_atomic_set_long(&source->async_ring_write, write + 1);
+		source->async_active = true;
+	} else {
+		os_atomic_set_bool(&source->async_clear, true);
+		os_atomic_dec_long(&frame->refs);
+	}
+
+	pthread_mutex_unlock(&source->async_mutex);
+}
+
 void obs_source_output_video2(obs_source_t *source, const struct obs_source_frame2 *frame)
 {
 	if (destroying(source))
@@ -3600,7 +4074,7 @@ static void obs_source_preload_video_internal(obs_source_t *source, const struct
 		return;
 
 	if (preload_frame_changed(source, frame)) {
-		obs_source_frame_destroy(source->async_preload_frame);
+		obs_source_frame_recycle(source->async_preload_frame);
 		source->async_preload_frame = obs_source_frame_create(frame->format, frame->width, frame->height);
 	}
 
@@ -3694,7 +4168,7 @@ static void obs_source_set_video_frame_internal(obs_source_t *source, const stru
 	obs_enter_graphics();
 
 	if (preload_frame_changed(source, frame)) {
-		obs_source_frame_destroy(source->async_preload_frame);
+		obs_source_frame_recycle(source->async_preload_frame);
 		source->async_preload_frame = obs_source_frame_create(frame->format, frame->width, frame->height);
 	}
 
@@ -3952,7 +4426,16 @@ void obs_source_output_audio(obs_source_t *source, const struct obs_source_audio
 		data.timestamp = output->timestamp;
 
 		pthread_mutex_lock(&source->audio_mutex);
-		source_output_audio_data(source, &data);
+		if (is_audio_source(source)) {
+			source_queue_audio_data(source, &data);
+		} else {
+			/* not on the audio thread's source list, so nothing
+			 * would drain the ring; process in place instead */
+			pthread_mutex_lock(&source->audio_buf_mutex);
+			source_process_audio_data(source, &data, os_gettime_ns());
+			pthread_mutex_unlock(&source->audio_buf_mutex);
+		}
+		source_signal_audio_data(source, &data, source_muted(source, os_gettime_ns()));
 		pthread_mutex_unlock(&source->audio_mutex);
 	}
 
@@ -3974,8 +4457,53 @@ void remove_async_frame(obs_source_t *source, struct obs_source_frame *frame)
 	}
 }
 
+/* releases the queue/display reference of a frame taken off async_frames;
+ * destroys frames adopted via obs_source_output_video_take once their last
+ * reference is gone, and returns cached frames to the cache */
+void release_async_queue_frame(obs_source_t *source, struct obs_source_frame *frame)
+{
+	if (!frame)
+		return;
+
+	if (os_atomic_dec_long(&frame->refs) == 0)
+		obs_source_frame_destroy(frame);
+	else
+		remove_async_frame(source, frame);
+}
+
 /* #define DEBUG_ASYNC_FRAMES 1 */
 
+/* Adjusts playout speed by up to ±2% so the buffered depth converges on
+ * the measured jitter target, instead of stepping between duplicating and
+ * dropping frames.  Only kicks in when arrival jitter is significant, so
+ * clean local feeds keep the exact 1:1 playout rate. */
+static uint64_t playout_adjusted_offset(obs_source_t *source, uint64_t sys_offset)
+{
+	const size_t num = source->async_frames.num;
+	long rate = 1000;
+
+	if (num > 1) {
+		const uint64_t buffered = source->async_frames.array[num - 1]->timestamp -
+					  source->async_frames.array[0]->timestamp;
+		const uint64_t target = source->jitter_peak_ns * 2;
+
+		os_atomic_set_long(&source->buffered_ms_stat, (long)(buffered / 1000000));
+
+		if (target > 10000000) {
+			if (buffered > target * 2)
+				rate = 1020;
+			else if (buffered < target / 2)
+				rate = 980;
+		}
+	} else {
+		os_atomic_set_long(&source->buffered_ms_stat, 0);
+	}
+
+	os_atomic_set_long(&source->playout_rate_permille, rate);
+
+	return util_mul_div64(sys_offset, (uint64_t)rate, 1000);
+}
+
 static bool ready_async_frame(obs_source_t *source, uint64_t sys_time)
 {
 	struct obs_source_frame *next_frame = source->async_frames.array[0];
@@ -3987,7 +4515,7 @@ static bool ready_async_frame(obs_source_t *source, uint64_t sys_time)
 	if (source->async_unbuffered) {
 		while (source->async_frames.num > 1) {
 			da_erase(source->async_frames, 0);
-			remove_async_frame(source, next_frame);
+			release_async_queue_frame(source, next_frame);
 			next_frame = source->async_frames.array[0];
 		}
 
@@ -4013,7 +4541,7 @@ static bool ready_async_frame(obs_source_t *source, uint64_t sys_time)
 		return true;
 	} else {
 		frame_offset = frame_time - source->last_frame_ts;
-		source->last_frame_ts += sys_offset;
+		source->last_frame_ts += playout_adjusted_offset(source, sys_offset);
 	}
 
 	while (source->last_frame_ts > next_frame->timestamp) {
@@ -4036,7 +4564,7 @@ static bool ready_async_frame(obs_source_t *source, uint64_t sys_time)
 		     source->last_frame_ts, next_frame->timestamp);
 #endif
 
-		remove_async_frame(source, frame);
+		release_async_queue_frame(source, frame);
 
 		if (source->async_frames.num == 1)
 			return true;
@@ -4906,6 +5434,7 @@ void obs_source_set_enabled(obs_source_t *source, bool enabled)
 		return;
 
 	source->enabled = enabled;
+	obs_canvas_mark_dirty();
 
 	calldata_init_fixed(&data, stack, sizeof(stack));
 	calldata_set_ptr(&data, "source", source);
@@ -5108,9 +5637,13 @@ static inline void multiply_output_audio(obs_source_t *source, size_t mix, size_
 {
 	register float *out = source->audio_output_buf[mix][0];
 	register float *end = out + AUDIO_OUTPUT_FRAMES * channels;
+	const __m128 vol_ps = _mm_set1_ps(vol);
 
-	while (out < end)
-		*(out++) *= vol;
+	/* AUDIO_OUTPUT_FRAMES * channels is always a multiple of four */
+	while (out < end) {
+		_mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(out), vol_ps));
+		out += 4;
+	}
 }
 
 static inline void multiply_vol_data(obs_source_t *source, size_t mix, size_t channels, float *vol_data)
@@ -5120,8 +5653,11 @@ static inline void multiply_vol_data(obs_source_t *source, size_t mix, size_t ch
 		register float *end = out + AUDIO_OUTPUT_FRAMES;
 		register float *vol = vol_data;
 
-		while (out < end)
-			*(out++) *= *(vol++);
+		while (out < end) {
+			_mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(out), _mm_loadu_ps(vol)));
+			out += 4;
+			vol += 4;
+		}
 	}
 }
 
@@ -5870,6 +6406,21 @@ uint64_t obs_source_get_last_async_ts(const obs_source_t *source)
 	return source->async_last_rendered_ts;
 }
 
+bool obs_source_get_jitter_stats(const obs_source_t *source, struct obs_source_jitter_stats *stats)
+{
+	if (!obs_source_valid(source, "obs_source_get_jitter_stats") || !stats)
+		return false;
+
+	long rate = os_atomic_load_long(&source->playout_rate_permille);
+	long buffered_ms = os_atomic_load_long(&source->buffered_ms_stat);
+
+	stats->jitter_avg_ns = source->jitter_avg_ns;
+	stats->jitter_peak_ns = source->jitter_peak_ns;
+	stats->buffered_ns = (uint64_t)(buffered_ms > 0 ? buffered_ms : 0) * 1000000ULL;
+	stats->playout_rate = rate ? (float)rate / 1000.0f : 1.0f;
+	return true;
+}
+
 obs_canvas_t *obs_source_get_canvas(const obs_source_t *source)
 {
 	return obs_weak_canvas_get_canvas(source->canvas);
@@ -208,6 +208,23 @@ enum obs_media_state {
  */
 #define OBS_SOURCE_REQUIRES_CANVAS (1 << 17)
 
+/**
+ * Source video output only changes in response to settings updates or
+ * explicit obs_source_video_changed() calls, never spontaneously from
+ * frame to frame.  Allows libobs to skip re-compositing canvases whose
+ * sources are all static or asynchronous.
+ */
+#define OBS_SOURCE_STATIC_VIDEO (1 << 18)
+
+/**
+ * Source type must be created on the thread that loads the scene
+ * collection.  obs_load_sources() constructs sources of independent
+ * types on a worker pool; types whose create callback touches
+ * thread-affine state (UI toolkits, single-threaded SDKs) should set
+ * this flag to opt out of parallel creation.
+ */
+#define OBS_SOURCE_CAP_SERIAL_CREATE (1 << 19)
+
 /** @} */
 
 typedef void (*obs_source_enum_proc_t)(obs_source_t *parent, obs_source_t *child, void *param);
@@ -551,6 +568,16 @@ struct obs_source_info {
 	 * @param  source  Source that the filter is being added to
 	 */
 	void (*filter_add)(void *data, obs_source_t *source);
+
+	/**
+	 * Optional hint for sources whose output updates at a lower rate
+	 * than the canvas (clocks, slow dashboards).  When non-zero, scene
+	 * rendering caches the source's last render and only re-renders it
+	 * once per interval, and the source's video_tick is called at the
+	 * same reduced rate (with accumulated seconds).  Settings updates
+	 * and obs_source_video_changed() force an immediate re-render.
+	 */
+	uint64_t render_interval_ns;
 };
 
 EXPORT void obs_register_source_s(const struct obs_source_info *info, size_t size);
@@ -224,14 +224,31 @@ static void *gpu_encode_thread(void *data)
 	return NULL;
 }
 
+static size_t get_encode_texture_count(void)
+{
+	long long count = obs_data_get_int(obs->data.private_data, "GpuEncoderTextureCount");
+
+	if (!count)
+		return NUM_ENCODE_TEXTURES;
+
+	if (count < MIN_ENCODE_TEXTURES)
+		count = MIN_ENCODE_TEXTURES;
+	else if (count > MAX_ENCODE_TEXTURES)
+		count = MAX_ENCODE_TEXTURES;
+
+	blog(LOG_INFO, "init_gpu_encoding: using %lld encode textures", count);
+	return (size_t)count;
+}
+
 bool init_gpu_encoding(struct obs_core_video_mix *video)
 {
 	const struct video_output_info *info = video_output_get_info(video->video);
+	size_t num_textures = get_encode_texture_count();
 
 	video->gpu_encode_stop = false;
 
-	deque_reserve(&video->gpu_encoder_avail_queue, NUM_ENCODE_TEXTURES);
-	for (size_t i = 0; i < NUM_ENCODE_TEXTURES; i++) {
+	deque_reserve(&video->gpu_encoder_avail_queue, num_textures);
+	for (size_t i = 0; i < num_textures; i++) {
 		gs_texture_t *tex;
 		gs_texture_t *tex_uv;
 
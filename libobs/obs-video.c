@@ -20,6 +20,8 @@
 
 #include "obs.h"
 #include "obs-internal.h"
+#include "graphics/matrix4.h"
+#include "graphics/vec3.h"
 #include "graphics/vec4.h"
 #include "media-io/format-conversion.h"
 #include "media-io/video-frame.h"
@@ -29,6 +31,119 @@
 #include <windows.h>
 #endif
 
+static void tick_parallel_sources(float seconds)
+{
+	struct obs_core_data *data = &obs->data;
+	struct obs_core_video *video = &obs->video;
+	long i;
+
+	while ((i = os_atomic_inc_long(&video->tick_next_idx) - 1) < (long)data->sources_to_tick_parallel.num) {
+		obs_source_t *s = data->sources_to_tick_parallel.array[i];
+		const uint64_t start = source_profiler_source_tick_start();
+		obs_source_video_tick(s, seconds);
+		source_profiler_source_tick_end(s, start);
+	}
+}
+
+static void tick_sources_job(void *param)
+{
+	UNUSED_PARAMETER(param);
+	tick_parallel_sources(obs->video.tick_seconds);
+}
+
+static void *tick_worker_thread(void *param)
+{
+	struct obs_core_video *video = param;
+
+	os_set_thread_name("libobs: tick worker");
+
+	for (;;) {
+		os_sem_wait(video->tick_start_sem);
+		if (!os_atomic_load_bool(&video->tick_threads_active))
+			break;
+
+		video->worker_job(video->worker_job_param);
+		os_sem_post(video->tick_done_sem);
+	}
+
+	return NULL;
+}
+
+/* The tick workers double as a generic pool for frame jobs: dispatch only
+ * ever happens from the graphics thread, and every dispatch is joined
+ * before the next one, so the pool runs at most one job at a time. */
+static void video_workers_start(void (*job)(void *param), void *param)
+{
+	struct obs_core_video *video = &obs->video;
+
+	video->worker_job = job;
+	video->worker_job_param = param;
+	for (size_t i = 0; i < video->tick_threads.num; i++)
+		os_sem_post(video->tick_start_sem);
+}
+
+static void video_workers_join(void)
+{
+	struct obs_core_video *video = &obs->video;
+
+	for (size_t i = 0; i < video->tick_threads.num; i++)
+		os_sem_wait(video->tick_done_sem);
+}
+
+bool obs_init_tick_threads(uint32_t count)
+{
+	struct obs_core_video *video = &obs->video;
+
+	if (!count) {
+		int cores = os_get_physical_cores();
+		count = cores > 1 ? (uint32_t)cores - 1 : 1;
+	}
+
+	if (os_sem_init(&video->tick_start_sem, 0) != 0)
+		return false;
+	if (os_sem_init(&video->tick_done_sem, 0) != 0)
+		return false;
+
+	os_atomic_set_bool(&video->tick_threads_active, true);
+
+	for (uint32_t i = 0; i < count; i++) {
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, tick_worker_thread, video) != 0)
+			return false;
+		da_push_back(video->tick_threads, &thread);
+	}
+
+	blog(LOG_INFO, "Parallel source tick enabled with %u worker thread(s)", count);
+	return true;
+}
+
+void obs_free_tick_threads(void)
+{
+	struct obs_core_video *video = &obs->video;
+
+	if (!video->tick_threads.num)
+		return;
+
+	os_atomic_set_bool(&video->tick_threads_active, false);
+	for (size_t i = 0; i < video->tick_threads.num; i++)
+		os_sem_post(video->tick_start_sem);
+	for (size_t i = 0; i < video->tick_threads.num; i++)
+		pthread_join(video->tick_threads.array[i], NULL);
+
+	da_free(video->tick_threads);
+	os_sem_destroy(video->tick_start_sem);
+	os_sem_destroy(video->tick_done_sem);
+	video->tick_start_sem = NULL;
+	video->tick_done_sem = NULL;
+}
+
+/* sources with no filter/parent relationship can be safely ticked out of
+ * order relative to each other */
+static inline bool source_tick_independent(const obs_source_t *source)
+{
+	return !source->filter_parent && !source->filters.num;
+}
+
 static uint64_t tick_sources(uint64_t cur_time, uint64_t last_time)
 {
 	struct obs_core_data *data = &obs->data;
@@ -58,15 +173,22 @@ static uint64_t tick_sources(uint64_t cur_time, uint64_t last_time)
 	/* ------------------------------------- */
 	/* get an array of all sources to tick   */
 
+	const bool parallel = obs->video.parallel_tick && obs->video.tick_threads.num > 0;
+
 	da_clear(data->sources_to_tick);
+	da_clear(data->sources_to_tick_parallel);
 
 	pthread_mutex_lock(&data->sources_mutex);
 
 	source = data->sources;
 	while (source) {
 		obs_source_t *s = obs_source_get_ref(source);
-		if (s)
-			da_push_back(data->sources_to_tick, &s);
+		if (s) {
+			if (parallel && source_tick_independent(s))
+				da_push_back(data->sources_to_tick_parallel, &s);
+			else
+				da_push_back(data->sources_to_tick, &s);
+		}
 		source = (struct obs_source *)source->context.hh_uuid.next;
 	}
 
@@ -75,6 +197,14 @@ static uint64_t tick_sources(uint64_t cur_time, uint64_t last_time)
 	/* ------------------------------------- */
 	/* call the tick function of each source */
 
+	if (parallel && data->sources_to_tick_parallel.num) {
+		struct obs_core_video *video = &obs->video;
+
+		video->tick_seconds = seconds;
+		os_atomic_set_long(&video->tick_next_idx, 0);
+		video_workers_start(tick_sources_job, NULL);
+	}
+
 	for (size_t i = 0; i < data->sources_to_tick.num; i++) {
 		obs_source_t *s = data->sources_to_tick.array[i];
 		const uint64_t start = source_profiler_source_tick_start();
@@ -83,11 +213,21 @@ static uint64_t tick_sources(uint64_t cur_time, uint64_t last_time)
 		obs_source_release(s);
 	}
 
+	if (parallel && data->sources_to_tick_parallel.num) {
+		/* steal remaining work, then join before rendering */
+		tick_parallel_sources(seconds);
+		video_workers_join();
+
+		for (size_t i = 0; i < data->sources_to_tick_parallel.num; i++)
+			obs_source_release(data->sources_to_tick_parallel.array[i]);
+	}
+
 	return cur_time;
 }
 
 /* in obs-display.c */
 extern void render_display(struct obs_display *display);
+extern void present_display(struct obs_display *display);
 
 static inline void render_displays(void)
 {
@@ -98,17 +238,33 @@ static inline void render_displays(void)
 
 	gs_enter_context(obs->video.graphics);
 
+	gs_timer_t *stage_timer = source_profiler_pipeline_begin();
+
 	/* render extra displays/swaps */
 	pthread_mutex_lock(&obs->data.displays_mutex);
 
+	/* record the draw work for every display first, then present all of
+	 * the swaps in a second pass: presenting in the middle of the walk
+	 * would stall the later displays behind each earlier swap instead of
+	 * letting the GPU overlap their work */
 	display = obs->data.first_display;
 	while (display) {
 		render_display(display);
 		display = display->next;
 	}
 
+	gs_flush();
+
+	display = obs->data.first_display;
+	while (display) {
+		present_display(display);
+		display = display->next;
+	}
+
 	pthread_mutex_unlock(&obs->data.displays_mutex);
 
+	source_profiler_pipeline_end(PROFILER_PIPELINE_DISPLAY, stage_timer);
+
 	gs_leave_context();
 }
 
@@ -121,6 +277,78 @@ static inline void set_render_size(uint32_t width, uint32_t height)
 	gs_set_viewport(0, 0, width, height);
 }
 
+/* Dynamic resolution: when the GPU repeatedly cannot finish a frame in
+ * time (observed as lagged frames), step the canvas render down in
+ * resolution and upscale on output, recovering once headroom returns.
+ * Levels are applied globally so mixes can still share render textures. */
+static const float dynres_levels[] = {1.0f, 0.9f, 0.75f};
+#define DYNRES_NUM_LEVELS (sizeof(dynres_levels) / sizeof(float))
+#define DYNRES_OVERRUN_FRAMES 10
+#define DYNRES_RECOVER_NS (5 * 1000000000ULL)
+
+static inline void dynres_dimensions(const struct obs_video_info *ovi, uint32_t *width, uint32_t *height)
+{
+	const float scale = dynres_levels[obs->video.dynres_level];
+
+	*width = ovi->base_width;
+	*height = ovi->base_height;
+
+	if (scale < 1.0f) {
+		*width = (uint32_t)((float)*width * scale) & ~1;
+		*height = (uint32_t)((float)*height * scale) & ~1;
+	}
+}
+
+static void dynres_set_level(int level)
+{
+	struct obs_core_video *video = &obs->video;
+
+	if (video->dynres_level == level)
+		return;
+
+	video->dynres_level = level;
+	video->dynres_streak = 0;
+	os_atomic_set_long(&video->dynres_scale_percent, (long)(dynres_levels[level] * 100.0f + 0.5f));
+
+	/* previous render textures hold the old scale, force recomposition */
+	pthread_mutex_lock(&video->mixes_mutex);
+	for (size_t i = 0, num = video->mixes.num; i < num; i++)
+		video->mixes.array[i]->texture_rendered = false;
+	pthread_mutex_unlock(&video->mixes_mutex);
+
+	blog(LOG_INFO, "Dynamic resolution: rendering canvas at %d%%",
+	     (int)os_atomic_load_long(&video->dynres_scale_percent));
+}
+
+static void update_dynamic_resolution(uint64_t now)
+{
+	struct obs_core_video *video = &obs->video;
+
+	if (!os_atomic_load_bool(&video->dynres_enabled)) {
+		if (video->dynres_level)
+			dynres_set_level(0);
+		return;
+	}
+
+	const uint32_t lagged = video->lagged_frames;
+	const bool lagged_now = lagged != video->dynres_lagged_prev;
+	video->dynres_lagged_prev = lagged;
+
+	if (lagged_now) {
+		video->dynres_calm_start_ns = now;
+		if (++video->dynres_streak >= DYNRES_OVERRUN_FRAMES && video->dynres_level < (int)DYNRES_NUM_LEVELS - 1) {
+			dynres_set_level(video->dynres_level + 1);
+			video->dynres_calm_start_ns = now;
+		}
+	} else {
+		video->dynres_streak = 0;
+		if (video->dynres_level && now - video->dynres_calm_start_ns >= DYNRES_RECOVER_NS) {
+			dynres_set_level(video->dynres_level - 1);
+			video->dynres_calm_start_ns = now;
+		}
+	}
+}
+
 static inline void unmap_last_surface(struct obs_core_video_mix *video)
 {
 	for (int c = 0; c < NUM_CHANNELS; ++c) {
@@ -153,16 +381,18 @@ static inline bool can_reuse_mix_texture(const struct obs_core_video_mix *mix, s
 	return false;
 }
 
-static inline void draw_mix_texture(const size_t mix_idx)
+static inline void draw_mix_texture(const size_t mix_idx, uint32_t width, uint32_t height)
 {
 	gs_texture_t *tex = obs->video.mixes.array[mix_idx]->render_texture;
 	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
 	gs_eparam_t *param = gs_effect_get_param_by_name(effect, "image");
 	gs_effect_set_texture_srgb(param, tex);
 
+	/* with dynamic resolution active only the scaled subregion of the
+	 * other mix's render texture holds valid content */
 	gs_enable_framebuffer_srgb(true);
 	while (gs_effect_loop(effect, "Draw"))
-		gs_draw_sprite(tex, 0, 0, 0);
+		gs_draw_sprite_subregion(tex, 0, 0, 0, width, height);
 	gs_enable_framebuffer_srgb(false);
 }
 
@@ -171,6 +401,9 @@ static inline void render_main_texture(struct obs_core_video_mix *video)
 {
 	uint32_t base_width = video->ovi.base_width;
 	uint32_t base_height = video->ovi.base_height;
+	uint32_t render_width, render_height;
+
+	dynres_dimensions(&video->ovi, &render_width, &render_height);
 
 	profile_start(render_main_texture_name);
 	GS_DEBUG_MARKER_BEGIN(GS_DEBUG_COLOR_MAIN_TEXTURE, render_main_texture_name);
@@ -178,28 +411,56 @@ static inline void render_main_texture(struct obs_core_video_mix *video)
 	struct vec4 clear_color;
 	vec4_set(&clear_color, 0.0f, 0.0f, 0.0f, 0.0f);
 
-	gs_set_render_target_with_color_space(video->render_texture, NULL, video->render_space);
-	gs_clear(GS_CLEAR_COLOR, &clear_color, 1.0f, 0);
+	pthread_mutex_lock(&obs->data.draw_callbacks_mutex);
 
-	set_render_size(base_width, base_height);
+	const bool have_draw_callbacks = obs->data.draw_callbacks.num > 0;
+	const long change_count = os_atomic_load_long(&obs->video.canvas_change_count);
 
-	pthread_mutex_lock(&obs->data.draw_callbacks_mutex);
+	/* if the previous frame came solely from static/async sources and
+	 * nothing has changed since, the previous render texture still holds
+	 * the correct canvas and compositing can be skipped entirely */
+	const bool reuse_previous = video->texture_rendered && video->last_render_stable && !have_draw_callbacks &&
+				    change_count == video->last_change_count;
 
-	for (size_t i = obs->data.draw_callbacks.num; i > 0; i--) {
-		struct draw_callback *const callback = obs->data.draw_callbacks.array + (i - 1);
-		callback->draw(callback->param, base_width, base_height);
-	}
+	if (reuse_previous) {
+		pthread_mutex_unlock(&obs->data.draw_callbacks_mutex);
+		os_atomic_inc_long(&obs->video.skipped_compositions);
+	} else {
+		gs_set_render_target_with_color_space(video->render_texture, NULL, video->render_space);
+		gs_clear(GS_CLEAR_COLOR, &clear_color, 1.0f, 0);
+
+		/* sources draw in base canvas coordinates; a reduced viewport
+		 * renders them at the dynamic resolution scale */
+		set_render_size(base_width, base_height);
+		if (render_width != base_width || render_height != base_height)
+			gs_set_viewport(0, 0, render_width, render_height);
+
+		for (size_t i = obs->data.draw_callbacks.num; i > 0; i--) {
+			struct draw_callback *const callback = obs->data.draw_callbacks.array + (i - 1);
+			callback->draw(callback->param, base_width, base_height);
+		}
 
-	pthread_mutex_unlock(&obs->data.draw_callbacks_mutex);
+		pthread_mutex_unlock(&obs->data.draw_callbacks_mutex);
 
-	/* In some cases we can reuse a previous mix's texture and save re-rendering everything */
-	size_t reuse_idx;
-	if (can_reuse_mix_texture(video, &reuse_idx))
-		draw_mix_texture(reuse_idx);
-	else
-		obs_view_render(video->view);
+		os_atomic_set_bool(&obs->video.render_unstable, false);
 
-	video->texture_rendered = true;
+		/* In some cases we can reuse a previous mix's texture and save re-rendering everything */
+		size_t reuse_idx;
+		if (can_reuse_mix_texture(video, &reuse_idx)) {
+			if (render_width != base_width || render_height != base_height)
+				set_render_size(render_width, render_height);
+			draw_mix_texture(reuse_idx, render_width, render_height);
+			video->last_render_stable = obs->video.mixes.array[reuse_idx]->last_render_stable;
+		} else {
+			obs_view_render(video->view);
+			video->last_render_stable = !os_atomic_load_bool(&obs->video.render_unstable);
+		}
+		if (have_draw_callbacks)
+			video->last_render_stable = false;
+		video->last_change_count = change_count;
+
+		video->texture_rendered = true;
+	}
 
 	pthread_mutex_lock(&obs->data.draw_callbacks_mutex);
 
@@ -242,6 +503,11 @@ static inline gs_effect_t *get_scale_effect_internal(struct obs_core_video_mix *
 
 static inline bool resolution_close(struct obs_core_video_mix *mix, uint32_t width, uint32_t height)
 {
+	/* with dynamic resolution active the render is smaller than the
+	 * canvas, so even a same-size output needs a real scale filter */
+	if (obs->video.dynres_level)
+		return false;
+
 	long width_cmp = (long)mix->ovi.base_width - (long)width;
 	long height_cmp = (long)mix->ovi.base_height - (long)height;
 
@@ -264,6 +530,159 @@ static inline gs_effect_t *get_scale_effect(struct obs_core_video_mix *mix, uint
 	}
 }
 
+/* finds the smallest output texture of the same view that was already
+ * scaled this frame and is still larger than the requested size; feeding
+ * smaller rungs from an already-downscaled texture costs far less memory
+ * bandwidth than rescaling the full canvas for every encoder mix */
+static gs_texture_t *find_scale_source(struct obs_core_video_mix *mix, uint32_t width, uint32_t height,
+				       uint32_t *src_width, uint32_t *src_height)
+{
+	gs_texture_t *best = NULL;
+	uint32_t best_w = 0;
+	uint32_t best_h = 0;
+
+	for (size_t i = 0, num = obs->video.mixes.num; i < num; i++) {
+		struct obs_core_video_mix *other = obs->video.mixes.array[i];
+		gs_texture_t *tex;
+		uint32_t w, h;
+
+		if (other == mix)
+			break;
+		if (other->view != mix->view || other->render_space != mix->render_space)
+			continue;
+		if (!other->output_scaled)
+			continue;
+
+		tex = other->output_texture;
+		w = gs_texture_get_width(tex);
+		h = gs_texture_get_height(tex);
+
+		if (w <= width || h <= height)
+			continue;
+		if (gs_texture_get_color_format(tex) != gs_texture_get_color_format(mix->output_texture))
+			continue;
+
+		if (!best || (uint64_t)w * h < (uint64_t)best_w * best_h) {
+			best = tex;
+			best_w = w;
+			best_h = h;
+		}
+	}
+
+	if (best) {
+		*src_width = best_w;
+		*src_height = best_h;
+	}
+
+	return best;
+}
+
+/* bicubic/lanczos are separable, so the rescale can run as a horizontal
+ * pass into an intermediate texture followed by a vertical pass, sampling
+ * a short 1-D kernel twice instead of the full 2-D kernel once */
+static const char *get_separable_scale_tech(struct obs_core_video_mix *mix)
+{
+	const struct video_output_info *info = video_output_get_info(mix->video);
+
+	if (!obs->video.separable_scale_effect)
+		return NULL;
+
+	/* the bilinear lowres fallback is not separable */
+	if (info->width < (mix->ovi.base_width / 2) && info->height < (mix->ovi.base_height / 2))
+		return NULL;
+
+	switch (mix->ovi.scale_type) {
+	case OBS_SCALE_BILINEAR:
+	case OBS_SCALE_AREA:
+		return NULL;
+	case OBS_SCALE_LANCZOS:
+		return "DrawLanczos";
+	case OBS_SCALE_BICUBIC:
+	default:
+		return "DrawBicubic";
+	}
+}
+
+static bool render_output_separable(struct obs_core_video_mix *mix, gs_texture_t *texture, gs_texture_t *target,
+				    uint32_t src_width, uint32_t src_height, const char *tech_name)
+{
+	const uint32_t width = gs_texture_get_width(target);
+	const uint32_t height = gs_texture_get_height(target);
+	const enum gs_color_format format = gs_texture_get_color_format(target);
+	gs_effect_t *effect = obs->video.separable_scale_effect;
+	gs_texture_t *mid = mix->scale_intermediate_texture;
+	struct vec2 base, base_i, axis;
+	size_t passes, i;
+
+	if (mid && (gs_texture_get_width(mid) != width || gs_texture_get_height(mid) != src_height ||
+		    gs_texture_get_color_format(mid) != format)) {
+		gs_texture_destroy(mid);
+		mid = NULL;
+	}
+	if (!mid)
+		mid = gs_texture_create(width, src_height, format, 1, NULL, GS_RENDER_TARGET);
+	mix->scale_intermediate_texture = mid;
+	if (!mid)
+		return false;
+
+	gs_technique_t *tech = gs_effect_get_technique(effect, tech_name);
+	gs_eparam_t *image = gs_effect_get_param_by_name(effect, "image");
+	gs_eparam_t *bres = gs_effect_get_param_by_name(effect, "base_dimension");
+	gs_eparam_t *bres_i = gs_effect_get_param_by_name(effect, "base_dimension_i");
+	gs_eparam_t *axis_param = gs_effect_get_param_by_name(effect, "axis");
+
+	gs_enable_depth_test(false);
+	gs_set_cull_mode(GS_NEITHER);
+	gs_enable_blending(false);
+	gs_enable_framebuffer_srgb(true);
+
+	/* horizontal pass: source -> (output width x source height) */
+	gs_set_render_target(mid, NULL);
+	gs_ortho(0.0f, (float)src_width, 0.0f, (float)src_height, -100.0f, 100.0f);
+	gs_set_viewport(0, 0, width, src_height);
+
+	vec2_set(&base, (float)src_width, (float)src_height);
+	vec2_set(&base_i, 1.0f / (float)src_width, 1.0f / (float)src_height);
+	vec2_set(&axis, 1.0f, 0.0f);
+	gs_effect_set_vec2(bres, &base);
+	gs_effect_set_vec2(bres_i, &base_i);
+	gs_effect_set_vec2(axis_param, &axis);
+	gs_effect_set_texture_srgb(image, texture);
+
+	passes = gs_technique_begin(tech);
+	for (i = 0; i < passes; i++) {
+		gs_technique_begin_pass(tech, i);
+		gs_draw_sprite_subregion(texture, 0, 0, 0, src_width, src_height);
+		gs_technique_end_pass(tech);
+	}
+	gs_technique_end(tech);
+
+	/* vertical pass: intermediate -> output */
+	gs_set_render_target(target, NULL);
+	gs_ortho(0.0f, (float)width, 0.0f, (float)src_height, -100.0f, 100.0f);
+	gs_set_viewport(0, 0, width, height);
+
+	vec2_set(&base, (float)width, (float)src_height);
+	vec2_set(&base_i, 1.0f / (float)width, 1.0f / (float)src_height);
+	vec2_set(&axis, 0.0f, 1.0f);
+	gs_effect_set_vec2(bres, &base);
+	gs_effect_set_vec2(bres_i, &base_i);
+	gs_effect_set_vec2(axis_param, &axis);
+	gs_effect_set_texture_srgb(image, mid);
+
+	passes = gs_technique_begin(tech);
+	for (i = 0; i < passes; i++) {
+		gs_technique_begin_pass(tech, i);
+		gs_draw_sprite_subregion(mid, 0, 0, 0, width, src_height);
+		gs_technique_end_pass(tech);
+	}
+	gs_technique_end(tech);
+
+	gs_enable_blending(true);
+	gs_enable_framebuffer_srgb(false);
+	return true;
+}
+
 static const char *render_output_texture_name = "render_output_texture";
 static inline gs_texture_t *render_output_texture(struct obs_core_video_mix *mix)
 {
@@ -272,11 +691,29 @@ static inline gs_texture_t *render_output_texture(struct obs_core_video_mix *mix
 	gs_texture_t *target = mix->output_texture;
 	const uint32_t width = gs_texture_get_width(target);
 	const uint32_t height = gs_texture_get_height(target);
-	if ((width == ovi->base_width) && (height == ovi->base_height))
+	uint32_t src_width, src_height;
+
+	dynres_dimensions(ovi, &src_width, &src_height);
+
+	/* the render texture can only be used as-is at full canvas size: at
+	 * a reduced dynamic resolution only its top-left subregion is valid */
+	if ((width == ovi->base_width) && (height == ovi->base_height) && src_width == ovi->base_width &&
+	    src_height == ovi->base_height)
 		return texture;
 
 	profile_start(render_output_texture_name);
 
+	gs_texture_t *cascade = find_scale_source(mix, width, height, &src_width, &src_height);
+	if (cascade)
+		texture = cascade;
+
+	const char *sep_tech = resolution_close(mix, width, height) ? NULL : get_separable_scale_tech(mix);
+	if (sep_tech && render_output_separable(mix, texture, target, src_width, src_height, sep_tech)) {
+		mix->output_scaled = true;
+		profile_end(render_output_texture_name);
+		return target;
+	}
+
 	gs_effect_t *effect = get_scale_effect(mix, width, height);
 	gs_technique_t *tech = gs_effect_get_technique(effect, "Draw");
 
@@ -286,17 +723,23 @@ static inline gs_texture_t *render_output_texture(struct obs_core_video_mix *mix
 	size_t passes, i;
 
 	gs_set_render_target(target, NULL);
-	set_render_size(width, height);
+
+	/* project the valid source region onto the full target so that a
+	 * dynamically scaled render only samples its rendered subregion */
+	gs_enable_depth_test(false);
+	gs_set_cull_mode(GS_NEITHER);
+	gs_ortho(0.0f, (float)src_width, 0.0f, (float)src_height, -100.0f, 100.0f);
+	gs_set_viewport(0, 0, width, height);
 
 	if (bres) {
 		struct vec2 base;
-		vec2_set(&base, (float)mix->ovi.base_width, (float)mix->ovi.base_height);
+		vec2_set(&base, (float)src_width, (float)src_height);
 		gs_effect_set_vec2(bres, &base);
 	}
 
 	if (bres_i) {
 		struct vec2 base_i;
-		vec2_set(&base_i, 1.0f / (float)mix->ovi.base_width, 1.0f / (float)mix->ovi.base_height);
+		vec2_set(&base_i, 1.0f / (float)src_width, 1.0f / (float)src_height);
 		gs_effect_set_vec2(bres_i, &base_i);
 	}
 
@@ -307,13 +750,15 @@ static inline gs_texture_t *render_output_texture(struct obs_core_video_mix *mix
 	passes = gs_technique_begin(tech);
 	for (i = 0; i < passes; i++) {
 		gs_technique_begin_pass(tech, i);
-		gs_draw_sprite(texture, 0, width, height);
+		gs_draw_sprite_subregion(texture, 0, 0, 0, src_width, src_height);
 		gs_technique_end_pass(tech);
 	}
 	gs_technique_end(tech);
 	gs_enable_blending(true);
 	gs_enable_framebuffer_srgb(false);
 
+	mix->output_scaled = true;
+
 	profile_end(render_output_texture_name);
 
 	return target;
@@ -344,6 +789,8 @@ static void render_convert_texture(struct obs_core_video_mix *video, gs_texture_
 {
 	profile_start(render_convert_texture_name);
 
+	gs_timer_t *stage_timer = source_profiler_pipeline_begin();
+
 	gs_effect_t *effect = obs->video.conversion_effect;
 	gs_eparam_t *color_vec0 = gs_effect_get_param_by_name(effect, "color_vec0");
 	gs_eparam_t *color_vec1 = gs_effect_get_param_by_name(effect, "color_vec1");
@@ -398,6 +845,8 @@ static void render_convert_texture(struct obs_core_video_mix *video, gs_texture_
 
 	video->texture_converted = true;
 
+	source_profiler_pipeline_end(PROFILER_PIPELINE_CONVERT, stage_timer);
+
 	profile_end(render_convert_texture_name);
 }
 
@@ -441,23 +890,41 @@ static inline bool queue_frame(struct obs_core_video_mix *video, bool raw_active
 {
 	bool duplicate = !video->gpu_encoder_avail_queue.size ||
 			 (video->gpu_encoder_queue.size && vframe_info->count > 1);
+	struct obs_tex_frame tf;
+	int count = 1;
+	uint64_t timestamp = vframe_info->timestamp;
 
 	if (duplicate) {
-		struct obs_tex_frame *tf =
-			deque_data(&video->gpu_encoder_queue, video->gpu_encoder_queue.size - sizeof(*tf));
+		bool replace_queued = !video->gpu_encoder_avail_queue.size && video->gpu_encoder_queue.size &&
+				      vframe_info->count == 1;
 
-		/* texture-based encoding is stopping */
-		if (!tf) {
-			return false;
+		if (!replace_queued) {
+			struct obs_tex_frame *back =
+				deque_data(&video->gpu_encoder_queue, video->gpu_encoder_queue.size - sizeof(*back));
+
+			/* texture-based encoding is stopping */
+			if (!back) {
+				return false;
+			}
+
+			back->count++;
+			os_sem_post(video->gpu_encode_semaphore);
+			goto finish;
 		}
 
-		tf->count++;
-		os_sem_post(video->gpu_encode_semaphore);
-		goto finish;
-	}
+		/* all textures are in flight: rather than repeating the
+		 * last queued frame and discarding the new one, drop the
+		 * queued frame's content and reuse its texture for the new
+		 * frame, so a transient encoder stall never freezes the
+		 * encoded output on stale pixels */
+		deque_pop_back(&video->gpu_encoder_queue, &tf, sizeof(tf));
+		count = tf.count + 1;
+		timestamp = tf.timestamp;
 
-	struct obs_tex_frame tf;
-	deque_pop_front(&video->gpu_encoder_avail_queue, &tf, sizeof(tf));
+		video_output_inc_texture_dropped_frames(video->video);
+	} else {
+		deque_pop_front(&video->gpu_encoder_avail_queue, &tf, sizeof(tf));
+	}
 
 	if (tf.released) {
 #ifdef _WIN32
@@ -490,8 +957,8 @@ static inline bool queue_frame(struct obs_core_video_mix *video, bool raw_active
 		tf.tex_uv = tex_uv;
 	}
 
-	tf.count = 1;
-	tf.timestamp = vframe_info->timestamp;
+	tf.count = count;
+	tf.timestamp = timestamp;
 	tf.released = true;
 #ifdef _WIN32
 	tf.handle = gs_texture_get_shared_handle(tf.tex);
@@ -597,43 +1064,114 @@ static inline bool download_frame(struct obs_core_video_mix *video, int prev_tex
 	return true;
 }
 
-static const uint8_t *set_gpu_converted_plane(uint32_t width, uint32_t height, uint32_t linesize_input,
-					      uint32_t linesize_output, const uint8_t *in, uint8_t *out)
+/* Readback copies are described as per-plane row copies first, then
+ * executed in row slices so that the tick workers can share the work. */
+struct frame_plane_copy {
+	uint32_t width; /* bytes per row */
+	uint32_t height;
+	uint32_t linesize_in;
+	uint32_t linesize_out;
+	const uint8_t *in;
+	uint8_t *out;
+};
+
+struct frame_copy_job {
+	struct frame_plane_copy planes[MAX_AV_PLANES];
+	size_t num_planes;
+	uint32_t slices_per_plane;
+	volatile long next_slice;
+};
+
+static const uint8_t *add_plane_copy(struct frame_copy_job *job, uint32_t width, uint32_t height,
+				     uint32_t linesize_input, uint32_t linesize_output, const uint8_t *in,
+				     uint8_t *out)
+{
+	struct frame_plane_copy *plane = &job->planes[job->num_planes++];
+
+	plane->width = width;
+	plane->height = height;
+	plane->linesize_in = linesize_input;
+	plane->linesize_out = linesize_output;
+	plane->in = in;
+	plane->out = out;
+
+	return in + (size_t)height * (size_t)linesize_input;
+}
+
+static void copy_plane_rows(const struct frame_plane_copy *p, uint32_t start_y, uint32_t end_y)
 {
-	if ((width == linesize_input) && (width == linesize_output)) {
-		size_t total = (size_t)width * (size_t)height;
-		memcpy(out, in, total);
-		in += total;
+	const uint8_t *in = p->in + (size_t)start_y * (size_t)p->linesize_in;
+	uint8_t *out = p->out + (size_t)start_y * (size_t)p->linesize_out;
+
+	if ((p->width == p->linesize_in) && (p->width == p->linesize_out)) {
+		memcpy(out, in, (size_t)p->width * (size_t)(end_y - start_y));
 	} else {
-		for (size_t y = 0; y < height; y++) {
-			memcpy(out, in, width);
-			out += linesize_output;
-			in += linesize_input;
+		for (uint32_t y = start_y; y < end_y; y++) {
+			memcpy(out, in, p->width);
+			out += p->linesize_out;
+			in += p->linesize_in;
 		}
 	}
+}
 
-	return in;
+static void copy_frame_slices(void *param)
+{
+	struct frame_copy_job *job = param;
+	const long total = (long)(job->num_planes * job->slices_per_plane);
+	long i;
+
+	while ((i = os_atomic_inc_long(&job->next_slice) - 1) < total) {
+		const struct frame_plane_copy *p = &job->planes[i / (long)job->slices_per_plane];
+		const uint32_t slice = (uint32_t)(i % (long)job->slices_per_plane);
+		const uint32_t rows = (p->height + job->slices_per_plane - 1) / job->slices_per_plane;
+		const uint32_t start_y = slice * rows;
+		uint32_t end_y = start_y + rows;
+
+		if (start_y >= p->height)
+			continue;
+		if (end_y > p->height)
+			end_y = p->height;
+
+		copy_plane_rows(p, start_y, end_y);
+	}
 }
 
-static void set_gpu_converted_data(struct video_frame *output, const struct video_data *input,
-				   const struct video_output_info *info)
+static void gather_gpu_converted_planes(struct frame_copy_job *job, struct video_frame *output,
+					const struct video_data *input, const struct video_output_info *info)
 {
 	switch (info->format) {
 	case VIDEO_FORMAT_I420: {
 		const uint32_t width = info->width;
 		const uint32_t height = info->height;
 
-		set_gpu_converted_plane(width, height, input->linesize[0], output->linesize[0], input->data[0],
-					output->data[0]);
+		add_plane_copy(job, width, height, input->linesize[0], output->linesize[0], input->data[0],
+			       output->data[0]);
 
 		const uint32_t width_d2 = width / 2;
 		const uint32_t height_d2 = height / 2;
 
-		set_gpu_converted_plane(width_d2, height_d2, input->linesize[1], output->linesize[1], input->data[1],
-					output->data[1]);
+		add_plane_copy(job, width_d2, height_d2, input->linesize[1], output->linesize[1], input->data[1],
+			       output->data[1]);
 
-		set_gpu_converted_plane(width_d2, height_d2, input->linesize[2], output->linesize[2], input->data[2],
-					output->data[2]);
+		add_plane_copy(job, width_d2, height_d2, input->linesize[2], output->linesize[2], input->data[2],
+			       output->data[2]);
+
+		break;
+	}
+	case VIDEO_FORMAT_I422: {
+		const uint32_t width = info->width;
+		const uint32_t height = info->height;
+
+		add_plane_copy(job, width, height, input->linesize[0], output->linesize[0], input->data[0],
+			       output->data[0]);
+
+		const uint32_t width_d2 = width / 2;
+
+		add_plane_copy(job, width_d2, height, input->linesize[1], output->linesize[1], input->data[1],
+			       output->data[1]);
+
+		add_plane_copy(job, width_d2, height, input->linesize[2], output->linesize[2], input->data[2],
+			       output->data[2]);
 
 		break;
 	}
@@ -642,16 +1180,16 @@ static void set_gpu_converted_data(struct video_frame *output, const struct vide
 		const uint32_t height = info->height;
 		const uint32_t height_d2 = height / 2;
 		if (input->linesize[1]) {
-			set_gpu_converted_plane(width, height, input->linesize[0], output->linesize[0], input->data[0],
-						output->data[0]);
-			set_gpu_converted_plane(width, height_d2, input->linesize[1], output->linesize[1],
-						input->data[1], output->data[1]);
+			add_plane_copy(job, width, height, input->linesize[0], output->linesize[0], input->data[0],
+				       output->data[0]);
+			add_plane_copy(job, width, height_d2, input->linesize[1], output->linesize[1], input->data[1],
+				       output->data[1]);
 		} else {
-			const uint8_t *const in_uv = set_gpu_converted_plane(width, height, input->linesize[0],
-									     output->linesize[0], input->data[0],
-									     output->data[0]);
-			set_gpu_converted_plane(width, height_d2, input->linesize[0], output->linesize[1], in_uv,
-						output->data[1]);
+			const uint8_t *const in_uv = add_plane_copy(job, width, height, input->linesize[0],
+								    output->linesize[0], input->data[0],
+								    output->data[0]);
+			add_plane_copy(job, width, height_d2, input->linesize[0], output->linesize[1], in_uv,
+				       output->data[1]);
 		}
 
 		break;
@@ -660,14 +1198,14 @@ static void set_gpu_converted_data(struct video_frame *output, const struct vide
 		const uint32_t width = info->width;
 		const uint32_t height = info->height;
 
-		set_gpu_converted_plane(width, height, input->linesize[0], output->linesize[0], input->data[0],
-					output->data[0]);
+		add_plane_copy(job, width, height, input->linesize[0], output->linesize[0], input->data[0],
+			       output->data[0]);
 
-		set_gpu_converted_plane(width, height, input->linesize[1], output->linesize[1], input->data[1],
-					output->data[1]);
+		add_plane_copy(job, width, height, input->linesize[1], output->linesize[1], input->data[1],
+			       output->data[1]);
 
-		set_gpu_converted_plane(width, height, input->linesize[2], output->linesize[2], input->data[2],
-					output->data[2]);
+		add_plane_copy(job, width, height, input->linesize[2], output->linesize[2], input->data[2],
+			       output->data[2]);
 
 		break;
 	}
@@ -675,16 +1213,16 @@ static void set_gpu_converted_data(struct video_frame *output, const struct vide
 		const uint32_t width = info->width;
 		const uint32_t height = info->height;
 
-		set_gpu_converted_plane(width * 2, height, input->linesize[0], output->linesize[0], input->data[0],
-					output->data[0]);
+		add_plane_copy(job, width * 2, height, input->linesize[0], output->linesize[0], input->data[0],
+			       output->data[0]);
 
 		const uint32_t height_d2 = height / 2;
 
-		set_gpu_converted_plane(width, height_d2, input->linesize[1], output->linesize[1], input->data[1],
-					output->data[1]);
+		add_plane_copy(job, width, height_d2, input->linesize[1], output->linesize[1], input->data[1],
+			       output->data[1]);
 
-		set_gpu_converted_plane(width, height_d2, input->linesize[2], output->linesize[2], input->data[2],
-					output->data[2]);
+		add_plane_copy(job, width, height_d2, input->linesize[2], output->linesize[2], input->data[2],
+			       output->data[2]);
 
 		break;
 	}
@@ -693,16 +1231,16 @@ static void set_gpu_converted_data(struct video_frame *output, const struct vide
 		const uint32_t height = info->height;
 		const uint32_t height_d2 = height / 2;
 		if (input->linesize[1]) {
-			set_gpu_converted_plane(width_x2, height, input->linesize[0], output->linesize[0],
-						input->data[0], output->data[0]);
-			set_gpu_converted_plane(width_x2, height_d2, input->linesize[1], output->linesize[1],
-						input->data[1], output->data[1]);
+			add_plane_copy(job, width_x2, height, input->linesize[0], output->linesize[0], input->data[0],
+				       output->data[0]);
+			add_plane_copy(job, width_x2, height_d2, input->linesize[1], output->linesize[1],
+				       input->data[1], output->data[1]);
 		} else {
-			const uint8_t *const in_uv = set_gpu_converted_plane(width_x2, height, input->linesize[0],
-									     output->linesize[0], input->data[0],
-									     output->data[0]);
-			set_gpu_converted_plane(width_x2, height_d2, input->linesize[0], output->linesize[1], in_uv,
-						output->data[1]);
+			const uint8_t *const in_uv = add_plane_copy(job, width_x2, height, input->linesize[0],
+								    output->linesize[0], input->data[0],
+								    output->data[0]);
+			add_plane_copy(job, width_x2, height_d2, input->linesize[0], output->linesize[1], in_uv,
+				       output->data[1]);
 		}
 
 		break;
@@ -711,22 +1249,22 @@ static void set_gpu_converted_data(struct video_frame *output, const struct vide
 		const uint32_t width_x2 = info->width * 2;
 		const uint32_t height = info->height;
 
-		set_gpu_converted_plane(width_x2, height, input->linesize[0], output->linesize[0], input->data[0],
-					output->data[0]);
+		add_plane_copy(job, width_x2, height, input->linesize[0], output->linesize[0], input->data[0],
+			       output->data[0]);
 
-		set_gpu_converted_plane(width_x2, height, input->linesize[1], output->linesize[1], input->data[1],
-					output->data[1]);
+		add_plane_copy(job, width_x2, height, input->linesize[1], output->linesize[1], input->data[1],
+			       output->data[1]);
 
 		break;
 	}
 	case VIDEO_FORMAT_P416: {
 		const uint32_t height = info->height;
 
-		set_gpu_converted_plane(info->width * 2, height, input->linesize[0], output->linesize[0],
-					input->data[0], output->data[0]);
+		add_plane_copy(job, info->width * 2, height, input->linesize[0], output->linesize[0], input->data[0],
+			       output->data[0]);
 
-		set_gpu_converted_plane(info->width * 4, height, input->linesize[1], output->linesize[1],
-					input->data[1], output->data[1]);
+		add_plane_copy(job, info->width * 4, height, input->linesize[1], output->linesize[1], input->data[1],
+			       output->data[1]);
 
 		break;
 	}
@@ -741,7 +1279,6 @@ static void set_gpu_converted_data(struct video_frame *output, const struct vide
 	case VIDEO_FORMAT_Y800:
 	case VIDEO_FORMAT_BGR3:
 	case VIDEO_FORMAT_I412:
-	case VIDEO_FORMAT_I422:
 	case VIDEO_FORMAT_I210:
 	case VIDEO_FORMAT_I40A:
 	case VIDEO_FORMAT_I42A:
@@ -755,25 +1292,16 @@ static void set_gpu_converted_data(struct video_frame *output, const struct vide
 	}
 }
 
-static inline void copy_rgbx_frame(struct video_frame *output, const struct video_data *input,
-				   const struct video_output_info *info)
+static inline void gather_rgbx_plane(struct frame_copy_job *job, struct video_frame *output,
+				     const struct video_data *input, const struct video_output_info *info)
 {
-	uint8_t *in_ptr = input->data[0];
-	uint8_t *out_ptr = output->data[0];
-
-	/* if the line sizes match, do a single copy */
-	if (input->linesize[0] == output->linesize[0]) {
-		memcpy(out_ptr, in_ptr, (size_t)input->linesize[0] * (size_t)info->height);
-	} else {
-		const size_t copy_size = (size_t)info->width * 4;
-		for (size_t y = 0; y < info->height; y++) {
-			memcpy(out_ptr, in_ptr, copy_size);
-			in_ptr += input->linesize[0];
-			out_ptr += output->linesize[0];
-		}
-	}
+	add_plane_copy(job, info->width * 4, info->height, input->linesize[0], output->linesize[0], input->data[0],
+		       output->data[0]);
 }
 
+/* frames at or above this height are worth the worker dispatch overhead */
+#define PARALLEL_COPY_MIN_HEIGHT 720
+
 static inline void output_video_data(struct obs_core_video_mix *video, struct video_data *input_frame, int count)
 {
 	const struct video_output_info *info;
@@ -784,10 +1312,23 @@ static inline void output_video_data(struct obs_core_video_mix *video, struct vi
 
 	locked = video_output_lock_frame(video->video, &output_frame, count, input_frame->timestamp);
 	if (locked) {
-		if (video->gpu_conversion) {
-			set_gpu_converted_data(&output_frame, input_frame, info);
+		struct frame_copy_job job = {0};
+
+		if (video->gpu_conversion)
+			gather_gpu_converted_planes(&job, &output_frame, input_frame, info);
+		else
+			gather_rgbx_plane(&job, &output_frame, input_frame, info);
+
+		if (obs->video.tick_threads.num && info->height >= PARALLEL_COPY_MIN_HEIGHT) {
+			/* slice each plane's rows across the tick worker
+			 * pool, with this thread working as well */
+			job.slices_per_plane = (uint32_t)obs->video.tick_threads.num + 1;
+			video_workers_start(copy_frame_slices, &job);
+			copy_frame_slices(&job);
+			video_workers_join();
 		} else {
-			copy_rgbx_frame(&output_frame, input_frame, info);
+			job.slices_per_plane = 1;
+			copy_frame_slices(&job);
 		}
 
 		video_output_unlock_frame(video->video);
@@ -810,6 +1351,21 @@ static inline void video_sleep(struct obs_core_video *video, uint64_t *p_time, u
 	int count;
 
 	if (os_sleepto_ns(t)) {
+		static const uint64_t bounds[4] = {25000, 100000, 500000, 2000000};
+		const uint64_t late_ns = os_gettime_ns() - t;
+		size_t bucket = 4;
+
+		for (size_t i = 0; i < 4; i++) {
+			if (late_ns < bounds[i]) {
+				bucket = i;
+				break;
+			}
+		}
+
+		video->pacing_jitter_buckets[bucket]++;
+		if (late_ns > video->pacing_jitter_max_ns)
+			video->pacing_jitter_max_ns = late_ns;
+
 		*p_time = t;
 		count = 1;
 	} else {
@@ -871,7 +1427,9 @@ static inline void output_frame(struct obs_core_video_mix *video)
 	const bool gpu_active = video->gpu_was_active;
 
 	int cur_texture = video->cur_texture;
-	int prev_texture = cur_texture == 0 ? NUM_TEXTURES - 1 : cur_texture - 1;
+	/* map the oldest staged surface so the copy has had the most time
+	 * to complete */
+	int prev_texture = (cur_texture + 1) % NUM_TEXTURES;
 	struct video_data frame;
 	bool frame_ready = 0;
 
@@ -882,7 +1440,9 @@ static inline void output_frame(struct obs_core_video_mix *video)
 
 	profile_start(output_frame_render_video_name);
 	GS_DEBUG_MARKER_BEGIN(GS_DEBUG_COLOR_RENDER_VIDEO, output_frame_render_video_name);
+	gs_timer_t *stage_timer = source_profiler_pipeline_begin();
 	render_video(video, raw_active, gpu_active, cur_texture);
+	source_profiler_pipeline_end(PROFILER_PIPELINE_RENDER, stage_timer);
 	GS_DEBUG_MARKER_END();
 	profile_end(output_frame_render_video_name);
 
@@ -913,13 +1473,194 @@ static inline void output_frame(struct obs_core_video_mix *video)
 		video->cur_texture = 0;
 }
 
+/* ------------------------------------------------------------------------- */
+/* encoder motion hints
+ *
+ * scene rendering pushes the bounding boxes of items that changed since
+ * the previous frame while the main canvas composites; once all mixes
+ * have rendered, the accumulated rects are published as ROI to encoders
+ * that opted in via obs_encoder_set_motion_hints_enabled() so rate
+ * control can favor the regions that actually changed.  a fully static
+ * frame publishes an empty set once, returning the encoder to uniform
+ * allocation without further ROI churn. */
+
+#define MOTION_HINT_MAX_RECTS 16
+#define MOTION_HINT_MIN_SIZE 16
+#define MOTION_HINT_PRIORITY 0.5f
+
+void obs_motion_hints_add_box(const struct matrix4 *box_transform)
+{
+	struct vec3 p[4];
+	float min_x, min_y, max_x, max_y;
+
+	if (!obs->video.collecting_motion_hints)
+		return;
+
+	for (size_t i = 0; i < 4; i++) {
+		vec3_set(&p[i], (float)(i & 1), (float)(i >> 1), 0.0f);
+		vec3_transform(&p[i], &p[i], box_transform);
+	}
+
+	min_x = max_x = p[0].x;
+	min_y = max_y = p[0].y;
+
+	for (size_t i = 1; i < 4; i++) {
+		if (p[i].x < min_x)
+			min_x = p[i].x;
+		if (p[i].x > max_x)
+			max_x = p[i].x;
+		if (p[i].y < min_y)
+			min_y = p[i].y;
+		if (p[i].y > max_y)
+			max_y = p[i].y;
+	}
+
+	if (max_x - min_x < 1.0f || max_y - min_y < 1.0f || max_x < 0.0f || max_y < 0.0f)
+		return;
+
+	struct obs_encoder_roi rect = {
+		.top = (min_y > 0.0f) ? (uint32_t)min_y : 0,
+		.bottom = (uint32_t)(max_y + 1.0f),
+		.left = (min_x > 0.0f) ? (uint32_t)min_x : 0,
+		.right = (uint32_t)(max_x + 1.0f),
+		.priority = MOTION_HINT_PRIORITY,
+	};
+
+	da_push_back(obs->video.motion_rects, &rect);
+}
+
+struct motion_hint_publish {
+	struct obs_encoder_roi rects[MOTION_HINT_MAX_RECTS];
+	size_t num;
+};
+
+static bool publish_motion_hints_enum(void *param, obs_encoder_t *encoder)
+{
+	struct motion_hint_publish *pub = param;
+
+	if (!encoder->motion_hints || encoder->media != obs_get_video())
+		return true;
+	if (!obs_encoder_active(encoder))
+		return true;
+
+	/* skip the ROI rebuild when the hints did not change */
+	bool same = encoder->roi.num == pub->num;
+	for (size_t i = 0; same && i < pub->num; i++)
+		same = memcmp(&encoder->roi.array[i], &pub->rects[i], sizeof(struct obs_encoder_roi)) == 0;
+	if (same)
+		return true;
+
+	obs_encoder_clear_roi(encoder);
+	for (size_t i = 0; i < pub->num; i++)
+		obs_encoder_add_roi(encoder, &pub->rects[i]);
+
+	return true;
+}
+
+static void publish_motion_hints(void)
+{
+	struct motion_hint_publish pub = {0};
+	struct obs_core_video_mix *mix = obs->data.main_canvas ? obs->data.main_canvas->mix : NULL;
+
+	if (!os_atomic_load_long(&obs->video.motion_hint_encoders) || !mix)
+		return;
+
+	const uint32_t base_width = mix->ovi.base_width;
+	const uint32_t base_height = mix->ovi.base_height;
+	const uint32_t out_width = mix->ovi.output_width;
+	const uint32_t out_height = mix->ovi.output_height;
+
+	if (!base_width || !base_height || out_width < MOTION_HINT_MIN_SIZE || out_height < MOTION_HINT_MIN_SIZE)
+		return;
+
+	const float scale_x = (float)out_width / (float)base_width;
+	const float scale_y = (float)out_height / (float)base_height;
+
+	struct obs_encoder_roi *rects = obs->video.motion_rects.array;
+	struct obs_encoder_roi merged;
+	size_t num = obs->video.motion_rects.num;
+	uint64_t area = 0;
+
+	/* too many distinct regions: collapse them into their union */
+	if (num > MOTION_HINT_MAX_RECTS) {
+		merged = rects[0];
+		for (size_t i = 1; i < num; i++) {
+			if (rects[i].left < merged.left)
+				merged.left = rects[i].left;
+			if (rects[i].top < merged.top)
+				merged.top = rects[i].top;
+			if (rects[i].right > merged.right)
+				merged.right = rects[i].right;
+			if (rects[i].bottom > merged.bottom)
+				merged.bottom = rects[i].bottom;
+		}
+		rects = &merged;
+		num = 1;
+	}
+
+	for (size_t i = 0; i < num; i++) {
+		struct obs_encoder_roi r = rects[i];
+
+		r.left = (uint32_t)((float)r.left * scale_x);
+		r.right = (uint32_t)((float)r.right * scale_x);
+		r.top = (uint32_t)((float)r.top * scale_y);
+		r.bottom = (uint32_t)((float)r.bottom * scale_y);
+
+		if (r.right > out_width)
+			r.right = out_width;
+		if (r.bottom > out_height)
+			r.bottom = out_height;
+		if (r.left >= r.right || r.top >= r.bottom)
+			continue;
+
+		/* obs_encoder_add_roi() rejects rects under 16px */
+		if (r.right - r.left < MOTION_HINT_MIN_SIZE) {
+			r.right = r.left + MOTION_HINT_MIN_SIZE;
+			if (r.right > out_width) {
+				r.right = out_width;
+				r.left = out_width - MOTION_HINT_MIN_SIZE;
+			}
+		}
+		if (r.bottom - r.top < MOTION_HINT_MIN_SIZE) {
+			r.bottom = r.top + MOTION_HINT_MIN_SIZE;
+			if (r.bottom > out_height) {
+				r.bottom = out_height;
+				r.top = out_height - MOTION_HINT_MIN_SIZE;
+			}
+		}
+
+		area += (uint64_t)(r.right - r.left) * (uint64_t)(r.bottom - r.top);
+		pub.rects[pub.num++] = r;
+	}
+
+	/* most of the frame changed: uniform allocation beats a huge ROI */
+	if (area * 5 > (uint64_t)out_width * out_height * 3)
+		pub.num = 0;
+
+	obs_enum_encoders(publish_motion_hints_enum, &pub);
+}
+
 static inline void output_frames(void)
 {
+	struct obs_core_video_mix *main_mix = obs->data.main_canvas ? obs->data.main_canvas->mix : NULL;
+	const bool motion_hints = os_atomic_load_long(&obs->video.motion_hint_encoders) > 0;
+
 	pthread_mutex_lock(&obs->video.mixes_mutex);
+
+	da_clear(obs->video.motion_rects);
+	obs->video.motion_frame_count++;
+
+	/* output textures scaled last frame are stale; only textures scaled
+	 * during this pass may feed smaller mixes */
+	for (size_t i = 0, num = obs->video.mixes.num; i < num; i++)
+		obs->video.mixes.array[i]->output_scaled = false;
+
 	for (size_t i = 0, num = obs->video.mixes.num; i < num; i++) {
 		struct obs_core_video_mix *mix = obs->video.mixes.array[i];
 		if (mix->view) {
+			obs->video.collecting_motion_hints = motion_hints && mix == main_mix;
 			output_frame(mix);
+			obs->video.collecting_motion_hints = false;
 		} else {
 			obs->video.mixes.array[i] = NULL;
 			obs_free_video_mix(mix);
@@ -929,6 +1670,8 @@ static inline void output_frames(void)
 		}
 	}
 	pthread_mutex_unlock(&obs->video.mixes_mutex);
+
+	publish_motion_hints();
 }
 
 #define NBSP "\xC2\xA0"
@@ -971,6 +1714,327 @@ static void execute_graphics_tasks(void)
 	}
 }
 
+/* ------------------------------------------------------------------------- */
+/* deferred texture readback service
+ *
+ * snapshots are staged on request and mapped a couple of frames later,
+ * once the copy is certain to have completed, so callers never stall
+ * the render loop waiting on the GPU.  all access happens on the
+ * graphics thread. */
+
+struct texture_readback {
+	gs_texrender_t *texrender;
+	gs_stagesurf_t *stagesurf;
+	uint32_t width;
+	uint32_t height;
+	enum gs_color_format format;
+	int frames_left;
+	obs_texture_readback_cb callback;
+	void *param;
+};
+
+static DARRAY(struct texture_readback) readbacks = {0};
+
+#define READBACK_DELAY_FRAMES 2
+
+void obs_request_texture_readback(gs_texture_t *tex, uint32_t width, uint32_t height,
+				  obs_texture_readback_cb callback, void *param)
+{
+	struct texture_readback rb = {0};
+	uint32_t tex_w, tex_h;
+
+	if (!obs || !tex || !callback)
+		return;
+	if (!gs_get_context()) {
+		blog(LOG_WARNING, "obs_request_texture_readback: must be "
+				  "called within the graphics context");
+		return;
+	}
+
+	tex_w = gs_texture_get_width(tex);
+	tex_h = gs_texture_get_height(tex);
+	if (!width)
+		width = tex_w;
+	if (!height)
+		height = tex_h;
+
+	rb.width = width;
+	rb.height = height;
+	rb.format = gs_texture_get_color_format(tex);
+	rb.frames_left = READBACK_DELAY_FRAMES;
+	rb.callback = callback;
+	rb.param = param;
+
+	/* downscale on the GPU before reading back */
+	if (width != tex_w || height != tex_h) {
+		rb.texrender = gs_texrender_create(rb.format, GS_ZS_NONE);
+
+		if (gs_texrender_begin(rb.texrender, width, height)) {
+			gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+			gs_eparam_t *image = gs_effect_get_param_by_name(effect, "image");
+
+			gs_ortho(0.0f, (float)tex_w, 0.0f, (float)tex_h, -100.0f, 100.0f);
+			gs_effect_set_texture(image, tex);
+
+			while (gs_effect_loop(effect, "Draw"))
+				gs_draw_sprite(tex, 0, 0, 0);
+
+			gs_texrender_end(rb.texrender);
+		}
+
+		tex = gs_texrender_get_texture(rb.texrender);
+	}
+
+	rb.stagesurf = gs_stagesurface_create(width, height, rb.format);
+	gs_stage_texture(rb.stagesurf, tex);
+
+	da_push_back(readbacks, &rb);
+}
+
+void obs_cancel_texture_readback(void *param)
+{
+	if (!obs || !gs_get_context())
+		return;
+
+	for (size_t i = readbacks.num; i > 0; i--) {
+		struct texture_readback *rb = &readbacks.array[i - 1];
+		if (rb->param != param)
+			continue;
+
+		gs_stagesurface_destroy(rb->stagesurf);
+		gs_texrender_destroy(rb->texrender);
+		da_erase(readbacks, i - 1);
+	}
+}
+
+static void process_texture_readbacks(void)
+{
+	for (size_t i = 0; i < readbacks.num;) {
+		struct texture_readback *rb = &readbacks.array[i];
+		uint8_t *data = NULL;
+		uint32_t linesize = 0;
+
+		if (--rb->frames_left > 0) {
+			i++;
+			continue;
+		}
+
+		if (gs_stagesurface_map(rb->stagesurf, &data, &linesize)) {
+			rb->callback(rb->param, data, linesize, rb->width, rb->height, rb->format);
+			gs_stagesurface_unmap(rb->stagesurf);
+		} else {
+			rb->callback(rb->param, NULL, 0, rb->width, rb->height, rb->format);
+		}
+
+		gs_stagesurface_destroy(rb->stagesurf);
+		gs_texrender_destroy(rb->texrender);
+		da_erase(readbacks, i);
+	}
+}
+
+/* notifies pending requests with no data when video shuts down */
+static void free_texture_readbacks(void)
+{
+	for (size_t i = 0; i < readbacks.num; i++) {
+		struct texture_readback *rb = &readbacks.array[i];
+
+		rb->callback(rb->param, NULL, 0, rb->width, rb->height, rb->format);
+		gs_stagesurface_destroy(rb->stagesurf);
+		gs_texrender_destroy(rb->texrender);
+	}
+
+	da_free(readbacks);
+}
+
+/* ------------------------------------------------------------------------- */
+/* source thumbnail service
+ *
+ * renders registered sources at reduced resolution on the graphics
+ * thread — at most one source per output frame so the render loop cost
+ * stays bounded — and delivers the pixels through the deferred readback
+ * service above.  the UI never touches the graphics context. */
+
+struct source_thumbnail {
+	obs_weak_source_t *source;
+	uint32_t max_cx;
+	uint32_t max_cy;
+	uint32_t interval;
+	uint32_t countdown;
+	gs_texrender_t *texrender;
+	obs_texture_readback_cb callback;
+	void *param;
+	bool showing;
+	bool remove;
+};
+
+static DARRAY(struct source_thumbnail) thumbnails = {0};
+static pthread_mutex_t thumbnail_mutex = PTHREAD_MUTEX_INITIALIZER;
+static size_t next_thumbnail = 0;
+
+void obs_add_thumbnail_callback(obs_source_t *source, uint32_t max_width, uint32_t max_height,
+				uint32_t interval_frames, obs_texture_readback_cb callback, void *param)
+{
+	struct source_thumbnail st = {0};
+
+	if (!obs || !source || !callback || !max_width || !max_height)
+		return;
+
+	st.source = obs_source_get_weak_source(source);
+	st.max_cx = max_width;
+	st.max_cy = max_height;
+	st.interval = interval_frames ? interval_frames : 1;
+	st.callback = callback;
+	st.param = param;
+	st.showing = true;
+
+	/* sources that only produce output while shown (e.g. captures)
+	 * must be marked showing for the thumbnail's lifetime */
+	obs_source_inc_showing(source);
+
+	pthread_mutex_lock(&thumbnail_mutex);
+	da_push_back(thumbnails, &st);
+	pthread_mutex_unlock(&thumbnail_mutex);
+}
+
+void obs_remove_thumbnail_callback(obs_texture_readback_cb callback, void *param)
+{
+	if (!obs)
+		return;
+
+	pthread_mutex_lock(&thumbnail_mutex);
+	for (size_t i = 0; i < thumbnails.num; i++) {
+		struct source_thumbnail *st = &thumbnails.array[i];
+		if (st->callback == callback && st->param == param)
+			st->remove = true;
+	}
+	pthread_mutex_unlock(&thumbnail_mutex);
+}
+
+/* graphics thread only */
+static void destroy_source_thumbnail(struct source_thumbnail *st)
+{
+	if (st->showing) {
+		obs_source_t *source = obs_weak_source_get_source(st->source);
+		if (source) {
+			obs_source_dec_showing(source);
+			obs_source_release(source);
+		}
+	}
+
+	obs_cancel_texture_readback(st->param);
+	gs_texrender_destroy(st->texrender);
+	obs_weak_source_release(st->source);
+}
+
+static bool render_source_thumbnail(struct source_thumbnail *st)
+{
+	obs_source_t *source = obs_weak_source_get_source(st->source);
+	uint32_t cx, cy, thumb_cx, thumb_cy;
+
+	if (!source) {
+		st->remove = true;
+		return false;
+	}
+
+	cx = obs_source_get_width(source);
+	cy = obs_source_get_height(source);
+	if (!cx || !cy) {
+		obs_source_release(source);
+		return false;
+	}
+
+	/* fit into the requested box, preserving aspect ratio */
+	thumb_cx = st->max_cx;
+	thumb_cy = cy * st->max_cx / cx;
+	if (thumb_cy > st->max_cy) {
+		thumb_cy = st->max_cy;
+		thumb_cx = cx * st->max_cy / cy;
+	}
+	if (!thumb_cx)
+		thumb_cx = 1;
+	if (!thumb_cy)
+		thumb_cy = 1;
+
+	if (!st->texrender)
+		st->texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+	gs_texrender_reset(st->texrender);
+	if (gs_texrender_begin(st->texrender, thumb_cx, thumb_cy)) {
+		struct vec4 zero;
+		vec4_zero(&zero);
+
+		gs_clear(GS_CLEAR_COLOR, &zero, 0.0f, 0);
+		gs_ortho(0.0f, (float)cx, 0.0f, (float)cy, -100.0f, 100.0f);
+
+		gs_blend_state_push();
+		gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+
+		obs_source_video_render(source);
+
+		gs_blend_state_pop();
+		gs_texrender_end(st->texrender);
+
+		obs_request_texture_readback(gs_texrender_get_texture(st->texrender), 0, 0, st->callback, st->param);
+	}
+
+	obs_source_release(source);
+	return true;
+}
+
+static void process_source_thumbnails(void)
+{
+	pthread_mutex_lock(&thumbnail_mutex);
+
+	for (size_t i = thumbnails.num; i > 0; i--) {
+		struct source_thumbnail *st = &thumbnails.array[i - 1];
+		if (st->remove) {
+			destroy_source_thumbnail(st);
+			da_erase(thumbnails, i - 1);
+		}
+	}
+
+	if (!thumbnails.num) {
+		next_thumbnail = 0;
+		pthread_mutex_unlock(&thumbnail_mutex);
+		return;
+	}
+
+	for (size_t i = 0; i < thumbnails.num; i++) {
+		struct source_thumbnail *st = &thumbnails.array[i];
+		if (st->countdown)
+			st->countdown--;
+	}
+
+	/* render at most one due thumbnail per output frame, round-robin */
+	for (size_t i = 0; i < thumbnails.num; i++) {
+		size_t idx = (next_thumbnail + i) % thumbnails.num;
+		struct source_thumbnail *st = &thumbnails.array[idx];
+
+		if (st->countdown || st->remove)
+			continue;
+
+		st->countdown = st->interval;
+		if (render_source_thumbnail(st)) {
+			next_thumbnail = (idx + 1) % thumbnails.num;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&thumbnail_mutex);
+}
+
+static void free_source_thumbnails(void)
+{
+	pthread_mutex_lock(&thumbnail_mutex);
+	for (size_t i = 0; i < thumbnails.num; i++)
+		destroy_source_thumbnail(&thumbnails.array[i]);
+	da_free(thumbnails);
+	next_thumbnail = 0;
+	pthread_mutex_unlock(&thumbnail_mutex);
+}
+
+/* ------------------------------------------------------------------------- */
+
 #ifdef _WIN32
 
 struct winrt_exports {
@@ -1100,6 +2164,7 @@ bool obs_graphics_thread_loop(struct obs_graphics_context *context)
 	uint64_t frame_time_ns;
 
 	update_active_states();
+	update_dynamic_resolution(frame_start);
 
 	profile_start(context->video_thread_name);
 	source_profiler_frame_begin();
@@ -1132,6 +2197,14 @@ bool obs_graphics_thread_loop(struct obs_graphics_context *context)
 
 	execute_graphics_tasks();
 
+	gs_enter_context(obs->video.graphics);
+	process_source_thumbnails();
+	process_texture_readbacks();
+	gs_process_texture_budget();
+	gs_leave_context();
+
+	barena_reset();
+
 	frame_time_ns = os_gettime_ns() - frame_start;
 
 	source_profiler_frame_collect();
@@ -1173,6 +2246,16 @@ void *obs_graphics_thread(void *param)
 
 	os_set_thread_name("libobs: graphics thread");
 
+	/* frame-scoped bump allocator for transient render allocations,
+	 * reset at the end of every loop iteration */
+	barena_init(256 * 1024);
+
+	/* compile effects deferred during graphics init before rendering
+	 * starts, so render paths never see a missing effect */
+	gs_enter_context(obs->video.graphics);
+	obs_compile_deferred_effects();
+	gs_leave_context();
+
 	const char *video_thread_name = profile_store_name(obs_get_profiler_name_store(),
 							   "obs_graphics_thread(%g" NBSP "ms)", interval / 1000000.);
 	profile_register_root(video_thread_name, interval);
@@ -1194,6 +2277,24 @@ void *obs_graphics_thread(void *param)
 #endif
 		;
 
+	const uint64_t *jb = obs->video.pacing_jitter_buckets;
+	const uint64_t paced = jb[0] + jb[1] + jb[2] + jb[3] + jb[4];
+	if (paced) {
+		blog(LOG_INFO,
+		     "Frame pacing: %.1f%% of %llu sleeps woke within 25us of "
+		     "target (%.1f%% within 100us), max overshoot %llu us",
+		     (double)jb[0] * 100.0 / (double)paced, (unsigned long long)paced,
+		     (double)(jb[0] + jb[1]) * 100.0 / (double)paced,
+		     (unsigned long long)(obs->video.pacing_jitter_max_ns / 1000));
+	}
+
+	gs_enter_context(obs->video.graphics);
+	free_source_thumbnails();
+	free_texture_readbacks();
+	gs_leave_context();
+
+	barena_free();
+
 #ifdef _WIN32
 	uninit_winrt_state(&winrt);
 #endif
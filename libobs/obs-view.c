@@ -106,6 +106,8 @@ void obs_view_set_source(obs_view_t *view, uint32_t channel, obs_source_t *sourc
 
 	pthread_mutex_unlock(&view->channels_mutex);
 
+	obs_canvas_mark_dirty();
+
 	if (source)
 		obs_source_activate(source, view->type);
 
@@ -366,6 +366,7 @@ void log_system_info(void)
 
 struct obs_hotkeys_platform {
 	int vk_codes[OBS_KEY_LAST_VALUE];
+	DWORD last_input_tick;
 };
 
 static int get_virtual_key(obs_key_t key)
@@ -1001,6 +1002,21 @@ bool obs_hotkeys_platform_is_pressed(obs_hotkeys_platform_t *context, obs_key_t
 	return vk_down(obs_key_to_virtual_key(key));
 }
 
+bool obs_hotkeys_platform_input_since_last(obs_hotkeys_platform_t *context)
+{
+	LASTINPUTINFO info = {sizeof(LASTINPUTINFO)};
+
+	/* the session-wide last input tick only moves when the user
+	 * actually types, clicks or moves the mouse */
+	if (!GetLastInputInfo(&info))
+		return true;
+	if (info.dwTime == context->last_input_tick)
+		return false;
+
+	context->last_input_tick = info.dwTime;
+	return true;
+}
+
 void obs_key_to_str(obs_key_t key, struct dstr *str)
 {
 	wchar_t name[128] = L"";
@@ -19,6 +19,8 @@
 
 #include "graphics/matrix4.h"
 #include "callback/calldata.h"
+#include "media-io/video-frame.h"
+#include "util/cf-lexer.h"
 
 #include "obs.h"
 #include "obs-internal.h"
@@ -62,6 +64,13 @@ static inline void calc_gpu_conversion_sizes(struct obs_core_video_mix *video)
 		video->conversion_techs[2] = "Planar_V_Left";
 		video->conversion_width_i = 1.f / (float)info->width;
 		break;
+	case VIDEO_FORMAT_I422:
+		video->conversion_needed = true;
+		video->conversion_techs[0] = "Planar_Y";
+		video->conversion_techs[1] = "Planar_U_Left";
+		video->conversion_techs[2] = "Planar_V_Left";
+		video->conversion_width_i = 1.f / (float)info->width;
+		break;
 	case VIDEO_FORMAT_NV12:
 		video->conversion_needed = true;
 		video->conversion_techs[0] = "NV12_Y";
@@ -201,6 +210,16 @@ static bool obs_init_gpu_conversion(struct obs_core_video_mix *video)
 		if (!video->convert_textures[0] || !video->convert_textures[1] || !video->convert_textures[2])
 			success = false;
 		break;
+	case VIDEO_FORMAT_I422:
+		video->convert_textures[0] =
+			gs_texture_create(info->width, info->height, GS_R8, 1, NULL, GS_RENDER_TARGET);
+		video->convert_textures[1] =
+			gs_texture_create(info->width / 2, info->height, GS_R8, 1, NULL, GS_RENDER_TARGET);
+		video->convert_textures[2] =
+			gs_texture_create(info->width / 2, info->height, GS_R8, 1, NULL, GS_RENDER_TARGET);
+		if (!video->convert_textures[0] || !video->convert_textures[1] || !video->convert_textures[2])
+			success = false;
+		break;
 	case VIDEO_FORMAT_NV12:
 		video->convert_textures[0] =
 			gs_texture_create(info->width, info->height, GS_R8, 1, NULL, GS_RENDER_TARGET);
@@ -288,6 +307,17 @@ static bool obs_init_gpu_copy_surfaces(struct obs_core_video_mix *video, size_t
 		if (!video->copy_surfaces[i][2])
 			return false;
 		break;
+	case VIDEO_FORMAT_I422:
+		video->copy_surfaces[i][0] = gs_stagesurface_create(info->width, info->height, GS_R8);
+		if (!video->copy_surfaces[i][0])
+			return false;
+		video->copy_surfaces[i][1] = gs_stagesurface_create(info->width / 2, info->height, GS_R8);
+		if (!video->copy_surfaces[i][1])
+			return false;
+		video->copy_surfaces[i][2] = gs_stagesurface_create(info->width / 2, info->height, GS_R8);
+		if (!video->copy_surfaces[i][2])
+			return false;
+		break;
 	case VIDEO_FORMAT_NV12:
 		video->copy_surfaces[i][0] = gs_stagesurface_create(info->width, info->height, GS_R8);
 		if (!video->copy_surfaces[i][0])
@@ -474,6 +504,39 @@ gs_effect_t *obs_load_effect(gs_effect_t **effect, const char *file)
 	return *effect;
 }
 
+static void defer_effect_compile(gs_effect_t **effect, const char *file)
+{
+	struct obs_deferred_effect deferred;
+
+	deferred.effect = effect;
+	deferred.file = obs_find_data_file(file);
+
+	pthread_mutex_lock(&obs->video.deferred_effects_mutex);
+	da_push_back(obs->video.deferred_effects, &deferred);
+	pthread_mutex_unlock(&obs->video.deferred_effects_mutex);
+}
+
+/* assumes the graphics context is entered */
+void obs_compile_deferred_effects(void)
+{
+	struct obs_core_video *video = &obs->video;
+
+	pthread_mutex_lock(&video->deferred_effects_mutex);
+
+	for (size_t i = 0; i < video->deferred_effects.num; i++) {
+		struct obs_deferred_effect *deferred = video->deferred_effects.array + i;
+
+		*deferred->effect = gs_effect_create_from_file(deferred->file, NULL);
+		if (!*deferred->effect)
+			blog(LOG_ERROR, "Failed to compile deferred effect '%s'", deferred->file);
+
+		bfree(deferred->file);
+	}
+
+	da_free(video->deferred_effects);
+	pthread_mutex_unlock(&video->deferred_effects_mutex);
+}
+
 static const char *shader_comp_name = "shader compilation";
 static const char *obs_init_graphics_name = "obs_init_graphics";
 static int obs_init_graphics(struct obs_video_info *ovi)
@@ -487,6 +550,11 @@ static int obs_init_graphics(struct obs_video_info *ovi)
 
 	profile_start(obs_init_graphics_name);
 
+	if (pthread_mutex_init(&video->deferred_effects_mutex, NULL) < 0) {
+		profile_end(obs_init_graphics_name);
+		return OBS_VIDEO_FAIL;
+	}
+
 	errorcode = gs_create(&video->graphics, ovi->graphics_module, ovi->adapter);
 	if (errorcode != GS_SUCCESS) {
 		profile_end(obs_init_graphics_name);
@@ -522,30 +590,19 @@ static int obs_init_graphics(struct obs_video_info *ovi)
 	video->solid_effect = gs_effect_create_from_file(filename, NULL);
 	bfree(filename);
 
-	filename = obs_find_data_file("repeat.effect");
-	video->repeat_effect = gs_effect_create_from_file(filename, NULL);
-	bfree(filename);
+	/* effects that are not required for the first frame are compiled on
+	 * the graphics thread instead of blocking obs_reset_video */
+	defer_effect_compile(&video->repeat_effect, "repeat.effect");
+	defer_effect_compile(&video->bicubic_effect, "bicubic_scale.effect");
+	defer_effect_compile(&video->lanczos_effect, "lanczos_scale.effect");
+	defer_effect_compile(&video->area_effect, "area.effect");
+	defer_effect_compile(&video->bilinear_lowres_effect, "bilinear_lowres_scale.effect");
+	defer_effect_compile(&video->separable_scale_effect, "separable_scale.effect");
 
 	filename = obs_find_data_file("format_conversion.effect");
 	video->conversion_effect = gs_effect_create_from_file(filename, NULL);
 	bfree(filename);
 
-	filename = obs_find_data_file("bicubic_scale.effect");
-	video->bicubic_effect = gs_effect_create_from_file(filename, NULL);
-	bfree(filename);
-
-	filename = obs_find_data_file("lanczos_scale.effect");
-	video->lanczos_effect = gs_effect_create_from_file(filename, NULL);
-	bfree(filename);
-
-	filename = obs_find_data_file("area.effect");
-	video->area_effect = gs_effect_create_from_file(filename, NULL);
-	bfree(filename);
-
-	filename = obs_find_data_file("bilinear_lowres_scale.effect");
-	video->bilinear_lowres_effect = gs_effect_create_from_file(filename, NULL);
-	bfree(filename);
-
 	filename = obs_find_data_file("premultiplied_alpha.effect");
 	video->premultiplied_alpha_effect = gs_effect_create_from_file(filename, NULL);
 	bfree(filename);
@@ -706,6 +763,12 @@ static int obs_init_video(struct obs_video_info *ovi)
 	if (!restore_canvases())
 		return OBS_VIDEO_FAIL;
 
+	video->parallel_tick = ovi->parallel_tick;
+	if (video->parallel_tick && !video->tick_threads.num) {
+		if (!obs_init_tick_threads(ovi->parallel_tick_threads))
+			return OBS_VIDEO_FAIL;
+	}
+
 	int errorcode;
 #ifdef __APPLE__
 	pthread_attr_t attr;
@@ -740,6 +803,8 @@ static void stop_video(void)
 		pthread_join(video->video_thread, &thread_retval);
 		video->thread_initialized = false;
 	}
+
+	obs_free_tick_threads();
 }
 
 static void obs_free_render_textures(struct obs_core_video_mix *video)
@@ -787,8 +852,10 @@ static void obs_free_render_textures(struct obs_core_video_mix *video)
 	}
 
 	gs_texture_destroy(video->output_texture);
+	gs_texture_destroy(video->scale_intermediate_texture);
 	video->render_texture = NULL;
 	video->output_texture = NULL;
+	video->scale_intermediate_texture = NULL;
 
 	gs_leave_context();
 }
@@ -830,6 +897,7 @@ static void obs_free_video(void)
 		obs->video.mixes.array[i] = NULL;
 	}
 	da_free(obs->video.mixes);
+	da_free(obs->video.motion_rects);
 	if (num_views > 0)
 		blog(LOG_WARNING, "Number of remaining views: %ld", num_views);
 	pthread_mutex_unlock(&obs->video.mixes_mutex);
@@ -871,12 +939,18 @@ static void obs_free_graphics(void)
 		gs_effect_destroy(video->lanczos_effect);
 		gs_effect_destroy(video->area_effect);
 		gs_effect_destroy(video->bilinear_lowres_effect);
+		gs_effect_destroy(video->separable_scale_effect);
 		video->default_effect = NULL;
 
 		gs_leave_context();
 
 		gs_destroy(video->graphics);
 		video->graphics = NULL;
+
+		for (size_t i = 0; i < video->deferred_effects.num; i++)
+			bfree(video->deferred_effects.array[i].file);
+		da_free(video->deferred_effects);
+		pthread_mutex_destroy(&video->deferred_effects_mutex);
 	}
 }
 
@@ -893,6 +967,8 @@ static bool obs_init_audio(struct audio_output_info *ai)
 		return false;
 	if (pthread_mutex_init(&audio->task_mutex, NULL) != 0)
 		return false;
+	if (pthread_mutex_init(&audio->tick_culprit_mutex, NULL) != 0)
+		return false;
 
 	struct obs_task_info audio_init = {.task = set_audio_thread};
 	deque_push_back(&audio->tasks, &audio_init, sizeof(audio_init));
@@ -900,6 +976,9 @@ static bool obs_init_audio(struct audio_output_info *ai)
 	audio->monitoring_device_name = bstrdup("Default");
 	audio->monitoring_device_id = bstrdup("default");
 
+	if (ai->mix_threads && !obs_init_audio_mix_threads(ai->mix_threads))
+		return false;
+
 	errorcode = audio_output_open(&audio->audio, ai);
 	if (errorcode == AUDIO_OUTPUT_SUCCESS)
 		return true;
@@ -927,6 +1006,8 @@ static void obs_free_audio(void)
 	if (audio->audio)
 		audio_output_close(audio->audio);
 
+	obs_free_audio_mix_threads();
+
 	deque_free(&audio->buffered_timestamps);
 	da_free(audio->render_order);
 	da_free(audio->root_nodes);
@@ -937,6 +1018,20 @@ static void obs_free_audio(void)
 	deque_free(&audio->tasks);
 	pthread_mutex_destroy(&audio->task_mutex);
 	pthread_mutex_destroy(&audio->monitoring_mutex);
+	pthread_mutex_destroy(&audio->tick_culprit_mutex);
+
+	if (audio->tick_overruns) {
+		blog(LOG_INFO,
+		     "Audio tick watchdog: %" PRIu64 " overrun(s); worst "
+		     "stage times (ms): tree=%.02f render=%.02f sync=%.02f "
+		     "mix=%.02f discard=%.02f tasks=%.02f",
+		     audio->tick_overruns, (double)audio->tick_stage_worst_ns[AUDIO_TICK_TREE] / 1000000.0,
+		     (double)audio->tick_stage_worst_ns[AUDIO_TICK_RENDER] / 1000000.0,
+		     (double)audio->tick_stage_worst_ns[AUDIO_TICK_SYNC] / 1000000.0,
+		     (double)audio->tick_stage_worst_ns[AUDIO_TICK_MIX] / 1000000.0,
+		     (double)audio->tick_stage_worst_ns[AUDIO_TICK_DISCARD] / 1000000.0,
+		     (double)audio->tick_stage_worst_ns[AUDIO_TICK_TASKS] / 1000000.0);
+	}
 
 	memset(audio, 0, sizeof(struct obs_core_audio));
 }
@@ -1053,6 +1148,7 @@ static void obs_free_data(void)
 		bfree(data->protocols.array[i]);
 	da_free(data->protocols);
 	da_free(data->sources_to_tick);
+	da_free(data->sources_to_tick_parallel);
 }
 
 static const char *obs_signals[] = {
@@ -1093,6 +1189,8 @@ static const char *obs_signals[] = {
 
 	"void video_reset()",
 
+	"void audio_tick_overrun(string stage, float total_ms, float budget_ms, string culprit, float culprit_ms)",
+
 	NULL,
 };
 
@@ -1109,7 +1207,6 @@ static inline bool obs_init_handlers(void)
 	return signal_handler_add_array(obs->signals, obs_signals);
 }
 
-static pthread_once_t obs_pthread_once_init_token = PTHREAD_ONCE_INIT;
 static inline bool obs_init_hotkeys(void)
 {
 	struct obs_core_hotkeys *hotkeys = &obs->hotkeys;
@@ -1120,7 +1217,6 @@ static inline bool obs_init_hotkeys(void)
 	hotkeys->hotkeys = NULL;
 	hotkeys->hotkey_pairs = NULL;
 	hotkeys->signals = obs->signals;
-	hotkeys->name_map_init_token = obs_pthread_once_init_token;
 	hotkeys->mute = bstrdup("Mute");
 	hotkeys->unmute = bstrdup("Unmute");
 	hotkeys->push_to_mute = bstrdup("Push-to-mute");
@@ -1174,8 +1270,6 @@ static inline void obs_free_hotkeys(void)
 	bfree(hotkeys->sceneitem_show);
 	bfree(hotkeys->sceneitem_hide);
 
-	obs_hotkey_name_map_free();
-
 	obs_hotkeys_platform_free(hotkeys);
 	pthread_mutex_destroy(&hotkeys->mutex);
 }
@@ -1204,6 +1298,7 @@ static bool obs_init(const char *locale, const char *module_config_path, profile
 
 	pthread_mutex_init_value(&obs->audio.monitoring_mutex);
 	pthread_mutex_init_value(&obs->audio.task_mutex);
+	pthread_mutex_init_value(&obs->audio.tick_culprit_mutex);
 	pthread_mutex_init_value(&obs->video.task_mutex);
 	pthread_mutex_init_value(&obs->video.encoder_group_mutex);
 	pthread_mutex_init_value(&obs->video.mixes_mutex);
@@ -1362,6 +1457,13 @@ void obs_shutdown(void)
 
 	obs_wait_for_destroy_queue();
 
+	struct source_type_item *type_item, *type_tmp;
+	HASH_ITER (hh, obs->source_type_lookup, type_item, type_tmp) {
+		HASH_DEL(obs->source_type_lookup, type_item);
+		obs_data_release(type_item->cached_defaults);
+		bfree(type_item);
+	}
+
 	for (size_t i = 0; i < obs->source_types.num; i++) {
 		struct obs_source_info *item = &obs->source_types.array[i];
 		if (item->type_data && item->free_type_data)
@@ -1406,9 +1508,12 @@ void obs_shutdown(void)
 	obs_free_data();
 	obs_free_audio();
 	obs_free_video();
+	video_frame_pool_clear();
 	os_task_queue_destroy(obs->destruction_task_thread);
 	obs_free_hotkeys();
 	obs_free_graphics();
+	cf_lexer_cache_free();
+	obs_missing_files_free_cache();
 	proc_handler_destroy(obs->procs);
 	signal_handler_destroy(obs->signals);
 	obs->procs = NULL;
@@ -1422,6 +1527,8 @@ void obs_shutdown(void)
 		bfree(obs->safe_modules.array[i]);
 	da_free(obs->safe_modules);
 
+	free_lazy_module_types();
+
 	if (obs->name_store_owned)
 		profiler_name_store_free(obs->name_store);
 
@@ -1510,6 +1617,8 @@ int obs_reset_video(struct obs_video_info *ovi)
 		}
 	}
 
+	gs_set_texture_budget((uint64_t)ovi->texture_budget_mb << 20);
+
 	const char *scale_type_name = "";
 	switch (ovi->scale_type) {
 	case OBS_SCALE_DISABLE:
@@ -1588,6 +1697,7 @@ bool obs_reset_audio2(const struct obs_audio_info2 *oai)
 	ai.format = AUDIO_FORMAT_FLOAT_PLANAR;
 	ai.speakers = oai->speakers;
 	ai.input_callback = audio_callback;
+	ai.mix_threads = oai->mix_threads;
 
 	blog(LOG_INFO, "---------------------------------");
 	blog(LOG_INFO,
@@ -2091,6 +2201,13 @@ obs_service_t *obs_get_service_by_name(const char *name)
 
 gs_effect_t *obs_get_base_effect(enum obs_base_effect effect)
 {
+	/* resolve any effects still pending from deferred compilation */
+	if (obs->video.deferred_effects.num) {
+		obs_enter_graphics();
+		obs_compile_deferred_effects();
+		obs_leave_graphics();
+	}
+
 	switch (effect) {
 	case OBS_EFFECT_DEFAULT:
 		return obs->video.default_effect;
@@ -2110,6 +2227,8 @@ gs_effect_t *obs_get_base_effect(enum obs_base_effect effect)
 		return obs->video.area_effect;
 	case OBS_EFFECT_BILINEAR_LOWRES:
 		return obs->video.bilinear_lowres_effect;
+	case OBS_EFFECT_SEPARABLE_SCALE:
+		return obs->video.separable_scale_effect;
 	case OBS_EFFECT_PREMULTIPLIED_ALPHA:
 		return obs->video.premultiplied_alpha_effect;
 	}
@@ -2354,26 +2473,135 @@ obs_source_t *obs_load_private_source(obs_data_t *source_data)
 	return obs_load_source_type(source_data, true);
 }
 
+struct load_sources_ctx {
+	obs_data_array_t *array;
+	obs_source_t **sources;
+	const bool *serial;
+	size_t count;
+	volatile long next;
+};
+
+static void *load_sources_worker(void *param)
+{
+	struct load_sources_ctx *ctx = param;
+
+	os_set_thread_name("libobs: load sources");
+
+	for (;;) {
+		size_t i = (size_t)os_atomic_inc_long(&ctx->next) - 1;
+		if (i >= ctx->count)
+			break;
+		if (ctx->serial[i])
+			continue;
+
+		obs_data_t *source_data = obs_data_array_item(ctx->array, i);
+		ctx->sources[i] = obs_load_source(source_data);
+		obs_data_release(source_data);
+	}
+
+	return NULL;
+}
+
+/* a source can only be created off the loading thread if neither its own
+ * type nor any of its filters' types require serial creation; unknown
+ * types have no info to consult, so keep them on the loading thread */
+static bool source_data_serial_create(obs_data_t *source_data)
+{
+	const char *id = obs_data_get_string(source_data, "versioned_id");
+	struct obs_source_info *info;
+	obs_data_array_t *filters;
+	bool serial = false;
+
+	if (!*id)
+		id = obs_data_get_string(source_data, "id");
+
+	info = get_source_info(id);
+	if (!info || (info->output_flags & OBS_SOURCE_CAP_SERIAL_CREATE) != 0)
+		return true;
+
+	filters = obs_data_get_array(source_data, "filters");
+	if (filters) {
+		size_t count = obs_data_array_count(filters);
+
+		for (size_t i = 0; i < count && !serial; i++) {
+			obs_data_t *filter_data = obs_data_array_item(filters, i);
+			serial = source_data_serial_create(filter_data);
+			obs_data_release(filter_data);
+		}
+
+		obs_data_array_release(filters);
+	}
+
+	return serial;
+}
+
 void obs_load_sources(obs_data_array_t *array, obs_load_source_cb cb, void *private_data)
 {
 	DARRAY(obs_source_t *) sources;
+	bool *serial;
+	bool any_parallel = false;
+	size_t num_threads;
 	size_t count;
 	size_t i;
 
 	da_init(sources);
 
 	count = obs_data_array_count(array);
-	da_reserve(sources, count);
+	da_resize(sources, count);
+
+	serial = bzalloc(count * sizeof(bool));
 
 	for (i = 0; i < count; i++) {
 		obs_data_t *source_data = obs_data_array_item(array, i);
-		obs_source_t *source = obs_load_source(source_data);
+		serial[i] = source_data_serial_create(source_data);
+		if (!serial[i])
+			any_parallel = true;
+		obs_data_release(source_data);
+	}
+
+	num_threads = (size_t)os_get_physical_cores();
+	if (num_threads > count)
+		num_threads = count;
+
+	/* sources do not reference each other until the load phase below, so
+	 * independent entries can be constructed concurrently; the loading
+	 * thread participates as one of the workers */
+	if (any_parallel && num_threads > 1) {
+		struct load_sources_ctx ctx = {
+			.array = array,
+			.sources = sources.array,
+			.serial = serial,
+			.count = count,
+		};
+		pthread_t *threads = bmalloc(sizeof(pthread_t) * (num_threads - 1));
+		size_t started = 0;
+
+		for (i = 0; i < num_threads - 1; i++) {
+			if (pthread_create(&threads[started], NULL, load_sources_worker, &ctx) == 0)
+				started++;
+		}
+
+		load_sources_worker(&ctx);
+
+		for (i = 0; i < started; i++)
+			pthread_join(threads[i], NULL);
+
+		bfree(threads);
+	} else {
+		memset(serial, true, count * sizeof(bool));
+	}
 
-		da_push_back(sources, &source);
+	for (i = 0; i < count; i++) {
+		if (!serial[i])
+			continue;
 
+		obs_data_t *source_data = obs_data_array_item(array, i);
+		sources.array[i] = obs_load_source(source_data);
 		obs_data_release(source_data);
 	}
 
+	bfree(serial);
+
 	/* tell sources that we want to load */
 	for (i = 0; i < sources.num; i++) {
 		obs_source_t *source = sources.array[i];
@@ -3027,6 +3255,27 @@ uint32_t obs_get_lagged_frames(void)
 	return obs->video.lagged_frames;
 }
 
+uint32_t obs_get_composition_skipped_frames(void)
+{
+	return (uint32_t)os_atomic_load_long(&obs->video.skipped_compositions);
+}
+
+void obs_set_dynamic_resolution_enabled(bool enable)
+{
+	os_atomic_set_bool(&obs->video.dynres_enabled, enable);
+}
+
+bool obs_get_dynamic_resolution_enabled(void)
+{
+	return os_atomic_load_bool(&obs->video.dynres_enabled);
+}
+
+float obs_get_dynamic_resolution_scale(void)
+{
+	const long percent = os_atomic_load_long(&obs->video.dynres_scale_percent);
+	return percent ? (float)percent / 100.0f : 1.0f;
+}
+
 struct obs_core_video_mix *get_mix_for_video(video_t *v)
 {
 	struct obs_core_video_mix *result = NULL;
@@ -201,6 +201,23 @@ struct obs_video_info {
 	enum video_range_type range;      /**< YUV range (if YUV) */
 
 	enum obs_scale_type scale_type; /**< How to scale if scaling */
+
+	/**
+	 * Tick sources that have no filter/parent dependencies on a worker
+	 * thread pool instead of serially on the graphics thread
+	 */
+	bool parallel_tick;
+
+	/** Number of tick worker threads (0 = one per physical core) */
+	uint32_t parallel_tick_threads;
+
+	/**
+	 * Texture memory budget in megabytes (0 = unlimited).  When live
+	 * texture memory exceeds the budget, idle demotable textures are
+	 * released least recently used first; see
+	 * gs_texture_set_demotable().
+	 */
+	uint32_t texture_budget_mb;
 };
 
 /**
@@ -217,6 +234,9 @@ struct obs_audio_info2 {
 
 	uint32_t max_buffering_ms;
 	bool fixed_buffering;
+
+	/** Worker threads for per-source audio rendering (0 = serial) */
+	uint32_t mix_threads;
 };
 
 /**
@@ -741,6 +761,7 @@ enum obs_base_effect {
 	OBS_EFFECT_PREMULTIPLIED_ALPHA, /**< Premultiplied alpha */
 	OBS_EFFECT_REPEAT,              /**< RGB/YUV (repeating) */
 	OBS_EFFECT_AREA,                /**< Area rescale */
+	OBS_EFFECT_SEPARABLE_SCALE,     /**< 1-D bicubic/lanczos pass for separable two-pass scaling */
 };
 
 /** Returns a commonly used base effect */
@@ -768,6 +789,46 @@ EXPORT void obs_render_canvas_texture_src_color_only(obs_canvas_t *canvas);
  * is unavailable. */
 EXPORT gs_texture_t *obs_get_main_texture(void);
 
+/**
+ * Called on the graphics thread when a deferred texture readback
+ * completes.  @p data points at the mapped staging copy and is only
+ * valid for the duration of the call; copy out what you need.  @p data
+ * is NULL if the readback failed or video shut down first.
+ */
+typedef void (*obs_texture_readback_cb)(void *param, uint8_t *data, uint32_t linesize, uint32_t width,
+					uint32_t height, enum gs_color_format format);
+
+/**
+ * Requests a deferred snapshot of a texture.  The texture is staged
+ * immediately (optionally downscaled on the GPU first when @p width /
+ * @p height differ from the texture size; 0 means native size) and the
+ * callback fires a couple of frames later once the staging copy is
+ * complete, so the render loop never blocks on the GPU.  Must be
+ * called within the graphics context.
+ */
+EXPORT void obs_request_texture_readback(gs_texture_t *tex, uint32_t width, uint32_t height,
+					 obs_texture_readback_cb callback, void *param);
+
+/** Cancels pending texture readbacks with the given callback parameter.
+ * Must be called within the graphics context. */
+EXPORT void obs_cancel_texture_readback(void *param);
+
+/**
+ * Registers a live thumbnail of a source.  The source is rendered at
+ * reduced resolution (fit into @p max_width x @p max_height, aspect
+ * preserved) on the graphics thread every @p interval_frames output
+ * frames, at most one registered source per frame, and the pixels are
+ * delivered through the deferred readback callback.  May be called from
+ * any thread.
+ */
+EXPORT void obs_add_thumbnail_callback(obs_source_t *source, uint32_t max_width, uint32_t max_height,
+				       uint32_t interval_frames, obs_texture_readback_cb callback, void *param);
+
+/** Unregisters thumbnails matching the callback/parameter pair.  The
+ * callback may still fire until the graphics thread processes the
+ * removal. */
+EXPORT void obs_remove_thumbnail_callback(obs_texture_readback_cb callback, void *param);
+
 /** Saves a source to settings data */
 EXPORT obs_data_t *obs_save_source(obs_source_t *source);
 
@@ -855,6 +916,19 @@ EXPORT uint64_t obs_get_frame_interval_ns(void);
 EXPORT uint32_t obs_get_total_frames(void);
 EXPORT uint32_t obs_get_lagged_frames(void);
 
+/** Number of frames where compositing was skipped because the canvas was
+ * unchanged since the previous frame */
+EXPORT uint32_t obs_get_composition_skipped_frames(void);
+
+/** Enables dynamic resolution: under sustained GPU overload the canvas
+ * renders at a reduced resolution (stepping down to 90% then 75%) and is
+ * upscaled on output, recovering when headroom returns */
+EXPORT void obs_set_dynamic_resolution_enabled(bool enable);
+EXPORT bool obs_get_dynamic_resolution_enabled(void);
+
+/** Currently applied dynamic resolution scale (1.0 when not reduced) */
+EXPORT float obs_get_dynamic_resolution_scale(void);
+
 OBS_DEPRECATED EXPORT bool obs_nv12_tex_active(void);
 OBS_DEPRECATED EXPORT bool obs_p010_tex_active(void);
 
@@ -966,6 +1040,14 @@ EXPORT void obs_display_remove_draw_callback(obs_display_t *display,
 EXPORT void obs_display_set_enabled(obs_display_t *display, bool enable);
 EXPORT bool obs_display_enabled(obs_display_t *display);
 
+/**
+ * Marks a display as hidden (fully occluded or minimized).  Hidden displays
+ * skip rendering and presenting entirely until shown again; unlike disabling
+ * a display this is purely an occlusion hint from the windowing system.
+ */
+EXPORT void obs_display_set_hidden(obs_display_t *display, bool hidden);
+EXPORT bool obs_display_hidden(obs_display_t *display);
+
 EXPORT void obs_display_set_background_color(obs_display_t *display, uint32_t color);
 
 EXPORT void obs_display_size(obs_display_t *display, uint32_t *width, uint32_t *height);
@@ -1348,8 +1430,70 @@ EXPORT void obs_source_draw(gs_texture_t *image, int x, int y, uint32_t cx, uint
 EXPORT void obs_source_output_video(obs_source_t *source, const struct obs_source_frame *frame);
 EXPORT void obs_source_output_video2(obs_source_t *source, const struct obs_source_frame2 *frame);
 
+/**
+ * Outputs asynchronous video data without copying it into the internal frame
+ * cache.  The source holds a reference to the frame until it has been
+ * displayed and released.
+ *
+ * The frame must have been allocated with obs_source_frame_create (or have an
+ * identical memory layout) and must carry at least one caller-owned reference
+ * (refs >= 1).  Once the frame's reference count drops back to the
+ * caller-owned count it may be refilled and output again, which allows
+ * callers to recycle a fixed pool of frames with zero per-frame copies or
+ * allocations inside libobs.
+ */
+EXPORT void obs_source_output_video_take(obs_source_t *source, struct obs_source_frame *frame);
+
+/** Timestamp jitter and playout statistics for an asynchronous source */
+struct obs_source_jitter_stats {
+	/** Smoothed inter-arrival jitter (nanoseconds, RFC3550-style) */
+	uint64_t jitter_avg_ns;
+	/** Slowly decaying peak inter-arrival jitter (nanoseconds) */
+	uint64_t jitter_peak_ns;
+	/** Currently buffered asynchronous video (nanoseconds) */
+	uint64_t buffered_ns;
+	/** Current playout rate (1.0 = realtime) */
+	float playout_rate;
+};
+
+/**
+ * Gets timestamp jitter statistics for an asynchronous source.  Returns
+ * false if the source is invalid.
+ */
+EXPORT bool obs_source_get_jitter_stats(const obs_source_t *source, struct obs_source_jitter_stats *stats);
+
 EXPORT void obs_source_set_async_rotation(obs_source_t *source, long rotation);
 
+/**
+ * Notifies libobs that a synchronously rendered source's video output has
+ * changed.  Sources declaring OBS_SOURCE_STATIC_VIDEO must call this
+ * whenever their rendered output changes outside of a settings update
+ * (e.g. an animated image advancing a frame) so that canvases containing
+ * them are re-composited.
+ */
+EXPORT void obs_source_video_changed(obs_source_t *source);
+
+/**
+ * Overrides the render interval hint of a source at runtime (see
+ * obs_source_info.render_interval_ns).  Zero restores full-rate
+ * ticking/rendering.
+ */
+EXPORT void obs_source_set_render_interval(obs_source_t *source, uint64_t interval_ns);
+EXPORT uint64_t obs_source_get_render_interval(const obs_source_t *source);
+
+/**
+ * Sets a per-frame time budget (combined tick + render CPU time) for a
+ * source.  When the budget is exceeded for overrun_frames consecutive
+ * frames the source emits the 'frame_budget_exceeded' signal, allowing
+ * automation to react to a misbehaving source (e.g. restart a browser
+ * source) before it degrades the whole canvas.
+ *
+ * A budget_ns of zero disables enforcement; an overrun_frames of zero is
+ * treated as one.
+ */
+EXPORT void obs_source_set_frame_budget(obs_source_t *source, uint64_t budget_ns, uint32_t overrun_frames);
+EXPORT uint64_t obs_source_get_frame_budget(const obs_source_t *source);
+
 EXPORT void obs_source_output_cea708(obs_source_t *source, const struct obs_source_cea_708 *captions);
 
 /**
@@ -1757,6 +1901,13 @@ EXPORT void obs_sceneitem_force_update_transform(obs_sceneitem_t *item);
 EXPORT void obs_sceneitem_defer_update_begin(obs_sceneitem_t *item);
 EXPORT void obs_sceneitem_defer_update_end(obs_sceneitem_t *item);
 
+/* Defers transform updates for every item of a scene; the scene is
+ * recomputed in a single pass when the last defer ends.  Intended for bulk
+ * operations that mutate many items at once.  Callers must not read item
+ * transforms mutated earlier in the same batch. */
+EXPORT void obs_scene_defer_update_begin(obs_scene_t *scene);
+EXPORT void obs_scene_defer_update_end(obs_scene_t *scene);
+
 /** Gets private front-end settings data.  This data is saved/loaded
  * automatically.  Returns an incremented reference. */
 EXPORT obs_data_t *obs_sceneitem_get_private_settings(obs_sceneitem_t *item);
@@ -2057,6 +2208,28 @@ EXPORT void obs_output_output_caption_text2(obs_output_t *output, const char *te
 EXPORT float obs_output_get_congestion(obs_output_t *output);
 EXPORT int obs_output_get_connect_time_ms(obs_output_t *output);
 
+/**
+ * Enables shared congestion control for an output.
+ *
+ * When enabled, the output's congestion samples drive the video encoder
+ * bitrate with additive-increase/multiplicative-decrease, and bitrate
+ * changes are reported through the output's "congestion" signal.  The
+ * video encoder must support OBS_ENCODER_CAP_DYN_BITRATE.
+ */
+EXPORT void obs_output_enable_congestion_control(obs_output_t *output, bool enable);
+EXPORT bool obs_output_congestion_control_enabled(const obs_output_t *output);
+
+/**
+ * Feeds a congestion sample from an output's send path.
+ *
+ * @param queued_usec  duration of data queued behind the send socket
+ * @param rtt_usec     measured round-trip time, or 0 if unknown
+ */
+EXPORT void obs_output_submit_congestion_sample(obs_output_t *output, uint64_t queued_usec, uint64_t rtt_usec);
+
+/** Returns the current congestion-controlled bitrate, or 0 if inactive */
+EXPORT long obs_output_get_congestion_control_bitrate(const obs_output_t *output);
+
 EXPORT bool obs_output_reconnecting(const obs_output_t *output);
 
 /** Pass a string of the last output error, for UI use */
@@ -2242,6 +2415,19 @@ EXPORT void obs_encoder_enum_roi(obs_encoder_t *encoder, void (*enum_proc)(void
 /** Get ROI increment, encoders must rebuild their ROI map if it has changed */
 EXPORT uint32_t obs_encoder_get_roi_increment(const obs_encoder_t *encoder);
 
+/**
+ * Enables compositor motion hints for a video encoder on the main mix.
+ *
+ * While enabled, libobs replaces the encoder's ROI list every frame with
+ * the regions of the canvas where scene items moved or changed content,
+ * so rate control spends bits where pixels actually changed.  Fully
+ * static frames clear the list, returning to uniform allocation.
+ * Do not combine with manually managed ROIs.
+ */
+EXPORT void obs_encoder_set_motion_hints_enabled(obs_encoder_t *encoder, bool enabled);
+/** Returns whether compositor motion hints are enabled for the encoder */
+EXPORT bool obs_encoder_get_motion_hints_enabled(const obs_encoder_t *encoder);
+
 /** For video encoders, returns true if pre-encode scaling is enabled */
 EXPORT bool obs_encoder_scaling_enabled(const obs_encoder_t *encoder);
 
@@ -2321,6 +2507,17 @@ EXPORT obs_properties_t *obs_encoder_properties(const obs_encoder_t *encoder);
  */
 EXPORT void obs_encoder_update(obs_encoder_t *encoder, obs_data_t *settings);
 
+/**
+ * Applies new settings to an encoder in place, without restarting it.
+ * While the encoder is active this requires the encoder type to advertise
+ * OBS_ENCODER_CAP_RECONFIGURE; the change is then applied between frames
+ * on the encode thread and the stream is not interrupted.  Returns false
+ * (and changes nothing) if an active encoder does not support it, in
+ * which case the caller should fall back to obs_encoder_update and a
+ * restart.
+ */
+EXPORT bool obs_encoder_reconfigure(obs_encoder_t *encoder, obs_data_t *settings);
+
 /** Gets extra data (headers) associated with this context */
 EXPORT bool obs_encoder_get_extra_data(const obs_encoder_t *encoder, uint8_t **extra_data, size_t *size);
 
@@ -2388,6 +2585,15 @@ EXPORT bool obs_encoder_set_group(obs_encoder_t *encoder, obs_encoder_group_t *g
 EXPORT obs_encoder_group_t *obs_encoder_group_create();
 EXPORT void obs_encoder_group_destroy(obs_encoder_group_t *group);
 
+/**
+ * Returns the encoder's position within its encoder group and the total
+ * number of encoders in the group, or 0 if the encoder is not grouped.
+ * Allows hardware encoder plugins to balance grouped (multitrack)
+ * sessions across multiple encode-capable devices.
+ */
+EXPORT size_t obs_encoder_get_group_index(const obs_encoder_t *encoder);
+EXPORT size_t obs_encoder_get_group_size(const obs_encoder_t *encoder);
+
 /* ------------------------------------------------------------------------- */
 /* Stream Services */
 
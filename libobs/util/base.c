@@ -21,6 +21,7 @@
 #include "base.h"
 
 static int crashing = 0;
+static int log_output_level = LOG_DEBUG;
 static void *log_param = NULL;
 static void *crash_param = NULL;
 
@@ -87,6 +88,16 @@ void base_set_crash_handler(void (*handler)(const char *, va_list, void *), void
 	crash_handler = handler;
 }
 
+void base_set_log_level(int level)
+{
+	log_output_level = level;
+}
+
+int base_get_log_level(void)
+{
+	return log_output_level;
+}
+
 OBS_NORETURN void bcrash(const char *format, ...)
 {
 	va_list args;
@@ -105,6 +116,11 @@ OBS_NORETURN void bcrash(const char *format, ...)
 
 void blogva(int log_level, const char *format, va_list args)
 {
+	/* filtered messages never reach the handler, so log calls on hot
+	 * paths cost a compare instead of a vsnprintf */
+	if (log_level > log_output_level)
+		return;
+
 	log_handler(log_level, format, args, log_param);
 }
 
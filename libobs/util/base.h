@@ -74,6 +74,15 @@ EXPORT void base_set_log_handler(log_handler_t handler, void *param);
 
 EXPORT void base_set_crash_handler(void (*handler)(const char *, va_list, void *), void *param);
 
+/**
+ * Sets/gets the maximum level that is passed to the log handler.  Messages
+ * less severe than the set level are dropped before any formatting happens,
+ * making filtered log calls nearly free.  Defaults to LOG_DEBUG (everything
+ * is passed through).
+ */
+EXPORT void base_set_log_level(int level);
+EXPORT int base_get_log_level(void);
+
 EXPORT void blogva(int log_level, const char *format, va_list args);
 
 #if !defined(_MSC_VER) && !defined(SWIG)
@@ -162,3 +162,74 @@ void *bmemdup(const void *ptr, size_t size)
 
 	return out;
 }
+
+/* ------------------------------------------------------------------------- */
+/* thread-local frame arena                                                  */
+
+struct frame_arena {
+	uint8_t *data;
+	size_t capacity;
+	size_t used;
+
+	/* heap allocations made while the arena was exhausted; released on
+	 * the next reset */
+	void **fallbacks;
+	size_t num_fallbacks;
+	size_t cap_fallbacks;
+};
+
+static THREAD_LOCAL struct frame_arena arena = {0};
+
+void barena_init(size_t capacity)
+{
+	if (arena.data)
+		barena_free();
+
+	arena.data = bmalloc(capacity);
+	arena.capacity = capacity;
+	arena.used = 0;
+}
+
+void barena_free(void)
+{
+	barena_reset();
+	bfree(arena.data);
+	bfree(arena.fallbacks);
+	memset(&arena, 0, sizeof(arena));
+}
+
+void *barena_alloc(size_t size)
+{
+	if (!size) {
+		os_breakpoint();
+		bcrash("barena_alloc: Allocating 0 bytes is broken behavior, please fix your code!");
+	}
+
+	/* bmalloc() returns ALIGNMENT-aligned blocks, so rounding each bump
+	 * up to ALIGNMENT keeps every arena allocation aligned as well */
+	size_t aligned = (size + (ALIGNMENT - 1)) & ~(size_t)(ALIGNMENT - 1);
+
+	if (aligned <= arena.capacity - arena.used && arena.data) {
+		void *ptr = arena.data + arena.used;
+		arena.used += aligned;
+		return ptr;
+	}
+
+	if (arena.num_fallbacks == arena.cap_fallbacks) {
+		arena.cap_fallbacks = arena.cap_fallbacks ? arena.cap_fallbacks * 2 : 8;
+		arena.fallbacks = brealloc(arena.fallbacks, arena.cap_fallbacks * sizeof(void *));
+	}
+
+	void *ptr = bmalloc(size);
+	arena.fallbacks[arena.num_fallbacks++] = ptr;
+	return ptr;
+}
+
+void barena_reset(void)
+{
+	for (size_t i = 0; i < arena.num_fallbacks; i++)
+		bfree(arena.fallbacks[i]);
+
+	arena.num_fallbacks = 0;
+	arena.used = 0;
+}
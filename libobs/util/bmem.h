@@ -41,6 +41,19 @@ EXPORT long bnum_allocs(void);
 
 EXPORT void *bmemdup(const void *ptr, size_t size);
 
+/*
+ * Thread-local frame arena: a bump allocator for transient allocations that
+ * do not outlive the current frame.  Allocations cannot be freed
+ * individually; the owning thread resets the arena once per frame, which
+ * releases everything at once.  If the arena is exhausted (or was never
+ * initialized on the calling thread), barena_alloc() falls back to the heap
+ * and the fallback blocks are freed on the next reset.
+ */
+EXPORT void barena_init(size_t capacity);
+EXPORT void barena_free(void);
+EXPORT void *barena_alloc(size_t size);
+EXPORT void barena_reset(void);
+
 static inline void *bzalloc(size_t size)
 {
 	void *mem = bmalloc(size);
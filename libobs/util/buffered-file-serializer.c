@@ -14,6 +14,11 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <fcntl.h>
+#endif
+
 #include "buffered-file-serializer.h"
 
 #include <inttypes.h>
@@ -26,6 +31,12 @@
 static const size_t DEFAULT_BUF_SIZE = 256ULL * 1048576ULL; // 256 MiB
 static const size_t DEFAULT_CHUNK_SIZE = 1048576;           // 1 MiB
 
+#ifdef __linux__
+// Granularity at which completed writes are handed to the kernel and their
+// pages dropped from the cache (see below)
+static const uint64_t SYNC_RANGE_SIZE = 8ULL * 1048576ULL; // 8 MiB
+#endif
+
 /* ========================================================================== */
 /* Buffered writer based on ffmpeg-mux implementation                         */
 
@@ -75,6 +86,12 @@ static void *io_thread(void *opaque)
 	bool want_seek = false;
 	bool force_flush_chunk = false;
 
+#ifdef __linux__
+	// Highest contiguous offset already handed to the kernel for writeback
+	uint64_t sync_pos = 0;
+	int fd = fileno(out->io.output_file);
+#endif
+
 	// current_seek_position is a virtual position updated as we read from
 	// the buffer, if it becomes discontinuous due to a seek request we
 	// flush the chunk. next_seek_position is the actual offset we should
@@ -186,6 +203,24 @@ static void *io_thread(void *opaque)
 				goto error;
 			}
 
+#ifdef __linux__
+			// Long recordings accumulate dirty pages faster than
+			// writeback clears them; once the kernel's dirty limit
+			// is hit, writes block and the stall backs up into the
+			// muxer. Kick off asynchronous writeback for completed
+			// ranges and drop the pages already flushed so that
+			// never happens. Backward seeks (header patching) just
+			// fault the pages back in.
+			if (current_seek_position > sync_pos &&
+			    current_seek_position - sync_pos >= SYNC_RANGE_SIZE) {
+				sync_file_range(fd, sync_pos, current_seek_position - sync_pos,
+						SYNC_FILE_RANGE_WRITE);
+				if (sync_pos)
+					posix_fadvise(fd, 0, (off_t)sync_pos, POSIX_FADV_DONTNEED);
+				sync_pos = current_seek_position;
+			}
+#endif
+
 			chunk_used = 0;
 			force_flush_chunk = false;
 		}
@@ -336,6 +371,11 @@ bool buffered_file_serializer_init(struct serializer *s, const char *path, size_
 	if (!out->io.output_file)
 		return false;
 
+	// Writes are already batched into chunk_size blocks; disable stdio
+	// buffering so each chunk goes to the kernel in a single write
+	// without an extra copy through the stdio buffer
+	setvbuf(out->io.output_file, NULL, _IONBF, 0);
+
 	out->io.buffer_size = max_bufsize ? max_bufsize : DEFAULT_BUF_SIZE;
 	out->io.chunk_size = chunk_size ? chunk_size : DEFAULT_CHUNK_SIZE;
 
@@ -17,6 +17,8 @@
 #include <ctype.h>
 #include <stdio.h>
 #include "platform.h"
+#include "threading.h"
+#include "crc32.h"
 #include "cf-lexer.h"
 
 static inline void cf_convert_from_escape_literal(char **p_dst, const char **p_src)
@@ -608,9 +610,88 @@ static inline void insert_path(struct cf_preprocessor *pp, struct dstr *str_file
 	}
 }
 
+/*
+ * Process-wide cache of lexed include files.
+ *
+ *   Effect files share a handful of common includes, and every compilation
+ * used to re-read and re-lex them from scratch; with a few hundred effects
+ * compiled at startup the same files were lexed hundreds of times.  A lexed
+ * include is immutable (the preprocessor only reads its token array), so it
+ * is lexed once per process and shared across compilations instead, keyed by
+ * path and content hash so a file that changed on disk gets a fresh entry.
+ *
+ *   Cached lexers are heap-allocated because their tokens point back at the
+ * owning lexer, and they are never evicted while the process runs because
+ * preprocessed token streams hold string references into their reformatted
+ * buffers.  The cache is torn down on libobs shutdown via
+ * cf_lexer_cache_free().
+ */
+
+struct cf_include_cache_entry {
+	char *file;
+	uint32_t hash;
+	struct cf_lexer *lex;
+};
+
+static pthread_mutex_t include_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static DARRAY(struct cf_include_cache_entry) include_cache = {0};
+
+static struct cf_lexer *cf_lexer_cache_get(const char *file, const char *file_data)
+{
+	uint32_t hash = calc_crc32(0, file_data, strlen(file_data));
+	struct cf_lexer *lex = NULL;
+	size_t i;
+
+	pthread_mutex_lock(&include_cache_mutex);
+
+	for (i = 0; i < include_cache.num; i++) {
+		struct cf_include_cache_entry *entry = include_cache.array + i;
+
+		if (entry->hash == hash && strcmp(entry->file, file) == 0) {
+			lex = entry->lex;
+			break;
+		}
+	}
+
+	if (!lex) {
+		struct cf_include_cache_entry entry;
+
+		lex = bmalloc(sizeof(struct cf_lexer));
+		cf_lexer_init(lex);
+		cf_lexer_lex(lex, file_data, file);
+
+		entry.file = bstrdup(file);
+		entry.hash = hash;
+		entry.lex = lex;
+		da_push_back(include_cache, &entry);
+	}
+
+	pthread_mutex_unlock(&include_cache_mutex);
+	return lex;
+}
+
+void cf_lexer_cache_free(void)
+{
+	size_t i;
+
+	pthread_mutex_lock(&include_cache_mutex);
+
+	for (i = 0; i < include_cache.num; i++) {
+		struct cf_include_cache_entry *entry = include_cache.array + i;
+
+		cf_lexer_free(entry->lex);
+		bfree(entry->lex);
+		bfree(entry->file);
+	}
+
+	da_free(include_cache);
+
+	pthread_mutex_unlock(&include_cache_mutex);
+}
+
 static void cf_include_file(struct cf_preprocessor *pp, const struct cf_token *file_token)
 {
-	struct cf_lexer new_lex;
+	struct cf_lexer *dep_lex;
 	struct dstr str_file;
 	FILE *file;
 	char *file_data;
@@ -624,7 +705,7 @@ static void cf_include_file(struct cf_preprocessor *pp, const struct cf_token *f
 
 	/* if dependency already exists, run preprocessor on it */
 	for (i = 0; i < pp->dependencies.num; i++) {
-		struct cf_lexer *dep = pp->dependencies.array + i;
+		struct cf_lexer *dep = pp->dependencies.array[i];
 
 		if (strcmp(dep->file, str_file.array) == 0) {
 			tokens = cf_lexer_get_tokens(dep);
@@ -642,13 +723,13 @@ static void cf_include_file(struct cf_preprocessor *pp, const struct cf_token *f
 	os_fread_utf8(file, &file_data);
 	fclose(file);
 
-	cf_lexer_init(&new_lex);
-	cf_lexer_lex(&new_lex, file_data, str_file.array);
-	tokens = cf_lexer_get_tokens(&new_lex);
-	cf_preprocess_tokens(pp, false, &tokens);
+	dep_lex = cf_lexer_cache_get(str_file.array, file_data);
 	bfree(file_data);
 
-	da_push_back(pp->dependencies, &new_lex);
+	tokens = cf_lexer_get_tokens(dep_lex);
+	cf_preprocess_tokens(pp, false, &tokens);
+
+	da_push_back(pp->dependencies, &dep_lex);
 
 exit:
 	dstr_free(&str_file);
@@ -1202,7 +1283,6 @@ void cf_preprocessor_init(struct cf_preprocessor *pp)
 
 void cf_preprocessor_free(struct cf_preprocessor *pp)
 {
-	struct cf_lexer *dependencies = pp->dependencies.array;
 	char **sys_include_dirs = pp->sys_include_dirs.array;
 	struct cf_def *defs = pp->defines.array;
 	size_t i;
@@ -1211,8 +1291,8 @@ void cf_preprocessor_free(struct cf_preprocessor *pp)
 		cf_def_free(defs + i);
 	for (i = 0; i < pp->sys_include_dirs.num; i++)
 		bfree(sys_include_dirs[i]);
-	for (i = 0; i < pp->dependencies.num; i++)
-		cf_lexer_free(dependencies + i);
+
+	/* dependency lexers are owned by the include cache */
 
 	da_free(pp->defines);
 	da_free(pp->sys_include_dirs);
@@ -1232,6 +1312,11 @@ bool cf_preprocess(struct cf_preprocessor *pp, struct cf_lexer *lex, struct erro
 
 	pp->ed = ed;
 	pp->lex = lex;
+
+	/* the output stream is at least as large as the input; reserving it up
+	 * front avoids repeated growth reallocations of a large array */
+	da_reserve(pp->tokens, lex->tokens.num);
+
 	cf_preprocess_tokens(pp, false, &token);
 	da_push_back(pp->tokens, token);
 
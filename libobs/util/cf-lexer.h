@@ -100,6 +100,16 @@ static inline struct cf_token *cf_lexer_get_tokens(struct cf_lexer *lex)
 
 EXPORT bool cf_lexer_lex(struct cf_lexer *lex, const char *str, const char *file);
 
+/**
+ * Frees the process-wide cache of lexed include files.
+ *
+ *   Included files are lexed once per process and shared across all
+ * preprocessor instances; preprocessed token streams reference the cached
+ * lexer's string data, so this may only be called once nothing that was
+ * preprocessed is in use anymore (i.e. on libobs shutdown).
+ */
+EXPORT void cf_lexer_cache_free(void);
+
 /* ------------------------------------------------------------------------- */
 /* c-family preprocessor definition */
 
@@ -169,7 +179,7 @@ struct cf_preprocessor {
 	struct error_data *ed;
 	DARRAY(struct cf_def) defines;
 	DARRAY(char *) sys_include_dirs;
-	DARRAY(struct cf_lexer) dependencies;
+	DARRAY(struct cf_lexer *) dependencies; /* owned by the include cache */
 	cf_token_array_t tokens;
 	bool ignore_state;
 };
@@ -64,6 +64,11 @@ struct config_data {
 	struct config_section *sections;
 	struct config_section *defaults;
 	pthread_mutex_t mutex;
+
+	/* set when a user value actually changes; saves of an unchanged
+	 * config are skipped so that frequent periodic saves do not cause
+	 * bursts of synchronous writes on slow filesystems */
+	bool dirty;
 };
 
 config_t *config_create(const char *file)
@@ -344,6 +349,13 @@ int config_save(config_t *config)
 
 	pthread_mutex_lock(&config->mutex);
 
+	if (!config->dirty) {
+		pthread_mutex_unlock(&config->mutex);
+		dstr_free(&tmp);
+		dstr_free(&str);
+		return CONFIG_SUCCESS;
+	}
+
 	f = os_fopen(config->file, "wb");
 	if (!f) {
 		pthread_mutex_unlock(&config->mutex);
@@ -383,6 +395,7 @@ int config_save(config_t *config)
 		goto cleanup;
 
 	ret = CONFIG_SUCCESS;
+	config->dirty = false;
 
 cleanup:
 	fclose(f);
@@ -410,6 +423,11 @@ int config_save_safe(config_t *config, const char *temp_ext, const char *backup_
 
 	pthread_mutex_lock(&config->mutex);
 
+	if (!config->dirty) {
+		pthread_mutex_unlock(&config->mutex);
+		return CONFIG_SUCCESS;
+	}
+
 	dstr_copy(&temp_file, config->file);
 	if (*temp_ext != '.')
 		dstr_cat(&temp_file, ".");
@@ -434,8 +452,11 @@ int config_save_safe(config_t *config, const char *temp_ext, const char *backup_
 		dstr_cat(&backup_file, backup_ext);
 	}
 
-	if (os_safe_replace(file, temp_file.array, backup_file.array) != 0)
+	if (os_safe_replace(file, temp_file.array, backup_file.array) != 0) {
+		/* re-arm so the next save attempt is not skipped */
+		config->dirty = true;
 		ret = CONFIG_ERROR;
+	}
 
 cleanup:
 	pthread_mutex_unlock(&config->mutex);
@@ -533,11 +554,19 @@ static void config_set_item(config_t *config, struct config_section **sections,
 		item->value = value;
 
 		HASH_ADD_STR(sec->items, name, item);
+	} else if (strcmp(item->value, value) == 0) {
+		/* unchanged value; do not mark the config dirty */
+		bfree(value);
+		pthread_mutex_unlock(&config->mutex);
+		return;
 	} else {
 		bfree(item->value);
 		item->value = value;
 	}
 
+	if (sections == &config->sections)
+		config->dirty = true;
+
 	pthread_mutex_unlock(&config->mutex);
 }
 
@@ -711,6 +740,7 @@ bool config_remove_value(config_t *config, const char *section, const char *name
 		if (item) {
 			HASH_DELETE(hh, sec->items, item);
 			config_item_free(item);
+			config->dirty = true;
 			success = true;
 		}
 	}
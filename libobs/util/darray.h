@@ -102,6 +102,10 @@ static inline void darray_ensure_capacity(const size_t element_size, struct darr
 		return;
 
 	new_cap = (!dst->capacity) ? new_size : dst->capacity * 2;
+	/* do not bother with capacities below four elements; growing a
+	 * fresh array one push at a time reallocates on every push */
+	if (new_cap < 4)
+		new_cap = 4;
 	if (new_size > new_cap)
 		new_cap = new_size;
 	ptr = bmalloc(element_size * new_cap);
@@ -70,6 +70,12 @@ static inline void deque_ensure_capacity(struct deque *dq)
 		return;
 
 	new_capacity = dq->capacity * 2;
+
+	/* growing a fresh deque a few bytes at a time reallocates on nearly
+	 * every push; start with a reasonable block instead */
+	if (new_capacity < 64)
+		new_capacity = 64;
+
 	if (dq->size > new_capacity)
 		new_capacity = dq->size;
 
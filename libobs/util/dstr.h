@@ -210,6 +210,10 @@ static inline void dstr_ensure_capacity(struct dstr *dst, const size_t new_size)
 		return;
 
 	new_cap = (!dst->capacity) ? new_size : dst->capacity * 2;
+	/* short strings dominate; a 32 byte floor avoids growing through
+	 * several tiny reallocations */
+	if (new_cap < 32)
+		new_cap = 32;
 	if (new_size > new_cap)
 		new_cap = new_size;
 	dst->array = (char *)brealloc(dst->array, new_cap);
@@ -219,25 +219,55 @@ void os_cpu_usage_info_destroy(os_cpu_usage_info_t *info)
 
 #endif
 
+/* how far short of the target the coarse sleep aims: nanosleep() routinely
+ * overshoots by a scheduler quantum under load, so stop early and spin out
+ * the remainder on the monotonic clock, mirroring what the Windows
+ * implementation does with Sleep() + QueryPerformanceCounter */
+#define SLEEP_SPIN_GUARD_NS 1000000ULL
+
+static inline void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__asm__ __volatile__("pause");
+#elif defined(__aarch64__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
 bool os_sleepto_ns(uint64_t time_target)
 {
 	uint64_t current = os_gettime_ns();
 	if (time_target < current)
 		return false;
 
-	time_target -= current;
+	if (time_target - current > SLEEP_SPIN_GUARD_NS) {
+		const uint64_t coarse = time_target - SLEEP_SPIN_GUARD_NS;
+		struct timespec req;
 
-	struct timespec req, remain;
-	memset(&req, 0, sizeof(req));
-	memset(&remain, 0, sizeof(remain));
-	req.tv_sec = time_target / 1000000000;
-	req.tv_nsec = time_target % 1000000000;
+#if defined(__linux__) || defined(__FreeBSD__)
+		req.tv_sec = coarse / 1000000000;
+		req.tv_nsec = coarse % 1000000000;
+
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &req, NULL) == EINTR)
+			;
+#else
+		struct timespec remain;
+		const uint64_t duration = coarse - current;
 
-	while (nanosleep(&req, &remain)) {
-		req = remain;
 		memset(&remain, 0, sizeof(remain));
+		req.tv_sec = duration / 1000000000;
+		req.tv_nsec = duration % 1000000000;
+
+		while (nanosleep(&req, &remain)) {
+			req = remain;
+			memset(&remain, 0, sizeof(remain));
+		}
+#endif
 	}
 
+	while (os_gettime_ns() < time_target)
+		cpu_relax();
+
 	return true;
 }
 
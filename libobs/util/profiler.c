@@ -78,14 +78,6 @@ struct profile_entry {
 	DARRAY(profile_entry) children;
 };
 
-typedef struct profile_root_entry profile_root_entry;
-struct profile_root_entry {
-	pthread_mutex_t *mutex;
-	const char *name;
-	profile_entry *entry;
-	profile_call *prev_call;
-};
-
 static inline uint64_t diff_ns_to_usec(uint64_t prev, uint64_t next)
 {
 	return (next - prev + 500) / 1000;
@@ -248,25 +240,210 @@ static void merge_call(profile_entry *entry, profile_call *call, profile_call *p
 #endif
 }
 
-static bool enabled = false;
+static volatile bool enabled = false;
+
+/* Root names registered with an expected time between calls; the mutex
+ * guards only this list and snapshot/teardown serialization, never the
+ * record path. */
+struct root_expected {
+	const char *name;
+	uint64_t expected_time_between_calls;
+};
+
 static pthread_mutex_t root_mutex = PTHREAD_MUTEX_INITIALIZER;
-static DARRAY(profile_root_entry) root_entries;
+static DARRAY(struct root_expected) expected_roots;
+static volatile long expected_version = 0;
+
+/* Completed root calls merge into per-thread accumulators, so recording
+ * threads never contend with each other; snapshots merge the per-thread
+ * trees lazily.  The spinlock on each accumulator is uncontended except
+ * while a snapshot is being taken. */
+typedef struct thread_root_entry thread_root_entry;
+struct thread_root_entry {
+	const char *name;
+	long expected_version;
+	profile_entry *entry;
+	profile_call *prev_call;
+};
 
+typedef struct thread_profile_data thread_profile_data;
+struct thread_profile_data {
+	volatile long lock;
+	DARRAY(thread_root_entry) roots;
+	thread_profile_data *next;
+};
+
+static thread_profile_data *volatile thread_data_list = NULL;
+
+static THREAD_LOCAL thread_profile_data *thread_data = NULL;
 static THREAD_LOCAL profile_call *thread_context = NULL;
 static THREAD_LOCAL bool thread_enabled = true;
 
+static inline void thread_data_lock(thread_profile_data *data)
+{
+	while (!os_atomic_compare_swap_long(&data->lock, 0, 1))
+		;
+}
+
+static inline void thread_data_unlock(thread_profile_data *data)
+{
+	os_atomic_store_long(&data->lock, 0);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Ring-buffer trace mode */
+
+#define TRACE_DEFAULT_EVENTS 65536
+
+struct profiler_trace_event {
+	const char *name;
+	uint64_t ts;
+	bool begin;
+};
+
+struct profiler_trace_buffer {
+	struct profiler_trace_event *events;
+	size_t capacity;
+	size_t write_idx;
+	bool wrapped;
+	int tid;
+	struct profiler_trace_buffer *next;
+};
+
+static pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+static volatile bool trace_enabled = false;
+static size_t trace_capacity = TRACE_DEFAULT_EVENTS;
+static int trace_next_tid = 1;
+static struct profiler_trace_buffer *trace_buffers = NULL;
+
+static THREAD_LOCAL struct profiler_trace_buffer *thread_trace = NULL;
+
+static struct profiler_trace_buffer *create_trace_buffer(void)
+{
+	struct profiler_trace_buffer *buf = bzalloc(sizeof(*buf));
+
+	pthread_mutex_lock(&trace_mutex);
+	buf->capacity = trace_capacity;
+	buf->events = bzalloc(sizeof(*buf->events) * buf->capacity);
+	buf->tid = trace_next_tid++;
+	buf->next = trace_buffers;
+	trace_buffers = buf;
+	pthread_mutex_unlock(&trace_mutex);
+
+	thread_trace = buf;
+	return buf;
+}
+
+static void trace_append(const char *name, bool begin, uint64_t ts)
+{
+	struct profiler_trace_buffer *buf = thread_trace;
+	if (!buf)
+		buf = create_trace_buffer();
+
+	struct profiler_trace_event *ev = &buf->events[buf->write_idx];
+	ev->name = name;
+	ev->ts = ts;
+	ev->begin = begin;
+
+	if (++buf->write_idx == buf->capacity) {
+		buf->write_idx = 0;
+		buf->wrapped = true;
+	}
+}
+
+void profiler_trace_start(size_t events_per_thread)
+{
+	pthread_mutex_lock(&trace_mutex);
+
+	/* capacity changes only affect threads that have not traced yet;
+	 * existing buffers keep their size and are simply rewound */
+	if (events_per_thread)
+		trace_capacity = events_per_thread;
+
+	for (struct profiler_trace_buffer *buf = trace_buffers; buf; buf = buf->next) {
+		buf->write_idx = 0;
+		buf->wrapped = false;
+	}
+
+	os_atomic_set_bool(&trace_enabled, true);
+	pthread_mutex_unlock(&trace_mutex);
+}
+
+void profiler_trace_stop(void)
+{
+	os_atomic_set_bool(&trace_enabled, false);
+}
+
+bool profiler_trace_enabled(void)
+{
+	return os_atomic_load_bool(&trace_enabled);
+}
+
+static void trace_cat_json_string(struct dstr *out, const char *str)
+{
+	dstr_cat_ch(out, '"');
+	for (const char *c = str; *c; c++) {
+		if (*c == '"' || *c == '\\')
+			dstr_cat_ch(out, '\\');
+		dstr_cat_ch(out, *c);
+	}
+	dstr_cat_ch(out, '"');
+}
+
+bool profiler_trace_save(const char *filename)
+{
+	struct dstr out = {0};
+	bool first = true;
+
+	dstr_cat(&out, "{\"traceEvents\":[\n");
+
+	pthread_mutex_lock(&trace_mutex);
+
+	for (struct profiler_trace_buffer *buf = trace_buffers; buf; buf = buf->next) {
+		size_t count = buf->wrapped ? buf->capacity : buf->write_idx;
+		size_t start = buf->wrapped ? buf->write_idx : 0;
+		size_t depth = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			const struct profiler_trace_event *ev = &buf->events[(start + i) % buf->capacity];
+
+			if (ev->begin) {
+				depth += 1;
+			} else if (!depth) {
+				/* exit whose matching enter was overwritten */
+				continue;
+			} else {
+				depth -= 1;
+			}
+
+			if (!first)
+				dstr_cat(&out, ",\n");
+			first = false;
+
+			dstr_cat(&out, "{\"name\":");
+			trace_cat_json_string(&out, ev->name);
+			dstr_catf(&out, ",\"ph\":\"%s\",\"ts\":%" PRIu64 ".%03u,\"pid\":1,\"tid\":%d}",
+				  ev->begin ? "B" : "E", ev->ts / 1000, (unsigned)(ev->ts % 1000), buf->tid);
+		}
+	}
+
+	pthread_mutex_unlock(&trace_mutex);
+
+	dstr_cat(&out, "\n]}\n");
+
+	bool success = os_quick_write_utf8_file(filename, out.array, out.len, false);
+	dstr_free(&out);
+	return success;
+}
+
 void profiler_start(void)
 {
-	pthread_mutex_lock(&root_mutex);
-	enabled = true;
-	pthread_mutex_unlock(&root_mutex);
+	os_atomic_set_bool(&enabled, true);
 }
 
 void profiler_stop(void)
 {
-	pthread_mutex_lock(&root_mutex);
-	enabled = false;
-	pthread_mutex_unlock(&root_mutex);
+	os_atomic_set_bool(&enabled, false);
 }
 
 void profile_reenable_thread(void)
@@ -274,83 +451,114 @@ void profile_reenable_thread(void)
 	if (thread_enabled)
 		return;
 
-	pthread_mutex_lock(&root_mutex);
-	thread_enabled = enabled;
-	pthread_mutex_unlock(&root_mutex);
+	thread_enabled = os_atomic_load_bool(&enabled);
 }
 
-static bool lock_root(void)
+static uint64_t lookup_expected_time(const char *name)
 {
+	uint64_t expected = 0;
+
 	pthread_mutex_lock(&root_mutex);
-	if (!enabled) {
-		pthread_mutex_unlock(&root_mutex);
-		thread_enabled = false;
-		return false;
+	for (size_t i = 0; i < expected_roots.num; i++) {
+		if (expected_roots.array[i].name == name) {
+			expected = expected_roots.array[i].expected_time_between_calls;
+			break;
+		}
 	}
+	pthread_mutex_unlock(&root_mutex);
 
-	return true;
+	return expected;
 }
 
-static profile_root_entry *get_root_entry(const char *name)
+void profile_register_root(const char *name, uint64_t expected_time_between_calls)
 {
-	profile_root_entry *r_entry = NULL;
+	pthread_mutex_lock(&root_mutex);
 
-	for (size_t i = 0; i < root_entries.num; i++) {
-		if (root_entries.array[i].name == name) {
-			r_entry = &root_entries.array[i];
+	struct root_expected *expected = NULL;
+	for (size_t i = 0; i < expected_roots.num; i++) {
+		if (expected_roots.array[i].name == name) {
+			expected = &expected_roots.array[i];
 			break;
 		}
 	}
 
-	if (!r_entry) {
-		r_entry = da_push_back_new(root_entries);
-		r_entry->mutex = bmalloc(sizeof(pthread_mutex_t));
-		pthread_mutex_init(r_entry->mutex, NULL);
+	if (!expected) {
+		expected = da_push_back_new(expected_roots);
+		expected->name = name;
+	}
+
+	expected->expected_time_between_calls = (expected_time_between_calls + 500) / 1000;
+
+	pthread_mutex_unlock(&root_mutex);
+
+	os_atomic_inc_long(&expected_version);
+}
+
+static thread_profile_data *get_thread_data(void)
+{
+	if (!thread_data) {
+		thread_profile_data *data = bzalloc(sizeof(*data));
+		thread_profile_data *head;
+
+		do {
+			head = os_atomic_load_ptr((void *const volatile *)&thread_data_list);
+			data->next = head;
+		} while (!os_atomic_compare_swap_ptr((void *volatile *)&thread_data_list, head, data));
 
-		r_entry->name = name;
-		r_entry->entry = bzalloc(sizeof(profile_entry));
-		init_entry(r_entry->entry, name);
+		thread_data = data;
 	}
 
-	return r_entry;
+	return thread_data;
 }
 
-void profile_register_root(const char *name, uint64_t expected_time_between_calls)
+/* call with the thread data locked */
+static thread_root_entry *get_thread_root(thread_profile_data *data, const char *name)
 {
-	if (!lock_root())
-		return;
+	const long version = os_atomic_load_long(&expected_version);
 
-	get_root_entry(name)->entry->expected_time_between_calls = (expected_time_between_calls + 500) / 1000;
-	pthread_mutex_unlock(&root_mutex);
+	for (size_t i = 0; i < data->roots.num; i++) {
+		thread_root_entry *root = &data->roots.array[i];
+		if (root->name != name)
+			continue;
+
+		if (root->expected_version != version) {
+			root->expected_version = version;
+			root->entry->expected_time_between_calls = lookup_expected_time(name);
+		}
+
+		return root;
+	}
+
+	thread_root_entry *root = da_push_back_new(data->roots);
+	root->name = name;
+	root->expected_version = version;
+	root->entry = bzalloc(sizeof(profile_entry));
+	init_entry(root->entry, name);
+	root->entry->expected_time_between_calls = lookup_expected_time(name);
+	return root;
 }
 
 static void free_call_context(profile_call *context);
 
 static void merge_context(profile_call *context)
 {
-	pthread_mutex_t *mutex = NULL;
-	profile_entry *entry = NULL;
-	profile_call *prev_call = NULL;
-
-	if (!lock_root()) {
+	if (!os_atomic_load_bool(&enabled)) {
+		thread_enabled = false;
 		free_call_context(context);
 		return;
 	}
 
-	profile_root_entry *r_entry = get_root_entry(context->name);
-
-	mutex = r_entry->mutex;
-	entry = r_entry->entry;
-	prev_call = r_entry->prev_call;
+	thread_profile_data *data = get_thread_data();
 
-	r_entry->prev_call = context;
+	thread_data_lock(data);
 
-	pthread_mutex_lock(mutex);
-	pthread_mutex_unlock(&root_mutex);
+	thread_root_entry *root = get_thread_root(data, context->name);
+	profile_call *prev_call = root->prev_call;
 
-	merge_call(entry, context, prev_call);
+	root->prev_call = context;
+	merge_call(root->entry, context, prev_call);
 
-	pthread_mutex_unlock(mutex);
+	thread_data_unlock(data);
 
 	free_call_context(prev_call);
 }
@@ -380,6 +588,9 @@ void profile_start(const char *name)
 
 	thread_context = call;
 	call->start_time = os_gettime_ns();
+
+	if (os_atomic_load_bool(&trace_enabled))
+		trace_append(name, true, call->start_time);
 }
 
 void profile_end(const char *name)
@@ -419,6 +630,9 @@ void profile_end(const char *name)
 	thread_context = call->parent;
 
 	call->end_time = end;
+
+	if (os_atomic_load_bool(&trace_enabled))
+		trace_append(call->name, false, end);
 #ifdef TRACK_OVERHEAD
 	call->overhead_end = os_gettime_ns();
 #endif
@@ -766,32 +980,48 @@ static void free_profile_entry(profile_entry *entry)
 
 void profiler_free(void)
 {
-	DARRAY(profile_root_entry) old_root_entries = {0};
+	os_atomic_set_bool(&enabled, false);
 
-	pthread_mutex_lock(&root_mutex);
-	enabled = false;
-	da_move(old_root_entries, root_entries);
-	pthread_mutex_unlock(&root_mutex);
+	/* profiled threads must be finished by this point */
+	thread_profile_data *data = os_atomic_exchange_ptr((void *volatile *)&thread_data_list, NULL);
 
-	for (size_t i = 0; i < old_root_entries.num; i++) {
-		profile_root_entry *entry = &old_root_entries.array[i];
+	while (data) {
+		thread_profile_data *next = data->next;
 
-		pthread_mutex_lock(entry->mutex);
-		pthread_mutex_unlock(entry->mutex);
+		for (size_t i = 0; i < data->roots.num; i++) {
+			thread_root_entry *root = &data->roots.array[i];
 
-		pthread_mutex_destroy(entry->mutex);
-		bfree(entry->mutex);
-		entry->mutex = NULL;
+			free_call_context(root->prev_call);
 
-		free_call_context(entry->prev_call);
+			free_profile_entry(root->entry);
+			bfree(root->entry);
+		}
 
-		free_profile_entry(entry->entry);
-		bfree(entry->entry);
+		da_free(data->roots);
+		bfree(data);
+		data = next;
 	}
 
-	da_free(old_root_entries);
+	pthread_mutex_lock(&root_mutex);
+	da_free(expected_roots);
+	pthread_mutex_unlock(&root_mutex);
 
 	pthread_mutex_destroy(&root_mutex);
+
+	/* traced threads must be finished by this point */
+	os_atomic_set_bool(&trace_enabled, false);
+
+	pthread_mutex_lock(&trace_mutex);
+	struct profiler_trace_buffer *buf = trace_buffers;
+	trace_buffers = NULL;
+	pthread_mutex_unlock(&trace_mutex);
+
+	while (buf) {
+		struct profiler_trace_buffer *next = buf->next;
+		bfree(buf->events);
+		bfree(buf);
+		buf = next;
+	}
 }
 
 /* ------------------------------------------------------------------------- */
@@ -883,18 +1113,71 @@ static void sort_snapshot_entry(profiler_snapshot_entry_t *entry)
 		sort_snapshot_entry(&entry->children.array[i]);
 }
 
+static void merge_times_table(profile_times_table *dst, profile_times_table *src)
+{
+	migrate_old_entries(src, false);
+
+	for (size_t i = 0; i < src->size; i++) {
+		if (!src->entries[i].probes)
+			continue;
+
+		migrate_old_entries(dst, true);
+		add_hashmap_entry(dst, src->entries[i].entry.time_delta, src->entries[i].entry.count);
+	}
+}
+
+static void merge_entry_into(profile_entry *dst, profile_entry *src)
+{
+	if (src->expected_time_between_calls && !dst->expected_time_between_calls)
+		dst->expected_time_between_calls = src->expected_time_between_calls;
+
+	merge_times_table(&dst->times, &src->times);
+	merge_times_table(&dst->times_between_calls, &src->times_between_calls);
+
+	for (size_t i = 0; i < src->children.num; i++) {
+		profile_entry *child = &src->children.array[i];
+		merge_entry_into(get_child(dst, child->name), child);
+	}
+}
+
 profiler_snapshot_t *profile_snapshot_create(void)
 {
 	profiler_snapshot_t *snap = bzalloc(sizeof(profiler_snapshot_t));
+	DARRAY(profile_entry) combined = {0};
 
-	pthread_mutex_lock(&root_mutex);
-	da_reserve(snap->roots, root_entries.num);
-	for (size_t i = 0; i < root_entries.num; i++) {
-		pthread_mutex_lock(root_entries.array[i].mutex);
-		add_entry_to_snapshot(root_entries.array[i].entry, da_push_back_new(snap->roots));
-		pthread_mutex_unlock(root_entries.array[i].mutex);
+	/* root_mutex must not be held here: recording threads take it for
+	 * expected-time lookups while holding their accumulator lock */
+	thread_profile_data *data = os_atomic_load_ptr((void *const volatile *)&thread_data_list);
+
+	for (; data; data = data->next) {
+		thread_data_lock(data);
+
+		for (size_t i = 0; i < data->roots.num; i++) {
+			thread_root_entry *root = &data->roots.array[i];
+			profile_entry *dst = NULL;
+
+			for (size_t j = 0; j < combined.num; j++) {
+				if (combined.array[j].name == root->name) {
+					dst = &combined.array[j];
+					break;
+				}
+			}
+
+			if (!dst)
+				dst = init_entry(da_push_back_new(combined), root->name);
+
+			merge_entry_into(dst, root->entry);
+		}
+
+		thread_data_unlock(data);
 	}
-	pthread_mutex_unlock(&root_mutex);
+
+	da_reserve(snap->roots, combined.num);
+	for (size_t i = 0; i < combined.num; i++) {
+		add_entry_to_snapshot(&combined.array[i], da_push_back_new(snap->roots));
+		free_profile_entry(&combined.array[i]);
+	}
+	da_free(combined);
 
 	for (size_t i = 0; i < snap->roots.num; i++)
 		sort_snapshot_entry(&snap->roots.array[i]);
@@ -32,6 +32,24 @@ EXPORT void profiler_print_time_between_calls(profiler_snapshot_t *snap);
 
 EXPORT void profiler_free(void);
 
+/* ------------------------------------------------------------------------- */
+/* Ring-buffer trace mode */
+
+/*
+ * Records enter/exit events from profile_start/profile_end sites into
+ * fixed-size per-thread ring buffers that keep the most recent events,
+ * allowing one-frame hitches to be diagnosed after the fact.  The trace
+ * can be saved as Chrome trace format JSON (loadable in chrome://tracing,
+ * Perfetto or speedscope as a flame graph).
+ *
+ * events_per_thread of 0 uses the default capacity (65536); changing the
+ * capacity only affects threads that have not recorded events yet.
+ */
+EXPORT void profiler_trace_start(size_t events_per_thread);
+EXPORT void profiler_trace_stop(void);
+EXPORT bool profiler_trace_enabled(void);
+EXPORT bool profiler_trace_save(const char *filename);
+
 /* ------------------------------------------------------------------------- */
 /* Profiler name storage */
 
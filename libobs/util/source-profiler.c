@@ -81,6 +81,18 @@ struct profiler_entry *hm_entries = NULL;
 static uint8_t timer_idx = 0;
 static gs_timer_range_t *timer_ranges[FRAME_BUFFER_SIZE] = {0};
 
+/* Pipeline-stage GPU timers (render/convert/display), pooled per buffered
+ * frame like the per-source render timers. A stage can run more than once
+ * per frame (e.g. conversion once per output mix). */
+struct pipeline_sample {
+	DARRAY(gs_timer_t *) timers[PROFILER_PIPELINE_STAGES];
+};
+
+static struct pipeline_sample pipeline_frames[FRAME_BUFFER_SIZE] = {0};
+/* Per-stage per-frame GPU time sums for last N frames */
+static struct ucirclebuf pipeline_gpu[PROFILER_PIPELINE_STAGES] = {0};
+static uint64_t pipeline_frame_last = 0;
+
 static uint64_t profiler_samples = 0;
 /* Sources can be rendered more than once per frame, to avoid reallocating
  * memory in the majority of cases, reserve at least two. */
@@ -201,6 +213,27 @@ static void reset_gpu_timers(void)
 	gs_leave_context();
 }
 
+static void reset_pipeline_timers(void)
+{
+	gs_enter_context(obs->video.graphics);
+	for (int i = 0; i < FRAME_BUFFER_SIZE; i++) {
+		struct pipeline_sample *ps = &pipeline_frames[i];
+
+		for (int s = 0; s < PROFILER_PIPELINE_STAGES; s++) {
+			for (size_t t = 0; t < ps->timers[s].num; t++)
+				gs_timer_destroy(ps->timers[s].array[t]);
+			da_free(ps->timers[s]);
+		}
+	}
+	gs_leave_context();
+
+	for (int s = 0; s < PROFILER_PIPELINE_STAGES; s++) {
+		pipeline_gpu[s].num = 0;
+		pipeline_gpu[s].idx = 0;
+	}
+	pipeline_frame_last = 0;
+}
+
 static void profiler_shutdown(void)
 {
 	struct source_samples *smp, *tmp;
@@ -218,6 +251,7 @@ static void profiler_shutdown(void)
 	pthread_rwlock_unlock(&hm_rwlock);
 
 	reset_gpu_timers();
+	reset_pipeline_timers();
 }
 
 void source_profiler_enable(bool enable)
@@ -237,6 +271,11 @@ void source_profiler_reset_video(struct obs_video_info *ovi)
 
 	/* This is fine because the video thread won't be running at this point */
 	profiler_shutdown();
+
+	for (int s = 0; s < PROFILER_PIPELINE_STAGES; s++) {
+		ucirclebuf_free(&pipeline_gpu[s]);
+		ucirclebuf_init(&pipeline_gpu[s], profiler_samples);
+	}
 }
 
 void source_profiler_render_begin(void)
@@ -378,6 +417,31 @@ void source_profiler_frame_collect(void)
 		smps = smps->hh.next;
 	}
 
+	if (gpu_enabled && gpu_ready) {
+		struct pipeline_sample *ps = &pipeline_frames[(timer_idx + 1) % FRAME_BUFFER_SIZE];
+		uint64_t frame_total = 0;
+
+		for (int s = 0; s < PROFILER_PIPELINE_STAGES; s++) {
+			uint64_t sum = 0, ticks = 0;
+
+			for (size_t i = 0; i < ps->timers[s].num; i++) {
+				gs_timer_t *timer = ps->timers[s].array[i];
+
+				if (!gpu_disjoint && gs_timer_get_data(timer, &ticks))
+					sum += util_mul_div64(ticks, 1000000000ULL, freq);
+
+				gs_timer_destroy(timer);
+			}
+			da_clear(ps->timers[s]);
+
+			if (pipeline_gpu[s].capacity)
+				ucirclebuf_push(&pipeline_gpu[s], sum);
+			frame_total += sum;
+		}
+
+		pipeline_frame_last = frame_total;
+	}
+
 	pthread_rwlock_unlock(&hm_rwlock);
 
 	if (gpu_enabled && gpu_ready)
@@ -390,6 +454,7 @@ void source_profiler_frame_collect(void)
 	} else if (!gpu_enable_next) {
 		gpu_enabled = false;
 		reset_gpu_timers();
+		reset_pipeline_timers();
 	}
 
 	profile_end(source_profiler_frame_collect_name);
@@ -412,9 +477,48 @@ void source_profiler_async_frame_received(obs_source_t *source)
 	pthread_rwlock_unlock(&hm_rwlock);
 }
 
+static inline bool budget_active(void)
+{
+	return os_atomic_load_long(&obs->video.budget_source_count) > 0;
+}
+
+/* Called from tick_end; since a source ticks exactly once at the start of
+ * each frame, the previous frame's accumulated tick + render time is
+ * complete at this point and can be checked against the budget. */
+static void source_budget_frame(obs_source_t *source, uint64_t tick_delta)
+{
+	const uint64_t budget = source->frame_budget_ns;
+
+	if (!budget) {
+		source->budget_frame_ns = 0;
+		source->budget_overrun_frames = 0;
+		return;
+	}
+
+	if (source->budget_frame_ns > budget) {
+		/* signal once per overrun streak, when the threshold is
+		 * first reached */
+		if (++source->budget_overrun_frames == source->budget_overrun_limit) {
+			struct calldata data;
+			uint8_t stack[128];
+
+			calldata_init_fixed(&data, stack, sizeof(stack));
+			calldata_set_ptr(&data, "source", source);
+			calldata_set_int(&data, "frame_time_ns", source->budget_frame_ns);
+			calldata_set_int(&data, "budget_ns", budget);
+
+			signal_handler_signal(source->context.signals, "frame_budget_exceeded", &data);
+		}
+	} else {
+		source->budget_overrun_frames = 0;
+	}
+
+	source->budget_frame_ns = tick_delta;
+}
+
 uint64_t source_profiler_source_tick_start(void)
 {
-	if (!enabled)
+	if (!enabled && !budget_active())
 		return 0;
 
 	return os_gettime_ns();
@@ -422,11 +526,16 @@ uint64_t source_profiler_source_tick_start(void)
 
 void source_profiler_source_tick_end(obs_source_t *source, uint64_t start)
 {
-	if (!enabled)
+	if (!start)
 		return;
 
 	const uint64_t delta = os_gettime_ns() - start;
 
+	source_budget_frame(source, delta);
+
+	if (!enabled)
+		return;
+
 	struct source_samples *smp = NULL;
 	HASH_FIND_PTR(hm_samples, &source, smp);
 	if (!smp) {
@@ -443,14 +552,17 @@ void source_profiler_source_tick_end(obs_source_t *source, uint64_t start)
 
 uint64_t source_profiler_source_render_begin(gs_timer_t **timer)
 {
-	if (!enabled)
-		return 0;
+	*timer = NULL;
+
+	if (!enabled) {
+		if (!budget_active())
+			return 0;
+		return os_gettime_ns();
+	}
 
 	if (gpu_enabled) {
 		*timer = gs_timer_create();
 		gs_timer_begin(*timer);
-	} else {
-		*timer = NULL;
 	}
 
 	return os_gettime_ns();
@@ -458,13 +570,19 @@ uint64_t source_profiler_source_render_begin(gs_timer_t **timer)
 
 void source_profiler_source_render_end(obs_source_t *source, uint64_t start, gs_timer_t *timer)
 {
-	if (!enabled)
+	if (!start)
 		return;
 	if (timer)
 		gs_timer_end(timer);
 
 	const uint64_t delta = os_gettime_ns() - start;
 
+	if (source->frame_budget_ns)
+		source->budget_frame_ns += delta;
+
+	if (!enabled)
+		return;
+
 	struct source_samples *smp;
 	HASH_FIND_PTR(hm_samples, &source, smp);
 
@@ -478,6 +596,25 @@ void source_profiler_source_render_end(obs_source_t *source, uint64_t start, gs_
 	}
 }
 
+gs_timer_t *source_profiler_pipeline_begin(void)
+{
+	if (!gpu_enabled)
+		return NULL;
+
+	gs_timer_t *timer = gs_timer_create();
+	gs_timer_begin(timer);
+	return timer;
+}
+
+void source_profiler_pipeline_end(enum profiler_pipeline_stage stage, gs_timer_t *timer)
+{
+	if (!timer)
+		return;
+
+	gs_timer_end(timer);
+	da_push_back(pipeline_frames[timer_idx].timers[stage], &timer);
+}
+
 static void task_delete_source(void *key)
 {
 	struct source_samples *smp;
@@ -560,6 +697,30 @@ static inline void calculate_render(struct profiler_entry *ent, struct profiler_
 	}
 }
 
+static int cmp_u64(const void *a, const void *b)
+{
+	const uint64_t va = *(const uint64_t *)a;
+	const uint64_t vb = *(const uint64_t *)b;
+
+	if (va < vb)
+		return -1;
+	return va > vb ? 1 : 0;
+}
+
+static inline void calculate_percentiles(const struct ucirclebuf *buf, uint64_t *p95, uint64_t *p99)
+{
+	if (!buf->num)
+		return;
+
+	uint64_t *sorted = bmemdup(buf->array, buf->num * sizeof(uint64_t));
+	qsort(sorted, buf->num, sizeof(uint64_t), cmp_u64);
+
+	*p95 = sorted[buf->num * 95 / 100];
+	*p99 = sorted[buf->num * 99 / 100];
+
+	bfree(sorted);
+}
+
 static inline void calculate_fps(const struct ucirclebuf *frames, double *avg, uint64_t *best, uint64_t *worst)
 {
 	uint64_t deltas = 0, delta_sum = 0, best_delta = 0, worst_delta = 0;
@@ -605,6 +766,8 @@ bool source_profiler_fill_result(obs_source_t *source, struct profiler_result *r
 	if (ent) {
 		calculate_tick(ent, result);
 		calculate_render(ent, result);
+		calculate_percentiles(&ent->tick, &result->tick_p95, &result->tick_p99);
+		calculate_percentiles(&ent->render_cpu_sum, &result->render_p95, &result->render_p99);
 
 		if (is_async_video_source(source)) {
 			calculate_fps(&ent->async_frame_ts, &result->async_input, &result->async_input_best,
@@ -619,6 +782,38 @@ bool source_profiler_fill_result(obs_source_t *source, struct profiler_result *r
 	return !!ent;
 }
 
+bool source_profiler_fill_pipeline_result(profiler_pipeline_result_t *result)
+{
+	if (!enabled || !gpu_enabled || !result)
+		return false;
+
+	memset(result, 0, sizeof(profiler_pipeline_result_t));
+
+	pthread_rwlock_rdlock(&hm_rwlock);
+
+	for (int s = 0; s < PROFILER_PIPELINE_STAGES; s++) {
+		const struct ucirclebuf *buf = &pipeline_gpu[s];
+		uint64_t sum = 0;
+
+		for (size_t i = 0; i < buf->num; i++) {
+			const uint64_t val = buf->array[i];
+			if (val > result->stage_max[s])
+				result->stage_max[s] = val;
+
+			sum += val;
+		}
+
+		if (buf->num)
+			result->stage_avg[s] = sum / buf->num;
+	}
+
+	result->frame_last = pipeline_frame_last;
+
+	pthread_rwlock_unlock(&hm_rwlock);
+
+	return true;
+}
+
 profiler_result_t *source_profiler_get_result(obs_source_t *source)
 {
 	profiler_result_t *ret = bmalloc(sizeof(profiler_result_t));
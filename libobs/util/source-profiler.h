@@ -49,13 +49,46 @@ typedef struct profiler_result {
 	uint64_t async_input_worst;
 	uint64_t async_rendered_best;
 	uint64_t async_rendered_worst;
+
+	/* 95th/99th percentile tick and render pass sum times in ns over
+	 * the sample window */
+	uint64_t tick_p95;
+	uint64_t tick_p99;
+	uint64_t render_p95;
+	uint64_t render_p99;
 } profiler_result_t;
 
+/* GPU pipeline stages timed per frame when GPU profiling is enabled.
+ * Stages can nest on the GPU timeline: the render stage includes the
+ * conversion passes that run as part of composing each output. */
+enum profiler_pipeline_stage {
+	/* Scene/mix composition (render_video) */
+	PROFILER_PIPELINE_RENDER,
+	/* Color conversion passes (render_convert_texture) */
+	PROFILER_PIPELINE_CONVERT,
+	/* Preview/projector display draws */
+	PROFILER_PIPELINE_DISPLAY,
+
+	PROFILER_PIPELINE_STAGES,
+};
+
+typedef struct profiler_pipeline_result {
+	/* Per-stage GPU time per frame in ns over the sample window */
+	uint64_t stage_avg[PROFILER_PIPELINE_STAGES];
+	uint64_t stage_max[PROFILER_PIPELINE_STAGES];
+
+	/* Sum of all stages for the most recently collected frame in ns */
+	uint64_t frame_last;
+} profiler_pipeline_result_t;
+
 /* Enable/disable profiler (applied on next frame) */
 EXPORT void source_profiler_enable(bool enable);
 /* Enable/disable GPU profiling (applied on next frame) */
 EXPORT void source_profiler_gpu_enable(bool enable);
 
+/* Get latest per-stage GPU pipeline timings (requires GPU profiling) */
+EXPORT bool source_profiler_fill_pipeline_result(profiler_pipeline_result_t *result);
+
 /* Get latest profiling results for source (must be freed by user) */
 EXPORT profiler_result_t *source_profiler_get_result(obs_source_t *source);
 /* Update existing profiler results object for source */
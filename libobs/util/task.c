@@ -1,24 +1,35 @@
 #include "task.h"
 #include "bmem.h"
 #include "threading.h"
-#include "deque.h"
+
+/*
+ * Producers push tasks onto a lock-free singly-linked list with a single
+ * compare-and-swap; the worker claims the entire list with one atomic
+ * exchange per wakeup and reverses it into FIFO order.  Queueing a task
+ * never contends with task execution, only with concurrent pushes.
+ */
+
+struct os_task_info {
+	os_task_t task;
+	void *param;
+};
+
+struct task_node {
+	struct task_node *next;
+	struct os_task_info info;
+};
 
 struct os_task_queue {
 	pthread_t thread;
 	os_sem_t *sem;
 	long id;
 
-	bool waiting;
-	bool tasks_processed;
+	volatile bool waiting;
+	volatile bool tasks_processed;
 	os_event_t *wait_event;
 
-	pthread_mutex_t mutex;
-	struct deque tasks;
-};
-
-struct os_task_info {
-	os_task_t task;
-	void *param;
+	/* LIFO push list; consumer claims and reverses it */
+	struct task_node *volatile push_list;
 };
 
 static THREAD_LOCAL bool exit_thread = false;
@@ -32,23 +43,19 @@ os_task_queue_t *os_task_queue_create(void)
 	struct os_task_queue *tq = bzalloc(sizeof(*tq));
 	tq->id = os_atomic_inc_long(&thread_id_counter);
 
-	if (pthread_mutex_init(&tq->mutex, NULL) != 0)
-		goto fail1;
 	if (os_sem_init(&tq->sem, 0) != 0)
-		goto fail2;
+		goto fail1;
 	if (os_event_init(&tq->wait_event, OS_EVENT_TYPE_AUTO) != 0)
-		goto fail3;
+		goto fail2;
 	if (pthread_create(&tq->thread, NULL, tiny_tubular_task_thread, tq) != 0)
-		goto fail4;
+		goto fail3;
 
 	return tq;
 
-fail4:
-	os_event_destroy(tq->wait_event);
 fail3:
-	os_sem_destroy(tq->sem);
+	os_event_destroy(tq->wait_event);
 fail2:
-	pthread_mutex_destroy(&tq->mutex);
+	os_sem_destroy(tq->sem);
 fail1:
 	bfree(tq);
 	return NULL;
@@ -56,17 +63,19 @@ fail1:
 
 bool os_task_queue_queue_task(os_task_queue_t *tq, os_task_t task, void *param)
 {
-	struct os_task_info ti = {
-		task,
-		param,
-	};
+	struct task_node *node;
 
 	if (!tq)
 		return false;
 
-	pthread_mutex_lock(&tq->mutex);
-	deque_push_back(&tq->tasks, &ti, sizeof(ti));
-	pthread_mutex_unlock(&tq->mutex);
+	node = bmalloc(sizeof(*node));
+	node->info.task = task;
+	node->info.param = param;
+
+	do {
+		node->next = os_atomic_load_ptr((void *const volatile *)&tq->push_list);
+	} while (!os_atomic_compare_swap_ptr((void *volatile *)&tq->push_list, node->next, node));
+
 	os_sem_post(tq->sem);
 	return true;
 }
@@ -83,6 +92,15 @@ static void stop_thread(void *unused)
 	UNUSED_PARAMETER(unused);
 }
 
+static void free_task_list(struct task_node *node)
+{
+	while (node) {
+		struct task_node *next = node->next;
+		bfree(node);
+		node = next;
+	}
+}
+
 void os_task_queue_destroy(os_task_queue_t *tq)
 {
 	if (!tq)
@@ -92,8 +110,7 @@ void os_task_queue_destroy(os_task_queue_t *tq)
 	pthread_join(tq->thread, NULL);
 	os_event_destroy(tq->wait_event);
 	os_sem_destroy(tq->sem);
-	pthread_mutex_destroy(&tq->mutex);
-	deque_free(&tq->tasks);
+	free_task_list(os_atomic_set_ptr((void *volatile *)&tq->push_list, NULL));
 	bfree(tq);
 }
 
@@ -102,25 +119,13 @@ bool os_task_queue_wait(os_task_queue_t *tq)
 	if (!tq)
 		return false;
 
-	struct os_task_info ti = {
-		wait_for_thread,
-		tq,
-	};
-
-	pthread_mutex_lock(&tq->mutex);
-	tq->waiting = true;
-	tq->tasks_processed = false;
-	deque_push_back(&tq->tasks, &ti, sizeof(ti));
-	pthread_mutex_unlock(&tq->mutex);
+	os_atomic_store_bool(&tq->tasks_processed, false);
+	os_atomic_store_bool(&tq->waiting, true);
 
-	os_sem_post(tq->sem);
+	os_task_queue_queue_task(tq, wait_for_thread, tq);
 	os_event_wait(tq->wait_event);
 
-	pthread_mutex_lock(&tq->mutex);
-	bool tasks_processed = tq->tasks_processed;
-	pthread_mutex_unlock(&tq->mutex);
-
-	return tasks_processed;
+	return os_atomic_load_bool(&tq->tasks_processed);
 }
 
 bool os_task_queue_inside(os_task_queue_t *tq)
@@ -136,28 +141,37 @@ static void *tiny_tubular_task_thread(void *param)
 	os_set_thread_name(__FUNCTION__);
 
 	while (!exit_thread && os_sem_wait(tq->sem) == 0) {
-		struct os_task_info ti;
-
-		pthread_mutex_lock(&tq->mutex);
-		deque_pop_front(&tq->tasks, &ti, sizeof(ti));
-		if (tq->tasks.size && ti.task == wait_for_thread) {
-			deque_push_back(&tq->tasks, &ti, sizeof(ti));
-			deque_pop_front(&tq->tasks, &ti, sizeof(ti));
+		struct task_node *node = os_atomic_set_ptr((void *volatile *)&tq->push_list, NULL);
+		struct task_node *fifo = NULL;
+
+		/* claimed list is in push (LIFO) order; reverse it */
+		while (node) {
+			struct task_node *next = node->next;
+			node->next = fifo;
+			fifo = node;
+			node = next;
 		}
-		if (tq->tasks.size && ti.task == stop_thread) {
-			deque_push_back(&tq->tasks, &ti, sizeof(ti));
-			deque_pop_front(&tq->tasks, &ti, sizeof(ti));
-		}
-		if (tq->waiting) {
-			if (ti.task == wait_for_thread) {
-				tq->waiting = false;
-			} else {
-				tq->tasks_processed = true;
-			}
+
+		while (fifo) {
+			struct task_node *next = fifo->next;
+			struct os_task_info ti = fifo->info;
+
+			bfree(fifo);
+			fifo = next;
+
+			if (ti.task == wait_for_thread)
+				os_atomic_store_bool(&tq->waiting, false);
+			else if (os_atomic_load_bool(&tq->waiting))
+				os_atomic_store_bool(&tq->tasks_processed, true);
+
+			ti.task(ti.param);
+
+			if (exit_thread)
+				break;
 		}
-		pthread_mutex_unlock(&tq->mutex);
 
-		ti.task(ti.param);
+		/* drop anything left in the batch if told to exit */
+		free_task_list(fifo);
 	}
 
 	return NULL;
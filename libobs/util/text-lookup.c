@@ -15,33 +15,51 @@
  */
 
 #include <ctype.h>
+#include <sys/stat.h>
 
+#include "darray.h"
 #include "dstr.h"
 #include "text-lookup.h"
 #include "lexer.h"
 #include "platform.h"
+#include "crc32.h"
 #include "uthash.h"
 
 /* ------------------------------------------------------------------------- */
 
 struct text_item {
 	char *lookup, *value;
+	bool slab; /* strings/node owned by a cache blob, not freed per-item */
 	UT_hash_handle hh;
 };
 
 static inline void text_item_destroy(struct text_item *item)
 {
-	bfree(item->lookup);
-	bfree(item->value);
-	bfree(item);
+	if (!item->slab) {
+		bfree(item->lookup);
+		bfree(item->value);
+		bfree(item);
+	}
 }
 
 /* ------------------------------------------------------------------------- */
 
+struct text_cache_blob {
+	char *data;
+	struct text_item *nodes;
+};
+
 struct text_lookup {
 	struct text_item *items;
+	DARRAY(struct text_cache_blob) blobs;
+};
+
+struct text_pair {
+	char *lookup, *value;
 };
 
+typedef DARRAY(struct text_pair) text_pair_array_t;
+
 static void lookup_getstringtoken(struct lexer *lex, struct strref *token)
 {
 	const char *temp = lex->offset;
@@ -154,7 +172,7 @@ static char *convert_string(const char *str, size_t len)
 	return out.array;
 }
 
-static void lookup_addfiledata(struct text_lookup *lookup, const char *file_data)
+static void lookup_parsefiledata(const char *file_data, text_pair_array_t *pairs)
 {
 	struct lexer lex;
 	struct strref name, value;
@@ -165,8 +183,7 @@ static void lookup_addfiledata(struct text_lookup *lookup, const char *file_data
 	strref_clear(&value);
 
 	while (lookup_gettoken(&lex, &name)) {
-		struct text_item *item;
-		struct text_item *old;
+		struct text_pair pair;
 		bool got_eq = false;
 
 		if (*name.array == '\n')
@@ -181,14 +198,9 @@ static void lookup_addfiledata(struct text_lookup *lookup, const char *file_data
 			goto getval;
 		}
 
-		item = bzalloc(sizeof(struct text_item));
-		item->lookup = bstrdup_n(name.array, name.len);
-		item->value = convert_string(value.array, value.len);
-
-		HASH_REPLACE_STR(lookup->items, lookup, item, old);
-
-		if (old)
-			text_item_destroy(old);
+		pair.lookup = bstrdup_n(name.array, name.len);
+		pair.value = convert_string(value.array, value.len);
+		da_push_back(*pairs, &pair);
 
 		if (!lookup_goto_nextline(&lex))
 			break;
@@ -197,6 +209,33 @@ static void lookup_addfiledata(struct text_lookup *lookup, const char *file_data
 	lexer_free(&lex);
 }
 
+static inline void lookup_replace_item(struct text_lookup *lookup, struct text_item *item)
+{
+	struct text_item *old;
+
+	HASH_REPLACE_STR(lookup->items, lookup, item, old);
+
+	if (old)
+		text_item_destroy(old);
+}
+
+static void lookup_add_pairs(struct text_lookup *lookup, text_pair_array_t *pairs)
+{
+	size_t i;
+
+	for (i = 0; i < pairs->num; i++) {
+		struct text_pair *pair = pairs->array + i;
+		struct text_item *item = bzalloc(sizeof(struct text_item));
+
+		item->lookup = pair->lookup;
+		item->value = pair->value;
+
+		lookup_replace_item(lookup, item);
+	}
+
+	da_free(*pairs);
+}
+
 static inline bool lookup_getstring(const char *lookup_val, const char **out, struct text_lookup *lookup)
 {
 	struct text_item *item;
@@ -213,6 +252,213 @@ static inline bool lookup_getstring(const char *lookup_val, const char **out, st
 	return true;
 }
 
+/* ------------------------------------------------------------------------- */
+/*
+ * Binary locale cache
+ *
+ *   Parsing the ini-style locale text re-lexes and unescapes thousands of
+ * strings for every one of the locale files loaded at startup (libobs plus
+ * each plugin module).  When a cache directory is set, the parsed pairs are
+ * serialized to a binary file once and later loads of an unchanged source
+ * file read the pre-converted strings back in a single block: the lookup
+ * nodes are allocated as one slab and their strings point straight into the
+ * blob.  A cache file is keyed by the crc32 of the source path and holds the
+ * source path, size and modification time, so a moved or edited locale file
+ * simply misses and gets re-parsed.
+ */
+
+#define TEXT_CACHE_VERSION 1
+
+struct text_cache_header {
+	char magic[4]; /* "TLKC" */
+	uint32_t version;
+	uint64_t src_size;
+	uint64_t src_mtime;
+	uint32_t path_len; /* padded to 4 bytes, including null */
+	uint32_t count;
+	uint32_t strings_size;
+};
+
+static const char text_cache_magic[4] = {'T', 'L', 'K', 'C'};
+
+static char *text_cache_dir = NULL;
+
+void text_lookup_enable_cache(const char *cache_dir)
+{
+	bfree(text_cache_dir);
+	text_cache_dir = NULL;
+
+	if (cache_dir && os_mkdirs(cache_dir) != MKDIR_ERROR)
+		text_cache_dir = bstrdup(cache_dir);
+}
+
+static void text_cache_get_path(struct dstr *cache_path, const char *path)
+{
+	uint32_t hash = calc_crc32(0, path, strlen(path));
+	dstr_printf(cache_path, "%s/%08x.tlc", text_cache_dir, (unsigned)hash);
+}
+
+static bool text_cache_load(struct text_lookup *lookup, const char *path, uint64_t src_size, uint64_t src_mtime)
+{
+	struct text_cache_header hdr;
+	struct text_cache_blob blob;
+	struct dstr cache_path = {0};
+	struct text_item *nodes = NULL;
+	const uint32_t *offsets;
+	size_t path_len = strlen(path);
+	char *data = NULL;
+	char *strings;
+	size_t size;
+	int64_t size64;
+	FILE *file;
+	size_t i;
+
+	text_cache_get_path(&cache_path, path);
+	file = os_fopen(cache_path.array, "rb");
+	dstr_free(&cache_path);
+	if (!file)
+		return false;
+
+	size64 = os_fgetsize(file);
+	if (size64 < (int64_t)sizeof(hdr))
+		goto fail;
+
+	size = (size_t)size64;
+	data = bmalloc(size);
+	if (fread(data, 1, size, file) != size)
+		goto fail;
+	fclose(file);
+	file = NULL;
+
+	memcpy(&hdr, data, sizeof(hdr));
+
+	if (memcmp(hdr.magic, text_cache_magic, sizeof(hdr.magic)) != 0 || hdr.version != TEXT_CACHE_VERSION ||
+	    hdr.src_size != src_size || hdr.src_mtime != src_mtime || !hdr.count || !hdr.strings_size)
+		goto fail;
+	if (size != sizeof(hdr) + hdr.path_len + (size_t)hdr.count * sizeof(uint32_t) * 2 + hdr.strings_size)
+		goto fail;
+	if (hdr.path_len <= path_len || memcmp(data + sizeof(hdr), path, path_len + 1) != 0)
+		goto fail;
+	if (data[size - 1] != 0)
+		goto fail;
+
+	offsets = (const uint32_t *)(data + sizeof(hdr) + hdr.path_len);
+	strings = data + sizeof(hdr) + hdr.path_len + (size_t)hdr.count * sizeof(uint32_t) * 2;
+
+	for (i = 0; i < hdr.count * 2; i++)
+		if (offsets[i] >= hdr.strings_size)
+			goto fail;
+
+	nodes = bzalloc(hdr.count * sizeof(struct text_item));
+
+	for (i = 0; i < hdr.count; i++) {
+		struct text_item *item = nodes + i;
+
+		item->lookup = strings + offsets[i * 2];
+		item->value = strings + offsets[i * 2 + 1];
+		item->slab = true;
+
+		lookup_replace_item(lookup, item);
+	}
+
+	blob.data = data;
+	blob.nodes = nodes;
+	da_push_back(lookup->blobs, &blob);
+	return true;
+
+fail:
+	if (file)
+		fclose(file);
+	bfree(data);
+	return false;
+}
+
+static void text_cache_save(const char *path, uint64_t src_size, uint64_t src_mtime, const text_pair_array_t *pairs)
+{
+	struct text_cache_header hdr;
+	struct dstr cache_path = {0};
+	struct dstr temp_path = {0};
+	uint32_t *offsets;
+	char *strings;
+	size_t strings_size = 0;
+	size_t path_len = strlen(path);
+	size_t pos = 0;
+	FILE *file;
+	size_t i;
+	bool success;
+
+	if (!pairs->num)
+		return;
+
+	for (i = 0; i < pairs->num; i++) {
+		strings_size += strlen(pairs->array[i].lookup) + 1;
+		strings_size += strlen(pairs->array[i].value) + 1;
+	}
+
+	if (strings_size > UINT32_MAX)
+		return;
+
+	memcpy(hdr.magic, text_cache_magic, sizeof(hdr.magic));
+	hdr.version = TEXT_CACHE_VERSION;
+	hdr.src_size = src_size;
+	hdr.src_mtime = src_mtime;
+	hdr.path_len = (uint32_t)((path_len + 1 + 3) & ~(size_t)3);
+	hdr.count = (uint32_t)pairs->num;
+	hdr.strings_size = (uint32_t)strings_size;
+
+	offsets = bmalloc(pairs->num * sizeof(uint32_t) * 2);
+	strings = bmalloc(strings_size);
+
+	for (i = 0; i < pairs->num; i++) {
+		const struct text_pair *pair = pairs->array + i;
+		size_t len;
+
+		offsets[i * 2] = (uint32_t)pos;
+		len = strlen(pair->lookup) + 1;
+		memcpy(strings + pos, pair->lookup, len);
+		pos += len;
+
+		offsets[i * 2 + 1] = (uint32_t)pos;
+		len = strlen(pair->value) + 1;
+		memcpy(strings + pos, pair->value, len);
+		pos += len;
+	}
+
+	text_cache_get_path(&cache_path, path);
+	dstr_copy_dstr(&temp_path, &cache_path);
+	dstr_cat(&temp_path, ".tmp");
+
+	file = os_fopen(temp_path.array, "wb");
+	if (!file)
+		goto cleanup;
+
+	success = fwrite(&hdr, sizeof(hdr), 1, file) == 1;
+
+	if (success) {
+		char pad[4] = {0};
+		success = fwrite(path, 1, path_len, file) == path_len &&
+			  fwrite(pad, 1, hdr.path_len - path_len, file) == hdr.path_len - path_len;
+	}
+
+	if (success)
+		success = fwrite(offsets, sizeof(uint32_t) * 2, pairs->num, file) == pairs->num;
+	if (success)
+		success = fwrite(strings, 1, strings_size, file) == strings_size;
+
+	fclose(file);
+
+	if (success)
+		os_safe_replace(cache_path.array, temp_path.array, NULL);
+	else
+		os_unlink(temp_path.array);
+
+cleanup:
+	dstr_free(&temp_path);
+	dstr_free(&cache_path);
+	bfree(strings);
+	bfree(offsets);
+}
+
 /* ------------------------------------------------------------------------- */
 
 lookup_t *text_lookup_create(const char *path)
@@ -229,10 +475,18 @@ lookup_t *text_lookup_create(const char *path)
 
 bool text_lookup_add(lookup_t *lookup, const char *path)
 {
+	text_pair_array_t pairs;
 	struct dstr file_str;
+	struct stat st;
+	bool have_stat;
 	char *temp = NULL;
 	FILE *file;
 
+	have_stat = os_stat(path, &st) == 0;
+
+	if (text_cache_dir && have_stat && text_cache_load(lookup, path, (uint64_t)st.st_size, (uint64_t)st.st_mtime))
+		return true;
+
 	file = os_fopen(path, "rb");
 	if (!file)
 		return false;
@@ -245,9 +499,16 @@ bool text_lookup_add(lookup_t *lookup, const char *path)
 		return false;
 
 	dstr_replace(&file_str, "\r", " ");
-	lookup_addfiledata(lookup, file_str.array);
+
+	da_init(pairs);
+	lookup_parsefiledata(file_str.array, &pairs);
 	dstr_free(&file_str);
 
+	if (text_cache_dir && have_stat)
+		text_cache_save(path, (uint64_t)st.st_size, (uint64_t)st.st_mtime, &pairs);
+
+	lookup_add_pairs(lookup, &pairs);
+
 	return true;
 }
 
@@ -259,6 +520,13 @@ void text_lookup_destroy(lookup_t *lookup)
 			HASH_DELETE(hh, lookup->items, item);
 			text_item_destroy(item);
 		}
+
+		for (size_t i = 0; i < lookup->blobs.num; i++) {
+			bfree(lookup->blobs.array[i].nodes);
+			bfree(lookup->blobs.array[i].data);
+		}
+		da_free(lookup->blobs);
+
 		bfree(lookup);
 	}
 }
@@ -35,6 +35,19 @@ struct text_lookup;
 typedef struct text_lookup lookup_t;
 
 /* functions */
+
+/**
+ * Enables the binary locale cache.
+ *
+ *   When a cache directory is set, parsed locale files are serialized to a
+ * binary file under it (keyed by source path, invalidated by file size and
+ * modification time), and subsequent loads of an unchanged file read the
+ * pre-parsed strings in a single block instead of re-lexing the ini text.
+ * Passing NULL disables the cache.  Not thread safe; call during startup
+ * before any lookups are loaded.
+ */
+EXPORT void text_lookup_enable_cache(const char *cache_dir);
+
 EXPORT lookup_t *text_lookup_create(const char *path);
 EXPORT bool text_lookup_add(lookup_t *lookup, const char *path);
 EXPORT void text_lookup_destroy(lookup_t *lookup);
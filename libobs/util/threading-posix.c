@@ -30,14 +30,144 @@
 #include <pthread_np.h>
 #endif
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <limits.h>
+#endif
+
 #include "bmem.h"
 #include "threading.h"
 
+static inline void add_ms_to_ts(struct timespec *ts, unsigned long milliseconds)
+{
+	ts->tv_sec += milliseconds / 1000;
+	ts->tv_nsec += (milliseconds % 1000) * 1000000;
+	if (ts->tv_nsec >= 1000000000) {
+		ts->tv_sec += 1;
+		ts->tv_nsec -= 1000000000;
+	}
+}
+
+#ifdef __linux__
+
+/* Futex-based event: signalling and waiting on an uncontended event stay
+ * entirely in userspace, and the kernel only gets involved when a waiter
+ * actually has to sleep.  The futex word has to be 32 bits, which the
+ * os_atomic_* wrappers do not cover, so the compiler atomics are used on
+ * it directly. */
+
+struct os_event_data {
+	uint32_t state;
+	uint32_t waiters;
+	bool manual;
+	volatile long sleeps;
+};
+
+static inline long futex_op(uint32_t *addr, int op, uint32_t val, const struct timespec *timeout)
+{
+	return syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+}
+
+int os_event_init(os_event_t **event, enum os_event_type type)
+{
+	struct os_event_data *data = bzalloc(sizeof(struct os_event_data));
+	data->manual = (type == OS_EVENT_TYPE_MANUAL);
+	*event = data;
+	return 0;
+}
+
+void os_event_destroy(os_event_t *event)
+{
+	if (event)
+		bfree(event);
+}
+
+static inline bool event_try_consume(os_event_t *event)
+{
+	if (event->manual)
+		return __atomic_load_n(&event->state, __ATOMIC_ACQUIRE) != 0;
+
+	uint32_t expected = 1;
+	return __atomic_compare_exchange_n(&event->state, &expected, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+static inline long event_sleep(os_event_t *event, const struct timespec *timeout)
+{
+	long ret;
+
+	os_atomic_inc_long((volatile long *)&event->sleeps);
+	__atomic_add_fetch(&event->waiters, 1, __ATOMIC_SEQ_CST);
+	ret = futex_op(&event->state, FUTEX_WAIT_PRIVATE, 0, timeout);
+	__atomic_sub_fetch(&event->waiters, 1, __ATOMIC_SEQ_CST);
+
+	return ret;
+}
+
+int os_event_wait(os_event_t *event)
+{
+	while (!event_try_consume(event))
+		event_sleep(event, NULL);
+	return 0;
+}
+
+int os_event_timedwait(os_event_t *event, unsigned long milliseconds)
+{
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	add_ms_to_ts(&deadline, milliseconds);
+
+	while (!event_try_consume(event)) {
+		struct timespec now, rel;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		rel.tv_sec = deadline.tv_sec - now.tv_sec;
+		rel.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+		if (rel.tv_nsec < 0) {
+			rel.tv_sec -= 1;
+			rel.tv_nsec += 1000000000;
+		}
+		if (rel.tv_sec < 0)
+			return ETIMEDOUT;
+
+		if (event_sleep(event, &rel) == -1 && errno == ETIMEDOUT)
+			return ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+int os_event_try(os_event_t *event)
+{
+	return event_try_consume(event) ? 0 : EAGAIN;
+}
+
+int os_event_signal(os_event_t *event)
+{
+	__atomic_store_n(&event->state, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&event->waiters, __ATOMIC_SEQ_CST) != 0)
+		futex_op(&event->state, FUTEX_WAKE_PRIVATE, event->manual ? INT_MAX : 1, NULL);
+	return 0;
+}
+
+void os_event_reset(os_event_t *event)
+{
+	__atomic_store_n(&event->state, 0, __ATOMIC_RELEASE);
+}
+
+long os_event_contention(os_event_t *event)
+{
+	return os_atomic_load_long((volatile long *)&event->sleeps);
+}
+
+#else
+
 struct os_event_data {
 	pthread_mutex_t mutex;
 	pthread_cond_t cond;
 	volatile bool signalled;
 	bool manual;
+	volatile long sleeps;
 };
 
 int os_event_init(os_event_t **event, enum os_event_type type)
@@ -78,6 +208,7 @@ int os_event_wait(os_event_t *event)
 	int code = 0;
 	pthread_mutex_lock(&event->mutex);
 	while (!event->signalled) {
+		event->sleeps++;
 		code = pthread_cond_wait(&event->cond, &event->mutex);
 		if (code != 0)
 			break;
@@ -93,16 +224,6 @@ int os_event_wait(os_event_t *event)
 	return code;
 }
 
-static inline void add_ms_to_ts(struct timespec *ts, unsigned long milliseconds)
-{
-	ts->tv_sec += milliseconds / 1000;
-	ts->tv_nsec += (milliseconds % 1000) * 1000000;
-	if (ts->tv_nsec >= 1000000000) {
-		ts->tv_sec += 1;
-		ts->tv_nsec -= 1000000000;
-	}
-}
-
 int os_event_timedwait(os_event_t *event, unsigned long milliseconds)
 {
 	int code = 0;
@@ -118,6 +239,7 @@ int os_event_timedwait(os_event_t *event, unsigned long milliseconds)
 		clock_gettime(CLOCK_REALTIME, &ts);
 #endif
 		add_ms_to_ts(&ts, milliseconds);
+		event->sleeps++;
 		code = pthread_cond_timedwait(&event->cond, &event->mutex, &ts);
 		if (code != 0)
 			break;
@@ -167,6 +289,13 @@ void os_event_reset(os_event_t *event)
 	pthread_mutex_unlock(&event->mutex);
 }
 
+long os_event_contention(os_event_t *event)
+{
+	return os_atomic_load_long(&event->sleeps);
+}
+
+#endif
+
 #ifdef __APPLE__
 
 struct os_sem_data {
@@ -119,6 +119,14 @@ void os_event_reset(os_event_t *event)
 	ResetEvent((HANDLE)event);
 }
 
+long os_event_contention(os_event_t *event)
+{
+	/* kernel event objects give no visibility into how often waiters
+	 * blocked */
+	UNUSED_PARAMETER(event);
+	return 0;
+}
+
 int os_sem_init(os_sem_t **sem, int value)
 {
 	HANDLE handle = CreateSemaphore(NULL, (LONG)value, 0x7FFFFFFF, NULL);
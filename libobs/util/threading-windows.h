@@ -33,6 +33,11 @@ static inline long os_atomic_dec_long(volatile long *val)
 	return _InterlockedDecrement(val);
 }
 
+static inline long os_atomic_add_long(volatile long *val, long add)
+{
+	return _InterlockedExchangeAdd(val, add) + add;
+}
+
 static inline void os_atomic_store_long(volatile long *ptr, long val)
 {
 #if defined(_M_ARM64)
@@ -140,3 +145,40 @@ static inline bool os_atomic_load_bool(const volatile bool *ptr)
 
 	return b;
 }
+
+static inline void *os_atomic_load_ptr(void *const volatile *ptr)
+{
+#if defined(_M_X64) || defined(_M_ARM64)
+	void *const val = (void *)__iso_volatile_load64((const volatile __int64 *)ptr);
+#else
+	void *const val = (void *)__iso_volatile_load32((const volatile __int32 *)ptr);
+#endif
+
+#if defined(_M_ARM)
+	__dmb(_ARM_BARRIER_ISH);
+#else
+	_ReadWriteBarrier();
+#endif
+
+	return val;
+}
+
+static inline void *os_atomic_set_ptr(void *volatile *ptr, void *val)
+{
+	return _InterlockedExchangePointer(ptr, val);
+}
+
+static inline void os_atomic_store_ptr(void *volatile *ptr, void *val)
+{
+	_InterlockedExchangePointer(ptr, val);
+}
+
+static inline void *os_atomic_exchange_ptr(void *volatile *ptr, void *val)
+{
+	return os_atomic_set_ptr(ptr, val);
+}
+
+static inline bool os_atomic_compare_swap_ptr(void *volatile *ptr, void *old_val, void *new_val)
+{
+	return _InterlockedCompareExchangePointer(ptr, new_val, old_val) == old_val;
+}
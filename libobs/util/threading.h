@@ -85,6 +85,10 @@ EXPORT int os_event_try(os_event_t *event);
 EXPORT int os_event_signal(os_event_t *event);
 EXPORT void os_event_reset(os_event_t *event);
 
+/* number of times waiters on this event actually had to sleep; always 0 on
+ * platforms where the implementation gives no visibility into waits */
+EXPORT long os_event_contention(os_event_t *event);
+
 EXPORT int os_sem_init(os_sem_t **sem, int value);
 EXPORT void os_sem_destroy(os_sem_t *sem);
 EXPORT int os_sem_post(os_sem_t *sem);
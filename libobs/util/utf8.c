@@ -66,6 +66,14 @@ size_t wchar_to_utf8(const wchar_t *in, size_t insize, char *out, size_t outsize
 
 #else
 
+#include "sse-intrin.h"
+
+/* the bulk-ASCII fast paths below assume the UCS-4 wchar_t this
+ * implementation already relies on */
+#if defined(__WCHAR_MAX__) && __WCHAR_MAX__ > 0xffff
+#define UTF8_SIMD_ASCII 1
+#endif
+
 #define _NXT 0x80
 #define _SEQ2 0xc0
 #define _SEQ3 0xe0
@@ -142,6 +150,34 @@ size_t utf8_to_wchar(const char *in, size_t insize, wchar_t *out, size_t outsize
 	wlim = out == NULL ? NULL : out + outsize;
 
 	for (; p < lim; p += n) {
+#ifdef UTF8_SIMD_ASCII
+		/* bulk-convert runs of ASCII 16 bytes at a time; anything
+		 * else falls through to the scalar sequence decoder.  Only
+		 * used with an explicit size so the loads cannot run past a
+		 * terminator. */
+		while (insize != 0 && (size_t)(lim - p) >= 16 && (out == NULL || (size_t)(wlim - out) >= 16)) {
+			__m128i chunk = _mm_loadu_si128((const __m128i *)p);
+			if (_mm_movemask_epi8(chunk))
+				break;
+
+			if (out != NULL) {
+				const __m128i zero = _mm_setzero_si128();
+				__m128i lo = _mm_unpacklo_epi8(chunk, zero);
+				__m128i hi = _mm_unpackhi_epi8(chunk, zero);
+				_mm_storeu_si128((__m128i *)(out + 0), _mm_unpacklo_epi16(lo, zero));
+				_mm_storeu_si128((__m128i *)(out + 4), _mm_unpackhi_epi16(lo, zero));
+				_mm_storeu_si128((__m128i *)(out + 8), _mm_unpacklo_epi16(hi, zero));
+				_mm_storeu_si128((__m128i *)(out + 12), _mm_unpackhi_epi16(hi, zero));
+				out += 16;
+			}
+
+			total += 16;
+			p += 16;
+		}
+
+		if (p >= lim)
+			break;
+#endif
 		if (!*p && insize == 0)
 			break;
 
@@ -271,6 +307,33 @@ size_t wchar_to_utf8(const wchar_t *in, size_t insize, char *out, size_t outsize
 	total = 0;
 
 	for (; w < wlim; w++) {
+#ifdef UTF8_SIMD_ASCII
+		/* pack runs of 16 ASCII wide characters straight to bytes;
+		 * anything else falls through to the scalar encoder */
+		while (insize != 0 && (size_t)(wlim - w) >= 16 && (out == NULL || (size_t)(lim - p) >= 16)) {
+			__m128i c0 = _mm_loadu_si128((const __m128i *)(w + 0));
+			__m128i c1 = _mm_loadu_si128((const __m128i *)(w + 4));
+			__m128i c2 = _mm_loadu_si128((const __m128i *)(w + 8));
+			__m128i c3 = _mm_loadu_si128((const __m128i *)(w + 12));
+			__m128i acc = _mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3));
+			acc = _mm_and_si128(acc, _mm_set1_epi32((int)0xffffff80));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(acc, _mm_setzero_si128())) != 0xffff)
+				break;
+
+			if (out != NULL) {
+				__m128i w16a = _mm_packs_epi32(c0, c1);
+				__m128i w16b = _mm_packs_epi32(c2, c3);
+				_mm_storeu_si128((__m128i *)p, _mm_packus_epi16(w16a, w16b));
+				p += 16;
+			}
+
+			total += 16;
+			w += 16;
+		}
+
+		if (w >= wlim)
+			break;
+#endif
 		if (!*w && insize == 0)
 			break;
 
@@ -287,6 +287,33 @@ void AJASource::CaptureThread(AJAThread *thread, void *data)
 		new AudioRepacker(ConvertRepackFormat(sourceProps.SpeakerLayout(), sourceProps.swapFrontCenterLFE),
 				  sourceProps.audioSampleSize * 8);
 
+	// Raster geometry and colorspace parameters are invariant for the
+	// life of this thread (a detected format change restarts capture via
+	// aja_source_update), so compute them once instead of per frame.
+	auto captureVideoFormat = sourceProps.videoFormat;
+	if (aja::Is3GLevelB(card, channel))
+		captureVideoFormat = aja::GetLevelAFormatForLevelBFormat(captureVideoFormat);
+
+	const enum video_format obs_vid_fmt = aja::AJAPixelFormatToOBSVideoFormat(sourceProps.pixelFormat);
+
+	NTV2FormatDesc fd(captureVideoFormat, sourceProps.pixelFormat);
+	struct obs_source_frame2 obsFrame;
+	obsFrame.flip = false;
+	obsFrame.width = fd.GetRasterWidth();
+	obsFrame.height = fd.GetRasterHeight();
+	obsFrame.format = obs_vid_fmt;
+	obsFrame.linesize[0] = fd.GetBytesPerRow();
+	video_colorspace colorspace = VIDEO_CS_709;
+	if (NTV2_IS_SD_VIDEO_FORMAT(captureVideoFormat))
+		colorspace = VIDEO_CS_601;
+	video_format_get_parameters_for_format(colorspace, VIDEO_RANGE_PARTIAL, obs_vid_fmt, obsFrame.color_matrix,
+					       obsFrame.color_range_min, obsFrame.color_range_max);
+
+	// Per-channel DMA bandwidth accounting
+	uint64_t videoBytes = 0, audioBytes = 0;
+	uint64_t totalVideoBytes = 0, totalAudioBytes = 0;
+	uint64_t statWindowStart = os_gettime_ns();
+
 	while (ajaSource->IsCapturing()) {
 		if (card->GetModelName() == "(Not Found)") {
 			os_sleep_ms(250);
@@ -327,6 +354,7 @@ void AJASource::CaptureThread(AJAThread *thread, void *data)
 			ResetAudioBufferOffsets(card, audioSystem, offsets);
 		} else {
 			offsets.lastAddress = offsets.currentAddress;
+			audioBytes += offsets.bytesRead;
 			uint32_t sampleCount =
 				offsets.bytesRead / (kDefaultAudioChannels * sourceProps.audioSampleSize);
 			obs_source_audio audioPacket;
@@ -355,32 +383,35 @@ void AJASource::CaptureThread(AJAThread *thread, void *data)
 		}
 
 		card->DMAReadFrame(currentCardFrame, ajaSource->mVideoBuffer, ajaSource->mVideoBuffer.GetByteCount());
+		videoBytes += ajaSource->mVideoBuffer.GetByteCount();
 
-		auto actualVideoFormat = videoFormat;
-		if (aja::Is3GLevelB(card, channel))
-			actualVideoFormat = aja::GetLevelAFormatForLevelBFormat(videoFormat);
-
-		const enum video_format obs_vid_fmt = aja::AJAPixelFormatToOBSVideoFormat(sourceProps.pixelFormat);
-
-		NTV2FormatDesc fd(actualVideoFormat, pixelFormat);
-		struct obs_source_frame2 obsFrame;
-		obsFrame.flip = false;
 		obsFrame.timestamp = os_gettime_ns();
-		obsFrame.width = fd.GetRasterWidth();
-		obsFrame.height = fd.GetRasterHeight();
-		obsFrame.format = obs_vid_fmt;
 		obsFrame.data[0] = reinterpret_cast<uint8_t *>((ULWord *)ajaSource->mVideoBuffer.GetHostPointer());
-		obsFrame.linesize[0] = fd.GetBytesPerRow();
-		video_colorspace colorspace = VIDEO_CS_709;
-		if (NTV2_IS_SD_VIDEO_FORMAT(actualVideoFormat))
-			colorspace = VIDEO_CS_601;
-		video_format_get_parameters_for_format(colorspace, VIDEO_RANGE_PARTIAL, obs_vid_fmt,
-						       obsFrame.color_matrix, obsFrame.color_range_min,
-						       obsFrame.color_range_max);
 
 		obs_source_output_video2(ajaSource->mSource, &obsFrame);
 
 		card->SetInputFrame(framestore, currentCardFrame);
+
+		const uint64_t now = os_gettime_ns();
+		if (now - statWindowStart >= 5 * NSEC_PER_SEC) {
+			const double sec = (double)(now - statWindowStart) / NSEC_PER_SEC;
+			blog(LOG_DEBUG, "AJASource::CaptureThread: '%s' DMA bandwidth: video %.1f MB/s, audio %.2f MB/s",
+			     ajaSource->GetName().c_str(), (double)videoBytes / sec / (1024.0 * 1024.0),
+			     (double)audioBytes / sec / (1024.0 * 1024.0));
+			totalVideoBytes += videoBytes;
+			totalAudioBytes += audioBytes;
+			videoBytes = 0;
+			audioBytes = 0;
+			statWindowStart = now;
+		}
+	}
+
+	totalVideoBytes += videoBytes;
+	totalAudioBytes += audioBytes;
+	if (totalVideoBytes || totalAudioBytes) {
+		blog(LOG_INFO, "AJASource::CaptureThread: '%s' transferred %.1f MB video, %.1f MB audio over DMA",
+		     ajaSource->GetName().c_str(), (double)totalVideoBytes / (1024.0 * 1024.0),
+		     (double)totalAudioBytes / (1024.0 * 1024.0));
 	}
 
 	blog(LOG_INFO, "AJASource::Capturethread: Thread loop stopped");
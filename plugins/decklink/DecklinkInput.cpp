@@ -70,11 +70,43 @@ bool DeckLinkInput::Activate(DeckLinkDevice *device, long long modeId, BMDVideoC
 			return false;
 	}
 
-	if (isActive)
-		instance->StopCapture();
+	const bool wasShared = sharedCapture;
+	if (isActive) {
+		if (wasShared)
+			instance->DetachExtraSource(source);
+		else
+			instance->StopCapture();
+	}
+	sharedCapture = false;
 
 	isCapturing = false;
-	if (!same)
+
+	/* The hardware input is exclusive; if another source is already
+	 * capturing this device with the same configuration, attach to its
+	 * instance instead of fighting over the input.  Frames are captured
+	 * and converted once and fanned out to every attached source. */
+	if (!same || wasShared) {
+		ComPtr<DeckLinkDeviceInstance> active;
+		active.Set(device->GetCaptureInstance());
+
+		if (active != nullptr && active->GetActiveModeId() == modeId &&
+		    active->GetVideoConnection() == bmdVideoConnection &&
+		    active->GetAudioConnection() == bmdAudioConnection &&
+		    active->GetActivePixelFormat() == pixelFormat && active->GetActiveColorSpace() == colorSpace &&
+		    active->GetActiveColorRange() == colorRange && active->GetActiveChannelFormat() == channelFormat &&
+		    active->GetActiveSwapState() == swap && active->AttachExtraSource(source)) {
+			instance = active;
+			sharedCapture = true;
+
+			os_atomic_inc_long(&activateRefs);
+			SaveSettings();
+			id = modeId;
+			isCapturing = true;
+			return true;
+		}
+	}
+
+	if (!same || wasShared)
 		instance.Set(new DeckLinkDeviceInstance(this, device));
 
 	if (instance == nullptr)
@@ -106,8 +138,13 @@ bool DeckLinkInput::Activate(DeckLinkDevice *device, long long modeId, BMDVideoC
 void DeckLinkInput::Deactivate(void)
 {
 	std::lock_guard<std::recursive_mutex> lock(deviceMutex);
-	if (instance)
-		instance->StopCapture();
+	if (instance) {
+		if (sharedCapture)
+			instance->DetachExtraSource(source);
+		else
+			instance->StopCapture();
+	}
+	sharedCapture = false;
 	isCapturing = false;
 	instance = nullptr;
 
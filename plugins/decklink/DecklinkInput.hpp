@@ -5,6 +5,7 @@
 class DeckLinkInput : public DecklinkBase {
 protected:
 	bool isCapturing = false;
+	bool sharedCapture = false;
 	obs_source_t *source;
 
 	void SaveSettings();
@@ -165,6 +165,10 @@ void DeckLinkDeviceInstance::HandleAudioPacket(IDeckLinkAudioInputPacket *audioP
 	nextAudioTS = timestamp + util_mul_div64(frameCount, 1000000000ULL, 48000ULL) + 1;
 
 	obs_source_output_audio(static_cast<DeckLinkInput *>(decklink)->GetSource(), &currentPacket);
+
+	std::lock_guard<std::mutex> lock(extraSourcesMutex);
+	for (obs_source_t *extra : extraSources)
+		obs_source_output_audio(extra, &currentPacket);
 }
 
 void DeckLinkDeviceInstance::HandleVideoFrame(IDeckLinkVideoInputFrame *videoFrame, const uint64_t timestamp)
@@ -244,6 +248,12 @@ void DeckLinkDeviceInstance::HandleVideoFrame(IDeckLinkVideoInputFrame *videoFra
 	currentFrame.trc = trc;
 
 	obs_source_output_video2(static_cast<DeckLinkInput *>(decklink)->GetSource(), &currentFrame);
+
+	/* The pixel format conversion above only ran once; every attached
+	 * source just copies the same frame into its async cache. */
+	std::lock_guard<std::mutex> lock(extraSourcesMutex);
+	for (obs_source_t *extra : extraSources)
+		obs_source_output_video2(extra, &currentFrame);
 }
 
 void DeckLinkDeviceInstance::HandleCaptionPacket(IDeckLinkAncillaryPacket *packet, const uint64_t timestamp)
@@ -321,15 +331,19 @@ void DeckLinkDeviceInstance::HandleCaptionPacket(IDeckLinkAncillaryPacket *packe
 
 		auto cc_count = bitstream_reader_read_bits(&reader, 5);
 
-		auto *outData = (uint8_t *)bzalloc(sizeof(uint8_t) * cc_count * 3);
-		memcpy(outData, anc + reader.pos, cc_count * 3);
+		/* cc_count is 5 bits, so the buffer tops out at 93 bytes and
+		 * never reallocates after the first caption frame */
+		captionBuffer.assign(anc + reader.pos, anc + reader.pos + cc_count * 3);
 
-		currentCaptions.data = outData;
+		currentCaptions.data = captionBuffer.data();
 		currentCaptions.timestamp = timestamp;
 		currentCaptions.packets = cc_count;
 
 		obs_source_output_cea708(static_cast<DeckLinkInput *>(decklink)->GetSource(), &currentCaptions);
-		bfree(outData);
+
+		std::lock_guard<std::mutex> lock(extraSourcesMutex);
+		for (obs_source_t *extra : extraSources)
+			obs_source_output_cea708(extra, &currentCaptions);
 	}
 }
 
@@ -503,6 +517,8 @@ bool DeckLinkDeviceInstance::StartCapture(DeckLinkDeviceMode *mode_, bool allow1
 
 	mode = mode_;
 
+	device->SetCaptureInstance(this);
+
 	return true;
 }
 
@@ -513,12 +529,37 @@ bool DeckLinkDeviceInstance::StopCapture(void)
 
 	LOG(LOG_INFO, "Stopping capture of '%s'...", GetDevice()->GetDisplayName().c_str());
 
+	device->ClearCaptureInstance(this);
+
 	input->StopStreams();
 	FinalizeStream();
 
 	return true;
 }
 
+bool DeckLinkDeviceInstance::AttachExtraSource(obs_source_t *source)
+{
+	std::lock_guard<std::mutex> lock(extraSourcesMutex);
+	if (mode == nullptr)
+		return false;
+
+	extraSources.push_back(source);
+	LOG(LOG_INFO, "Sharing capture of '%s' (%d attached sources)", GetDevice()->GetDisplayName().c_str(),
+	    (int)extraSources.size());
+	return true;
+}
+
+void DeckLinkDeviceInstance::DetachExtraSource(obs_source_t *source)
+{
+	std::lock_guard<std::mutex> lock(extraSourcesMutex);
+	for (size_t i = 0; i < extraSources.size(); i++) {
+		if (extraSources[i] == source) {
+			extraSources.erase(extraSources.begin() + i);
+			break;
+		}
+	}
+}
+
 bool DeckLinkDeviceInstance::StartOutput(DeckLinkDeviceMode *mode_)
 {
 	if (mode != nullptr)
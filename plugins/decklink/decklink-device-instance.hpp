@@ -7,6 +7,7 @@
 #include "decklink-device.hpp"
 #include "OBSVideoFrame.h"
 #include <atomic>
+#include <mutex>
 #include <vector>
 
 class AudioRepacker;
@@ -156,6 +157,12 @@ protected:
 	bool swap;
 	bool allow10Bit;
 
+	/* additional sources fed from this capture (fan-out); the capture
+	 * itself is owned by the source that started it */
+	std::mutex extraSourcesMutex;
+	std::vector<obs_source_t *> extraSources;
+	std::vector<uint8_t> captionBuffer;
+
 	OBSVideoFrame *convertFrame = nullptr;
 	std::vector<uint8_t> frameBlobs[FrameQueueFrameCount];
 	FrameQueue frameQueueObsToDecklink;
@@ -193,6 +200,9 @@ public:
 			  BMDAudioConnection bmdAudioConnection);
 	bool StopCapture(void);
 
+	bool AttachExtraSource(obs_source_t *source);
+	void DetachExtraSource(obs_source_t *source);
+
 	bool StartOutput(DeckLinkDeviceMode *mode_);
 	bool StopOutput(void);
 
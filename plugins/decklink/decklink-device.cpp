@@ -1,6 +1,7 @@
 #include <sstream>
 
 #include "decklink-device.hpp"
+#include "decklink-device-instance.hpp"
 
 #include <util/threading.h>
 
@@ -258,3 +259,27 @@ int32_t DeckLinkDevice::GetMaxChannel(void) const
 {
 	return maxChannel;
 }
+
+/* The device's input can only be captured once; additional sources share the
+ * frames of the instance registered here.  Returns an AddRef'd instance (or
+ * nullptr when nothing is capturing); the caller owns the reference. */
+DeckLinkDeviceInstance *DeckLinkDevice::GetCaptureInstance()
+{
+	std::lock_guard<std::mutex> lock(captureMutex);
+	if (captureInstance)
+		captureInstance->AddRef();
+	return captureInstance;
+}
+
+void DeckLinkDevice::SetCaptureInstance(DeckLinkDeviceInstance *instance)
+{
+	std::lock_guard<std::mutex> lock(captureMutex);
+	captureInstance = instance;
+}
+
+void DeckLinkDevice::ClearCaptureInstance(DeckLinkDeviceInstance *instance)
+{
+	std::lock_guard<std::mutex> lock(captureMutex);
+	if (captureInstance == instance)
+		captureInstance = nullptr;
+}
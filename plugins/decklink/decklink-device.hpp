@@ -3,10 +3,13 @@
 #include "decklink-device-mode.hpp"
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <stdint.h>
 
+class DeckLinkDeviceInstance;
+
 class DeckLinkDevice {
 	ComPtr<IDeckLink> device;
 	std::map<long long, DeckLinkDeviceMode *> inputModeIdMap;
@@ -29,6 +32,8 @@ class DeckLinkDevice {
 	int64_t supportedAudioOutputConnections = -1;
 	int keyerMode = 0;
 	volatile long refCount = 1;
+	std::mutex captureMutex;
+	DeckLinkDeviceInstance *captureInstance = nullptr;
 
 public:
 	DeckLinkDevice(IDeckLink *device);
@@ -62,5 +67,9 @@ public:
 	bool GetOutput(IDeckLinkOutput **output);
 	bool GetKeyer(IDeckLinkKeyer **keyer);
 
+	DeckLinkDeviceInstance *GetCaptureInstance();
+	void SetCaptureInstance(DeckLinkDeviceInstance *instance);
+	void ClearCaptureInstance(DeckLinkDeviceInstance *instance);
+
 	inline bool IsDevice(IDeckLink *device_) { return device_ == device; }
 };
@@ -27,6 +27,9 @@ struct image_source {
 	volatile bool file_decoded;
 	volatile bool texture_loaded;
 
+	pthread_t decode_thread;
+	bool decode_thread_active;
+
 	gs_image_file4_t if4;
 };
 
@@ -72,11 +75,27 @@ static void image_source_load_texture(void *data)
 		warn("failed to load texture '%s'", context->file);
 	context->update_time_elapsed = 0;
 	os_atomic_set_bool(&context->texture_loaded, true);
+	obs_source_video_changed(context->source);
+}
+
+static void *image_source_decode_thread(void *data)
+{
+	struct image_source *context = data;
+
+	os_set_thread_name("image_source: file decode");
+	image_source_preload_image(context);
+	return NULL;
 }
 
 static void image_source_unload(void *data)
 {
 	struct image_source *context = data;
+
+	if (context->decode_thread_active) {
+		pthread_join(context->decode_thread, NULL);
+		context->decode_thread_active = false;
+	}
+
 	os_atomic_set_bool(&context->file_decoded, false);
 	os_atomic_set_bool(&context->texture_loaded, false);
 
@@ -90,8 +109,16 @@ static void image_source_load(struct image_source *context)
 	image_source_unload(context);
 
 	if (context->file && *context->file) {
-		image_source_preload_image(context);
-		image_source_load_texture(context);
+		/* Decode on a worker thread; the tick callback uploads the
+		 * texture once the file has been decoded, and nothing is
+		 * rendered until then.  This keeps large files from
+		 * stalling whichever thread triggered the (re)load. */
+		if (pthread_create(&context->decode_thread, NULL, image_source_decode_thread, context) == 0) {
+			context->decode_thread_active = true;
+		} else {
+			image_source_preload_image(context);
+			image_source_load_texture(context);
+		}
 	}
 }
 
@@ -204,6 +231,11 @@ static void image_source_render(void *data, gs_effect_t *effect)
 		return;
 
 	struct gs_image_file *const image = &context->if4.image3.image2.image;
+
+	/* re-upload if the texture was demoted under memory pressure */
+	if (!image->texture && image->texture_data)
+		gs_image_file_init_texture(image);
+
 	gs_texture_t *const texture = image->texture;
 	if (!texture)
 		return;
@@ -276,6 +308,7 @@ static void image_source_tick(void *data, float seconds)
 			obs_enter_graphics();
 			gs_image_file4_update_texture(&context->if4);
 			obs_leave_graphics();
+			obs_source_video_changed(context->source);
 		}
 	}
 
@@ -319,6 +352,12 @@ uint64_t image_source_get_memory_usage(void *data)
 	return s->if4.image3.image2.mem_usage;
 }
 
+bool image_source_decoded(void *data)
+{
+	struct image_source *s = data;
+	return os_atomic_load_bool(&s->file_decoded);
+}
+
 static void missing_file_callback(void *src, const char *new_path, void *data)
 {
 	struct image_source *s = src;
@@ -338,12 +377,10 @@ static obs_missing_files_t *image_source_missingfiles(void *data)
 	obs_missing_files_t *files = obs_missing_files_create();
 
 	if (strcmp(s->file, "") != 0) {
-		if (!os_file_exists(s->file)) {
-			obs_missing_file_t *file = obs_missing_file_create(s->file, missing_file_callback,
-									   OBS_MISSING_FILE_SOURCE, s->source, NULL);
+		obs_missing_file_t *file = obs_missing_file_create(s->file, missing_file_callback,
+								   OBS_MISSING_FILE_SOURCE, s->source, NULL);
 
-			obs_missing_files_add_file(files, file);
-		}
+		obs_missing_files_add_file_checked(files, file);
 	}
 
 	return files;
@@ -363,7 +400,7 @@ static enum gs_color_space image_source_get_color_space(void *data, size_t count
 static struct obs_source_info image_source_info = {
 	.id = "image_source",
 	.type = OBS_SOURCE_TYPE_INPUT,
-	.output_flags = OBS_SOURCE_VIDEO | OBS_SOURCE_SRGB,
+	.output_flags = OBS_SOURCE_VIDEO | OBS_SOURCE_SRGB | OBS_SOURCE_STATIC_VIDEO,
 	.get_name = image_source_get_name,
 	.create = image_source_create,
 	.destroy = image_source_destroy,
@@ -68,6 +68,8 @@ static const char *TR_SLIDE                  = "slide";
 /* clang-format on */
 
 extern void image_source_preload_image(void *data);
+extern uint64_t image_source_get_memory_usage(void *data);
+extern bool image_source_decoded(void *data);
 
 /* ------------------------------------------------------------------------- */
 
@@ -91,6 +93,13 @@ enum behavior {
 
 #define SLIDE_BUFFER_COUNT 5
 
+/* memory budget for decoded slides held by the decode-ahead buffers.
+ * slides nearest the current one always stay decoded; farther ones are
+ * evicted once the budget is exceeded and decoded again as they move
+ * closer */
+#define BYTES_TO_MBYTES (1024 * 1024)
+#define MAX_DECODE_AHEAD_MEM (400 * BYTES_TO_MBYTES)
+
 struct active_slides {
 	struct deque prev;
 	struct deque next;
@@ -369,6 +378,53 @@ static struct source_data get_new_source(struct slideshow *ss, struct active_sli
 	return sd;
 }
 
+/* bytes of decoded image data a buffered slide currently holds. slides
+ * still waiting on their decode task report zero */
+static uint64_t slide_mem_usage(obs_source_t *source)
+{
+	void *data = obs_obj_get_data(source);
+
+	if (!data || !image_source_decoded(data))
+		return 0;
+
+	return image_source_get_memory_usage(data);
+}
+
+static inline uint64_t prune_deque_slides(struct slideshow *ss, struct deque *buf, bool back_to_front, uint64_t used)
+{
+	size_t count = buf->size / sizeof(struct source_data);
+
+	for (size_t i = 0; i < count; i++) {
+		size_t idx = back_to_front ? count - 1 - i : i;
+		struct source_data *sd = deque_data(buf, idx * sizeof(struct source_data));
+
+		/* the nearest slide always stays resident so rotation
+		 * never lands on an evicted source */
+		if (i == 0 || used <= MAX_DECODE_AHEAD_MEM) {
+			if (!sd->source)
+				sd->source = create_source_from_file(ss, sd->path, false);
+			used += slide_mem_usage(sd->source);
+		} else if (sd->source) {
+			obs_source_release(sd->source);
+			sd->source = NULL;
+		}
+	}
+
+	return used;
+}
+
+/* keeps the decode-ahead buffers within the memory budget. upcoming
+ * slides get budget priority over previous ones since that is the usual
+ * playback direction */
+static void prune_decoded_slides(struct slideshow *ss)
+{
+	struct active_slides *slides = &ss->data.slides;
+	uint64_t used = slide_mem_usage(slides->cur.source);
+
+	used = prune_deque_slides(ss, &slides->next, false, used);
+	prune_deque_slides(ss, &slides->prev, true, used);
+}
+
 static void restart_slides(struct slideshow *ss)
 {
 	struct slideshow_data *ssd = &ss->data;
@@ -837,6 +893,8 @@ static void ss_video_tick(void *data, float seconds)
 	if (!ss->transition || !ssd->slide_time)
 		return;
 
+	prune_decoded_slides(ss);
+
 	if (ssd->restart_on_activate && ssd->use_cut) {
 		ssd->elapsed = 0.0f;
 		restart_slides(ss);
@@ -1112,12 +1170,10 @@ static obs_missing_files_t *ss_missingfiles(void *data)
 		const char *path = obs_data_get_string(item, "value");
 
 		if (*path != 0) {
-			if (!os_file_exists(path)) {
-				obs_missing_file_t *file = obs_missing_file_create(
-					path, missing_file_callback, OBS_MISSING_FILE_SOURCE, source, (void *)path);
+			obs_missing_file_t *file = obs_missing_file_create(path, missing_file_callback,
+									   OBS_MISSING_FILE_SOURCE, source, (void *)path);
 
-				obs_missing_files_add_file(missing_files, file);
-			}
+			obs_missing_files_add_file_checked(missing_files, file);
 		}
 
 		obs_data_release(item);
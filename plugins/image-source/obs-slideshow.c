@@ -1008,12 +1008,10 @@ static obs_missing_files_t *ss_missingfiles(void *data)
 		const char *path = obs_data_get_string(item, "value");
 
 		if (strcmp(path, "") != 0) {
-			if (!os_file_exists(path)) {
-				obs_missing_file_t *file = obs_missing_file_create(
-					path, missing_file_callback, OBS_MISSING_FILE_SOURCE, source, (void *)path);
+			obs_missing_file_t *file = obs_missing_file_create(path, missing_file_callback,
+									   OBS_MISSING_FILE_SOURCE, source, (void *)path);
 
-				obs_missing_files_add_file(missing_files, file);
-			}
+			obs_missing_files_add_file_checked(missing_files, file);
 		}
 
 		obs_data_release(item);
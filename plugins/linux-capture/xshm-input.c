@@ -18,6 +18,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdio.h>
 #include <stdlib.h>
 #include <inttypes.h>
+#include <xcb/damage.h>
 #include <xcb/randr.h>
 #include <xcb/shm.h>
 #include <xcb/xfixes.h>
@@ -25,6 +26,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <obs-module.h>
 #include <util/dstr.h>
+#include <util/platform.h>
 #include "xcursor-xcb.h"
 #include "xhelpers.h"
 
@@ -34,6 +36,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #define INVALID_DISPLAY (-1)
 
+/* safety-net full refresh interval when damage reporting is active */
+#define XSHM_REFRESH_INTERVAL_NS (2 * 1000000000ULL)
+
 struct xshm_data {
 	obs_source_t *source;
 
@@ -65,6 +70,12 @@ struct xshm_data {
 	bool use_xinerama;
 	bool use_randr;
 	bool advanced;
+
+	/* damage reporting: skip the screen copy entirely on ticks where
+	 * nothing changed (XCB_NONE when the extension is unavailable) */
+	xcb_damage_damage_t damage;
+	uint8_t damage_event;
+	uint64_t last_refresh_ns;
 };
 
 /**
@@ -202,6 +213,11 @@ static void xshm_capture_stop(struct xshm_data *data)
 		data->xshm = NULL;
 	}
 
+	if (data->damage) {
+		xcb_damage_destroy(data->xcb, data->damage);
+		data->damage = XCB_NONE;
+	}
+
 	if (data->xcb) {
 		xcb_disconnect(data->xcb);
 		data->xcb = NULL;
@@ -256,6 +272,19 @@ static void xshm_capture_start(struct xshm_data *data)
 	data->cursor = xcb_xcursor_init(data->xcb);
 	xcb_xcursor_offset(data->cursor, data->adj_x_org, data->adj_y_org);
 
+	const xcb_query_extension_reply_t *damage_ext = xcb_get_extension_data(data->xcb, &xcb_damage_id);
+	if (damage_ext && damage_ext->present) {
+		xcb_damage_query_version_unchecked(data->xcb, XCB_DAMAGE_MAJOR_VERSION, XCB_DAMAGE_MINOR_VERSION);
+		data->damage_event = damage_ext->first_event;
+		data->damage = xcb_generate_id(data->xcb);
+		xcb_damage_create(data->xcb, data->damage, data->xcb_screen->root,
+				  XCB_DAMAGE_REPORT_LEVEL_NON_EMPTY);
+	} else {
+		blog(LOG_INFO, "Missing Damage extension, copying every frame");
+		data->damage = XCB_NONE;
+	}
+	data->last_refresh_ns = 0;
+
 	obs_enter_graphics();
 
 	xshm_resize_texture(data);
@@ -494,6 +523,30 @@ static void xshm_video_tick(void *vptr, float seconds)
 	if (!obs_source_showing(data->source))
 		return;
 
+	bool dirty = data->damage == XCB_NONE;
+	xcb_generic_event_t *event;
+
+	while ((event = xcb_poll_for_event(data->xcb))) {
+		if (data->damage && (event->response_type & ~0x80) == data->damage_event + XCB_DAMAGE_NOTIFY)
+			dirty = true;
+		free(event);
+	}
+
+	const uint64_t now = os_gettime_ns();
+	if (!dirty && now - data->last_refresh_ns < XSHM_REFRESH_INTERVAL_NS) {
+		/* screen unchanged since the last copy: only track the
+		 * cursor, which produces no root window damage */
+		obs_enter_graphics();
+		xcb_xcursor_update(data->xcb, data->cursor);
+		obs_leave_graphics();
+		return;
+	}
+
+	/* clear the damage region before copying so changes that race the
+	 * copy re-trigger an event and get picked up next tick */
+	if (data->damage)
+		xcb_damage_subtract(data->xcb, data->damage, XCB_NONE, XCB_NONE);
+
 	xcb_shm_get_image_cookie_t img_c;
 	xcb_shm_get_image_reply_t *img_r;
 
@@ -513,6 +566,8 @@ static void xshm_video_tick(void *vptr, float seconds)
 
 	obs_leave_graphics();
 
+	data->last_refresh_ns = now;
+
 exit:
 	free(img_r);
 }
@@ -76,6 +76,18 @@ struct format_info {
 	DARRAY(uint64_t) modifiers;
 };
 
+/* cached per-buffer DMA-BUF import: PipeWire cycles a fixed pool of
+ * buffers, so the EGL image behind each one is created once and kept in
+ * pw_buffer user data until the buffer is removed from the pool */
+struct dmabuf_texture {
+	gs_texture_t *texture;
+	uint32_t n_planes;
+	int fds[MAX_AV_PLANES];
+	uint32_t strides[MAX_AV_PLANES];
+	uint32_t offsets[MAX_AV_PLANES];
+	uint64_t modifier;
+};
+
 struct _obs_pipewire {
 	int pipewire_fd;
 
@@ -99,6 +111,14 @@ struct _obs_pipewire_stream {
 	obs_source_t *source;
 
 	gs_texture_t *texture;
+	gs_texture_t *shm_texture;
+
+	struct {
+		uint64_t zero_copy_frames;
+		uint64_t copied_frames;
+		uint64_t dmabuf_imports;
+	} stats;
+	bool shm_fallback_logged;
 
 	struct pw_stream *stream;
 	struct spa_hook stream_listener;
@@ -788,23 +808,68 @@ static void process_video_sync(obs_pipewire_stream *obs_pw_stream)
 			goto read_metadata;
 		}
 
-		g_clear_pointer(&obs_pw_stream->texture, gs_texture_destroy);
+		if (planes > MAX_AV_PLANES) {
+			blog(LOG_ERROR, "[pipewire] too many DMA-BUF planes: %u", planes);
+			goto read_metadata;
+		}
+
+		/* reuse the import made the first time this buffer was seen
+		 * unless its layout changed underneath us */
+		struct dmabuf_texture *entry = b->user_data;
+		if (entry &&
+		    (entry->n_planes != planes || entry->modifier != obs_pw_stream->format.info.raw.modifier ||
+		     memcmp(entry->fds, fds, planes * sizeof(int)) != 0 ||
+		     memcmp(entry->strides, strides, planes * sizeof(uint32_t)) != 0 ||
+		     memcmp(entry->offsets, offsets, planes * sizeof(uint32_t)) != 0)) {
+			if (obs_pw_stream->texture == entry->texture)
+				obs_pw_stream->texture = NULL;
+			g_clear_pointer(&entry->texture, gs_texture_destroy);
+			g_clear_pointer(&b->user_data, bfree);
+			entry = NULL;
+		}
 
-		use_modifiers = obs_pw_stream->format.info.raw.modifier != DRM_FORMAT_MOD_INVALID;
-		obs_pw_stream->texture = gs_texture_create_from_dmabuf(
-			obs_pw_stream->format.info.raw.size.width, obs_pw_stream->format.info.raw.size.height,
-			obs_pw_video_format.drm_format, obs_pw_video_format.gs_format, planes, fds, strides, offsets,
-			use_modifiers ? modifiers : NULL);
+		if (!entry) {
+			gs_texture_t *texture;
 
-		if (obs_pw_stream->texture == NULL) {
-			remove_modifier_from_format(obs_pw_stream, obs_pw_stream->format.info.raw.format,
-						    obs_pw_stream->format.info.raw.modifier);
-			pw_loop_signal_event(pw_thread_loop_get_loop(obs_pw->thread_loop), obs_pw_stream->reneg);
-			goto read_metadata;
+			use_modifiers = obs_pw_stream->format.info.raw.modifier != DRM_FORMAT_MOD_INVALID;
+			texture = gs_texture_create_from_dmabuf(obs_pw_stream->format.info.raw.size.width,
+								obs_pw_stream->format.info.raw.size.height,
+								obs_pw_video_format.drm_format,
+								obs_pw_video_format.gs_format, planes, fds, strides,
+								offsets, use_modifiers ? modifiers : NULL);
+
+			if (texture == NULL) {
+				remove_modifier_from_format(obs_pw_stream, obs_pw_stream->format.info.raw.format,
+							    obs_pw_stream->format.info.raw.modifier);
+				pw_loop_signal_event(pw_thread_loop_get_loop(obs_pw->thread_loop), obs_pw_stream->reneg);
+				goto read_metadata;
+			}
+
+			if (obs_pw_video_format.swap_red_blue)
+				swap_texture_red_blue(texture);
+
+			entry = bzalloc(sizeof(*entry));
+			entry->texture = texture;
+			entry->n_planes = planes;
+			memcpy(entry->fds, fds, planes * sizeof(int));
+			memcpy(entry->strides, strides, planes * sizeof(uint32_t));
+			memcpy(entry->offsets, offsets, planes * sizeof(uint32_t));
+			entry->modifier = obs_pw_stream->format.info.raw.modifier;
+			b->user_data = entry;
+
+			obs_pw_stream->stats.dmabuf_imports++;
 		}
+
+		obs_pw_stream->texture = entry->texture;
+		obs_pw_stream->stats.zero_copy_frames++;
 	} else {
 		blog(LOG_DEBUG, "[pipewire] Buffer has memory texture");
 
+		if (!obs_pw_stream->shm_fallback_logged) {
+			blog(LOG_INFO, "[pipewire] DMA-BUF unavailable, copying memory buffers every frame");
+			obs_pw_stream->shm_fallback_logged = true;
+		}
+
 		if (!obs_pw_video_format_from_spa_format(obs_pw_stream->format.info.raw.format, &obs_pw_video_format) ||
 		    obs_pw_video_format.gs_format == GS_UNKNOWN) {
 			blog(LOG_ERROR, "[pipewire] unsupported buffer format: %d",
@@ -822,15 +887,28 @@ static void process_video_sync(obs_pipewire_stream *obs_pw_stream)
 			goto read_metadata;
 		}
 
-		g_clear_pointer(&obs_pw_stream->texture, gs_texture_destroy);
-		obs_pw_stream->texture = gs_texture_create(obs_pw_stream->format.info.raw.size.width,
-							   obs_pw_stream->format.info.raw.size.height,
-							   obs_pw_video_format.gs_format, 1,
-							   (const uint8_t **)&buffer->datas[0].data, GS_DYNAMIC);
-	}
+		/* the dynamic texture is reused across frames; recreating it
+		 * is only necessary when the negotiated size/format change */
+		if (obs_pw_stream->shm_texture &&
+		    (gs_texture_get_width(obs_pw_stream->shm_texture) != obs_pw_stream->format.info.raw.size.width ||
+		     gs_texture_get_height(obs_pw_stream->shm_texture) != obs_pw_stream->format.info.raw.size.height ||
+		     gs_texture_get_color_format(obs_pw_stream->shm_texture) != obs_pw_video_format.gs_format))
+			g_clear_pointer(&obs_pw_stream->shm_texture, gs_texture_destroy);
+
+		if (obs_pw_stream->shm_texture) {
+			gs_texture_set_image(obs_pw_stream->shm_texture, buffer->datas[0].data,
+					     buffer->datas[0].chunk->stride, false);
+		} else {
+			obs_pw_stream->shm_texture = gs_texture_create(
+				obs_pw_stream->format.info.raw.size.width, obs_pw_stream->format.info.raw.size.height,
+				obs_pw_video_format.gs_format, 1, (const uint8_t **)&buffer->datas[0].data, GS_DYNAMIC);
+			if (obs_pw_stream->shm_texture && obs_pw_video_format.swap_red_blue)
+				swap_texture_red_blue(obs_pw_stream->shm_texture);
+		}
 
-	if (obs_pw_video_format.swap_red_blue)
-		swap_texture_red_blue(obs_pw_stream->texture);
+		obs_pw_stream->texture = obs_pw_stream->shm_texture;
+		obs_pw_stream->stats.copied_frames++;
+	}
 
 	/* Video Crop */
 	region = spa_buffer_find_meta_data(buffer, SPA_META_VideoCrop, sizeof(*region));
@@ -1035,6 +1113,23 @@ static void on_param_changed_cb(void *user_data, uint32_t id, const struct spa_p
 	obs_pw_stream->negotiated = true;
 }
 
+static void on_remove_buffer_cb(void *user_data, struct pw_buffer *b)
+{
+	obs_pipewire_stream *obs_pw_stream = user_data;
+	struct dmabuf_texture *entry = b->user_data;
+
+	if (!entry)
+		return;
+
+	obs_enter_graphics();
+	if (obs_pw_stream->texture == entry->texture)
+		obs_pw_stream->texture = NULL;
+	gs_texture_destroy(entry->texture);
+	obs_leave_graphics();
+
+	g_clear_pointer(&b->user_data, bfree);
+}
+
 static void on_state_changed_cb(void *user_data, enum pw_stream_state old, enum pw_stream_state state,
 				const char *error)
 {
@@ -1051,6 +1146,7 @@ static const struct pw_stream_events stream_events = {
 	.state_changed = on_state_changed_cb,
 	.param_changed = on_param_changed_cb,
 	.process = on_process_cb,
+	.remove_buffer = on_remove_buffer_cb,
 };
 
 static void on_core_info_cb(void *user_data, const struct pw_core_info *info)
@@ -1398,9 +1494,17 @@ void obs_pipewire_stream_destroy(obs_pipewire_stream *obs_pw_stream)
 
 	g_ptr_array_remove(obs_pw_stream->obs_pw->streams, obs_pw_stream);
 
+	blog(LOG_INFO,
+	     "[pipewire] Stream %p frames: %" PRIu64 " zero-copy, %" PRIu64 " copied, %" PRIu64 " DMA-BUF imports",
+	     obs_pw_stream->stream, obs_pw_stream->stats.zero_copy_frames, obs_pw_stream->stats.copied_frames,
+	     obs_pw_stream->stats.dmabuf_imports);
+
 	obs_enter_graphics();
 	g_clear_pointer(&obs_pw_stream->cursor.texture, gs_texture_destroy);
-	g_clear_pointer(&obs_pw_stream->texture, gs_texture_destroy);
+	g_clear_pointer(&obs_pw_stream->shm_texture, gs_texture_destroy);
+	/* DMA-BUF textures are owned by the buffer pool entries and are
+	 * released by on_remove_buffer_cb when the stream disconnects */
+	obs_pw_stream->texture = NULL;
 	obs_leave_graphics();
 
 	pw_thread_loop_lock(obs_pw_stream->obs_pw->thread_loop);
@@ -45,6 +45,10 @@ struct pulse_data {
 	uint_fast8_t channels;
 	uint64_t first_ts;
 
+	/* fragment batching */
+	uint8_t *batch_buffer;
+	size_t batch_capacity;
+
 	/* statistics */
 	uint_fast32_t packets;
 	uint_fast64_t frames;
@@ -185,28 +189,47 @@ static void pulse_stream_read(pa_stream *p, size_t nbytes, void *userdata)
 
 	const void *frames;
 	size_t bytes;
+	size_t total = 0;
 
 	if (!data->stream)
 		goto exit;
 
-	pa_stream_peek(data->stream, &frames, &bytes);
+	/* drain every fragment available this wakeup into one buffer so
+	 * only a single packet is pushed into the source per callback */
+	while (pa_stream_readable_size(data->stream) > 0) {
+		if (pa_stream_peek(data->stream, &frames, &bytes) != 0)
+			break;
 
-	// check if we got data
-	if (!bytes)
-		goto exit;
+		// check if we got data
+		if (!bytes)
+			break;
+
+		if (!frames) {
+			blog(LOG_ERROR, "Got audio hole of %u bytes", (unsigned int)bytes);
+			pa_stream_drop(data->stream);
+			continue;
+		}
+
+		if (total + bytes > data->batch_capacity) {
+			data->batch_capacity = total + bytes;
+			data->batch_buffer = brealloc(data->batch_buffer, data->batch_capacity);
+		}
+
+		memcpy(data->batch_buffer + total, frames, bytes);
+		total += bytes;
 
-	if (!frames) {
-		blog(LOG_ERROR, "Got audio hole of %u bytes", (unsigned int)bytes);
 		pa_stream_drop(data->stream);
-		goto exit;
 	}
 
+	if (!total)
+		goto exit;
+
 	struct obs_source_audio out;
 	out.speakers = data->speakers;
 	out.samples_per_sec = data->samples_per_sec;
 	out.format = pulse_to_obs_audio_format(data->format);
-	out.data[0] = (uint8_t *)frames;
-	out.frames = bytes / data->bytes_per_frame;
+	out.data[0] = data->batch_buffer;
+	out.frames = total / data->bytes_per_frame;
 	out.timestamp = get_sample_time(out.frames, out.samples_per_sec);
 
 	if (!data->first_ts)
@@ -217,8 +240,6 @@ static void pulse_stream_read(pa_stream *p, size_t nbytes, void *userdata)
 
 	data->packets++;
 	data->frames += out.frames;
-
-	pa_stream_drop(data->stream);
 exit:
 	pulse_signal(0);
 }
@@ -312,9 +333,9 @@ skip:
  * We request the default format used by pulse here because the data will be
  * converted and possibly re-sampled by obs anyway.
  *
- * For now we request a buffer length of 25ms although pulse seems to ignore
- * this setting for monitor streams. For "real" input streams this should work
- * fine though.
+ * We request a fragment size matching the obs audio tick although pulse
+ * seems to ignore this setting for monitor streams. For "real" input
+ * streams this should work fine though.
  */
 static int_fast32_t pulse_start_recording(struct pulse_data *data)
 {
@@ -357,8 +378,16 @@ static int_fast32_t pulse_start_recording(struct pulse_data *data)
 	pa_stream_set_read_callback(data->stream, pulse_stream_read, (void *)data);
 	pulse_unlock();
 
+	/* Negotiate a fragment size matching the obs audio tick
+	 * (AUDIO_OUTPUT_FRAMES) so each wakeup delivers roughly one mix
+	 * tick worth of data; fall back to 25ms if audio is not active. */
+	uint64_t frag_usec = 25000;
+	struct obs_audio_info aoi;
+	if (obs_get_audio_info(&aoi) && aoi.samples_per_sec)
+		frag_usec = util_mul_div64(AUDIO_OUTPUT_FRAMES, 1000000ULL, aoi.samples_per_sec);
+
 	pa_buffer_attr attr;
-	attr.fragsize = pa_usec_to_bytes(25000, &spec);
+	attr.fragsize = pa_usec_to_bytes((pa_usec_t)frag_usec, &spec);
 	attr.maxlength = (uint32_t)-1;
 	attr.minreq = (uint32_t)-1;
 	attr.prebuf = (uint32_t)-1;
@@ -513,6 +542,7 @@ static void pulse_destroy(void *vptr)
 
 	if (data->device)
 		bfree(data->device);
+	bfree(data->batch_buffer);
 	bfree(data);
 }
 
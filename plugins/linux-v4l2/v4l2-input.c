@@ -53,6 +53,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #define V4L2_DATA(voidptr) struct v4l2_data *data = voidptr;
 
+#define V4L2_FRAME_POOL_SIZE 4
+
 #define timeval2ns(tv) (((uint64_t)tv.tv_sec * 1000000000) + ((uint64_t)tv.tv_usec * 1000))
 
 #define V4L2_FOURCC_STR(code)                                                                \
@@ -93,6 +95,10 @@ struct v4l2_data {
 
 	bool auto_reset;
 	int timeout_frames;
+
+	/* raw frames recycled through obs_source_output_video_take; a frame
+	 * with a reference count of 1 is owned exclusively by us */
+	struct obs_source_frame *frame_pool[V4L2_FRAME_POOL_SIZE];
 };
 
 /* forward declarations */
@@ -154,6 +160,107 @@ static void v4l2_prep_obs_frame(struct v4l2_data *data, struct obs_source_frame
 	}
 }
 
+static void v4l2_init_frame_pool(struct v4l2_data *data, const struct obs_source_frame *proto)
+{
+	const enum video_format format = v4l2_to_obs_video_format(data->pixfmt);
+
+	if (format == VIDEO_FORMAT_NONE)
+		return;
+
+	for (size_t i = 0; i < V4L2_FRAME_POOL_SIZE; i++) {
+		struct obs_source_frame *frame = obs_source_frame_create(format, data->width, data->height);
+
+		frame->flags = proto->flags;
+		frame->full_range = proto->full_range;
+		memcpy(frame->color_matrix, proto->color_matrix, sizeof(frame->color_matrix));
+		memcpy(frame->color_range_min, proto->color_range_min, sizeof(frame->color_range_min));
+		memcpy(frame->color_range_max, proto->color_range_max, sizeof(frame->color_range_max));
+		os_atomic_set_long(&frame->refs, 1);
+
+		data->frame_pool[i] = frame;
+	}
+}
+
+static struct obs_source_frame *v4l2_pool_acquire(struct v4l2_data *data)
+{
+	for (size_t i = 0; i < V4L2_FRAME_POOL_SIZE; i++) {
+		struct obs_source_frame *frame = data->frame_pool[i];
+
+		if (frame && os_atomic_load_long(&frame->refs) == 1)
+			return frame;
+	}
+
+	return NULL;
+}
+
+/* copies the capture buffer into a pooled frame row by row, since the
+ * driver linesize may include padding that the pooled frame does not */
+static void v4l2_fill_pool_frame(struct v4l2_data *data, const struct obs_source_frame *proto,
+				 struct obs_source_frame *frame, const uint8_t *start, const size_t *plane_offsets)
+{
+	for (size_t i = 0; i < MAX_AV_PLANES; i++) {
+		if (!proto->linesize[i] || !frame->data[i])
+			continue;
+
+		uint32_t rows = (i == 0) ? data->height : data->height / 2;
+		uint32_t bytes = proto->linesize[i] < frame->linesize[i] ? proto->linesize[i] : frame->linesize[i];
+		const uint8_t *src = start + plane_offsets[i];
+		uint8_t *dst = frame->data[i];
+
+		if (proto->linesize[i] == frame->linesize[i]) {
+			/* no padding mismatch, copy the plane in one go */
+			memcpy(dst, src, (size_t)bytes * rows);
+			continue;
+		}
+
+		for (uint32_t r = 0; r < rows; r++) {
+			memcpy(dst, src, bytes);
+			src += proto->linesize[i];
+			dst += frame->linesize[i];
+		}
+	}
+}
+
+static void v4l2_free_frame_pool(struct v4l2_data *data)
+{
+	bool active = false;
+
+	for (size_t i = 0; i < V4L2_FRAME_POOL_SIZE; i++)
+		active |= data->frame_pool[i] != NULL;
+	if (!active)
+		return;
+
+	/* flush frames still queued inside libobs so their references are
+	 * returned by the graphics thread */
+	obs_source_output_video(data->source, NULL);
+
+	for (int tries = 0; tries < 100; tries++) {
+		bool busy = false;
+
+		for (size_t i = 0; i < V4L2_FRAME_POOL_SIZE; i++) {
+			struct obs_source_frame *frame = data->frame_pool[i];
+			busy |= frame && os_atomic_load_long(&frame->refs) > 1;
+		}
+
+		if (!busy)
+			break;
+		os_sleep_ms(10);
+	}
+
+	for (size_t i = 0; i < V4L2_FRAME_POOL_SIZE; i++) {
+		struct obs_source_frame *frame = data->frame_pool[i];
+
+		if (!frame)
+			continue;
+		if (os_atomic_load_long(&frame->refs) > 1)
+			blog(LOG_WARNING, "%s: pooled frame still in use, leaking it", data->device_id);
+		else
+			obs_source_frame_destroy(frame);
+
+		data->frame_pool[i] = NULL;
+	}
+}
+
 /*
  * Worker thread to get video data
  */
@@ -194,6 +301,9 @@ static void *v4l2_thread(void *vptr)
 	first_ts = 0;
 	v4l2_prep_obs_frame(data, &out, plane_offsets);
 
+	if (data->pixfmt != V4L2_PIX_FMT_MJPEG && data->pixfmt != V4L2_PIX_FMT_H264)
+		v4l2_init_frame_pool(data, &out);
+
 	blog(LOG_DEBUG, "%s: obs frame prepared", data->device_id);
 
 	while (os_event_try(data->event) == EAGAIN) {
@@ -263,11 +373,20 @@ static void *v4l2_thread(void *vptr)
 				blog(LOG_ERROR, "failed to unpack jpeg or h264");
 				break;
 			}
+			obs_source_output_video(data->source, &out);
 		} else {
-			for (uint_fast32_t i = 0; i < MAX_AV_PLANES; ++i)
-				out.data[i] = start + plane_offsets[i];
+			struct obs_source_frame *pooled = v4l2_pool_acquire(data);
+
+			if (pooled) {
+				v4l2_fill_pool_frame(data, &out, pooled, start, plane_offsets);
+				pooled->timestamp = out.timestamp;
+				obs_source_output_video_take(data->source, pooled);
+			} else {
+				for (uint_fast32_t i = 0; i < MAX_AV_PLANES; ++i)
+					out.data[i] = start + plane_offsets[i];
+				obs_source_output_video(data->source, &out);
+			}
 		}
-		obs_source_output_video(data->source, &out);
 
 	continue_queue_buffer:
 		if (v4l2_ioctl(data->dev, VIDIOC_QBUF, &buf) < 0) {
@@ -836,6 +955,8 @@ static void v4l2_terminate(struct v4l2_data *data)
 		pthread_join(data->thread, NULL);
 		os_event_destroy(data->event);
 		data->thread = 0;
+
+		v4l2_free_frame_pool(data);
 	}
 
 	if (data->pixfmt == V4L2_PIX_FMT_MJPEG || data->pixfmt == V4L2_PIX_FMT_H264) {
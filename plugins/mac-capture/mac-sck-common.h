@@ -57,6 +57,9 @@ struct API_AVAILABLE(macos(12.5)) screen_capture {
     IOSurfaceRef current, prev;
     bool capture_failed;
 
+    uint64_t zero_copy_binds;
+    uint64_t failed_binds;
+
     pthread_mutex_t mutex;
 
     ScreenCaptureStreamType capture_type;
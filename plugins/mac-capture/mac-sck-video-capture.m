@@ -39,6 +39,13 @@ API_AVAILABLE(macos(12.5)) static void destroy_screen_stream(struct screen_captu
         sc->disp = NULL;
     }
 
+    if (sc->zero_copy_binds || sc->failed_binds) {
+        MACCAP_LOG(LOG_INFO, "stream stats: %llu zero-copy frames, %llu unbindable frames",
+                   (unsigned long long) sc->zero_copy_binds, (unsigned long long) sc->failed_binds);
+        sc->zero_copy_binds = 0;
+        sc->failed_binds = 0;
+    }
+
     os_event_destroy(sc->stream_start_completed);
 }
 
@@ -321,10 +328,24 @@ API_AVAILABLE(macos(12.5)) static void sck_video_capture_tick(void *data, float
         return;
 
     obs_enter_graphics();
-    if (sc->tex)
-        gs_texture_rebind_iosurface(sc->tex, sc->prev);
-    else
+    bool bound = false;
+    if (sc->tex) {
+        bound = gs_texture_rebind_iosurface(sc->tex, sc->prev);
+        if (!bound) {
+            /* the surface pixel format may have changed (e.g. SDR
+             * <-> EDR); recreate rather than showing a stale frame */
+            gs_texture_destroy(sc->tex);
+            sc->tex = gs_texture_create_from_iosurface(sc->prev);
+            bound = sc->tex != NULL;
+        }
+    } else {
         sc->tex = gs_texture_create_from_iosurface(sc->prev);
+        bound = sc->tex != NULL;
+    }
+    if (bound)
+        sc->zero_copy_binds++;
+    else
+        sc->failed_binds++;
     obs_leave_graphics();
 
     if (prev_prev) {
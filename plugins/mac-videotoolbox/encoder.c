@@ -45,6 +45,11 @@ bool is_apple_silicon = true;
 bool is_apple_silicon = false;
 #endif
 
+struct vt_submit_time {
+	int64_t pts;
+	uint64_t ts;
+};
+
 struct vt_encoder {
 	obs_encoder_t *encoder;
 
@@ -73,6 +78,14 @@ struct vt_encoder {
 	bool hw_enc;
 	DARRAY(uint8_t) packet_data;
 	DARRAY(uint8_t) extra_data;
+
+	/* pipeline latency accounting (submit -> sample ready), matching
+	 * the NVENC encoder's bookkeeping */
+	DARRAY(struct vt_submit_time) pending_submits;
+	uint64_t latency_total_ns;
+	uint64_t latency_max_ns;
+	uint64_t latency_frames;
+	uint64_t copy_total_ns;
 };
 
 static const char *codec_type_to_print_fmt(CMVideoCodecType codec_type)
@@ -623,8 +636,16 @@ static void vt_destroy(void *data)
 			VTCompressionSessionInvalidate(enc->session);
 			CFRelease(enc->session);
 		}
+		if (enc->latency_frames) {
+			VT_BLOG(LOG_INFO,
+				"encode latency: avg %llu us, max %llu us over %llu frames, %llu ms total copying "
+				"into pixel buffers",
+				enc->latency_total_ns / enc->latency_frames / 1000, enc->latency_max_ns / 1000,
+				enc->latency_frames, enc->copy_total_ns / 1000000);
+		}
 		da_free(enc->packet_data);
 		da_free(enc->extra_data);
+		da_free(enc->pending_submits);
 		bfree(enc);
 	}
 }
@@ -1016,6 +1037,22 @@ static bool parse_sample(struct vt_encoder *enc, CMSampleBufferRef buffer, struc
 	packet->type = OBS_ENCODER_VIDEO;
 	packet->pts = (int64_t)(CMTimeGetSeconds(pts));
 	packet->dts = (int64_t)(CMTimeGetSeconds(dts));
+
+	/* match this sample back to its submission; output is reordered
+	 * when B-frames are enabled, so search by pts */
+	for (size_t i = 0; i < enc->pending_submits.num; i++) {
+		const struct vt_submit_time *submit = &enc->pending_submits.array[i];
+		if (submit->pts != packet->pts)
+			continue;
+
+		const uint64_t latency = os_gettime_ns() - submit->ts;
+		enc->latency_total_ns += latency;
+		enc->latency_frames++;
+		if (latency > enc->latency_max_ns)
+			enc->latency_max_ns = latency;
+		da_erase(enc->pending_submits, i);
+		break;
+	}
 	packet->data = enc->packet_data.array;
 	packet->size = enc->packet_data.num;
 	packet->keyframe = keyframe;
@@ -1125,6 +1162,8 @@ static bool vt_encode(void *data, struct encoder_frame *frame, struct encoder_pa
 		goto fail;
 	}
 
+	const uint64_t copy_start = os_gettime_ns();
+
 	code = CVPixelBufferLockBaseAddress(pixbuf, 0);
 	if (code != noErr) {
 		goto fail;
@@ -1150,8 +1189,14 @@ static bool vt_encode(void *data, struct encoder_frame *frame, struct encoder_pa
 		goto fail;
 	}
 
+	enc->copy_total_ns += os_gettime_ns() - copy_start;
+
+	struct vt_submit_time submit = {frame->pts, os_gettime_ns()};
+	da_push_back(enc->pending_submits, &submit);
+
 	code = VTCompressionSessionEncodeFrame(enc->session, pixbuf, pts, dur, NULL, pixbuf, NULL);
 	if (code != noErr) {
+		da_pop_back(enc->pending_submits);
 		goto fail;
 	}
 
@@ -141,6 +141,10 @@ bool ffmpeg_hls_mux_start(void *data)
 		stream->keyint_sec = keyint_sec;
 	}
 
+	stream->hls_orig_bitrate = (long)obs_data_get_int(settings, "bitrate");
+	stream->hls_cur_bitrate = stream->hls_orig_bitrate;
+	stream->hls_bitrate_timeout = 0;
+
 	obs_data_release(settings);
 
 	start_pipe(stream, path.array);
@@ -236,6 +240,59 @@ void check_to_drop_frames(struct ffmpeg_muxer *stream, bool pframes)
 		drop_frames(stream, priority);
 }
 
+/* ------------------------------------------------------------------------- */
+/* memory-pressure bitrate feedback
+ *
+ * a slow upload backs the packet queue up long before the frame-drop
+ * threshold trips; halving the encoder bitrate at half that threshold
+ * lets the upload catch up instead of oscillating between buffering and
+ * dropping, and the bitrate walks back up once the backlog clears. */
+
+#define HLS_BITRATE_ADJUST_TIMEOUT_NS 10000000000ULL
+
+static void hls_apply_bitrate(struct ffmpeg_muxer *stream)
+{
+	obs_encoder_t *vencoder = obs_output_get_video_encoder(stream->output);
+	obs_data_t *settings = obs_encoder_get_settings(vencoder);
+
+	obs_data_set_int(settings, "bitrate", stream->hls_cur_bitrate);
+	obs_encoder_update(vencoder, settings);
+
+	obs_data_release(settings);
+}
+
+static void check_memory_pressure(struct ffmpeg_muxer *stream, int64_t buffer_duration_usec)
+{
+	int keyint_sec = stream->keyint_sec;
+	int64_t pressure_usec = (keyint_sec ? 2 * keyint_sec : 10) * 1000000LL / 2;
+	long min_bitrate = stream->hls_orig_bitrate / 4;
+	uint64_t now = os_gettime_ns();
+
+	if (!stream->hls_orig_bitrate)
+		return;
+
+	if (buffer_duration_usec > pressure_usec) {
+		if (stream->hls_cur_bitrate > min_bitrate && now >= stream->hls_bitrate_timeout) {
+			stream->hls_cur_bitrate /= 2;
+			if (stream->hls_cur_bitrate < min_bitrate)
+				stream->hls_cur_bitrate = min_bitrate;
+			stream->hls_bitrate_timeout = now + HLS_BITRATE_ADJUST_TIMEOUT_NS;
+			hls_apply_bitrate(stream);
+			warn("Upload falling behind (%d seconds buffered); "
+			     "bitrate lowered to %ld kbps",
+			     (int)(buffer_duration_usec / 1000000), stream->hls_cur_bitrate);
+		}
+	} else if (buffer_duration_usec < pressure_usec / 4 && stream->hls_cur_bitrate < stream->hls_orig_bitrate &&
+		   now >= stream->hls_bitrate_timeout) {
+		stream->hls_cur_bitrate += stream->hls_orig_bitrate / 10;
+		if (stream->hls_cur_bitrate > stream->hls_orig_bitrate)
+			stream->hls_cur_bitrate = stream->hls_orig_bitrate;
+		stream->hls_bitrate_timeout = now + HLS_BITRATE_ADJUST_TIMEOUT_NS;
+		hls_apply_bitrate(stream);
+		info("Upload backlog cleared; bitrate restored to %ld kbps", stream->hls_cur_bitrate);
+	}
+}
+
 static bool add_video_packet(struct ffmpeg_muxer *stream, struct encoder_packet *packet)
 {
 	check_to_drop_frames(stream, false);
@@ -277,6 +334,11 @@ void ffmpeg_hls_mux_data(void *data, struct encoder_packet *packet)
 
 	if (stopping(stream)) {
 		if (packet->sys_dts_usec >= stream->stop_ts) {
+			/* leave the encoder at its configured bitrate */
+			if (stream->hls_cur_bitrate && stream->hls_cur_bitrate != stream->hls_orig_bitrate) {
+				stream->hls_cur_bitrate = stream->hls_orig_bitrate;
+				hls_apply_bitrate(stream);
+			}
 			deactivate(stream, 0);
 			return;
 		}
@@ -295,15 +357,22 @@ void ffmpeg_hls_mux_data(void *data, struct encoder_packet *packet)
 	}
 	obs_encoder_packet_ref(&new_packet, packet);
 
+	int64_t buffer_duration_usec = 0;
+	struct encoder_packet first;
+
 	pthread_mutex_lock(&stream->write_mutex);
 
 	if (active(stream)) {
 		added_packet = (packet->type == OBS_ENCODER_VIDEO) ? add_video_packet(stream, &new_packet)
 								   : write_packet_to_buf(stream, &new_packet);
+		if (find_first_video_packet(stream, &first))
+			buffer_duration_usec = stream->last_dts_usec - first.dts_usec;
 	}
 
 	pthread_mutex_unlock(&stream->write_mutex);
 
+	check_memory_pressure(stream, buffer_duration_usec);
+
 	if (added_packet)
 		os_sem_post(stream->write_sem);
 	else
@@ -356,6 +356,128 @@ typedef int (*write_packet_cb)(void *, const uint8_t *, int);
 typedef int (*write_packet_cb)(void *, uint8_t *, int);
 #endif
 
+/* ------------------------------------------------------------------------- */
+/* pacing thread for SRT & RIST
+ *
+ * libsrt/librist sends can block for milliseconds under load; calling
+ * them from the mux thread stalls av_interleaved_write_frame() and
+ * shows up as PCR jitter at contribution bitrates.  the muxer instead
+ * queues timestamped TS chunks and a dedicated thread performs the
+ * actual sends. */
+
+struct mpegts_send_chunk {
+	uint64_t ts; /* enqueue time, for backlog diagnostics */
+	int size;
+	uint8_t data[];
+};
+
+/* several seconds of backlog at contribution bitrates; if the queue
+ * ever gets this deep the link is effectively dead */
+#define SEND_QUEUE_MAX_BYTES (32 * 1024 * 1024)
+#define SEND_BACKLOG_WARN_NS 500000000ULL
+
+static int paced_write(void *opaque, const uint8_t *buf, int size)
+{
+	struct ffmpeg_output *stream = opaque;
+	struct mpegts_send_chunk *chunk;
+
+	if (os_atomic_load_bool(&stream->send_error))
+		return AVERROR(EIO);
+
+	chunk = bmalloc(sizeof(*chunk) + size);
+	chunk->ts = os_gettime_ns();
+	chunk->size = size;
+	memcpy(chunk->data, buf, size);
+
+	pthread_mutex_lock(&stream->send_mutex);
+	if (stream->send_queue_bytes + (size_t)size > SEND_QUEUE_MAX_BYTES) {
+		pthread_mutex_unlock(&stream->send_mutex);
+		bfree(chunk);
+		warn("mpegts send queue overflowed; connection too slow");
+		os_atomic_set_bool(&stream->send_error, true);
+		return AVERROR(EIO);
+	}
+	deque_push_back(&stream->send_queue, &chunk, sizeof(chunk));
+	stream->send_queue_bytes += size;
+	pthread_mutex_unlock(&stream->send_mutex);
+
+	os_sem_post(stream->send_sem);
+	return size;
+}
+
+static void *mpegts_send_thread(void *data)
+{
+	struct ffmpeg_output *stream = data;
+
+	os_set_thread_name("obs-ffmpeg-mpegts: send thread");
+
+	while (os_sem_wait(stream->send_sem) == 0) {
+		struct mpegts_send_chunk *chunk = NULL;
+		bool stop = os_atomic_load_bool(&stream->send_stop);
+		int ret = 0;
+
+		pthread_mutex_lock(&stream->send_mutex);
+		if (stream->send_queue.size) {
+			deque_pop_front(&stream->send_queue, &chunk, sizeof(chunk));
+			stream->send_queue_bytes -= chunk->size;
+		}
+		pthread_mutex_unlock(&stream->send_mutex);
+
+		if (!chunk) {
+			if (stop)
+				break;
+			continue;
+		}
+
+		if (!os_atomic_load_bool(&stream->send_error)) {
+			uint64_t now = os_gettime_ns();
+
+			if (now - chunk->ts > SEND_BACKLOG_WARN_NS &&
+			    now - stream->last_send_warn_ns > 5 * SEND_BACKLOG_WARN_NS) {
+				stream->last_send_warn_ns = now;
+				warn("mpegts send backlog exceeds %d ms", (int)(SEND_BACKLOG_WARN_NS / 1000000));
+			}
+
+			if (stream->ff_data.config.is_rist)
+				ret = librist_write(stream->h, chunk->data, chunk->size);
+			else
+				ret = libsrt_write(stream->h, chunk->data, chunk->size);
+		}
+
+		bfree(chunk);
+
+		if (ret < 0)
+			os_atomic_set_bool(&stream->send_error, true);
+	}
+
+	return NULL;
+}
+
+/* joins the pacing thread after letting it drain the queue, then frees
+ * whatever could not be sent */
+static void stop_send_thread(struct ffmpeg_output *stream)
+{
+	if (!stream->send_thread_active)
+		return;
+
+	os_atomic_set_bool(&stream->send_stop, true);
+	os_sem_post(stream->send_sem);
+	pthread_join(stream->send_thread, NULL);
+	stream->send_thread_active = false;
+	os_atomic_set_bool(&stream->send_stop, false);
+	os_atomic_set_bool(&stream->send_error, false);
+
+	pthread_mutex_lock(&stream->send_mutex);
+	while (stream->send_queue.size) {
+		struct mpegts_send_chunk *chunk;
+		deque_pop_front(&stream->send_queue, &chunk, sizeof(chunk));
+		bfree(chunk);
+	}
+	deque_free(&stream->send_queue);
+	stream->send_queue_bytes = 0;
+	pthread_mutex_unlock(&stream->send_mutex);
+}
+
 static inline int allocate_custom_aviocontext(struct ffmpeg_output *stream, bool is_rist)
 {
 	/* allocate buffers */
@@ -369,20 +491,26 @@ static inline int allocate_custom_aviocontext(struct ffmpeg_output *stream, bool
 	buffer = av_malloc(buffer_size);
 	if (!buffer)
 		return AVERROR(ENOMEM);
-	/* allocate custom avio_context */
-	if (is_rist)
-		s = avio_alloc_context(buffer, buffer_size, AVIO_FLAG_WRITE, h, NULL, (write_packet_cb)librist_write,
-				       NULL);
-	else
-		s = avio_alloc_context(buffer, buffer_size, AVIO_FLAG_WRITE, h, NULL, (write_packet_cb)libsrt_write,
-				       NULL);
+	/* allocate custom avio_context; writes go through the pacing thread
+	 * rather than hitting librist/libsrt from the mux thread */
+	s = avio_alloc_context(buffer, buffer_size, AVIO_FLAG_WRITE, stream, NULL, (write_packet_cb)paced_write, NULL);
 	if (!s)
 		goto fail;
 	s->max_packet_size = h->max_packet_size;
-	s->opaque = h;
+	s->opaque = stream;
+
+	os_atomic_set_bool(&stream->send_stop, false);
+	os_atomic_set_bool(&stream->send_error, false);
+	if (pthread_create(&stream->send_thread, NULL, mpegts_send_thread, stream) != 0) {
+		avio_context_free(&s);
+		goto fail;
+	}
+	stream->send_thread_active = true;
+
 	stream->s = s;
 	stream->ff_data.output->pb = s;
 
+	UNUSED_PARAMETER(is_rist);
 	return 0;
 fail:
 	av_freep(&buffer);
@@ -502,9 +630,16 @@ static void close_mpegts_url(struct ffmpeg_output *stream, bool is_rist)
 {
 	int err = 0;
 	URLContext *h = stream->h;
+	AVIOContext *s = stream->s;
 	if (!h)
 		return; /* can happen when opening the url fails */
 
+	/* push buffered mux output into the send queue, then let the pacing
+	 * thread drain it before tearing the connection down */
+	if (s)
+		avio_flush(s);
+	stop_send_thread(stream);
+
 	/* close rist or srt URLs ; free URLContext */
 	if (is_rist) {
 		err = librist_close(h);
@@ -515,11 +650,9 @@ static void close_mpegts_url(struct ffmpeg_output *stream, bool is_rist)
 	av_freep(h);
 
 	/* close custom avio_context for srt or rist */
-	AVIOContext *s = stream->s;
 	if (!s)
 		return;
 
-	avio_flush(s);
 	s->opaque = NULL;
 	av_freep(&s->buffer);
 	avio_context_free(&s);
@@ -623,12 +756,18 @@ static void *ffmpeg_mpegts_create(obs_data_t *settings, obs_output_t *output)
 	pthread_mutex_init_value(&data->write_mutex);
 	data->output = output;
 
+	pthread_mutex_init_value(&data->send_mutex);
+
 	if (pthread_mutex_init(&data->write_mutex, NULL) != 0)
 		goto fail;
+	if (pthread_mutex_init(&data->send_mutex, NULL) != 0)
+		goto fail;
 	if (os_event_init(&data->stop_event, OS_EVENT_TYPE_AUTO) != 0)
 		goto fail;
 	if (os_sem_init(&data->write_sem, 0) != 0)
 		goto fail;
+	if (os_sem_init(&data->send_sem, 0) != 0)
+		goto fail;
 
 	av_log_set_callback(ffmpeg_mpegts_log_callback);
 
@@ -637,6 +776,8 @@ static void *ffmpeg_mpegts_create(obs_data_t *settings, obs_output_t *output)
 
 fail:
 	pthread_mutex_destroy(&data->write_mutex);
+	pthread_mutex_destroy(&data->send_mutex);
+	os_sem_destroy(data->write_sem);
 	os_event_destroy(data->stop_event);
 	bfree(data);
 	return NULL;
@@ -654,8 +795,11 @@ static void ffmpeg_mpegts_destroy(void *data)
 		if (output->connecting)
 			pthread_join(output->start_thread, NULL);
 
+		stop_send_thread(output);
 		pthread_mutex_destroy(&output->write_mutex);
+		pthread_mutex_destroy(&output->send_mutex);
 		os_sem_destroy(output->write_sem);
+		os_sem_destroy(output->send_sem);
 		os_event_destroy(output->stop_event);
 		bfree(data);
 	}
@@ -46,13 +46,22 @@ static const char *ffmpeg_mpegts_mux_getname(void *type)
 
 static inline void replay_buffer_clear(struct ffmpeg_muxer *stream)
 {
-	while (stream->packets.size > 0) {
-		struct encoder_packet pkt;
-		deque_pop_front(&stream->packets, &pkt, sizeof(pkt));
-		obs_encoder_packet_release(&pkt);
+	/* slab-backed replay records hold no packet references; everything
+	 * else in the deque is refcounted encoder packets */
+	if (!stream->slab) {
+		while (stream->packets.size > 0) {
+			struct encoder_packet pkt;
+			deque_pop_front(&stream->packets, &pkt, sizeof(pkt));
+			obs_encoder_packet_release(&pkt);
+		}
 	}
 
 	deque_free(&stream->packets);
+	bfree(stream->slab);
+	stream->slab = NULL;
+	stream->slab_size = 0;
+	stream->slab_head = 0;
+	stream->slab_start = 0;
 	stream->cur_size = 0;
 	stream->cur_time = 0;
 	stream->max_size = 0;
@@ -72,6 +81,7 @@ static void ffmpeg_mux_destroy(void *data)
 		obs_encoder_packet_release(&stream->mux_packets.array[i]);
 	da_free(stream->mux_packets);
 	deque_free(&stream->packets);
+	da_free(stream->stage);
 
 	os_process_pipe_destroy(stream->pipe);
 	dstr_free(&stream->path);
@@ -466,6 +476,10 @@ int deactivate(struct ffmpeg_muxer *stream, int code)
 	}
 
 	if (active(stream)) {
+		/* best effort: hand any batched packets to the mux process
+		 * before closing its stdin */
+		stage_flush(stream);
+
 		ret = os_process_pipe_destroy(stream->pipe);
 		stream->pipe = NULL;
 
@@ -600,10 +614,28 @@ static void generate_filename(struct ffmpeg_muxer *stream, struct dstr *dst, boo
 	obs_data_release(settings);
 }
 
+/* how many staged bytes to accumulate before writing to the mux process;
+ * one pipe write then carries dozens of packets' worth of headers and
+ * payloads instead of two syscalls per packet */
+#define STAGE_FLUSH_SIZE (256 * 1024)
+
+static bool stage_flush(struct ffmpeg_muxer *stream)
+{
+	size_t size = stream->stage.num;
+	size_t ret;
+
+	if (!size)
+		return true;
+
+	ret = os_process_pipe_write(stream->pipe, stream->stage.array, size);
+	da_clear(stream->stage);
+
+	return ret == size;
+}
+
 bool write_packet(struct ffmpeg_muxer *stream, struct encoder_packet *packet)
 {
 	bool is_video = packet->type == OBS_ENCODER_VIDEO;
-	size_t ret;
 
 	struct ffm_packet_info info = {.pts = packet->pts,
 				       .dts = packet->dts,
@@ -622,18 +654,15 @@ bool write_packet(struct ffmpeg_muxer *stream, struct encoder_packet *packet)
 		}
 	}
 
-	ret = os_process_pipe_write(stream->pipe, (const uint8_t *)&info, sizeof(info));
-	if (ret != sizeof(info)) {
-		warn("os_process_pipe_write for info structure failed");
-		signal_failure(stream);
-		return false;
-	}
+	da_push_back_array(stream->stage, (const uint8_t *)&info, sizeof(info));
+	da_push_back_array(stream->stage, packet->data, packet->size);
 
-	ret = os_process_pipe_write(stream->pipe, packet->data, packet->size);
-	if (ret != packet->size) {
-		warn("os_process_pipe_write for packet data failed");
-		signal_failure(stream);
-		return false;
+	if (stream->is_network || stream->stage.num >= STAGE_FLUSH_SIZE) {
+		if (!stage_flush(stream)) {
+			warn("os_process_pipe_write for packet data failed");
+			signal_failure(stream);
+			return false;
+		}
 	}
 
 	stream->total_bytes += packet->size;
@@ -711,20 +740,15 @@ static inline bool should_split(struct ffmpeg_muxer *stream, struct encoder_pack
 
 static bool send_new_filename(struct ffmpeg_muxer *stream, const char *filename)
 {
-	size_t ret;
 	uint32_t size = (uint32_t)strlen(filename);
 	struct ffm_packet_info info = {.type = FFM_PACKET_CHANGE_FILE, .size = size};
 
-	ret = os_process_pipe_write(stream->pipe, (const uint8_t *)&info, sizeof(info));
-	if (ret != sizeof(info)) {
-		warn("os_process_pipe_write for info structure failed");
-		signal_failure(stream);
-		return false;
-	}
+	/* staged like packet data so it stays ordered with pending writes */
+	da_push_back_array(stream->stage, (const uint8_t *)&info, sizeof(info));
+	da_push_back_array(stream->stage, (const uint8_t *)filename, size);
 
-	ret = os_process_pipe_write(stream->pipe, (const uint8_t *)filename, size);
-	if (ret != size) {
-		warn("os_process_pipe_write for packet data failed");
+	if (!stage_flush(stream)) {
+		warn("os_process_pipe_write for new file name failed");
 		signal_failure(stream);
 		return false;
 	}
@@ -996,9 +1020,81 @@ static bool replay_buffer_start(void *data)
 	return true;
 }
 
+#define REPLAY_SLAB_MIN_SIZE (1024 * 1024)
+
+/* Grows the slab and linearizes the ring into it, so that after growth the
+ * retained payloads occupy [0, cur_size) and new data can be appended. */
+static void replay_slab_grow(struct ffmpeg_muxer *stream, size_t need)
+{
+	const size_t rec_size = sizeof(struct replay_packet);
+	size_t required = (size_t)stream->cur_size + need;
+	size_t new_size = stream->slab_size ? stream->slab_size * 2 : REPLAY_SLAB_MIN_SIZE;
+	size_t num = stream->packets.size / rec_size;
+	uint8_t *new_slab;
+	size_t pos = 0;
+
+	while (new_size < required)
+		new_size *= 2;
+
+	new_slab = bmalloc(new_size);
+
+	for (size_t i = 0; i < num; i++) {
+		struct replay_packet *rec = deque_data(&stream->packets, i * rec_size);
+
+		memcpy(new_slab + pos, stream->slab + rec->slab_offset, rec->info.size);
+		rec->slab_offset = pos;
+		pos += rec->info.size;
+	}
+
+	bfree(stream->slab);
+	stream->slab = new_slab;
+	stream->slab_size = new_size;
+	stream->slab_start = 0;
+	stream->slab_head = pos;
+}
+
+/* Reserves space for one payload in the slab ring.  Payloads never straddle
+ * the end of the slab; when the tail does not fit, allocation wraps to the
+ * front and the tail bytes stay unused until the wrapped-past records are
+ * evicted. */
+static size_t replay_slab_reserve(struct ffmpeg_muxer *stream, size_t size)
+{
+	size_t offset;
+
+	if (!stream->packets.size) {
+		if (size > stream->slab_size || !stream->slab)
+			replay_slab_grow(stream, size);
+		stream->slab_start = 0;
+		stream->slab_head = size;
+		return 0;
+	}
+
+	if (stream->slab_head > stream->slab_start) {
+		if (stream->slab_size - stream->slab_head >= size) {
+			offset = stream->slab_head;
+			stream->slab_head += size;
+			return offset;
+		}
+		if (stream->slab_start > size) {
+			stream->slab_head = size;
+			return 0;
+		}
+	} else if (stream->slab_head < stream->slab_start && stream->slab_start - stream->slab_head > size) {
+		offset = stream->slab_head;
+		stream->slab_head += size;
+		return offset;
+	}
+
+	replay_slab_grow(stream, size);
+
+	offset = stream->slab_head;
+	stream->slab_head += size;
+	return offset;
+}
+
 static bool purge_front(struct ffmpeg_muxer *stream)
 {
-	struct encoder_packet pkt;
+	struct replay_packet pkt;
 	bool keyframe;
 
 	if (!stream->packets.size)
@@ -1006,7 +1102,7 @@ static bool purge_front(struct ffmpeg_muxer *stream)
 
 	deque_pop_front(&stream->packets, &pkt, sizeof(pkt));
 
-	keyframe = pkt.type == OBS_ENCODER_VIDEO && pkt.keyframe;
+	keyframe = pkt.info.type == OBS_ENCODER_VIDEO && pkt.info.keyframe;
 
 	if (keyframe)
 		stream->keyframes--;
@@ -1014,27 +1110,29 @@ static bool purge_front(struct ffmpeg_muxer *stream)
 	if (!stream->packets.size) {
 		stream->cur_size = 0;
 		stream->cur_time = 0;
+		stream->slab_start = 0;
+		stream->slab_head = 0;
 	} else {
-		struct encoder_packet first;
+		struct replay_packet first;
 		deque_peek_front(&stream->packets, &first, sizeof(first));
-		stream->cur_time = first.dts_usec;
-		stream->cur_size -= (int64_t)pkt.size;
+		stream->cur_time = first.info.dts_usec;
+		stream->cur_size -= (int64_t)pkt.info.size;
+		stream->slab_start = first.slab_offset;
 	}
 
-	obs_encoder_packet_release(&pkt);
 	return keyframe;
 }
 
 static inline void purge(struct ffmpeg_muxer *stream)
 {
 	if (purge_front(stream)) {
-		struct encoder_packet pkt;
+		struct replay_packet pkt;
 
 		for (;;) {
 			if (!stream->packets.size)
 				return;
 			deque_peek_front(&stream->packets, &pkt, sizeof(pkt));
-			if (pkt.type == OBS_ENCODER_VIDEO && pkt.keyframe)
+			if (pkt.info.type == OBS_ENCODER_VIDEO && pkt.info.keyframe)
 				return;
 
 			purge_front(stream);
@@ -1065,7 +1163,11 @@ static void insert_packet(mux_packets_t *packets, struct encoder_packet *packet,
 	struct encoder_packet pkt;
 	size_t idx;
 
-	obs_encoder_packet_ref(&pkt, packet);
+	/* copy out of the slab: the ring keeps filling (and overwriting)
+	 * while the mux thread writes the saved packets.  these copies are
+	 * not refcounted; the mux thread bfrees them after writing */
+	pkt = *packet;
+	pkt.data = bmemdup(packet->data, packet->size);
 
 	if (pkt.type == OBS_ENCODER_VIDEO) {
 		pkt.dts_usec -= video_offset;
@@ -1112,7 +1214,14 @@ static void *replay_buffer_mux_thread(void *data)
 			error = true;
 			goto error;
 		}
-		obs_encoder_packet_release(pkt);
+		bfree(pkt->data);
+		pkt->data = NULL;
+	}
+
+	if (!stage_flush(stream)) {
+		warn("Could not write packet for file '%s'", stream->path.array);
+		error = true;
+		goto error;
 	}
 
 	info("Wrote replay buffer to '%s'", stream->path.array);
@@ -1122,7 +1231,7 @@ error:
 	stream->pipe = NULL;
 	if (error) {
 		for (size_t i = 0; i < stream->mux_packets.num; i++)
-			obs_encoder_packet_release(&stream->mux_packets.array[i]);
+			bfree(stream->mux_packets.array[i].data);
 	}
 	da_free(stream->mux_packets);
 	os_atomic_set_bool(&stream->muxing, false);
@@ -1138,7 +1247,7 @@ error:
 
 static void replay_buffer_save(struct ffmpeg_muxer *stream)
 {
-	const size_t size = sizeof(struct encoder_packet);
+	const size_t size = sizeof(struct replay_packet);
 	size_t num_packets = stream->packets.size / size;
 
 	da_reserve(stream->mux_packets, num_packets);
@@ -1154,8 +1263,11 @@ static void replay_buffer_save(struct ffmpeg_muxer *stream)
 	int64_t audio_dts_offsets[MAX_AUDIO_MIXES] = {0};
 
 	for (size_t i = 0; i < num_packets; i++) {
-		struct encoder_packet *pkt;
-		pkt = deque_data(&stream->packets, i * size);
+		struct replay_packet *rec = deque_data(&stream->packets, i * size);
+		struct encoder_packet stored = rec->info;
+		struct encoder_packet *pkt = &stored;
+
+		pkt->data = stream->slab + rec->slab_offset;
 
 		if (pkt->type == OBS_ENCODER_VIDEO) {
 			if (!found_video) {
@@ -1202,7 +1314,7 @@ static void deactivate_replay_buffer(struct ffmpeg_muxer *stream, int code)
 static void replay_buffer_data(void *data, struct encoder_packet *packet)
 {
 	struct ffmpeg_muxer *stream = data;
-	struct encoder_packet pkt;
+	struct replay_packet rec;
 
 	if (!active(stream))
 		return;
@@ -1220,14 +1332,21 @@ static void replay_buffer_data(void *data, struct encoder_packet *packet)
 		}
 	}
 
-	obs_encoder_packet_ref(&pkt, packet);
-	replay_buffer_purge(stream, &pkt);
+	replay_buffer_purge(stream, packet);
+
+	/* copy the payload into the slab instead of holding a reference, so
+	 * the encoder's buffer is returned immediately and retained data
+	 * lives in one allocation */
+	rec.info = *packet;
+	rec.info.data = NULL;
+	rec.slab_offset = replay_slab_reserve(stream, packet->size);
+	memcpy(stream->slab + rec.slab_offset, packet->data, packet->size);
 
 	if (!stream->packets.size)
-		stream->cur_time = pkt.dts_usec;
-	stream->cur_size += pkt.size;
+		stream->cur_time = packet->dts_usec;
+	stream->cur_size += (int64_t)packet->size;
 
-	deque_push_back(&stream->packets, packet, sizeof(*packet));
+	deque_push_back(&stream->packets, &rec, sizeof(rec));
 
 	if (packet->type == OBS_ENCODER_VIDEO && packet->keyframe)
 		stream->keyframes++;
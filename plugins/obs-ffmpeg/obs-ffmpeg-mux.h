@@ -11,6 +11,13 @@
 
 typedef DARRAY(struct encoder_packet) mux_packets_t;
 
+/* replay ring record: the payload lives in the replay slab at slab_offset,
+ * so info.data is not meaningful while the record is stored */
+struct replay_packet {
+	struct encoder_packet info;
+	size_t slab_offset;
+};
+
 struct ffmpeg_muxer {
 	obs_output_t *output;
 	os_process_pipe_t *pipe;
@@ -38,6 +45,14 @@ struct ffmpeg_muxer {
 	volatile bool muxing;
 	mux_packets_t mux_packets;
 
+	/* replay slab: one ring allocation backing all retained payloads,
+	 * so the hot path does no per-packet allocation and eviction is
+	 * just an offset bump */
+	uint8_t *slab;
+	size_t slab_size;
+	size_t slab_head;
+	size_t slab_start;
+
 	/* split file */
 	bool found_video;
 	bool found_audio[MAX_AUDIO_MIXES];
@@ -61,6 +76,17 @@ struct ffmpeg_muxer {
 	int min_priority;
 	int64_t last_dts_usec;
 
+	/* memory-pressure bitrate feedback (HLS only) */
+	long hls_orig_bitrate;
+	long hls_cur_bitrate;
+	uint64_t hls_bitrate_timeout;
+
+	/* write staging: packet headers and payloads are coalesced here and
+	 * handed to the mux process in one large pipe write instead of two
+	 * small ones per packet (see stage_flush()).  file outputs batch
+	 * multiple packets per write; network outputs flush every packet */
+	DARRAY(uint8_t) stage;
+
 	bool is_network;
 	bool split_file;
 	bool allow_overwrite;
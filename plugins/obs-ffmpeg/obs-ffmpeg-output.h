@@ -114,6 +114,17 @@ struct ffmpeg_output {
 	URLContext *h;
 	AVIOContext *s;
 	bool got_headers;
+
+	/* pacing thread: decouples the muxer from blocking protocol sends */
+	bool send_thread_active;
+	pthread_t send_thread;
+	pthread_mutex_t send_mutex;
+	os_sem_t *send_sem;
+	struct deque send_queue; /* struct mpegts_send_chunk * */
+	size_t send_queue_bytes;
+	uint64_t last_send_warn_ns;
+	volatile bool send_stop;
+	volatile bool send_error;
 #endif
 };
 bool ffmpeg_data_init(struct ffmpeg_data *data, struct ffmpeg_cfg *config);
@@ -312,6 +312,8 @@ static void ffmpeg_source_open(struct ffmpeg_source *s)
 		};
 
 		s->media = media_playback_create(&info);
+		if (s->media)
+			media_playback_set_decode_priority(s->media, obs_source_active(s->source));
 	}
 }
 
@@ -655,6 +657,8 @@ static void ffmpeg_source_activate(void *data)
 {
 	struct ffmpeg_source *s = data;
 
+	media_playback_set_decode_priority(s->media, true);
+
 	if (s->restart_on_activate)
 		obs_source_media_restart(s->source);
 }
@@ -663,6 +667,8 @@ static void ffmpeg_source_deactivate(void *data)
 {
 	struct ffmpeg_source *s = data;
 
+	media_playback_set_decode_priority(s->media, false);
+
 	if (s->restart_on_activate) {
 		if (s->media) {
 			media_playback_stop(s->media);
@@ -770,12 +776,10 @@ static obs_missing_files_t *ffmpeg_source_missingfiles(void *data)
 	obs_missing_files_t *files = obs_missing_files_create();
 
 	if (s->is_local_file && strcmp(s->input, "") != 0) {
-		if (!os_file_exists(s->input)) {
-			obs_missing_file_t *file = obs_missing_file_create(s->input, missing_file_callback,
-									   OBS_MISSING_FILE_SOURCE, s->source, NULL);
+		obs_missing_file_t *file = obs_missing_file_create(s->input, missing_file_callback,
+								   OBS_MISSING_FILE_SOURCE, s->source, NULL);
 
-			obs_missing_files_add_file(files, file);
-		}
+		obs_missing_files_add_file_checked(files, file);
 	}
 
 	return files;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <util/sse-intrin.h>
+
+/* Shared helpers for the audio DSP filters (compressor, expander,
+ * limiter): block application of per-sample gain buffers four floats at
+ * a time via SSE (simde on non-x86 targets), plus flush-to-zero control
+ * so envelope feedback paths do not hit the denormal slow path. */
+
+#ifndef _MM_FLUSH_ZERO_ON
+#define _MM_FLUSH_ZERO_ON 0x8000
+#endif
+
+/* disables denormals for the calling thread and returns the previous
+ * control word; pair with audio_dsp_restore_denormals */
+static inline uint32_t audio_dsp_disable_denormals(void)
+{
+	const uint32_t csr = _mm_getcsr();
+	_mm_setcsr(csr | _MM_FLUSH_ZERO_ON);
+	return csr;
+}
+
+static inline void audio_dsp_restore_denormals(uint32_t csr)
+{
+	_mm_setcsr(csr);
+}
+
+/* samples[i] *= gain[i] */
+static inline void audio_dsp_apply_gain_buf(float *samples, const float *gain, uint32_t num)
+{
+	uint32_t i = 0;
+
+	for (; i + 4 <= num; i += 4) {
+		const __m128 s = _mm_loadu_ps(&samples[i]);
+		const __m128 g = _mm_loadu_ps(&gain[i]);
+		_mm_storeu_ps(&samples[i], _mm_mul_ps(s, g));
+	}
+	for (; i < num; i++)
+		samples[i] *= gain[i];
+}
+
+/* samples[i] = isfinite(samples[i]) ? samples[i] * gain[i] : 0.0f */
+static inline void audio_dsp_apply_gain_buf_safe(float *samples, const float *gain, uint32_t num)
+{
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 inf = _mm_castsi128_ps(_mm_set1_epi32(0x7F800000));
+	uint32_t i = 0;
+
+	for (; i + 4 <= num; i += 4) {
+		const __m128 s = _mm_loadu_ps(&samples[i]);
+		const __m128 g = _mm_loadu_ps(&gain[i]);
+		const __m128 finite = _mm_cmplt_ps(_mm_and_ps(s, abs_mask), inf);
+		_mm_storeu_ps(&samples[i], _mm_and_ps(_mm_mul_ps(s, g), finite));
+	}
+	for (; i < num; i++)
+		samples[i] = isfinite(samples[i]) ? samples[i] * gain[i] : 0.0f;
+}
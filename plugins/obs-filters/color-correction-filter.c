@@ -74,6 +74,7 @@ struct color_correction_filter_data_v2 {
 	gs_eparam_t *final_matrix_param;
 
 	float gamma;
+	bool identity;
 
 	/* Pre-Computes */
 	struct matrix4 con_matrix;
@@ -389,6 +390,16 @@ static void color_correction_filter_update_v2(void *data, obs_data_t *settings)
 	matrix4_mul(&filter->final_matrix, &filter->final_matrix, &filter->hue_op_matrix);
 	/* Lastly we apply the Color Wash matrix. */
 	matrix4_mul(&filter->final_matrix, &filter->final_matrix, &filter->color_matrix);
+
+	/*
+	 * With everything at defaults the final matrix is exactly the
+	 * identity and gamma is exactly 1.0; remember that so the render
+	 * function can skip the pass (and its render target) entirely.
+	 */
+	struct matrix4 identity_matrix;
+	matrix4_identity(&identity_matrix);
+	filter->identity =
+		filter->gamma == 1.0f && memcmp(&filter->final_matrix, &identity_matrix, sizeof(identity_matrix)) == 0;
 }
 
 /*
@@ -578,6 +589,12 @@ static void color_correction_filter_render_v2(void *data, gs_effect_t *effect)
 		GS_CS_709_EXTENDED,
 	};
 
+	/* A no-op correction doesn't deserve a render pass. */
+	if (filter->identity) {
+		obs_source_skip_video_filter(filter->context);
+		return;
+	}
+
 	const enum gs_color_space source_space = obs_source_get_color_space(
 		obs_filter_get_target(filter->context), OBS_COUNTOF(preferred_spaces), preferred_spaces);
 	if (source_space == GS_CS_709_EXTENDED) {
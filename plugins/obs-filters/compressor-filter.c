@@ -8,6 +8,8 @@
 #include <util/deque.h>
 #include <util/threading.h>
 
+#include "audio-dsp.h"
+
 /* -------------------------------------------------------- */
 
 #define do_log(level, format, ...) \
@@ -355,16 +357,27 @@ static void analyze_sidechain(struct compressor_data *cd, const uint32_t num_sam
 
 static inline void process_compression(const struct compressor_data *cd, float **samples, uint32_t num_samples)
 {
-	for (size_t i = 0; i < num_samples; ++i) {
-		const float env_db = mul_to_db(cd->envelope_buf[i]);
-		float gain = cd->slope * (cd->threshold - env_db);
-		gain = db_to_mul(fminf(0, gain));
-
-		for (size_t c = 0; c < cd->num_channels; ++c) {
-			if (samples[c]) {
-				samples[c][i] *= gain * cd->output_gain;
-			}
+	float *gain_buf = cd->envelope_buf;
+	const float threshold_mul = db_to_mul(cd->threshold);
+	const float output_gain = cd->output_gain;
+
+	/* convert the envelope into a gain in place; below the threshold
+	 * the compressor leaves the signal untouched, so the expensive dB
+	 * round-trip only runs for samples actually over the threshold */
+	for (uint32_t i = 0; i < num_samples; ++i) {
+		float gain = output_gain;
+
+		if (gain_buf[i] > threshold_mul) {
+			const float env_db = mul_to_db(gain_buf[i]);
+			gain = db_to_mul(fminf(0, cd->slope * (cd->threshold - env_db))) * output_gain;
 		}
+
+		gain_buf[i] = gain;
+	}
+
+	for (size_t c = 0; c < cd->num_channels; ++c) {
+		if (samples[c])
+			audio_dsp_apply_gain_buf(samples[c], gain_buf, num_samples);
 	}
 }
 
@@ -426,12 +439,16 @@ static struct obs_audio_data *compressor_filter_audio(void *data, struct obs_aud
 	obs_weak_source_t *weak_sidechain = cd->weak_sidechain;
 	pthread_mutex_unlock(&cd->sidechain_update_mutex);
 
+	const uint32_t csr = audio_dsp_disable_denormals();
+
 	if (weak_sidechain)
 		analyze_sidechain(cd, num_samples);
 	else
 		analyze_envelope(cd, samples, num_samples);
 
 	process_compression(cd, samples, num_samples);
+
+	audio_dsp_restore_denormals(csr);
 	return audio;
 }
 
@@ -5,6 +5,8 @@
 
 #include <math.h>
 
+#include "audio-dsp.h"
+
 #define LOW_FREQ 800.0f
 #define HIGH_FREQ 5000.0f
 
@@ -131,6 +133,12 @@ static struct obs_audio_data *eq_filter_audio(void *data, struct obs_audio_data
 	struct eq_data *eq = data;
 	const uint32_t frames = audio->frames;
 
+	/* the delay lines are a serial dependency chain, so this stays
+	 * scalar; flushing denormals keeps the decaying feedback paths off
+	 * the FPU slow path (the epsilon above only protects the first
+	 * stage of each band) */
+	const uint32_t csr = audio_dsp_disable_denormals();
+
 	for (size_t c = 0; c < eq->channels; c++) {
 		float *adata = (float *)audio->data[c];
 		struct eq_channel_state *channel = &eq->eqs[c];
@@ -140,6 +148,7 @@ static struct obs_audio_data *eq_filter_audio(void *data, struct obs_audio_data
 		}
 	}
 
+	audio_dsp_restore_denormals(csr);
 	return audio;
 }
 
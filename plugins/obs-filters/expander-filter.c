@@ -8,6 +8,8 @@
 #include <util/deque.h>
 #include <util/threading.h>
 
+#include "audio-dsp.h"
+
 /* -------------------------------------------------------- */
 
 #define do_log(level, format, ...) \
@@ -364,7 +366,11 @@ static inline void process_sample(size_t idx, float *samples, float *env_buf, fl
 	/* --------------------------------- */
 	/* output                            */
 
-	if (!is_upwcomp) {
+	/* a fully released gain stage is the common case once the signal
+	 * sits above the threshold; skip the dB conversion for it */
+	if (gain_db[idx] == 0.0f) {
+		gain = 1.0f;
+	} else if (!is_upwcomp) {
 		gain = db_to_mul(fminf(0, gain_db[idx]));
 	} else {
 		gain = db_to_mul(gain_db[idx]);
@@ -416,8 +422,12 @@ static struct obs_audio_data *expander_filter_audio(void *data, struct obs_audio
 
 	float **samples = (float **)audio->data;
 
+	const uint32_t csr = audio_dsp_disable_denormals();
+
 	analyze_envelope(cd, samples, num_samples);
 	process_expansion(cd, samples, num_samples);
+
+	audio_dsp_restore_denormals(csr);
 	return audio;
 }
 
@@ -3,21 +3,30 @@
 #include <util/util_uint64.h>
 
 #define S_DELAY_MS "delay_ms"
+#define S_VRAM_BUDGET_MB "vram_budget_mb"
 #define T_DELAY_MS obs_module_text("DelayMs")
+#define T_VRAM_BUDGET_MB obs_module_text("DelayVramBudget")
 
 struct frame {
 	gs_texrender_t *render;
+	gs_texrender_t *render_y;
+	gs_texrender_t *render_uv;
+	bool compressed;
 	enum gs_color_space space;
 	uint64_t ts;
 };
 
 struct gpu_delay_filter_data {
 	obs_source_t *context;
+	gs_effect_t *pack_effect;
+	gs_texrender_t *scratch;
 	struct deque frames;
 	uint64_t delay_ns;
 	uint64_t interval_ns;
 	uint32_t cx;
 	uint32_t cy;
+	uint32_t vram_budget_mb;
+	bool subsample;
 	bool target_valid;
 	bool processed_frame;
 };
@@ -28,13 +37,21 @@ static const char *gpu_delay_filter_get_name(void *unused)
 	return obs_module_text("GPUDelayFilter");
 }
 
+static void free_frame(struct frame *frame)
+{
+	gs_texrender_destroy(frame->render);
+	gs_texrender_destroy(frame->render_y);
+	gs_texrender_destroy(frame->render_uv);
+	memset(frame, 0, sizeof(*frame));
+}
+
 static void free_textures(struct gpu_delay_filter_data *f)
 {
 	obs_enter_graphics();
 	while (f->frames.size) {
 		struct frame frame;
 		deque_pop_front(&f->frames, &frame, sizeof(frame));
-		gs_texrender_destroy(frame.render);
+		free_frame(&frame);
 	}
 	deque_free(&f->frames);
 	obs_leave_graphics();
@@ -55,19 +72,33 @@ static void update_interval(struct gpu_delay_filter_data *f, uint64_t new_interv
 	f->interval_ns = new_interval_ns;
 	size_t num = (size_t)(f->delay_ns / new_interval_ns);
 
-	if (num > num_frames(&f->frames)) {
-		size_t prev_num = num_frames(&f->frames);
-
-		obs_enter_graphics();
-
-		deque_upsize(&f->frames, num * sizeof(struct frame));
-
-		for (size_t i = prev_num; i < num; i++) {
-			struct frame *frame = deque_data(&f->frames, i * sizeof(*frame));
-			frame->render = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+	/* Full-precision frames cost 4 bytes per pixel, 4:2:0 subsampled
+	 * frames 1.5; when the full-precision ring would exceed the VRAM
+	 * budget, subsample SDR frames, and clamp the ring as a last
+	 * resort. */
+	const uint64_t budget = (uint64_t)f->vram_budget_mb << 20;
+	const uint64_t pixels = (uint64_t)f->cx * f->cy;
+	f->subsample = false;
+
+	if (num && pixels) {
+		if (num * pixels * 4 > budget && f->pack_effect)
+			f->subsample = true;
+
+		const uint64_t frame_cost = f->subsample ? pixels * 3 / 2 : pixels * 4;
+		if (num * frame_cost > budget) {
+			const size_t max_num = (size_t)(budget / frame_cost);
+			blog(LOG_WARNING,
+			     "gpu_delay: %u MB budget only fits %zu of "
+			     "%zu delayed frames at %ux%u",
+			     (unsigned)f->vram_budget_mb, max_num, num, (unsigned)f->cx, (unsigned)f->cy);
+			num = max_num;
 		}
+	}
 
-		obs_leave_graphics();
+	if (num > num_frames(&f->frames)) {
+		/* new slots are zero-filled; textures are created on first
+		 * insert so that the mode (full vs. subsampled) is known */
+		deque_upsize(&f->frames, num * sizeof(struct frame));
 
 	} else if (num < num_frames(&f->frames)) {
 		obs_enter_graphics();
@@ -75,7 +106,7 @@ static void update_interval(struct gpu_delay_filter_data *f, uint64_t new_interv
 		while (num_frames(&f->frames) > num) {
 			struct frame frame;
 			deque_pop_front(&f->frames, &frame, sizeof(frame));
-			gs_texrender_destroy(frame.render);
+			free_frame(&frame);
 		}
 
 		obs_leave_graphics();
@@ -134,6 +165,7 @@ static void gpu_delay_filter_update(void *data, obs_data_t *s)
 	struct gpu_delay_filter_data *f = data;
 
 	f->delay_ns = (uint64_t)obs_data_get_int(s, S_DELAY_MS) * 1000000ULL;
+	f->vram_budget_mb = (uint32_t)obs_data_get_int(s, S_VRAM_BUDGET_MB);
 
 	/* full reset */
 	f->cx = 0;
@@ -142,13 +174,21 @@ static void gpu_delay_filter_update(void *data, obs_data_t *s)
 	free_textures(f);
 }
 
+static void gpu_delay_filter_defaults(obs_data_t *settings)
+{
+	obs_data_set_default_int(settings, S_VRAM_BUDGET_MB, 2048);
+}
+
 static obs_properties_t *gpu_delay_filter_properties(void *data)
 {
 	obs_properties_t *props = obs_properties_create();
 
-	obs_property_t *p = obs_properties_add_int(props, S_DELAY_MS, T_DELAY_MS, 0, 500, 1);
+	obs_property_t *p = obs_properties_add_int(props, S_DELAY_MS, T_DELAY_MS, 0, 4000, 1);
 	obs_property_int_set_suffix(p, " ms");
 
+	p = obs_properties_add_int(props, S_VRAM_BUDGET_MB, T_VRAM_BUDGET_MB, 128, 16384, 128);
+	obs_property_int_set_suffix(p, " MB");
+
 	UNUSED_PARAMETER(data);
 	return props;
 }
@@ -156,8 +196,20 @@ static obs_properties_t *gpu_delay_filter_properties(void *data)
 static void *gpu_delay_filter_create(obs_data_t *settings, obs_source_t *context)
 {
 	struct gpu_delay_filter_data *f = bzalloc(sizeof(*f));
+	char *effect_path = obs_module_file("gpu_delay_pack.effect");
+
 	f->context = context;
 
+	obs_enter_graphics();
+	f->pack_effect = gs_effect_create_from_file(effect_path, NULL);
+	obs_leave_graphics();
+
+	if (!f->pack_effect)
+		blog(LOG_WARNING, "gpu_delay: failed to load subsampling effect, "
+				  "frames will stay full precision");
+
+	bfree(effect_path);
+
 	obs_source_update(context, settings);
 	return f;
 }
@@ -167,6 +219,12 @@ static void gpu_delay_filter_destroy(void *data)
 	struct gpu_delay_filter_data *f = data;
 
 	free_textures(f);
+
+	obs_enter_graphics();
+	gs_texrender_destroy(f->scratch);
+	gs_effect_destroy(f->pack_effect);
+	obs_leave_graphics();
+
 	bfree(f);
 }
 
@@ -230,6 +288,35 @@ static const char *get_tech_name_and_multiplier(enum gs_color_space current_spac
 	return tech_name;
 }
 
+static void pack_frame(struct gpu_delay_filter_data *f, struct frame *frame)
+{
+	gs_texture_t *tex = gs_texrender_get_texture(f->scratch);
+	gs_eparam_t *image = gs_effect_get_param_by_name(f->pack_effect, "image");
+	const uint32_t half_cx = (f->cx + 1) / 2;
+	const uint32_t half_cy = (f->cy + 1) / 2;
+
+	if (!tex)
+		return;
+
+	gs_texrender_reset(frame->render_y);
+	if (gs_texrender_begin(frame->render_y, f->cx, f->cy)) {
+		gs_ortho(0.0f, (float)f->cx, 0.0f, (float)f->cy, -100.0f, 100.0f);
+		gs_effect_set_texture(image, tex);
+		while (gs_effect_loop(f->pack_effect, "PackY"))
+			gs_draw_sprite(tex, 0, f->cx, f->cy);
+		gs_texrender_end(frame->render_y);
+	}
+
+	gs_texrender_reset(frame->render_uv);
+	if (gs_texrender_begin(frame->render_uv, half_cx, half_cy)) {
+		gs_ortho(0.0f, (float)f->cx, 0.0f, (float)f->cy, -100.0f, 100.0f);
+		gs_effect_set_texture(image, tex);
+		while (gs_effect_loop(f->pack_effect, "PackUV"))
+			gs_draw_sprite(tex, 0, f->cx, f->cy);
+		gs_texrender_end(frame->render_uv);
+	}
+}
+
 static void draw_frame(struct gpu_delay_filter_data *f)
 {
 	struct frame frame;
@@ -239,8 +326,27 @@ static void draw_frame(struct gpu_delay_filter_data *f)
 	float multiplier;
 	const char *technique = get_tech_name_and_multiplier(current_space, frame.space, &multiplier);
 
+	if (frame.compressed) {
+		gs_texture_t *tex_y = gs_texrender_get_texture(frame.render_y);
+		gs_texture_t *tex_uv = gs_texrender_get_texture(frame.render_uv);
+		if (tex_y && tex_uv) {
+			const bool previous = gs_framebuffer_srgb_enabled();
+			gs_enable_framebuffer_srgb(true);
+
+			gs_effect_set_texture(gs_effect_get_param_by_name(f->pack_effect, "image"), tex_y);
+			gs_effect_set_texture(gs_effect_get_param_by_name(f->pack_effect, "image_uv"), tex_uv);
+			gs_effect_set_float(gs_effect_get_param_by_name(f->pack_effect, "multiplier"), multiplier);
+
+			while (gs_effect_loop(f->pack_effect, technique))
+				gs_draw_sprite(tex_y, 0, f->cx, f->cy);
+
+			gs_enable_framebuffer_srgb(previous);
+		}
+		return;
+	}
+
 	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
-	gs_texture_t *tex = gs_texrender_get_texture(frame.render);
+	gs_texture_t *tex = frame.render ? gs_texrender_get_texture(frame.render) : NULL;
 	if (tex) {
 		const bool previous = gs_framebuffer_srgb_enabled();
 		gs_enable_framebuffer_srgb(true);
@@ -282,17 +388,46 @@ static void gpu_delay_filter_render(void *data, gs_effect_t *effect)
 	const enum gs_color_space space =
 		obs_source_get_color_space(target, OBS_COUNTOF(preferred_spaces), preferred_spaces);
 	const enum gs_color_format format = gs_get_format_from_space(space);
-	if (gs_texrender_get_format(frame.render) != format) {
-		gs_texrender_destroy(frame.render);
-		frame.render = gs_texrender_create(format, GS_ZS_NONE);
+
+	/* HDR frames would not survive 8-bit planes, so only SDR frames
+	 * are subsampled */
+	const bool compress = f->subsample && f->pack_effect && space == GS_CS_SRGB;
+
+	gs_texrender_t *render_target;
+	if (compress) {
+		if (!f->scratch)
+			f->scratch = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+		if (frame.render) {
+			gs_texrender_destroy(frame.render);
+			frame.render = NULL;
+		}
+		if (!frame.render_y)
+			frame.render_y = gs_texrender_create(GS_R8, GS_ZS_NONE);
+		if (!frame.render_uv)
+			frame.render_uv = gs_texrender_create(GS_R8G8, GS_ZS_NONE);
+		render_target = f->scratch;
+	} else {
+		if (frame.render_y) {
+			gs_texrender_destroy(frame.render_y);
+			gs_texrender_destroy(frame.render_uv);
+			frame.render_y = NULL;
+			frame.render_uv = NULL;
+		}
+		if (!frame.render) {
+			frame.render = gs_texrender_create(format, GS_ZS_NONE);
+		} else if (gs_texrender_get_format(frame.render) != format) {
+			gs_texrender_destroy(frame.render);
+			frame.render = gs_texrender_create(format, GS_ZS_NONE);
+		}
+		render_target = frame.render;
 	}
 
-	gs_texrender_reset(frame.render);
+	gs_texrender_reset(render_target);
 
 	gs_blend_state_push();
 	gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
 
-	if (gs_texrender_begin_with_color_space(frame.render, f->cx, f->cy, space)) {
+	if (gs_texrender_begin_with_color_space(render_target, f->cx, f->cy, space)) {
 		uint32_t parent_flags = obs_source_get_output_flags(target);
 		bool custom_draw = (parent_flags & OBS_SOURCE_CUSTOM_DRAW) != 0;
 		bool async = (parent_flags & OBS_SOURCE_ASYNC) != 0;
@@ -307,9 +442,12 @@ static void gpu_delay_filter_render(void *data, gs_effect_t *effect)
 		else
 			obs_source_video_render(target);
 
-		gs_texrender_end(frame.render);
+		gs_texrender_end(render_target);
 
 		frame.space = space;
+		frame.compressed = compress;
+		if (compress)
+			pack_frame(f, &frame);
 	}
 
 	gs_blend_state_pop();
@@ -352,6 +490,7 @@ struct obs_source_info gpu_delay_filter = {
 	.create = gpu_delay_filter_create,
 	.destroy = gpu_delay_filter_destroy,
 	.update = gpu_delay_filter_update,
+	.get_defaults = gpu_delay_filter_defaults,
 	.get_properties = gpu_delay_filter_properties,
 	.video_tick = gpu_delay_filter_tick,
 	.video_render = gpu_delay_filter_render,
@@ -37,6 +37,8 @@
 #include <util/bmem.h>      // For bzalloc, brealloc, bfree
 #include <util/circlebuf.h> // For circular buffer implementation
 
+#include "audio-dsp.h" // Shared vectorized gain application helpers
+
 /* Prevent compiler warnings for unused parameters */
 #ifndef UNUSED_PARAMETER
 #define UNUSED_PARAMETER(x) (void)x
@@ -506,8 +508,13 @@ static inline void process_compression(const struct limiter_v2_data *cd, float *
 		return;
 	}
 
+	/* The envelope has already been consumed by this point, so convert
+	 * it into a gain buffer in place, then apply it per channel over
+	 * contiguous sample runs so the multiplies vectorize. */
+	float *gain_buf = cd->envelope_buf;
+
 	for (uint32_t i = 0; i < num_samples; ++i) {
-		const float env_lin = cd->envelope_buf[i];
+		const float env_lin = gain_buf[i];
 		float gain_reduction_multiplier = 1.0f;
 
 		if (env_lin > SMALL_EPSILON) {
@@ -524,13 +531,12 @@ static inline void process_compression(const struct limiter_v2_data *cd, float *
 		if (!isfinite(final_gain))
 			final_gain = 0.0f;
 
-		for (size_t c = 0; c < cd->num_channels; ++c) {
-			if (c < MAX_AUDIO_CHANNELS && samples[c] && isfinite(samples[c][i])) {
-				samples[c][i] *= final_gain;
-			} else if (c < MAX_AUDIO_CHANNELS && samples[c]) {
-				samples[c][i] = 0.0f;
-			}
-		}
+		gain_buf[i] = final_gain;
+	}
+
+	for (size_t c = 0; c < cd->num_channels && c < MAX_AUDIO_CHANNELS; ++c) {
+		if (samples[c])
+			audio_dsp_apply_gain_buf_safe(samples[c], gain_buf, num_samples);
 	}
 }
 
@@ -998,6 +1004,8 @@ static struct obs_audio_data *limiter_v2_filter_audio(void *data, struct obs_aud
 	float **samples = (float **)audio->data;
 	bool lookahead_active = cd->lookahead_enabled && cd->lookahead_buffers_initialized && cd->lookahead_samples > 0;
 
+	const uint32_t csr = audio_dsp_disable_denormals();
+
 	// --- 1. Analyze Undelayed Input (Sidechain Path) ---
 	analyze_envelope(cd, samples, num_samples);
 
@@ -1021,6 +1029,7 @@ static struct obs_audio_data *limiter_v2_filter_audio(void *data, struct obs_aud
 	// --- 3. Process Compression (Main Path Processing) ---
 	process_compression(cd, samples, num_samples);
 
+	audio_dsp_restore_denormals(csr);
 	return audio;
 }
 
@@ -110,6 +110,14 @@ static void luma_key_render_internal(void *data, bool premultiplied)
 {
 	struct luma_key_filter_data *filter = data;
 
+	/* a fully open key (the default) passes every pixel unchanged;
+	 * skip the pass rather than burn a render target on it */
+	if (filter->luma_min <= 0.0f && filter->luma_max >= 1.0f && filter->luma_min_smooth <= 0.0f &&
+	    filter->luma_max_smooth <= 0.0f) {
+		obs_source_skip_video_filter(filter->context);
+		return;
+	}
+
 	const enum gs_color_space preferred_spaces[] = {
 		GS_CS_SRGB,
 		GS_CS_SRGB_16F,
@@ -0,0 +1,380 @@
+#include <obs-module.h>
+#include <graphics/half.h>
+#include <graphics/image-file.h>
+#include <util/dstr.h>
+#include <util/platform.h>
+#include <util/threading.h>
+
+#include "lut-cache.h"
+
+static const uint32_t LUT_WIDTH = 64;
+
+struct lut_entry {
+	uint64_t hash;
+	uint64_t file_size;
+	volatile long refs;
+	volatile bool loaded;
+
+	char *path;
+	bool png;
+	void *cube_data;
+	gs_image_file_t image;
+
+	struct lut_data data;
+	struct lut_entry *next;
+};
+
+static pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct lut_entry *cache_entries = NULL;
+
+static bool hash_file(const char *path, uint64_t *hash, uint64_t *size)
+{
+	FILE *const file = os_fopen(path, "rb");
+	if (!file)
+		return false;
+
+	uint64_t h = 0xcbf29ce484222325ULL;
+	uint64_t total = 0;
+	uint8_t chunk[4096];
+	size_t n;
+
+	while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+		for (size_t i = 0; i < n; i++)
+			h = (h ^ chunk[i]) * 0x100000001b3ULL;
+		total += n;
+	}
+
+	fclose(file);
+
+	if (!total)
+		return false;
+
+	*hash = h;
+	*size = total;
+	return true;
+}
+
+static gs_texture_t *make_clut_texture_png(const enum gs_color_format format, const uint32_t image_width,
+					   const uint32_t image_height, const uint8_t *data)
+{
+	if (image_width % LUT_WIDTH != 0)
+		return NULL;
+
+	if (image_height % LUT_WIDTH != 0)
+		return NULL;
+
+	const uint32_t pixel_count = LUT_WIDTH * LUT_WIDTH * LUT_WIDTH;
+	if ((image_width * image_height) != pixel_count)
+		return NULL;
+
+	const uint32_t bpp = gs_get_format_bpp(format);
+	if (bpp % 8 != 0)
+		return NULL;
+
+	const uint32_t pixel_size = bpp / 8;
+	const uint32_t buffer_size = pixel_size * pixel_count;
+	uint8_t *const buffer = bmalloc(buffer_size);
+	const uint32_t macro_width = image_width / LUT_WIDTH;
+	const uint32_t macro_height = image_height / LUT_WIDTH;
+	uint8_t *cursor = buffer;
+	for (uint32_t z = 0; z < LUT_WIDTH; ++z) {
+		const int z_x = (z % macro_width) * LUT_WIDTH;
+		const int z_y = (z / macro_height) * LUT_WIDTH;
+		for (uint32_t y = 0; y < LUT_WIDTH; ++y) {
+			const uint32_t row_index = image_width * (z_y + y);
+			for (uint32_t x = 0; x < LUT_WIDTH; ++x) {
+				const uint32_t index = row_index + z_x + x;
+				memcpy(cursor, &data[pixel_size * index], pixel_size);
+
+				cursor += pixel_size;
+			}
+		}
+	}
+
+	gs_texture_t *const texture =
+		gs_voltexture_create(LUT_WIDTH, LUT_WIDTH, LUT_WIDTH, format, 1, (const uint8_t **)&buffer, 0);
+	bfree(buffer);
+
+	return texture;
+}
+
+static bool get_cube_entry(FILE *const file, float *const red, float *const green, float *const blue)
+{
+	bool data_found = false;
+
+	char line[256];
+	while (fgets(line, sizeof(line), file)) {
+		if (sscanf(line, "%f %f %f", red, green, blue) == 3) {
+			data_found = true;
+			break;
+		}
+	}
+
+	return data_found;
+}
+
+static void *load_1d_lut(FILE *const file, const uint32_t width, float red, float green, float blue)
+{
+	const uint32_t data_size = 4 * width * width * width * sizeof(struct half);
+	struct half *values = bmalloc(data_size);
+
+	size_t offset = 0;
+	bool data_found = true;
+	for (uint32_t index = 0; index < width; ++index) {
+		if (!data_found) {
+			bfree(values);
+			values = NULL;
+			break;
+		}
+
+		values[offset++] = half_from_float(gs_srgb_nonlinear_to_linear(red));
+		values[offset++] = half_from_float(gs_srgb_nonlinear_to_linear(green));
+		values[offset++] = half_from_float(gs_srgb_nonlinear_to_linear(blue));
+		values[offset++] = half_from_bits(0x3c00); // 1.0
+
+		data_found = get_cube_entry(file, &red, &green, &blue);
+	}
+
+	return values;
+}
+
+static void *load_3d_lut(FILE *const file, const uint32_t width, float red, float green, float blue)
+{
+	const uint32_t data_size = 4 * width * width * width * sizeof(struct half);
+	struct half *values = bmalloc(data_size);
+
+	size_t offset = 0;
+	bool data_found = true;
+	for (uint32_t z = 0; z < width; ++z) {
+		for (uint32_t y = 0; y < width; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				if (!data_found) {
+					bfree(values);
+					values = NULL;
+					break;
+				}
+
+				values[offset++] = half_from_float(gs_srgb_nonlinear_to_linear(red));
+				values[offset++] = half_from_float(gs_srgb_nonlinear_to_linear(green));
+				values[offset++] = half_from_float(gs_srgb_nonlinear_to_linear(blue));
+				values[offset++] = half_from_bits(0x3c00); // 1.0
+
+				data_found = get_cube_entry(file, &red, &green, &blue);
+			}
+		}
+	}
+
+	return values;
+}
+
+static void *load_cube_file(const char *const path, uint32_t *const width, struct vec3 *domain_min,
+			    struct vec3 *domain_max, bool *is_1d)
+{
+	void *data = NULL;
+
+	FILE *const file = os_fopen(path, "rb");
+	if (file) {
+		float red, green, blue;
+		unsigned width_1d = 0;
+		unsigned width_3d = 0;
+
+		bool data_found = false;
+
+		char line[256];
+		unsigned u;
+		float f[3];
+		while (fgets(line, sizeof(line), file)) {
+			if (sscanf(line, "%f %f %f", &red, &green, &blue) == 3) {
+				/* no more metadata */
+				data_found = true;
+				break;
+			} else if (sscanf(line, "DOMAIN_MIN %f %f %f", &f[0], &f[1], &f[2]) == 3) {
+				vec3_set(domain_min, f[0], f[1], f[2]);
+			} else if (sscanf(line, "DOMAIN_MAX %f %f %f", &f[0], &f[1], &f[2]) == 3) {
+				vec3_set(domain_max, f[0], f[1], f[2]);
+			} else if (sscanf(line, "LUT_1D_SIZE %u", &u) == 1) {
+				width_1d = u;
+			} else if (sscanf(line, "LUT_3D_SIZE %u", &u) == 1) {
+				width_3d = u;
+			}
+		}
+
+		if (domain_min->x >= domain_max->x || domain_min->y >= domain_max->y ||
+		    domain_min->z >= domain_max->z) {
+			blog(LOG_WARNING, "Invalid CUBE LUT domain: [%f, %f], [%f, %f], [%f, %f]", domain_min->x,
+			     domain_max->x, domain_min->y, domain_max->y, domain_min->z, domain_max->z);
+		} else if (data_found) {
+			if (width_1d > 0) {
+				data = load_1d_lut(file, width_1d, red, green, blue);
+				if (data) {
+					*width = width_1d;
+					*is_1d = true;
+				}
+			} else if (width_3d > 0) {
+				data = load_3d_lut(file, width_3d, red, green, blue);
+				if (data) {
+					*width = width_3d;
+					*is_1d = false;
+				}
+			}
+		}
+
+		fclose(file);
+	}
+
+	return data;
+}
+
+/* graphics thread */
+static void lut_cache_upload(void *param)
+{
+	struct lut_entry *entry = param;
+
+	if (entry->png) {
+		if (entry->image.loaded) {
+			entry->data.texture = make_clut_texture_png(entry->image.format, entry->image.cx,
+								    entry->image.cy, entry->image.texture_data);
+			entry->data.width = LUT_WIDTH;
+
+			const float width_i = 1.0f / (float)LUT_WIDTH;
+			const float clut_scale = 1.0f - width_i;
+			const float offset = 0.5f * width_i;
+			vec3_set(&entry->data.clut_scale, clut_scale, clut_scale, clut_scale);
+			vec3_set(&entry->data.clut_offset, offset, offset, offset);
+		}
+
+		gs_image_file_free(&entry->image);
+
+	} else if (entry->cube_data) {
+		const uint32_t width = entry->data.width;
+		if (entry->data.is_1d) {
+			entry->data.texture =
+				gs_texture_create(width, 1, GS_RGBA16F, 1, (const uint8_t **)&entry->cube_data, 0);
+		} else {
+			entry->data.texture = gs_voltexture_create(width, width, width, GS_RGBA16F, 1,
+								   (const uint8_t **)&entry->cube_data, 0);
+		}
+
+		struct vec3 domain_scale;
+		vec3_sub(&domain_scale, &entry->data.domain_max, &entry->data.domain_min);
+
+		const float width_minus_one = (float)(width - 1);
+		vec3_set(&entry->data.clut_scale, width_minus_one, width_minus_one, width_minus_one);
+		vec3_div(&entry->data.clut_scale, &entry->data.clut_scale, &domain_scale);
+
+		vec3_neg(&entry->data.clut_offset, &entry->data.domain_min);
+		vec3_mul(&entry->data.clut_offset, &entry->data.clut_offset, &entry->data.clut_scale);
+
+		/* want normalized UVW */
+		vec3_divf(&entry->data.clut_scale, &entry->data.clut_scale, (float)width);
+		vec3_addf(&entry->data.clut_offset, &entry->data.clut_offset, 0.5f);
+		vec3_divf(&entry->data.clut_offset, &entry->data.clut_offset, (float)width);
+
+		bfree(entry->cube_data);
+		entry->cube_data = NULL;
+	}
+
+	os_atomic_set_bool(&entry->loaded, true);
+	lut_cache_release(entry);
+}
+
+static void *lut_load_thread(void *param)
+{
+	struct lut_entry *entry = param;
+
+	os_set_thread_name("obs-filters: LUT load");
+
+	vec3_set(&entry->data.domain_min, 0.0f, 0.0f, 0.0f);
+	vec3_set(&entry->data.domain_max, 1.0f, 1.0f, 1.0f);
+
+	const char *const ext = os_get_path_extension(entry->path);
+	if (ext && astrcmpi(ext, ".cube") == 0) {
+		entry->cube_data = load_cube_file(entry->path, &entry->data.width, &entry->data.domain_min,
+						  &entry->data.domain_max, &entry->data.is_1d);
+	} else {
+		gs_image_file_init(&entry->image, entry->path);
+		entry->png = true;
+	}
+
+	obs_queue_task(OBS_TASK_GRAPHICS, lut_cache_upload, entry, false);
+	return NULL;
+}
+
+struct lut_entry *lut_cache_acquire(const char *path)
+{
+	uint64_t hash, size;
+	pthread_t thread;
+
+	if (!path || !hash_file(path, &hash, &size))
+		return NULL;
+
+	pthread_mutex_lock(&cache_mutex);
+
+	for (struct lut_entry *entry = cache_entries; entry; entry = entry->next) {
+		if (entry->hash == hash && entry->file_size == size) {
+			os_atomic_inc_long(&entry->refs);
+			pthread_mutex_unlock(&cache_mutex);
+			return entry;
+		}
+	}
+
+	struct lut_entry *entry = bzalloc(sizeof(*entry));
+	entry->hash = hash;
+	entry->file_size = size;
+	entry->path = bstrdup(path);
+	entry->refs = 2; /* caller + loader thread */
+	entry->next = cache_entries;
+	cache_entries = entry;
+
+	pthread_mutex_unlock(&cache_mutex);
+
+	if (pthread_create(&thread, NULL, lut_load_thread, entry) == 0) {
+		pthread_detach(thread);
+	} else {
+		os_atomic_set_bool(&entry->loaded, true);
+		lut_cache_release(entry);
+	}
+
+	return entry;
+}
+
+void lut_cache_release(struct lut_entry *entry)
+{
+	if (!entry)
+		return;
+
+	pthread_mutex_lock(&cache_mutex);
+
+	if (os_atomic_dec_long(&entry->refs) != 0) {
+		pthread_mutex_unlock(&cache_mutex);
+		return;
+	}
+
+	struct lut_entry **p = &cache_entries;
+	while (*p && *p != entry)
+		p = &(*p)->next;
+	if (*p)
+		*p = entry->next;
+
+	pthread_mutex_unlock(&cache_mutex);
+
+	obs_enter_graphics();
+	if (entry->data.is_1d)
+		gs_texture_destroy(entry->data.texture);
+	else
+		gs_voltexture_destroy(entry->data.texture);
+	gs_image_file_free(&entry->image);
+	obs_leave_graphics();
+
+	bfree(entry->cube_data);
+	bfree(entry->path);
+	bfree(entry);
+}
+
+const struct lut_data *lut_cache_get(struct lut_entry *entry)
+{
+	if (!entry || !os_atomic_load_bool(&entry->loaded))
+		return NULL;
+
+	return entry->data.texture ? &entry->data : NULL;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <graphics/graphics.h>
+#include <graphics/vec3.h>
+
+/* Refcounted cache of LUT textures keyed by file content, so that many
+ * filter instances pointing at the same LUT share one texture.  Files
+ * are parsed on a worker thread and uploaded on the graphics thread. */
+
+struct lut_entry;
+
+/* Valid once lut_cache_get() returns non-NULL; the texture may only be
+ * used inside the graphics context. */
+struct lut_data {
+	gs_texture_t *texture;
+	uint32_t width;
+	bool is_1d;
+	struct vec3 clut_scale;
+	struct vec3 clut_offset;
+	struct vec3 domain_min;
+	struct vec3 domain_max;
+};
+
+extern struct lut_entry *lut_cache_acquire(const char *path);
+extern void lut_cache_release(struct lut_entry *entry);
+
+/* returns NULL while the LUT is still loading or if loading failed */
+extern const struct lut_data *lut_cache_get(struct lut_entry *entry);
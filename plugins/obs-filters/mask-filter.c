@@ -36,6 +36,11 @@ struct mask_filter_data {
 	time_t image_file_timestamp;
 	float update_time_elapsed;
 
+	gs_eparam_t *target_param;
+	gs_eparam_t *color_param;
+	gs_eparam_t *mul_val_param;
+	gs_eparam_t *add_val_param;
+
 	gs_texture_t *target;
 	gs_image_file_t image;
 	struct vec4 color;
@@ -111,6 +116,20 @@ static void mask_filter_update_internal(void *data, obs_data_t *settings, float
 	filter->effect = gs_effect_create_from_file(effect_path, NULL);
 	bfree(effect_path);
 
+	/* cache the parameters so the render function doesn't do four
+	 * string lookups per frame */
+	if (filter->effect) {
+		filter->target_param = gs_effect_get_param_by_name(filter->effect, "target");
+		filter->color_param = gs_effect_get_param_by_name(filter->effect, "color");
+		filter->mul_val_param = gs_effect_get_param_by_name(filter->effect, "mul_val");
+		filter->add_val_param = gs_effect_get_param_by_name(filter->effect, "add_val");
+	} else {
+		filter->target_param = NULL;
+		filter->color_param = NULL;
+		filter->mul_val_param = NULL;
+		filter->add_val_param = NULL;
+	}
+
 	obs_leave_graphics();
 }
 
@@ -250,7 +269,6 @@ static void mask_filter_render(void *data, gs_effect_t *effect)
 
 	struct mask_filter_data *filter = data;
 	obs_source_t *target = obs_filter_get_target(filter->context);
-	gs_eparam_t *param;
 	struct vec2 add_val = {0};
 	struct vec2 mul_val = {1.0f, 1.0f};
 
@@ -302,17 +320,10 @@ static void mask_filter_render(void *data, gs_effect_t *effect)
 		const enum gs_color_format format = gs_get_format_from_space(source_space);
 		if (obs_source_process_filter_begin_with_color_space(filter->context, format, source_space,
 								     OBS_ALLOW_DIRECT_RENDERING)) {
-			param = gs_effect_get_param_by_name(filter->effect, "target");
-			gs_effect_set_texture_srgb(param, filter->target);
-
-			param = gs_effect_get_param_by_name(filter->effect, "color");
-			gs_effect_set_vec4(param, &filter->color);
-
-			param = gs_effect_get_param_by_name(filter->effect, "mul_val");
-			gs_effect_set_vec2(param, &mul_val);
-
-			param = gs_effect_get_param_by_name(filter->effect, "add_val");
-			gs_effect_set_vec2(param, &add_val);
+			gs_effect_set_texture_srgb(filter->target_param, filter->target);
+			gs_effect_set_vec4(filter->color_param, &filter->color);
+			gs_effect_set_vec2(filter->mul_val_param, &mul_val);
+			gs_effect_set_vec2(filter->add_val_param, &add_val);
 
 			gs_blend_state_push();
 			gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
@@ -41,6 +41,7 @@ bool nvafx_loaded = false;
 
 #define S_SUPPRESS_LEVEL "suppress_level"
 #define S_NVAFX_INTENSITY "intensity"
+#define S_ASYNC_DSP "async_processing"
 #define S_METHOD "method"
 #define S_METHOD_SPEEX "speex"
 #define S_METHOD_RNN "rnnoise"
@@ -51,6 +52,7 @@ bool nvafx_loaded = false;
 #define MT_ obs_module_text
 #define TEXT_SUPPRESS_LEVEL MT_("NoiseSuppress.SuppressLevel")
 #define TEXT_NVAFX_INTENSITY MT_("NoiseSuppress.Intensity")
+#define TEXT_ASYNC_DSP MT_("NoiseSuppress.AsyncProcessing")
 #define TEXT_METHOD MT_("NoiseSuppress.Method")
 #define TEXT_METHOD_SPEEX MT_("NoiseSuppress.Method.Speex")
 #define TEXT_METHOD_RNN MT_("NoiseSuppress.Method.RNNoise")
@@ -97,6 +99,17 @@ struct noise_suppress_data {
 #endif
 	bool has_mono_src;
 	volatile bool reinit_done;
+
+	/* optional background DSP thread: when enabled, inference runs off
+	 * the audio thread and ready segments are picked up on a later
+	 * tick, trading up to one segment of delivery delay for audio-tick
+	 * time */
+	bool async_dsp;
+	bool dsp_thread_active;
+	volatile bool dsp_thread_stop;
+	pthread_t dsp_thread;
+	os_sem_t *dsp_sem;
+	pthread_mutex_t dsp_mutex;
 #ifdef LIBSPEEXDSP_ENABLED
 	/* Speex preprocessor state */
 	SpeexPreprocessState *spx_states[MAX_PREPROC_CHANNELS];
@@ -141,10 +154,14 @@ static const char *noise_suppress_name(void *unused)
 	return obs_module_text("NoiseSuppress");
 }
 
+static void noise_suppress_stop_dsp_thread(struct noise_suppress_data *ng);
+
 static void noise_suppress_destroy(void *data)
 {
 	struct noise_suppress_data *ng = data;
 
+	noise_suppress_stop_dsp_thread(ng);
+
 	for (size_t i = 0; i < ng->channels; i++) {
 #ifdef LIBSPEEXDSP_ENABLED
 		speex_preprocess_state_destroy(ng->spx_states[i]);
@@ -170,6 +187,8 @@ static void noise_suppress_destroy(void *data)
 	bfree(ng->copy_buffers[0]);
 	deque_free(&ng->info_buffer);
 	da_free(ng->output_data);
+	os_sem_destroy(ng->dsp_sem);
+	pthread_mutex_destroy(&ng->dsp_mutex);
 	bfree(ng);
 }
 
@@ -211,6 +230,33 @@ static inline enum speaker_layout convert_speaker_layout(uint8_t channels)
 	}
 }
 
+static void *noise_suppress_dsp_thread(void *data);
+
+static void noise_suppress_start_dsp_thread(struct noise_suppress_data *ng)
+{
+	if (ng->dsp_thread_active)
+		return;
+
+	if (pthread_create(&ng->dsp_thread, NULL, noise_suppress_dsp_thread, ng) == 0) {
+		ng->dsp_thread_active = true;
+	} else {
+		warn("Failed to create DSP thread, processing inline");
+		ng->async_dsp = false;
+	}
+}
+
+static void noise_suppress_stop_dsp_thread(struct noise_suppress_data *ng)
+{
+	if (!ng->dsp_thread_active)
+		return;
+
+	os_atomic_set_bool(&ng->dsp_thread_stop, true);
+	os_sem_post(ng->dsp_sem);
+	pthread_join(ng->dsp_thread, NULL);
+	ng->dsp_thread_active = false;
+	os_atomic_set_bool(&ng->dsp_thread_stop, false);
+}
+
 static void noise_suppress_update(void *data, obs_data_t *s)
 {
 	struct noise_suppress_data *ng = data;
@@ -229,6 +275,12 @@ static void noise_suppress_update(void *data, obs_data_t *s)
 	ng->frames = frames;
 	ng->channels = channels;
 
+	ng->async_dsp = obs_data_get_bool(s, S_ASYNC_DSP) && !ng->nvafx_enabled;
+	if (ng->async_dsp)
+		noise_suppress_start_dsp_thread(ng);
+	else
+		noise_suppress_stop_dsp_thread(ng);
+
 	/* Ignore if already allocated */
 #if defined(LIBSPEEXDSP_ENABLED)
 	if (!ng->use_rnnoise && ng->spx_states[0])
@@ -285,6 +337,18 @@ static void *noise_suppress_create(obs_data_t *settings, obs_source_t *filter)
 	ng->context = filter;
 	ng->nvafx_enabled = false;
 	ng->nvafx_migrated = false;
+
+	if (pthread_mutex_init(&ng->dsp_mutex, NULL) != 0) {
+		blog(LOG_ERROR, "Failed to create mutex");
+		bfree(ng);
+		return NULL;
+	}
+	if (os_sem_init(&ng->dsp_sem, 0) != 0) {
+		blog(LOG_ERROR, "Failed to create semaphore");
+		pthread_mutex_destroy(&ng->dsp_mutex);
+		bfree(ng);
+		return NULL;
+	}
 #ifdef LIBNVAFX_ENABLED
 	ng->migrated_filter = NULL;
 	// If a NVAFX entry is detected, create a new instance of NVAFX filter.
@@ -424,6 +488,44 @@ static inline void process(struct noise_suppress_data *ng)
 		deque_push_back(&ng->output_buffers[i], ng->copy_buffers[i], ng->frames * sizeof(float));
 }
 
+static void *noise_suppress_dsp_thread(void *data)
+{
+	struct noise_suppress_data *ng = data;
+	const size_t segment_size = ng->frames * sizeof(float);
+
+	os_set_thread_name("obs-filters: noise suppress");
+
+	while (os_sem_wait(ng->dsp_sem) == 0) {
+		if (os_atomic_load_bool(&ng->dsp_thread_stop))
+			break;
+
+		for (;;) {
+			pthread_mutex_lock(&ng->dsp_mutex);
+			const bool have_segment = ng->input_buffers[0].size >= segment_size;
+			if (have_segment) {
+				for (size_t i = 0; i < ng->channels; i++)
+					deque_pop_front(&ng->input_buffers[i], ng->copy_buffers[i], segment_size);
+			}
+			pthread_mutex_unlock(&ng->dsp_mutex);
+
+			if (!have_segment)
+				break;
+
+			if (ng->use_rnnoise)
+				process_rnnoise(ng);
+			else
+				process_speexdsp(ng);
+
+			pthread_mutex_lock(&ng->dsp_mutex);
+			for (size_t i = 0; i < ng->channels; i++)
+				deque_push_back(&ng->output_buffers[i], ng->copy_buffers[i], segment_size);
+			pthread_mutex_unlock(&ng->dsp_mutex);
+		}
+	}
+
+	return NULL;
+}
+
 struct ng_audio_info {
 	uint32_t frames;
 	uint64_t timestamp;
@@ -489,11 +591,18 @@ static struct obs_audio_data *noise_suppress_filter_audio(void *data, struct obs
 	 * if timestamp has dramatically changed, consider it a new stream of
 	 * audio data.  clear all circular buffers to prevent old audio data
 	 * from being processed as part of the new data. */
+	const bool async = ng->async_dsp && ng->dsp_thread_active;
+
 	if (ng->last_timestamp) {
 		int64_t diff = llabs((int64_t)ng->last_timestamp - (int64_t)audio->timestamp);
 
-		if (diff > 1000000000LL)
+		if (diff > 1000000000LL) {
+			if (async)
+				pthread_mutex_lock(&ng->dsp_mutex);
 			reset_data(ng);
+			if (async)
+				pthread_mutex_unlock(&ng->dsp_mutex);
+		}
 	}
 
 	ng->last_timestamp = audio->timestamp;
@@ -505,14 +614,23 @@ static struct obs_audio_data *noise_suppress_filter_audio(void *data, struct obs
 	deque_push_back(&ng->info_buffer, &info, sizeof(info));
 
 	/* -----------------------------------------------
-	 * push back current audio data to input deque */
-	for (size_t i = 0; i < ng->channels; i++)
-		deque_push_back(&ng->input_buffers[i], audio->data[i], audio->frames * sizeof(float));
+	 * push back current audio data to input deque, then either hand
+	 * the segments to the DSP thread or process them inline */
+	if (async) {
+		pthread_mutex_lock(&ng->dsp_mutex);
+		for (size_t i = 0; i < ng->channels; i++)
+			deque_push_back(&ng->input_buffers[i], audio->data[i], audio->frames * sizeof(float));
+		pthread_mutex_unlock(&ng->dsp_mutex);
+
+		os_sem_post(ng->dsp_sem);
+	} else {
+		for (size_t i = 0; i < ng->channels; i++)
+			deque_push_back(&ng->input_buffers[i], audio->data[i], audio->frames * sizeof(float));
 
-	/* -----------------------------------------------
-	 * pop/process each 10ms segments, push back to output deque */
-	while (ng->input_buffers[0].size >= segment_size)
-		process(ng);
+		/* pop/process each 10ms segments, push back to output deque */
+		while (ng->input_buffers[0].size >= segment_size)
+			process(ng);
+	}
 
 	/* -----------------------------------------------
 	 * peek front of info deque, check to see if we have enough to
@@ -521,8 +639,14 @@ static struct obs_audio_data *noise_suppress_filter_audio(void *data, struct obs
 	deque_peek_front(&ng->info_buffer, &info, sizeof(info));
 	out_size = info.frames * sizeof(float);
 
-	if (ng->output_buffers[0].size < out_size)
+	if (async)
+		pthread_mutex_lock(&ng->dsp_mutex);
+
+	if (ng->output_buffers[0].size < out_size) {
+		if (async)
+			pthread_mutex_unlock(&ng->dsp_mutex);
 		return NULL;
+	}
 
 	/* -----------------------------------------------
 	 * if there's enough audio data buffered in the output deque,
@@ -536,6 +660,9 @@ static struct obs_audio_data *noise_suppress_filter_audio(void *data, struct obs
 		deque_pop_front(&ng->output_buffers[i], ng->output_audio.data[i], out_size);
 	}
 
+	if (async)
+		pthread_mutex_unlock(&ng->dsp_mutex);
+
 	ng->output_audio.frames = info.frames;
 	ng->output_audio.timestamp = info.timestamp - ng->latency;
 	return &ng->output_audio;
@@ -561,6 +688,7 @@ static bool noise_suppress_method_modified(obs_properties_t *props, obs_property
 static void noise_suppress_defaults_v1(obs_data_t *s)
 {
 	obs_data_set_default_int(s, S_SUPPRESS_LEVEL, -30);
+	obs_data_set_default_bool(s, S_ASYNC_DSP, false);
 #if defined(LIBRNNOISE_ENABLED) && !defined(LIBSPEEXDSP_ENABLED)
 	obs_data_set_default_string(s, S_METHOD, S_METHOD_RNN);
 #else
@@ -574,6 +702,7 @@ static void noise_suppress_defaults_v1(obs_data_t *s)
 static void noise_suppress_defaults_v2(obs_data_t *s)
 {
 	obs_data_set_default_int(s, S_SUPPRESS_LEVEL, -30);
+	obs_data_set_default_bool(s, S_ASYNC_DSP, false);
 #if defined(LIBRNNOISE_ENABLED)
 	obs_data_set_default_string(s, S_METHOD, S_METHOD_RNN);
 #else
@@ -619,6 +748,8 @@ static obs_properties_t *noise_suppress_properties(void *data)
 	obs_property_int_set_suffix(speex_slider, " dB");
 #endif
 
+	obs_properties_add_bool(ppts, S_ASYNC_DSP, TEXT_ASYNC_DSP);
+
 #ifdef LIBNVAFX_ENABLED
 	if (ng->nvafx_enabled) {
 		obs_properties_add_float_slider(ppts, S_NVAFX_INTENSITY, TEXT_NVAFX_INTENSITY, 0.0f, 1.0f, 0.01f);
@@ -4,6 +4,7 @@
 #include <obs-module.h>
 #include <util/platform.h>
 #include <graphics/vec2.h>
+#include <graphics/vec4.h>
 #include <graphics/math-defs.h>
 
 /* clang-format off */
@@ -48,6 +49,9 @@ struct scale_filter_data {
 	int cy_out;
 	enum obs_scale_type sampling;
 	gs_samplerstate_t *point_sampler;
+	gs_texrender_t *mid_texrender;
+	const char *separable_tech;
+	bool separable;
 	bool aspect_ratio_only;
 	bool target_valid;
 	bool valid;
@@ -121,6 +125,7 @@ static void scale_filter_destroy(void *data)
 
 	obs_enter_graphics();
 	gs_samplerstate_destroy(filter->point_sampler);
+	gs_texrender_destroy(filter->mid_texrender);
 	obs_leave_graphics();
 	bfree(data);
 }
@@ -241,6 +246,10 @@ static void scale_filter_tick(void *data, float seconds)
 
 	filter->undistort_factor = filter->undistort ? (new_aspect / old_aspect) : 1.0;
 
+	/* bicubic/lanczos without undistortion can run as two 1-D passes */
+	filter->separable = !filter->undistort && (type == OBS_EFFECT_BICUBIC || type == OBS_EFFECT_LANCZOS);
+	filter->separable_tech = (type == OBS_EFFECT_LANCZOS) ? "DrawLanczos" : "DrawBicubic";
+
 	filter->effect = obs_get_base_effect(type);
 	filter->image_param = gs_effect_get_param_by_name(filter->effect, "image");
 
@@ -394,6 +403,94 @@ static const char *get_tech_name_and_multiplier(const struct scale_filter_data *
 	return tech_name;
 }
 
+/* Draws the horizontal pass into mid_texrender through the standard
+ * filter processing path, then the vertical pass (which also applies any
+ * color conversion) into the active render target.  Returns false if the
+ * intermediate could not be set up, in which case the caller falls back
+ * to the single-pass effect. */
+static bool scale_filter_render_separable(struct scale_filter_data *filter, gs_effect_t *effect,
+					  const char *technique, float multiplier, enum gs_color_format format,
+					  enum gs_color_space space)
+{
+	uint32_t cx_src = (uint32_t)filter->dimension.x;
+	uint32_t cy_src = (uint32_t)filter->dimension.y;
+	gs_eparam_t *image_param = gs_effect_get_param_by_name(effect, "image");
+	gs_eparam_t *dim_param = gs_effect_get_param_by_name(effect, "base_dimension");
+	gs_eparam_t *dim_i_param = gs_effect_get_param_by_name(effect, "base_dimension_i");
+	gs_eparam_t *axis_param = gs_effect_get_param_by_name(effect, "axis");
+	gs_eparam_t *mult_param = gs_effect_get_param_by_name(effect, "multiplier");
+	struct vec4 clear_color;
+	struct vec2 dim, dim_i, axis;
+	char tech_v[64];
+
+	if (filter->mid_texrender && gs_texrender_get_format(filter->mid_texrender) != format) {
+		gs_texrender_destroy(filter->mid_texrender);
+		filter->mid_texrender = NULL;
+	}
+	if (!filter->mid_texrender)
+		filter->mid_texrender = gs_texrender_create(format, GS_ZS_NONE);
+
+	gs_texrender_reset(filter->mid_texrender);
+	if (!gs_texrender_begin_with_color_space(filter->mid_texrender, filter->cx_out, cy_src, space))
+		return false;
+
+	/* horizontal pass into the intermediate */
+	vec4_zero(&clear_color);
+	gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+	gs_ortho(0.0f, (float)filter->cx_out, 0.0f, (float)cy_src, -100.0f, 100.0f);
+
+	vec2_set(&dim, (float)cx_src, (float)cy_src);
+	vec2_set(&dim_i, 1.0f / (float)cx_src, 1.0f / (float)cy_src);
+	vec2_set(&axis, 1.0f, 0.0f);
+	gs_effect_set_vec2(dim_param, &dim);
+	gs_effect_set_vec2(dim_i_param, &dim_i);
+	gs_effect_set_vec2(axis_param, &axis);
+	gs_effect_set_float(mult_param, 1.0f);
+
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	obs_source_process_filter_tech_end(filter->context, effect, filter->cx_out, cy_src, filter->separable_tech);
+	gs_blend_state_pop();
+
+	gs_texrender_end(filter->mid_texrender);
+
+	gs_texture_t *mid_tex = gs_texrender_get_texture(filter->mid_texrender);
+	if (!mid_tex)
+		return true; /* filter chain already consumed; nothing to draw */
+
+	/* vertical pass into the output; "Draw" prefix of the single-pass
+	 * technique name is replaced with the kernel-specific one */
+	snprintf(tech_v, sizeof(tech_v), "%s%s", filter->separable_tech, technique + 4);
+
+	vec2_set(&dim, (float)filter->cx_out, (float)cy_src);
+	vec2_set(&dim_i, 1.0f / (float)filter->cx_out, 1.0f / (float)cy_src);
+	vec2_set(&axis, 0.0f, 1.0f);
+	gs_effect_set_vec2(dim_param, &dim);
+	gs_effect_set_vec2(dim_i_param, &dim_i);
+	gs_effect_set_vec2(axis_param, &axis);
+	gs_effect_set_float(mult_param, multiplier);
+
+	gs_technique_t *tech = gs_effect_get_technique(effect, tech_v);
+	const bool previous_srgb = gs_framebuffer_srgb_enabled();
+	gs_enable_framebuffer_srgb(true);
+	gs_effect_set_texture_srgb(image_param, mid_tex);
+
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+
+	size_t passes = gs_technique_begin(tech);
+	for (size_t i = 0; i < passes; i++) {
+		gs_technique_begin_pass(tech, i);
+		gs_draw_sprite(mid_tex, 0, (uint32_t)filter->cx_out, (uint32_t)filter->cy_out);
+		gs_technique_end_pass(tech);
+	}
+	gs_technique_end(tech);
+
+	gs_blend_state_pop();
+	gs_enable_framebuffer_srgb(previous_srgb);
+	return true;
+}
+
 static void scale_filter_render(void *data, gs_effect_t *effect)
 {
 	UNUSED_PARAMETER(effect);
@@ -415,9 +512,24 @@ static void scale_filter_render(void *data, gs_effect_t *effect)
 		obs_filter_get_target(filter->context), OBS_COUNTOF(preferred_spaces), preferred_spaces);
 	float multiplier;
 	const char *technique = get_tech_name_and_multiplier(filter, gs_get_color_space(), source_space, &multiplier);
+
+	/* a 1:1 scale with no color space conversion is an identity pass;
+	 * skip the full-screen resample and its render target */
+	if ((float)filter->cx_out == filter->dimension.x && (float)filter->cy_out == filter->dimension.y &&
+	    multiplier == 1.0f && strcmp(technique, "Draw") == 0) {
+		obs_source_skip_video_filter(filter->context);
+		return;
+	}
+
+	gs_effect_t *sep_effect = filter->separable ? obs_get_base_effect(OBS_EFFECT_SEPARABLE_SCALE) : NULL;
+
 	const enum gs_color_format format = gs_get_format_from_space(source_space);
 	if (obs_source_process_filter_begin_with_color_space(filter->context, format, source_space,
 							     OBS_NO_DIRECT_RENDERING)) {
+		if (sep_effect && scale_filter_render_separable(filter, sep_effect, technique, multiplier, format,
+								source_space))
+			return;
+
 		if (filter->dimension_param)
 			gs_effect_set_vec2(filter->dimension_param, &filter->dimension);
 
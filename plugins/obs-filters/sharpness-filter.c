@@ -76,6 +76,12 @@ static void sharpness_render(void *data, gs_effect_t *effect)
 
 	struct sharpness_data *filter = data;
 
+	/* zero sharpness is an identity pass; skip the render target */
+	if (filter->sharpness <= 0.0f) {
+		obs_source_skip_video_filter(filter->context);
+		return;
+	}
+
 	const enum gs_color_space preferred_spaces[] = {
 		GS_CS_SRGB,
 		GS_CS_SRGB_16F,
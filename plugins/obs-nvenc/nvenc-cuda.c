@@ -25,15 +25,25 @@ bool cuda_ctx_init(struct nvenc_data *enc, obs_data_t *settings, const bool text
 	bool force_cuda_tex = obs_data_get_bool(settings, "force_cuda_tex");
 #endif
 
-	if (gpu == -1)
-		gpu = 0;
-
 	CU_FAILED(cu->cuInit(0))
 	CU_FAILED(cu->cuDeviceGetCount(&count))
 	if (!count) {
 		NV_FAIL("No CUDA devices found");
 		return false;
 	}
+
+	if (gpu == -1) {
+		gpu = 0;
+
+		/* Spread auto-selected sessions of grouped (multitrack)
+		 * encoders across all encode-capable devices; texture
+		 * encoders are tied to the GPU OBS renders on and keep
+		 * their device. */
+		if (count > 1 && !texture && obs_encoder_get_group_size(enc->encoder) > 1) {
+			gpu = (int)(obs_encoder_get_group_index(enc->encoder) % (size_t)count);
+			info("Balancing grouped encoder onto CUDA device %d of %d", gpu, count);
+		}
+	}
 #ifdef _WIN32
 	CU_FAILED(cu->cuDeviceGet(&device, gpu))
 #else
@@ -107,6 +107,12 @@ struct nvenc_data {
 	size_t roi_map_size;
 	uint32_t roi_increment;
 
+	/* pipeline latency accounting (submit -> bitstream ready) */
+	uint64_t latency_total_ns;
+	uint64_t latency_max_ns;
+	uint64_t latency_frames;
+	uint64_t lock_wait_total_ns;
+
 	struct nvenc_properties props;
 
 	CUcontext cu_ctx;
@@ -132,6 +138,7 @@ struct handle_tex {
 /* Bitstream buffer */
 struct nv_bitstream {
 	void *ptr;
+	uint64_t submit_ts;
 };
 
 /** Mapped resources **/
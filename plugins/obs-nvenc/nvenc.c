@@ -2,6 +2,9 @@
 
 #include <util/darray.h>
 #include <util/dstr.h>
+#include <util/platform.h>
+
+#include <inttypes.h>
 
 /* ========================================================================= */
 
@@ -966,6 +969,13 @@ static void nvenc_destroy(void *data)
 		get_encoded_packet(enc, true);
 	}
 
+	if (enc->latency_frames) {
+		info("encode latency: avg %" PRIu64 " us, max %" PRIu64 " us over %" PRIu64 " frames, %" PRIu64
+		     " ms total blocked on bitstream locks",
+		     enc->latency_total_ns / enc->latency_frames / 1000, enc->latency_max_ns / 1000,
+		     enc->latency_frames, enc->lock_wait_total_ns / 1000000);
+	}
+
 	for (size_t i = 0; i < enc->bitstreams.num; i++) {
 		nv_bitstream_free(enc, &enc->bitstreams.array[i]);
 	}
@@ -1030,10 +1040,25 @@ static bool get_encoded_packet(struct nvenc_data *enc, bool finalize)
 		lock.outputBitstream = bs->ptr;
 		lock.doNotWait = false;
 
+		const uint64_t lock_start = os_gettime_ns();
+
 		if (NV_FAILED(nv.nvEncLockBitstream(s, &lock))) {
 			return false;
 		}
 
+		/* submit -> bitstream-ready latency includes the deliberate
+		 * lookahead/B-frame queueing delay; the lock wait isolates
+		 * time actually spent stalled on the encoder */
+		const uint64_t lock_end = os_gettime_ns();
+		if (bs->submit_ts) {
+			const uint64_t latency = lock_end - bs->submit_ts;
+			enc->latency_total_ns += latency;
+			enc->latency_frames++;
+			if (latency > enc->latency_max_ns)
+				enc->latency_max_ns = latency;
+		}
+		enc->lock_wait_total_ns += lock_end - lock_start;
+
 		if (enc->first_packet) {
 			NV_ENC_SEQUENCE_PARAM_PAYLOAD payload = {0};
 			uint8_t buf[256];
@@ -1208,6 +1233,8 @@ bool nvenc_encode_base(struct nvenc_data *enc, struct nv_bitstream *bs, void *pi
 	if (obs_encoder_has_roi(enc->encoder))
 		add_roi(enc, &params);
 
+	bs->submit_ts = os_gettime_ns();
+
 	NVENCSTATUS err = nv.nvEncEncodePicture(enc->session, &params);
 	if (err != NV_ENC_SUCCESS && err != NV_ENC_ERR_NEED_MORE_INPUT) {
 		nv_failed(enc->encoder, err, __FUNCTION__, "nvEncEncodePicture");
@@ -305,7 +305,8 @@ void flv_meta_data(obs_output_t *context, uint8_t **output, size_t *size, bool w
 static int32_t last_time = 0;
 #endif
 
-static void flv_video(struct serializer *s, int32_t dts_offset, struct encoder_packet *packet, bool is_header)
+static void flv_video(struct serializer *s, int32_t dts_offset, struct encoder_packet *packet, bool is_header,
+		      bool write_prev_size)
 {
 	int32_t ct_offset_ms = get_ms_time(packet, packet->pts) - get_ms_time(packet, packet->dts);
 	int32_t time_ms = get_ms_time(packet, packet->dts) - dts_offset;
@@ -335,10 +336,12 @@ static void flv_video(struct serializer *s, int32_t dts_offset, struct encoder_p
 	s_wb24(s, ct_offset_ms);
 	s_write(s, packet->data, packet->size);
 
-	write_previous_tag_size(s);
+	if (write_prev_size)
+		write_previous_tag_size(s);
 }
 
-static void flv_audio(struct serializer *s, int32_t dts_offset, struct encoder_packet *packet, bool is_header)
+static void flv_audio(struct serializer *s, int32_t dts_offset, struct encoder_packet *packet, bool is_header,
+		      bool write_prev_size)
 {
 	int32_t time_ms = get_ms_time(packet, packet->dts) - dts_offset;
 
@@ -366,7 +369,18 @@ static void flv_audio(struct serializer *s, int32_t dts_offset, struct encoder_p
 	s_w8(s, is_header ? 0 : 1);
 	s_write(s, packet->data, packet->size);
 
-	write_previous_tag_size(s);
+	if (write_prev_size)
+		write_previous_tag_size(s);
+}
+
+/* The in-place variants below build the tag behind RTMP_MAX_HEADER_SIZE
+ * writable scratch bytes and omit the trailing previousTagSize field, so the
+ * buffer can be handed to RTMP_WriteInPlace() and chunked where it lies
+ * instead of being copied into an RTMPPacket first. */
+static void write_rtmp_chunk_scratch(struct serializer *s)
+{
+	const uint8_t scratch[RTMP_MAX_HEADER_SIZE] = {0};
+	s_write(s, scratch, sizeof(scratch));
 }
 
 void flv_packet_mux(struct encoder_packet *packet, int32_t dts_offset, uint8_t **output, size_t *size, bool is_header)
@@ -377,16 +391,38 @@ void flv_packet_mux(struct encoder_packet *packet, int32_t dts_offset, uint8_t *
 	array_output_serializer_init(&s, &data);
 
 	if (packet->type == OBS_ENCODER_VIDEO)
-		flv_video(&s, dts_offset, packet, is_header);
+		flv_video(&s, dts_offset, packet, is_header, true);
 	else
-		flv_audio(&s, dts_offset, packet, is_header);
+		flv_audio(&s, dts_offset, packet, is_header, true);
 
 	*output = data.bytes.array;
 	*size = data.bytes.num;
 }
 
-void flv_packet_audio_ex(struct encoder_packet *packet, enum audio_id_t codec_id, int32_t dts_offset, uint8_t **output,
-			 size_t *size, int type, size_t idx)
+void flv_packet_mux_in_place(struct encoder_packet *packet, int32_t dts_offset, uint8_t **output, size_t *size,
+			     bool is_header)
+{
+	struct array_output_data data;
+	struct serializer s;
+
+	array_output_serializer_init(&s, &data);
+
+	if (packet->data && packet->size) {
+		da_reserve(data.bytes, RTMP_MAX_HEADER_SIZE + 16 + packet->size);
+		write_rtmp_chunk_scratch(&s);
+
+		if (packet->type == OBS_ENCODER_VIDEO)
+			flv_video(&s, dts_offset, packet, is_header, false);
+		else
+			flv_audio(&s, dts_offset, packet, is_header, false);
+	}
+
+	*output = data.bytes.array;
+	*size = data.bytes.num;
+}
+
+static void flv_packet_audio_ex_internal(struct encoder_packet *packet, enum audio_id_t codec_id, int32_t dts_offset,
+					 uint8_t **output, size_t *size, int type, size_t idx, bool in_place)
 {
 	struct array_output_data data;
 	struct serializer s;
@@ -406,6 +442,11 @@ void flv_packet_audio_ex(struct encoder_packet *packet, enum audio_id_t codec_id
 	if (is_multitrack)
 		header_metadata_size += 2; // w8 + w8
 
+	if (in_place) {
+		da_reserve(data.bytes, RTMP_MAX_HEADER_SIZE + 11 + (size_t)header_metadata_size + packet->size);
+		write_rtmp_chunk_scratch(&s);
+	}
+
 	s_w8(&s, RTMP_PACKET_TYPE_AUDIO);
 
 #ifdef DEBUG_TIMESTAMPS
@@ -433,15 +474,22 @@ void flv_packet_audio_ex(struct encoder_packet *packet, enum audio_id_t codec_id
 
 	s_write(&s, packet->data, packet->size);
 
-	write_previous_tag_size(&s);
+	if (!in_place)
+		write_previous_tag_size(&s);
 
 	*output = data.bytes.array;
 	*size = data.bytes.num;
 }
 
+void flv_packet_audio_ex(struct encoder_packet *packet, enum audio_id_t codec_id, int32_t dts_offset, uint8_t **output,
+			 size_t *size, int type, size_t idx)
+{
+	flv_packet_audio_ex_internal(packet, codec_id, dts_offset, output, size, type, idx, false);
+}
+
 // Y2023 spec
-void flv_packet_ex(struct encoder_packet *packet, enum video_id_t codec_id, int32_t dts_offset, uint8_t **output,
-		   size_t *size, int type, size_t idx)
+static void flv_packet_ex_internal(struct encoder_packet *packet, enum video_id_t codec_id, int32_t dts_offset,
+				   uint8_t **output, size_t *size, int type, size_t idx, bool in_place)
 {
 	struct array_output_data data;
 	struct serializer s;
@@ -462,6 +510,11 @@ void flv_packet_ex(struct encoder_packet *packet, enum video_id_t codec_id, int3
 	if (is_multitrack)
 		header_metadata_size += 2; // w8+w8
 
+	if (in_place) {
+		da_reserve(data.bytes, RTMP_MAX_HEADER_SIZE + 11 + (size_t)header_metadata_size + packet->size);
+		write_rtmp_chunk_scratch(&s);
+	}
+
 	s_w8(&s, RTMP_PACKET_TYPE_VIDEO);
 	s_wb24(&s, (uint32_t)packet->size + header_metadata_size);
 	s_wtimestamp(&s, time_ms);
@@ -494,12 +547,19 @@ void flv_packet_ex(struct encoder_packet *packet, enum video_id_t codec_id, int3
 	s_write(&s, packet->data, packet->size);
 
 	// packet tail
-	write_previous_tag_size(&s);
+	if (!in_place)
+		write_previous_tag_size(&s);
 
 	*output = data.bytes.array;
 	*size = data.bytes.num;
 }
 
+void flv_packet_ex(struct encoder_packet *packet, enum video_id_t codec_id, int32_t dts_offset, uint8_t **output,
+		   size_t *size, int type, size_t idx)
+{
+	flv_packet_ex_internal(packet, codec_id, dts_offset, output, size, type, idx, false);
+}
+
 void flv_packet_start(struct encoder_packet *packet, enum video_id_t codec, uint8_t **output, size_t *size, size_t idx)
 {
 	flv_packet_ex(packet, codec, 0, output, size, PACKETTYPE_SEQ_START, idx);
@@ -516,6 +576,17 @@ void flv_packet_frames(struct encoder_packet *packet, enum video_id_t codec, int
 	flv_packet_ex(packet, codec, dts_offset, output, size, packet_type, idx);
 }
 
+void flv_packet_frames_in_place(struct encoder_packet *packet, enum video_id_t codec, int32_t dts_offset,
+				uint8_t **output, size_t *size, size_t idx)
+{
+	int packet_type = PACKETTYPE_FRAMES;
+	// PACKETTYPE_FRAMESX is an optimization to avoid sending composition
+	// time offsets of 0. See Enhanced RTMP spec.
+	if ((codec == CODEC_H264 || codec == CODEC_HEVC) && packet->dts == packet->pts)
+		packet_type = PACKETTYPE_FRAMESX;
+	flv_packet_ex_internal(packet, codec, dts_offset, output, size, packet_type, idx, true);
+}
+
 void flv_packet_end(struct encoder_packet *packet, enum video_id_t codec, uint8_t **output, size_t *size, size_t idx)
 {
 	flv_packet_ex(packet, codec, 0, output, size, PACKETTYPE_SEQ_END, idx);
@@ -533,6 +604,12 @@ void flv_packet_audio_frames(struct encoder_packet *packet, enum audio_id_t code
 	flv_packet_audio_ex(packet, codec, dts_offset, output, size, AUDIO_PACKETTYPE_FRAMES, idx);
 }
 
+void flv_packet_audio_frames_in_place(struct encoder_packet *packet, enum audio_id_t codec, int32_t dts_offset,
+				      uint8_t **output, size_t *size, size_t idx)
+{
+	flv_packet_audio_ex_internal(packet, codec, dts_offset, output, size, AUDIO_PACKETTYPE_FRAMES, idx, true);
+}
+
 void flv_packet_metadata(enum video_id_t codec_id, uint8_t **output, size_t *size, int bits_per_raw_sample,
 			 uint8_t color_primaries, int color_trc, int color_space, int min_luminance, int max_luminance,
 			 size_t idx)
@@ -77,3 +77,14 @@ extern void flv_packet_audio_start(struct encoder_packet *packet, enum audio_id_
 				   size_t idx);
 extern void flv_packet_audio_frames(struct encoder_packet *packet, enum audio_id_t codec, int32_t dts_offset,
 				    uint8_t **output, size_t *size, size_t idx);
+
+/* Variants that build the tag behind RTMP_MAX_HEADER_SIZE writable scratch
+ * bytes and omit the trailing previousTagSize field, for sending with
+ * RTMP_WriteInPlace() without a second copy.  Not suitable for writing to
+ * FLV files. */
+extern void flv_packet_mux_in_place(struct encoder_packet *packet, int32_t dts_offset, uint8_t **output, size_t *size,
+				    bool is_header);
+extern void flv_packet_frames_in_place(struct encoder_packet *packet, enum video_id_t codec, int32_t dts_offset,
+				       uint8_t **output, size_t *size, size_t idx);
+extern void flv_packet_audio_frames_in_place(struct encoder_packet *packet, enum audio_id_t codec, int32_t dts_offset,
+					     uint8_t **output, size_t *size, size_t idx);
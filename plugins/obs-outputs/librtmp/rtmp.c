@@ -39,6 +39,20 @@
 #define MSG_NOSIGNAL 0
 #endif
 
+/* scatter/gather element for WritevN() */
+#ifdef _WIN32
+typedef WSABUF rtmp_iovec;
+#define RTMP_IOV_DATA(v)	((v).buf)
+#define RTMP_IOV_LEN(v)	((v).len)
+#else
+#include <sys/uio.h>
+typedef struct iovec rtmp_iovec;
+#define RTMP_IOV_DATA(v)	((v).iov_base)
+#define RTMP_IOV_LEN(v)	((v).iov_len)
+#endif
+
+#define RTMP_WRITEV_MAX	512
+
 #ifdef CRYPTO
 
 #ifdef __APPLE__
@@ -173,6 +187,7 @@ static void HandleClientBW(RTMP *r, const RTMPPacket *packet);
 
 static int ReadN(RTMP *r, char *buffer, int n);
 static int WriteN(RTMP *r, const char *buffer, int n);
+static int WritevN(RTMP *r, rtmp_iovec *iov, int iovcnt);
 
 static void DecodeTEA(AVal *key, AVal *text);
 
@@ -1629,6 +1644,82 @@ WriteN(RTMP *r, const char *buffer, int n)
     return n == 0;
 }
 
+/*
+ * Scatter/gather counterpart of WriteN(): sends every element of iov with as
+ * few system calls as the OS allows.  Only used on plain sockets; RTMPT, TLS
+ * and custom-send transports keep the per-chunk WriteN() path.
+ */
+static int
+WritevN(RTMP *r, rtmp_iovec *iov, int iovcnt)
+{
+    struct linger l;
+
+    while (iovcnt > 0)
+    {
+        int nBytes;
+        int cnt = iovcnt > RTMP_WRITEV_MAX ? RTMP_WRITEV_MAX : iovcnt;
+
+#ifdef _WIN32
+        DWORD sent = 0;
+
+        if (WSASend(r->m_sb.sb_socket, iov, cnt, &sent, 0, NULL, NULL) == 0)
+            nBytes = (int)sent;
+        else
+            nBytes = -1;
+#else
+        struct msghdr msg;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = cnt;
+        nBytes = (int)sendmsg(r->m_sb.sb_socket, &msg, MSG_NOSIGNAL);
+#endif
+
+        if (nBytes < 0)
+        {
+            int sockerr = GetSockError();
+            RTMP_Log(RTMP_LOGERROR, "%s, RTMP send error %d (%d elements)",
+                     __FUNCTION__, sockerr, iovcnt);
+
+            if (sockerr == EINTR && !RTMP_ctrlC)
+                continue;
+
+            r->last_error_code = sockerr;
+
+            /* see WriteN() for why the socket is force-closed here */
+            l.l_onoff = 1;
+            l.l_linger = 0;
+            setsockopt(r->m_sb.sb_socket, SOL_SOCKET, SO_LINGER, (char *)&l, sizeof(l));
+            RTMPSockBuf_Close(&r->m_sb);
+
+            RTMP_Close(r);
+            return FALSE;
+        }
+
+        if (nBytes == 0)
+            return FALSE;
+
+        /* skip past fully written elements, trim a partial one */
+        while (nBytes > 0)
+        {
+            if ((int)RTMP_IOV_LEN(*iov) <= nBytes)
+            {
+                nBytes -= (int)RTMP_IOV_LEN(*iov);
+                iov++;
+                iovcnt--;
+            }
+            else
+            {
+                RTMP_IOV_DATA(*iov) = (char *)RTMP_IOV_DATA(*iov) + nBytes;
+                RTMP_IOV_LEN(*iov) -= nBytes;
+                nBytes = 0;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
 #define SAVC(x)	static const AVal av_##x = AVC(#x)
 
 SAVC(app);
@@ -4236,6 +4327,70 @@ RTMP_SendPacket(RTMP *r, RTMPPacket *packet, int queue)
             toff = tbuf;
         }
     }
+    /* batch multi-chunk messages into a single scatter/gather send on plain
+     * sockets; continuation headers go into a side buffer so the body is not
+     * modified and no per-chunk send() calls are made */
+    else if (nSize > nChunkSize && !r->m_bCustomSend
+#if defined(CRYPTO) && !defined(NO_SSL)
+             && !r->m_sb.sb_ssl
+#endif
+            )
+    {
+        int chunks = (nSize + nChunkSize - 1) / nChunkSize;
+        rtmp_iovec *iov = malloc(sizeof(rtmp_iovec) * (chunks * 2) + (size_t)chunks * 7);
+        char *c3;
+        int niov = 0, ok;
+
+        if (!iov)
+            return FALSE;
+        c3 = (char *)(iov + chunks * 2);
+
+        RTMP_IOV_DATA(iov[niov]) = header;
+        RTMP_IOV_LEN(iov[niov]) = hSize + nChunkSize;
+        niov++;
+        nSize -= nChunkSize;
+        buffer += nChunkSize;
+        hSize = 0;
+
+        while (nSize > 0)
+        {
+            int c3size = 1;
+
+            if (nSize < nChunkSize)
+                nChunkSize = nSize;
+
+            *c3 = (0xc0 | c);
+            if (cSize)
+            {
+                int tmp = packet->m_nChannel - 64;
+                c3[1] = tmp & 0xff;
+                if (cSize == 2)
+                    c3[2] = tmp >> 8;
+                c3size += cSize;
+            }
+            if (t >= 0xffffff)
+            {
+                AMF_EncodeInt32(c3 + c3size, c3 + c3size + 4, t);
+                c3size += 4;
+            }
+
+            RTMP_IOV_DATA(iov[niov]) = c3;
+            RTMP_IOV_LEN(iov[niov]) = c3size;
+            niov++;
+            RTMP_IOV_DATA(iov[niov]) = buffer;
+            RTMP_IOV_LEN(iov[niov]) = nChunkSize;
+            niov++;
+
+            c3 += c3size;
+            nSize -= nChunkSize;
+            buffer += nChunkSize;
+        }
+
+        ok = WritevN(r, iov, niov);
+        free(iov);
+        if (!ok)
+            return FALSE;
+    }
     while (nSize + hSize)
     {
         int wrote;
@@ -5393,3 +5548,62 @@ RTMP_Write(RTMP *r, const char *buf, int size, int streamIdx)
     }
     return size+s2;
 }
+
+/*
+ * Like RTMP_Write(), but sends a single FLV tag without copying its body into
+ * an intermediate RTMPPacket.  The caller must prepend RTMP_MAX_HEADER_SIZE
+ * writable scratch bytes to the tag: RTMP_SendPacket() writes the first chunk
+ * header into the bytes immediately preceding the body and overwrites the
+ * trailing bytes of each already-sent chunk with the continuation headers, so
+ * the tag is chunked in place and the buffer contents are clobbered.  The
+ * trailing previousTagSize field is optional and ignored if present.
+ */
+int
+RTMP_WriteInPlace(RTMP *r, char *buf, int size, int streamIdx)
+{
+    RTMPPacket packet = { 0 };
+    char *tag = buf + RTMP_MAX_HEADER_SIZE;
+    int s2 = size - RTMP_MAX_HEADER_SIZE;
+
+    if (s2 < 11)
+    {
+        /* FLV tag too small */
+        return 0;
+    }
+
+    packet.m_nChannel = 0x04;	/* source channel */
+    packet.m_nInfoField2 = r->Link.streams[streamIdx].id;
+
+    packet.m_packetType = *tag++;
+    packet.m_nBodySize = AMF_DecodeInt24(tag);
+    tag += 3;
+    packet.m_nTimeStamp = AMF_DecodeInt24(tag);
+    tag += 3;
+    packet.m_nTimeStamp |= *tag++ << 24;
+    tag += 3;
+    s2 -= 11;
+
+    if ((int)packet.m_nBodySize > s2)
+    {
+        /* body extends past the end of the buffer */
+        return 0;
+    }
+
+    if (((packet.m_packetType == RTMP_PACKET_TYPE_AUDIO
+            || packet.m_packetType == RTMP_PACKET_TYPE_VIDEO) &&
+            !packet.m_nTimeStamp) || packet.m_packetType == RTMP_PACKET_TYPE_INFO)
+    {
+        packet.m_headerType = RTMP_PACKET_SIZE_LARGE;
+    }
+    else
+    {
+        packet.m_headerType = RTMP_PACKET_SIZE_MEDIUM;
+    }
+
+    packet.m_body = tag;
+
+    if (!RTMP_SendPacket(r, &packet, FALSE))
+        return -1;
+
+    return size;
+}
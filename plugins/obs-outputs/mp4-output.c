@@ -80,6 +80,20 @@ struct mp4_output {
 
 	/* Buffer for packets while we reinitialise the muxer after splitting */
 	DARRAY(struct encoder_packet) split_buffer;
+
+	/* Background finalization of the previous file during a split */
+	pthread_t finisher_thread;
+	bool finisher_active;
+};
+
+/* Everything the finisher thread needs to finalise the previous file
+ * after a split; ownership of the muxer, serializer and chapter names
+ * moves to the task. */
+struct split_finish_task {
+	struct mp4_output *out;
+	struct mp4_mux *muxer;
+	struct serializer serializer;
+	DARRAY(struct chapter) chapters;
 };
 
 static inline bool stopping(struct mp4_output *out)
@@ -139,10 +153,14 @@ static const char *mp4_output_name(void *unused)
 	return obs_module_text("MP4Output");
 }
 
+static void join_split_finisher(struct mp4_output *out);
+
 static void mp4_output_destroy(void *data)
 {
 	struct mp4_output *out = data;
 
+	join_split_finisher(out);
+
 	for (size_t i = 0; i < out->chapters.num; i++)
 		bfree(out->chapters.array[i].name);
 	da_free(out->chapters);
@@ -376,31 +394,63 @@ static void generate_filename(struct mp4_output *out, struct dstr *dst, bool ove
 	obs_data_release(settings);
 }
 
-static bool change_file(struct mp4_output *out, struct encoder_packet *pkt)
+static void *split_finisher_thread(void *data)
 {
+	struct split_finish_task *task = data;
+	struct mp4_output *out = task->out;
 	uint64_t start_time = os_gettime_ns();
 
+	os_set_thread_name("mp4 output: split finisher");
+
 	/* finalise file */
-	for (size_t i = 0; i < out->chapters.num; i++) {
-		struct chapter *chap = &out->chapters.array[i];
-		mp4_mux_add_chapter(out->muxer, chap->dts_usec, chap->name);
+	for (size_t i = 0; i < task->chapters.num; i++) {
+		struct chapter *chap = &task->chapters.array[i];
+		mp4_mux_add_chapter(task->muxer, chap->dts_usec, chap->name);
 	}
 
-	mp4_mux_finalise(out->muxer);
-
-	info("Waiting for file writer to finish...");
+	mp4_mux_finalise(task->muxer);
 
 	/* flush/close file and destroy old muxer */
-	buffered_file_serializer_free(&out->serializer);
-	mp4_mux_destroy(out->muxer);
+	buffered_file_serializer_free(&task->serializer);
+	mp4_mux_destroy(task->muxer);
 
-	for (size_t i = 0; i < out->chapters.num; i++)
-		bfree(out->chapters.array[i].name);
+	for (size_t i = 0; i < task->chapters.num; i++)
+		bfree(task->chapters.array[i].name);
 
-	da_clear(out->chapters);
+	da_free(task->chapters);
 
 	info("MP4 file split complete. Finalization took %" PRIu64 " ms.", (os_gettime_ns() - start_time) / 1000000);
 
+	bfree(task);
+	return NULL;
+}
+
+static void join_split_finisher(struct mp4_output *out)
+{
+	if (out->finisher_active) {
+		pthread_join(out->finisher_thread, NULL);
+		out->finisher_active = false;
+	}
+}
+
+static bool change_file(struct mp4_output *out, struct encoder_packet *pkt)
+{
+	/* at most one finalization in flight */
+	join_split_finisher(out);
+
+	/* hand the previous file off to the finisher thread so packet
+	 * ingestion never waits on the moov write or filesystem flush */
+	struct split_finish_task *task = bzalloc(sizeof(struct split_finish_task));
+	task->out = out;
+	task->muxer = out->muxer;
+	task->serializer = out->serializer;
+	da_move(task->chapters, out->chapters);
+
+	if (pthread_create(&out->finisher_thread, NULL, split_finisher_thread, task) == 0)
+		out->finisher_active = true;
+	else
+		split_finisher_thread(task);
+
 	/* open new file */
 	generate_filename(out, &out->path, out->allow_overwrite);
 	info("Changing output file to '%s'", out->path.array);
@@ -442,6 +492,9 @@ static void mp4_output_actual_stop(struct mp4_output *out, int code)
 {
 	os_atomic_set_bool(&out->active, false);
 
+	/* wait for any in-flight split finalization */
+	join_split_finisher(out);
+
 	uint64_t start_time = os_gettime_ns();
 
 	for (size_t i = 0; i < out->chapters.num; i++) {
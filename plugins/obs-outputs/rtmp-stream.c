@@ -98,6 +98,8 @@ static inline bool disconnected(struct rtmp_stream *stream)
 	return os_atomic_load_bool(&stream->disconnected);
 }
 
+static void stop_standby(struct rtmp_stream *stream);
+
 static void rtmp_stream_destroy(void *data)
 {
 	struct rtmp_stream *stream = data;
@@ -119,6 +121,8 @@ static void rtmp_stream_destroy(void *data)
 		}
 	}
 
+	stop_standby(stream);
+
 	RTMP_TLS_Free(&stream->rtmp);
 	free_packets(stream);
 	dstr_free(&stream->path);
@@ -127,6 +131,8 @@ static void rtmp_stream_destroy(void *data)
 	dstr_free(&stream->password);
 	dstr_free(&stream->encoder_name);
 	dstr_free(&stream->bind_ip);
+	dstr_free(&stream->standby_path);
+	pthread_mutex_destroy(&stream->standby_mutex);
 	os_event_destroy(stream->stop_event);
 	os_sem_destroy(stream->send_sem);
 	pthread_mutex_destroy(&stream->packets_mutex);
@@ -172,6 +178,11 @@ static void *rtmp_stream_create(obs_data_t *settings, obs_output_t *output)
 		goto fail;
 	}
 
+	if (pthread_mutex_init(&stream->standby_mutex, NULL) != 0) {
+		warn("Failed to initialize standby mutex");
+		goto fail;
+	}
+
 	if (os_event_init(&stream->buffer_space_available_event, OS_EVENT_TYPE_AUTO) != 0) {
 		warn("Failed to initialize write buffer event");
 		goto fail;
@@ -266,6 +277,199 @@ static bool process_recv_data(struct rtmp_stream *stream, size_t size)
 	return true;
 }
 
+static bool standby_connect(struct rtmp_stream *stream)
+{
+	RTMP *rtmp = &stream->standby_rtmp;
+	char *path = dstr_is_empty(&stream->standby_path) ? stream->path.array : stream->standby_path.array;
+
+	info("Connecting standby session to %s...", path);
+
+	RTMP_TLS_Free(rtmp);
+	RTMP_Init(rtmp);
+
+	if (!RTMP_SetupURL(rtmp, path))
+		return false;
+
+	RTMP_EnableWrite(rtmp);
+
+	set_rtmp_dstr(&rtmp->Link.pubUser, &stream->username);
+	set_rtmp_dstr(&rtmp->Link.pubPasswd, &stream->password);
+	set_rtmp_dstr(&rtmp->Link.flashVer, &stream->encoder_name);
+	rtmp->Link.swfUrl = rtmp->Link.tcUrl;
+
+	if (dstr_is_empty(&stream->bind_ip) || dstr_cmp(&stream->bind_ip, "default") == 0)
+		memset(&rtmp->m_bindIP, 0, sizeof(rtmp->m_bindIP));
+	else
+		netif_str_to_addr(&rtmp->m_bindIP.addr, &rtmp->m_bindIP.addrLen, stream->bind_ip.array);
+
+	if (rtmp->m_bindIP.addrLen == 0)
+		rtmp->m_bindIP.addrLen = stream->addrlen_hint;
+
+	RTMP_AddStream(rtmp, stream->key.array);
+
+	rtmp->m_outChunkSize = 4096;
+	rtmp->m_bSendChunkSizeInfo = true;
+	rtmp->m_bUseNagle = true;
+
+	if (!RTMP_Connect(rtmp, NULL))
+		return false;
+
+	if (!RTMP_ConnectStream(rtmp, 0)) {
+		RTMP_Close(rtmp);
+		return false;
+	}
+
+	info("Standby session to %s ready", path);
+	return true;
+}
+
+/* Answer server control traffic so the idle standby session stays alive.
+ * Called with the standby mutex held; the select() timeout bounds how long
+ * a failover can wait for the handoff. */
+static bool standby_service(struct rtmp_stream *stream)
+{
+	RTMP *rtmp = &stream->standby_rtmp;
+	struct timeval timeout = {0, 200000};
+	RTMPPacket packet = {0};
+	fd_set fds;
+	int ret;
+
+	FD_ZERO(&fds);
+	FD_SET(rtmp->m_sb.sb_socket, &fds);
+
+	ret = select((int)rtmp->m_sb.sb_socket + 1, &fds, NULL, NULL, &timeout);
+	if (ret == 0)
+		return RTMP_IsConnected(rtmp);
+	if (ret < 0)
+		return false;
+
+	if (!RTMP_ReadPacket(rtmp, &packet))
+		return false;
+
+	if (packet.m_body) {
+		RTMP_ClientPacket(rtmp, &packet);
+		RTMPPacket_Free(&packet);
+	}
+
+	return RTMP_IsConnected(rtmp);
+}
+
+static void *standby_thread(void *data)
+{
+	struct rtmp_stream *stream = data;
+	bool healthy;
+
+	os_set_thread_name("rtmp-stream: standby_thread");
+
+	while (!os_atomic_load_bool(&stream->standby_stop)) {
+		if (!os_atomic_load_bool(&stream->standby_connected)) {
+			if (standby_connect(stream)) {
+				os_atomic_set_bool(&stream->standby_connected, true);
+			} else {
+				warn("Standby connection failed, retrying in 10 seconds");
+				for (int i = 0; i < 100 && !os_atomic_load_bool(&stream->standby_stop); i++)
+					os_sleep_ms(100);
+			}
+			continue;
+		}
+
+		/* a failover may take the session while we wait for the
+		 * mutex, in which case there is nothing left to service */
+		pthread_mutex_lock(&stream->standby_mutex);
+		healthy = !os_atomic_load_bool(&stream->standby_connected) || standby_service(stream);
+		pthread_mutex_unlock(&stream->standby_mutex);
+
+		if (!healthy) {
+			warn("Standby connection lost, reconnecting");
+			pthread_mutex_lock(&stream->standby_mutex);
+			os_atomic_set_bool(&stream->standby_connected, false);
+			RTMP_Close(&stream->standby_rtmp);
+			pthread_mutex_unlock(&stream->standby_mutex);
+		}
+	}
+
+	return NULL;
+}
+
+static void start_standby(struct rtmp_stream *stream)
+{
+	os_atomic_set_bool(&stream->standby_stop, false);
+	os_atomic_set_bool(&stream->standby_connected, false);
+
+	if (pthread_create(&stream->standby_thread, NULL, standby_thread, stream) == 0)
+		stream->standby_thread_active = true;
+	else
+		warn("Failed to create standby thread");
+}
+
+static void stop_standby(struct rtmp_stream *stream)
+{
+	if (!stream->standby_thread_active)
+		return;
+
+	os_atomic_set_bool(&stream->standby_stop, true);
+	pthread_join(stream->standby_thread, NULL);
+	stream->standby_thread_active = false;
+
+	if (os_atomic_load_bool(&stream->standby_connected)) {
+		RTMP_Close(&stream->standby_rtmp);
+		os_atomic_set_bool(&stream->standby_connected, false);
+	}
+	RTMP_TLS_Free(&stream->standby_rtmp);
+}
+
+static void drop_frames(struct rtmp_stream *stream, const char *name, int highest_priority, bool pframes);
+
+/* Swap the warm standby session in for the failed primary.  Called from the
+ * send thread; on success the caller resends headers and keeps sending
+ * instead of disconnecting. */
+static bool try_failover(struct rtmp_stream *stream)
+{
+	RTMP *sb = &stream->standby_rtmp;
+
+	if (!stream->standby_enabled)
+		return false;
+
+	pthread_mutex_lock(&stream->standby_mutex);
+
+	if (!os_atomic_load_bool(&stream->standby_connected)) {
+		pthread_mutex_unlock(&stream->standby_mutex);
+		warn("Send failed with no standby connection ready");
+		return false;
+	}
+
+	info("Send failed, switching to warm standby session");
+
+	RTMP_Close(&stream->rtmp);
+	RTMP_TLS_Free(&stream->rtmp);
+
+	stream->rtmp = *sb;
+
+	/* sb_start points into the sockbuf embedded in the RTMP struct that
+	 * was just copied; rebase it into the copy */
+	if (sb->m_sb.sb_start)
+		stream->rtmp.m_sb.sb_start = stream->rtmp.m_sb.sb_buf + (sb->m_sb.sb_start - sb->m_sb.sb_buf);
+
+	memset(sb, 0, sizeof(*sb));
+	os_atomic_set_bool(&stream->standby_connected, false);
+
+	pthread_mutex_unlock(&stream->standby_mutex);
+
+	if (!dstr_is_empty(&stream->standby_path))
+		dstr_copy_dstr(&stream->path, &stream->standby_path);
+
+	/* the backup ingest needs headers and a clean GOP: resend the FLV
+	 * metadata/sequence headers and drop video until the next keyframe */
+	stream->sent_headers = false;
+
+	pthread_mutex_lock(&stream->packets_mutex);
+	drop_frames(stream, "failover", OBS_NAL_PRIORITY_HIGHEST, false);
+	pthread_mutex_unlock(&stream->packets_mutex);
+
+	stream->failover_count++;
+	return true;
+}
+
 #ifdef TEST_FRAMEDROPS
 static void droptest_cap_data_rate(struct rtmp_stream *stream, size_t size)
 {
@@ -405,13 +609,13 @@ static int send_packet(struct rtmp_stream *stream, struct encoder_packet *packet
 	if (handle_socket_read(stream))
 		return -1;
 
-	flv_packet_mux(packet, is_header ? 0 : stream->start_dts_offset, &data, &size, is_header);
+	flv_packet_mux_in_place(packet, is_header ? 0 : stream->start_dts_offset, &data, &size, is_header);
 
 #ifdef TEST_FRAMEDROPS
 	droptest_cap_data_rate(stream, size);
 #endif
 
-	ret = RTMP_Write(&stream->rtmp, (char *)data, (int)size, 0);
+	ret = RTMP_WriteInPlace(&stream->rtmp, (char *)data, (int)size, 0);
 	bfree(data);
 
 	if (is_header)
@@ -419,7 +623,8 @@ static int send_packet(struct rtmp_stream *stream, struct encoder_packet *packet
 	else
 		obs_encoder_packet_release(packet);
 
-	stream->total_bytes_sent += size;
+	if (size >= RTMP_MAX_HEADER_SIZE)
+		stream->total_bytes_sent += size - RTMP_MAX_HEADER_SIZE;
 	return ret;
 }
 
@@ -438,14 +643,22 @@ static int send_packet_ex(struct rtmp_stream *stream, struct encoder_packet *pac
 	} else if (is_footer) {
 		flv_packet_end(packet, stream->video_codec[idx], &data, &size, idx);
 	} else {
-		flv_packet_frames(packet, stream->video_codec[idx], stream->start_dts_offset, &data, &size, idx);
+		flv_packet_frames_in_place(packet, stream->video_codec[idx], stream->start_dts_offset, &data, &size,
+					   idx);
 	}
 
 #ifdef TEST_FRAMEDROPS
 	droptest_cap_data_rate(stream, size);
 #endif
 
-	ret = RTMP_Write(&stream->rtmp, (char *)data, (int)size, 0);
+	if (is_header || is_footer) {
+		ret = RTMP_Write(&stream->rtmp, (char *)data, (int)size, 0);
+		stream->total_bytes_sent += size;
+	} else {
+		ret = RTMP_WriteInPlace(&stream->rtmp, (char *)data, (int)size, 0);
+		if (size >= RTMP_MAX_HEADER_SIZE)
+			stream->total_bytes_sent += size - RTMP_MAX_HEADER_SIZE;
+	}
 	bfree(data);
 
 	if (is_header || is_footer) // manually created packets
@@ -453,7 +666,6 @@ static int send_packet_ex(struct rtmp_stream *stream, struct encoder_packet *pac
 	else
 		obs_encoder_packet_release(packet);
 
-	stream->total_bytes_sent += size;
 	return ret;
 }
 
@@ -468,11 +680,12 @@ static int send_audio_packet_ex(struct rtmp_stream *stream, struct encoder_packe
 
 	if (is_header) {
 		flv_packet_audio_start(packet, stream->audio_codec[idx], &data, &size, idx);
+		ret = RTMP_Write(&stream->rtmp, (char *)data, (int)size, 0);
 	} else {
-		flv_packet_audio_frames(packet, stream->audio_codec[idx], stream->start_dts_offset, &data, &size, idx);
+		flv_packet_audio_frames_in_place(packet, stream->audio_codec[idx], stream->start_dts_offset, &data,
+						 &size, idx);
+		ret = RTMP_WriteInPlace(&stream->rtmp, (char *)data, (int)size, 0);
 	}
-
-	ret = RTMP_Write(&stream->rtmp, (char *)data, (int)size, 0);
 	bfree(data);
 
 	if (is_header)
@@ -626,6 +839,72 @@ static void log_sndbuf_size(struct rtmp_stream *stream)
 }
 #endif
 
+/* Token-bucket pacer: without it a keyframe hits the socket as one burst,
+ * which overflows shallow buffers on high-RTT links and shows up as periodic
+ * packet loss.  The bucket refills at 1.5x the configured bitrate and holds
+ * half a second of burst, so pacing only trims the peaks; back-pressure from
+ * sleeping here feeds the normal frame-drop logic through queue growth. */
+static void pace_send(struct rtmp_stream *stream, size_t size)
+{
+	uint64_t now = os_gettime_ns();
+	uint64_t cap = stream->pace_rate_bytes_per_sec / 2;
+
+	if (!stream->pace_last_fill_ns) {
+		stream->pace_last_fill_ns = now;
+		stream->pace_tokens = cap;
+	}
+
+	stream->pace_tokens += (now - stream->pace_last_fill_ns) * stream->pace_rate_bytes_per_sec / 1000000000ULL;
+	if (stream->pace_tokens > cap)
+		stream->pace_tokens = cap;
+	stream->pace_last_fill_ns = now;
+
+	if (stream->pace_tokens >= size) {
+		stream->pace_tokens -= size;
+		return;
+	}
+
+	uint64_t wait_ns = (size - stream->pace_tokens) * 1000000000ULL / stream->pace_rate_bytes_per_sec;
+	if (wait_ns > 500000000ULL)
+		wait_ns = 500000000ULL;
+
+	stream->pace_tokens = 0;
+	stream->pace_last_fill_ns = now + wait_ns;
+	os_sleepto_ns(now + wait_ns);
+}
+
+static const uint64_t send_latency_bounds_ns[7] = {1000000,  5000000,   10000000, 25000000,
+						   50000000, 100000000, 250000000};
+
+static void record_send_latency(struct rtmp_stream *stream, uint64_t delta_ns)
+{
+	size_t i = 0;
+
+	while (i < 7 && delta_ns >= send_latency_bounds_ns[i])
+		i++;
+
+	stream->send_latency_buckets[i]++;
+	stream->send_latency_total_ns += delta_ns;
+	stream->send_latency_count++;
+	if (delta_ns > stream->send_latency_max_ns)
+		stream->send_latency_max_ns = delta_ns;
+}
+
+/* separates network stalls from encoder stalls when reading stream logs */
+static void log_send_latency(struct rtmp_stream *stream)
+{
+	const uint64_t *b = stream->send_latency_buckets;
+
+	if (!stream->send_latency_count)
+		return;
+
+	info("Send latency: avg %" PRIu64 " us, max %" PRIu64 " us, "
+	     "histogram (<1/<5/<10/<25/<50/<100/<250/>=250 ms): "
+	     "%" PRIu64 "/%" PRIu64 "/%" PRIu64 "/%" PRIu64 "/%" PRIu64 "/%" PRIu64 "/%" PRIu64 "/%" PRIu64,
+	     stream->send_latency_total_ns / stream->send_latency_count / 1000, stream->send_latency_max_ns / 1000,
+	     b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7]);
+}
+
 static void *send_thread(void *data)
 {
 	struct rtmp_stream *stream = data;
@@ -655,7 +934,10 @@ static void *send_thread(void *data)
 		}
 
 		if (!stream->sent_headers) {
-			if (!send_headers(stream)) {
+			bool headers_sent = send_headers(stream);
+			if (!headers_sent && try_failover(stream))
+				headers_sent = send_headers(stream);
+			if (!headers_sent) {
 				os_atomic_set_bool(&stream->disconnected, true);
 				break;
 			}
@@ -666,6 +948,11 @@ static void *send_thread(void *data)
 			dbr_frame.size = packet.size;
 		}
 
+		if (stream->pacing_enabled)
+			pace_send(stream, packet.size);
+
+		uint64_t send_beg = os_gettime_ns();
+
 		int sent;
 		if (packet.type == OBS_ENCODER_VIDEO &&
 		    (stream->video_codec[packet.track_idx] != CODEC_H264 ||
@@ -677,9 +964,14 @@ static void *send_thread(void *data)
 			sent = send_packet(stream, &packet, false);
 		}
 
+		record_send_latency(stream, os_gettime_ns() - send_beg);
+
 		if (sent < 0) {
-			os_atomic_set_bool(&stream->disconnected, true);
-			break;
+			if (!try_failover(stream)) {
+				os_atomic_set_bool(&stream->disconnected, true);
+				break;
+			}
+			continue;
 		}
 
 		if (stream->dbr_enabled) {
@@ -703,6 +995,8 @@ static void *send_thread(void *data)
 		send_footers(stream); // Y2023 spec
 	}
 
+	log_send_latency(stream);
+
 #ifdef _WIN32
 	log_sndbuf_size(stream);
 #endif
@@ -715,6 +1009,11 @@ static void *send_thread(void *data)
 		stream->rtmp.m_bCustomSend = false;
 	}
 
+	stop_standby(stream);
+
+	if (stream->failover_count)
+		info("Failed over to the standby connection %d time(s) this session", stream->failover_count);
+
 	set_output_error(stream);
 
 	RTMP_Close(&stream->rtmp);
@@ -1242,6 +1541,7 @@ static bool init_connect(struct rtmp_stream *stream)
 		pthread_join(stream->send_thread, NULL);
 	}
 
+	stop_standby(stream);
 	free_packets(stream);
 
 	service = obs_output_get_service(stream->output);
@@ -1312,6 +1612,46 @@ static bool init_connect(struct rtmp_stream *stream)
 		info("Dynamic bitrate enabled.  Dropped frames begone!");
 	}
 
+	stream->pacing_enabled = obs_data_get_bool(settings, OPT_PACING_ENABLED);
+	stream->pace_rate_bytes_per_sec = 0;
+	stream->pace_tokens = 0;
+	stream->pace_last_fill_ns = 0;
+	if (stream->pacing_enabled) {
+		uint64_t total_kbps = 0;
+
+		for (size_t i = 0; i < MAX_OUTPUT_VIDEO_ENCODERS; i++) {
+			obs_encoder_t *enc = obs_output_get_video_encoder2(stream->output, i);
+			if (!enc)
+				continue;
+
+			obs_data_t *enc_settings = obs_encoder_get_settings(enc);
+			total_kbps += (uint64_t)obs_data_get_int(enc_settings, "bitrate");
+			obs_data_release(enc_settings);
+		}
+		for (size_t i = 0; i < MAX_OUTPUT_AUDIO_ENCODERS; i++) {
+			obs_encoder_t *enc = obs_output_get_audio_encoder(stream->output, i);
+			if (!enc)
+				continue;
+
+			obs_data_t *enc_settings = obs_encoder_get_settings(enc);
+			total_kbps += (uint64_t)obs_data_get_int(enc_settings, "bitrate");
+			obs_data_release(enc_settings);
+		}
+
+		if (total_kbps) {
+			stream->pace_rate_bytes_per_sec = total_kbps * 1000 / 8 * 3 / 2;
+			info("Send pacing enabled (%" PRIu64 " bytes/sec)", stream->pace_rate_bytes_per_sec);
+		} else {
+			stream->pacing_enabled = false;
+			info("Send pacing disabled: could not determine total bitrate");
+		}
+	}
+
+	memset(stream->send_latency_buckets, 0, sizeof(stream->send_latency_buckets));
+	stream->send_latency_total_ns = 0;
+	stream->send_latency_max_ns = 0;
+	stream->send_latency_count = 0;
+
 	obs_data_release(vsettings);
 	obs_data_release(asettings);
 
@@ -1324,6 +1664,11 @@ static bool init_connect(struct rtmp_stream *stream)
 	bind_ip = obs_data_get_string(settings, OPT_BIND_IP);
 	dstr_copy(&stream->bind_ip, bind_ip);
 
+	stream->standby_enabled = obs_data_get_bool(settings, OPT_STANDBY_ENABLED);
+	dstr_copy(&stream->standby_path, obs_data_get_string(settings, OPT_STANDBY_URL));
+	dstr_depad(&stream->standby_path);
+	stream->failover_count = 0;
+
 	// Check that we have an IP Family set and that the setting length
 	// is 4 characters long so we don't capture ie. IPv4+IPv6
 	ip_family = obs_data_get_string(settings, OPT_IP_FAMILY);
@@ -1350,6 +1695,11 @@ static bool init_connect(struct rtmp_stream *stream)
 	stream->low_latency_mode = false;
 #endif
 
+	if (stream->standby_enabled && stream->new_socket_loop) {
+		warn("Disabling standby connection, not compatible with the new socket loop");
+		stream->standby_enabled = false;
+	}
+
 	obs_data_release(settings);
 	return true;
 }
@@ -1385,6 +1735,8 @@ static void *connect_thread(void *data)
 	if (ret != OBS_OUTPUT_SUCCESS) {
 		obs_output_signal_stop(stream->output, ret);
 		info("Connection to %s failed: %d", stream->path.array, ret);
+	} else if (stream->standby_enabled) {
+		start_standby(stream);
 	}
 
 	if (!stopping(stream))
@@ -1585,8 +1937,10 @@ static void check_to_drop_frames(struct rtmp_stream *stream, bool pframes)
 	}
 
 	if (num_packets < 5) {
-		if (!pframes)
+		if (!pframes) {
 			stream->congestion = 0.0f;
+			obs_output_submit_congestion_sample(stream->output, 0, 0);
+		}
 		return;
 	}
 
@@ -1599,6 +1953,7 @@ static void check_to_drop_frames(struct rtmp_stream *stream, bool pframes)
 
 	if (!pframes) {
 		stream->congestion = (float)buffer_duration_usec / (float)drop_threshold;
+		obs_output_submit_congestion_sample(stream->output, (uint64_t)buffer_duration_usec, 0);
 	}
 
 	/* alternatively, drop only pframes:
@@ -1723,7 +2078,10 @@ static void rtmp_stream_defaults(obs_data_t *defaults)
 #ifdef _WIN32
 	obs_data_set_default_bool(defaults, OPT_NEWSOCKETLOOP_ENABLED, false);
 	obs_data_set_default_bool(defaults, OPT_LOWLATENCY_ENABLED, false);
+	obs_data_set_default_bool(defaults, OPT_PACING_ENABLED, false);
 #endif
+	obs_data_set_default_bool(defaults, OPT_STANDBY_ENABLED, false);
+	obs_data_set_default_string(defaults, OPT_STANDBY_URL, "");
 }
 
 static obs_properties_t *rtmp_stream_properties(void *unused)
@@ -1761,6 +2119,9 @@ static obs_properties_t *rtmp_stream_properties(void *unused)
 	obs_properties_add_bool(props, OPT_NEWSOCKETLOOP_ENABLED, obs_module_text("RTMPStream.NewSocketLoop"));
 	obs_properties_add_bool(props, OPT_LOWLATENCY_ENABLED, obs_module_text("RTMPStream.LowLatencyMode"));
 #endif
+	obs_properties_add_bool(props, OPT_PACING_ENABLED, obs_module_text("RTMPStream.Pacing"));
+	obs_properties_add_bool(props, OPT_STANDBY_ENABLED, obs_module_text("RTMPStream.StandbyConnection"));
+	obs_properties_add_text(props, OPT_STANDBY_URL, obs_module_text("RTMPStream.StandbyURL"), OBS_TEXT_DEFAULT);
 
 	return props;
 }
@@ -13,6 +13,7 @@
 #include <Iphlpapi.h>
 #else
 #include <sys/ioctl.h>
+#include <sys/select.h>
 #endif
 
 #define do_log(level, format, ...) \
@@ -30,7 +31,10 @@
 #define OPT_IP_FAMILY "ip_family"
 #define OPT_NEWSOCKETLOOP_ENABLED "new_socket_loop_enabled"
 #define OPT_LOWLATENCY_ENABLED "low_latency_mode_enabled"
+#define OPT_PACING_ENABLED "pacing_enabled"
 #define OPT_METADATA_MULTITRACK "metadata_multitrack"
+#define OPT_STANDBY_ENABLED "standby_connection_enabled"
+#define OPT_STANDBY_URL "standby_url"
 
 //#define TEST_FRAMEDROPS
 //#define TEST_FRAMEDROPS_WITH_BITRATE_SHORTCUTS
@@ -113,6 +117,29 @@ struct rtmp_stream {
 	long dbr_inc_bitrate;
 	bool dbr_enabled;
 
+	/* token-bucket send pacing (smooths keyframe bursts) */
+	bool pacing_enabled;
+	uint64_t pace_rate_bytes_per_sec;
+	uint64_t pace_tokens;
+	uint64_t pace_last_fill_ns;
+
+	/* per-send latency histogram, logged when the stream stops */
+	uint64_t send_latency_buckets[8];
+	uint64_t send_latency_total_ns;
+	uint64_t send_latency_max_ns;
+	uint64_t send_latency_count;
+
+	/* warm standby connection, swapped in when the primary send fails */
+	bool standby_enabled;
+	struct dstr standby_path;
+	RTMP standby_rtmp;
+	pthread_t standby_thread;
+	bool standby_thread_active;
+	pthread_mutex_t standby_mutex;
+	volatile bool standby_connected;
+	volatile bool standby_stop;
+	int failover_count;
+
 	enum audio_id_t audio_codec[MAX_OUTPUT_AUDIO_ENCODERS];
 	enum video_id_t video_codec[MAX_OUTPUT_VIDEO_ENCODERS];
 
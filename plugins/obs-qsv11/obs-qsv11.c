@@ -840,7 +840,29 @@ static void *obs_qsv_create_tex(enum qsv_codec codec, obs_data_t *settings, obs_
 	obs_get_video_info(&ovi);
 
 	if (!adapters[ovi.adapter].is_intel) {
-		blog(LOG_INFO, ">>> app not on intel GPU, fall back to old qsv encoder");
+		/* Hybrid boxes (render on dGPU, encode on the Intel iGPU)
+		 * take the system-memory path below.  True zero-copy would
+		 * need the render textures created with cross-adapter share
+		 * flags in libobs-d3d11 and a second device on the Intel
+		 * adapter; plain shared handles cannot be opened across
+		 * adapters, so make the per-frame copy cost visible instead
+		 * of failing silently. */
+		bool intel_elsewhere = false;
+		for (size_t i = 0; i < adapter_count; i++) {
+			if (i != ovi.adapter && adapters[i].is_intel) {
+				intel_elsewhere = true;
+				break;
+			}
+		}
+
+		if (intel_elsewhere)
+			blog(LOG_INFO,
+			     ">>> rendering on adapter %u, QSV on a different adapter; "
+			     "frames will take a full-resolution system-memory copy each "
+			     "frame, fall back to old qsv encoder",
+			     ovi.adapter);
+		else
+			blog(LOG_INFO, ">>> app not on intel GPU, fall back to old qsv encoder");
 		return obs_encoder_create_rerouted(encoder, (const char *)fallback_id);
 	}
 
@@ -1124,12 +1124,10 @@ bool obs_module_load(void)
 		const char *path = obs_data_get_string(settings, S_FILE);
 
 		if (read && strcmp(path, "") != 0) {
-			if (!os_file_exists(path)) {
-				obs_missing_file_t *file = obs_missing_file_create(
-					path, missing_file_callback, OBS_MISSING_FILE_SOURCE, s->source, NULL);
+			obs_missing_file_t *file = obs_missing_file_create(path, missing_file_callback,
+									   OBS_MISSING_FILE_SOURCE, s->source, NULL);
 
-				obs_missing_files_add_file(files, file);
-			}
+			obs_missing_files_add_file_checked(files, file);
 		}
 
 		obs_data_release(settings);
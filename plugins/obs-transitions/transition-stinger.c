@@ -64,6 +64,26 @@ static float mix_b_fade_in_out(void *data, float t);
 static float mix_a_cross_fade(void *data, float t);
 static float mix_b_cross_fade(void *data, float t);
 
+static void stinger_preload(struct stinger_info *s)
+{
+	calldata_t cd = {0};
+
+	if (s->media_source)
+		proc_handler_call(obs_source_get_proc_handler(s->media_source), "preload_first_frame", &cd);
+	if (s->matte_source)
+		proc_handler_call(obs_source_get_proc_handler(s->matte_source), "preload_first_frame", &cd);
+
+	calldata_free(&cd);
+}
+
+/* lets frontends warm the decoder shortly before triggering the
+ * transition so even large stingers start without a hitch */
+static void stinger_prefetch_proc(void *data, calldata_t *cd)
+{
+	stinger_preload(data);
+	UNUSED_PARAMETER(cd);
+}
+
 static void stinger_update(void *data, obs_data_t *settings)
 {
 	struct stinger_info *s = data;
@@ -157,6 +177,10 @@ static void stinger_update(void *data, obs_data_t *settings)
 
 		obs_leave_graphics();
 	}
+
+	/* prime the decoder now instead of paying for open/seek/decode on
+	 * the render path of the first transition */
+	stinger_preload(s);
 }
 
 static void *stinger_create(obs_data_t *settings, obs_source_t *source)
@@ -187,6 +211,8 @@ static void *stinger_create(obs_data_t *settings, obs_source_t *source)
 	s->ep_matte_tex = gs_effect_get_param_by_name(s->matte_effect, "matte_tex");
 	s->ep_invert_matte = gs_effect_get_param_by_name(s->matte_effect, "invert_matte");
 
+	proc_handler_add(obs_source_get_proc_handler(source), "void prefetch()", stinger_prefetch_proc, s);
+
 	obs_transition_enable_fixed(s->source, true, 0);
 	obs_source_update(source, settings);
 	return s;
@@ -579,10 +605,7 @@ static void stinger_transition_stop(void *data)
 	if (s->matte_source)
 		obs_source_remove_active_child(s->source, s->matte_source);
 
-	proc_handler_t *ph = obs_source_get_proc_handler(s->media_source);
-
-	calldata_t cd = {0};
-	proc_handler_call(ph, "preload_first_frame", &cd);
+	stinger_preload(s);
 
 	s->transitioning = false;
 }
@@ -762,13 +785,11 @@ static obs_missing_files_t *stinger_missing_files(void *data)
 	const char *path = obs_data_get_string(settings, "path");
 
 	if (strcmp(path, "") != 0) {
-		if (!os_file_exists(path)) {
-			obs_missing_file_t *file = obs_missing_file_create(path, missing_file_callback,
-									   OBS_MISSING_FILE_SOURCE, s->source,
-									   (void *)"media_source");
+		obs_missing_file_t *file = obs_missing_file_create(path, missing_file_callback,
+								   OBS_MISSING_FILE_SOURCE, s->source,
+								   (void *)"media_source");
 
-			obs_missing_files_add_file(files, file);
-		}
+		obs_missing_files_add_file_checked(files, file);
 	}
 
 	const char *track_matte_path = obs_data_get_string(settings, "track_matte_path");
@@ -92,7 +92,9 @@ void VSTPlugin::createChannelBuffers(size_t count)
 {
 	cleanupChannelBuffers();
 
-	int blocksize = BLOCK_SIZE;
+	/* match the host tick size so a full tick is processed in one
+	 * processReplacing call instead of several small passes */
+	blockSize = std::max((size_t)BLOCK_SIZE, (size_t)AUDIO_OUTPUT_FRAMES);
 	numChannels = std::max((size_t)0, count);
 
 	if (numChannels > 0) {
@@ -100,8 +102,8 @@ void VSTPlugin::createChannelBuffers(size_t count)
 		outputs = (float **)bmalloc(sizeof(float *) * numChannels);
 		channelrefs = (float **)bmalloc(sizeof(float *) * numChannels);
 		for (size_t channel = 0; channel < numChannels; channel++) {
-			inputs[channel] = (float *)bmalloc(sizeof(float) * blocksize);
-			outputs[channel] = (float *)bmalloc(sizeof(float) * blocksize);
+			inputs[channel] = (float *)bmalloc(sizeof(float) * blockSize);
+			outputs[channel] = (float *)bmalloc(sizeof(float) * blockSize);
 		}
 	}
 }
@@ -201,8 +203,7 @@ void VSTPlugin::loadEffectFromPath(const std::string &path)
 		mTimeInfo.flags = kVstTempoValid | kVstNanosValid | kVstTransportPlaying;
 
 		effect->dispatcher(effect, effSetSampleRate, 0, 0, nullptr, sampleRate);
-		int blocksize = BLOCK_SIZE;
-		effect->dispatcher(effect, effSetBlockSize, 0, blocksize, nullptr, 0.0f);
+		effect->dispatcher(effect, effSetBlockSize, 0, (intptr_t)blockSize, nullptr, 0.0f);
 
 		effect->dispatcher(effect, effMainsChanged, 0, 1, nullptr, 0);
 
@@ -231,18 +232,26 @@ obs_audio_data *VSTPlugin::process(struct obs_audio_data *audio)
 	if (!effectValid)
 		return audio;
 
+	const uint64_t start = os_gettime_ns();
+
+	if (budgetBypassUntil) {
+		if (start < budgetBypassUntil)
+			return audio;
+		budgetBypassUntil = 0;
+	}
+
 	std::lock_guard<std::recursive_mutex> lock(lockEffect);
 
 	if (effect && effectReady && numChannels > 0) {
-		uint passes = (audio->frames + BLOCK_SIZE - 1) / BLOCK_SIZE;
-		uint extra = audio->frames % BLOCK_SIZE;
+		uint passes = (uint)((audio->frames + blockSize - 1) / blockSize);
+		uint extra = (uint)(audio->frames % blockSize);
 		for (uint pass = 0; pass < passes; pass++) {
-			uint frames = pass == passes - 1 && extra ? extra : BLOCK_SIZE;
-			silenceChannel(outputs, numChannels, BLOCK_SIZE);
+			uint frames = pass == passes - 1 && extra ? extra : (uint)blockSize;
+			silenceChannel(outputs, numChannels, (long)blockSize);
 
 			for (size_t d = 0; d < numChannels; d++) {
 				if (d < MAX_AV_PLANES && audio->data[d] != nullptr) {
-					channelrefs[d] = ((float *)audio->data[d]) + (pass * BLOCK_SIZE);
+					channelrefs[d] = ((float *)audio->data[d]) + (pass * blockSize);
 				} else {
 					channelrefs[d] = inputs[d];
 				}
@@ -259,6 +268,28 @@ obs_audio_data *VSTPlugin::process(struct obs_audio_data *audio)
 				}
 			}
 		}
+
+		/* budget: the real-time length of the audio just processed;
+		 * a plugin that repeatedly blows it would make the audio
+		 * thread fall behind and escalate buffering, so bypass it
+		 * for a while and try again */
+		const uint64_t elapsed = os_gettime_ns() - start;
+		const uint64_t budget =
+			util_mul_div64(audio->frames, 1000000000ULL, audio_output_get_sample_rate(obs_get_audio()));
+
+		if (elapsed > budget) {
+			if (++budgetOverruns >= 10) {
+				blog(LOG_WARNING,
+				     "VST Plug-in '%s': processing took %.1f ms for %.1f ms of audio %u times in a "
+				     "row; bypassing for 5 seconds",
+				     effectName, (double)elapsed / 1000000.0, (double)budget / 1000000.0,
+				     budgetOverruns);
+				budgetBypassUntil = start + 5000000000ULL;
+				budgetOverruns = 0;
+			}
+		} else {
+			budgetOverruns = 0;
+		}
 	}
 
 	return audio;
@@ -51,9 +51,16 @@ class VSTPlugin : public QObject {
 	float **outputs = nullptr;
 	float **channelrefs = nullptr;
 	size_t numChannels = 0;
+	size_t blockSize = BLOCK_SIZE;
 	void createChannelBuffers(size_t count);
 	void cleanupChannelBuffers();
 
+	/* processing-time budget: a plugin that repeatedly takes longer than
+	 * the real-time length of the audio it processes is bypassed for a
+	 * while instead of stalling the audio pipeline (see process()) */
+	uint32_t budgetOverruns = 0;
+	uint64_t budgetBypassUntil = 0;
+
 	EditorWidget *editorWidget = nullptr;
 	bool editorOpened = false;
 
@@ -113,6 +113,7 @@ static void obs_x264_defaults(obs_data_t *settings)
 	obs_data_set_default_string(settings, "profile", "");
 	obs_data_set_default_string(settings, "tune", "");
 	obs_data_set_default_string(settings, "x264opts", "");
+	obs_data_set_default_bool(settings, "sliced_threads", false);
 	obs_data_set_default_bool(settings, "repeat_headers", false);
 }
 
@@ -136,6 +137,7 @@ static inline void add_strings(obs_property_t *list, const char *const *strings)
 #define TEXT_TUNE obs_module_text("Tune")
 #define TEXT_NONE obs_module_text("None")
 #define TEXT_X264_OPTS obs_module_text("EncoderOptions")
+#define TEXT_SLICED_THREADS obs_module_text("SlicedThreads")
 
 static bool use_bufsize_modified(obs_properties_t *ppts, obs_property_t *p, obs_data_t *settings)
 {
@@ -214,6 +216,9 @@ static obs_properties_t *obs_x264_props(void *unused)
 	obs_properties_add_bool(props, "vfr", TEXT_VFR);
 #endif
 
+	p = obs_properties_add_bool(props, "sliced_threads", TEXT_SLICED_THREADS);
+	obs_property_set_long_description(p, obs_module_text("SlicedThreads.ToolTip"));
+
 	obs_properties_add_text(props, "x264opts", TEXT_X264_OPTS, OBS_TEXT_DEFAULT);
 
 	headers = obs_properties_add_bool(props, "repeat_headers", "repeat_headers");
@@ -368,6 +373,7 @@ static void update_params(struct obs_x264 *obsx264, obs_data_t *settings, const
 	int height = (int)obs_encoder_get_height(obsx264->encoder);
 	int bf = (int)obs_data_get_int(settings, "bf");
 	bool use_bufsize = obs_data_get_bool(settings, "use_bufsize");
+	bool sliced_threads = obs_data_get_bool(settings, "sliced_threads");
 	bool cbr_override = obs_data_get_bool(settings, "cbr");
 	enum rate_control rc;
 
@@ -429,6 +435,12 @@ static void update_params(struct obs_x264 *obsx264, obs_data_t *settings, const
 	if (obs_data_has_user_value(settings, "bf"))
 		obsx264->params.i_bframe = bf;
 
+	/* encode each frame as horizontal slabs in parallel (slices of one
+	 * frame) instead of pipelining whole frames across threads; scales
+	 * further at very large canvas sizes and drops the frame-threading
+	 * latency.  x264opts can still override this below */
+	obsx264->params.b_sliced_threads = sliced_threads;
+
 	static const char *const smpte170m = "smpte170m";
 	static const char *const bt709 = "bt709";
 	const char *colorprim = bt709;
@@ -503,10 +515,11 @@ static void update_params(struct obs_x264 *obsx264, obs_data_t *settings, const
 		     "\tfps_den:      %d\n"
 		     "\twidth:        %d\n"
 		     "\theight:       %d\n"
-		     "\tkeyint:       %d\n",
+		     "\tkeyint:       %d\n"
+		     "\tsliced:       %s\n",
 		     rate_control, obsx264->params.rc.i_vbv_max_bitrate, obsx264->params.rc.i_vbv_buffer_size,
 		     (int)obsx264->params.rc.f_rf_constant, voi->fps_num, voi->fps_den, width, height,
-		     obsx264->params.i_keyint_max);
+		     obsx264->params.i_keyint_max, obsx264->params.b_sliced_threads ? "true" : "false");
 	}
 }
 
@@ -861,5 +874,5 @@ struct obs_encoder_info obs_x264_encoder = {
 	.get_extra_data = obs_x264_extra_data,
 	.get_sei_data = obs_x264_sei,
 	.get_video_info = obs_x264_video_info,
-	.caps = OBS_ENCODER_CAP_DYN_BITRATE | OBS_ENCODER_CAP_ROI,
+	.caps = OBS_ENCODER_CAP_DYN_BITRATE | OBS_ENCODER_CAP_ROI | OBS_ENCODER_CAP_RECONFIGURE,
 };
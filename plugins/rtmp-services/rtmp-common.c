@@ -1,9 +1,12 @@
 #include <util/platform.h>
+#include <util/threading.h>
 #include <util/dstr.h>
 #include <obs-module.h>
 #include <jansson.h>
 #include <obs-config.h>
 
+#include <sys/stat.h>
+
 #include "rtmp-format-ver.h"
 #include "service-specific/twitch.h"
 #include "service-specific/nimotv.h"
@@ -376,24 +379,68 @@ static json_t *open_json_file(const char *file)
 	return list;
 }
 
+/* The services catalog is immutable between updater runs, so parse it once
+ * and hand out shared references instead of re-reading ~120KB of JSON every
+ * time the settings UI or an encoder configuration queries it.  The cache
+ * is keyed on the file identity (path, mtime, size) so a catalog replaced
+ * by the service updater at runtime is picked up on the next access. */
+static pthread_mutex_t services_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static json_t *services_cache = NULL;
+static struct dstr services_cache_file = {0};
+static time_t services_cache_mtime = 0;
+static off_t services_cache_size = 0;
+
+static json_t *get_cached_services(const char *file, const struct stat *st)
+{
+	json_t *list;
+
+	if (services_cache && dstr_cmp(&services_cache_file, file) == 0 &&
+	    services_cache_mtime == st->st_mtime && services_cache_size == st->st_size)
+		return json_incref(services_cache);
+
+	list = open_json_file(file);
+	if (!list)
+		return NULL;
+
+	json_decref(services_cache);
+	services_cache = list;
+	dstr_copy(&services_cache_file, file);
+	services_cache_mtime = st->st_mtime;
+	services_cache_size = st->st_size;
+
+	return json_incref(list);
+}
+
+void release_services_file_cache(void)
+{
+	pthread_mutex_lock(&services_cache_mutex);
+	json_decref(services_cache);
+	services_cache = NULL;
+	dstr_free(&services_cache_file);
+	services_cache_mtime = 0;
+	services_cache_size = 0;
+	pthread_mutex_unlock(&services_cache_mutex);
+}
+
 static json_t *open_services_file(void)
 {
-	char *file;
 	json_t *root = NULL;
 
-	file = obs_module_config_path("services.json");
-	if (file) {
-		root = open_json_file(file);
+	pthread_mutex_lock(&services_cache_mutex);
+
+	for (int i = 0; i < 2 && !root; i++) {
+		char *file = (i == 0) ? obs_module_config_path("services.json") : obs_module_file("services.json");
+		struct stat st;
+
+		if (!file)
+			continue;
+
+		if (os_stat(file, &st) == 0)
+			root = get_cached_services(file, &st);
 		bfree(file);
 	}
 
-	if (!root) {
-		file = obs_module_file("services.json");
-		if (file) {
-			root = open_json_file(file);
-			bfree(file);
-		}
-	}
+	pthread_mutex_unlock(&services_cache_mutex);
 
 	return root;
 }
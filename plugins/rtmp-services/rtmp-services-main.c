@@ -24,6 +24,7 @@ static const char *RTMP_SERVICES_URL = (const char *)SERVICES_URL;
 
 extern struct obs_service_info rtmp_common_service;
 extern struct obs_service_info rtmp_custom_service;
+extern void release_services_file_cache(void);
 
 static update_info_t *update_info = NULL;
 static struct dstr module_name = {0};
@@ -130,6 +131,7 @@ bool obs_module_load(void)
 void obs_module_unload(void)
 {
 	update_info_destroy(update_info);
+	release_services_file_cache();
 	unload_twitch_data();
 	free_showroom_data();
 	unload_dacast_data();
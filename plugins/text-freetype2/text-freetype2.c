@@ -17,6 +17,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <obs-module.h>
 #include <util/platform.h>
+#include <util/threading.h>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <sys/stat.h>
@@ -91,6 +92,31 @@ static struct obs_source_info freetype2_source_info_v2 = {
 };
 
 static bool plugin_initialized = false;
+static pthread_t font_list_thread;
+static bool font_list_thread_valid = false;
+static os_event_t *font_list_ready = NULL;
+
+static void *load_font_list_thread(void *unused)
+{
+	os_set_thread_name("text-ft2: font enumeration");
+
+	if (!load_cached_os_font_list())
+		load_os_font_list();
+
+	os_event_signal(font_list_ready);
+
+	UNUSED_PARAMETER(unused);
+	return NULL;
+}
+
+/* Blocks until the font list is available; only font resolution needs the
+ * list, so sources can be created and startup can proceed while enumeration
+ * is still running in the background. */
+static void wait_for_font_list(void)
+{
+	if (font_list_thread_valid)
+		os_event_wait(font_list_ready);
+}
 
 static void init_plugin(void)
 {
@@ -104,8 +130,15 @@ static void init_plugin(void)
 		return;
 	}
 
-	if (!load_cached_os_font_list())
-		load_os_font_list();
+	/* Enumerating a font-heavy system can take seconds; do it off-thread
+	 * so creating the first text source does not stall the loader. */
+	if (os_event_init(&font_list_ready, OS_EVENT_TYPE_MANUAL) == 0 &&
+	    pthread_create(&font_list_thread, NULL, load_font_list_thread, NULL) == 0) {
+		font_list_thread_valid = true;
+	} else {
+		if (!load_cached_os_font_list())
+			load_os_font_list();
+	}
 
 	plugin_initialized = true;
 }
@@ -127,6 +160,10 @@ bool obs_module_load()
 void obs_module_unload(void)
 {
 	if (plugin_initialized) {
+		if (font_list_thread_valid) {
+			pthread_join(font_list_thread, NULL);
+			os_event_destroy(font_list_ready);
+		}
 		free_os_font_list();
 		FT_Done_FreeType(ft2_lib);
 	}
@@ -318,6 +355,9 @@ static void ft2_video_tick(void *data, float seconds)
 static bool init_font(struct ft2_source *srcdata)
 {
 	FT_Long index;
+
+	wait_for_font_list();
+
 	const char *path =
 		get_font_path(srcdata->font_name, srcdata->font_size, srcdata->font_style, srcdata->font_flags, &index);
 	if (!path)
@@ -569,12 +609,10 @@ static obs_missing_files_t *ft2_missing_files(void *data)
 	const char *path = obs_data_get_string(settings, "text_file");
 
 	if (read && strcmp(path, "") != 0) {
-		if (!os_file_exists(path)) {
-			obs_missing_file_t *file = obs_missing_file_create(path, missing_file_callback,
-									   OBS_MISSING_FILE_SOURCE, s->src, NULL);
+		obs_missing_file_t *file = obs_missing_file_create(path, missing_file_callback,
+								   OBS_MISSING_FILE_SOURCE, s->src, NULL);
 
-			obs_missing_files_add_file(files, file);
-		}
+		obs_missing_files_add_file_checked(files, file);
 	}
 
 	obs_data_release(settings);
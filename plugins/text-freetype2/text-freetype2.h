@@ -59,6 +59,7 @@ struct ft2_source {
 
 	uint8_t *texbuf;
 	gs_vertbuffer_t *vbuf;
+	uint32_t vbuf_capacity;
 
 	gs_effect_t *draw_effect;
 	bool outline_text, drop_shadow;
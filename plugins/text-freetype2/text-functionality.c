@@ -71,18 +71,33 @@ void set_up_vertex_buffer(struct ft2_source *srcdata)
 	srcdata->cy = srcdata->max_h;
 
 	obs_enter_graphics();
-	if (srcdata->vbuf != NULL) {
-		gs_vertbuffer_t *tmpvbuf = srcdata->vbuf;
-		srcdata->vbuf = NULL;
-		gs_vertexbuffer_destroy(tmpvbuf);
-	}
 
 	if (*srcdata->text == 0) {
+		if (srcdata->vbuf != NULL) {
+			gs_vertbuffer_t *tmpvbuf = srcdata->vbuf;
+			srcdata->vbuf = NULL;
+			srcdata->vbuf_capacity = 0;
+			gs_vertexbuffer_destroy(tmpvbuf);
+		}
 		obs_leave_graphics();
 		return;
 	}
 
-	srcdata->vbuf = create_uv_vbuffer((uint32_t)wcslen(srcdata->text) * 6, true);
+	/* the buffer only grows; small text edits (tickers, chat logs
+	 * trimmed to a line count) just refill and reflush the existing
+	 * buffer, the draw call only uses wcslen(text) * 6 vertices */
+	const uint32_t num_verts = (uint32_t)wcslen(srcdata->text) * 6;
+	if (srcdata->vbuf != NULL && num_verts > srcdata->vbuf_capacity) {
+		gs_vertbuffer_t *tmpvbuf = srcdata->vbuf;
+		srcdata->vbuf = NULL;
+		srcdata->vbuf_capacity = 0;
+		gs_vertexbuffer_destroy(tmpvbuf);
+	}
+
+	if (srcdata->vbuf == NULL) {
+		srcdata->vbuf = create_uv_vbuffer(num_verts, true);
+		srcdata->vbuf_capacity = num_verts;
+	}
 
 	if (srcdata->custom_width <= 100)
 		goto skip_word_wrap;
@@ -332,14 +347,18 @@ void cache_glyphs(struct ft2_source *srcdata, wchar_t *cache_glyphs)
 
 		obs_enter_graphics();
 
-		if (srcdata->tex != NULL) {
-			gs_texture_t *tmp_texture = srcdata->tex;
-			srcdata->tex = NULL;
-			gs_texture_destroy(tmp_texture);
+		/* the atlas texture is created once and re-uploaded in
+		 * place when new glyphs land in it; text changes that only
+		 * use already-cached glyphs upload nothing at all.  the
+		 * upload is the whole buffer because dynamic texture maps
+		 * discard previous contents */
+		if (srcdata->tex == NULL) {
+			srcdata->tex = gs_texture_create(texbuf_w, texbuf_h, GS_A8, 1,
+							 (const uint8_t **)&srcdata->texbuf, GS_DYNAMIC);
+		} else {
+			gs_texture_set_image(srcdata->tex, srcdata->texbuf, texbuf_w, false);
 		}
 
-		srcdata->tex = gs_texture_create(texbuf_w, texbuf_h, GS_A8, 1, (const uint8_t **)&srcdata->texbuf, 0);
-
 		obs_leave_graphics();
 	}
 }
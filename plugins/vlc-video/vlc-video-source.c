@@ -53,6 +53,9 @@ enum behavior {
 	BEHAVIOR_ALWAYS_PLAY,
 };
 
+/* number of video frames handed to libVLC's vmem callbacks in rotation */
+#define VLC_VIDEO_FRAME_POOL 3
+
 struct vlc_source {
 	obs_source_t *source;
 
@@ -60,6 +63,11 @@ struct vlc_source {
 	libvlc_media_list_player_t *media_list_player;
 
 	struct obs_source_frame frame;
+	/* ring of decode targets; VLC keeps several pictures in flight, so
+	 * decoding into a single buffer would overwrite a frame libobs is
+	 * still reading */
+	struct obs_source_frame frame_pool[VLC_VIDEO_FRAME_POOL];
+	size_t frame_pool_idx;
 	struct obs_source_audio audio;
 	size_t audio_capacity;
 
@@ -346,6 +354,8 @@ static void vlcs_destroy(void *data)
 
 	bfree((void *)c->audio.data[0]);
 	obs_source_frame_free(&c->frame);
+	for (size_t i = 0; i < VLC_VIDEO_FRAME_POOL; i++)
+		obs_source_frame_free(&c->frame_pool[i]);
 
 	free_files(&c->files);
 	pthread_mutex_destroy(&c->mutex);
@@ -355,18 +365,22 @@ static void vlcs_destroy(void *data)
 static void *vlcs_video_lock(void *data, void **planes)
 {
 	struct vlc_source *c = data;
-	for (size_t i = 0; i < MAX_AV_PLANES && c->frame.data[i] != NULL; i++)
-		planes[i] = c->frame.data[i];
-	return NULL;
+	struct obs_source_frame *frame = &c->frame_pool[c->frame_pool_idx];
+
+	c->frame_pool_idx = (c->frame_pool_idx + 1) % VLC_VIDEO_FRAME_POOL;
+
+	for (size_t i = 0; i < MAX_AV_PLANES && frame->data[i] != NULL; i++)
+		planes[i] = frame->data[i];
+	return frame;
 }
 
 static void vlcs_video_display(void *data, void *picture)
 {
 	struct vlc_source *c = data;
-	c->frame.timestamp = (uint64_t)libvlc_clock_() * 1000ULL - time_start;
-	obs_source_output_video(c->source, &c->frame);
+	struct obs_source_frame *frame = picture;
 
-	UNUSED_PARAMETER(picture);
+	frame->timestamp = (uint64_t)libvlc_clock_() * 1000ULL - time_start;
+	obs_source_output_video(c->source, frame);
 }
 
 static void calculate_display_size(struct vlc_source *c, unsigned *width, unsigned *height)
@@ -450,6 +464,19 @@ static unsigned vlcs_video_format(void **p_data, char *chroma, unsigned *width,
 		range = c->frame.full_range ? VIDEO_RANGE_FULL : VIDEO_RANGE_PARTIAL;
 		video_format_get_parameters_for_format(VIDEO_CS_DEFAULT, range, new_format, c->frame.color_matrix,
 						       c->frame.color_range_min, c->frame.color_range_max);
+
+		for (size_t p = 0; p < VLC_VIDEO_FRAME_POOL; p++) {
+			struct obs_source_frame *pf = &c->frame_pool[p];
+
+			obs_source_frame_free(pf);
+			obs_source_frame_init(pf, new_format, *width, *height);
+			pf->format = new_format;
+			pf->full_range = new_range;
+			memcpy(pf->color_matrix, c->frame.color_matrix, sizeof(pf->color_matrix));
+			memcpy(pf->color_range_min, c->frame.color_range_min, sizeof(pf->color_range_min));
+			memcpy(pf->color_range_max, c->frame.color_range_max, sizeof(pf->color_range_max));
+		}
+		c->frame_pool_idx = 0;
 	}
 
 	while (c->frame.data[i]) {
@@ -1126,11 +1153,11 @@ static obs_missing_files_t *vlcs_missingfiles(void *data)
 		const char *path = obs_data_get_string(item, "value");
 
 		if (strcmp(path, "") != 0) {
-			if (!os_file_exists(path) && strstr(path, "://") == NULL) {
+			if (strstr(path, "://") == NULL) {
 				obs_missing_file_t *file = obs_missing_file_create(
 					path, missing_file_callback, OBS_MISSING_FILE_SOURCE, source, (void *)path);
 
-				obs_missing_files_add_file(missing_files, file);
+				obs_missing_files_add_file_checked(missing_files, file);
 			}
 		}
 
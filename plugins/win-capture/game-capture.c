@@ -114,6 +114,19 @@ struct game_capture_config {
 	bool capture_audio;
 };
 
+/* small pool of OBS-owned capture textures kept across re-hooks and
+ * resolution changes, so alt-tabbing or toggling resolution reuses an
+ * existing allocation instead of stalling on destroy/create */
+#define GC_TEXTURE_POOL_SIZE 3
+
+struct gc_pooled_texture {
+	gs_texture_t *texture;
+	uint32_t cx;
+	uint32_t cy;
+	enum gs_color_format format;
+	bool dynamic;
+};
+
 typedef DPI_AWARENESS_CONTEXT(WINAPI *PFN_SetThreadDpiAwarenessContext)(DPI_AWARENESS_CONTEXT);
 typedef DPI_AWARENESS_CONTEXT(WINAPI *PFN_GetThreadDpiAwarenessContext)(VOID);
 typedef DPI_AWARENESS_CONTEXT(WINAPI *PFN_GetWindowDpiAwarenessContext)(HWND);
@@ -159,8 +172,10 @@ struct game_capture {
 
 	ipc_pipe_server_t pipe;
 	gs_texture_t *texture;
+	bool texture_shared;
 	gs_texture_t *extra_texture;
 	gs_texrender_t *extra_texrender;
+	struct gc_pooled_texture texture_pool[GC_TEXTURE_POOL_SIZE];
 	bool is_10a2_2100pq;
 	bool linear_sample;
 	struct hook_info *global_hook_info;
@@ -309,6 +324,76 @@ static inline float hook_rate_to_float(enum hook_rate rate)
 	}
 }
 
+/* all pool calls are made inside obs_enter_graphics() */
+
+static gs_texture_t *texture_pool_acquire(struct game_capture *gc, uint32_t cx, uint32_t cy,
+					  enum gs_color_format format, bool dynamic)
+{
+	for (size_t i = 0; i < GC_TEXTURE_POOL_SIZE; i++) {
+		struct gc_pooled_texture *slot = &gc->texture_pool[i];
+
+		if (slot->texture && slot->cx == cx && slot->cy == cy && slot->format == format &&
+		    slot->dynamic == dynamic) {
+			gs_texture_t *texture = slot->texture;
+			slot->texture = NULL;
+			return texture;
+		}
+	}
+
+	return gs_texture_create(cx, cy, format, 1, NULL, dynamic ? GS_DYNAMIC : 0);
+}
+
+static void texture_pool_release(struct game_capture *gc, gs_texture_t *texture, bool dynamic)
+{
+	struct gc_pooled_texture *slot = NULL;
+
+	if (!texture)
+		return;
+
+	for (size_t i = 0; i < GC_TEXTURE_POOL_SIZE && !slot; i++) {
+		if (!gc->texture_pool[i].texture)
+			slot = &gc->texture_pool[i];
+	}
+
+	if (!slot) {
+		/* evict the oldest entry */
+		slot = &gc->texture_pool[0];
+		gs_texture_destroy(slot->texture);
+		memmove(&gc->texture_pool[0], &gc->texture_pool[1],
+			(GC_TEXTURE_POOL_SIZE - 1) * sizeof(struct gc_pooled_texture));
+		slot = &gc->texture_pool[GC_TEXTURE_POOL_SIZE - 1];
+	}
+
+	slot->texture = texture;
+	slot->cx = gs_texture_get_width(texture);
+	slot->cy = gs_texture_get_height(texture);
+	slot->format = gs_texture_get_color_format(texture);
+	slot->dynamic = dynamic;
+}
+
+static void texture_pool_free(struct game_capture *gc)
+{
+	for (size_t i = 0; i < GC_TEXTURE_POOL_SIZE; i++) {
+		gs_texture_destroy(gc->texture_pool[i].texture);
+		gc->texture_pool[i].texture = NULL;
+	}
+}
+
+/* shared textures wrap the game's resource and must be closed on unhook;
+ * everything OBS-owned goes back to the pool instead */
+static void release_capture_textures(struct game_capture *gc)
+{
+	if (gc->texture_shared)
+		gs_texture_destroy(gc->texture);
+	else
+		texture_pool_release(gc, gc->texture, true);
+	gc->texture = NULL;
+	gc->texture_shared = false;
+
+	texture_pool_release(gc, gc->extra_texture, false);
+	gc->extra_texture = NULL;
+}
+
 static void stop_capture(struct game_capture *gc)
 {
 	ipc_pipe_server_free(&gc->pipe);
@@ -343,12 +428,9 @@ static void stop_capture(struct game_capture *gc)
 	close_handle(&gc->texture_mutexes[1]);
 
 	obs_enter_graphics();
-	gs_texrender_destroy(gc->extra_texrender);
-	gc->extra_texrender = NULL;
-	gs_texture_destroy(gc->extra_texture);
-	gc->extra_texture = NULL;
-	gs_texture_destroy(gc->texture);
-	gc->texture = NULL;
+	/* the texrender is format-stable (GS_RGBA16F) and survives
+	 * re-hooks; it is destroyed with the source */
+	release_capture_textures(gc);
 	obs_leave_graphics();
 
 	if (gc->active)
@@ -400,6 +482,9 @@ static void game_capture_destroy(void *data)
 
 	obs_enter_graphics();
 	cursor_data_free(&gc->cursor_data);
+	texture_pool_free(gc);
+	gs_texrender_destroy(gc->extra_texrender);
+	gc->extra_texrender = NULL;
 	obs_leave_graphics();
 
 	dstr_free(&gc->title);
@@ -798,6 +883,8 @@ static inline bool init_hook_info(struct game_capture *gc)
 	gc->global_hook_info->force_shmem = gc->config.force_shmem;
 	gc->global_hook_info->UNUSED_use_scale = false;
 	gc->global_hook_info->allow_srgb_alias = true;
+	gc->global_hook_info->throttle_on_consume = gc->config.limit_framerate;
+	gc->global_hook_info->frames_consumed = 0;
 	reset_frame_interval(gc);
 
 	obs_enter_graphics();
@@ -1538,21 +1625,15 @@ static inline bool init_shmem_capture(struct game_capture *gc)
 	const enum gs_color_format format = convert_16bit ? GS_BGRA : convert_format(dxgi_format);
 
 	obs_enter_graphics();
-	gs_texrender_destroy(gc->extra_texrender);
-	gc->extra_texrender = NULL;
-	gs_texture_destroy(gc->extra_texture);
-	gc->extra_texture = NULL;
-	gs_texture_destroy(gc->texture);
-	gc->texture = NULL;
-	gs_texture_t *const texture = gs_texture_create(gc->cx, gc->cy, format, 1, NULL, GS_DYNAMIC);
-	obs_leave_graphics();
+	release_capture_textures(gc);
+	gs_texture_t *const texture = texture_pool_acquire(gc, gc->cx, gc->cy, format, true);
 
 	bool success = texture != NULL;
 	if (success) {
 		const bool linear_sample = format != GS_R10G10B10A2;
 
-		gs_texrender_t *extra_texrender = NULL;
-		if (!linear_sample) {
+		gs_texrender_t *extra_texrender = gc->extra_texrender;
+		if (!linear_sample && !extra_texrender) {
 			extra_texrender = gs_texrender_create(GS_RGBA16F, GS_ZS_NONE);
 			success = extra_texrender != NULL;
 			if (!success)
@@ -1565,16 +1646,18 @@ static inline bool init_shmem_capture(struct game_capture *gc)
 			gc->convert_16bit = convert_16bit;
 
 			gc->texture = texture;
+			gc->texture_shared = false;
 			gc->extra_texture = NULL;
 			gc->extra_texrender = extra_texrender;
 			gc->linear_sample = linear_sample;
 			gc->copy_texture = copy_shmem_tex;
 		} else {
-			gs_texture_destroy(texture);
+			texture_pool_release(gc, texture, true);
 		}
 	} else {
 		warn("init_shmem_capture: failed to create texture");
 	}
+	obs_leave_graphics();
 
 	return success;
 }
@@ -1582,12 +1665,7 @@ static inline bool init_shmem_capture(struct game_capture *gc)
 static inline bool init_shtex_capture(struct game_capture *gc)
 {
 	obs_enter_graphics();
-	gs_texrender_destroy(gc->extra_texrender);
-	gc->extra_texrender = NULL;
-	gs_texture_destroy(gc->extra_texture);
-	gc->extra_texture = NULL;
-	gs_texture_destroy(gc->texture);
-	gc->texture = NULL;
+	release_capture_textures(gc);
 	gs_texture_t *const texture = gs_texture_open_shared(gc->shtex_data->tex_handle);
 	bool success = texture != NULL;
 	if (success) {
@@ -1596,17 +1674,18 @@ static inline bool init_shtex_capture(struct game_capture *gc)
 		enum gs_color_format linear_format = ten_bit_srgb ? GS_RGBA16F : gs_generalize_format(format);
 		const bool linear_sample = (linear_format == format);
 		gs_texture_t *extra_texture = NULL;
-		gs_texrender_t *extra_texrender = NULL;
+		gs_texrender_t *extra_texrender = gc->extra_texrender;
 		if (!linear_sample) {
 			if (ten_bit_srgb) {
-				extra_texrender = gs_texrender_create(linear_format, GS_ZS_NONE);
+				if (!extra_texrender)
+					extra_texrender = gs_texrender_create(linear_format, GS_ZS_NONE);
 				success = extra_texrender != NULL;
 				if (!success)
 					warn("init_shtex_capture: failed to create extra texrender");
 			} else {
-				extra_texture = gs_texture_create(gs_texture_get_width(texture),
-								  gs_texture_get_height(texture), linear_format, 1,
-								  NULL, 0);
+				extra_texture = texture_pool_acquire(gc, gs_texture_get_width(texture),
+								     gs_texture_get_height(texture), linear_format,
+								     false);
 				success = extra_texture != NULL;
 				if (!success)
 					warn("init_shtex_capture: failed to create extra texture");
@@ -1615,6 +1694,7 @@ static inline bool init_shtex_capture(struct game_capture *gc)
 
 		if (success) {
 			gc->texture = texture;
+			gc->texture_shared = true;
 			gc->linear_sample = linear_sample;
 			gc->extra_texture = extra_texture;
 			gc->extra_texrender = extra_texrender;
@@ -1807,6 +1887,11 @@ static void game_capture_tick(void *data, float seconds)
 				obs_leave_graphics();
 			}
 
+			/* signal the hook that this frame was consumed so it
+			 * can copy the next one */
+			if (gc->global_hook_info)
+				gc->global_hook_info->frames_consumed++;
+
 			if (gc->config.cursor) {
 				DPI_AWARENESS_CONTEXT previous = NULL;
 				if (gc->get_window_dpi_awareness_context != NULL) {
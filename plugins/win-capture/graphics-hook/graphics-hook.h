@@ -185,9 +185,32 @@ static inline bool frame_ready(uint64_t interval)
 	return true;
 }
 
+static inline bool consume_ready(void)
+{
+	static uint32_t last_consumed = 0;
+	uint32_t consumed = global_hook_info->frames_consumed;
+
+	if (consumed == last_consumed) {
+		return false;
+	}
+
+	last_consumed = consumed;
+	return true;
+}
+
 static inline bool capture_ready(void)
 {
-	return capture_active() && frame_ready(global_hook_info->frame_interval);
+	if (!capture_active()) {
+		return false;
+	}
+
+	/* only copy frames OBS will actually consume rather than copying on
+	 * an interval derived from the canvas framerate */
+	if (global_hook_info->throttle_on_consume) {
+		return consume_ready();
+	}
+
+	return frame_ready(global_hook_info->frame_interval);
 }
 
 static inline bool capture_stopped(void)
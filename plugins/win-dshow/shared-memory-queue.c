@@ -29,6 +29,7 @@ struct video_queue {
 	bool ready_to_read;
 	struct queue_header *header;
 	uint64_t *ts[3];
+	volatile uint32_t *seq[3];
 	uint8_t *frame[3];
 	long last_inc;
 	int dup_counter;
@@ -36,7 +37,14 @@ struct video_queue {
 };
 
 #define ALIGN_SIZE(size, align) size = (((size) + (align - 1)) & (~(align - 1)))
+
+/* per-frame header: a timestamp followed by a sequence counter.  The
+ * sequence is odd while the writer is copying into the slot, and bumped to
+ * the next even value once the frame is complete, so readers can detect a
+ * writer that lapped them mid-read.  Slots written by older writers keep a
+ * sequence of zero, which always validates. */
 #define FRAME_HEADER_SIZE 32
+#define FRAME_SEQ_OFFSET 8
 
 video_queue_t *video_queue_create(uint32_t cx, uint32_t cy, uint64_t interval)
 {
@@ -97,6 +105,7 @@ video_queue_t *video_queue_create(uint32_t cx, uint32_t cy, uint64_t interval)
 	for (size_t i = 0; i < 3; i++) {
 		uint32_t off = offset_frame[i];
 		vq.ts[i] = (uint64_t *)(((uint8_t *)vq.header) + off);
+		vq.seq[i] = (volatile uint32_t *)(((uint8_t *)vq.header) + off + FRAME_SEQ_OFFSET);
 		vq.frame[i] = ((uint8_t *)vq.header) + off + FRAME_HEADER_SIZE;
 	}
 	pvq = malloc(sizeof(vq));
@@ -156,17 +165,40 @@ void video_queue_get_info(video_queue_t *vq, uint32_t *cx, uint32_t *cy, uint64_
 
 #define get_idx(inc) ((unsigned long)inc % 3)
 
+static inline void copy_plane(uint8_t *dst, const uint8_t *src, size_t width, size_t height, size_t linesize)
+{
+	if (linesize == width) {
+		memcpy(dst, src, width * height);
+		return;
+	}
+
+	/* strip the linesize padding so padded strides cannot write past
+	 * the cx*cy*3/2 that the slot was sized for */
+	for (size_t y = 0; y < height; y++) {
+		memcpy(dst, src, width);
+		dst += width;
+		src += linesize;
+	}
+}
+
 void video_queue_write(video_queue_t *vq, uint8_t **data, uint32_t *linesize, uint64_t timestamp)
 {
 	struct queue_header *qh = vq->header;
 	long inc = ++qh->write_idx;
 
 	unsigned long idx = get_idx(inc);
-	size_t size = linesize[0] * qh->cy;
+	size_t width = qh->cx;
+	size_t height = qh->cy;
+
+	*vq->seq[idx] = (uint32_t)inc * 2 + 1;
+	MemoryBarrier();
 
 	*vq->ts[idx] = timestamp;
-	memcpy(vq->frame[idx], data[0], size);
-	memcpy(vq->frame[idx] + size, data[1], size / 2);
+	copy_plane(vq->frame[idx], data[0], width, height, linesize[0]);
+	copy_plane(vq->frame[idx] + width * height, data[1], width, height / 2, linesize[1]);
+
+	MemoryBarrier();
+	*vq->seq[idx] = (uint32_t)inc * 2;
 
 	qh->read_idx = inc;
 	qh->state = SHARED_QUEUE_STATE_READY;
@@ -183,6 +215,7 @@ enum queue_state video_queue_state(video_queue_t *vq)
 		for (size_t i = 0; i < 3; i++) {
 			size_t off = vq->header->offsets[i];
 			vq->ts[i] = (uint64_t *)(((uint8_t *)vq->header) + off);
+			vq->seq[i] = (volatile uint32_t *)(((uint8_t *)vq->header) + off + FRAME_SEQ_OFFSET);
 			vq->frame[i] = ((uint8_t *)vq->header) + off + FRAME_HEADER_SIZE;
 		}
 		vq->ready_to_read = true;
@@ -209,10 +242,27 @@ bool video_queue_read(video_queue_t *vq, nv12_scale_t *scale, void *dst, uint64_
 		vq->last_inc = inc;
 	}
 
-	unsigned long idx = get_idx(inc);
+	for (int retry = 0; retry < 3; retry++) {
+		unsigned long idx = get_idx(inc);
+		uint32_t seq = *vq->seq[idx];
+
+		if (seq & 1) {
+			/* writer is mid-copy; use the previous frame */
+			inc--;
+			continue;
+		}
+
+		*ts = *vq->ts[idx];
+		nv12_do_scale(scale, dst, vq->frame[idx]);
 
-	*ts = *vq->ts[idx];
+		MemoryBarrier();
+		if (*vq->seq[idx] == seq)
+			return true;
+
+		/* the writer lapped us mid-read; retry with the newest
+		 * frame */
+		inc = qh->read_idx;
+	}
 
-	nv12_do_scale(scale, dst, vq->frame[idx]);
 	return true;
 }
@@ -694,6 +694,173 @@ struct PropertiesData {
 	}
 };
 
+/* Shared snapshot of the last device enumeration.  COM enumeration can
+ * take seconds with certain capture drivers installed, and it used to run
+ * synchronously inside GetDShowProperties, freezing the UI every time a
+ * properties dialog opened.  The dialog is now built immediately from the
+ * snapshot while a worker thread re-enumerates; if the device list
+ * actually changed, obs_source_update_properties tells the frontend to
+ * rebuild the open dialog. */
+struct DeviceEnumCache {
+	CriticalSection mutex;
+	vector<VideoDevice> devices;
+	vector<AudioDevice> audioDevices;
+	bool valid = false;
+	volatile long refreshing = 0;
+};
+
+static DeviceEnumCache enumCache;
+
+static bool VideoDeviceListsMatch(const vector<VideoDevice> &a, const vector<VideoDevice> &b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	for (size_t i = 0; i < a.size(); i++) {
+		if (a[i].name != b[i].name || a[i].path != b[i].path)
+			return false;
+	}
+
+	return true;
+}
+
+static bool AudioDeviceListsMatch(const vector<AudioDevice> &a, const vector<AudioDevice> &b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	for (size_t i = 0; i < a.size(); i++) {
+		if (a[i].name != b[i].name || a[i].path != b[i].path)
+			return false;
+	}
+
+	return true;
+}
+
+struct DeviceEnumRefreshParams {
+	OBSWeakSource source;
+};
+
+static DWORD CALLBACK DeviceEnumRefreshThread(LPVOID ptr)
+{
+	DeviceEnumRefreshParams *params = (DeviceEnumRefreshParams *)ptr;
+
+	os_set_thread_name("win-dshow: device enum refresh");
+
+	CoInitialize(nullptr);
+
+	vector<VideoDevice> devices;
+	vector<AudioDevice> audioDevices;
+	Device::EnumVideoDevices(devices);
+	Device::EnumAudioDevices(audioDevices);
+
+	bool changed;
+	{
+		CriticalScope scope(enumCache.mutex);
+		changed = !enumCache.valid || !VideoDeviceListsMatch(enumCache.devices, devices) ||
+			  !AudioDeviceListsMatch(enumCache.audioDevices, audioDevices);
+		enumCache.devices = std::move(devices);
+		enumCache.audioDevices = std::move(audioDevices);
+		enumCache.valid = true;
+	}
+
+	os_atomic_set_long(&enumCache.refreshing, 0);
+
+	if (changed) {
+		OBSSource source = OBSGetStrongRef(params->source);
+		if (source)
+			obs_source_update_properties(source);
+	}
+
+	CoUninitialize();
+
+	delete params;
+	return 0;
+}
+
+static void FillEnumCache(PropertiesData *data, DShowInput *input)
+{
+	bool haveSnapshot;
+	{
+		CriticalScope scope(enumCache.mutex);
+		haveSnapshot = enumCache.valid;
+		if (haveSnapshot) {
+			data->devices = enumCache.devices;
+			data->audioDevices = enumCache.audioDevices;
+		}
+	}
+
+	if (!haveSnapshot) {
+		/* very first dialog: no snapshot yet, enumerate here */
+		Device::EnumVideoDevices(data->devices);
+		Device::EnumAudioDevices(data->audioDevices);
+
+		CriticalScope scope(enumCache.mutex);
+		enumCache.devices = data->devices;
+		enumCache.audioDevices = data->audioDevices;
+		enumCache.valid = true;
+		return;
+	}
+
+	if (os_atomic_set_long(&enumCache.refreshing, 1) != 0)
+		return;
+
+	DeviceEnumRefreshParams *params = new DeviceEnumRefreshParams;
+	if (input)
+		params->source = OBSGetWeakRef(input->source);
+
+	WinHandle refreshThread = CreateThread(nullptr, 0, DeviceEnumRefreshThread, params, 0, nullptr);
+	if (!refreshThread) {
+		os_atomic_set_long(&enumCache.refreshing, 0);
+		delete params;
+	}
+}
+
+/* Activation used to re-enumerate every DirectShow device and all of its
+ * capabilities just to find the one device being started, which can take
+ * seconds with certain drivers installed and serialized multiple capture
+ * sources coming up at once.  Look the device up in the shared enumeration
+ * snapshot first and only fall back to a full enumeration when it is not
+ * there (first activation or a newly attached device). */
+static bool GetCachedVideoDevice(VideoDevice &dev, const char *encoded_id)
+{
+	DeviceId deviceId;
+	if (!DecodeDeviceId(deviceId, encoded_id))
+		return false;
+
+	{
+		CriticalScope scope(enumCache.mutex);
+		if (enumCache.valid) {
+			for (const VideoDevice &cur : enumCache.devices) {
+				if (deviceId.name == cur.name && deviceId.path == cur.path) {
+					dev = cur;
+					return true;
+				}
+			}
+		}
+	}
+
+	vector<VideoDevice> devices;
+	vector<AudioDevice> audioDevices;
+	Device::EnumVideoDevices(devices);
+	Device::EnumAudioDevices(audioDevices);
+
+	bool found = false;
+	for (const VideoDevice &cur : devices) {
+		if (deviceId.name == cur.name && deviceId.path == cur.path) {
+			dev = cur;
+			found = true;
+			break;
+		}
+	}
+
+	CriticalScope scope(enumCache.mutex);
+	enumCache.devices = std::move(devices);
+	enumCache.audioDevices = std::move(audioDevices);
+	enumCache.valid = true;
+	return found;
+}
+
 static inline bool ConvertRes(int &cx, int &cy, const char *res)
 {
 	return sscanf(res, "%dx%d", &cx, &cy) == 2;
@@ -869,11 +1036,9 @@ bool DShowInput::UpdateVideoConfig(obs_data_t *settings)
 		return false;
 	}
 
-	PropertiesData data;
-	Device::EnumVideoDevices(data.devices);
 	VideoDevice dev;
-	if (!data.GetDevice(dev, video_device_id.c_str())) {
-		blog(LOG_WARNING, "%s: data.GetDevice failed", obs_source_get_name(source));
+	if (!GetCachedVideoDevice(dev, video_device_id.c_str())) {
+		blog(LOG_WARNING, "%s: GetCachedVideoDevice failed", obs_source_get_name(source));
 		return false;
 	}
 
@@ -1843,6 +2008,7 @@ static obs_properties_t *GetDShowProperties(void *obj)
 	PropertiesData *data = new PropertiesData;
 
 	data->input = input;
+	FillEnumCache(data, input);
 
 	obs_properties_set_param(ppts, data, PropertiesDataDestroy);
 
@@ -1851,7 +2017,6 @@ static obs_properties_t *GetDShowProperties(void *obj)
 
 	obs_property_set_modified_callback(p, DeviceSelectionChanged);
 
-	Device::EnumVideoDevices(data->devices);
 	for (const VideoDevice &device : data->devices)
 		AddDevice(p, device);
 
@@ -1918,8 +2083,6 @@ static obs_properties_t *GetDShowProperties(void *obj)
 	/* ------------------------------------- */
 	/* audio settings */
 
-	Device::EnumAudioDevices(data->audioDevices);
-
 	p = obs_properties_add_list(ppts, AUDIO_OUTPUT_MODE, TEXT_AUDIO_MODE, OBS_COMBO_TYPE_LIST,
 				    OBS_COMBO_FORMAT_INT);
 	obs_property_list_add_int(p, TEXT_MODE_CAPTURE, (int64_t)AudioMode::Capture);
@@ -28,6 +28,7 @@ using namespace std;
 #define OPT_USE_DEVICE_TIMING "use_device_timing"
 #define OPT_WINDOW "window"
 #define OPT_PRIORITY "priority"
+#define OPT_LOW_LATENCY "low_latency"
 
 WASAPINotify *GetNotify();
 static void GetWASAPIDefaults(obs_data_t *settings);
@@ -166,6 +167,7 @@ class WASAPISource {
 	DWORD process_id = 0;
 	const SourceType sourceType;
 	std::atomic<bool> useDeviceTiming = false;
+	std::atomic<bool> lowLatency = false;
 	std::atomic<bool> isDefaultDevice = false;
 	std::atomic<bool> sawBadTimestamp = false;
 	bool hooked = false;
@@ -242,7 +244,8 @@ class WASAPISource {
 					    const string device_id);
 	static ComPtr<IAudioClient> InitClient(IMMDevice *device, SourceType type, DWORD process_id,
 					       PFN_ActivateAudioInterfaceAsync activate_audio_interface_async,
-					       speaker_layout &speakers, audio_format &format, uint32_t &sampleRate);
+					       bool lowLatency, speaker_layout &speakers, audio_format &format,
+					       uint32_t &sampleRate);
 	static void InitFormat(const WAVEFORMATEX *wfex, enum speaker_layout &speakers, enum audio_format &format,
 			       uint32_t &sampleRate);
 	static void ClearBuffer(IMMDevice *device);
@@ -254,6 +257,7 @@ class WASAPISource {
 	struct UpdateParams {
 		string device_id;
 		bool useDeviceTiming;
+		bool lowLatency;
 		bool isDefaultDevice;
 		window_priority priority;
 		string window_class;
@@ -473,6 +477,7 @@ WASAPISource::UpdateParams WASAPISource::BuildUpdateParams(obs_data_t *settings)
 	WASAPISource::UpdateParams params;
 	params.device_id = obs_data_get_string(settings, OPT_DEVICE_ID);
 	params.useDeviceTiming = obs_data_get_bool(settings, OPT_USE_DEVICE_TIMING);
+	params.lowLatency = obs_data_get_bool(settings, OPT_LOW_LATENCY);
 	params.isDefaultDevice = _strcmpi(params.device_id.c_str(), "default") == 0;
 	params.priority = (window_priority)obs_data_get_int(settings, "priority");
 	params.window_class.clear();
@@ -505,6 +510,7 @@ void WASAPISource::UpdateSettings(UpdateParams &&params)
 {
 	device_id = std::move(params.device_id);
 	useDeviceTiming = params.useDeviceTiming;
+	lowLatency = params.lowLatency;
 	isDefaultDevice = params.isDefaultDevice;
 	priority = params.priority;
 	window_class = std::move(params.window_class);
@@ -527,8 +533,9 @@ void WASAPISource::LogSettings()
 		blog(LOG_INFO,
 		     "[win-wasapi: '%s'] update settings:\n"
 		     "\tdevice id: %s\n"
-		     "\tuse device timing: %d",
-		     obs_source_get_name(source), device_id.c_str(), (int)useDeviceTiming);
+		     "\tuse device timing: %d\n"
+		     "\tlow latency: %d",
+		     obs_source_get_name(source), device_id.c_str(), (int)useDeviceTiming, (int)lowLatency);
 	}
 }
 
@@ -539,7 +546,7 @@ void WASAPISource::Update(obs_data_t *settings)
 	const bool restart = (sourceType == SourceType::ProcessOutput)
 				     ? ((priority != params.priority) || (window_class != params.window_class) ||
 					(title != params.title) || (executable != params.executable))
-				     : (device_id.compare(params.device_id) != 0);
+				     : ((device_id.compare(params.device_id) != 0) || (lowLatency != params.lowLatency));
 
 	UpdateSettings(std::move(params));
 	LogSettings();
@@ -555,7 +562,7 @@ void WASAPISource::OnWindowChanged(obs_data_t *settings)
 	const bool restart = (sourceType == SourceType::ProcessOutput)
 				     ? ((priority != params.priority) || (window_class != params.window_class) ||
 					(title != params.title) || (executable != params.executable))
-				     : (device_id.compare(params.device_id) != 0);
+				     : ((device_id.compare(params.device_id) != 0) || (lowLatency != params.lowLatency));
 
 	UpdateSettings(std::move(params));
 
@@ -632,7 +639,8 @@ static DWORD GetSpeakerChannelMask(speaker_layout layout)
 
 ComPtr<IAudioClient> WASAPISource::InitClient(IMMDevice *device, SourceType type, DWORD process_id,
 					      PFN_ActivateAudioInterfaceAsync activate_audio_interface_async,
-					      speaker_layout &speakers, audio_format &format, uint32_t &samples_per_sec)
+					      bool lowLatency, speaker_layout &speakers, audio_format &format,
+					      uint32_t &samples_per_sec)
 {
 	WAVEFORMATEXTENSIBLE wfextensible;
 	CoTaskMemPtr<WAVEFORMATEX> wfex;
@@ -707,6 +715,32 @@ ComPtr<IAudioClient> WASAPISource::InitClient(IMMDevice *device, SourceType type
 	DWORD flags = AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
 	if (type != SourceType::Input)
 		flags |= AUDCLNT_STREAMFLAGS_LOOPBACK;
+
+	if (lowLatency) {
+		/* Request the smallest shared-mode engine period the device
+		 * supports (typically 2.67 ms vs. the 10 ms default) via
+		 * IAudioClient3.  Fall back to the default period if the
+		 * interface or the small period is unavailable (e.g. older
+		 * Windows, exclusive-mode-only drivers, loopback). */
+		ComQIPtr<IAudioClient3> client3(client.Get());
+		UINT32 defaultPeriod, fundamentalPeriod, minPeriod, maxPeriod;
+
+		res = client3 ? client3->GetSharedModeEnginePeriod(pFormat, &defaultPeriod, &fundamentalPeriod,
+								   &minPeriod, &maxPeriod)
+			      : E_NOINTERFACE;
+		if (SUCCEEDED(res))
+			res = client3->InitializeSharedAudioStream(flags, minPeriod, pFormat, nullptr);
+		if (SUCCEEDED(res)) {
+			blog(LOG_INFO, "WASAPI: Using small-period capture (%" PRIu32 " frames)", minPeriod);
+			return client;
+		}
+
+		blog(LOG_WARNING,
+		     "WASAPI: Small-period initialization failed "
+		     "(0x%lX), falling back to default period",
+		     res);
+	}
+
 	res = client->Initialize(AUDCLNT_SHAREMODE_SHARED, flags, BUFFER_TIME_100NS, 0, pFormat, nullptr);
 	if (FAILED(res))
 		throw HRError("Failed to initialize audio client", res);
@@ -835,7 +869,7 @@ void WASAPISource::Initialize()
 	ResetEvent(receiveSignal);
 
 	ComPtr<IAudioClient> temp_client = InitClient(device, sourceType, process_id, activate_audio_interface_async,
-						      speakers, format, sampleRate);
+						      lowLatency, speakers, format, sampleRate);
 	if (sourceType == SourceType::DeviceOutput)
 		ClearBuffer(device);
 	ComPtr<IAudioCaptureClient> temp_capture = InitCapture(temp_client, receiveSignal);
@@ -1038,6 +1072,23 @@ bool WASAPISource::ProcessCaptureData()
 
 #define RECONNECT_INTERVAL 3000
 
+/* Windows 7 does not reliably signal the capture event for loopback
+ * clients, so those waits need a 10 ms poll there; later versions wake
+ * correctly, and polling every loopback source a hundred times a second
+ * is pure scheduler churn on many-device setups */
+static bool LoopbackNeedsPolling()
+{
+	static const bool polling = [] {
+		struct win_version_info win8 = {};
+		win8.major = 6;
+		win8.minor = 2;
+		struct win_version_info ver;
+		get_win_ver(&ver);
+		return win_version_compare(&ver, &win8) < 0;
+	}();
+	return polling;
+}
+
 DWORD WINAPI WASAPISource::CaptureThread(LPVOID param)
 {
 	os_set_thread_name("win-wasapi: capture thread");
@@ -1078,9 +1129,11 @@ DWORD WINAPI WASAPISource::CaptureThread(LPVOID param)
 		bool stop = false;
 		bool reconnect = false;
 		do {
-			/* Windows 7 does not seem to wake up for LOOPBACK */
-			const DWORD dwMilliseconds =
-				((sigs == active_sigs) && (source->sourceType != SourceType::Input)) ? 10 : INFINITE;
+			const DWORD dwMilliseconds = ((sigs == active_sigs) &&
+						      (source->sourceType != SourceType::Input) &&
+						      LoopbackNeedsPolling())
+							     ? 10
+							     : INFINITE;
 
 			const DWORD ret = WaitForMultipleObjects(sig_count, sigs, false, dwMilliseconds);
 			switch (ret) {
@@ -1324,12 +1377,14 @@ static void GetWASAPIDefaultsInput(obs_data_t *settings)
 {
 	obs_data_set_default_string(settings, OPT_DEVICE_ID, "default");
 	obs_data_set_default_bool(settings, OPT_USE_DEVICE_TIMING, false);
+	obs_data_set_default_bool(settings, OPT_LOW_LATENCY, false);
 }
 
 static void GetWASAPIDefaultsDeviceOutput(obs_data_t *settings)
 {
 	obs_data_set_default_string(settings, OPT_DEVICE_ID, "default");
 	obs_data_set_default_bool(settings, OPT_USE_DEVICE_TIMING, true);
+	obs_data_set_default_bool(settings, OPT_LOW_LATENCY, false);
 }
 
 static void GetWASAPIDefaultsProcessOutput(obs_data_t *) {}
@@ -1473,6 +1528,7 @@ static obs_properties_t *GetWASAPIPropertiesInput(void *)
 	}
 
 	obs_properties_add_bool(props, OPT_USE_DEVICE_TIMING, obs_module_text("UseDeviceTiming"));
+	obs_properties_add_bool(props, OPT_LOW_LATENCY, obs_module_text("LowLatency"));
 
 	return props;
 }
@@ -1496,6 +1552,7 @@ static obs_properties_t *GetWASAPIPropertiesDeviceOutput(void *)
 	}
 
 	obs_properties_add_bool(props, OPT_USE_DEVICE_TIMING, obs_module_text("UseDeviceTiming"));
+	obs_properties_add_bool(props, OPT_LOW_LATENCY, obs_module_text("LowLatency"));
 
 	return props;
 }
@@ -87,7 +87,7 @@ static int mp_open_codec(struct mp_decode *d, bool hw)
 
 	if (c->thread_count == 1 && c->codec_id != AV_CODEC_ID_PNG && c->codec_id != AV_CODEC_ID_TIFF &&
 	    c->codec_id != AV_CODEC_ID_JPEG2000 && c->codec_id != AV_CODEC_ID_MPEG4 && c->codec_id != AV_CODEC_ID_WEBP)
-		c->thread_count = 0;
+		c->thread_count = mp_media_decode_threads(d->m);
 
 	ret = avcodec_open2(c, d->codec, NULL);
 	if (ret < 0)
@@ -264,6 +264,41 @@ static inline int64_t get_estimated_duration(struct mp_decode *d, int64_t last_p
 	}
 }
 
+static int mp_transfer_hw_frame(struct mp_decode *d)
+{
+	AVFrame *sw = d->sw_frame;
+
+	/* keep the system-memory download target allocated across frames:
+	 * letting av_hwframe_transfer_data allocate a fresh buffer every
+	 * frame costs a multi-megabyte allocation and free per frame at 4K */
+	if (!sw->data[0] || sw->width != d->hw_frame->width || sw->height != d->hw_frame->height) {
+		enum AVPixelFormat *formats = NULL;
+
+		av_frame_unref(sw);
+
+		if (av_hwframe_transfer_get_formats(d->hw_frame->hw_frames_ctx, AV_HWFRAME_TRANSFER_DIRECTION_FROM,
+						    &formats, 0) == 0) {
+			sw->format = formats[0];
+			av_freep(&formats);
+		}
+
+		sw->width = d->hw_frame->width;
+		sw->height = d->hw_frame->height;
+
+		if (sw->format == AV_PIX_FMT_NONE || av_frame_get_buffer(sw, 0) != 0) {
+			av_frame_unref(sw);
+			return av_hwframe_transfer_data(sw, d->hw_frame, 0);
+		}
+	}
+
+	/* av_frame_copy_props appends side data, so drop what the previous
+	 * frame left behind before the caller copies fresh props over */
+	while (sw->nb_side_data)
+		av_frame_remove_side_data(sw, sw->side_data[0]->type);
+
+	return av_hwframe_transfer_data(sw, d->hw_frame, 0);
+}
+
 static int decode_packet(struct mp_decode *d, int *got_frame)
 {
 	int ret;
@@ -304,15 +339,19 @@ static int decode_packet(struct mp_decode *d, int *got_frame)
 			return ret;
 		}
 
-		av_frame_unref(d->sw_frame);
-
-		int err = av_hwframe_transfer_data(d->sw_frame, d->hw_frame, 0);
+		int err = mp_transfer_hw_frame(d);
 		if (err == 0) {
 			err = av_frame_copy_props(d->sw_frame, d->hw_frame);
 		}
 		if (err) {
 			ret = 0;
 			*got_frame = false;
+		} else {
+			/* release the hardware surface back to the decoder
+			 * pool right away; those pools are small and holding
+			 * the surface until the next receive can stall the
+			 * decoder */
+			av_frame_unref(d->hw_frame);
 		}
 	}
 
@@ -386,13 +425,13 @@ bool mp_decode_next(struct mp_decode *d)
 	if (d->frame_ready) {
 		int64_t last_pts = d->frame_pts;
 
-		if (d->in_frame->best_effort_timestamp == AV_NOPTS_VALUE)
+		if (d->frame->best_effort_timestamp == AV_NOPTS_VALUE)
 			d->frame_pts = d->next_pts;
 		else
-			d->frame_pts = av_rescale_q(d->in_frame->best_effort_timestamp, d->stream->time_base,
+			d->frame_pts = av_rescale_q(d->frame->best_effort_timestamp, d->stream->time_base,
 						    (AVRational){1, 1000000000});
 
-		int64_t duration = d->in_frame->duration;
+		int64_t duration = d->frame->duration;
 		if (!duration)
 			duration = get_estimated_duration(d, last_pts);
 		else
@@ -164,6 +164,14 @@ bool media_playback_has_video(media_playback_t *mp)
 		return mp->media.has_video;
 }
 
+void media_playback_set_decode_priority(media_playback_t *mp, bool high)
+{
+	if (!mp || mp->is_cached)
+		return;
+
+	mp_media_set_decode_priority(&mp->media, high);
+}
+
 bool media_playback_has_audio(media_playback_t *mp)
 {
 	if (!mp)
@@ -63,3 +63,9 @@ extern int64_t media_playback_get_frames(media_playback_t *mp);
 extern int64_t media_playback_get_duration(media_playback_t *mp);
 extern bool media_playback_has_video(media_playback_t *mp);
 extern bool media_playback_has_audio(media_playback_t *mp);
+
+/* marks playback as high priority so its decoders keep FFmpeg's full
+ * automatic worker-thread count even when many media sources share the
+ * machine; background sources get a divided share instead. Takes effect
+ * when decoders are next opened (play/restart). */
+extern void media_playback_set_decode_priority(media_playback_t *mp, bool high);
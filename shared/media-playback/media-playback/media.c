@@ -27,6 +27,10 @@
 
 static int64_t base_sys_ts = 0;
 
+/* live mp_media instances; used to split FFmpeg decoder worker threads
+ * among concurrent sources (see mp_media_decode_threads()) */
+static volatile long media_instances = 0;
+
 static inline enum video_format convert_pixel_format(int f)
 {
 	switch (f) {
@@ -192,6 +196,82 @@ static int mp_media_next_packet(mp_media_t *media)
 	return ret;
 }
 
+static void mp_media_free_loop_packets(mp_media_t *m)
+{
+	for (size_t i = 0; i < m->loop_packets.num; i++)
+		mp_media_free_packet(m, m->loop_packets.array[i]);
+	da_clear(m->loop_packets);
+	m->loop_prefetched = false;
+}
+
+#define LOOP_PREFETCH_MAX_PACKETS 128
+
+/* When a looping local file's demuxer hits EOF, the tail of the current
+ * iteration is still being presented but the demuxer itself is idle.
+ * Rewind it now and pre-read the first GOP's packets so the loop reset
+ * only decodes RAM-resident data instead of seeking and demuxing from
+ * disk right on the presentation deadline. */
+static void mp_media_loop_prefetch(mp_media_t *m)
+{
+	AVStream *stream = m->fmt->streams[0];
+	int64_t start_time = m->fmt->start_time;
+	if (start_time == AV_NOPTS_VALUE)
+		start_time = 0;
+
+	/* seek_to picks different flags without a duration; only prefetch
+	 * when we can reproduce the exact seek the reset will want */
+	if (m->fmt->duration == AV_NOPTS_VALUE)
+		return;
+
+	int64_t seek_target = av_rescale_q(start_time, AV_TIME_BASE_Q, stream->time_base);
+
+	if (av_seek_frame(m->fmt, 0, seek_target, AVSEEK_FLAG_BACKWARD) < 0)
+		return;
+
+	int video_keyframes = 0;
+
+	while (m->loop_packets.num < LOOP_PREFETCH_MAX_PACKETS) {
+		AVPacket *pkt;
+		AVPacket **const cached = da_end(m->packet_pool);
+		if (cached) {
+			pkt = *cached;
+			da_pop_back(m->packet_pool);
+		} else {
+			pkt = av_packet_alloc();
+		}
+
+		int ret = av_read_frame(m->fmt, pkt);
+		if (ret < 0) {
+			mp_media_free_packet(m, pkt);
+			break;
+		}
+
+		da_push_back(m->loop_packets, &pkt);
+
+		if (m->has_video && pkt->stream_index == m->v.stream->index && (pkt->flags & AV_PKT_FLAG_KEY) &&
+		    ++video_keyframes == 2)
+			break;
+	}
+
+	m->loop_seek_target = seek_target;
+	m->loop_prefetched = true;
+}
+
+static void mp_media_feed_loop_packets(mp_media_t *m)
+{
+	for (size_t i = 0; i < m->loop_packets.num; i++) {
+		AVPacket *pkt = m->loop_packets.array[i];
+		struct mp_decode *d = get_packet_decoder(m, pkt);
+		if (d && pkt->size)
+			mp_decode_push_packet(d, pkt);
+		else
+			mp_media_free_packet(m, pkt);
+	}
+
+	da_clear(m->loop_packets);
+	m->loop_prefetched = false;
+}
+
 static inline bool mp_media_ready_to_start(mp_media_t *m)
 {
 	if (m->has_audio && !m->a.eof && !m->a.frame_ready)
@@ -271,6 +351,13 @@ bool mp_media_prepare_frames(mp_media_t *m)
 			if (ret == AVERROR_EOF || ret == AVERROR_EXIT) {
 				if (!actively_seeking) {
 					m->eof = true;
+
+					pthread_mutex_lock(&m->mutex);
+					bool looping = m->looping;
+					pthread_mutex_unlock(&m->mutex);
+
+					if (looping && m->is_local_file && !m->loop_prefetched)
+						mp_media_loop_prefetch(m);
 				} else {
 					break;
 				}
@@ -533,20 +620,32 @@ static void seek_to(mp_media_t *m, int64_t pos)
 				      ? av_rescale_q(seek_pos, AV_TIME_BASE_Q, stream->time_base)
 				      : seek_pos;
 
-	if (m->is_local_file) {
+	bool prefetched = m->loop_prefetched && seek_flags == AVSEEK_FLAG_BACKWARD &&
+			  seek_target == m->loop_seek_target;
+
+	if (m->is_local_file && !prefetched) {
+		/* a prefetch targeting some other position is stale */
+		mp_media_free_loop_packets(m);
+
 		int ret = av_seek_frame(m->fmt, 0, seek_target, seek_flags);
 		if (ret < 0) {
 			blog(LOG_WARNING, "MP: Failed to seek: %s", av_err2str(ret));
 		}
 	}
 
+	if (m->has_audio && m->is_local_file)
+		mp_decode_flush(&m->a);
 	if (m->has_video && m->is_local_file) {
 		mp_decode_flush(&m->v);
+
+		if (prefetched)
+			mp_media_feed_loop_packets(m);
+
 		if (m->seek_next_ts && m->pause && m->v_preload_cb && mp_media_prepare_frames(m))
 			mp_media_next_video(m, true);
+	} else if (prefetched && m->is_local_file) {
+		mp_media_feed_loop_packets(m);
 	}
-	if (m->has_audio && m->is_local_file)
-		mp_decode_flush(&m->a);
 }
 
 bool mp_media_reset(mp_media_t *m)
@@ -905,6 +1004,9 @@ bool mp_media_init(mp_media_t *media, const struct mp_media_info *info)
 	if (!base_sys_ts)
 		base_sys_ts = (int64_t)os_gettime_ns();
 
+	os_atomic_inc_long(&media_instances);
+	media->instance_counted = true;
+
 	if (!mp_media_init_internal(media, info)) {
 		mp_media_free(media);
 		return false;
@@ -930,10 +1032,16 @@ void mp_media_free(mp_media_t *media)
 	if (!media)
 		return;
 
+	if (media->instance_counted)
+		os_atomic_dec_long(&media_instances);
+
 	mp_media_stop(media);
 	mp_kill_thread(media);
 	mp_decode_free(&media->v);
 	mp_decode_free(&media->a);
+	for (size_t i = 0; i < media->loop_packets.num; i++)
+		av_packet_free(&media->loop_packets.array[i]);
+	da_free(media->loop_packets);
 	for (size_t i = 0; i < media->packet_pool.num; i++)
 		av_packet_free(&media->packet_pool.array[i]);
 	da_free(media->packet_pool);
@@ -948,6 +1056,28 @@ void mp_media_free(mp_media_t *media)
 	pthread_mutex_init_value(&media->mutex);
 }
 
+int mp_media_decode_threads(const mp_media_t *m)
+{
+	long instances = os_atomic_load_long(&media_instances);
+	int threads;
+
+	if (instances <= 1 || os_atomic_load_bool(&m->boost_decode))
+		return 0;
+
+	threads = os_get_logical_cores() / (int)instances;
+	if (threads < 2)
+		threads = 2;
+	return threads;
+}
+
+void mp_media_set_decode_priority(mp_media_t *m, bool boost)
+{
+	if (!m)
+		return;
+
+	os_atomic_set_bool(&m->boost_decode, boost);
+}
+
 void mp_media_play(mp_media_t *m, bool loop, bool reconnecting)
 {
 	pthread_mutex_lock(&m->mutex);
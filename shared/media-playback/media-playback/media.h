@@ -60,6 +60,9 @@ struct mp_media {
 	uint8_t *scale_pic[4];
 
 	DARRAY(AVPacket *) packet_pool;
+	DARRAY(AVPacket *) loop_packets;
+	bool loop_prefetched;
+	int64_t loop_seek_target;
 	struct mp_decode v;
 	struct mp_decode a;
 	bool request_preload;
@@ -71,6 +74,12 @@ struct mp_media {
 	bool eof;
 	bool hw;
 
+	/* decoder thread sharing: counted toward the global instance total
+	 * while initialized; boosted instances keep FFmpeg's full automatic
+	 * worker count (see mp_media_decode_threads()) */
+	bool instance_counted;
+	volatile bool boost_decode;
+
 	struct obs_source_frame obsframe;
 	enum video_colorspace cur_space;
 	enum video_range_type cur_range;
@@ -119,6 +128,17 @@ extern int64_t mp_media_get_frames(mp_media_t *m);
 extern int64_t mp_media_get_duration(mp_media_t *m);
 extern void mp_media_seek(mp_media_t *m, int64_t pos);
 
+/* number of worker threads each FFmpeg decoder should spawn: 0 (FFmpeg
+ * automatic, one per logical core) for a lone or boosted instance,
+ * otherwise the logical cores divided among all live instances so that
+ * many concurrent sources do not multiply idle decoder threads */
+extern int mp_media_decode_threads(const mp_media_t *m);
+
+/* boost an instance so decoders it opens afterwards get the full
+ * automatic worker count regardless of how many other instances exist;
+ * used to favor sources active in the program output */
+extern void mp_media_set_decode_priority(mp_media_t *m, bool boost);
+
 /* #define DETAILED_DEBUG_INFO */
 
 #ifdef __cplusplus
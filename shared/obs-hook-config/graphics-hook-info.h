@@ -118,7 +118,16 @@ struct hook_info {
 	/* hook addresses */
 	struct graphics_offsets offsets;
 
-	uint32_t reserved[126];
+	/* consumption-based capture throttling: when throttle_on_consume is
+	 * nonzero, the hook only copies a frame after OBS bumps
+	 * frames_consumed (i.e. after the previous copy was actually used),
+	 * instead of copying on a wall-clock interval.  Zero on either side
+	 * falls back to frame_interval throttling for compatibility with
+	 * older hooks/frontends. */
+	volatile uint32_t throttle_on_consume;
+	volatile uint32_t frames_consumed;
+
+	uint32_t reserved[124];
 };
 static_assert(sizeof(struct hook_info) == 648, "ABI compatibility");
 
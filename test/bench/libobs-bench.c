@@ -0,0 +1,340 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <obs.h>
+#include <graphics/matrix4.h>
+#include <media-io/format-conversion.h>
+#include <util/darray.h>
+#include <util/deque.h>
+#include <util/platform.h>
+
+/* Microbenchmarks for libobs hot paths.
+ *
+ * Each benchmark does its own untimed setup and teardown and returns the
+ * elapsed time for the requested number of iterations; a warmup pass runs
+ * first so one-time costs (page faults, lazy tables) do not land in the
+ * measured pass.  Results are printed as JSON on stdout (or to the file
+ * given as the first argument) so CI can diff runs between revisions.
+ * Human-readable progress goes to stderr. */
+
+struct bench_result {
+	const char *name;
+	uint64_t iterations;
+	uint64_t total_ns;
+};
+
+typedef uint64_t (*bench_fn)(uint64_t iterations);
+
+static DARRAY(struct bench_result) results;
+
+static void run_bench(const char *name, uint64_t iterations, bench_fn fn)
+{
+	struct bench_result result;
+
+	fn(iterations / 10 + 1);
+
+	result.name = name;
+	result.iterations = iterations;
+	result.total_ns = fn(iterations);
+	da_push_back(results, &result);
+
+	fprintf(stderr, "%-36s %14" PRIu64 " ns  (%" PRIu64 " iterations, %.1f ns/iter)\n", name, result.total_ns,
+		iterations, (double)result.total_ns / (double)iterations);
+}
+
+/* ------------------------------------------------------------------------- */
+/* format conversion */
+
+#define CONV_CX 1280
+#define CONV_CY 720
+
+static uint64_t bench_compress_uyvx_to_i420(uint64_t iterations)
+{
+	uint32_t in_linesize = CONV_CX * 4;
+	uint8_t *input = bmalloc((size_t)in_linesize * CONV_CY);
+	uint8_t *out_y = bmalloc((size_t)CONV_CX * CONV_CY);
+	uint8_t *out_u = bmalloc((size_t)CONV_CX * CONV_CY / 4);
+	uint8_t *out_v = bmalloc((size_t)CONV_CX * CONV_CY / 4);
+	uint8_t *output[] = {out_y, out_u, out_v};
+	uint32_t out_linesize[] = {CONV_CX, CONV_CX / 2, CONV_CX / 2};
+
+	for (size_t i = 0; i < (size_t)in_linesize * CONV_CY; i++)
+		input[i] = (uint8_t)(i * 7);
+
+	uint64_t start = os_gettime_ns();
+	for (uint64_t i = 0; i < iterations; i++)
+		compress_uyvx_to_i420(input, in_linesize, 0, CONV_CY, output, out_linesize);
+	uint64_t elapsed = os_gettime_ns() - start;
+
+	bfree(input);
+	bfree(out_y);
+	bfree(out_u);
+	bfree(out_v);
+	return elapsed;
+}
+
+static uint64_t bench_compress_uyvx_to_nv12(uint64_t iterations)
+{
+	uint32_t in_linesize = CONV_CX * 4;
+	uint8_t *input = bmalloc((size_t)in_linesize * CONV_CY);
+	uint8_t *out_y = bmalloc((size_t)CONV_CX * CONV_CY);
+	uint8_t *out_uv = bmalloc((size_t)CONV_CX * CONV_CY / 2);
+	uint8_t *output[] = {out_y, out_uv};
+	uint32_t out_linesize[] = {CONV_CX, CONV_CX};
+
+	for (size_t i = 0; i < (size_t)in_linesize * CONV_CY; i++)
+		input[i] = (uint8_t)(i * 7);
+
+	uint64_t start = os_gettime_ns();
+	for (uint64_t i = 0; i < iterations; i++)
+		compress_uyvx_to_nv12(input, in_linesize, 0, CONV_CY, output, out_linesize);
+	uint64_t elapsed = os_gettime_ns() - start;
+
+	bfree(input);
+	bfree(out_y);
+	bfree(out_uv);
+	return elapsed;
+}
+
+/* ------------------------------------------------------------------------- */
+/* matrix ops */
+
+#define MATRIX_COUNT 4096
+
+static void init_matrices(struct matrix4 *mats, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		matrix4_identity(&mats[i]);
+		matrix4_rotate_aa4f(&mats[i], &mats[i], 0.0f, 0.0f, 1.0f, (float)i * 0.01f);
+		matrix4_translate3f(&mats[i], &mats[i], (float)i, (float)i * 2.0f, 0.0f);
+	}
+}
+
+static uint64_t bench_matrix4_mul(uint64_t iterations)
+{
+	struct matrix4 *mats1 = bmalloc(sizeof(struct matrix4) * MATRIX_COUNT);
+	struct matrix4 *mats2 = bmalloc(sizeof(struct matrix4) * MATRIX_COUNT);
+	struct matrix4 *dst = bmalloc(sizeof(struct matrix4) * MATRIX_COUNT);
+
+	init_matrices(mats1, MATRIX_COUNT);
+	init_matrices(mats2, MATRIX_COUNT);
+
+	uint64_t start = os_gettime_ns();
+	for (uint64_t i = 0; i < iterations; i++) {
+		for (size_t j = 0; j < MATRIX_COUNT; j++)
+			matrix4_mul(&dst[j], &mats1[j], &mats2[j]);
+	}
+	uint64_t elapsed = os_gettime_ns() - start;
+
+	bfree(mats1);
+	bfree(mats2);
+	bfree(dst);
+	return elapsed;
+}
+
+static uint64_t bench_matrix4_mul_batch(uint64_t iterations)
+{
+	struct matrix4 *mats1 = bmalloc(sizeof(struct matrix4) * MATRIX_COUNT);
+	struct matrix4 *mats2 = bmalloc(sizeof(struct matrix4) * MATRIX_COUNT);
+	struct matrix4 *dst = bmalloc(sizeof(struct matrix4) * MATRIX_COUNT);
+
+	init_matrices(mats1, MATRIX_COUNT);
+	init_matrices(mats2, MATRIX_COUNT);
+
+	uint64_t start = os_gettime_ns();
+	for (uint64_t i = 0; i < iterations; i++)
+		matrix4_mul_batch(dst, mats1, mats2, MATRIX_COUNT);
+	uint64_t elapsed = os_gettime_ns() - start;
+
+	bfree(mats1);
+	bfree(mats2);
+	bfree(dst);
+	return elapsed;
+}
+
+/* ------------------------------------------------------------------------- */
+/* calldata emission */
+
+static long signal_sink;
+
+static void bench_signal_cb(void *data, calldata_t *cd)
+{
+	UNUSED_PARAMETER(data);
+	signal_sink += (long)calldata_int(cd, "id");
+}
+
+static uint64_t bench_calldata_emission(uint64_t iterations)
+{
+	signal_handler_t *sh = signal_handler_create();
+	struct calldata params;
+	uint8_t stack[128];
+
+	signal_handler_add(sh, "void bench(ptr source, int id)");
+	signal_handler_connect(sh, "bench", bench_signal_cb, NULL);
+
+	uint64_t start = os_gettime_ns();
+	for (uint64_t i = 0; i < iterations; i++) {
+		calldata_init_fixed(&params, stack, sizeof(stack));
+		calldata_set_ptr(&params, "source", &params);
+		calldata_set_int(&params, "id", (long long)i);
+		signal_handler_signal(sh, "bench", &params);
+	}
+	uint64_t elapsed = os_gettime_ns() - start;
+
+	signal_handler_destroy(sh);
+	return elapsed;
+}
+
+/* ------------------------------------------------------------------------- */
+/* obs-data serialization */
+
+static uint64_t bench_obs_data_json(uint64_t iterations)
+{
+	obs_data_t *data = obs_data_create();
+	obs_data_array_t *array = obs_data_array_create();
+
+	for (int i = 0; i < 16; i++) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "name", "scene item");
+		obs_data_set_int(item, "id", i);
+		obs_data_set_double(item, "x", (double)i * 1.5);
+		obs_data_set_double(item, "y", (double)i * 2.5);
+		obs_data_set_bool(item, "visible", (i & 1) != 0);
+		obs_data_array_push_back(array, item);
+		obs_data_release(item);
+	}
+
+	obs_data_set_string(data, "name", "benchmark collection");
+	obs_data_set_array(data, "items", array);
+	obs_data_array_release(array);
+
+	uint64_t start = os_gettime_ns();
+	for (uint64_t i = 0; i < iterations; i++) {
+		const char *json = obs_data_get_json(data);
+		obs_data_t *parsed = obs_data_create_from_json(json);
+		obs_data_release(parsed);
+	}
+	uint64_t elapsed = os_gettime_ns() - start;
+
+	obs_data_release(data);
+	return elapsed;
+}
+
+/* ------------------------------------------------------------------------- */
+/* deque growth */
+
+#define DEQUE_RECORDS 4096
+
+static uint64_t bench_deque_growth(uint64_t iterations)
+{
+	uint8_t record[64] = {0};
+	uint64_t start = os_gettime_ns();
+
+	for (uint64_t i = 0; i < iterations; i++) {
+		struct deque dq;
+		deque_init(&dq);
+
+		for (size_t j = 0; j < DEQUE_RECORDS; j++)
+			deque_push_back(&dq, record, sizeof(record));
+		for (size_t j = 0; j < DEQUE_RECORDS / 2; j++)
+			deque_pop_front(&dq, record, sizeof(record));
+		for (size_t j = 0; j < DEQUE_RECORDS / 2; j++)
+			deque_push_back(&dq, record, sizeof(record));
+
+		deque_free(&dq);
+	}
+
+	return os_gettime_ns() - start;
+}
+
+/* ------------------------------------------------------------------------- */
+/* scene transform recomputation
+ *
+ * Recomputing a scene item's draw transform does not need a running video
+ * pipeline: it is the matrix composition that obs-scene performs per item
+ * (scale, rotation, translation, then the parent transform).  This
+ * reproduces that composition for a scene's worth of items. */
+
+#define TRANSFORM_ITEMS 1000
+
+static uint64_t bench_scene_transform(uint64_t iterations)
+{
+	struct matrix4 *transforms = bmalloc(sizeof(struct matrix4) * TRANSFORM_ITEMS);
+	struct matrix4 parent;
+
+	matrix4_identity(&parent);
+	matrix4_translate3f(&parent, &parent, 100.0f, 50.0f, 0.0f);
+
+	uint64_t start = os_gettime_ns();
+	for (uint64_t i = 0; i < iterations; i++) {
+		for (size_t j = 0; j < TRANSFORM_ITEMS; j++) {
+			struct matrix4 *mat = &transforms[j];
+
+			matrix4_identity(mat);
+			matrix4_scale3f(mat, mat, 0.5f + (float)j * 0.001f, 0.5f + (float)j * 0.001f, 1.0f);
+			matrix4_rotate_aa4f(mat, mat, 0.0f, 0.0f, 1.0f, (float)j * 0.01f);
+			matrix4_translate3f(mat, mat, (float)j, (float)j * 0.5f, 0.0f);
+			matrix4_mul(mat, mat, &parent);
+		}
+	}
+	uint64_t elapsed = os_gettime_ns() - start;
+
+	bfree(transforms);
+	return elapsed;
+}
+
+/* ------------------------------------------------------------------------- */
+
+static bool write_results(const char *path)
+{
+	obs_data_t *report = obs_data_create();
+	obs_data_array_t *array = obs_data_array_create();
+
+	for (size_t i = 0; i < results.num; i++) {
+		struct bench_result *result = &results.array[i];
+		obs_data_t *item = obs_data_create();
+
+		obs_data_set_string(item, "name", result->name);
+		obs_data_set_int(item, "iterations", (long long)result->iterations);
+		obs_data_set_int(item, "total_ns", (long long)result->total_ns);
+		obs_data_set_double(item, "ns_per_iter", (double)result->total_ns / (double)result->iterations);
+
+		obs_data_array_push_back(array, item);
+		obs_data_release(item);
+	}
+
+	obs_data_set_array(report, "benchmarks", array);
+	obs_data_array_release(array);
+
+	bool success = true;
+	if (path) {
+		success = obs_data_save_json(report, path);
+	} else {
+		puts(obs_data_get_json(report));
+	}
+
+	obs_data_release(report);
+	return success;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *path = argc > 1 ? argv[1] : NULL;
+
+	da_init(results);
+
+	run_bench("compress_uyvx_to_i420_720p", 200, bench_compress_uyvx_to_i420);
+	run_bench("compress_uyvx_to_nv12_720p", 200, bench_compress_uyvx_to_nv12);
+	run_bench("matrix4_mul_4096", 1000, bench_matrix4_mul);
+	run_bench("matrix4_mul_batch_4096", 1000, bench_matrix4_mul_batch);
+	run_bench("calldata_emission", 100000, bench_calldata_emission);
+	run_bench("obs_data_json_roundtrip", 10000, bench_obs_data_json);
+	run_bench("deque_growth_4096x64", 1000, bench_deque_growth);
+	run_bench("scene_transform_1000_items", 1000, bench_scene_transform);
+
+	bool success = write_results(path);
+
+	da_free(results);
+	return success ? 0 : 1;
+}
@@ -3,8 +3,29 @@
 #include <setjmp.h>
 #include <cmocka.h>
 
+#include <util/bmem.h>
 #include <util/darray.h>
 
+static void array_alloc_count_test(void **state)
+{
+	UNUSED_PARAMETER(state);
+
+	DARRAY(uint8_t) testarray;
+	da_init(testarray);
+
+	long allocs = bnum_allocs();
+
+	for (uint8_t i = 0; i < 4; i++)
+		da_push_back(testarray, &i);
+
+	/* the first push allocates at least four elements up front, so
+	 * pushing four one at a time performs a single allocation */
+	assert_int_equal(bnum_allocs() - allocs, 1);
+	assert_int_equal(testarray.num, 4);
+
+	da_free(testarray);
+}
+
 static void array_basic_test(void **state)
 {
 	UNUSED_PARAMETER(state);
@@ -25,6 +46,7 @@ int main()
 {
 	const struct CMUnitTest tests[] = {
 		cmocka_unit_test(array_basic_test),
+		cmocka_unit_test(array_alloc_count_test),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
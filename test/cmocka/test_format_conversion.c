@@ -0,0 +1,208 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <media-io/format-conversion.h>
+
+#define TEST_WIDTH 256
+#define TEST_HEIGHT 128
+
+/* plain reference loops; the exported functions may dispatch to SIMD
+ * variants depending on the host CPU */
+
+static void reference_decompress_nv12(const uint8_t *const input[], const uint32_t in_linesize[], uint32_t height,
+				      uint8_t *output, uint32_t out_linesize)
+{
+	for (uint32_t y = 0; y < height / 2; y++) {
+		const uint16_t *chroma = (const uint16_t *)(input[1] + y * in_linesize[1]);
+		const uint8_t *lum0 = input[0] + y * 2 * in_linesize[0];
+		const uint8_t *lum1 = lum0 + in_linesize[0];
+		uint32_t *output0 = (uint32_t *)(output + y * 2 * out_linesize);
+		uint32_t *output1 = (uint32_t *)((uint8_t *)output0 + out_linesize);
+
+		for (uint32_t x = 0; x < in_linesize[0] / 2; x++) {
+			uint32_t out = chroma[x] << 8;
+
+			output0[x * 2] = lum0[x * 2] | out;
+			output0[x * 2 + 1] = lum0[x * 2 + 1] | out;
+			output1[x * 2] = lum1[x * 2] | out;
+			output1[x * 2 + 1] = lum1[x * 2 + 1] | out;
+		}
+	}
+}
+
+static void reference_decompress_420(const uint8_t *const input[], const uint32_t in_linesize[], uint32_t height,
+				     uint8_t *output, uint32_t out_linesize)
+{
+	for (uint32_t y = 0; y < height / 2; y++) {
+		const uint8_t *chroma0 = input[1] + y * in_linesize[1];
+		const uint8_t *chroma1 = input[2] + y * in_linesize[2];
+		const uint8_t *lum0 = input[0] + y * 2 * in_linesize[0];
+		const uint8_t *lum1 = lum0 + in_linesize[0];
+		uint32_t *output0 = (uint32_t *)(output + y * 2 * out_linesize);
+		uint32_t *output1 = (uint32_t *)((uint8_t *)output0 + out_linesize);
+
+		for (uint32_t x = 0; x < in_linesize[0] / 2; x++) {
+			uint32_t out = (chroma0[x] << 8) | chroma1[x];
+
+			output0[x * 2] = (lum0[x * 2] << 16) | out;
+			output0[x * 2 + 1] = (lum0[x * 2 + 1] << 16) | out;
+			output1[x * 2] = (lum1[x * 2] << 16) | out;
+			output1[x * 2 + 1] = (lum1[x * 2 + 1] << 16) | out;
+		}
+	}
+}
+
+static void reference_decompress_422(const uint8_t *input, uint32_t in_linesize, uint32_t height, uint8_t *output,
+				     uint32_t out_linesize, bool leading_lum)
+{
+	for (uint32_t y = 0; y < height; y++) {
+		const uint32_t *input32 = (const uint32_t *)(input + y * in_linesize);
+		uint32_t *output32 = (uint32_t *)(output + y * out_linesize);
+
+		for (uint32_t x = 0; x < in_linesize / 4; x++) {
+			uint32_t dw = input32[x];
+
+			output32[x * 2] = dw;
+			if (leading_lum) {
+				dw &= 0xFFFFFF00;
+				dw |= (uint8_t)(dw >> 16);
+			} else {
+				dw &= 0xFFFF00FF;
+				dw |= (dw >> 16) & 0xFF00;
+			}
+			output32[x * 2 + 1] = dw;
+		}
+	}
+}
+
+static void fill_pseudo_random(uint8_t *data, size_t size)
+{
+	uint32_t seed = 0x12345678;
+
+	for (size_t i = 0; i < size; i++) {
+		seed = seed * 1664525 + 1013904223;
+		data[i] = (uint8_t)(seed >> 24);
+	}
+}
+
+static void decompress_nv12_matches_reference(void **state)
+{
+	UNUSED_PARAMETER(state);
+
+	uint8_t *lum = bmalloc(TEST_WIDTH * TEST_HEIGHT);
+	uint8_t *chroma = bmalloc(TEST_WIDTH * TEST_HEIGHT / 2);
+	uint8_t *out = bmalloc(TEST_WIDTH * TEST_HEIGHT * 4);
+	uint8_t *expected = bmalloc(TEST_WIDTH * TEST_HEIGHT * 4);
+
+	fill_pseudo_random(lum, TEST_WIDTH * TEST_HEIGHT);
+	fill_pseudo_random(chroma, TEST_WIDTH * TEST_HEIGHT / 2);
+
+	const uint8_t *input[3] = {lum, chroma, NULL};
+	const uint32_t in_linesize[3] = {TEST_WIDTH, TEST_WIDTH, 0};
+
+	decompress_nv12(input, in_linesize, 0, TEST_HEIGHT, out, TEST_WIDTH * 4);
+	reference_decompress_nv12(input, in_linesize, TEST_HEIGHT, expected, TEST_WIDTH * 4);
+
+	assert_memory_equal(out, expected, TEST_WIDTH * TEST_HEIGHT * 4);
+
+	bfree(expected);
+	bfree(out);
+	bfree(chroma);
+	bfree(lum);
+}
+
+static void decompress_420_matches_reference(void **state)
+{
+	UNUSED_PARAMETER(state);
+
+	uint8_t *lum = bmalloc(TEST_WIDTH * TEST_HEIGHT);
+	uint8_t *u = bmalloc(TEST_WIDTH * TEST_HEIGHT / 4);
+	uint8_t *v = bmalloc(TEST_WIDTH * TEST_HEIGHT / 4);
+	uint8_t *out = bmalloc(TEST_WIDTH * TEST_HEIGHT * 4);
+	uint8_t *expected = bmalloc(TEST_WIDTH * TEST_HEIGHT * 4);
+
+	fill_pseudo_random(lum, TEST_WIDTH * TEST_HEIGHT);
+	fill_pseudo_random(u, TEST_WIDTH * TEST_HEIGHT / 4);
+	fill_pseudo_random(v, TEST_WIDTH * TEST_HEIGHT / 4);
+
+	const uint8_t *input[3] = {lum, u, v};
+	const uint32_t in_linesize[3] = {TEST_WIDTH, TEST_WIDTH / 2, TEST_WIDTH / 2};
+
+	decompress_420(input, in_linesize, 0, TEST_HEIGHT, out, TEST_WIDTH * 4);
+	reference_decompress_420(input, in_linesize, TEST_HEIGHT, expected, TEST_WIDTH * 4);
+
+	assert_memory_equal(out, expected, TEST_WIDTH * TEST_HEIGHT * 4);
+
+	bfree(expected);
+	bfree(out);
+	bfree(v);
+	bfree(u);
+	bfree(lum);
+}
+
+static void decompress_422_matches_reference(void **state)
+{
+	UNUSED_PARAMETER(state);
+
+	uint8_t *in = bmalloc(TEST_WIDTH * 2 * TEST_HEIGHT);
+	uint8_t *out = bmalloc(TEST_WIDTH * TEST_HEIGHT * 4);
+	uint8_t *expected = bmalloc(TEST_WIDTH * TEST_HEIGHT * 4);
+
+	fill_pseudo_random(in, TEST_WIDTH * 2 * TEST_HEIGHT);
+
+	for (int leading = 0; leading <= 1; leading++) {
+		decompress_422(in, TEST_WIDTH * 2, 0, TEST_HEIGHT, out, TEST_WIDTH * 4, leading == 1);
+		reference_decompress_422(in, TEST_WIDTH * 2, TEST_HEIGHT, expected, TEST_WIDTH * 4, leading == 1);
+
+		assert_memory_equal(out, expected, TEST_WIDTH * TEST_HEIGHT * 4);
+	}
+
+	bfree(expected);
+	bfree(out);
+	bfree(in);
+}
+
+static void decompress_nv12_benchmark(void **state)
+{
+	UNUSED_PARAMETER(state);
+
+	uint8_t *lum = bmalloc(TEST_WIDTH * TEST_HEIGHT);
+	uint8_t *chroma = bmalloc(TEST_WIDTH * TEST_HEIGHT / 2);
+	uint8_t *out = bmalloc(TEST_WIDTH * TEST_HEIGHT * 4);
+
+	fill_pseudo_random(lum, TEST_WIDTH * TEST_HEIGHT);
+	fill_pseudo_random(chroma, TEST_WIDTH * TEST_HEIGHT / 2);
+
+	const uint8_t *input[3] = {lum, chroma, NULL};
+	const uint32_t in_linesize[3] = {TEST_WIDTH, TEST_WIDTH, 0};
+	const int iterations = 1000;
+
+	uint64_t start = os_gettime_ns();
+	for (int i = 0; i < iterations; i++)
+		decompress_nv12(input, in_linesize, 0, TEST_HEIGHT, out, TEST_WIDTH * 4);
+	uint64_t elapsed = os_gettime_ns() - start;
+
+	double ns_per_pixel = (double)elapsed / ((double)iterations * TEST_WIDTH * TEST_HEIGHT);
+	print_message("decompress_nv12: %.3f ns/pixel\n", ns_per_pixel);
+
+	bfree(out);
+	bfree(chroma);
+	bfree(lum);
+}
+
+int main()
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(decompress_nv12_matches_reference),
+		cmocka_unit_test(decompress_420_matches_reference),
+		cmocka_unit_test(decompress_422_matches_reference),
+		cmocka_unit_test(decompress_nv12_benchmark),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,105 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <obs-nal.h>
+
+/* simple scalar reference with the same semantics as
+ * obs_nal_find_startcode: a start code needs at least one payload byte
+ * after it, and a single preceding zero is included in the result */
+static const uint8_t *ref_find_startcode(const uint8_t *p, const uint8_t *end)
+{
+	const uint8_t *start = p;
+
+	for (; end - p > 3; p++) {
+		if (p[0] == 0 && p[1] == 0 && p[2] == 1)
+			return (start < p && !p[-1]) ? p - 1 : p;
+	}
+
+	return end;
+}
+
+static void nal_find_startcode_basic(void **state)
+{
+	UNUSED_PARAMETER(state);
+
+	const uint8_t three_byte[] = {0xff, 0xff, 0x00, 0x00, 0x01, 0x65, 0x88};
+	const uint8_t four_byte[] = {0x00, 0x00, 0x00, 0x01, 0x65, 0x88};
+	const uint8_t zero_run[] = {0x00, 0x00, 0x00, 0x00, 0x01, 0x65};
+	const uint8_t no_code[] = {0x01, 0x02, 0x00, 0x01, 0x00, 0x02};
+	const uint8_t no_payload[] = {0xff, 0x00, 0x00, 0x01};
+
+	assert_ptr_equal(obs_nal_find_startcode(three_byte, three_byte + sizeof(three_byte)), three_byte + 2);
+
+	/* one zero of a longer run is included in the result */
+	assert_ptr_equal(obs_nal_find_startcode(four_byte, four_byte + sizeof(four_byte)), four_byte);
+	assert_ptr_equal(obs_nal_find_startcode(zero_run, zero_run + sizeof(zero_run)), zero_run + 1);
+
+	assert_ptr_equal(obs_nal_find_startcode(no_code, no_code + sizeof(no_code)), no_code + sizeof(no_code));
+
+	/* a start code with no payload byte after it does not count */
+	assert_ptr_equal(obs_nal_find_startcode(no_payload, no_payload + sizeof(no_payload)),
+			 no_payload + sizeof(no_payload));
+}
+
+static void nal_find_startcode_offsets(void **state)
+{
+	UNUSED_PARAMETER(state);
+
+	/* place a start code at every offset of a buffer large enough to
+	 * exercise both the 16-byte blocks and the scalar tail */
+	for (size_t off = 0; off + 4 <= 64; off++) {
+		uint8_t data[64];
+
+		memset(data, 0xff, sizeof(data));
+		data[off] = 0x00;
+		data[off + 1] = 0x00;
+		data[off + 2] = 0x01;
+
+		assert_ptr_equal(obs_nal_find_startcode(data, data + sizeof(data)),
+				 ref_find_startcode(data, data + sizeof(data)));
+	}
+}
+
+static void nal_find_startcode_fuzz(void **state)
+{
+	UNUSED_PARAMETER(state);
+
+	uint8_t data[4096];
+
+	srand(0x0b5);
+
+	/* dense zeros stress the candidate checks, full-range bytes stress
+	 * the block-skip path; walk both buffers comparing every step */
+	for (int pass = 0; pass < 2; pass++) {
+		const uint8_t *end = data + sizeof(data);
+		const uint8_t *p = data;
+
+		for (size_t i = 0; i < sizeof(data); i++)
+			data[i] = (uint8_t)(pass ? rand() : rand() % 4);
+
+		while (p < end) {
+			const uint8_t *found = obs_nal_find_startcode(p, end);
+
+			assert_ptr_equal(found, ref_find_startcode(p, end));
+			if (found == end)
+				break;
+
+			p = found + 1;
+		}
+	}
+}
+
+int main()
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(nal_find_startcode_basic),
+		cmocka_unit_test(nal_find_startcode_offsets),
+		cmocka_unit_test(nal_find_startcode_fuzz),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,157 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+#include <math.h>
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <graphics/srgb.h>
+#include <graphics/half.h>
+
+#define TEST_COUNT (256 * 1024)
+
+/* the batch kernels evaluate pow() with polynomial approximations; allow a
+ * few ulps against the scalar powf() helpers */
+#define SRGB_TOLERANCE 1e-5f
+
+static void srgb_decode_batch_test(void **state)
+{
+	float *batch = bmalloc(TEST_COUNT * sizeof(float));
+	float *reference = bmalloc(TEST_COUNT * sizeof(float));
+
+	srand(1234);
+	for (size_t i = 0; i < TEST_COUNT; i++)
+		batch[i] = reference[i] = (float)rand() / RAND_MAX;
+
+	gs_float3_srgb_nonlinear_to_linear_batch(batch, TEST_COUNT / 3);
+
+	for (size_t i = 0; i < (TEST_COUNT / 3) * 3; i++) {
+		float expected = gs_srgb_nonlinear_to_linear(reference[i]);
+		assert_true(fabsf(batch[i] - expected) <= SRGB_TOLERANCE);
+	}
+
+	bfree(reference);
+	bfree(batch);
+
+	UNUSED_PARAMETER(state);
+}
+
+static void srgb_texel_batch_alpha_test(void **state)
+{
+	const size_t texels = TEST_COUNT / 4;
+	float *batch = bmalloc(TEST_COUNT * sizeof(float));
+	float *reference = bmalloc(TEST_COUNT * sizeof(float));
+
+	srand(5678);
+	for (size_t i = 0; i < TEST_COUNT; i++)
+		batch[i] = reference[i] = (float)rand() / RAND_MAX;
+
+	gs_float4_srgb_nonlinear_to_linear_batch(batch, texels);
+
+	for (size_t i = 0; i < texels * 4; i++) {
+		if ((i & 3) == 3) {
+			/* alpha lanes must pass through untouched */
+			assert_true(batch[i] == reference[i]);
+		} else {
+			float expected = gs_srgb_nonlinear_to_linear(reference[i]);
+			assert_true(fabsf(batch[i] - expected) <= SRGB_TOLERANCE);
+		}
+	}
+
+	gs_float4_srgb_linear_to_nonlinear_batch(batch, texels);
+
+	/* decode then encode should round-trip to the original data */
+	for (size_t i = 0; i < texels * 4; i++)
+		assert_true(fabsf(batch[i] - reference[i]) <= SRGB_TOLERANCE);
+
+	bfree(reference);
+	bfree(batch);
+
+	UNUSED_PARAMETER(state);
+}
+
+static void half_plane_test(void **state)
+{
+	float *floats = bmalloc(TEST_COUNT * sizeof(float));
+	float *floats2 = bmalloc(TEST_COUNT * sizeof(float));
+	struct half *halfs = bmalloc(TEST_COUNT * sizeof(struct half));
+
+	srand(91011);
+	for (size_t i = 0; i < TEST_COUNT; i++)
+		floats[i] = ((float)rand() / RAND_MAX - 0.5f) * 300.0f;
+
+	/* include denormal-range and edge values */
+	floats[0] = 0.0f;
+	floats[1] = -0.0f;
+	floats[2] = 5.0e-8f;
+	floats[3] = 65504.0f;
+	floats[4] = 1000000.0f;
+
+	gs_half_from_float_plane(halfs, floats, TEST_COUNT);
+
+	/* the SIMD paths must match the scalar conversion bit for bit */
+	for (size_t i = 0; i < TEST_COUNT; i++)
+		assert_int_equal(halfs[i].u, half_from_float(floats[i]).u);
+
+	gs_float_from_half_plane(floats2, halfs, TEST_COUNT);
+
+	for (size_t i = 0; i < TEST_COUNT; i++)
+		assert_true(floats2[i] == half_to_float(halfs[i]));
+
+	bfree(halfs);
+	bfree(floats2);
+	bfree(floats);
+
+	UNUSED_PARAMETER(state);
+}
+
+static void conversion_benchmark(void **state)
+{
+	const int iterations = 50;
+	float *batch = bmalloc(TEST_COUNT * sizeof(float));
+	struct half *halfs = bmalloc(TEST_COUNT * sizeof(struct half));
+
+	srand(1213);
+	for (size_t i = 0; i < TEST_COUNT; i++)
+		batch[i] = (float)rand() / RAND_MAX;
+
+	uint64_t start = os_gettime_ns();
+	for (int i = 0; i < iterations; i++)
+		gs_float3_srgb_nonlinear_to_linear_batch(batch, TEST_COUNT / 3);
+	uint64_t elapsed = os_gettime_ns() - start;
+	print_message("srgb_nonlinear_to_linear_batch: %.3f ns/element\n",
+		      (double)elapsed / ((double)iterations * (TEST_COUNT / 3) * 3));
+
+	start = os_gettime_ns();
+	for (int i = 0; i < iterations; i++)
+		gs_half_from_float_plane(halfs, batch, TEST_COUNT);
+	elapsed = os_gettime_ns() - start;
+	print_message("half_from_float_plane: %.3f ns/element\n",
+		      (double)elapsed / ((double)iterations * TEST_COUNT));
+
+	start = os_gettime_ns();
+	for (int i = 0; i < iterations; i++)
+		gs_float_from_half_plane(batch, halfs, TEST_COUNT);
+	elapsed = os_gettime_ns() - start;
+	print_message("float_from_half_plane: %.3f ns/element\n",
+		      (double)elapsed / ((double)iterations * TEST_COUNT));
+
+	bfree(halfs);
+	bfree(batch);
+
+	UNUSED_PARAMETER(state);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(srgb_decode_batch_test),
+		cmocka_unit_test(srgb_texel_batch_alpha_test),
+		cmocka_unit_test(half_plane_test),
+		cmocka_unit_test(conversion_benchmark),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,270 @@
+#include <util/darray.h>
+#include <util/dstr.h>
+#include <util/platform.h>
+#include <util/threading.h>
+#include <obs-module.h>
+
+/* Synthetic pipeline load generator for capacity testing.
+ *
+ * Point the OBS_LOAD_GENERATOR environment variable at a JSON config file
+ * and the generator builds a scene of synthetic load sources plus a
+ * sinewave audio source, encodes them with the configured encoders into a
+ * null output, samples pipeline statistics once a second, and writes a
+ * machine-readable JSON report.  Config keys (all optional):
+ *
+ *   video_source_count     number of load sources            (default 4)
+ *   source_width           per-source width                  (default 1920)
+ *   source_height          per-source height                 (default 1080)
+ *   source_fps             per-source frame rate             (default 30)
+ *   audio                  add a synthetic audio source      (default true)
+ *   video_encoder          video encoder id                  (default obs_x264)
+ *   video_encoder_settings settings object for the encoder   (default empty)
+ *   audio_encoder          audio encoder id                  (default ffmpeg_aac)
+ *   startup_delay_sec      wait before starting the run      (default 10)
+ *   duration_sec           measured run length               (default 60)
+ *   report_path            report destination               (default
+ *                          obs-load-report.json in the working directory)
+ *
+ * The startup delay lets the frontend finish loading its scene collection
+ * first; the generator then takes over output channels 0/1 for the run and
+ * clears them afterwards. */
+
+struct load_generator {
+	pthread_t thread;
+	bool thread_active;
+	os_event_t *stop_signal;
+	obs_data_t *config;
+};
+
+static struct load_generator generator;
+
+static void sample_stats(obs_data_array_t *samples, obs_output_t *output, int t_sec)
+{
+	obs_data_t *sample = obs_data_create();
+
+	obs_data_set_int(sample, "t_sec", t_sec);
+	obs_data_set_double(sample, "active_fps", obs_get_active_fps());
+	obs_data_set_int(sample, "avg_frame_time_ns", obs_get_average_frame_time_ns());
+	obs_data_set_int(sample, "total_frames", obs_get_total_frames());
+	obs_data_set_int(sample, "lagged_frames", obs_get_lagged_frames());
+	obs_data_set_int(sample, "skipped_frames", video_output_get_skipped_frames(obs_get_video()));
+	obs_data_set_int(sample, "output_total_frames", obs_output_get_total_frames(output));
+	obs_data_set_int(sample, "output_dropped_frames", obs_output_get_frames_dropped(output));
+
+	obs_data_array_push_back(samples, sample);
+	obs_data_release(sample);
+}
+
+static void write_report(obs_data_t *config, obs_data_array_t *samples, obs_output_t *output)
+{
+	const char *path = obs_data_get_string(config, "report_path");
+	obs_data_t *report = obs_data_create();
+	obs_data_t *summary = obs_data_create();
+
+	uint32_t total = obs_get_total_frames();
+	uint32_t lagged = obs_get_lagged_frames();
+	uint32_t skipped = video_output_get_skipped_frames(obs_get_video());
+
+	obs_data_set_int(summary, "total_frames", total);
+	obs_data_set_int(summary, "lagged_frames", lagged);
+	obs_data_set_int(summary, "skipped_frames", skipped);
+	obs_data_set_double(summary, "lagged_percent", total ? (double)lagged / (double)total * 100.0 : 0.0);
+	obs_data_set_double(summary, "skipped_percent", total ? (double)skipped / (double)total * 100.0 : 0.0);
+	obs_data_set_int(summary, "output_total_frames", obs_output_get_total_frames(output));
+	obs_data_set_int(summary, "output_dropped_frames", obs_output_get_frames_dropped(output));
+	obs_data_set_int(summary, "avg_frame_time_ns", obs_get_average_frame_time_ns());
+
+	obs_data_set_obj(report, "config", config);
+	obs_data_set_obj(report, "summary", summary);
+	obs_data_set_array(report, "samples", samples);
+
+	if (obs_data_save_json_safe(report, path, "tmp", "bak"))
+		blog(LOG_INFO, "load generator: wrote report to '%s'", path);
+	else
+		blog(LOG_ERROR, "load generator: failed to write report to '%s'", path);
+
+	obs_data_release(summary);
+	obs_data_release(report);
+}
+
+static void *load_generator_thread(void *data)
+{
+	struct load_generator *lg = data;
+	obs_data_t *config = lg->config;
+
+	DARRAY(obs_source_t *) sources;
+	obs_scene_t *scene = NULL;
+	obs_source_t *audio = NULL;
+	obs_encoder_t *venc = NULL;
+	obs_encoder_t *aenc = NULL;
+	obs_output_t *output = NULL;
+	obs_data_array_t *samples = NULL;
+
+	os_set_thread_name("load generator");
+	da_init(sources);
+
+	uint64_t delay_ms = (uint64_t)obs_data_get_int(config, "startup_delay_sec") * 1000;
+	if (os_event_timedwait(lg->stop_signal, (unsigned long)delay_ms) != ETIMEDOUT)
+		goto cleanup;
+
+	long long count = obs_data_get_int(config, "video_source_count");
+	obs_data_t *source_settings = obs_data_create();
+	obs_data_set_int(source_settings, "width", obs_data_get_int(config, "source_width"));
+	obs_data_set_int(source_settings, "height", obs_data_get_int(config, "source_height"));
+	obs_data_set_int(source_settings, "fps", obs_data_get_int(config, "source_fps"));
+
+	scene = obs_scene_create("load generator scene");
+
+	for (long long i = 0; i < count; i++) {
+		struct dstr name = {0};
+		dstr_printf(&name, "load source %lld", i);
+
+		obs_source_t *source = obs_source_create("load_source", name.array, source_settings, NULL);
+		dstr_free(&name);
+
+		if (!source)
+			continue;
+
+		obs_scene_add(scene, source);
+		da_push_back(sources, &source);
+	}
+
+	obs_data_release(source_settings);
+
+	if (obs_data_get_bool(config, "audio"))
+		audio = obs_source_create("test_sinewave", "load generator audio", NULL, NULL);
+
+	obs_set_output_source(0, obs_scene_get_source(scene));
+	if (audio)
+		obs_set_output_source(1, audio);
+
+	obs_data_t *venc_settings = obs_data_get_obj(config, "video_encoder_settings");
+	venc = obs_video_encoder_create(obs_data_get_string(config, "video_encoder"),
+					"load generator video encoder", venc_settings, NULL);
+	obs_data_release(venc_settings);
+
+	if (!venc) {
+		blog(LOG_ERROR, "load generator: failed to create video encoder '%s'",
+		     obs_data_get_string(config, "video_encoder"));
+		goto cleanup;
+	}
+	obs_encoder_set_video(venc, obs_get_video());
+
+	if (audio) {
+		aenc = obs_audio_encoder_create(obs_data_get_string(config, "audio_encoder"),
+						"load generator audio encoder", NULL, 0, NULL);
+		if (aenc)
+			obs_encoder_set_audio(aenc, obs_get_audio());
+	}
+
+	output = obs_output_create("null_output", "load generator output", NULL, NULL);
+	obs_output_set_video_encoder(output, venc);
+	if (aenc)
+		obs_output_set_audio_encoder(output, aenc, 0);
+
+	if (!obs_output_start(output)) {
+		blog(LOG_ERROR, "load generator: failed to start output");
+		goto cleanup;
+	}
+
+	blog(LOG_INFO,
+	     "load generator: running %lld sources at %lldx%lld/%lld fps "
+	     "through '%s' for %lld seconds",
+	     count, obs_data_get_int(config, "source_width"), obs_data_get_int(config, "source_height"),
+	     obs_data_get_int(config, "source_fps"), obs_data_get_string(config, "video_encoder"),
+	     obs_data_get_int(config, "duration_sec"));
+
+	samples = obs_data_array_create();
+
+	long long duration = obs_data_get_int(config, "duration_sec");
+	for (long long sec = 0; sec < duration; sec++) {
+		if (os_event_timedwait(lg->stop_signal, 1000) != ETIMEDOUT)
+			break;
+
+		sample_stats(samples, output, (int)(sec + 1));
+	}
+
+	obs_output_stop(output);
+
+	write_report(config, samples, output);
+
+cleanup:
+	if (output)
+		obs_output_release(output);
+	if (venc)
+		obs_encoder_release(venc);
+	if (aenc)
+		obs_encoder_release(aenc);
+
+	obs_set_output_source(0, NULL);
+	if (audio) {
+		obs_set_output_source(1, NULL);
+		obs_source_release(audio);
+	}
+
+	for (size_t i = 0; i < sources.num; i++)
+		obs_source_release(sources.array[i]);
+	da_free(sources);
+
+	if (scene)
+		obs_scene_release(scene);
+	if (samples)
+		obs_data_array_release(samples);
+
+	return NULL;
+}
+
+bool load_generator_start(void)
+{
+	const char *path = getenv("OBS_LOAD_GENERATOR");
+	if (!path || !*path)
+		return false;
+
+	obs_data_t *config = obs_data_create_from_json_file(path);
+	if (!config) {
+		blog(LOG_ERROR, "load generator: failed to load config '%s'", path);
+		return false;
+	}
+
+	obs_data_set_default_int(config, "video_source_count", 4);
+	obs_data_set_default_int(config, "source_width", 1920);
+	obs_data_set_default_int(config, "source_height", 1080);
+	obs_data_set_default_int(config, "source_fps", 30);
+	obs_data_set_default_bool(config, "audio", true);
+	obs_data_set_default_string(config, "video_encoder", "obs_x264");
+	obs_data_set_default_string(config, "audio_encoder", "ffmpeg_aac");
+	obs_data_set_default_int(config, "startup_delay_sec", 10);
+	obs_data_set_default_int(config, "duration_sec", 60);
+	obs_data_set_default_string(config, "report_path", "obs-load-report.json");
+
+	if (os_event_init(&generator.stop_signal, OS_EVENT_TYPE_MANUAL) != 0) {
+		obs_data_release(config);
+		return false;
+	}
+
+	generator.config = config;
+
+	if (pthread_create(&generator.thread, NULL, load_generator_thread, &generator) != 0) {
+		os_event_destroy(generator.stop_signal);
+		generator.stop_signal = NULL;
+		obs_data_release(config);
+		generator.config = NULL;
+		return false;
+	}
+
+	generator.thread_active = true;
+	return true;
+}
+
+void load_generator_stop(void)
+{
+	if (!generator.thread_active)
+		return;
+
+	os_event_signal(generator.stop_signal);
+	pthread_join(generator.thread, NULL);
+
+	os_event_destroy(generator.stop_signal);
+	obs_data_release(generator.config);
+	memset(&generator, 0, sizeof(generator));
+}
@@ -0,0 +1,146 @@
+#include <stdlib.h>
+#include <util/threading.h>
+#include <util/platform.h>
+#include <obs-module.h>
+
+/* Procedural video source with configurable resolution and frame rate,
+ * used by the load generator to drive the pipeline at arbitrary cost.
+ * Every frame is a moving gradient, so encoders get content that changes
+ * each frame instead of collapsing to repeat frames. */
+
+struct load_source {
+	obs_source_t *source;
+	os_event_t *stop_signal;
+	pthread_t thread;
+	bool initialized;
+
+	uint32_t cx;
+	uint32_t cy;
+	uint64_t interval_ns;
+	uint32_t *pixels;
+};
+
+static const char *load_source_getname(void *unused)
+{
+	UNUSED_PARAMETER(unused);
+	return "Synthetic Load Source (Test)";
+}
+
+static void load_source_destroy(void *data)
+{
+	struct load_source *ls = data;
+
+	if (ls) {
+		if (ls->initialized) {
+			os_event_signal(ls->stop_signal);
+			pthread_join(ls->thread, NULL);
+		}
+
+		os_event_destroy(ls->stop_signal);
+		bfree(ls->pixels);
+		bfree(ls);
+	}
+}
+
+static inline void fill_frame(uint32_t *pixels, uint32_t cx, uint32_t cy, uint32_t offset)
+{
+	for (uint32_t y = 0; y < cy; y++) {
+		uint32_t *row = pixels + (size_t)y * cx;
+		uint32_t v = y + offset;
+
+		for (uint32_t x = 0; x < cx; x++) {
+			uint32_t p = (x + v) & 0xFF;
+			row[x] = 0xFF000000 | (p << 16) | ((p ^ 0x80) << 8) | (v & 0xFF);
+		}
+	}
+}
+
+static void *load_source_thread(void *data)
+{
+	struct load_source *ls = data;
+	uint64_t cur_time = os_gettime_ns();
+	uint32_t offset = 0;
+
+	struct obs_source_frame frame = {
+		.data = {[0] = (uint8_t *)ls->pixels},
+		.linesize = {[0] = ls->cx * 4},
+		.width = ls->cx,
+		.height = ls->cy,
+		.format = VIDEO_FORMAT_BGRX,
+	};
+
+	while (os_event_try(ls->stop_signal) == EAGAIN) {
+		fill_frame(ls->pixels, ls->cx, ls->cy, offset++);
+
+		frame.timestamp = cur_time;
+
+		obs_source_output_video(ls->source, &frame);
+
+		if (!os_sleepto_ns(cur_time += ls->interval_ns))
+			cur_time = os_gettime_ns();
+	}
+
+	return NULL;
+}
+
+static void *load_source_create(obs_data_t *settings, obs_source_t *source)
+{
+	struct load_source *ls = bzalloc(sizeof(struct load_source));
+	long long fps = obs_data_get_int(settings, "fps");
+
+	if (fps < 1)
+		fps = 30;
+
+	ls->source = source;
+	ls->cx = (uint32_t)obs_data_get_int(settings, "width");
+	ls->cy = (uint32_t)obs_data_get_int(settings, "height");
+	if (!ls->cx || !ls->cy) {
+		ls->cx = 1920;
+		ls->cy = 1080;
+	}
+	ls->interval_ns = 1000000000ULL / (uint64_t)fps;
+	ls->pixels = bmalloc((size_t)ls->cx * ls->cy * 4);
+
+	if (os_event_init(&ls->stop_signal, OS_EVENT_TYPE_MANUAL) != 0) {
+		load_source_destroy(ls);
+		return NULL;
+	}
+
+	if (pthread_create(&ls->thread, NULL, load_source_thread, ls) != 0) {
+		load_source_destroy(ls);
+		return NULL;
+	}
+
+	ls->initialized = true;
+	return ls;
+}
+
+static void load_source_defaults(obs_data_t *settings)
+{
+	obs_data_set_default_int(settings, "width", 1920);
+	obs_data_set_default_int(settings, "height", 1080);
+	obs_data_set_default_int(settings, "fps", 30);
+}
+
+static obs_properties_t *load_source_properties(void *unused)
+{
+	obs_properties_t *props = obs_properties_create();
+
+	UNUSED_PARAMETER(unused);
+
+	obs_properties_add_int(props, "width", "Width", 2, 8192, 2);
+	obs_properties_add_int(props, "height", "Height", 2, 8192, 2);
+	obs_properties_add_int(props, "fps", "FPS", 1, 240, 1);
+	return props;
+}
+
+struct obs_source_info load_source = {
+	.id = "load_source",
+	.type = OBS_SOURCE_TYPE_INPUT,
+	.output_flags = OBS_SOURCE_ASYNC_VIDEO,
+	.get_name = load_source_getname,
+	.create = load_source_create,
+	.destroy = load_source_destroy,
+	.get_defaults = load_source_defaults,
+	.get_properties = load_source_properties,
+};
@@ -2,6 +2,7 @@
 
 OBS_DECLARE_MODULE()
 
+extern struct obs_source_info load_source;
 extern struct obs_source_info test_random;
 extern struct obs_source_info test_sinewave;
 extern struct obs_source_info test_filter;
@@ -10,8 +11,12 @@ extern struct obs_source_info buffering_async_sync_test;
 extern struct obs_source_info sync_video;
 extern struct obs_source_info sync_audio;
 
+extern bool load_generator_start(void);
+extern void load_generator_stop(void);
+
 bool obs_module_load(void)
 {
+	obs_register_source(&load_source);
 	obs_register_source(&test_random);
 	obs_register_source(&test_sinewave);
 	obs_register_source(&test_filter);
@@ -21,3 +26,13 @@ bool obs_module_load(void)
 	obs_register_source(&sync_audio);
 	return true;
 }
+
+void obs_module_post_load(void)
+{
+	load_generator_start();
+}
+
+void obs_module_unload(void)
+{
+	load_generator_stop();
+}